@@ -195,6 +195,71 @@ fwupd_client_get_devices(FwupdClient *self, GCancellable *cancellable, GError **
 	return g_steal_pointer(&helper->array);
 }
 
+static void
+fwupd_client_get_devices_full_cb(GObject *source, GAsyncResult *res, gpointer user_data)
+{
+	FwupdClientHelper *helper = (FwupdClientHelper *)user_data;
+	helper->array =
+	    fwupd_client_get_devices_full_finish(FWUPD_CLIENT(source), res, &helper->error);
+	g_main_loop_quit(helper->loop);
+}
+
+/**
+ * fwupd_client_get_devices_full:
+ * @self: a #FwupdClient
+ * @flags: a #FwupdDeviceFlags the device must have set, e.g. %FWUPD_DEVICE_FLAG_UPDATABLE,
+ *	or %FWUPD_DEVICE_FLAG_NONE for no flag filtering
+ * @vendor_id: (nullable): optional vendor ID the device must have, e.g. `USB:0x056A`
+ * @offset: number of matching devices to skip, or 0
+ * @limit: maximum number of devices to return, or 0 for unlimited
+ * @cancellable: (nullable): optional #GCancellable
+ * @error: (nullable): optional return location for an error
+ *
+ * Gets devices registered with the daemon, filtered and paged on the server
+ * side. This transfers much less data than [method@FwupdClient.get_devices]
+ * when the caller only wants a subset of devices, e.g. just the updatable ones.
+ *
+ * Returns: (element-type FwupdDevice) (transfer container): results
+ *
+ * Since: 2.0.3
+ **/
+GPtrArray *
+fwupd_client_get_devices_full(FwupdClient *self,
+			      FwupdDeviceFlags flags,
+			      const gchar *vendor_id,
+			      guint offset,
+			      guint limit,
+			      GCancellable *cancellable,
+			      GError **error)
+{
+	g_autoptr(FwupdClientHelper) helper = NULL;
+
+	g_return_val_if_fail(FWUPD_IS_CLIENT(self), NULL);
+	g_return_val_if_fail(cancellable == NULL || G_IS_CANCELLABLE(cancellable), NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+	/* connect */
+	if (!fwupd_client_connect(self, cancellable, error))
+		return NULL;
+
+	/* call async version and run loop until complete */
+	helper = fwupd_client_helper_new(self);
+	fwupd_client_get_devices_full_async(self,
+					    flags,
+					    vendor_id,
+					    offset,
+					    limit,
+					    cancellable,
+					    fwupd_client_get_devices_full_cb,
+					    helper);
+	g_main_loop_run(helper->loop);
+	if (helper->array == NULL) {
+		g_propagate_error(error, g_steal_pointer(&helper->error));
+		return NULL;
+	}
+	return g_steal_pointer(&helper->array);
+}
+
 static void
 fwupd_client_get_plugins_cb(GObject *source, GAsyncResult *res, gpointer user_data)
 {
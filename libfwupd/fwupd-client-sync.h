@@ -23,6 +23,14 @@ fwupd_client_get_devices(FwupdClient *self,
 			 GCancellable *cancellable,
 			 GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
 GPtrArray *
+fwupd_client_get_devices_full(FwupdClient *self,
+			      FwupdDeviceFlags flags,
+			      const gchar *vendor_id,
+			      guint offset,
+			      guint limit,
+			      GCancellable *cancellable,
+			      GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
+GPtrArray *
 fwupd_client_get_plugins(FwupdClient *self,
 			 GCancellable *cancellable,
 			 GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
@@ -7,6 +7,7 @@
 #include "config.h"
 
 #include <gio/gio.h>
+#include <glib/gstdio.h>
 #ifdef HAVE_LIBCURL
 #include <curl/curl.h>
 #endif
@@ -82,6 +83,15 @@ typedef struct {
 	gchar *user_agent;
 	GHashTable *hints;		/* str:str */
 	GHashTable *immediate_requests; /* str:FwupdRequest */
+	GHashTable *device_pool;	/* (nullable) device-id:FwupdDevice */
+#ifdef HAVE_LIBCURL
+	CURLSH *curl_share;
+	GMutex curl_share_mutex[CURL_LOCK_DATA_LAST];
+	GMutex download_mutex; /* for @download_tasks and @downloads_active */
+	GCond download_cond;
+	guint downloads_active;
+	GHashTable *download_tasks; /* str:GPtrArray of GTask */
+#endif
 } FwupdClientPrivate;
 
 #ifdef HAVE_LIBCURL
@@ -90,7 +100,13 @@ typedef struct {
 	CURL *curl;
 	curl_mime *mime;
 	struct curl_slist *headers;
+	gchar *checksum_expected; /* (nullable) */
+	GChecksum *checksum;	  /* (nullable), fed as the bytes arrive */
+	gchar *singleflight_id;	  /* (nullable) */
 } FwupdCurlHelper;
+
+/* how many transfers are allowed to run at the same time */
+#define FWUPD_CLIENT_DOWNLOADS_MAX 4
 #endif
 
 enum {
@@ -142,12 +158,25 @@ fwupd_client_curl_helper_free(FwupdCurlHelper *helper)
 		curl_slist_free_all(helper->headers);
 	if (helper->urls != NULL)
 		g_ptr_array_unref(helper->urls);
+	if (helper->checksum != NULL)
+		g_checksum_free(helper->checksum);
+	g_free(helper->checksum_expected);
+	g_free(helper->singleflight_id);
 	g_free(helper);
 }
 
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(FwupdCurlHelper, fwupd_client_curl_helper_free)
 #endif
 
+static void
+fwupd_client_download_bytes_full_async(FwupdClient *self,
+				       GPtrArray *urls,
+				       const gchar *checksum_expected,
+				       FwupdClientDownloadFlags flags,
+				       GCancellable *cancellable,
+				       GAsyncReadyCallback callback,
+				       gpointer callback_data);
+
 typedef struct {
 	FwupdClient *self;
 	gchar *property_name;
@@ -655,6 +684,11 @@ fwupd_client_signal_cb(GDBusProxy *proxy,
 			g_warning("failed to build FwupdDevice[DeviceAdded]: %s", error->message);
 			return;
 		}
+		if (priv->device_pool != NULL && fwupd_device_get_id(dev) != NULL) {
+			g_hash_table_insert(priv->device_pool,
+					    g_strdup(fwupd_device_get_id(dev)),
+					    g_object_ref(dev));
+		}
 		g_debug("Emitting ::device-added(%s)", fwupd_device_get_id(dev));
 		fwupd_client_signal_emit_object(self, SIGNAL_DEVICE_ADDED, G_OBJECT(dev));
 		return;
@@ -665,6 +699,15 @@ fwupd_client_signal_cb(GDBusProxy *proxy,
 			g_warning("failed to build FwupdDevice[DeviceRemoved]: %s", error->message);
 			return;
 		}
+		if (priv->device_pool != NULL && fwupd_device_get_id(dev) != NULL) {
+			FwupdDevice *dev_pooled =
+			    g_hash_table_lookup(priv->device_pool, fwupd_device_get_id(dev));
+			/* emit with the pooled instance so callers can match by identity */
+			if (dev_pooled != NULL) {
+				g_set_object(&dev, dev_pooled);
+				g_hash_table_remove(priv->device_pool, fwupd_device_get_id(dev));
+			}
+		}
 		g_debug("Emitting ::device-removed(%s)", fwupd_device_get_id(dev));
 		fwupd_client_signal_emit_object(self, SIGNAL_DEVICE_REMOVED, G_OBJECT(dev));
 		return;
@@ -675,6 +718,21 @@ fwupd_client_signal_cb(GDBusProxy *proxy,
 			g_warning("failed to build FwupdDevice[DeviceChanged]: %s", error->message);
 			return;
 		}
+		if (priv->device_pool != NULL && fwupd_device_get_id(dev) != NULL) {
+			FwupdDevice *dev_pooled =
+			    g_hash_table_lookup(priv->device_pool, fwupd_device_get_id(dev));
+			/* apply the new properties onto the pooled instance in-place */
+			if (dev_pooled != NULL) {
+				if (!fwupd_codec_from_variant(FWUPD_CODEC(dev_pooled),
+							      parameters,
+							      &error)) {
+					g_warning("failed to update FwupdDevice[DeviceChanged]: %s",
+						  error->message);
+					return;
+				}
+				g_set_object(&dev, dev_pooled);
+			}
+		}
 		g_debug("Emitting ::device-changed(%s)", fwupd_device_get_id(dev));
 		fwupd_client_signal_emit_object(self, SIGNAL_DEVICE_CHANGED, G_OBJECT(dev));
 
@@ -837,6 +895,43 @@ fwupd_client_curl_helper_set_proxy(FwupdClient *self,
 	return TRUE;
 }
 
+static void
+fwupd_client_curl_lock_cb(CURL *handle,
+			  curl_lock_data data,
+			  curl_lock_access access,
+			  void *userptr)
+{
+	FwupdClientPrivate *priv = GET_PRIVATE(FWUPD_CLIENT(userptr));
+	g_mutex_lock(&priv->curl_share_mutex[data]);
+}
+
+static void
+fwupd_client_curl_unlock_cb(CURL *handle, curl_lock_data data, void *userptr)
+{
+	FwupdClientPrivate *priv = GET_PRIVATE(FWUPD_CLIENT(userptr));
+	g_mutex_unlock(&priv->curl_share_mutex[data]);
+}
+
+/* sharing the DNS cache, the TLS session cache and the connection cache between all the
+ * easy handles means downloading several artifacts from the same CDN does one lookup and
+ * one full handshake, with every other transfer resumed or multiplexed */
+static CURLSH *
+fwupd_client_curl_share_new(FwupdClient *self)
+{
+	CURLSH *share = curl_share_init();
+	if (share == NULL)
+		return NULL;
+	(void)curl_share_setopt(share, CURLSHOPT_USERDATA, self);
+	(void)curl_share_setopt(share, CURLSHOPT_LOCKFUNC, fwupd_client_curl_lock_cb);
+	(void)curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, fwupd_client_curl_unlock_cb);
+	(void)curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+	(void)curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if CURL_AT_LEAST_VERSION(7, 57, 0)
+	(void)curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+	return share;
+}
+
 static FwupdCurlHelper *
 fwupd_client_curl_new(FwupdClient *self, GError **error)
 {
@@ -858,6 +953,8 @@ fwupd_client_curl_new(FwupdClient *self, GError **error)
 	}
 	if (g_getenv("FWUPD_CURL_VERBOSE") != NULL)
 		(void)curl_easy_setopt(helper->curl, CURLOPT_VERBOSE, 1L);
+	if (priv->curl_share != NULL)
+		(void)curl_easy_setopt(helper->curl, CURLOPT_SHARE, priv->curl_share);
 	(void)curl_easy_setopt(helper->curl,
 			       CURLOPT_XFERINFOFUNCTION,
 			       fwupd_client_progress_callback_cb);
@@ -1714,10 +1811,102 @@ fwupd_client_get_report_metadata_finish(FwupdClient *self, GAsyncResult *res, GE
 	return g_task_propagate_pointer(G_TASK(res), error);
 }
 
+static GPtrArray *
+fwupd_client_device_array_from_variant(FwupdClient *self, GVariant *val, GError **error)
+{
+	FwupdClientPrivate *priv = GET_PRIVATE(self);
+	gsize sz;
+	g_autoptr(GPtrArray) array = NULL;
+	g_autoptr(GVariant) untuple = NULL;
+
+	/* no pooled model, so build a fresh object tree */
+	if (priv->device_pool == NULL)
+		return fwupd_codec_array_from_variant(val, FWUPD_TYPE_DEVICE, error);
+
+	/* apply each result onto the pooled instance where one already exists, so that
+	 * steady-state polls return refs to the same objects rather than a fresh tree */
+	array = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	untuple = g_variant_get_child_value(val, 0);
+	sz = g_variant_n_children(untuple);
+	for (gsize i = 0; i < sz; i++) {
+		const gchar *device_id = NULL;
+		FwupdDevice *dev_pooled = NULL;
+		g_autoptr(GVariant) data = g_variant_get_child_value(untuple, i);
+		g_autoptr(FwupdDevice) dev = NULL;
+
+		if (g_variant_lookup(data, FWUPD_RESULT_KEY_DEVICE_ID, "&s", &device_id))
+			dev_pooled = g_hash_table_lookup(priv->device_pool, device_id);
+		if (dev_pooled != NULL) {
+			if (!fwupd_codec_from_variant(FWUPD_CODEC(dev_pooled), data, error))
+				return NULL;
+			g_ptr_array_add(array, g_object_ref(dev_pooled));
+			continue;
+		}
+		dev = fwupd_device_new();
+		if (!fwupd_codec_from_variant(FWUPD_CODEC(dev), data, error))
+			return NULL;
+		if (device_id != NULL) {
+			g_hash_table_insert(priv->device_pool,
+					    g_strdup(device_id),
+					    g_object_ref(dev));
+		}
+		g_ptr_array_add(array, g_object_ref(dev));
+	}
+	return g_steal_pointer(&array);
+}
+
+/**
+ * fwupd_client_set_persist_devices:
+ * @self: a #FwupdClient
+ * @persist_devices: %TRUE to keep a persistent device model
+ *
+ * Sets if the client should maintain a persistent model of devices keyed by ID.
+ *
+ * When enabled, results from [method@FwupdClient.get_devices_async] are applied onto the
+ * pooled objects and the same instances are returned from each call, with signals such as
+ * [signal@FwupdClient::device-changed] also updating the pooled instance in-place.
+ * This avoids rebuilding an identical object tree in clients that poll frequently.
+ *
+ * Since: 2.0.3
+ **/
+void
+fwupd_client_set_persist_devices(FwupdClient *self, gboolean persist_devices)
+{
+	FwupdClientPrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FWUPD_IS_CLIENT(self));
+	if (persist_devices && priv->device_pool == NULL) {
+		priv->device_pool = g_hash_table_new_full(g_str_hash,
+							  g_str_equal,
+							  g_free,
+							  (GDestroyNotify)g_object_unref);
+	} else if (!persist_devices) {
+		g_clear_pointer(&priv->device_pool, g_hash_table_unref);
+	}
+}
+
+/**
+ * fwupd_client_get_persist_devices:
+ * @self: a #FwupdClient
+ *
+ * Gets if the client is maintaining a persistent model of devices keyed by ID.
+ *
+ * Returns: %TRUE if set by [method@FwupdClient.set_persist_devices]
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fwupd_client_get_persist_devices(FwupdClient *self)
+{
+	FwupdClientPrivate *priv = GET_PRIVATE(self);
+	g_return_val_if_fail(FWUPD_IS_CLIENT(self), FALSE);
+	return priv->device_pool != NULL;
+}
+
 static void
 fwupd_client_get_devices_cb(GObject *source, GAsyncResult *res, gpointer user_data)
 {
 	g_autoptr(GTask) task = G_TASK(user_data);
+	FwupdClient *self = FWUPD_CLIENT(g_task_get_source_object(task));
 	g_autoptr(GError) error = NULL;
 	g_autoptr(GPtrArray) array = NULL;
 	g_autoptr(GVariant) val = NULL;
@@ -1728,7 +1917,7 @@ fwupd_client_get_devices_cb(GObject *source, GAsyncResult *res, gpointer user_da
 		g_task_return_error(task, g_steal_pointer(&error));
 		return;
 	}
-	array = fwupd_codec_array_from_variant(val, FWUPD_TYPE_DEVICE, &error);
+	array = fwupd_client_device_array_from_variant(self, val, &error);
 	if (array == NULL) {
 		g_task_return_error(task, g_steal_pointer(&error));
 		return;
@@ -1799,6 +1988,184 @@ fwupd_client_get_devices_finish(FwupdClient *self, GAsyncResult *res, GError **e
 	return g_task_propagate_pointer(G_TASK(res), error);
 }
 
+/**
+ * fwupd_client_get_devices_full_async:
+ * @self: a #FwupdClient
+ * @flags: a #FwupdDeviceFlags the device must have set, e.g. %FWUPD_DEVICE_FLAG_UPDATABLE,
+ *	or %FWUPD_DEVICE_FLAG_NONE for no flag filtering
+ * @vendor_id: (nullable): optional vendor ID the device must have, e.g. `USB:0x056A`
+ * @offset: number of matching devices to skip, or 0
+ * @limit: maximum number of devices to return, or 0 for unlimited
+ * @cancellable: (nullable): optional #GCancellable
+ * @callback: (scope async) (closure callback_data): the function to run on completion
+ * @callback_data: the data to pass to @callback
+ *
+ * Gets devices registered with the daemon, filtered and paged on the server
+ * side. This transfers much less data than [method@FwupdClient.get_devices_async]
+ * when the caller only wants a subset of devices, e.g. just the updatable ones.
+ *
+ * You must have called [method@Client.connect_async] on @self before using
+ * this method.
+ *
+ * Since: 2.0.3
+ **/
+void
+fwupd_client_get_devices_full_async(FwupdClient *self,
+				    FwupdDeviceFlags flags,
+				    const gchar *vendor_id,
+				    guint offset,
+				    guint limit,
+				    GCancellable *cancellable,
+				    GAsyncReadyCallback callback,
+				    gpointer callback_data)
+{
+	FwupdClientPrivate *priv = GET_PRIVATE(self);
+	GVariantBuilder builder;
+	g_autoptr(GTask) task = NULL;
+
+	g_return_if_fail(FWUPD_IS_CLIENT(self));
+	g_return_if_fail(cancellable == NULL || G_IS_CANCELLABLE(cancellable));
+	g_return_if_fail(priv->proxy != NULL);
+
+	/* only send options that are set */
+	g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
+	if (flags != FWUPD_DEVICE_FLAG_NONE) {
+		g_variant_builder_add(&builder,
+				      "{sv}",
+				      "flags",
+				      g_variant_new_uint64((guint64)flags));
+	}
+	if (vendor_id != NULL) {
+		g_variant_builder_add(&builder,
+				      "{sv}",
+				      "vendor-id",
+				      g_variant_new_string(vendor_id));
+	}
+	if (offset != 0)
+		g_variant_builder_add(&builder, "{sv}", "offset", g_variant_new_uint32(offset));
+	if (limit != 0)
+		g_variant_builder_add(&builder, "{sv}", "limit", g_variant_new_uint32(limit));
+
+	/* call into daemon */
+	task = g_task_new(self, cancellable, callback, callback_data);
+	g_dbus_proxy_call(priv->proxy,
+			  "GetDevicesFiltered",
+			  g_variant_new("(a{sv})", &builder),
+			  G_DBUS_CALL_FLAGS_NONE,
+			  FWUPD_CLIENT_DBUS_PROXY_TIMEOUT,
+			  cancellable,
+			  fwupd_client_get_devices_cb,
+			  g_steal_pointer(&task));
+}
+
+/**
+ * fwupd_client_get_devices_full_finish:
+ * @self: a #FwupdClient
+ * @res: (not nullable): the asynchronous result
+ * @error: (nullable): optional return location for an error
+ *
+ * Gets the result of [method@FwupdClient.get_devices_full_async].
+ *
+ * Returns: (element-type FwupdDevice) (transfer container): results
+ *
+ * Since: 2.0.3
+ **/
+GPtrArray *
+fwupd_client_get_devices_full_finish(FwupdClient *self, GAsyncResult *res, GError **error)
+{
+	g_return_val_if_fail(FWUPD_IS_CLIENT(self), NULL);
+	g_return_val_if_fail(g_task_is_valid(res, self), NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+	return g_task_propagate_pointer(G_TASK(res), error);
+}
+
+static void
+fwupd_client_get_inventory_cb(GObject *source, GAsyncResult *res, gpointer user_data)
+{
+	g_autoptr(GTask) task = G_TASK(user_data);
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GPtrArray) array = NULL;
+	g_autoptr(GVariant) val = NULL;
+
+	val = g_dbus_proxy_call_finish(G_DBUS_PROXY(source), res, &error);
+	if (val == NULL) {
+		fwupd_client_fixup_dbus_error(error);
+		g_task_return_error(task, g_steal_pointer(&error));
+		return;
+	}
+	array = fwupd_codec_array_from_variant(val, FWUPD_TYPE_DEVICE, &error);
+	if (array == NULL) {
+		g_task_return_error(task, g_steal_pointer(&error));
+		return;
+	}
+	fwupd_device_array_ensure_parents(array);
+
+	/* success */
+	g_task_return_pointer(task, g_steal_pointer(&array), (GDestroyNotify)g_ptr_array_unref);
+}
+
+/**
+ * fwupd_client_get_inventory_async:
+ * @self: a #FwupdClient
+ * @cancellable: (nullable): optional #GCancellable
+ * @callback: (scope async) (closure callback_data): the function to run on completion
+ * @callback_data: the data to pass to @callback
+ *
+ * Gets all the devices registered with the daemon, with any available releases
+ * embedded on each updatable device. This is much faster than calling
+ * [method@FwupdClient.get_releases_async] once per device.
+ *
+ * You must have called [method@Client.connect_async] on @self before using
+ * this method.
+ *
+ * Since: 2.0.3
+ **/
+void
+fwupd_client_get_inventory_async(FwupdClient *self,
+				 GCancellable *cancellable,
+				 GAsyncReadyCallback callback,
+				 gpointer callback_data)
+{
+	FwupdClientPrivate *priv = GET_PRIVATE(self);
+	g_autoptr(GTask) task = NULL;
+
+	g_return_if_fail(FWUPD_IS_CLIENT(self));
+	g_return_if_fail(cancellable == NULL || G_IS_CANCELLABLE(cancellable));
+	g_return_if_fail(priv->proxy != NULL);
+
+	/* call into daemon */
+	task = g_task_new(self, cancellable, callback, callback_data);
+	g_dbus_proxy_call(priv->proxy,
+			  "GetInventory",
+			  NULL,
+			  G_DBUS_CALL_FLAGS_NONE,
+			  FWUPD_CLIENT_DBUS_PROXY_TIMEOUT,
+			  cancellable,
+			  fwupd_client_get_inventory_cb,
+			  g_steal_pointer(&task));
+}
+
+/**
+ * fwupd_client_get_inventory_finish:
+ * @self: a #FwupdClient
+ * @res: (not nullable): the asynchronous result
+ * @error: (nullable): optional return location for an error
+ *
+ * Gets the result of [method@FwupdClient.get_inventory_async].
+ *
+ * Returns: (element-type FwupdDevice) (transfer container): results
+ *
+ * Since: 2.0.3
+ **/
+GPtrArray *
+fwupd_client_get_inventory_finish(FwupdClient *self, GAsyncResult *res, GError **error)
+{
+	g_return_val_if_fail(FWUPD_IS_CLIENT(self), NULL);
+	g_return_val_if_fail(g_task_is_valid(res, self), NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+	return g_task_propagate_pointer(G_TASK(res), error);
+}
+
 static void
 fwupd_client_get_plugins_cb(GObject *source, GAsyncResult *res, gpointer user_data)
 {
@@ -2264,11 +2631,11 @@ fwupd_client_get_releases_finish(FwupdClient *self, GAsyncResult *res, GError **
 }
 
 static void
-fwupd_client_get_downgrades_cb(GObject *source, GAsyncResult *res, gpointer user_data)
+fwupd_client_get_release_details_cb(GObject *source, GAsyncResult *res, gpointer user_data)
 {
+	g_autoptr(FwupdRelease) release = fwupd_release_new();
 	g_autoptr(GTask) task = G_TASK(user_data);
 	g_autoptr(GError) error = NULL;
-	g_autoptr(GPtrArray) array = NULL;
 	g_autoptr(GVariant) val = NULL;
 
 	val = g_dbus_proxy_call_finish(G_DBUS_PROXY(source), res, &error);
@@ -2277,72 +2644,77 @@ fwupd_client_get_downgrades_cb(GObject *source, GAsyncResult *res, gpointer user
 		g_task_return_error(task, g_steal_pointer(&error));
 		return;
 	}
-	array = fwupd_codec_array_from_variant(val, FWUPD_TYPE_RELEASE, &error);
-	if (array == NULL) {
+	if (!fwupd_codec_from_variant(FWUPD_CODEC(release), val, &error)) {
 		g_task_return_error(task, g_steal_pointer(&error));
 		return;
 	}
 
 	/* success */
-	g_task_return_pointer(task, g_steal_pointer(&array), (GDestroyNotify)g_ptr_array_unref);
+	g_task_return_pointer(task, g_steal_pointer(&release), (GDestroyNotify)g_object_unref);
 }
 
 /**
- * fwupd_client_get_downgrades_async:
+ * fwupd_client_get_release_details_async:
  * @self: a #FwupdClient
  * @device_id: (not nullable): the device ID
+ * @version: (not nullable): the release version, e.g. `1.2.3`
  * @cancellable: (nullable): optional #GCancellable
  * @callback: (scope async) (closure callback_data): the function to run on completion
  * @callback_data: the data to pass to @callback
  *
- * Gets all the downgrades for a specific device.
+ * Gets the full details for a single release, including the description.
+ *
+ * Clients that set %FWUPD_FEATURE_FLAG_LAZY_RELEASE_DETAILS get enumeration replies
+ * without the release description and should use this method when it is actually shown.
  *
  * You must have called [method@Client.connect_async] on @self before using
  * this method.
  *
- * Since: 1.5.0
+ * Since: 2.0.3
  **/
 void
-fwupd_client_get_downgrades_async(FwupdClient *self,
-				  const gchar *device_id,
-				  GCancellable *cancellable,
-				  GAsyncReadyCallback callback,
-				  gpointer callback_data)
+fwupd_client_get_release_details_async(FwupdClient *self,
+				       const gchar *device_id,
+				       const gchar *version,
+				       GCancellable *cancellable,
+				       GAsyncReadyCallback callback,
+				       gpointer callback_data)
 {
 	FwupdClientPrivate *priv = GET_PRIVATE(self);
 	g_autoptr(GTask) task = NULL;
 
 	g_return_if_fail(FWUPD_IS_CLIENT(self));
 	g_return_if_fail(device_id != NULL);
+	g_return_if_fail(version != NULL);
 	g_return_if_fail(cancellable == NULL || G_IS_CANCELLABLE(cancellable));
 	g_return_if_fail(priv->proxy != NULL);
 
 	/* call into daemon */
 	task = g_task_new(self, cancellable, callback, callback_data);
 	g_dbus_proxy_call(priv->proxy,
-			  "GetDowngrades",
-			  g_variant_new("(s)", device_id),
+			  "GetReleaseDetails",
+			  g_variant_new("(ss)", device_id, version),
 			  G_DBUS_CALL_FLAGS_NONE,
 			  FWUPD_CLIENT_DBUS_PROXY_TIMEOUT,
 			  cancellable,
-			  fwupd_client_get_downgrades_cb,
+			  fwupd_client_get_release_details_cb,
 			  g_steal_pointer(&task));
 }
 
 /**
- * fwupd_client_get_downgrades_finish:
+ * fwupd_client_get_release_details_finish:
  * @self: a #FwupdClient
  * @res: (not nullable): the asynchronous result
  * @error: (nullable): optional return location for an error
  *
- * Gets the result of [method@FwupdClient.get_downgrades_async].
+ * Gets the result of [method@FwupdClient.get_release_details_async].
  *
- * Returns: (element-type FwupdRelease) (transfer container): results
+ * Returns: (transfer full): a release, or %NULL for failure
  *
- * Since: 1.5.0
+ * Since: 2.0.3
  **/
-GPtrArray *
-fwupd_client_get_downgrades_finish(FwupdClient *self, GAsyncResult *res, GError **error)
+FwupdRelease *
+fwupd_client_get_release_details_finish(FwupdClient *self, GAsyncResult *res, GError **error)
 {
 	g_return_val_if_fail(FWUPD_IS_CLIENT(self), NULL);
 	g_return_val_if_fail(g_task_is_valid(res, self), NULL);
@@ -2351,7 +2723,7 @@ fwupd_client_get_downgrades_finish(FwupdClient *self, GAsyncResult *res, GError
 }
 
 static void
-fwupd_client_get_upgrades_cb(GObject *source, GAsyncResult *res, gpointer user_data)
+fwupd_client_get_downgrades_cb(GObject *source, GAsyncResult *res, gpointer user_data)
 {
 	g_autoptr(GTask) task = G_TASK(user_data);
 	g_autoptr(GError) error = NULL;
@@ -2375,14 +2747,14 @@ fwupd_client_get_upgrades_cb(GObject *source, GAsyncResult *res, gpointer user_d
 }
 
 /**
- * fwupd_client_get_upgrades_async:
+ * fwupd_client_get_downgrades_async:
  * @self: a #FwupdClient
  * @device_id: (not nullable): the device ID
  * @cancellable: (nullable): optional #GCancellable
  * @callback: (scope async) (closure callback_data): the function to run on completion
  * @callback_data: the data to pass to @callback
  *
- * Gets all the upgrades for a specific device.
+ * Gets all the downgrades for a specific device.
  *
  * You must have called [method@Client.connect_async] on @self before using
  * this method.
@@ -2390,11 +2762,11 @@ fwupd_client_get_upgrades_cb(GObject *source, GAsyncResult *res, gpointer user_d
  * Since: 1.5.0
  **/
 void
-fwupd_client_get_upgrades_async(FwupdClient *self,
-				const gchar *device_id,
-				GCancellable *cancellable,
-				GAsyncReadyCallback callback,
-				gpointer callback_data)
+fwupd_client_get_downgrades_async(FwupdClient *self,
+				  const gchar *device_id,
+				  GCancellable *cancellable,
+				  GAsyncReadyCallback callback,
+				  gpointer callback_data)
 {
 	FwupdClientPrivate *priv = GET_PRIVATE(self);
 	g_autoptr(GTask) task = NULL;
@@ -2407,29 +2779,29 @@ fwupd_client_get_upgrades_async(FwupdClient *self,
 	/* call into daemon */
 	task = g_task_new(self, cancellable, callback, callback_data);
 	g_dbus_proxy_call(priv->proxy,
-			  "GetUpgrades",
+			  "GetDowngrades",
 			  g_variant_new("(s)", device_id),
 			  G_DBUS_CALL_FLAGS_NONE,
 			  FWUPD_CLIENT_DBUS_PROXY_TIMEOUT,
 			  cancellable,
-			  fwupd_client_get_upgrades_cb,
+			  fwupd_client_get_downgrades_cb,
 			  g_steal_pointer(&task));
 }
 
 /**
- * fwupd_client_get_upgrades_finish:
+ * fwupd_client_get_downgrades_finish:
  * @self: a #FwupdClient
  * @res: (not nullable): the asynchronous result
  * @error: (nullable): optional return location for an error
  *
- * Gets the result of [method@FwupdClient.get_upgrades_async].
+ * Gets the result of [method@FwupdClient.get_downgrades_async].
  *
  * Returns: (element-type FwupdRelease) (transfer container): results
  *
  * Since: 1.5.0
  **/
 GPtrArray *
-fwupd_client_get_upgrades_finish(FwupdClient *self, GAsyncResult *res, GError **error)
+fwupd_client_get_downgrades_finish(FwupdClient *self, GAsyncResult *res, GError **error)
 {
 	g_return_val_if_fail(FWUPD_IS_CLIENT(self), NULL);
 	g_return_val_if_fail(g_task_is_valid(res, self), NULL);
@@ -2438,10 +2810,11 @@ fwupd_client_get_upgrades_finish(FwupdClient *self, GAsyncResult *res, GError **
 }
 
 static void
-fwupd_client_modify_config_cb(GObject *source, GAsyncResult *res, gpointer user_data)
+fwupd_client_get_upgrades_cb(GObject *source, GAsyncResult *res, gpointer user_data)
 {
 	g_autoptr(GTask) task = G_TASK(user_data);
 	g_autoptr(GError) error = NULL;
+	g_autoptr(GPtrArray) array = NULL;
 	g_autoptr(GVariant) val = NULL;
 
 	val = g_dbus_proxy_call_finish(G_DBUS_PROXY(source), res, &error);
@@ -2450,7 +2823,93 @@ fwupd_client_modify_config_cb(GObject *source, GAsyncResult *res, gpointer user_
 		g_task_return_error(task, g_steal_pointer(&error));
 		return;
 	}
-
+	array = fwupd_codec_array_from_variant(val, FWUPD_TYPE_RELEASE, &error);
+	if (array == NULL) {
+		g_task_return_error(task, g_steal_pointer(&error));
+		return;
+	}
+
+	/* success */
+	g_task_return_pointer(task, g_steal_pointer(&array), (GDestroyNotify)g_ptr_array_unref);
+}
+
+/**
+ * fwupd_client_get_upgrades_async:
+ * @self: a #FwupdClient
+ * @device_id: (not nullable): the device ID
+ * @cancellable: (nullable): optional #GCancellable
+ * @callback: (scope async) (closure callback_data): the function to run on completion
+ * @callback_data: the data to pass to @callback
+ *
+ * Gets all the upgrades for a specific device.
+ *
+ * You must have called [method@Client.connect_async] on @self before using
+ * this method.
+ *
+ * Since: 1.5.0
+ **/
+void
+fwupd_client_get_upgrades_async(FwupdClient *self,
+				const gchar *device_id,
+				GCancellable *cancellable,
+				GAsyncReadyCallback callback,
+				gpointer callback_data)
+{
+	FwupdClientPrivate *priv = GET_PRIVATE(self);
+	g_autoptr(GTask) task = NULL;
+
+	g_return_if_fail(FWUPD_IS_CLIENT(self));
+	g_return_if_fail(device_id != NULL);
+	g_return_if_fail(cancellable == NULL || G_IS_CANCELLABLE(cancellable));
+	g_return_if_fail(priv->proxy != NULL);
+
+	/* call into daemon */
+	task = g_task_new(self, cancellable, callback, callback_data);
+	g_dbus_proxy_call(priv->proxy,
+			  "GetUpgrades",
+			  g_variant_new("(s)", device_id),
+			  G_DBUS_CALL_FLAGS_NONE,
+			  FWUPD_CLIENT_DBUS_PROXY_TIMEOUT,
+			  cancellable,
+			  fwupd_client_get_upgrades_cb,
+			  g_steal_pointer(&task));
+}
+
+/**
+ * fwupd_client_get_upgrades_finish:
+ * @self: a #FwupdClient
+ * @res: (not nullable): the asynchronous result
+ * @error: (nullable): optional return location for an error
+ *
+ * Gets the result of [method@FwupdClient.get_upgrades_async].
+ *
+ * Returns: (element-type FwupdRelease) (transfer container): results
+ *
+ * Since: 1.5.0
+ **/
+GPtrArray *
+fwupd_client_get_upgrades_finish(FwupdClient *self, GAsyncResult *res, GError **error)
+{
+	g_return_val_if_fail(FWUPD_IS_CLIENT(self), NULL);
+	g_return_val_if_fail(g_task_is_valid(res, self), NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+	return g_task_propagate_pointer(G_TASK(res), error);
+}
+
+static void
+fwupd_client_modify_config_cb(GObject *source, GAsyncResult *res, gpointer user_data)
+{
+	g_autoptr(GTask) task = G_TASK(user_data);
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GVariant) val = NULL;
+
+	val = g_dbus_proxy_call_finish(G_DBUS_PROXY(source), res, &error);
+	if (val == NULL) {
+		fwupd_client_fixup_dbus_error(error);
+		g_task_return_error(task, g_steal_pointer(&error));
+		return;
+	}
+
 	/* success */
 	g_task_return_boolean(task, TRUE);
 }
@@ -3379,31 +3838,15 @@ fwupd_client_install_release_download_cb(GObject *source, GAsyncResult *res, gpo
 	g_autoptr(GError) error = NULL;
 	g_autoptr(GTask) task = G_TASK(user_data);
 	FwupdClientInstallReleaseData *data = g_task_get_task_data(task);
-	GChecksumType checksum_type;
 	GCancellable *cancellable = g_task_get_cancellable(task);
-	const gchar *checksum_expected;
-	g_autofree gchar *checksum_actual = NULL;
 
+	/* the checksum was already verified as the bytes arrived */
 	blob = fwupd_client_download_bytes_finish(FWUPD_CLIENT(source), res, &error);
 	if (blob == NULL) {
 		g_task_return_error(task, g_steal_pointer(&error));
 		return;
 	}
 
-	/* verify checksum */
-	checksum_expected = fwupd_checksum_get_best(fwupd_release_get_checksums(data->release));
-	checksum_type = fwupd_checksum_guess_kind(checksum_expected);
-	checksum_actual = g_compute_checksum_for_bytes(checksum_type, blob);
-	if (g_strcmp0(checksum_expected, checksum_actual) != 0) {
-		g_task_return_new_error(task,
-					FWUPD_ERROR,
-					FWUPD_ERROR_INVALID_FILE,
-					"checksum invalid, expected %s got %s",
-					checksum_expected,
-					checksum_actual);
-		return;
-	}
-
 	fwupd_client_install_bytes_async(FWUPD_CLIENT(source),
 					 fwupd_device_get_id(data->device),
 					 blob,
@@ -3467,6 +3910,7 @@ static void
 fwupd_client_install_release_remote_cb(GObject *source, GAsyncResult *res, gpointer user_data)
 {
 	GPtrArray *locations;
+	const gchar *checksum_expected;
 	const gchar *uri_tmp;
 	g_autofree gchar *fn = NULL;
 	g_autoptr(FwupdRemote) remote = NULL;
@@ -3556,13 +4000,25 @@ fwupd_client_install_release_remote_cb(GObject *source, GAsyncResult *res, gpoin
 		return;
 	}
 
-	/* download file */
-	fwupd_client_download_bytes2_async(FWUPD_CLIENT(source),
-					   uris_built,
-					   data->download_flags,
-					   cancellable,
-					   fwupd_client_install_release_download_cb,
-					   g_steal_pointer(&task));
+	/* the checksum is what we verify the download against */
+	checksum_expected =
+	    fwupd_checksum_get_best(fwupd_release_get_checksums(data->release));
+	if (checksum_expected == NULL) {
+		g_task_return_new_error(task,
+					FWUPD_ERROR,
+					FWUPD_ERROR_INVALID_FILE,
+					"release missing checksum");
+		return;
+	}
+
+	/* download file, verifying the checksum as the bytes arrive */
+	fwupd_client_download_bytes_full_async(FWUPD_CLIENT(source),
+					       uris_built,
+					       checksum_expected,
+					       data->download_flags,
+					       cancellable,
+					       fwupd_client_install_release_download_cb,
+					       g_steal_pointer(&task));
 }
 
 #ifdef HAVE_LIBCURL
@@ -3646,12 +4102,22 @@ fwupd_client_install_release_async(FwupdClient *self,
 	/* work out what remote-specific URI fields this should use */
 	remote_id = fwupd_release_get_remote_id(release);
 	if (remote_id == NULL) {
-		fwupd_client_download_bytes2_async(self,
-						   fwupd_release_get_locations(release),
-						   download_flags,
-						   cancellable,
-						   fwupd_client_install_release_download_cb,
-						   g_steal_pointer(&task));
+		const gchar *checksum_expected =
+		    fwupd_checksum_get_best(fwupd_release_get_checksums(release));
+		if (checksum_expected == NULL) {
+			g_task_return_new_error(task,
+						FWUPD_ERROR,
+						FWUPD_ERROR_INVALID_FILE,
+						"release missing checksum");
+			return;
+		}
+		fwupd_client_download_bytes_full_async(self,
+						       fwupd_release_get_locations(release),
+						       checksum_expected,
+						       download_flags,
+						       cancellable,
+						       fwupd_client_install_release_download_cb,
+						       g_steal_pointer(&task));
 		return;
 	}
 
@@ -4373,7 +4839,53 @@ fwupd_client_refresh_remote_metadata_cb(GObject *source, GAsyncResult *res, gpoi
 }
 
 static void
-fwupd_client_refresh_remote_signature_cb(GObject *source, GAsyncResult *res, gpointer user_data)
+fwupd_client_refresh_remote_metadata_download(GTask *task_in)
+{
+	g_autoptr(GTask) task = task_in;
+	g_autoptr(GError) error = NULL;
+	FwupdClientRefreshRemoteData *data = g_task_get_task_data(task);
+	FwupdClient *self = g_task_get_source_object(task);
+	GCancellable *cancellable = g_task_get_cancellable(task);
+	g_autoptr(GPtrArray) urls = g_ptr_array_new_with_free_func(g_free);
+
+	/* maybe get metadata from Passim */
+	if (fwupd_remote_has_flag(data->remote, FWUPD_REMOTE_FLAG_ALLOW_P2P_METADATA) &&
+	    fwupd_remote_get_checksum_metadata(data->remote) != NULL &&
+	    fwupd_remote_get_username(data->remote) == NULL &&
+	    fwupd_remote_get_password(data->remote) == NULL) {
+		g_autofree gchar *basename =
+		    g_path_get_basename(fwupd_remote_get_metadata_uri(data->remote));
+		g_ptr_array_add(urls,
+				g_strdup_printf("https://localhost:27500/%s?sha256=%s",
+						basename,
+						fwupd_remote_get_checksum_metadata(data->remote)));
+	}
+	if ((data->download_flags & FWUPD_CLIENT_DOWNLOAD_FLAG_ONLY_P2P) == 0) {
+		g_autofree gchar *uri = fwupd_remote_build_metadata_uri(data->remote, &error);
+		if (uri == NULL) {
+			g_task_return_error(task, g_steal_pointer(&error));
+			return;
+		}
+		g_ptr_array_add(urls, g_steal_pointer(&uri));
+	}
+	fwupd_client_download_bytes2_async(self,
+					   urls,
+					   FWUPD_CLIENT_DOWNLOAD_FLAG_NONE,
+					   cancellable,
+					   fwupd_client_refresh_remote_metadata_cb,
+					   g_steal_pointer(&task));
+}
+
+#ifdef HAVE_LIBCURL
+static void
+fwupd_client_refresh_remote_delta_async(FwupdClient *self,
+					FwupdRemote *remote,
+					GCancellable *cancellable,
+					GAsyncReadyCallback callback,
+					gpointer callback_data);
+
+static void
+fwupd_client_refresh_remote_delta_cb(GObject *source, GAsyncResult *res, gpointer user_data)
 {
 	g_autoptr(GBytes) bytes = NULL;
 	g_autoptr(GError) error = NULL;
@@ -4381,7 +4893,36 @@ fwupd_client_refresh_remote_signature_cb(GObject *source, GAsyncResult *res, gpo
 	FwupdClientRefreshRemoteData *data = g_task_get_task_data(task);
 	FwupdClient *self = g_task_get_source_object(task);
 	GCancellable *cancellable = g_task_get_cancellable(task);
-	g_autoptr(GPtrArray) urls = g_ptr_array_new_with_free_func(g_free);
+
+	/* fall back to the full download on any kind of failure */
+	bytes = g_task_propagate_pointer(G_TASK(res), &error);
+	if (bytes == NULL) {
+		g_info("delta refresh of %s failed, falling back to full download: %s",
+		       fwupd_remote_get_id(data->remote),
+		       error->message);
+		fwupd_client_refresh_remote_metadata_download(g_steal_pointer(&task));
+		return;
+	}
+	data->metadata = g_steal_pointer(&bytes);
+
+	/* send all this to fwupd */
+	fwupd_client_update_metadata_bytes_async(self,
+						 fwupd_remote_get_id(data->remote),
+						 data->metadata,
+						 data->signature,
+						 cancellable,
+						 fwupd_client_refresh_remote_update_cb,
+						 g_steal_pointer(&task));
+}
+#endif
+
+static void
+fwupd_client_refresh_remote_signature_cb(GObject *source, GAsyncResult *res, gpointer user_data)
+{
+	g_autoptr(GBytes) bytes = NULL;
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GTask) task = G_TASK(user_data);
+	FwupdClientRefreshRemoteData *data = g_task_get_task_data(task);
 
 	/* save signature */
 	bytes = fwupd_client_download_bytes_finish(FWUPD_CLIENT(source), res, &error);
@@ -4415,32 +4956,23 @@ fwupd_client_refresh_remote_signature_cb(GObject *source, GAsyncResult *res, gpo
 		}
 	}
 
-	/* maybe get metadata from Passim */
-	if (fwupd_remote_has_flag(data->remote, FWUPD_REMOTE_FLAG_ALLOW_P2P_METADATA) &&
+	/* reconstruct the new metadata from the old copy, downloading only the changed blocks */
+#ifdef HAVE_LIBCURL
+	if ((data->download_flags & FWUPD_CLIENT_DOWNLOAD_FLAG_METADATA_DELTA) > 0 &&
+	    (data->download_flags & FWUPD_CLIENT_DOWNLOAD_FLAG_ONLY_P2P) == 0 &&
 	    fwupd_remote_get_checksum_metadata(data->remote) != NULL &&
-	    fwupd_remote_get_username(data->remote) == NULL &&
-	    fwupd_remote_get_password(data->remote) == NULL) {
-		g_autofree gchar *basename =
-		    g_path_get_basename(fwupd_remote_get_metadata_uri(data->remote));
-		g_ptr_array_add(urls,
-				g_strdup_printf("https://localhost:27500/%s?sha256=%s",
-						basename,
-						fwupd_remote_get_checksum_metadata(data->remote)));
-	}
-	if ((data->download_flags & FWUPD_CLIENT_DOWNLOAD_FLAG_ONLY_P2P) == 0) {
-		g_autofree gchar *uri = fwupd_remote_build_metadata_uri(data->remote, &error);
-		if (uri == NULL) {
-			g_task_return_error(task, g_steal_pointer(&error));
-			return;
-		}
-		g_ptr_array_add(urls, g_steal_pointer(&uri));
+	    fwupd_remote_get_filename_cache(data->remote) != NULL &&
+	    g_file_test(fwupd_remote_get_filename_cache(data->remote), G_FILE_TEST_EXISTS)) {
+		FwupdClient *self = g_task_get_source_object(task);
+		fwupd_client_refresh_remote_delta_async(self,
+							data->remote,
+							g_task_get_cancellable(task),
+							fwupd_client_refresh_remote_delta_cb,
+							g_steal_pointer(&task));
+		return;
 	}
-	fwupd_client_download_bytes2_async(self,
-					   urls,
-					   FWUPD_CLIENT_DOWNLOAD_FLAG_NONE,
-					   cancellable,
-					   fwupd_client_refresh_remote_metadata_cb,
-					   g_steal_pointer(&task));
+#endif
+	fwupd_client_refresh_remote_metadata_download(g_steal_pointer(&task));
 }
 
 /**
@@ -5484,12 +6016,19 @@ fwupd_client_set_user_agent_for_package(FwupdClient *self,
 }
 
 #ifdef HAVE_LIBCURL
+typedef struct {
+	GByteArray *buf;
+	GChecksum *checksum; /* (nullable) */
+} FwupdClientDownloadBuf;
+
 static size_t
 fwupd_client_download_write_callback_cb(char *ptr, size_t size, size_t nmemb, void *userdata)
 {
-	GByteArray *buf = (GByteArray *)userdata;
+	FwupdClientDownloadBuf *dlbuf = (FwupdClientDownloadBuf *)userdata;
 	gsize realsize = size * nmemb;
-	g_byte_array_append(buf, (const guint8 *)ptr, realsize);
+	g_byte_array_append(dlbuf->buf, (const guint8 *)ptr, realsize);
+	if (dlbuf->checksum != NULL)
+		g_checksum_update(dlbuf->checksum, (const guchar *)ptr, (gssize)realsize);
 	return realsize;
 }
 
@@ -5537,13 +6076,131 @@ fwupd_client_download_ipfs(FwupdClient *self,
 	return g_steal_pointer(&bstdout);
 }
 
+#define FWUPD_CLIENT_DOWNLOAD_WINDOW_SZ (1024 * 1024) /* bytes */
+
+static gchar *
+fwupd_client_download_cache_fn(const gchar *checksum_expected);
+
+static void
+fwupd_client_download_partial_remove(const gchar *checksum_expected)
+{
+	g_autofree gchar *fn = fwupd_client_download_cache_fn(checksum_expected);
+	g_autofree gchar *fn_partial = g_strdup_printf("%s.partial", fn);
+	g_autofree gchar *fn_windows = g_strdup_printf("%s.windows", fn);
+	(void)g_unlink(fn_partial);
+	(void)g_unlink(fn_windows);
+}
+
+/* an interrupted transfer is kept beside the download cache along with a digest of every
+ * completed window, so the next attempt revalidates what already arrived and the worst
+ * case retransfer is one window rather than the whole file */
+static void
+fwupd_client_download_partial_save(const gchar *checksum_expected, GByteArray *buf)
+{
+	gsize nwindows = buf->len / FWUPD_CLIENT_DOWNLOAD_WINDOW_SZ;
+	g_autofree gchar *dirname = NULL;
+	g_autofree gchar *fn = fwupd_client_download_cache_fn(checksum_expected);
+	g_autofree gchar *fn_partial = g_strdup_printf("%s.partial", fn);
+	g_autofree gchar *fn_windows = g_strdup_printf("%s.windows", fn);
+	g_autoptr(GString) str = g_string_new(NULL);
+
+	if (nwindows == 0) {
+		fwupd_client_download_partial_remove(checksum_expected);
+		return;
+	}
+	dirname = g_path_get_dirname(fn);
+	if (g_mkdir_with_parents(dirname, 0700) != 0) {
+		g_debug("failed to create %s", dirname);
+		return;
+	}
+	for (gsize i = 0; i < nwindows; i++) {
+		g_autofree gchar *checksum_window = g_compute_checksum_for_data(
+		    G_CHECKSUM_SHA256,
+		    buf->data + i * FWUPD_CLIENT_DOWNLOAD_WINDOW_SZ,
+		    FWUPD_CLIENT_DOWNLOAD_WINDOW_SZ);
+		g_string_append_printf(str, "%s\n", checksum_window);
+	}
+	if (!g_file_set_contents(fn_partial,
+				 (const gchar *)buf->data,
+				 (gssize)(nwindows * FWUPD_CLIENT_DOWNLOAD_WINDOW_SZ),
+				 NULL) ||
+	    !g_file_set_contents(fn_windows, str->str, -1, NULL)) {
+		g_debug("failed to save partial download for %s", checksum_expected);
+		fwupd_client_download_partial_remove(checksum_expected);
+		return;
+	}
+	g_info("saved %u windows of partial download for %s", (guint)nwindows, checksum_expected);
+}
+
+/* returns the number of bytes appended to @buf, i.e. the longest prefix of complete
+ * windows that still matches the recorded digests */
+static gsize
+fwupd_client_download_partial_load(const gchar *checksum_expected, GByteArray *buf)
+{
+	gsize datasz = 0;
+	gsize validsz = 0;
+	g_autofree gchar *data = NULL;
+	g_autofree gchar *fn = fwupd_client_download_cache_fn(checksum_expected);
+	g_autofree gchar *fn_partial = g_strdup_printf("%s.partial", fn);
+	g_autofree gchar *fn_windows = g_strdup_printf("%s.windows", fn);
+	g_autofree gchar *windows = NULL;
+	g_auto(GStrv) lines = NULL;
+
+	if (!g_file_get_contents(fn_partial, &data, &datasz, NULL))
+		return 0;
+	if (!g_file_get_contents(fn_windows, &windows, NULL, NULL))
+		return 0;
+	lines = g_strsplit(windows, "\n", -1);
+	for (guint i = 0; lines[i] != NULL && lines[i][0] != '\0'; i++) {
+		g_autofree gchar *checksum_window = NULL;
+		if (validsz + FWUPD_CLIENT_DOWNLOAD_WINDOW_SZ > datasz)
+			break;
+		checksum_window =
+		    g_compute_checksum_for_data(G_CHECKSUM_SHA256,
+						(const guchar *)data + validsz,
+						FWUPD_CLIENT_DOWNLOAD_WINDOW_SZ);
+		if (g_strcmp0(checksum_window, lines[i]) != 0)
+			break;
+		validsz += FWUPD_CLIENT_DOWNLOAD_WINDOW_SZ;
+	}
+	if (validsz == 0)
+		return 0;
+	g_byte_array_append(buf, (const guint8 *)data, validsz);
+	return validsz;
+}
+
 static GBytes *
-fwupd_client_download_http(FwupdClient *self, CURL *curl, const gchar *url, GError **error)
+fwupd_client_download_http(FwupdClient *self,
+			   CURL *curl,
+			   GChecksum *checksum,
+			   const gchar *checksum_expected,
+			   const gchar *url,
+			   GError **error)
 {
 	CURLcode res;
 	gchar errbuf[CURL_ERROR_SIZE] = {'\0'};
 	glong status_code = 0;
+	gsize resumesz = 0;
 	g_autoptr(GByteArray) buf = g_byte_array_new();
+	FwupdClientDownloadBuf dlbuf = {.buf = buf, .checksum = checksum};
+
+	/* a retried transfer has to digest from the very start */
+	if (checksum != NULL)
+		g_checksum_reset(checksum);
+
+	/* revalidate and reuse any interrupted transfer of this exact file, asking the
+	 * server for just the bytes we do not have yet */
+	if (checksum_expected != NULL) {
+		resumesz = fwupd_client_download_partial_load(checksum_expected, buf);
+		if (resumesz > 0) {
+			g_info("resuming download of %s at 0x%x", url, (guint)resumesz);
+			if (checksum != NULL)
+				g_checksum_update(checksum, buf->data, (gssize)resumesz);
+			(void)curl_easy_setopt(curl,
+					       CURLOPT_RESUME_FROM_LARGE,
+					       (curl_off_t)resumesz);
+		}
+	}
 
 	/* relax the SSL checks on localhost URLs and broken corporate proxies */
 	if (fwupd_client_is_localhost(url) || g_getenv("DISABLE_SSL_STRICT") != NULL) {
@@ -5560,11 +6217,15 @@ fwupd_client_download_http(FwupdClient *self, CURL *curl, const gchar *url, GErr
 	(void)curl_easy_setopt(curl,
 			       CURLOPT_WRITEFUNCTION,
 			       fwupd_client_download_write_callback_cb);
-	(void)curl_easy_setopt(curl, CURLOPT_WRITEDATA, buf);
+	(void)curl_easy_setopt(curl, CURLOPT_WRITEDATA, &dlbuf);
 	res = curl_easy_perform(curl);
+	(void)curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, (curl_off_t)0);
 	fwupd_client_set_status(self, FWUPD_STATUS_IDLE);
 	fwupd_client_set_percentage(self, 100);
 	if (res != CURLE_OK) {
+		/* keep the complete windows for the next attempt */
+		if (checksum_expected != NULL)
+			fwupd_client_download_partial_save(checksum_expected, buf);
 		if (errbuf[0] != '\0') {
 			g_set_error(error,
 				    FWUPD_ERROR,
@@ -5584,6 +6245,23 @@ fwupd_client_download_http(FwupdClient *self, CURL *curl, const gchar *url, GErr
 	/* check for server limit */
 	curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status_code);
 	g_info("status-code was %ld", status_code);
+	if (status_code == 200 && resumesz > 0) {
+		/* the server ignored the range request and sent the whole file again, so
+		 * the prefix we seeded is stale */
+		g_byte_array_remove_range(buf, 0, resumesz);
+		if (checksum != NULL) {
+			g_checksum_reset(checksum);
+			g_checksum_update(checksum, buf->data, (gssize)buf->len);
+		}
+	}
+	if (status_code == 416 && resumesz > 0) {
+		fwupd_client_download_partial_remove(checksum_expected);
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_TIMED_OUT,
+				    "resume rejected by server, retrying from the start");
+		return NULL;
+	}
 	if (status_code == 429) {
 		g_set_error_literal(error,
 				    FWUPD_ERROR,
@@ -5628,6 +6306,9 @@ fwupd_client_download_http(FwupdClient *self, CURL *curl, const gchar *url, GErr
 		return NULL;
 	}
 
+	/* the whole file arrived so the partial state is no longer interesting */
+	if (checksum_expected != NULL)
+		fwupd_client_download_partial_remove(checksum_expected);
 	return g_bytes_new(buf->data, buf->len);
 }
 
@@ -5640,7 +6321,12 @@ fwupd_client_download_error_is_fatal(const GError *error)
 }
 
 static GBytes *
-fwupd_client_download_http_retry(FwupdClient *self, CURL *curl, const gchar *url, GError **error)
+fwupd_client_download_http_retry(FwupdClient *self,
+				 CURL *curl,
+				 GChecksum *checksum,
+				 const gchar *checksum_expected,
+				 const gchar *url,
+				 GError **error)
 {
 	FwupdClientPrivate *priv = GET_PRIVATE(self);
 	gulong delay_ms = 2500;
@@ -5648,7 +6334,12 @@ fwupd_client_download_http_retry(FwupdClient *self, CURL *curl, const gchar *url
 		g_autoptr(GBytes) blob = NULL;
 		g_autoptr(GError) error_local = NULL;
 
-		blob = fwupd_client_download_http(self, curl, url, &error_local);
+		blob = fwupd_client_download_http(self,
+						  curl,
+						  checksum,
+						  checksum_expected,
+						  url,
+						  &error_local);
 		if (blob != NULL)
 			return g_steal_pointer(&blob);
 		if (i >= priv->download_retries ||
@@ -5661,64 +6352,410 @@ fwupd_client_download_http_retry(FwupdClient *self, CURL *curl, const gchar *url
 	}
 	return NULL;
 }
+
+#define FWUPD_CLIENT_METADATA_DELTA_BLOCKSZ_MAX (4 * 1024 * 1024)   /* bytes */
+#define FWUPD_CLIENT_METADATA_DELTA_FILESZ_MAX	(512 * 1024 * 1024) /* bytes */
+
+static GBytes *
+fwupd_client_refresh_remote_delta_reconstruct(FwupdClient *self,
+					      FwupdCurlHelper *helper,
+					      FwupdRemote *remote,
+					      const gchar *metadata_uri,
+					      GBytes *blob_manifest,
+					      GError **error)
+{
+	GChecksumType checksum_kind;
+	const gchar *checksum_expected = fwupd_remote_get_checksum_metadata(remote);
+	gsize localsz = 0;
+	guint64 blocksz = 0;
+	guint64 filesz = 0;
+	guint blocks_changed = 0;
+	g_autofree gboolean *matched = NULL;
+	g_autofree gchar *checksum_actual = NULL;
+	g_autofree gchar *local = NULL;
+	g_autofree gchar *manifest_str = NULL;
+	g_autofree guint8 *buf = NULL;
+	g_auto(GStrv) lines = NULL;
+	g_autoptr(GPtrArray) checksums = g_ptr_array_new();
+
+	/* parse the manifest: a blocksz and filesz line, then one checksum per block */
+	manifest_str = g_strndup((const gchar *)g_bytes_get_data(blob_manifest, NULL),
+				 g_bytes_get_size(blob_manifest));
+	lines = g_strsplit(manifest_str, "\n", -1);
+	for (guint i = 0; lines[i] != NULL; i++) {
+		if (g_str_has_prefix(lines[i], "blocksz=")) {
+			blocksz = g_ascii_strtoull(lines[i] + strlen("blocksz="), NULL, 10);
+			continue;
+		}
+		if (g_str_has_prefix(lines[i], "filesz=")) {
+			filesz = g_ascii_strtoull(lines[i] + strlen("filesz="), NULL, 10);
+			continue;
+		}
+		if (lines[i][0] == '\0' || lines[i][0] == '#')
+			continue;
+		g_ptr_array_add(checksums, lines[i]);
+	}
+	if (blocksz == 0 || blocksz > FWUPD_CLIENT_METADATA_DELTA_BLOCKSZ_MAX || filesz == 0 ||
+	    filesz > FWUPD_CLIENT_METADATA_DELTA_FILESZ_MAX) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_FILE,
+			    "manifest invalid, blocksz %" G_GUINT64_FORMAT " and filesz %" G_GUINT64_FORMAT,
+			    blocksz,
+			    filesz);
+		return NULL;
+	}
+	if ((guint64)checksums->len != (filesz + blocksz - 1) / blocksz) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_FILE,
+			    "manifest invalid, got %u checksums for %" G_GUINT64_FORMAT " bytes",
+			    checksums->len,
+			    filesz);
+		return NULL;
+	}
+	checksum_kind = fwupd_checksum_guess_kind(g_ptr_array_index(checksums, 0));
+
+	/* the old metadata we are patching */
+	if (!g_file_get_contents(fwupd_remote_get_filename_cache(remote), &local, &localsz, error))
+		return NULL;
+
+	/* reuse any local block with an identical checksum */
+	buf = g_malloc0(filesz);
+	matched = g_new0(gboolean, checksums->len);
+	for (guint i = 0; i < checksums->len; i++) {
+		const gchar *checksum_block = g_ptr_array_index(checksums, i);
+		guint64 offset = (guint64)i * blocksz;
+		gsize chksz = MIN(blocksz, filesz - offset);
+		if (offset + chksz <= localsz) {
+			g_autofree gchar *checksum_local =
+			    g_compute_checksum_for_data(checksum_kind,
+							(const guchar *)local + offset,
+							chksz);
+			if (g_strcmp0(checksum_local, checksum_block) == 0) {
+				memcpy(buf + offset, local + offset, chksz); /* nocheck:blocked */
+				matched[i] = TRUE;
+			}
+		}
+		if (!matched[i])
+			blocks_changed++;
+	}
+
+	/* fetch each run of changed blocks as a single range */
+	for (guint i = 0; i < checksums->len; i++) {
+		guint j;
+		guint64 offset = (guint64)i * blocksz;
+		guint64 offset_end;
+		g_autofree gchar *range = NULL;
+		g_autoptr(GBytes) blob_range = NULL;
+
+		if (matched[i])
+			continue;
+		for (j = i; j < checksums->len && !matched[j]; j++)
+			;
+		offset_end = MIN((guint64)j * blocksz, filesz);
+		range = g_strdup_printf("%" G_GUINT64_FORMAT "-%" G_GUINT64_FORMAT,
+					offset,
+					offset_end - 1);
+		g_debug("downloading range %s of %s", range, metadata_uri);
+		(void)curl_easy_setopt(helper->curl, CURLOPT_RANGE, range);
+		blob_range = fwupd_client_download_http_retry(self,
+							      helper->curl,
+							      NULL,
+							      NULL,
+							      metadata_uri,
+							      error);
+		(void)curl_easy_setopt(helper->curl, CURLOPT_RANGE, NULL);
+		if (blob_range == NULL)
+			return NULL;
+		if (g_bytes_get_size(blob_range) != offset_end - offset) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INVALID_FILE,
+				    "server returned 0x%x bytes for a range of 0x%x",
+				    (guint)g_bytes_get_size(blob_range),
+				    (guint)(offset_end - offset));
+			return NULL;
+		}
+		memcpy(buf + offset, /* nocheck:blocked */
+		       g_bytes_get_data(blob_range, NULL),
+		       offset_end - offset);
+		i = j;
+	}
+	g_info("delta refresh downloaded %u of %u blocks", blocks_changed, checksums->len);
+
+	/* verify the reassembled file is exactly what the signature covers */
+	checksum_actual = g_compute_checksum_for_data(fwupd_checksum_guess_kind(checksum_expected),
+						      (const guchar *)buf,
+						      filesz);
+	if (g_strcmp0(checksum_actual, checksum_expected) != 0) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_FILE,
+			    "reconstructed metadata checksum expected %s and got %s",
+			    checksum_expected,
+			    checksum_actual);
+		return NULL;
+	}
+
+	/* success */
+	return g_bytes_new_take(g_steal_pointer(&buf), filesz);
+}
+
 static void
-fwupd_client_download_bytes_thread_cb(GTask *task,
-				      gpointer source_object,
-				      gpointer task_data,
-				      GCancellable *cancellable)
+fwupd_client_refresh_remote_delta_thread_cb(GTask *task,
+					    gpointer source_object,
+					    gpointer task_data,
+					    GCancellable *cancellable)
 {
 	FwupdClient *self = FWUPD_CLIENT(source_object);
-	FwupdCurlHelper *helper = g_task_get_task_data(task);
+	FwupdRemote *remote = FWUPD_REMOTE(task_data);
+	g_autofree gchar *manifest_uri = NULL;
+	g_autofree gchar *metadata_uri = NULL;
+	g_autoptr(FwupdCurlHelper) helper = NULL;
 	g_autoptr(GBytes) blob = NULL;
+	g_autoptr(GBytes) blob_manifest = NULL;
+	g_autoptr(GError) error = NULL;
+
+	metadata_uri = fwupd_remote_build_metadata_uri(remote, &error);
+	if (metadata_uri == NULL) {
+		g_task_return_error(task, g_steal_pointer(&error));
+		return;
+	}
+	helper = fwupd_client_curl_new(self, &error);
+	if (helper == NULL) {
+		g_task_return_error(task, g_steal_pointer(&error));
+		return;
+	}
+	if (!fwupd_client_curl_helper_set_proxy(self, helper, metadata_uri, &error)) {
+		g_task_return_error(task, g_steal_pointer(&error));
+		return;
+	}
+
+	/* the manifest is tiny and may well not exist, so do not retry */
+	manifest_uri = g_strdup_printf("%s.manifest", metadata_uri);
+	blob_manifest =
+	    fwupd_client_download_http(self, helper->curl, NULL, NULL, manifest_uri, &error);
+	if (blob_manifest == NULL) {
+		g_task_return_error(task, g_steal_pointer(&error));
+		return;
+	}
+	blob = fwupd_client_refresh_remote_delta_reconstruct(self,
+							     helper,
+							     remote,
+							     metadata_uri,
+							     blob_manifest,
+							     &error);
+	if (blob == NULL) {
+		g_task_return_error(task, g_steal_pointer(&error));
+		return;
+	}
+	g_task_return_pointer(task, g_steal_pointer(&blob), (GDestroyNotify)g_bytes_unref);
+}
+
+static void
+fwupd_client_refresh_remote_delta_async(FwupdClient *self,
+					FwupdRemote *remote,
+					GCancellable *cancellable,
+					GAsyncReadyCallback callback,
+					gpointer callback_data)
+{
+	g_autoptr(GTask) task = g_task_new(self, cancellable, callback, callback_data);
+	g_task_set_task_data(task, g_object_ref(remote), (GDestroyNotify)g_object_unref);
+	g_task_run_in_thread(task, fwupd_client_refresh_remote_delta_thread_cb);
+}
+
+static gchar *
+fwupd_client_download_cache_fn(const gchar *checksum_expected)
+{
+	return g_build_filename(g_get_user_cache_dir(),
+				"fwupd",
+				"downloads",
+				checksum_expected,
+				NULL);
+}
+
+/* the cache is content-addressed, so a file that does not match its own name is just garbage
+ * from an interrupted writer and is ignored */
+static GBytes *
+fwupd_client_download_cache_load(const gchar *checksum_expected)
+{
+	gchar *data = NULL;
+	gsize len = 0;
+	g_autofree gchar *checksum_actual = NULL;
+	g_autofree gchar *fn = fwupd_client_download_cache_fn(checksum_expected);
+	g_autoptr(GBytes) blob = NULL;
+
+	if (!g_file_get_contents(fn, &data, &len, NULL))
+		return NULL;
+	blob = g_bytes_new_take(data, len);
+	checksum_actual =
+	    g_compute_checksum_for_bytes(fwupd_checksum_guess_kind(checksum_expected), blob);
+	if (g_strcmp0(checksum_actual, checksum_expected) != 0) {
+		g_debug("ignoring invalid cache file %s", fn);
+		return NULL;
+	}
+	g_info("using cached download for %s", checksum_expected);
+	return g_steal_pointer(&blob);
+}
+
+static void
+fwupd_client_download_cache_save(const gchar *checksum_expected, GBytes *blob)
+{
+	g_autofree gchar *dirname = NULL;
+	g_autofree gchar *fn = fwupd_client_download_cache_fn(checksum_expected);
+	g_autoptr(GError) error_local = NULL;
+
+	dirname = g_path_get_dirname(fn);
+	if (g_mkdir_with_parents(dirname, 0700) != 0) {
+		g_debug("failed to create %s", dirname);
+		return;
+	}
+	/* g_file_set_contents writes a same-directory temp file and renames it over the
+	 * destination, so concurrent clients can never observe a partial download */
+	if (!g_file_set_contents(fn,
+				 g_bytes_get_data(blob, NULL),
+				 g_bytes_get_size(blob),
+				 &error_local))
+		g_debug("failed to save cache file %s: %s", fn, error_local->message);
+}
+
+static GBytes *
+fwupd_client_download_bytes_worker(FwupdClient *self,
+				   FwupdCurlHelper *helper,
+				   GCancellable *cancellable,
+				   GError **error)
+{
+	g_autoptr(GBytes) blob = NULL;
+
+	/* served from the local content-addressed cache? */
+	if (helper->checksum_expected != NULL) {
+		blob = fwupd_client_download_cache_load(helper->checksum_expected);
+		if (blob != NULL)
+			return g_steal_pointer(&blob);
+	}
 
 	for (guint i = 0; i < helper->urls->len; i++) {
 		const gchar *url = g_ptr_array_index(helper->urls, i);
-		g_autoptr(GError) error = NULL;
+		gboolean checksum_streamed = FALSE;
+		g_autoptr(GError) error_local = NULL;
 		g_info("downloading %s", url);
-		if (!fwupd_client_curl_helper_set_proxy(self, helper, url, &error)) {
-			g_task_return_error(task, g_steal_pointer(&error));
-			return;
-		}
+		if (!fwupd_client_curl_helper_set_proxy(self, helper, url, error))
+			return NULL;
 		if (fwupd_client_is_url_http(url)) {
-			blob = fwupd_client_download_http_retry(self, helper->curl, url, &error);
-			if (blob != NULL)
-				break;
+			blob = fwupd_client_download_http_retry(self,
+								helper->curl,
+								helper->checksum,
+								helper->checksum_expected,
+								url,
+								&error_local);
+			checksum_streamed = helper->checksum != NULL;
 		} else if (fwupd_client_is_url_ipfs(url)) {
-			blob = fwupd_client_download_ipfs(self, url, cancellable, &error);
-			if (blob != NULL)
-				break;
+			blob = fwupd_client_download_ipfs(self, url, cancellable, &error_local);
 		} else {
-			g_set_error(&error,
+			g_set_error(&error_local,
 				    FWUPD_ERROR,
 				    FWUPD_ERROR_INVALID_FILE,
 				    "not sure how to handle: %s",
 				    url);
 		}
+
+		/* for HTTP the digest was already fed during the transfer */
+		if (blob != NULL && helper->checksum_expected != NULL) {
+			g_autofree gchar *checksum_actual = NULL;
+			if (checksum_streamed) {
+				checksum_actual = g_strdup(g_checksum_get_string(helper->checksum));
+			} else {
+				checksum_actual = g_compute_checksum_for_bytes(
+				    fwupd_checksum_guess_kind(helper->checksum_expected),
+				    blob);
+			}
+			if (g_strcmp0(helper->checksum_expected, checksum_actual) != 0) {
+				g_set_error(&error_local,
+					    FWUPD_ERROR,
+					    FWUPD_ERROR_INVALID_FILE,
+					    "checksum invalid, expected %s got %s",
+					    helper->checksum_expected,
+					    checksum_actual);
+				g_clear_pointer(&blob, g_bytes_unref);
+			}
+		}
+		if (blob != NULL)
+			break;
 		if (i == helper->urls->len - 1) {
-			g_task_return_error(task, g_steal_pointer(&error));
-			return;
+			g_propagate_error(error, g_steal_pointer(&error_local));
+			return NULL;
 		}
 		fwupd_client_set_percentage(self, 0);
 		fwupd_client_set_status(self, FWUPD_STATUS_IDLE);
-		g_info("failed to download %s: %s, trying next URI…", url, error->message);
+		g_info("failed to download %s: %s, trying next URI…", url, error_local->message);
+	}
+
+	/* the blob was verified against the checksum, so other clients can reuse it */
+	if (blob != NULL && helper->checksum_expected != NULL)
+		fwupd_client_download_cache_save(helper->checksum_expected, blob);
+	return g_steal_pointer(&blob);
+}
+
+static void
+fwupd_client_download_bytes_thread_cb(GTask *task,
+				      gpointer source_object,
+				      gpointer task_data,
+				      GCancellable *cancellable)
+{
+	FwupdClient *self = FWUPD_CLIENT(source_object);
+	FwupdClientPrivate *priv = GET_PRIVATE(self);
+	FwupdCurlHelper *helper = g_task_get_task_data(task);
+	g_autoptr(GBytes) blob = NULL;
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GPtrArray) tasks = NULL;
+
+	/* cap the number of transfers running at the same time; the slot is taken in thread
+	 * context so the async call itself never blocks the caller */
+	g_mutex_lock(&priv->download_mutex);
+	while (priv->downloads_active >= FWUPD_CLIENT_DOWNLOADS_MAX)
+		g_cond_wait(&priv->download_cond, &priv->download_mutex);
+	priv->downloads_active++;
+	g_mutex_unlock(&priv->download_mutex);
+
+	blob = fwupd_client_download_bytes_worker(self, helper, cancellable, &error);
+
+	/* resolve every task that piggybacked onto this transfer, including our own */
+	g_mutex_lock(&priv->download_mutex);
+	priv->downloads_active--;
+	g_cond_broadcast(&priv->download_cond);
+	tasks = g_ptr_array_ref(g_hash_table_lookup(priv->download_tasks, helper->singleflight_id));
+	g_hash_table_remove(priv->download_tasks, helper->singleflight_id);
+	g_mutex_unlock(&priv->download_mutex);
+	for (guint i = 0; i < tasks->len; i++) {
+		GTask *task_tmp = g_ptr_array_index(tasks, i);
+		if (blob != NULL) {
+			g_task_return_pointer(task_tmp,
+					      g_bytes_ref(blob),
+					      (GDestroyNotify)g_bytes_unref);
+		} else {
+			g_task_return_error(task_tmp, g_error_copy(error));
+		}
 	}
-	g_task_return_pointer(task, g_steal_pointer(&blob), (GDestroyNotify)g_bytes_unref);
 }
 #endif
 
-/* private */
-void
-fwupd_client_download_bytes2_async(FwupdClient *self,
-				   GPtrArray *urls,
-				   FwupdClientDownloadFlags flags,
-				   GCancellable *cancellable,
-				   GAsyncReadyCallback callback,
-				   gpointer callback_data)
+static void
+fwupd_client_download_bytes_full_async(FwupdClient *self,
+				       GPtrArray *urls,
+				       const gchar *checksum_expected,
+				       FwupdClientDownloadFlags flags,
+				       GCancellable *cancellable,
+				       GAsyncReadyCallback callback,
+				       gpointer callback_data)
 {
 	g_autoptr(GTask) task = NULL;
 #ifdef HAVE_LIBCURL
+	FwupdClientPrivate *priv = GET_PRIVATE(self);
+	GPtrArray *tasks;
 	g_autoptr(GError) error = NULL;
 	g_autoptr(FwupdCurlHelper) helper = NULL;
+	g_autoptr(GString) singleflight_id = NULL;
 #endif
 
 	g_return_if_fail(FWUPD_IS_CLIENT(self));
@@ -5738,6 +6775,37 @@ fwupd_client_download_bytes2_async(FwupdClient *self,
 		g_task_return_error(task, g_steal_pointer(&error));
 		return;
 	}
+	if (checksum_expected != NULL) {
+		const gchar *peer_cache_uri = g_getenv("FWUPD_PEER_CACHE_URI");
+		helper->checksum_expected = g_strdup(checksum_expected);
+		helper->checksum = g_checksum_new(fwupd_checksum_guess_kind(checksum_expected));
+
+		/* try a LAN-local peer cache serving content-addressed files before the WAN
+		 * mirrors; any failure just falls through to the next URI */
+		if (peer_cache_uri != NULL) {
+			g_ptr_array_insert(
+			    helper->urls,
+			    0,
+			    g_strdup_printf("%s/%s", peer_cache_uri, checksum_expected));
+		}
+	}
+	/* an identical request already in flight shares the one transfer rather than
+	 * fetching the same file twice */
+	singleflight_id = g_string_new(checksum_expected);
+	for (guint i = 0; i < helper->urls->len; i++)
+		g_string_append(singleflight_id, g_ptr_array_index(helper->urls, i));
+	helper->singleflight_id = g_strdup(singleflight_id->str);
+	g_mutex_lock(&priv->download_mutex);
+	tasks = g_hash_table_lookup(priv->download_tasks, helper->singleflight_id);
+	if (tasks != NULL) {
+		g_ptr_array_add(tasks, g_object_ref(task));
+		g_mutex_unlock(&priv->download_mutex);
+		return;
+	}
+	tasks = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	g_ptr_array_add(tasks, g_object_ref(task));
+	g_hash_table_insert(priv->download_tasks, g_strdup(helper->singleflight_id), tasks);
+	g_mutex_unlock(&priv->download_mutex);
 	g_task_set_task_data(task,
 			     g_steal_pointer(&helper),
 			     (GDestroyNotify)fwupd_client_curl_helper_free);
@@ -5749,6 +6817,95 @@ fwupd_client_download_bytes2_async(FwupdClient *self,
 #endif
 }
 
+/* private */
+void
+fwupd_client_download_bytes2_async(FwupdClient *self,
+				   GPtrArray *urls,
+				   FwupdClientDownloadFlags flags,
+				   GCancellable *cancellable,
+				   GAsyncReadyCallback callback,
+				   gpointer callback_data)
+{
+	fwupd_client_download_bytes_full_async(self,
+					       urls,
+					       NULL,
+					       flags,
+					       cancellable,
+					       callback,
+					       callback_data);
+}
+
+/**
+ * fwupd_client_download_bytes_verify_async:
+ * @self: a #FwupdClient
+ * @url: (not nullable): the remote URL
+ * @checksum: (not nullable): the expected payload checksum, e.g. a SHA-256 hash
+ * @flags: download flags, e.g. %FWUPD_CLIENT_DOWNLOAD_FLAG_NONE
+ * @cancellable: (nullable): optional #GCancellable
+ * @callback: (scope async) (closure callback_data): the function to run on completion
+ * @callback_data: the data to pass to @callback
+ *
+ * Downloads data from a remote server and verifies it against the supplied checksum.
+ * The digest is computed incrementally as the bytes arrive, so the verification cost is
+ * hidden behind the transfer rather than added after it.
+ *
+ * You must have called [method@Client.connect_async] on @self before using
+ * this method.
+ *
+ * NOTE: This method is thread-safe, but progress signals will be
+ * emitted in the global default main context, if not explicitly set with
+ * [method@Client.set_main_context].
+ *
+ * Since: 2.0.3
+ **/
+void
+fwupd_client_download_bytes_verify_async(FwupdClient *self,
+					 const gchar *url,
+					 const gchar *checksum,
+					 FwupdClientDownloadFlags flags,
+					 GCancellable *cancellable,
+					 GAsyncReadyCallback callback,
+					 gpointer callback_data)
+{
+	g_autoptr(GPtrArray) urls = g_ptr_array_new_with_free_func(g_free);
+
+	g_return_if_fail(FWUPD_IS_CLIENT(self));
+	g_return_if_fail(url != NULL);
+	g_return_if_fail(checksum != NULL);
+	g_return_if_fail(cancellable == NULL || G_IS_CANCELLABLE(cancellable));
+
+	/* just proxy */
+	g_ptr_array_add(urls, g_strdup(url));
+	fwupd_client_download_bytes_full_async(self,
+					       urls,
+					       checksum,
+					       flags,
+					       cancellable,
+					       callback,
+					       callback_data);
+}
+
+/**
+ * fwupd_client_download_bytes_verify_finish:
+ * @self: a #FwupdClient
+ * @res: (not nullable): the asynchronous result
+ * @error: (nullable): optional return location for an error
+ *
+ * Gets the result of [method@FwupdClient.download_bytes_verify_async].
+ *
+ * Returns: (transfer full): downloaded data, or %NULL for error
+ *
+ * Since: 2.0.3
+ **/
+GBytes *
+fwupd_client_download_bytes_verify_finish(FwupdClient *self, GAsyncResult *res, GError **error)
+{
+	g_return_val_if_fail(FWUPD_IS_CLIENT(self), NULL);
+	g_return_val_if_fail(g_task_is_valid(res, self), NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+	return g_task_propagate_pointer(G_TASK(res), error);
+}
+
 /**
  * fwupd_client_download_bytes_async:
  * @self: a #FwupdClient
@@ -5822,12 +6979,13 @@ fwupd_client_upload_bytes_thread_cb(GTask *task,
 	CURLcode res;
 	gchar errbuf[CURL_ERROR_SIZE] = {'\0'};
 	g_autoptr(GByteArray) buf = g_byte_array_new();
+	FwupdClientDownloadBuf dlbuf = {.buf = buf, .checksum = NULL};
 
 	(void)curl_easy_setopt(helper->curl, CURLOPT_ERRORBUFFER, errbuf);
 	(void)curl_easy_setopt(helper->curl,
 			       CURLOPT_WRITEFUNCTION,
 			       fwupd_client_download_write_callback_cb);
-	(void)curl_easy_setopt(helper->curl, CURLOPT_WRITEDATA, buf);
+	(void)curl_easy_setopt(helper->curl, CURLOPT_WRITEDATA, &dlbuf);
 	res = curl_easy_perform(helper->curl);
 	fwupd_client_set_status(self, FWUPD_STATUS_IDLE);
 	if (res != CURLE_OK) {
@@ -7594,6 +8752,17 @@ fwupd_client_init(FwupdClient *self)
 	priv->battery_threshold = FWUPD_BATTERY_LEVEL_INVALID;
 	priv->immediate_requests =
 	    g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_object_unref);
+#ifdef HAVE_LIBCURL
+	for (guint i = 0; i < CURL_LOCK_DATA_LAST; i++)
+		g_mutex_init(&priv->curl_share_mutex[i]);
+	g_mutex_init(&priv->download_mutex);
+	g_cond_init(&priv->download_cond);
+	priv->download_tasks = g_hash_table_new_full(g_str_hash,
+						     g_str_equal,
+						     g_free,
+						     (GDestroyNotify)g_ptr_array_unref);
+	priv->curl_share = fwupd_client_curl_share_new(self);
+#endif
 
 	/* we get this one for free */
 	fwupd_client_add_hint(self, "locale", g_getenv("LANG"));
@@ -7617,6 +8786,8 @@ fwupd_client_finalize(GObject *object)
 	g_free(priv->host_security_id);
 	g_hash_table_unref(priv->hints);
 	g_hash_table_unref(priv->immediate_requests);
+	if (priv->device_pool != NULL)
+		g_hash_table_unref(priv->device_pool);
 	g_mutex_clear(&priv->idle_mutex);
 	if (priv->idle_id != 0)
 		g_source_remove(priv->idle_id);
@@ -7624,6 +8795,15 @@ fwupd_client_finalize(GObject *object)
 	g_mutex_clear(&priv->proxy_mutex);
 	if (priv->proxy != NULL)
 		g_object_unref(priv->proxy);
+#ifdef HAVE_LIBCURL
+	if (priv->curl_share != NULL)
+		curl_share_cleanup(priv->curl_share);
+	for (guint i = 0; i < CURL_LOCK_DATA_LAST; i++)
+		g_mutex_clear(&priv->curl_share_mutex[i]);
+	g_hash_table_unref(priv->download_tasks);
+	g_cond_clear(&priv->download_cond);
+	g_mutex_clear(&priv->download_mutex);
+#endif
 
 	G_OBJECT_CLASS(fwupd_client_parent_class)->finalize(object);
 }
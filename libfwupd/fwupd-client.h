@@ -59,6 +59,16 @@ typedef enum {
 	 * Since: 1.9.4
 	 */
 	FWUPD_CLIENT_DOWNLOAD_FLAG_ONLY_P2P = 1 << 0,
+	/**
+	 * FWUPD_CLIENT_DOWNLOAD_FLAG_METADATA_DELTA:
+	 *
+	 * Try to reconstruct the metadata from the locally cached copy using a
+	 * block manifest and HTTP range requests, falling back to a full
+	 * download if the server does not provide a manifest.
+	 *
+	 * Since: 2.0.3
+	 */
+	FWUPD_CLIENT_DOWNLOAD_FLAG_METADATA_DELTA = 1 << 1,
 	/*< private >*/
 	FWUPD_CLIENT_DOWNLOAD_FLAG_LAST
 } FwupdClientDownloadFlags;
@@ -125,6 +135,29 @@ fwupd_client_get_devices_finish(FwupdClient *self,
 				GAsyncResult *res,
 				GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
 void
+fwupd_client_get_devices_full_async(FwupdClient *self,
+				    FwupdDeviceFlags flags,
+				    const gchar *vendor_id,
+				    guint offset,
+				    guint limit,
+				    GCancellable *cancellable,
+				    GAsyncReadyCallback callback,
+				    gpointer callback_data) G_GNUC_NON_NULL(1);
+GPtrArray *
+fwupd_client_get_devices_full_finish(FwupdClient *self,
+				     GAsyncResult *res,
+				     GError **error) G_GNUC_WARN_UNUSED_RESULT
+    G_GNUC_NON_NULL(1, 2);
+void
+fwupd_client_get_inventory_async(FwupdClient *self,
+				 GCancellable *cancellable,
+				 GAsyncReadyCallback callback,
+				 gpointer callback_data) G_GNUC_NON_NULL(1);
+GPtrArray *
+fwupd_client_get_inventory_finish(FwupdClient *self,
+				  GAsyncResult *res,
+				  GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
+void
 fwupd_client_get_plugins_async(FwupdClient *self,
 			       GCancellable *cancellable,
 			       GAsyncReadyCallback callback,
@@ -153,6 +186,18 @@ fwupd_client_get_releases_finish(FwupdClient *self,
 				 GAsyncResult *res,
 				 GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
 void
+fwupd_client_get_release_details_async(FwupdClient *self,
+				       const gchar *device_id,
+				       const gchar *version,
+				       GCancellable *cancellable,
+				       GAsyncReadyCallback callback,
+				       gpointer callback_data) G_GNUC_NON_NULL(1, 2, 3);
+FwupdRelease *
+fwupd_client_get_release_details_finish(FwupdClient *self,
+					GAsyncResult *res,
+					GError **error) G_GNUC_WARN_UNUSED_RESULT
+    G_GNUC_NON_NULL(1, 2);
+void
 fwupd_client_get_downgrades_async(FwupdClient *self,
 				  const gchar *device_id,
 				  GCancellable *cancellable,
@@ -605,6 +650,10 @@ fwupd_client_set_feature_flags_finish(FwupdClient *self,
 				      GAsyncResult *res,
 				      GError **error) G_GNUC_WARN_UNUSED_RESULT
     G_GNUC_NON_NULL(1, 2);
+gboolean
+fwupd_client_get_persist_devices(FwupdClient *self) G_GNUC_NON_NULL(1);
+void
+fwupd_client_set_persist_devices(FwupdClient *self, gboolean persist_devices) G_GNUC_NON_NULL(1);
 const gchar *
 fwupd_client_get_user_agent(FwupdClient *self) G_GNUC_NON_NULL(1);
 void
@@ -625,6 +674,19 @@ fwupd_client_download_bytes_finish(FwupdClient *self,
 				   GAsyncResult *res,
 				   GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
 void
+fwupd_client_download_bytes_verify_async(FwupdClient *self,
+					 const gchar *url,
+					 const gchar *checksum,
+					 FwupdClientDownloadFlags flags,
+					 GCancellable *cancellable,
+					 GAsyncReadyCallback callback,
+					 gpointer callback_data) G_GNUC_NON_NULL(1, 2, 3);
+GBytes *
+fwupd_client_download_bytes_verify_finish(FwupdClient *self,
+					  GAsyncResult *res,
+					  GError **error) G_GNUC_WARN_UNUSED_RESULT
+    G_GNUC_NON_NULL(1, 2);
+void
 fwupd_client_download_set_retries(FwupdClient *self, guint retries) G_GNUC_NON_NULL(1);
 void
 fwupd_client_upload_bytes_async(FwupdClient *self,
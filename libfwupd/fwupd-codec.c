@@ -224,6 +224,111 @@ fwupd_codec_to_json(FwupdCodec *self, JsonBuilder *builder, FwupdCodecFlags flag
 	iface->add_json(self, builder, flags);
 }
 
+static void
+fwupd_codec_json_append_string_escaped(GString *str, const gchar *value)
+{
+	g_string_append_c(str, '"');
+	for (guint i = 0; value[i] != '\0'; i++) {
+		const gchar c = value[i];
+		if (c == '"' || c == '\\') {
+			g_string_append_c(str, '\\');
+			g_string_append_c(str, c);
+		} else if (c == '\b') {
+			g_string_append(str, "\\b");
+		} else if (c == '\f') {
+			g_string_append(str, "\\f");
+		} else if (c == '\n') {
+			g_string_append(str, "\\n");
+		} else if (c == '\r') {
+			g_string_append(str, "\\r");
+		} else if (c == '\t') {
+			g_string_append(str, "\\t");
+		} else if ((guchar)c < 0x20) {
+			g_string_append_printf(str, "\\u%04x", (guint)c);
+		} else {
+			g_string_append_c(str, c);
+		}
+	}
+	g_string_append_c(str, '"');
+}
+
+/* emit the node directly into the buffer, without the per-node measure-then-copy
+ * passes a generator does */
+static void
+fwupd_codec_json_append_node(GString *str, JsonNode *json_node)
+{
+	JsonNodeType node_type = json_node_get_node_type(json_node);
+	if (node_type == JSON_NODE_VALUE) {
+		GType gtype = json_node_get_value_type(json_node);
+		if (gtype == G_TYPE_STRING) {
+			fwupd_codec_json_append_string_escaped(str,
+							       json_node_get_string(json_node));
+		} else if (gtype == G_TYPE_INT64) {
+			g_string_append_printf(str,
+					       "%" G_GINT64_FORMAT,
+					       json_node_get_int(json_node));
+		} else if (gtype == G_TYPE_DOUBLE) {
+			gchar buf[G_ASCII_DTOSTR_BUF_SIZE] = {0};
+			g_ascii_dtostr(buf, sizeof(buf), json_node_get_double(json_node));
+			g_string_append(str, buf);
+		} else if (gtype == G_TYPE_BOOLEAN) {
+			g_string_append(str, json_node_get_boolean(json_node) ? "true" : "false");
+		}
+	} else if (node_type == JSON_NODE_ARRAY) {
+		JsonArray *json_array = json_node_get_array(json_node);
+		guint sz = json_array_get_length(json_array);
+		g_string_append_c(str, '[');
+		for (guint i = 0; i < sz; i++) {
+			if (i > 0)
+				g_string_append_c(str, ',');
+			fwupd_codec_json_append_node(str, json_array_get_element(json_array, i));
+		}
+		g_string_append_c(str, ']');
+	} else if (node_type == JSON_NODE_OBJECT) {
+		JsonObjectIter iter;
+		const gchar *member_name;
+		JsonNode *member_node;
+		gboolean first = TRUE;
+		g_string_append_c(str, '{');
+		json_object_iter_init_ordered(&iter, json_node_get_object(json_node));
+		while (json_object_iter_next_ordered(&iter, &member_name, &member_node)) {
+			if (!first)
+				g_string_append_c(str, ',');
+			fwupd_codec_json_append_string_escaped(str, member_name);
+			g_string_append_c(str, ':');
+			fwupd_codec_json_append_node(str, member_node);
+			first = FALSE;
+		}
+		g_string_append_c(str, '}');
+	} else {
+		g_string_append(str, "null");
+	}
+}
+
+static gchar *
+fwupd_codec_json_root_to_string(JsonNode *json_root, FwupdCodecFlags flags, GError **error)
+{
+	g_autofree gchar *data = NULL;
+	g_autoptr(JsonGenerator) json_generator = NULL;
+
+	/* use the streaming emitter when the output is for machines */
+	if (flags & FWUPD_CODEC_FLAG_COMPACT) {
+		g_autoptr(GString) str = g_string_sized_new(1024);
+		fwupd_codec_json_append_node(str, json_root);
+		return g_string_free(g_steal_pointer(&str), FALSE);
+	}
+
+	json_generator = json_generator_new();
+	json_generator_set_pretty(json_generator, TRUE);
+	json_generator_set_root(json_generator, json_root);
+	data = json_generator_to_data(json_generator, NULL);
+	if (data == NULL) {
+		g_set_error(error, FWUPD_ERROR, FWUPD_ERROR_INTERNAL, "failed to convert to json");
+		return NULL;
+	}
+	return g_steal_pointer(&data);
+}
+
 /**
  * fwupd_codec_to_json_string:
  * @self: a #FwupdCodec
@@ -239,8 +344,6 @@ fwupd_codec_to_json(FwupdCodec *self, JsonBuilder *builder, FwupdCodecFlags flag
 gchar *
 fwupd_codec_to_json_string(FwupdCodec *self, FwupdCodecFlags flags, GError **error)
 {
-	g_autofree gchar *data = NULL;
-	g_autoptr(JsonGenerator) json_generator = NULL;
 	g_autoptr(JsonBuilder) builder = json_builder_new();
 	g_autoptr(JsonNode) json_root = NULL;
 
@@ -251,15 +354,7 @@ fwupd_codec_to_json_string(FwupdCodec *self, FwupdCodecFlags flags, GError **err
 	fwupd_codec_to_json(self, builder, flags);
 	json_builder_end_object(builder);
 	json_root = json_builder_get_root(builder);
-	json_generator = json_generator_new();
-	json_generator_set_pretty(json_generator, TRUE);
-	json_generator_set_root(json_generator, json_root);
-	data = json_generator_to_data(json_generator, NULL);
-	if (data == NULL) {
-		g_set_error(error, FWUPD_ERROR, FWUPD_ERROR_INTERNAL, "failed to convert to json");
-		return NULL;
-	}
-	return g_steal_pointer(&data);
+	return fwupd_codec_json_root_to_string(json_root, flags, error);
 }
 
 /**
@@ -381,6 +476,42 @@ fwupd_codec_array_to_json(GPtrArray *array,
 	json_builder_end_array(builder);
 }
 
+/**
+ * fwupd_codec_array_to_json_string:
+ * @array: (element-type GObject): (not nullable): array of objects that must implement `FwupdCodec`
+ * @member_name: (not nullable): member name of the array
+ * @flags: a #FwupdCodecFlags, e.g. %FWUPD_CODEC_FLAG_COMPACT
+ * @error: (nullable): optional return location for an error
+ *
+ * Converts an array of objects to a JSON string with one root member.
+ *
+ * Using %FWUPD_CODEC_FLAG_COMPACT here is considerably faster than a pretty-printing
+ * generator when serializing thousands of objects.
+ *
+ * Returns: (transfer full): a string
+ *
+ * Since: 2.0.3
+ */
+gchar *
+fwupd_codec_array_to_json_string(GPtrArray *array,
+				 const gchar *member_name,
+				 FwupdCodecFlags flags,
+				 GError **error)
+{
+	g_autoptr(JsonBuilder) builder = json_builder_new();
+	g_autoptr(JsonNode) json_root = NULL;
+
+	g_return_val_if_fail(array != NULL, NULL);
+	g_return_val_if_fail(member_name != NULL, NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+	json_builder_begin_object(builder);
+	fwupd_codec_array_to_json(array, member_name, builder, flags);
+	json_builder_end_object(builder);
+	json_root = json_builder_get_root(builder);
+	return fwupd_codec_json_root_to_string(json_root, flags, error);
+}
+
 /**
  * fwupd_codec_array_to_variant:
  * @array: (element-type GObject): (not nullable): array of objects that much implement `FwupdCodec`
@@ -402,7 +533,9 @@ fwupd_codec_array_to_variant(GPtrArray *array, FwupdCodecFlags flags)
 	g_variant_builder_init(&builder, G_VARIANT_TYPE("aa{sv}"));
 	for (guint i = 0; i < array->len; i++) {
 		FwupdCodec *codec = FWUPD_CODEC(g_ptr_array_index(array, i));
-		g_variant_builder_add_value(&builder, fwupd_codec_to_variant(codec, flags));
+		g_autoptr(GVariant) value =
+		    g_variant_take_ref(fwupd_codec_to_variant(codec, flags));
+		g_variant_builder_add_value(&builder, value);
 	}
 	return g_variant_new("(aa{sv})", &builder);
 }
@@ -36,6 +36,16 @@ typedef enum {
 	 * Since: 2.0.0
 	 */
 	FWUPD_CODEC_FLAG_TRUSTED = 1 << 0,
+	/**
+	 * FWUPD_CODEC_FLAG_COMPACT:
+	 *
+	 * Produce machine-readable output without indentation, using a streaming
+	 * emitter rather than a generator -- which is considerably faster when
+	 * serializing thousands of objects.
+	 *
+	 * Since: 2.0.3
+	 */
+	FWUPD_CODEC_FLAG_COMPACT = 1 << 1,
 } FwupdCodecFlags;
 
 struct _FwupdCodecInterface {
@@ -78,6 +88,11 @@ fwupd_codec_array_to_json(GPtrArray *array,
 			  const gchar *member_name,
 			  JsonBuilder *builder,
 			  FwupdCodecFlags flags);
+gchar *
+fwupd_codec_array_to_json_string(GPtrArray *array,
+				 const gchar *member_name,
+				 FwupdCodecFlags flags,
+				 GError **error) G_GNUC_NON_NULL(1, 2);
 
 GVariant *
 fwupd_codec_to_variant(FwupdCodec *self, FwupdCodecFlags flags) G_GNUC_NON_NULL(1);
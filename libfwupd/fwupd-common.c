@@ -494,7 +494,7 @@ fwupd_unix_input_stream_from_bytes(GBytes *bytes, GError **error)
 #endif
 
 #ifdef HAVE_MEMFD_CREATE
-	fd = memfd_create("fwupd", MFD_CLOEXEC);
+	fd = memfd_create("fwupd", MFD_CLOEXEC | MFD_ALLOW_SEALING);
 #else
 	/* emulate in-memory file by an unlinked temporary file */
 	fd = g_mkstemp(tmp_file);
@@ -538,6 +538,12 @@ fwupd_unix_input_stream_from_bytes(GBytes *bytes, GError **error)
 			    g_strerror(errno));
 		return NULL;
 	}
+#if defined(HAVE_MEMFD_CREATE) && defined(F_ADD_SEALS)
+	/* seal the contents so the receiver can safely map the fd without copying it;
+	 * best effort as the daemon falls back to reading unsealed fds */
+	if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0)
+		g_debug("failed to seal memfd: %s", g_strerror(errno));
+#endif
 	return G_UNIX_INPUT_STREAM(g_unix_input_stream_new(fd, TRUE));
 }
 
@@ -68,6 +68,8 @@ typedef struct {
 	guint percentage;
 	GPtrArray *releases; /* (nullable) (element-type FwupdRelease) */
 	FwupdDevice *parent; /* noref */
+	GVariant *variant_cache; /* (nullable) */
+	FwupdCodecFlags variant_cache_flags;
 } FwupdDevicePrivate;
 
 enum {
@@ -102,6 +104,13 @@ G_DEFINE_TYPE_EXTENDED(FwupdDevice,
 
 #define FWUPD_BATTERY_THRESHOLD_DEFAULT 10 /* % */
 
+static void
+fwupd_device_invalidate_variant_cache(FwupdDevice *self)
+{
+	FwupdDevicePrivate *priv = GET_PRIVATE(self);
+	g_clear_pointer(&priv->variant_cache, g_variant_unref);
+}
+
 static void
 fwupd_device_ensure_checksums(FwupdDevice *self)
 {
@@ -173,6 +182,7 @@ fwupd_device_add_checksum(FwupdDevice *self, const gchar *checksum)
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
 	g_return_if_fail(checksum != NULL);
+	fwupd_device_invalidate_variant_cache(self);
 
 	if (fwupd_device_has_checksum(self, checksum))
 		return;
@@ -222,6 +232,7 @@ fwupd_device_add_issue(FwupdDevice *self, const gchar *issue)
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
 	g_return_if_fail(issue != NULL);
+	fwupd_device_invalidate_variant_cache(self);
 
 	fwupd_device_ensure_issues(self);
 	for (guint i = 0; i < priv->issues->len; i++) {
@@ -291,6 +302,7 @@ fwupd_device_set_summary(FwupdDevice *self, const gchar *summary)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 
 	/* not changed */
 	if (g_strcmp0(priv->summary, summary) == 0)
@@ -332,6 +344,7 @@ fwupd_device_set_branch(FwupdDevice *self, const gchar *branch)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 
 	/* not changed */
 	if (g_strcmp0(priv->branch, branch) == 0)
@@ -373,6 +386,7 @@ fwupd_device_set_serial(FwupdDevice *self, const gchar *serial)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 
 	/* not changed */
 	if (g_strcmp0(priv->serial, serial) == 0)
@@ -414,6 +428,7 @@ fwupd_device_set_id(FwupdDevice *self, const gchar *id)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 
 	/* not changed */
 	if (g_strcmp0(priv->id, id) == 0)
@@ -462,6 +477,7 @@ fwupd_device_set_parent_id(FwupdDevice *self, const gchar *parent_id)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 
 	/* not changed */
 	if (g_strcmp0(priv->parent_id, parent_id) == 0)
@@ -515,6 +531,7 @@ fwupd_device_set_composite_id(FwupdDevice *self, const gchar *composite_id)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 
 	/* not changed */
 	if (g_strcmp0(priv->composite_id, composite_id) == 0)
@@ -701,7 +718,7 @@ fwupd_device_ensure_guids(FwupdDevice *self)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	if (priv->guids == NULL)
-		priv->guids = g_ptr_array_new_with_free_func(g_free);
+		priv->guids = g_ptr_array_new_with_free_func((GDestroyNotify)g_ref_string_release);
 }
 
 /**
@@ -746,7 +763,8 @@ fwupd_device_has_guid(FwupdDevice *self, const gchar *guid)
 		return FALSE;
 	for (guint i = 0; i < priv->guids->len; i++) {
 		const gchar *guid_tmp = g_ptr_array_index(priv->guids, i);
-		if (g_strcmp0(guid, guid_tmp) == 0)
+		/* interned, so this is often just a pointer comparison */
+		if (guid == guid_tmp || g_strcmp0(guid, guid_tmp) == 0)
 			return TRUE;
 	}
 	return FALSE;
@@ -767,10 +785,11 @@ fwupd_device_add_guid(FwupdDevice *self, const gchar *guid)
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
 	g_return_if_fail(guid != NULL);
+	fwupd_device_invalidate_variant_cache(self);
 	if (fwupd_device_has_guid(self, guid))
 		return;
 	fwupd_device_ensure_guids(self);
-	g_ptr_array_add(priv->guids, g_strdup(guid));
+	g_ptr_array_add(priv->guids, g_ref_string_new_intern(guid));
 }
 
 /**
@@ -798,7 +817,8 @@ fwupd_device_ensure_instance_ids(FwupdDevice *self)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	if (priv->instance_ids == NULL)
-		priv->instance_ids = g_ptr_array_new_with_free_func(g_free);
+		priv->instance_ids =
+		    g_ptr_array_new_with_free_func((GDestroyNotify)g_ref_string_release);
 }
 
 /**
@@ -843,7 +863,8 @@ fwupd_device_has_instance_id(FwupdDevice *self, const gchar *instance_id)
 		return FALSE;
 	for (guint i = 0; i < priv->instance_ids->len; i++) {
 		const gchar *instance_id_tmp = g_ptr_array_index(priv->instance_ids, i);
-		if (g_strcmp0(instance_id, instance_id_tmp) == 0)
+		/* interned, so this is often just a pointer comparison */
+		if (instance_id == instance_id_tmp || g_strcmp0(instance_id, instance_id_tmp) == 0)
 			return TRUE;
 	}
 	return FALSE;
@@ -864,10 +885,11 @@ fwupd_device_add_instance_id(FwupdDevice *self, const gchar *instance_id)
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
 	g_return_if_fail(instance_id != NULL);
+	fwupd_device_invalidate_variant_cache(self);
 	if (fwupd_device_has_instance_id(self, instance_id))
 		return;
 	fwupd_device_ensure_instance_ids(self);
-	g_ptr_array_add(priv->instance_ids, g_strdup(instance_id));
+	g_ptr_array_add(priv->instance_ids, g_ref_string_new_intern(instance_id));
 }
 
 static void
@@ -940,6 +962,7 @@ fwupd_device_add_icon(FwupdDevice *self, const gchar *icon)
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
 	g_return_if_fail(icon != NULL);
+	fwupd_device_invalidate_variant_cache(self);
 	if (fwupd_device_has_icon(self, icon))
 		return;
 	fwupd_device_ensure_icons(self);
@@ -978,6 +1001,7 @@ fwupd_device_set_name(FwupdDevice *self, const gchar *name)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 
 	/* not changed */
 	if (g_strcmp0(priv->name, name) == 0)
@@ -1019,6 +1043,7 @@ fwupd_device_set_vendor(FwupdDevice *self, const gchar *vendor)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 
 	/* not changed */
 	if (g_strcmp0(priv->vendor, vendor) == 0)
@@ -1100,6 +1125,7 @@ fwupd_device_add_vendor_id(FwupdDevice *self, const gchar *vendor_id)
 
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
 	g_return_if_fail(vendor_id != NULL);
+	fwupd_device_invalidate_variant_cache(self);
 
 	if (fwupd_device_has_vendor_id(self, vendor_id))
 		return;
@@ -1139,6 +1165,7 @@ fwupd_device_set_version(FwupdDevice *self, const gchar *version)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 
 	/* not changed */
 	if (g_strcmp0(priv->version, version) == 0)
@@ -1181,6 +1208,7 @@ fwupd_device_set_version_lowest(FwupdDevice *self, const gchar *version_lowest)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 
 	/* not changed */
 	if (g_strcmp0(priv->version_lowest, version_lowest) == 0)
@@ -1222,6 +1250,7 @@ fwupd_device_set_version_lowest_raw(FwupdDevice *self, guint64 version_lowest_ra
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	priv->version_lowest_raw = version_lowest_raw;
 }
 
@@ -1257,6 +1286,7 @@ fwupd_device_set_version_bootloader(FwupdDevice *self, const gchar *version_boot
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 
 	/* not changed */
 	if (g_strcmp0(priv->version_bootloader, version_bootloader) == 0)
@@ -1298,6 +1328,7 @@ fwupd_device_set_version_bootloader_raw(FwupdDevice *self, guint64 version_bootl
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	priv->version_bootloader_raw = version_bootloader_raw;
 }
 
@@ -1333,6 +1364,7 @@ fwupd_device_set_flashes_left(FwupdDevice *self, guint32 flashes_left)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	priv->flashes_left = flashes_left;
 }
 
@@ -1373,6 +1405,7 @@ fwupd_device_set_battery_level(FwupdDevice *self, guint32 battery_level)
 
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
 	g_return_if_fail(battery_level <= FWUPD_BATTERY_LEVEL_INVALID);
+	fwupd_device_invalidate_variant_cache(self);
 
 	if (priv->battery_level == battery_level)
 		return;
@@ -1427,6 +1460,7 @@ fwupd_device_set_battery_threshold(FwupdDevice *self, guint32 battery_threshold)
 
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
 	g_return_if_fail(battery_threshold <= FWUPD_BATTERY_LEVEL_INVALID);
+	fwupd_device_invalidate_variant_cache(self);
 
 	if (priv->battery_threshold == battery_threshold)
 		return;
@@ -1466,6 +1500,7 @@ fwupd_device_set_install_duration(FwupdDevice *self, guint32 duration)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	priv->install_duration = duration;
 }
 
@@ -1501,6 +1536,7 @@ fwupd_device_set_plugin(FwupdDevice *self, const gchar *plugin)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 
 	/* not changed */
 	if (g_strcmp0(priv->plugin, plugin) == 0)
@@ -1582,6 +1618,7 @@ fwupd_device_add_protocol(FwupdDevice *self, const gchar *protocol)
 
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
 	g_return_if_fail(protocol != NULL);
+	fwupd_device_invalidate_variant_cache(self);
 
 	if (fwupd_device_has_protocol(self, protocol))
 		return;
@@ -1621,6 +1658,7 @@ fwupd_device_set_flags(FwupdDevice *self, guint64 flags)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	if (priv->flags == flags)
 		return;
 	priv->flags = flags;
@@ -1641,6 +1679,7 @@ fwupd_device_add_flag(FwupdDevice *self, FwupdDeviceFlags flag)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	if (flag == 0)
 		return;
 	if ((priv->flags | flag) == priv->flags)
@@ -1663,6 +1702,7 @@ fwupd_device_remove_flag(FwupdDevice *self, FwupdDeviceFlags flag)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	if (flag == 0)
 		return;
 	if ((priv->flags & flag) == 0)
@@ -1722,6 +1762,7 @@ fwupd_device_set_problems(FwupdDevice *self, guint64 problems)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	if (priv->problems == problems)
 		return;
 	priv->problems = problems;
@@ -1742,6 +1783,7 @@ fwupd_device_add_problem(FwupdDevice *self, FwupdDeviceProblem problem)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	if (problem == FWUPD_DEVICE_PROBLEM_NONE)
 		return;
 	if (fwupd_device_has_problem(self, problem))
@@ -1764,6 +1806,7 @@ fwupd_device_remove_problem(FwupdDevice *self, FwupdDeviceProblem problem)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	if (problem == FWUPD_DEVICE_PROBLEM_NONE)
 		return;
 	if (!fwupd_device_has_problem(self, problem))
@@ -1823,6 +1866,7 @@ fwupd_device_set_request_flags(FwupdDevice *self, guint64 request_flags)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	if (priv->request_flags == request_flags)
 		return;
 	priv->request_flags = request_flags;
@@ -1843,6 +1887,7 @@ fwupd_device_add_request_flag(FwupdDevice *self, FwupdRequestFlags request_flag)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	if (request_flag == 0)
 		return;
 	if ((priv->request_flags | request_flag) == priv->request_flags)
@@ -1865,6 +1910,7 @@ fwupd_device_remove_request_flag(FwupdDevice *self, FwupdRequestFlags request_fl
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	if (request_flag == 0)
 		return;
 	if ((priv->request_flags & request_flag) == 0)
@@ -1924,6 +1970,7 @@ fwupd_device_set_created(FwupdDevice *self, guint64 created)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	priv->created = created;
 }
 
@@ -1959,6 +2006,7 @@ fwupd_device_set_modified(FwupdDevice *self, guint64 modified)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	priv->modified = modified;
 }
 
@@ -2353,12 +2401,43 @@ fwupd_device_add_variant(FwupdCodec *codec, GVariantBuilder *builder, FwupdCodec
 	}
 }
 
+static GVariant *
+fwupd_device_to_variant(FwupdCodec *codec, FwupdCodecFlags flags)
+{
+	FwupdDevice *self = FWUPD_DEVICE(codec);
+	FwupdDevicePrivate *priv = GET_PRIVATE(self);
+	GVariantBuilder builder;
+
+	/* the releases are mutable objects, and so the serialized form cannot be cached */
+	if (priv->releases != NULL && priv->releases->len > 0) {
+		g_variant_builder_init(&builder, G_VARIANT_TYPE_VARDICT);
+		fwupd_device_add_variant(codec, &builder, flags);
+		return g_variant_new("a{sv}", &builder);
+	}
+
+	/* rebuild the cache, e.g. after something changed or a different trust level */
+	if (priv->variant_cache == NULL || priv->variant_cache_flags != flags) {
+		fwupd_device_invalidate_variant_cache(self);
+		g_variant_builder_init(&builder, G_VARIANT_TYPE_VARDICT);
+		fwupd_device_add_variant(codec, &builder, flags);
+		priv->variant_cache = g_variant_ref_sink(g_variant_new("a{sv}", &builder));
+		priv->variant_cache_flags = flags;
+	}
+	return g_variant_ref(priv->variant_cache);
+}
+
 static void
 fwupd_device_from_key_value(FwupdDevice *self, const gchar *key, GVariant *value)
 {
 	if (g_strcmp0(key, FWUPD_RESULT_KEY_RELEASE) == 0) {
+		FwupdDevicePrivate *priv = GET_PRIVATE(self);
 		GVariantIter iter;
 		GVariant *child;
+
+		/* the serialized form is authoritative; this matters when the variant is
+		 * re-applied onto an existing instance, as releases are not deduplicated */
+		if (priv->releases != NULL)
+			g_ptr_array_set_size(priv->releases, 0);
 		g_variant_iter_init(&iter, value);
 		while ((child = g_variant_iter_next_value(&iter))) {
 			g_autoptr(FwupdRelease) release = fwupd_release_new();
@@ -2626,6 +2705,7 @@ fwupd_device_set_update_state(FwupdDevice *self, FwupdUpdateState update_state)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	if (priv->update_state == update_state)
 		return;
 	priv->update_state = update_state;
@@ -2664,6 +2744,7 @@ fwupd_device_set_version_format(FwupdDevice *self, FwupdVersionFormat version_fo
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	priv->version_format = version_format;
 }
 
@@ -2699,6 +2780,7 @@ fwupd_device_set_version_raw(FwupdDevice *self, guint64 version_raw)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	priv->version_raw = version_raw;
 }
 
@@ -2734,6 +2816,7 @@ fwupd_device_set_version_build_date(FwupdDevice *self, guint64 version_build_dat
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	priv->version_build_date = version_build_date;
 }
 
@@ -2769,6 +2852,7 @@ fwupd_device_set_update_error(FwupdDevice *self, const gchar *update_error)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 
 	/* not changed */
 	if (g_strcmp0(priv->update_error, update_error) == 0)
@@ -2841,6 +2925,7 @@ fwupd_device_add_release(FwupdDevice *self, FwupdRelease *release)
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
 	g_return_if_fail(FWUPD_IS_RELEASE(release));
+	fwupd_device_invalidate_variant_cache(self);
 	fwupd_device_ensure_releases(self);
 	g_ptr_array_add(priv->releases, g_object_ref(release));
 }
@@ -2877,6 +2962,7 @@ fwupd_device_set_status(FwupdDevice *self, FwupdStatus status)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	if (priv->status == status)
 		return;
 	priv->status = status;
@@ -2915,6 +3001,7 @@ fwupd_device_set_percentage(FwupdDevice *self, guint percentage)
 {
 	FwupdDevicePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FWUPD_IS_DEVICE(self));
+	fwupd_device_invalidate_variant_cache(self);
 	if (priv->percentage == percentage)
 		return;
 	priv->percentage = percentage;
@@ -3951,6 +4038,8 @@ fwupd_device_finalize(GObject *object)
 		g_ptr_array_unref(priv->releases);
 	if (priv->issues != NULL)
 		g_ptr_array_unref(priv->issues);
+	if (priv->variant_cache != NULL)
+		g_variant_unref(priv->variant_cache);
 
 	G_OBJECT_CLASS(fwupd_device_parent_class)->finalize(object);
 }
@@ -3974,6 +4063,7 @@ fwupd_device_codec_iface_init(FwupdCodecInterface *iface)
 	iface->add_json = fwupd_device_add_json;
 	iface->from_json = fwupd_device_from_json;
 	iface->add_variant = fwupd_device_add_variant;
+	iface->to_variant = fwupd_device_to_variant;
 	iface->from_variant_iter = fwupd_device_from_variant_iter;
 }
 
@@ -34,6 +34,22 @@ G_BEGIN_DECLS
  * The D-Bus type signature string is 'as' i.e. an array of strings.
  **/
 #define FWUPD_RESULT_KEY_CHECKSUM "Checksum"
+/**
+ * FWUPD_RESULT_KEY_CHECKSUM_BLOCKS:
+ *
+ * Result key to represent per-block container checksums
+ *
+ * The D-Bus type signature string is 'as' i.e. an array of strings.
+ **/
+#define FWUPD_RESULT_KEY_CHECKSUM_BLOCKS "ChecksumBlocks"
+/**
+ * FWUPD_RESULT_KEY_CHECKSUM_BLOCK_SIZE:
+ *
+ * Result key to represent the size covered by each per-block checksum
+ *
+ * The D-Bus type signature string is 'u' i.e. a unsigned 32 bit integer.
+ **/
+#define FWUPD_RESULT_KEY_CHECKSUM_BLOCK_SIZE "ChecksumBlockSize"
 /**
  * FWUPD_RESULT_KEY_TAGS:
  *
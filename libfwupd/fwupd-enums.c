@@ -435,6 +435,10 @@ fwupd_plugin_flag_to_string(FwupdPluginFlags plugin_flag)
 		return "ready";
 	if (plugin_flag == FWUPD_PLUGIN_FLAG_TEST_ONLY)
 		return "test-only";
+	if (plugin_flag == FWUPD_PLUGIN_FLAG_NOT_THREAD_SAFE)
+		return "not-thread-safe";
+	if (plugin_flag == FWUPD_PLUGIN_FLAG_PARALLEL_INSTALLS)
+		return "parallel-installs";
 	return NULL;
 }
 
@@ -491,6 +495,10 @@ fwupd_plugin_flag_from_string(const gchar *plugin_flag)
 		return FWUPD_PLUGIN_FLAG_READY;
 	if (g_strcmp0(plugin_flag, "test-only") == 0)
 		return FWUPD_PLUGIN_FLAG_TEST_ONLY;
+	if (g_strcmp0(plugin_flag, "not-thread-safe") == 0)
+		return FWUPD_PLUGIN_FLAG_NOT_THREAD_SAFE;
+	if (g_strcmp0(plugin_flag, "parallel-installs") == 0)
+		return FWUPD_PLUGIN_FLAG_PARALLEL_INSTALLS;
 	return FWUPD_PLUGIN_FLAG_UNKNOWN;
 }
 
@@ -585,6 +593,8 @@ fwupd_feature_flag_to_string(FwupdFeatureFlags feature_flag)
 		return "allow-authentication";
 	if (feature_flag == FWUPD_FEATURE_FLAG_REQUESTS_NON_GENERIC)
 		return "requests-non-generic";
+	if (feature_flag == FWUPD_FEATURE_FLAG_LAZY_RELEASE_DETAILS)
+		return "lazy-release-details";
 	return NULL;
 }
 
@@ -623,6 +633,8 @@ fwupd_feature_flag_from_string(const gchar *feature_flag)
 		return FWUPD_FEATURE_FLAG_ALLOW_AUTHENTICATION;
 	if (g_strcmp0(feature_flag, "requests-non-generic") == 0)
 		return FWUPD_FEATURE_FLAG_REQUESTS_NON_GENERIC;
+	if (g_strcmp0(feature_flag, "lazy-release-details") == 0)
+		return FWUPD_FEATURE_FLAG_LAZY_RELEASE_DETAILS;
 	return FWUPD_FEATURE_FLAG_UNKNOWN;
 }
 
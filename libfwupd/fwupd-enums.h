@@ -234,6 +234,15 @@ typedef enum {
 	 * Since: 1.9.8
 	 */
 	FWUPD_FEATURE_FLAG_REQUESTS_NON_GENERIC = 1 << 9, /* Since: 1.9.8 */
+	/**
+	 * FWUPD_FEATURE_FLAG_LAZY_RELEASE_DETAILS:
+	 *
+	 * Can fetch the release description on demand using `GetReleaseDetails`, and so the
+	 * enumeration replies do not need to include it.
+	 *
+	 * Since: 2.0.3
+	 */
+	FWUPD_FEATURE_FLAG_LAZY_RELEASE_DETAILS = 1 << 10, /* Since: 2.0.3 */
 	/*< private >*/
 	FWUPD_FEATURE_FLAG_UNKNOWN = G_MAXUINT64,
 } FwupdFeatureFlags;
@@ -1025,6 +1034,24 @@ typedef enum {
 	 * Since: 2.0.0
 	 */
 	FWUPD_PLUGIN_FLAG_TEST_ONLY = 1ull << 18,
+	/**
+	 * FWUPD_PLUGIN_FLAG_NOT_THREAD_SAFE:
+	 *
+	 * The plugin cannot probe devices from more than one thread at the same time, and the
+	 * daemon should serialize calls into it.
+	 *
+	 * Since: 2.0.3
+	 */
+	FWUPD_PLUGIN_FLAG_NOT_THREAD_SAFE = 1ull << 19,
+	/**
+	 * FWUPD_PLUGIN_FLAG_PARALLEL_INSTALLS:
+	 *
+	 * The plugin can flash several of its devices at the same time, e.g. a room
+	 * full of identical cameras, and the daemon may batch the installs.
+	 *
+	 * Since: 2.0.3
+	 */
+	FWUPD_PLUGIN_FLAG_PARALLEL_INSTALLS = 1ull << 20,
 	/**
 	 * FWUPD_PLUGIN_FLAG_UNKNOWN:
 	 *
@@ -31,7 +31,8 @@ static void
 fwupd_release_finalize(GObject *object);
 
 typedef struct {
-	GPtrArray *checksums;  /* (nullable) (element-type utf-8) */
+	GPtrArray *checksums;	    /* (nullable) (element-type utf-8) */
+	GPtrArray *checksum_blocks; /* (nullable) (element-type utf-8) */
 	GPtrArray *tags;       /* (nullable) (element-type utf-8) */
 	GPtrArray *categories; /* (nullable) (element-type utf-8) */
 	GPtrArray *issues;     /* (nullable) (element-type utf-8) */
@@ -58,6 +59,7 @@ typedef struct {
 	guint64 size;
 	guint64 created;
 	guint32 install_duration;
+	guint32 checksum_block_size;
 	FwupdReleaseFlags flags;
 	FwupdReleaseUrgency urgency;
 	gchar *update_message;
@@ -527,6 +529,92 @@ fwupd_release_has_checksum(FwupdRelease *self, const gchar *checksum)
 	return FALSE;
 }
 
+static void
+fwupd_release_ensure_checksum_blocks(FwupdRelease *self)
+{
+	FwupdReleasePrivate *priv = GET_PRIVATE(self);
+	if (priv->checksum_blocks == NULL)
+		priv->checksum_blocks = g_ptr_array_new_with_free_func(g_free);
+}
+
+/**
+ * fwupd_release_get_checksum_blocks:
+ * @self: a #FwupdRelease
+ *
+ * Gets the per-block checksums of the release container, which allow sections
+ * of the download to be verified without hashing the entire file.
+ *
+ * The blocks are ordered, and each covers fwupd_release_get_checksum_block_size()
+ * bytes of the container — except the last, which may be short.
+ *
+ * Returns: (element-type utf8) (transfer none): the block checksums, which may be empty
+ *
+ * Since: 2.0.3
+ **/
+GPtrArray *
+fwupd_release_get_checksum_blocks(FwupdRelease *self)
+{
+	FwupdReleasePrivate *priv = GET_PRIVATE(self);
+	g_return_val_if_fail(FWUPD_IS_RELEASE(self), NULL);
+	fwupd_release_ensure_checksum_blocks(self);
+	return priv->checksum_blocks;
+}
+
+/**
+ * fwupd_release_add_checksum_block:
+ * @self: a #FwupdRelease
+ * @checksum: (not nullable): the container block checksum
+ *
+ * Adds a per-block checksum of the release container.
+ *
+ * Since: 2.0.3
+ **/
+void
+fwupd_release_add_checksum_block(FwupdRelease *self, const gchar *checksum)
+{
+	FwupdReleasePrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FWUPD_IS_RELEASE(self));
+	g_return_if_fail(checksum != NULL);
+	fwupd_release_ensure_checksum_blocks(self);
+	g_ptr_array_add(priv->checksum_blocks, g_strdup(checksum));
+}
+
+/**
+ * fwupd_release_get_checksum_block_size:
+ * @self: a #FwupdRelease
+ *
+ * Gets the number of container bytes covered by each entry returned by
+ * fwupd_release_get_checksum_blocks().
+ *
+ * Returns: size in bytes, or 0 if no block checksums are provided
+ *
+ * Since: 2.0.3
+ **/
+guint32
+fwupd_release_get_checksum_block_size(FwupdRelease *self)
+{
+	FwupdReleasePrivate *priv = GET_PRIVATE(self);
+	g_return_val_if_fail(FWUPD_IS_RELEASE(self), 0);
+	return priv->checksum_block_size;
+}
+
+/**
+ * fwupd_release_set_checksum_block_size:
+ * @self: a #FwupdRelease
+ * @checksum_block_size: size in bytes, e.g. 0x100000
+ *
+ * Sets the number of container bytes covered by each per-block checksum.
+ *
+ * Since: 2.0.3
+ **/
+void
+fwupd_release_set_checksum_block_size(FwupdRelease *self, guint32 checksum_block_size)
+{
+	FwupdReleasePrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FWUPD_IS_RELEASE(self));
+	priv->checksum_block_size = checksum_block_size;
+}
+
 static void
 fwupd_release_ensure_tags(FwupdRelease *self)
 {
@@ -1741,6 +1829,20 @@ fwupd_release_add_variant(FwupdCodec *codec, GVariantBuilder *builder, FwupdCode
 				      FWUPD_RESULT_KEY_CHECKSUM,
 				      g_variant_new_string(str->str));
 	}
+	if (priv->checksum_blocks != NULL && priv->checksum_blocks->len > 0) {
+		g_variant_builder_add(
+		    builder,
+		    "{sv}",
+		    FWUPD_RESULT_KEY_CHECKSUM_BLOCKS,
+		    g_variant_new_strv((const gchar *const *)priv->checksum_blocks->pdata,
+				       priv->checksum_blocks->len));
+	}
+	if (priv->checksum_block_size > 0) {
+		g_variant_builder_add(builder,
+				      "{sv}",
+				      FWUPD_RESULT_KEY_CHECKSUM_BLOCK_SIZE,
+				      g_variant_new_uint32(priv->checksum_block_size));
+	}
 	if (priv->locations != NULL && priv->locations->len > 0) {
 		g_variant_builder_add(
 		    builder,
@@ -1908,6 +2010,16 @@ fwupd_release_from_key_value(FwupdRelease *self, const gchar *key, GVariant *val
 			fwupd_release_add_checksum(self, split[i]);
 		return;
 	}
+	if (g_strcmp0(key, FWUPD_RESULT_KEY_CHECKSUM_BLOCKS) == 0) {
+		g_autofree const gchar **strv = g_variant_get_strv(value, NULL);
+		for (guint i = 0; strv[i] != NULL; i++)
+			fwupd_release_add_checksum_block(self, strv[i]);
+		return;
+	}
+	if (g_strcmp0(key, FWUPD_RESULT_KEY_CHECKSUM_BLOCK_SIZE) == 0) {
+		fwupd_release_set_checksum_block_size(self, g_variant_get_uint32(value));
+		return;
+	}
 	if (g_strcmp0(key, FWUPD_RESULT_KEY_LOCATIONS) == 0) {
 		g_autofree const gchar **strv = g_variant_get_strv(value, NULL);
 		for (guint i = 0; strv[i] != NULL; i++)
@@ -2050,6 +2162,20 @@ fwupd_release_add_json(FwupdCodec *codec, JsonBuilder *builder, FwupdCodecFlags
 		}
 		json_builder_end_array(builder);
 	}
+	if (priv->checksum_blocks != NULL && priv->checksum_blocks->len > 0) {
+		json_builder_set_member_name(builder, FWUPD_RESULT_KEY_CHECKSUM_BLOCKS);
+		json_builder_begin_array(builder);
+		for (guint i = 0; i < priv->checksum_blocks->len; i++) {
+			const gchar *checksum = g_ptr_array_index(priv->checksum_blocks, i);
+			json_builder_add_string_value(builder, checksum);
+		}
+		json_builder_end_array(builder);
+	}
+	if (priv->checksum_block_size > 0) {
+		fwupd_codec_json_append_int(builder,
+					    FWUPD_RESULT_KEY_CHECKSUM_BLOCK_SIZE,
+					    priv->checksum_block_size);
+	}
 	if (priv->tags != NULL && priv->tags->len > 0) {
 		json_builder_set_member_name(builder, FWUPD_RESULT_KEY_TAGS);
 		json_builder_begin_array(builder);
@@ -2157,6 +2283,23 @@ fwupd_release_add_string(FwupdCodec *codec, guint idt, GString *str)
 						  checksum_display);
 		}
 	}
+	if (priv->checksum_blocks != NULL) {
+		for (guint i = 0; i < priv->checksum_blocks->len; i++) {
+			const gchar *checksum = g_ptr_array_index(priv->checksum_blocks, i);
+			g_autofree gchar *checksum_display =
+			    fwupd_checksum_format_for_display(checksum);
+			fwupd_codec_string_append(str,
+						  idt,
+						  FWUPD_RESULT_KEY_CHECKSUM_BLOCKS,
+						  checksum_display);
+		}
+	}
+	if (priv->checksum_block_size > 0) {
+		fwupd_codec_string_append_size(str,
+					       idt,
+					       FWUPD_RESULT_KEY_CHECKSUM_BLOCK_SIZE,
+					       priv->checksum_block_size);
+	}
 	if (priv->tags != NULL) {
 		for (guint i = 0; i < priv->tags->len; i++) {
 			const gchar *tag = g_ptr_array_index(priv->tags, i);
@@ -2303,6 +2446,8 @@ fwupd_release_finalize(GObject *object)
 		g_ptr_array_unref(priv->issues);
 	if (priv->checksums != NULL)
 		g_ptr_array_unref(priv->checksums);
+	if (priv->checksum_blocks != NULL)
+		g_ptr_array_unref(priv->checksum_blocks);
 	if (priv->tags != NULL)
 		g_ptr_array_unref(priv->tags);
 	if (priv->reports != NULL)
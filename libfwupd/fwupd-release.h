@@ -56,6 +56,15 @@ gboolean
 fwupd_release_has_checksum(FwupdRelease *self, const gchar *checksum) G_GNUC_WARN_UNUSED_RESULT
     G_GNUC_NON_NULL(1, 2);
 GPtrArray *
+fwupd_release_get_checksum_blocks(FwupdRelease *self) G_GNUC_NON_NULL(1);
+void
+fwupd_release_add_checksum_block(FwupdRelease *self, const gchar *checksum) G_GNUC_NON_NULL(1, 2);
+guint32
+fwupd_release_get_checksum_block_size(FwupdRelease *self) G_GNUC_NON_NULL(1);
+void
+fwupd_release_set_checksum_block_size(FwupdRelease *self, guint32 checksum_block_size)
+    G_GNUC_NON_NULL(1);
+GPtrArray *
 fwupd_release_get_tags(FwupdRelease *self) G_GNUC_NON_NULL(1);
 void
 fwupd_release_add_tag(FwupdRelease *self, const gchar *tag) G_GNUC_NON_NULL(1, 2);
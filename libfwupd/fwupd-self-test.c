@@ -177,6 +177,9 @@ fwupd_release_func(void)
 	fwupd_release_add_tag(release1, "tag");
 	fwupd_release_add_checksum(release1, "checksum");
 	fwupd_release_add_checksum(release1, "checksum");
+	fwupd_release_set_checksum_block_size(release1, 0x100000);
+	fwupd_release_add_checksum_block(release1, "checksum-block1");
+	fwupd_release_add_checksum_block(release1, "checksum-block2");
 	fwupd_release_add_flag(release1, FWUPD_RELEASE_FLAG_IS_UPGRADE);
 	fwupd_release_add_flag(release1, FWUPD_RELEASE_FLAG_IS_UPGRADE);
 	fwupd_release_add_flag(release1, FWUPD_RELEASE_FLAG_BLOCKED_APPROVAL);
@@ -213,6 +216,8 @@ fwupd_release_func(void)
 	g_assert_true(fwupd_release_has_category(release2, "category"));
 	g_assert_true(fwupd_release_has_tag(release2, "tag"));
 	g_assert_true(fwupd_release_has_checksum(release2, "checksum"));
+	g_assert_cmpint(fwupd_release_get_checksum_block_size(release2), ==, 0x100000);
+	g_assert_cmpint(fwupd_release_get_checksum_blocks(release2)->len, ==, 2);
 	g_assert_true(fwupd_release_has_flag(release2, FWUPD_RELEASE_FLAG_IS_UPGRADE));
 	g_assert_false(fwupd_release_has_flag(release2, FWUPD_RELEASE_FLAG_IS_COMMUNITY));
 	g_assert_cmpint(fwupd_release_get_issues(release2)->len, ==, 1);
@@ -252,6 +257,9 @@ fwupd_release_func(void)
 				    "  Categories:           category\n"
 				    "  Issues:               issue\n"
 				    "  Checksum:             SHA1(checksum)\n"
+				    "  ChecksumBlocks:       SHA1(checksum-block1)\n"
+				    "  ChecksumBlocks:       SHA1(checksum-block2)\n"
+				    "  ChecksumBlockSize:    1.0 MB\n"
 				    "  Tags:                 tag\n"
 				    "  License:              license\n"
 				    "  Size:                 1.2 kB\n"
@@ -543,9 +551,11 @@ fwupd_device_func(void)
 {
 	gboolean ret;
 	g_autofree gchar *data = NULL;
+	g_autofree gchar *data_compact = NULL;
 	g_autofree gchar *str = NULL;
 	g_autoptr(FwupdDevice) dev = NULL;
 	g_autoptr(FwupdDevice) dev2 = fwupd_device_new();
+	g_autoptr(FwupdDevice) dev_compact = fwupd_device_new();
 	g_autoptr(FwupdDevice) dev_new = fwupd_device_new();
 	g_autoptr(FwupdRelease) rel = NULL;
 	g_autoptr(GError) error = NULL;
@@ -709,6 +719,20 @@ fwupd_device_func(void)
 	g_assert_true(fwupd_device_has_instance_id(dev2, "USB\\VID_1234&PID_0001"));
 	g_assert_true(fwupd_device_has_flag(dev2, FWUPD_DEVICE_FLAG_UPDATABLE));
 	g_assert_false(fwupd_device_has_flag(dev2, FWUPD_DEVICE_FLAG_LOCKED));
+
+	/* export to compact json, and check it round-trips */
+	data_compact = fwupd_codec_to_json_string(FWUPD_CODEC(dev),
+						  FWUPD_CODEC_FLAG_TRUSTED |
+						      FWUPD_CODEC_FLAG_COMPACT,
+						  &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(data_compact);
+	g_assert_null(g_strstr_len(data_compact, -1, "\n"));
+	ret = fwupd_codec_from_json_string(FWUPD_CODEC(dev_compact), data_compact, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+	g_assert_true(fwupd_device_has_instance_id(dev_compact, "USB\\VID_1234&PID_0001"));
+	g_assert_cmpstr(fwupd_device_get_name(dev_compact), ==, "ColorHug2");
 }
 
 static void
@@ -24,6 +24,9 @@
 typedef struct {
 	FuArchiveFormat format;
 	FuArchiveCompression compression;
+	gboolean on_demand;
+	gsize cache_budget;
+	FuArchive *archive; /* nullable, only when on-demand */
 } FuArchiveFirmwarePrivate;
 
 G_DEFINE_TYPE_WITH_PRIVATE(FuArchiveFirmware, fu_archive_firmware, FU_TYPE_FIRMWARE)
@@ -48,7 +51,14 @@ fu_archive_firmware_parse_cb(FuArchive *self,
 			     GError **error)
 {
 	FuFirmware *firmware = FU_FIRMWARE(user_data);
-	g_autoptr(FuFirmware) img = fu_firmware_new_from_bytes(bytes);
+	g_autoptr(FuFirmware) img = NULL;
+
+	/* bytes is NULL when the member decompression has been deferred */
+	if (bytes != NULL) {
+		img = fu_firmware_new_from_bytes(bytes);
+	} else {
+		img = fu_firmware_new();
+	}
 	fu_firmware_set_id(img, filename);
 	return fu_firmware_add_image_full(firmware, img, error);
 }
@@ -59,12 +69,22 @@ fu_archive_firmware_parse(FuFirmware *firmware,
 			  FwupdInstallFlags flags,
 			  GError **error)
 {
+	FuArchiveFirmware *self = FU_ARCHIVE_FIRMWARE(firmware);
+	FuArchiveFirmwarePrivate *priv = GET_PRIVATE(self);
+	FuArchiveFlags archive_flags = FU_ARCHIVE_FLAG_IGNORE_PATH;
 	g_autoptr(FuArchive) archive = NULL;
 
-	/* load archive */
-	archive = fu_archive_new_stream(stream, FU_ARCHIVE_FLAG_IGNORE_PATH, error);
+	/* load archive, perhaps only scanning the member names */
+	if (priv->on_demand)
+		archive_flags |= FU_ARCHIVE_FLAG_ON_DEMAND;
+	archive = fu_archive_new_stream(stream, archive_flags, error);
 	if (archive == NULL)
 		return FALSE;
+	if (priv->on_demand) {
+		if (priv->cache_budget != 0)
+			fu_archive_set_cache_budget(archive, priv->cache_budget);
+		g_set_object(&priv->archive, archive);
+	}
 
 	/* decompress each image in the archive */
 	return fu_archive_iterate(archive, fu_archive_firmware_parse_cb, firmware, error);
@@ -140,6 +160,64 @@ fu_archive_firmware_set_compression(FuArchiveFirmware *self, FuArchiveCompressio
 	priv->compression = compression;
 }
 
+/**
+ * fu_archive_firmware_set_on_demand:
+ * @self: a #FuArchiveFirmware
+ * @on_demand: if members should be decompressed when first used
+ *
+ * Sets if archive members should only be decompressed on access, rather than all at parse time.
+ * This keeps the memory usage of huge vendor archives bounded, at the cost of keeping a
+ * reference on the parsed stream.
+ *
+ * Members accessed with fu_archive_firmware_get_image_fnmatch() get their payload set on first
+ * use; members that are never used are never decompressed.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_archive_firmware_set_on_demand(FuArchiveFirmware *self, gboolean on_demand)
+{
+	FuArchiveFirmwarePrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FU_IS_ARCHIVE_FIRMWARE(self));
+	priv->on_demand = on_demand;
+}
+
+/**
+ * fu_archive_firmware_get_on_demand:
+ * @self: a #FuArchiveFirmware
+ *
+ * Gets if archive members are only decompressed on access.
+ *
+ * Returns: boolean
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_archive_firmware_get_on_demand(FuArchiveFirmware *self)
+{
+	FuArchiveFirmwarePrivate *priv = GET_PRIVATE(self);
+	g_return_val_if_fail(FU_IS_ARCHIVE_FIRMWARE(self), FALSE);
+	return priv->on_demand;
+}
+
+/**
+ * fu_archive_firmware_set_cache_budget:
+ * @self: a #FuArchiveFirmware
+ * @cache_budget: maximum number of bytes of decompressed members to keep cached
+ *
+ * Sets the byte budget for members decompressed on-demand, passed to
+ * fu_archive_set_cache_budget() at parse time.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_archive_firmware_set_cache_budget(FuArchiveFirmware *self, gsize cache_budget)
+{
+	FuArchiveFirmwarePrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FU_IS_ARCHIVE_FIRMWARE(self));
+	priv->cache_budget = cache_budget;
+}
+
 /**
  * fu_archive_firmware_get_image_fnmatch:
  * @self: a #FuPlugin
@@ -156,6 +234,7 @@ fu_archive_firmware_set_compression(FuArchiveFirmware *self, FuArchiveCompressio
 FuFirmware *
 fu_archive_firmware_get_image_fnmatch(FuArchiveFirmware *self, const gchar *pattern, GError **error)
 {
+	FuArchiveFirmwarePrivate *priv = GET_PRIVATE(self);
 	g_autoptr(FuFirmware) img_match = NULL;
 	g_autoptr(GPtrArray) imgs = fu_firmware_get_images(FU_FIRMWARE(self));
 
@@ -186,6 +265,20 @@ fu_archive_firmware_get_image_fnmatch(FuArchiveFirmware *self, const gchar *patt
 			    pattern);
 		return NULL;
 	}
+
+	/* decompress the member on first use */
+	if (priv->archive != NULL) {
+		g_autoptr(GBytes) blob_old = fu_firmware_get_bytes(img_match, NULL);
+		if (blob_old == NULL) {
+			g_autoptr(GBytes) blob = NULL;
+			blob = fu_archive_lookup_by_fn(priv->archive,
+						       fu_firmware_get_id(img_match),
+						       error);
+			if (blob == NULL)
+				return NULL;
+			fu_firmware_set_bytes(img_match, blob);
+		}
+	}
 	return g_steal_pointer(&img_match);
 }
 
@@ -278,10 +371,22 @@ fu_archive_firmware_init(FuArchiveFirmware *self)
 	fu_firmware_set_images_max(FU_FIRMWARE(self), 10000);
 }
 
+static void
+fu_archive_firmware_finalize(GObject *object)
+{
+	FuArchiveFirmware *self = FU_ARCHIVE_FIRMWARE(object);
+	FuArchiveFirmwarePrivate *priv = GET_PRIVATE(self);
+	if (priv->archive != NULL)
+		g_object_unref(priv->archive);
+	G_OBJECT_CLASS(fu_archive_firmware_parent_class)->finalize(object);
+}
+
 static void
 fu_archive_firmware_class_init(FuArchiveFirmwareClass *klass)
 {
+	GObjectClass *object_class = G_OBJECT_CLASS(klass);
 	FuFirmwareClass *firmware_class = FU_FIRMWARE_CLASS(klass);
+	object_class->finalize = fu_archive_firmware_finalize;
 	firmware_class->parse = fu_archive_firmware_parse;
 	firmware_class->write = fu_archive_firmware_write;
 	firmware_class->build = fu_archive_firmware_build;
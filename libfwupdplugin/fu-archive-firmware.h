@@ -29,6 +29,13 @@ fu_archive_firmware_get_compression(FuArchiveFirmware *self) G_GNUC_NON_NULL(1);
 void
 fu_archive_firmware_set_compression(FuArchiveFirmware *self, FuArchiveCompression compression)
     G_GNUC_NON_NULL(1);
+gboolean
+fu_archive_firmware_get_on_demand(FuArchiveFirmware *self) G_GNUC_NON_NULL(1);
+void
+fu_archive_firmware_set_on_demand(FuArchiveFirmware *self, gboolean on_demand) G_GNUC_NON_NULL(1);
+void
+fu_archive_firmware_set_cache_budget(FuArchiveFirmware *self, gsize cache_budget)
+    G_GNUC_NON_NULL(1);
 FuFirmware *
 fu_archive_firmware_get_image_fnmatch(FuArchiveFirmware *self, const gchar *pattern, GError **error)
     G_GNUC_NON_NULL(1, 2);
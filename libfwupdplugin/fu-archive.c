@@ -30,16 +30,31 @@
 
 struct _FuArchive {
 	GObject parent_instance;
-	GHashTable *entries; /* str:GBytes */
+	GHashTable *entries; /* str:GBytes, value NULL when not yet decompressed */
+	GInputStream *stream; /* nullable, only when FU_ARCHIVE_FLAG_ON_DEMAND */
+	FuArchiveFlags flags;
+	GQueue *cache_lru; /* of borrowed keys from entries */
+	gsize cache_sz;
+	gsize cache_budget;
 };
 
 G_DEFINE_TYPE(FuArchive, fu_archive, G_TYPE_OBJECT)
 
+#define FU_ARCHIVE_CACHE_BUDGET_DEFAULT (64 * 1024 * 1024)
+
+#ifdef HAVE_LIBARCHIVE
+static GBytes *
+fu_archive_load_entry(FuArchive *self, const gchar *fn, GError **error);
+#endif
+
 static void
 fu_archive_finalize(GObject *obj)
 {
 	FuArchive *self = FU_ARCHIVE(obj);
 
+	if (self->stream != NULL)
+		g_object_unref(self->stream);
+	g_queue_free(self->cache_lru);
 	g_hash_table_unref(self->entries);
 	G_OBJECT_CLASS(fu_archive_parent_class)->finalize(obj);
 }
@@ -56,6 +71,27 @@ fu_archive_init(FuArchive *self)
 {
 	self->entries =
 	    g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_bytes_unref);
+	self->cache_lru = g_queue_new();
+	self->cache_budget = FU_ARCHIVE_CACHE_BUDGET_DEFAULT;
+}
+
+/**
+ * fu_archive_set_cache_budget:
+ * @self: a #FuArchive
+ * @cache_budget: maximum number of bytes of decompressed entries to keep
+ *
+ * Sets the byte budget for entries decompressed on-demand; the least recently used entries
+ * are dropped when the budget is exceeded and are decompressed again on next use.
+ *
+ * This has no effect unless the archive was loaded with %FU_ARCHIVE_FLAG_ON_DEMAND.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_archive_set_cache_budget(FuArchive *self, gsize cache_budget)
+{
+	g_return_if_fail(FU_IS_ARCHIVE(self));
+	self->cache_budget = cache_budget;
 }
 
 /**
@@ -77,6 +113,29 @@ fu_archive_add_entry(FuArchive *self, const gchar *fn, GBytes *blob)
 	g_hash_table_insert(self->entries, g_strdup(fn), g_bytes_ref(blob));
 }
 
+/* the key pointers in the LRU are owned by the entries hash and are never removed */
+static void
+fu_archive_cache_touch(FuArchive *self, const gchar *fn)
+{
+	gpointer key = NULL;
+	if (!g_hash_table_lookup_extended(self->entries, fn, &key, NULL))
+		return;
+	g_queue_remove(self->cache_lru, key);
+	g_queue_push_tail(self->cache_lru, key);
+}
+
+static void
+fu_archive_cache_evict(FuArchive *self)
+{
+	while (self->cache_sz > self->cache_budget && self->cache_lru->length > 1) {
+		gpointer key = g_queue_pop_head(self->cache_lru);
+		GBytes *blob = g_hash_table_lookup(self->entries, key);
+		g_debug("evicting %s [0x%x]", (const gchar *)key, (guint)g_bytes_get_size(blob));
+		self->cache_sz -= g_bytes_get_size(blob);
+		g_hash_table_insert(self->entries, g_strdup(key), NULL);
+	}
+}
+
 /**
  * fu_archive_lookup_by_fn:
  * @self: a #FuArchive
@@ -100,9 +159,24 @@ fu_archive_lookup_by_fn(FuArchive *self, const gchar *fn, GError **error)
 
 	bytes = g_hash_table_lookup(self->entries, fn);
 	if (bytes == NULL) {
+		/* the entry exists, but the decompression was deferred */
+		if (self->stream != NULL && g_hash_table_contains(self->entries, fn)) {
+#ifdef HAVE_LIBARCHIVE
+			g_autoptr(GBytes) blob = fu_archive_load_entry(self, fn, error);
+			if (blob == NULL)
+				return NULL;
+			g_hash_table_insert(self->entries, g_strdup(fn), g_bytes_ref(blob));
+			self->cache_sz += g_bytes_get_size(blob);
+			fu_archive_cache_touch(self, fn);
+			fu_archive_cache_evict(self);
+			return g_steal_pointer(&blob);
+#endif
+		}
 		g_set_error(error, FWUPD_ERROR, FWUPD_ERROR_NOT_FOUND, "no blob for %s", fn);
 		return NULL;
 	}
+	if (self->stream != NULL)
+		fu_archive_cache_touch(self, fn);
 	return g_bytes_ref(bytes);
 }
 
@@ -116,6 +190,10 @@ fu_archive_lookup_by_fn(FuArchive *self, const gchar *fn, GError **error)
  * Iterates over the archive contents, calling the given function for each
  * of the files found. If any @callback returns %FALSE scanning is aborted.
  *
+ * If the archive was loaded with %FU_ARCHIVE_FLAG_ON_DEMAND then @callback is called with a
+ * %NULL blob for any entry that has not yet been decompressed; use fu_archive_lookup_by_fn()
+ * to get the entry contents.
+ *
  * Returns: True if no @callback returned FALSE
  *
  * Since: 1.3.4
@@ -296,6 +374,26 @@ fu_archive_read(FuArchive *self, _archive_read_ctx *arch, FuArchiveFlags flags,
 				    fn);
 			return FALSE;
 		}
+		if (flags & FU_ARCHIVE_FLAG_IGNORE_PATH) {
+			fn_key = g_path_get_basename(fn);
+		} else {
+			fn_key = g_strdup(fn);
+		}
+
+		/* defer the decompression until the entry is first used */
+		if ((flags & FU_ARCHIVE_FLAG_ON_DEMAND) > 0 && self->stream != NULL) {
+			g_debug("deferring %s", fn_key);
+			g_hash_table_insert(self->entries, g_steal_pointer(&fn_key), NULL);
+			if (archive_read_data_skip(arch) != ARCHIVE_OK) {
+				g_set_error(error,
+					    FWUPD_ERROR,
+					    FWUPD_ERROR_READ,
+					    "cannot skip data: %s",
+					    archive_error_string(arch));
+				return FALSE;
+			}
+			continue;
+		}
 		bufsz = archive_entry_size(entry);
 		if (bufsz > 1024 * 1024 * 1024) {
 			g_set_error_literal(error,
@@ -323,11 +421,6 @@ fu_archive_read(FuArchive *self, _archive_read_ctx *arch, FuArchiveFlags flags,
 				    bufsz);
 			return FALSE;
 		}
-		if (flags & FU_ARCHIVE_FLAG_IGNORE_PATH) {
-			fn_key = g_path_get_basename(fn);
-		} else {
-			fn_key = g_strdup(fn);
-		}
 		g_debug("adding %s [%" G_GINT64_FORMAT "]", fn_key, bufsz);
 		bytes = g_bytes_new_take(g_steal_pointer(&buf), bufsz);
 		fu_archive_add_entry(self, fn_key, bytes);
@@ -467,6 +560,95 @@ fu_archive_seek_cb(struct archive *arch, void *client_data, gint64 offset, gint
 	}
 	return g_seekable_tell(G_SEEKABLE(helper->stream));
 }
+
+/* re-open the archive and decompress a single entry, skipping everything else */
+static GBytes *
+fu_archive_load_entry(FuArchive *self, const gchar *fn, GError **error)
+{
+	FuArchiveStreamHelper helper = {.stream = self->stream};
+	int r;
+	g_autoptr(_archive_read_ctx) arch = NULL;
+
+	if (!g_seekable_seek(G_SEEKABLE(self->stream), 0x0, G_SEEK_SET, NULL, error))
+		return NULL;
+	arch = fu_archive_read_new(error);
+	if (arch == NULL)
+		return NULL;
+	archive_read_set_seek_callback(arch, fu_archive_seek_cb);
+	archive_read_set_read_callback(arch, fu_archive_read_cb);
+	archive_read_set_skip_callback(arch, fu_archive_skip_cb);
+	archive_read_set_callback_data(arch, &helper);
+	r = archive_read_open1(arch);
+	if (r != 0) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_NOT_SUPPORTED,
+			    "cannot open: %s",
+			    archive_error_string(arch));
+		return NULL;
+	}
+	while (TRUE) {
+		const gchar *fn_entry;
+		gint64 bufsz;
+		gssize rc;
+		struct archive_entry *entry;
+		g_autofree gchar *fn_key = NULL;
+		g_autofree guint8 *buf = NULL;
+
+		r = archive_read_next_header(arch, &entry);
+		if (r == ARCHIVE_EOF)
+			break;
+		if (r != ARCHIVE_OK) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INVALID_DATA,
+				    "cannot read header: %s",
+				    archive_error_string(arch));
+			return NULL;
+		}
+		fn_entry = archive_entry_pathname(entry);
+		if (fn_entry == NULL)
+			continue;
+		if (self->flags & FU_ARCHIVE_FLAG_IGNORE_PATH) {
+			fn_key = g_path_get_basename(fn_entry);
+		} else {
+			fn_key = g_strdup(fn_entry);
+		}
+		if (g_strcmp0(fn_key, fn) != 0)
+			continue;
+		bufsz = archive_entry_size(entry);
+		if (bufsz > 1024 * 1024 * 1024) {
+			g_set_error_literal(error,
+					    FWUPD_ERROR,
+					    FWUPD_ERROR_NOT_SUPPORTED,
+					    "cannot read huge files");
+			return NULL;
+		}
+		buf = g_malloc(bufsz);
+		rc = archive_read_data(arch, buf, (gsize)bufsz);
+		if (rc < 0) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_READ,
+				    "cannot read data: %s",
+				    archive_error_string(arch));
+			return NULL;
+		}
+		if (rc != bufsz) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_READ,
+				    "read %" G_GSSIZE_FORMAT " of %" G_GINT64_FORMAT,
+				    rc,
+				    bufsz);
+			return NULL;
+		}
+		g_debug("loaded %s [%" G_GINT64_FORMAT "]", fn, bufsz);
+		return g_bytes_new_take(g_steal_pointer(&buf), bufsz);
+	}
+	g_set_error(error, FWUPD_ERROR, FWUPD_ERROR_NOT_FOUND, "no entry for %s", fn);
+	return NULL;
+}
 #endif
 
 /**
@@ -477,6 +659,9 @@ fu_archive_seek_cb(struct archive *arch, void *client_data, gint64 offset, gint
  *
  * Parses @stream as an archive and decompresses all files to memory blobs.
  *
+ * If %FU_ARCHIVE_FLAG_ON_DEMAND is set then only the entry names are read at parse time, and
+ * a reference is kept on @stream so that each entry can be decompressed when first used.
+ *
  * Returns: a #FuArchive, or %NULL if the archive was invalid in any way.
  *
  * Since: 2.0.0
@@ -493,6 +678,9 @@ fu_archive_new_stream(GInputStream *stream, FuArchiveFlags flags, GError **error
 	g_return_val_if_fail(G_INPUT_STREAM(stream), NULL);
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
+	self->flags = flags;
+	if (flags & FU_ARCHIVE_FLAG_ON_DEMAND)
+		self->stream = g_object_ref(stream);
 	if (!g_seekable_seek(G_SEEKABLE(stream), 0x0, G_SEEK_SET, NULL, error))
 		return NULL;
 
@@ -19,12 +19,14 @@ G_DECLARE_FINAL_TYPE(FuArchive, fu_archive, FU, ARCHIVE, GObject)
  * FuArchiveFlags:
  * @FU_ARCHIVE_FLAG_NONE:		No flags set
  * @FU_ARCHIVE_FLAG_IGNORE_PATH:	Ignore any path component
+ * @FU_ARCHIVE_FLAG_ON_DEMAND:		Decompress entries when first accessed
  *
  * The flags to use when loading the archive.
  **/
 typedef enum {
 	FU_ARCHIVE_FLAG_NONE = 0,
 	FU_ARCHIVE_FLAG_IGNORE_PATH = 1 << 0,
+	FU_ARCHIVE_FLAG_ON_DEMAND = 1 << 1,
 	/*< private >*/
 	FU_ARCHIVE_FLAG_LAST
 } FuArchiveFlags;
@@ -33,7 +35,7 @@ typedef enum {
  * FuArchiveIterateFunc:
  * @self: a #FuArchive
  * @filename: a filename
- * @bytes: the blob referenced by @filename
+ * @bytes: (nullable): the blob referenced by @filename, or %NULL if not yet decompressed
  * @user_data: user data
  * @error: a #GError or NULL
  *
@@ -57,6 +59,8 @@ fu_archive_add_entry(FuArchive *self, const gchar *fn, GBytes *blob) G_GNUC_NON_
 GBytes *
 fu_archive_lookup_by_fn(FuArchive *self, const gchar *fn, GError **error) G_GNUC_WARN_UNUSED_RESULT
     G_GNUC_NON_NULL(1, 2);
+void
+fu_archive_set_cache_budget(FuArchive *self, gsize cache_budget) G_GNUC_NON_NULL(1);
 GByteArray *
 fu_archive_write(FuArchive *self,
 		 FuArchiveFormat format,
@@ -28,6 +28,7 @@ typedef struct {
 	gboolean can_invalidate;
 	GType device_gtype;
 	GHashTable *devices; /* device_id : * FuDevice */
+	GHashTable *timings; /* (nullable): step:usec */
 	GThread *thread_init;
 } FuBackendPrivate;
 
@@ -304,6 +305,47 @@ fu_backend_add_string(FuBackend *self, guint idt, GString *str)
 		klass->to_string(self, idt, str);
 }
 
+/**
+ * fu_backend_add_timing:
+ * @self: a #FuBackend
+ * @step: a string, e.g. `setup`
+ * @duration_usec: duration in microseconds
+ *
+ * Records how long a backend step took so that slow backends can be identified
+ * without tracing.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_backend_add_timing(FuBackend *self, const gchar *step, guint duration_usec)
+{
+	FuBackendPrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FU_IS_BACKEND(self));
+	g_return_if_fail(step != NULL);
+	if (priv->timings == NULL)
+		priv->timings = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	g_hash_table_insert(priv->timings, g_strdup(step), GUINT_TO_POINTER(duration_usec));
+}
+
+/**
+ * fu_backend_get_timings:
+ * @self: a #FuBackend
+ *
+ * Returns the recorded duration of each backend step, with each value in
+ * microseconds stored using GUINT_TO_POINTER().
+ *
+ * Returns: (transfer none) (nullable): the map of step timings
+ *
+ * Since: 2.0.3
+ **/
+GHashTable *
+fu_backend_get_timings(FuBackend *self)
+{
+	FuBackendPrivate *priv = GET_PRIVATE(self);
+	g_return_val_if_fail(FU_IS_BACKEND(self), NULL);
+	return priv->timings;
+}
+
 /**
  * fu_backend_setup:
  * @self: a #FuBackend
@@ -330,10 +372,12 @@ fu_backend_setup(FuBackend *self, FuBackendSetupFlags flags, FuProgress *progres
 	if (priv->done_setup)
 		return TRUE;
 	if (klass->setup != NULL) {
+		gint64 timestamp = g_get_monotonic_time();
 		if (!klass->setup(self, flags, progress, error)) {
 			priv->enabled = FALSE;
 			return FALSE;
 		}
+		fu_backend_add_timing(self, "setup", g_get_monotonic_time() - timestamp);
 	}
 	priv->done_setup = TRUE;
 	return TRUE;
@@ -447,6 +491,26 @@ fu_backend_from_json(FwupdCodec *codec, JsonNode *json_node, GError **error)
 		g_ptr_array_add(devices_added, g_object_ref(device_tmp));
 	}
 
+	/* devices recorded in a previous phase with no new events are referenced by backend ID
+	 * rather than re-serialized; treat them as present-and-unchanged so they do not get
+	 * removed below */
+	if (json_object_has_member(json_object, "UsbDevicesUnchanged")) {
+		JsonArray *json_array_unchanged =
+		    json_object_get_array_member(json_object, "UsbDevicesUnchanged");
+		for (guint i = 0; i < json_array_get_length(json_array_unchanged); i++) {
+			const gchar *backend_id =
+			    json_array_get_string_element(json_array_unchanged, i);
+			FuDevice *device_old = fu_backend_lookup_by_id(self, backend_id);
+			if (device_old == NULL)
+				continue;
+			fu_device_clear_events(device_old);
+			g_debug("unchanged %s [%s]",
+				fu_device_get_name(device_old),
+				fu_device_get_backend_id(device_old));
+			g_ptr_array_remove(devices_remove, device_old);
+		}
+	}
+
 	/* emit removes then adds */
 	for (guint i = 0; i < devices_remove->len; i++) {
 		FuDevice *device = g_ptr_array_index(devices_remove, i);
@@ -518,13 +582,18 @@ gboolean
 fu_backend_coldplug(FuBackend *self, FuProgress *progress, GError **error)
 {
 	FuBackendClass *klass = FU_BACKEND_GET_CLASS(self);
+	gint64 timestamp;
 	g_return_val_if_fail(FU_IS_BACKEND(self), FALSE);
 	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 	if (!fu_backend_setup(self, FU_BACKEND_SETUP_FLAG_NONE, progress, error))
 		return FALSE;
 	if (klass->coldplug == NULL)
 		return TRUE;
-	return klass->coldplug(self, progress, error);
+	timestamp = g_get_monotonic_time();
+	if (!klass->coldplug(self, progress, error))
+		return FALSE;
+	fu_backend_add_timing(self, "coldplug", g_get_monotonic_time() - timestamp);
+	return TRUE;
 }
 
 /**
@@ -735,6 +804,8 @@ fu_backend_finalize(GObject *object)
 	FuBackendPrivate *priv = GET_PRIVATE(self);
 	g_free(priv->name);
 	g_hash_table_unref(priv->devices);
+	if (priv->timings != NULL)
+		g_hash_table_unref(priv->timings);
 	G_OBJECT_CLASS(fu_backend_parent_class)->finalize(object);
 }
 
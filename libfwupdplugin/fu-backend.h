@@ -88,6 +88,11 @@ void
 fu_backend_invalidate(FuBackend *self) G_GNUC_NON_NULL(1);
 void
 fu_backend_add_string(FuBackend *self, guint idt, GString *str) G_GNUC_NON_NULL(1, 3);
+void
+fu_backend_add_timing(FuBackend *self, const gchar *step, guint duration_usec)
+    G_GNUC_NON_NULL(1, 2);
+GHashTable *
+fu_backend_get_timings(FuBackend *self) G_GNUC_NON_NULL(1);
 FuDevice *
 fu_backend_get_device_parent(FuBackend *self,
 			     FuDevice *device,
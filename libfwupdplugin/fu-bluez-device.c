@@ -104,16 +104,31 @@ fu_bluez_device_signal_cb(GDBusProxy *proxy,
 static gboolean
 fu_bluez_device_ensure_uuid_helper_proxy(FuBluezDeviceUuidHelper *uuid_helper, GError **error)
 {
+	FuBluezDevicePrivate *priv = GET_PRIVATE(uuid_helper->self);
+
 	if (uuid_helper->proxy != NULL)
 		return TRUE;
-	uuid_helper->proxy = g_dbus_proxy_new_for_bus_sync(G_BUS_TYPE_SYSTEM,
-							   G_DBUS_PROXY_FLAGS_NONE,
-							   NULL,
-							   "org.bluez",
-							   uuid_helper->path,
-							   "org.bluez.GattCharacteristic1",
-							   NULL,
-							   error);
+
+	/* reuse the object manager proxy where possible; it shares one connection and
+	 * already has the property cache kept up to date from signals */
+	if (priv->object_manager != NULL) {
+		GDBusInterface *iface =
+		    g_dbus_object_manager_get_interface(priv->object_manager,
+							uuid_helper->path,
+							"org.bluez.GattCharacteristic1");
+		if (iface != NULL)
+			uuid_helper->proxy = G_DBUS_PROXY(iface);
+	}
+	if (uuid_helper->proxy == NULL) {
+		uuid_helper->proxy = g_dbus_proxy_new_for_bus_sync(G_BUS_TYPE_SYSTEM,
+								   G_DBUS_PROXY_FLAGS_NONE,
+								   NULL,
+								   "org.bluez",
+								   uuid_helper->path,
+								   "org.bluez.GattCharacteristic1",
+								   NULL,
+								   error);
+	}
 	if (uuid_helper->proxy == NULL) {
 		g_prefix_error(error, "Failed to create GDBusProxy for uuid_helper: ");
 		return FALSE;
@@ -252,9 +267,14 @@ fu_bluez_device_to_string(FuDevice *device, guint idt, GString *str)
 /*
  * Returns the value of a property of an object specified by its path as
  * a GVariant, or NULL if the property wasn't found.
+ *
+ * The property cache of @obj is kept up to date from PropertiesChanged
+ * signals by the object manager, so this does not normally need a round
+ * trip to bluezd.
  */
 static GVariant *
-fu_bluez_device_get_ble_property(const gchar *obj_path,
+fu_bluez_device_get_ble_property(GDBusObject *obj,
+				 const gchar *obj_path,
 				 const gchar *iface,
 				 const gchar *prop_name,
 				 GError **error)
@@ -262,6 +282,18 @@ fu_bluez_device_get_ble_property(const gchar *obj_path,
 	g_autoptr(GDBusProxy) proxy = NULL;
 	g_autoptr(GVariant) val = NULL;
 
+	/* use the object manager snapshot where available */
+	if (obj != NULL) {
+		g_autoptr(GDBusInterface) iface_proxy = g_dbus_object_get_interface(obj, iface);
+		if (iface_proxy != NULL) {
+			val = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(iface_proxy),
+							       prop_name);
+			if (val != NULL)
+				return g_steal_pointer(&val);
+		}
+	}
+
+	/* fall back to a dedicated proxy */
 	proxy = g_dbus_proxy_new_for_bus_sync(G_BUS_TYPE_SYSTEM,
 					      G_DBUS_PROXY_FLAGS_NONE,
 					      NULL,
@@ -296,13 +328,14 @@ fu_bluez_device_get_ble_property(const gchar *obj_path,
  * The returned string must be freed using g_free().
  */
 static gchar *
-fu_bluez_device_get_ble_string_property(const gchar *obj_path,
+fu_bluez_device_get_ble_string_property(GDBusObject *obj,
+					const gchar *obj_path,
 					const gchar *iface,
 					const gchar *prop_name,
 					GError **error)
 {
 	g_autoptr(GVariant) val = NULL;
-	val = fu_bluez_device_get_ble_property(obj_path, iface, prop_name, error);
+	val = fu_bluez_device_get_ble_property(obj, obj_path, iface, prop_name, error);
 	if (val == NULL)
 		return NULL;
 	return g_variant_dup_string(val, NULL);
@@ -327,7 +360,8 @@ fu_bluez_device_get_interface_uuid(FuBluezDevice *self,
 			    iface_name);
 		return NULL;
 	}
-	obj_uuid = fu_bluez_device_get_ble_string_property(obj_path, iface_name, "UUID", error);
+	obj_uuid =
+	    fu_bluez_device_get_ble_string_property(obj, obj_path, iface_name, "UUID", error);
 	if (obj_uuid == NULL) {
 		g_prefix_error(error, "failed to get %s property: ", iface_name);
 		return NULL;
@@ -408,8 +442,11 @@ fu_bluez_device_read_battery_interface(FuBluezDevice *self,
 	}
 
 	/* sometimes battery service announced but has no value, no error in that case */
-	obj_percentage =
-	    fu_bluez_device_get_ble_property(obj_path, iface_name, "Percentage", &error_local);
+	obj_percentage = fu_bluez_device_get_ble_property(obj,
+							  obj_path,
+							  iface_name,
+							  "Percentage",
+							  &error_local);
 	if (obj_percentage == NULL) {
 		g_debug("failed to get battery percentage from org.bluez.Battery1: %s",
 			error_local->message);
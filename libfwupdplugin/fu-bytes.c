@@ -13,7 +13,7 @@
 #include "fu-bytes.h"
 #include "fu-common.h"
 #include "fu-input-stream.h"
-#include "fu-mem.h"
+#include "fu-mem-private.h"
 
 /**
  * fu_bytes_set_contents:
@@ -90,6 +90,8 @@ fu_bytes_get_contents(const gchar *filename, GError **error)
 	g_debug("mapped file %s of size 0x%x",
 		filename,
 		(guint)g_mapped_file_get_length(mapped_file));
+	fu_memadvise_sequential((const guint8 *)g_mapped_file_get_contents(mapped_file),
+				g_mapped_file_get_length(mapped_file));
 	return g_mapped_file_get_bytes(mapped_file);
 }
 
@@ -152,6 +154,36 @@ fu_bytes_is_empty(GBytes *bytes)
 	return TRUE;
 }
 
+/**
+ * fu_bytes_trim_empty:
+ * @bytes: data blob
+ *
+ * Returns the blob with any trailing empty (0xff) bytes removed; if there are none
+ * then the original @bytes is returned.
+ *
+ * This is useful when storing dumps of mostly-erased flash, as reprogramming the
+ * trimmed image after a chip erase gives identical device contents.
+ *
+ * Returns: (transfer full): a #GBytes, possibly @bytes
+ *
+ * Since: 2.0.3
+ **/
+GBytes *
+fu_bytes_trim_empty(GBytes *bytes)
+{
+	gsize sz = 0;
+	const guint8 *buf;
+
+	g_return_val_if_fail(bytes != NULL, NULL);
+
+	buf = g_bytes_get_data(bytes, &sz);
+	while (sz > 0 && buf[sz - 1] == 0xff)
+		sz--;
+	if (sz == g_bytes_get_size(bytes))
+		return g_bytes_ref(bytes);
+	return g_bytes_new_from_bytes(bytes, 0x0, sz);
+}
+
 /**
  * fu_bytes_compare:
  * @bytes1: a data blob
@@ -21,6 +21,8 @@ const guint8 *
 fu_bytes_get_data_safe(GBytes *bytes, gsize *bufsz, GError **error) G_GNUC_NON_NULL(1);
 gboolean
 fu_bytes_is_empty(GBytes *bytes) G_GNUC_NON_NULL(1);
+GBytes *
+fu_bytes_trim_empty(GBytes *bytes) G_GNUC_NON_NULL(1);
 gboolean
 fu_bytes_compare(GBytes *bytes1, GBytes *bytes2, GError **error) G_GNUC_WARN_UNUSED_RESULT
     G_GNUC_NON_NULL(1, 2);
@@ -20,6 +20,7 @@
 #include "fu-composite-input-stream.h"
 #include "fu-input-stream.h"
 #include "fu-mem-private.h"
+#include "fu-mszip-input-stream.h"
 #include "fu-partial-input-stream.h"
 #include "fu-string.h"
 
@@ -34,8 +35,6 @@ G_DEFINE_TYPE_WITH_PRIVATE(FuCabFirmware, fu_cab_firmware, FU_TYPE_FIRMWARE)
 #define FU_CAB_FIRMWARE_MAX_FILES   1024
 #define FU_CAB_FIRMWARE_MAX_FOLDERS 64
 
-#define FU_CAB_FIRMWARE_DECOMPRESS_BUFSZ 0x4000 /* bytes */
-
 /**
  * fu_cab_firmware_get_compressed:
  * @self: a #FuCabFirmware
@@ -114,20 +113,15 @@ typedef struct {
 	gsize size_total;
 	FuCabCompression compression;
 	GPtrArray *folder_data; /* of FuCompositeInputStream */
-	z_stream zstrm;
-	guint8 *decompress_buf;
-	gsize decompress_bufsz;
 } FuCabFirmwareParseHelper;
 
 static void
 fu_cab_firmware_parse_helper_free(FuCabFirmwareParseHelper *helper)
 {
-	inflateEnd(&helper->zstrm);
 	if (helper->stream != NULL)
 		g_object_unref(helper->stream);
 	if (helper->folder_data != NULL)
 		g_ptr_array_unref(helper->folder_data);
-	g_free(helper->decompress_buf);
 	g_free(helper);
 }
 
@@ -191,6 +185,7 @@ fu_cab_firmware_parse_data(FuCabFirmware *self,
 			   FuCabFirmwareParseHelper *helper,
 			   gsize *offset,
 			   GInputStream *folder_data,
+			   FuMszipInputStream *mszip_stream,
 			   GError **error)
 {
 	gsize blob_comp;
@@ -266,24 +261,18 @@ fu_cab_firmware_parse_data(FuCabFirmware *self,
 		}
 	}
 
-	/* decompress Zlib data after removing *another *header... */
+	/* register the block for on-demand decompression after removing *another *header... */
 	if (helper->compression == FU_CAB_COMPRESSION_MSZIP) {
-		int zret;
 		g_autofree gchar *kind = NULL;
-		g_autoptr(GByteArray) buf = g_byte_array_new();
-		g_autoptr(GBytes) bytes_comp = NULL;
-		g_autoptr(GBytes) bytes_uncomp = NULL;
-
-		/* check compressed header */
-		bytes_comp = fu_input_stream_read_bytes(helper->stream,
-							*offset + hdr_sz,
-							blob_comp,
-							NULL,
-							error);
-		if (bytes_comp == NULL)
+		g_autoptr(GBytes) bytes_hdr = NULL;
+
+		/* check compressed header now for a sane parse-time error */
+		bytes_hdr =
+		    fu_input_stream_read_bytes(helper->stream, *offset + hdr_sz, 2, NULL, error);
+		if (bytes_hdr == NULL)
 			return FALSE;
-		kind = fu_memstrsafe(g_bytes_get_data(bytes_comp, NULL),
-				     g_bytes_get_size(bytes_comp),
+		kind = fu_memstrsafe(g_bytes_get_data(bytes_hdr, NULL),
+				     g_bytes_get_size(bytes_hdr),
 				     0x0,
 				     2,
 				     error);
@@ -297,51 +286,12 @@ fu_cab_firmware_parse_data(FuCabFirmware *self,
 				    kind);
 			return FALSE;
 		}
-		if (helper->decompress_buf == NULL)
-			helper->decompress_buf = g_malloc0(helper->decompress_bufsz);
-		helper->zstrm.avail_in = g_bytes_get_size(bytes_comp) - 2;
-		helper->zstrm.next_in = (z_const Bytef *)g_bytes_get_data(bytes_comp, NULL) + 2;
-		while (1) {
-			helper->zstrm.avail_out = helper->decompress_bufsz;
-			helper->zstrm.next_out = helper->decompress_buf;
-			zret = inflate(&helper->zstrm, Z_BLOCK);
-			if (zret == Z_STREAM_END)
-				break;
-			g_byte_array_append(buf,
-					    helper->decompress_buf,
-					    helper->decompress_bufsz - helper->zstrm.avail_out);
-			if (zret != Z_OK) {
-				g_set_error(error,
-					    FWUPD_ERROR,
-					    FWUPD_ERROR_NOT_SUPPORTED,
-					    "inflate error @0x%x: %s",
-					    (guint)*offset,
-					    zError(zret));
-				return FALSE;
-			}
-		}
-		zret = inflateReset(&helper->zstrm);
-		if (zret != Z_OK) {
-			g_set_error(error,
-				    FWUPD_ERROR,
-				    FWUPD_ERROR_NOT_SUPPORTED,
-				    "failed to reset inflate: %s",
-				    zError(zret));
-			return FALSE;
-		}
-		zret = inflateSetDictionary(&helper->zstrm, buf->data, buf->len);
-		if (zret != Z_OK) {
-			g_set_error(error,
-				    FWUPD_ERROR,
-				    FWUPD_ERROR_NOT_SUPPORTED,
-				    "failed to set inflate dictionary: %s",
-				    zError(zret));
+		if (!fu_mszip_input_stream_add_block(mszip_stream,
+						     *offset + hdr_sz,
+						     blob_comp,
+						     blob_uncomp,
+						     error))
 			return FALSE;
-		}
-		bytes_uncomp =
-		    g_byte_array_free_to_bytes(g_steal_pointer(&buf)); /* nocheck:blocked */
-		fu_composite_input_stream_add_bytes(FU_COMPOSITE_INPUT_STREAM(folder_data),
-						    bytes_uncomp);
 	} else {
 		fu_composite_input_stream_add_partial_stream(
 		    FU_COMPOSITE_INPUT_STREAM(folder_data),
@@ -364,6 +314,7 @@ fu_cab_firmware_parse_folder(FuCabFirmware *self,
 	FuCabFirmwarePrivate *priv = GET_PRIVATE(self);
 	gsize offset_folder;
 	g_autoptr(GByteArray) st = NULL;
+	g_autoptr(GInputStream) mszip_stream = NULL;
 
 	/* parse header */
 	st = fu_struct_cab_folder_parse_stream(helper->stream, offset, error);
@@ -391,10 +342,28 @@ fu_cab_firmware_parse_folder(FuCabFirmware *self,
 		return FALSE;
 	}
 
+	/* compressed blocks are inflated only when the folder data is read */
+	if (helper->compression == FU_CAB_COMPRESSION_MSZIP) {
+		mszip_stream = fu_mszip_input_stream_new(helper->stream, error);
+		if (mszip_stream == NULL)
+			return FALSE;
+	}
+
 	/* parse CDATA */
 	offset_folder = fu_struct_cab_folder_get_offset(st);
 	for (guint i = 0; i < fu_struct_cab_folder_get_ndatab(st); i++) {
-		if (!fu_cab_firmware_parse_data(self, helper, &offset_folder, folder_data, error))
+		if (!fu_cab_firmware_parse_data(self,
+						helper,
+						&offset_folder,
+						folder_data,
+						(FuMszipInputStream *)mszip_stream,
+						error))
+			return FALSE;
+	}
+	if (mszip_stream != NULL) {
+		if (!fu_composite_input_stream_add_stream(FU_COMPOSITE_INPUT_STREAM(folder_data),
+							  mszip_stream,
+							  error))
 			return FALSE;
 	}
 
@@ -505,26 +474,10 @@ fu_cab_firmware_validate(FuFirmware *firmware, GInputStream *stream, gsize offse
 static FuCabFirmwareParseHelper *
 fu_cab_firmware_parse_helper_new(GInputStream *stream, FwupdInstallFlags flags, GError **error)
 {
-	int zret;
 	g_autoptr(FuCabFirmwareParseHelper) helper = g_new0(FuCabFirmwareParseHelper, 1);
-
-	/* zlib */
-	helper->zstrm.zalloc = fu_cab_firmware_zalloc;
-	helper->zstrm.zfree = fu_cab_firmware_zfree;
-	zret = inflateInit2(&helper->zstrm, -MAX_WBITS);
-	if (zret != Z_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_NOT_SUPPORTED,
-			    "failed to initialize inflate: %s",
-			    zError(zret));
-		return NULL;
-	}
-
 	helper->stream = g_object_ref(stream);
 	helper->install_flags = flags;
 	helper->folder_data = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
-	helper->decompress_bufsz = FU_CAB_FIRMWARE_DECOMPRESS_BUFSZ;
 	return g_steal_pointer(&helper);
 }
 
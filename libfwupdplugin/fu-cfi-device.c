@@ -790,11 +790,19 @@ fu_cfi_device_write_pages(FuCfiDevice *self,
 	fu_progress_set_steps(progress, fu_chunk_array_length(pages));
 	for (guint i = 0; i < fu_chunk_array_length(pages); i++) {
 		g_autoptr(FuChunk) page = NULL;
+		g_autoptr(GBytes) page_blob = NULL;
 
 		/* prepare chunk */
 		page = fu_chunk_array_index(pages, i, error);
 		if (page == NULL)
 			return FALSE;
+
+		/* the chip was erased to 0xFF, so programming an empty page is a no-op */
+		page_blob = fu_chunk_get_bytes(page);
+		if (fu_bytes_is_empty(page_blob)) {
+			fu_progress_step_done(progress);
+			continue;
+		}
 		if (!fu_cfi_device_write_page(self, page, fu_progress_get_child(progress), error))
 			return FALSE;
 		fu_progress_step_done(progress);
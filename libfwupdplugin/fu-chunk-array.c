@@ -141,6 +141,138 @@ fu_chunk_array_index(FuChunkArray *self, guint idx, GError **error)
 	return g_steal_pointer(&chk);
 }
 
+typedef struct {
+	FuChunk *chk;
+	GError *error;
+} FuChunkArrayPrefetchItem;
+
+static void
+fu_chunk_array_prefetch_item_free(FuChunkArrayPrefetchItem *item)
+{
+	if (item->chk != NULL)
+		g_object_unref(item->chk);
+	if (item->error != NULL)
+		g_error_free(item->error);
+	g_free(item);
+}
+
+typedef struct {
+	FuChunkArray *self;
+	GAsyncQueue *queue_chunks; /* of FuChunkArrayPrefetchItem */
+	GAsyncQueue *queue_slots;
+} FuChunkArrayPrefetchHelper;
+
+static gpointer
+fu_chunk_array_prefetch_thread_cb(gpointer user_data)
+{
+	FuChunkArrayPrefetchHelper *helper = (FuChunkArrayPrefetchHelper *)user_data;
+	guint length = fu_chunk_array_length(helper->self);
+
+	for (guint i = 0; i < length; i++) {
+		gboolean failed;
+		FuChunkArrayPrefetchItem *item = g_new0(FuChunkArrayPrefetchItem, 1);
+
+		item->chk = fu_chunk_array_index(helper->self, i, &item->error);
+		failed = item->chk == NULL;
+
+		/* wait for a free slot so we never hold more than @max_pending chunks */
+		g_async_queue_pop(helper->queue_slots);
+		g_async_queue_push(helper->queue_chunks, item);
+		if (failed)
+			return NULL;
+	}
+
+	/* end of stream */
+	g_async_queue_push(helper->queue_chunks, g_new0(FuChunkArrayPrefetchItem, 1));
+	return NULL;
+}
+
+/**
+ * fu_chunk_array_write_pipelined:
+ * @self: a #FuChunkArray
+ * @max_pending: the number of chunks to keep prepared, e.g. 2
+ * @write_func: (scope call): the function to call with each prepared chunk
+ * @user_data: user data passed to @write_func
+ * @error: (nullable): optional return location for an error
+ *
+ * Calls @write_func for each chunk in order, preparing up to @max_pending chunks on a worker
+ * thread so that reading the source stream overlaps with the device write.
+ *
+ * This is most useful for stream-backed chunk arrays where getting the chunk payload is
+ * expensive, for instance when the stream is composite or decompressed on the fly.
+ *
+ * Returns: %TRUE for success
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_chunk_array_write_pipelined(FuChunkArray *self,
+			       guint max_pending,
+			       FuChunkArrayWriteFunc write_func,
+			       gpointer user_data,
+			       GError **error)
+{
+	gboolean ret = TRUE;
+	guint length;
+	FuChunkArrayPrefetchHelper helper = {.self = self};
+	g_autoptr(GThread) thread = NULL;
+
+	g_return_val_if_fail(FU_IS_CHUNK_ARRAY(self), FALSE);
+	g_return_val_if_fail(max_pending > 0, FALSE);
+	g_return_val_if_fail(write_func != NULL, FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	/* nothing to do */
+	length = fu_chunk_array_length(self);
+	if (length == 0)
+		return TRUE;
+
+	helper.queue_chunks = g_async_queue_new();
+	helper.queue_slots = g_async_queue_new();
+	for (guint i = 0; i < max_pending; i++)
+		g_async_queue_push(helper.queue_slots, GUINT_TO_POINTER(1));
+	thread = g_thread_new("FuChunkArrayPrefetch", fu_chunk_array_prefetch_thread_cb, &helper);
+
+	while (TRUE) {
+		FuChunkArrayPrefetchItem *item = g_async_queue_pop(helper.queue_chunks);
+
+		/* the producer failed to read the chunk */
+		if (item->error != NULL) {
+			g_propagate_error(error, g_steal_pointer(&item->error));
+			fu_chunk_array_prefetch_item_free(item);
+			ret = FALSE;
+			break;
+		}
+
+		/* end of stream */
+		if (item->chk == NULL) {
+			fu_chunk_array_prefetch_item_free(item);
+			break;
+		}
+		if (!write_func(self, item->chk, user_data, error)) {
+			fu_chunk_array_prefetch_item_free(item);
+			ret = FALSE;
+			break;
+		}
+		fu_chunk_array_prefetch_item_free(item);
+		g_async_queue_push(helper.queue_slots, GUINT_TO_POINTER(1));
+	}
+
+	/* unblock the producer if we bailed early, then drain anything it queued */
+	for (guint i = 0; i < length; i++)
+		g_async_queue_push(helper.queue_slots, GUINT_TO_POINTER(1));
+	g_thread_join(g_steal_pointer(&thread));
+	while (TRUE) {
+		FuChunkArrayPrefetchItem *item = g_async_queue_try_pop(helper.queue_chunks);
+		if (item == NULL)
+			break;
+		fu_chunk_array_prefetch_item_free(item);
+	}
+	g_async_queue_unref(helper.queue_chunks);
+	g_async_queue_unref(helper.queue_slots);
+	return ret;
+}
+
 static void
 fu_chunk_array_ensure_offsets(FuChunkArray *self)
 {
@@ -238,6 +370,42 @@ fu_chunk_array_new_from_stream(GInputStream *stream,
 			       gsize page_sz,
 			       gsize packet_sz,
 			       GError **error)
+{
+	return fu_chunk_array_new_from_stream_full(stream,
+						   addr_offset,
+						   page_sz,
+						   packet_sz,
+						   FU_CHUNK_ARRAY_FLAG_NONE,
+						   error);
+}
+
+/**
+ * fu_chunk_array_new_from_stream_full:
+ * @stream: a #GInputStream
+ * @addr_offset: the hardware address offset, or %FU_CHUNK_ADDR_OFFSET_NONE
+ * @page_sz: the hardware page size, typically %FU_CHUNK_PAGESZ_NONE
+ * @packet_sz: the packet size, or 0x0
+ * @flags: a #FuChunkArrayFlags, e.g. %FU_CHUNK_ARRAY_FLAG_ZERO_COPY
+ * @error: (nullable): optional return location for an error
+ *
+ * Chunks a linear stream into packets, ensuring each packet is less that a specific
+ * transfer size.
+ *
+ * Using %FU_CHUNK_ARRAY_FLAG_ZERO_COPY reads the stream contents just once, and each chunk
+ * then references the shared buffer rather than allocating and copying per chunk -- which
+ * matters when writing a large payload with a small packet size.
+ *
+ * Returns: (transfer full): a #FuChunkArray, or #NULL on error
+ *
+ * Since: 2.0.3
+ **/
+FuChunkArray *
+fu_chunk_array_new_from_stream_full(GInputStream *stream,
+				    gsize addr_offset,
+				    gsize page_sz,
+				    gsize packet_sz,
+				    FuChunkArrayFlags flags,
+				    GError **error)
 {
 	g_autoptr(FuChunkArray) self = g_object_new(FU_TYPE_CHUNK_ARRAY, NULL);
 
@@ -252,7 +420,13 @@ fu_chunk_array_new_from_stream(GInputStream *stream,
 	self->addr_offset = addr_offset;
 	self->page_sz = page_sz;
 	self->packet_sz = packet_sz;
-	self->stream = g_object_ref(stream);
+	if (flags & FU_CHUNK_ARRAY_FLAG_ZERO_COPY && self->total_size > 0) {
+		self->blob = fu_input_stream_read_bytes(stream, 0x0, self->total_size, NULL, error);
+		if (self->blob == NULL)
+			return NULL;
+	} else {
+		self->stream = g_object_ref(stream);
+	}
 
 	/* success */
 	fu_chunk_array_ensure_offsets(self);
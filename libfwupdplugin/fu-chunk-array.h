@@ -14,6 +14,20 @@
 
 G_DECLARE_FINAL_TYPE(FuChunkArray, fu_chunk_array, FU, CHUNK_ARRAY, GObject)
 
+/**
+ * FuChunkArrayFlags:
+ * @FU_CHUNK_ARRAY_FLAG_NONE:		No flags set
+ * @FU_CHUNK_ARRAY_FLAG_ZERO_COPY:	Read the stream once and share the buffer between chunks
+ *
+ * The flags to use when creating the chunk array.
+ **/
+typedef enum {
+	FU_CHUNK_ARRAY_FLAG_NONE = 0,
+	FU_CHUNK_ARRAY_FLAG_ZERO_COPY = 1 << 0,
+	/*< private >*/
+	FU_CHUNK_ARRAY_FLAG_LAST
+} FuChunkArrayFlags;
+
 FuChunkArray *
 fu_chunk_array_new_virtual(gsize bufsz, gsize addr_offset, gsize page_sz, gsize packet_sz);
 FuChunkArray *
@@ -25,7 +39,39 @@ fu_chunk_array_new_from_stream(GInputStream *stream,
 			       gsize page_sz,
 			       gsize packet_sz,
 			       GError **error) G_GNUC_NON_NULL(1);
+FuChunkArray *
+fu_chunk_array_new_from_stream_full(GInputStream *stream,
+				    gsize addr_offset,
+				    gsize page_sz,
+				    gsize packet_sz,
+				    FuChunkArrayFlags flags,
+				    GError **error) G_GNUC_NON_NULL(1);
 guint
 fu_chunk_array_length(FuChunkArray *self) G_GNUC_NON_NULL(1);
 FuChunk *
 fu_chunk_array_index(FuChunkArray *self, guint idx, GError **error) G_GNUC_NON_NULL(1);
+
+/**
+ * FuChunkArrayWriteFunc:
+ * @self: a #FuChunkArray
+ * @chk: a #FuChunk
+ * @user_data: user data
+ * @error: (nullable): optional return location for an error
+ *
+ * The write function used by fu_chunk_array_write_pipelined().
+ *
+ * Returns: %TRUE on success
+ *
+ * Since: 2.0.3
+ **/
+typedef gboolean (*FuChunkArrayWriteFunc)(FuChunkArray *self,
+					  FuChunk *chk,
+					  gpointer user_data,
+					  GError **error) G_GNUC_WARN_UNUSED_RESULT;
+
+gboolean
+fu_chunk_array_write_pipelined(FuChunkArray *self,
+			       guint max_pending,
+			       FuChunkArrayWriteFunc write_func,
+			       gpointer user_data,
+			       GError **error) G_GNUC_NON_NULL(1, 3);
@@ -31,3 +31,11 @@ enum FuDisplayState {
     Connected,
     Disconnected,
 }
+
+#[derive(ToString, FromString)]
+enum FuDeviceVerifyKind {
+    Unknown,
+    Full,       // Read back and compare the entire firmware
+    Sampled,    // Read back a random subset of blocks
+    Attested,   // Trust a device-computed checksum
+}
@@ -404,8 +404,11 @@ fu_config_monitor_changed_cb(GFileMonitor *monitor,
 			     gpointer user_data)
 {
 	FuConfig *self = FU_CONFIG(user_data);
+	FuConfigPrivate *priv = GET_PRIVATE(self);
 	g_autoptr(GError) error = NULL;
 	g_autofree gchar *fn = g_file_get_path(file);
+	g_autofree gchar *data_old = NULL;
+	g_autofree gchar *data_new = NULL;
 
 	/* nothing we need to care about */
 	if (event_type == G_FILE_MONITOR_EVENT_ATTRIBUTE_CHANGED) {
@@ -415,8 +418,16 @@ fu_config_monitor_changed_cb(GFileMonitor *monitor,
 
 	/* reload everything */
 	g_info("%s changed, reloading all configs", fn);
+	data_old = g_key_file_to_data(priv->keyfile, NULL, NULL);
 	if (!fu_config_reload(self, &error))
 		g_warning("failed to rescan daemon config: %s", error->message);
+
+	/* no effective change, e.g. the file was rewritten with the same contents */
+	data_new = g_key_file_to_data(priv->keyfile, NULL, NULL);
+	if (g_strcmp0(data_old, data_new) == 0) {
+		g_debug("config contents unchanged, not emitting ::changed");
+		return;
+	}
 	fu_config_emit_changed(self);
 }
 
@@ -9,6 +9,7 @@
 #include "config.h"
 
 #include "fu-bios-settings-private.h"
+#include "fu-bytes.h"
 #include "fu-common-private.h"
 #include "fu-config-private.h"
 #include "fu-context-helper.h"
@@ -46,6 +47,7 @@ typedef struct {
 	GPtrArray *esp_volumes;
 	GHashTable *firmware_gtypes; /* utf8:GType */
 	GHashTable *hwid_flags;	     /* str: */
+	GHashTable *acpi_tables;     /* utf8:GBytes */
 	FuPowerState power_state;
 	FuLidState lid_state;
 	FuDisplayState display_state;
@@ -299,6 +301,53 @@ fu_context_get_smbios_integer(FuContext *self, guint8 type, guint8 offset, GErro
 	return fu_smbios_get_integer(priv->smbios, type, offset, error);
 }
 
+/**
+ * fu_context_get_acpi_table:
+ * @self: a #FuContext
+ * @signature: (not nullable): a table signature, e.g. `DMAR`
+ * @error: (nullable): optional return location for an error
+ *
+ * Gets the raw data for an ACPI table.
+ *
+ * The tables cannot change at runtime and so each one is read from sysfs at most once, with the
+ * mmap-backed blob shared between all the plugins that need it.
+ *
+ * Returns: (transfer full): a #GBytes, or %NULL on error
+ *
+ * Since: 2.0.3
+ **/
+GBytes *
+fu_context_get_acpi_table(FuContext *self, const gchar *signature, GError **error)
+{
+	FuContextPrivate *priv = GET_PRIVATE(self);
+	GBytes *blob;
+	g_autofree gchar *fn = NULL;
+	g_autofree gchar *path = NULL;
+	g_autoptr(GBytes) blob_new = NULL;
+
+	g_return_val_if_fail(FU_IS_CONTEXT(self), NULL);
+	g_return_val_if_fail(signature != NULL, NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+	/* already loaded */
+	blob = g_hash_table_lookup(priv->acpi_tables, signature);
+	if (blob != NULL)
+		return g_bytes_ref(blob);
+
+	/* load from sysfs */
+	path = fu_path_from_kind(FU_PATH_KIND_ACPI_TABLES);
+	fn = g_build_filename(path, signature, NULL);
+	blob_new = fu_bytes_get_contents(fn, error);
+	if (blob_new == NULL) {
+		g_prefix_error(error, "failed to load %s: ", fn);
+		return NULL;
+	}
+	g_hash_table_insert(priv->acpi_tables, g_strdup(signature), g_bytes_ref(blob_new));
+
+	/* success */
+	return g_steal_pointer(&blob_new);
+}
+
 /**
  * fu_context_reload_bios_settings:
  * @self: a #FuContext
@@ -969,6 +1018,45 @@ fu_context_lookup_quirk_by_id_iter(FuContext *self,
 					   &helper);
 }
 
+/**
+ * fu_context_lookup_quirk_by_ids_iter:
+ * @self: a #FuContext
+ * @guids: (element-type utf8): GUIDs to lookup
+ * @key: (nullable): an ID to match the entry, e.g. `Name`, or %NULL for all keys
+ * @iter_cb: (scope call) (closure user_data): a function to call for each result
+ * @user_data: user data passed to @iter_cb
+ *
+ * Looks up all entries in the hardware database using a set of GUID values,
+ * which is much faster than calling fu_context_lookup_quirk_by_id_iter() once
+ * per GUID when a device has many instance IDs.
+ *
+ * Returns: %TRUE if any ID was found, and @iter was called
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_context_lookup_quirk_by_ids_iter(FuContext *self,
+				    GPtrArray *guids,
+				    const gchar *key,
+				    FuContextLookupIter iter_cb,
+				    gpointer user_data)
+{
+	FuContextPrivate *priv = GET_PRIVATE(self);
+	FuContextQuirkLookupHelper helper = {
+	    .self = self,
+	    .iter_cb = iter_cb,
+	    .user_data = user_data,
+	};
+	g_return_val_if_fail(FU_IS_CONTEXT(self), FALSE);
+	g_return_val_if_fail(guids != NULL, FALSE);
+	g_return_val_if_fail(iter_cb != NULL, FALSE);
+	return fu_quirks_lookup_by_ids_iter(priv->quirks,
+					    guids,
+					    key,
+					    fu_context_lookup_quirk_by_id_iter_cb,
+					    &helper);
+}
+
 /**
  * fu_context_security_changed:
  * @self: a #FuContext
@@ -1084,16 +1172,13 @@ fu_context_load_hwinfo(FuContext *self,
 		g_warning("Failed to load HWIDs: %s", error_hwids->message);
 	fu_progress_step_done(progress);
 
-	/* set the hwid flags */
+	/* set the hwid flags, resolving all the GUIDs in one pass */
 	guids = fu_context_get_hwid_guids(self);
-	for (guint i = 0; i < guids->len; i++) {
-		const gchar *guid = g_ptr_array_index(guids, i);
-		fu_context_lookup_quirk_by_id_iter(self,
-						   guid,
-						   FU_QUIRKS_FLAGS,
-						   fu_context_hwid_quirk_cb,
-						   NULL);
-	}
+	fu_context_lookup_quirk_by_ids_iter(self,
+					    guids,
+					    FU_QUIRKS_FLAGS,
+					    fu_context_hwid_quirk_cb,
+					    NULL);
 	fu_progress_step_done(progress);
 
 	fu_context_add_udev_subsystem(self, "firmware-attributes", NULL);
@@ -1560,6 +1645,26 @@ fu_context_get_esp_volumes(FuContext *self, GError **error)
 	return g_ptr_array_ref(priv->esp_volumes);
 }
 
+/**
+ * fu_context_invalidate_esp_volumes:
+ * @self: a #FuContext
+ *
+ * Drops any cached EFI system partition volumes, typically done when the block subsystem
+ * topology has changed, so that the next call to fu_context_get_esp_volumes() probes again.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_context_invalidate_esp_volumes(FuContext *self)
+{
+	FuContextPrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FU_IS_CONTEXT(self));
+	if (priv->esp_volumes->len == 0)
+		return;
+	g_debug("invalidating %u cached ESP volumes", priv->esp_volumes->len);
+	g_ptr_array_set_size(priv->esp_volumes, 0);
+}
+
 static gboolean
 fu_context_is_esp_linux(FuVolume *esp, GError **error)
 {
@@ -2152,6 +2257,7 @@ fu_context_finalize(GObject *object)
 	g_object_unref(priv->host_bios_settings);
 	g_hash_table_unref(priv->firmware_gtypes);
 	g_hash_table_unref(priv->udev_subsystems);
+	g_hash_table_unref(priv->acpi_tables);
 	g_ptr_array_unref(priv->esp_volumes);
 	g_ptr_array_unref(priv->backends);
 
@@ -2323,6 +2429,10 @@ fu_context_init(FuContext *self)
 						      g_free,
 						      (GDestroyNotify)g_ptr_array_unref);
 	priv->firmware_gtypes = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	priv->acpi_tables = g_hash_table_new_full(g_str_hash,
+						  g_str_equal,
+						  g_free,
+						  (GDestroyNotify)g_bytes_unref);
 	priv->quirks = fu_quirks_new(self);
 	priv->host_bios_settings = fu_bios_settings_new();
 	priv->esp_volumes = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
@@ -154,6 +154,9 @@ fu_context_get_smbios_integer(FuContext *self, guint8 type, guint8 offset, GErro
 GPtrArray *
 fu_context_get_smbios_data(FuContext *self, guint8 structure_type, GError **error)
     G_GNUC_NON_NULL(1);
+GBytes *
+fu_context_get_acpi_table(FuContext *self, const gchar *signature, GError **error)
+    G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
 gboolean
 fu_context_has_hwid_guid(FuContext *self, const gchar *guid) G_GNUC_NON_NULL(1);
 GPtrArray *
@@ -183,6 +186,12 @@ fu_context_lookup_quirk_by_id_iter(FuContext *self,
 				   const gchar *key,
 				   FuContextLookupIter iter_cb,
 				   gpointer user_data) G_GNUC_NON_NULL(1, 2);
+gboolean
+fu_context_lookup_quirk_by_ids_iter(FuContext *self,
+				    GPtrArray *guids,
+				    const gchar *key,
+				    FuContextLookupIter iter_cb,
+				    gpointer user_data) G_GNUC_NON_NULL(1, 2);
 void
 fu_context_add_quirk_key(FuContext *self, const gchar *key) G_GNUC_NON_NULL(1, 2);
 void
@@ -219,6 +228,8 @@ fu_context_get_bios_setting(FuContext *self, const gchar *name) G_GNUC_NON_NULL(
 GPtrArray *
 fu_context_get_esp_volumes(FuContext *self, GError **error) G_GNUC_WARN_UNUSED_RESULT
     G_GNUC_NON_NULL(1);
+void
+fu_context_invalidate_esp_volumes(FuContext *self) G_GNUC_NON_NULL(1);
 FuVolume *
 fu_context_get_default_esp(FuContext *self, GError **error) G_GNUC_WARN_UNUSED_RESULT
     G_GNUC_NON_NULL(1);
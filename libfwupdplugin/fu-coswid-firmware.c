@@ -36,6 +36,9 @@ typedef struct {
 	GPtrArray *links;    /* of FuCoswidFirmwareLink */
 	GPtrArray *entities; /* of FuCoswidFirmwareEntity */
 	GPtrArray *payloads; /* of FuCoswidFirmwarePayload */
+#ifdef HAVE_CBOR
+	cbor_item_t *item; /* (nullable): detail decode deferred from ->parse() */
+#endif
 } FuCoswidFirmwarePrivate;
 
 G_DEFINE_TYPE_WITH_PRIVATE(FuCoswidFirmware, fu_coswid_firmware, FU_TYPE_FIRMWARE)
@@ -521,6 +524,58 @@ fu_coswid_firmware_parse_entity(cbor_item_t *item, gpointer user_data, GError **
 }
 #endif
 
+/* materialize the meta, links, payloads and entities deferred from ->parse() */
+static gboolean
+fu_coswid_firmware_ensure_details(FuCoswidFirmware *self, GError **error)
+{
+#ifdef HAVE_CBOR
+	FuCoswidFirmwarePrivate *priv = GET_PRIVATE(self);
+	struct cbor_pair *pairs = NULL;
+	g_autoptr(cbor_item_t) item = NULL;
+
+	/* already done, or built from XML */
+	if (priv->item == NULL)
+		return TRUE;
+
+	/* only ever attempt this once, even on failure */
+	item = g_steal_pointer(&priv->item);
+	pairs = cbor_map_handle(item);
+	for (gsize i = 0; i < cbor_map_size(item); i++) {
+		FuCoswidTag tag_id = 0;
+		if (!fu_coswid_read_tag(pairs[i].key, &tag_id, error))
+			return FALSE;
+		if (tag_id == FU_COSWID_TAG_SOFTWARE_META) {
+			if (!fu_coswid_parse_one_or_many(pairs[i].value,
+							 fu_coswid_firmware_parse_meta,
+							 self, /* user_data */
+							 error))
+				return FALSE;
+		} else if (tag_id == FU_COSWID_TAG_LINK) {
+			if (!fu_coswid_parse_one_or_many(pairs[i].value,
+							 fu_coswid_firmware_parse_link,
+							 self, /* user_data */
+							 error))
+				return FALSE;
+		} else if (tag_id == FU_COSWID_TAG_PAYLOAD) {
+			if (!fu_coswid_parse_one_or_many(pairs[i].value,
+							 fu_coswid_firmware_parse_payload,
+							 self, /* user_data */
+							 error))
+				return FALSE;
+		} else if (tag_id == FU_COSWID_TAG_ENTITY) {
+			if (!fu_coswid_parse_one_or_many(pairs[i].value,
+							 fu_coswid_firmware_parse_entity,
+							 self, /* user_data */
+							 error))
+				return FALSE;
+		}
+	}
+#endif
+
+	/* success */
+	return TRUE;
+}
+
 #ifdef HAVE_CBOR_SET_ALLOCS
 static void *
 fu_coswid_firmware_malloc(size_t size)
@@ -560,6 +615,8 @@ fu_coswid_firmware_parse(FuFirmware *firmware,
 #ifdef HAVE_CBOR
 	FuCoswidFirmware *self = FU_COSWID_FIRMWARE(firmware);
 	FuCoswidFirmwarePrivate *priv = GET_PRIVATE(self);
+	gboolean has_entity = FALSE;
+	gboolean has_link = FALSE;
 	struct cbor_load_result result = {0x0};
 	struct cbor_pair *pairs = NULL;
 	g_autoptr(cbor_item_t) item = NULL;
@@ -629,30 +686,13 @@ fu_coswid_firmware_parse(FuFirmware *firmware,
 							   &priv->version_scheme,
 							   error))
 				return FALSE;
-		} else if (tag_id == FU_COSWID_TAG_SOFTWARE_META) {
-			if (!fu_coswid_parse_one_or_many(pairs[i].value,
-							 fu_coswid_firmware_parse_meta,
-							 self, /* user_data */
-							 error))
-				return FALSE;
+		} else if (tag_id == FU_COSWID_TAG_SOFTWARE_META ||
+			   tag_id == FU_COSWID_TAG_PAYLOAD) {
+			/* deferred until actually needed */
 		} else if (tag_id == FU_COSWID_TAG_LINK) {
-			if (!fu_coswid_parse_one_or_many(pairs[i].value,
-							 fu_coswid_firmware_parse_link,
-							 self, /* user_data */
-							 error))
-				return FALSE;
-		} else if (tag_id == FU_COSWID_TAG_PAYLOAD) {
-			if (!fu_coswid_parse_one_or_many(pairs[i].value,
-							 fu_coswid_firmware_parse_payload,
-							 self, /* user_data */
-							 error))
-				return FALSE;
+			has_link = TRUE;
 		} else if (tag_id == FU_COSWID_TAG_ENTITY) {
-			if (!fu_coswid_parse_one_or_many(pairs[i].value,
-							 fu_coswid_firmware_parse_entity,
-							 self, /* user_data */
-							 error))
-				return FALSE;
+			has_entity = TRUE;
 		} else {
 			g_debug("unhandled tag %s from root", fu_coswid_tag_to_string(tag_id));
 		}
@@ -660,7 +700,7 @@ fu_coswid_firmware_parse(FuFirmware *firmware,
 
 	/* device not supported */
 	if (fu_firmware_get_id(firmware) == NULL && fu_firmware_get_version(firmware) == NULL &&
-	    priv->product == NULL && priv->entities->len == 0 && priv->links->len == 0) {
+	    priv->product == NULL && !has_entity && !has_link) {
 		g_set_error_literal(error,
 				    FWUPD_ERROR,
 				    FWUPD_ERROR_NOT_SUPPORTED,
@@ -668,6 +708,12 @@ fu_coswid_firmware_parse(FuFirmware *firmware,
 		return FALSE;
 	}
 
+	/* decoding the meta, links, payloads and entities is the expensive part and most
+	 * users only want the tag-id and version, so keep the root item and do it lazily */
+	if (priv->item != NULL)
+		cbor_decref(&priv->item);
+	priv->item = g_steal_pointer(&item);
+
 	/* success */
 	return TRUE;
 #else
@@ -708,6 +754,8 @@ fu_coswid_firmware_get_checksum(FuFirmware *firmware, GChecksumType csum_kind, G
 			    fwupd_checksum_type_to_string_display(csum_kind));
 		return NULL;
 	}
+	if (!fu_coswid_firmware_ensure_details(self, error))
+		return NULL;
 
 	/* find the correct hash kind */
 	for (guint i = 0; i < priv->payloads->len; i++) {
@@ -780,6 +828,9 @@ fu_coswid_firmware_write(FuFirmware *firmware, GError **error)
 	g_autoptr(cbor_item_t) root = cbor_new_indefinite_map();
 	g_autoptr(cbor_item_t) item_meta = cbor_new_indefinite_map();
 
+	if (!fu_coswid_firmware_ensure_details(self, error))
+		return NULL;
+
 	/* preallocate the map structure */
 	fu_coswid_write_tag_string(root, FU_COSWID_TAG_LANG, "en-US");
 	if (fu_firmware_get_id(firmware) != NULL) {
@@ -1113,6 +1164,10 @@ fu_coswid_firmware_export(FuFirmware *firmware, FuFirmwareExportFlags flags, XbB
 {
 	FuCoswidFirmware *self = FU_COSWID_FIRMWARE(firmware);
 	FuCoswidFirmwarePrivate *priv = GET_PRIVATE(self);
+	g_autoptr(GError) error_local = NULL;
+
+	if (!fu_coswid_firmware_ensure_details(self, &error_local))
+		g_warning("failed to decode coSWID detail: %s", error_local->message);
 	if (priv->version_scheme != FU_COSWID_VERSION_SCHEME_UNKNOWN) {
 		fu_xmlb_builder_insert_kv(bn,
 					  "version_scheme",
@@ -1185,6 +1240,10 @@ fu_coswid_firmware_finalize(GObject *object)
 	g_ptr_array_unref(priv->links);
 	g_ptr_array_unref(priv->payloads);
 	g_ptr_array_unref(priv->entities);
+#ifdef HAVE_CBOR
+	if (priv->item != NULL)
+		cbor_decref(&priv->item);
+#endif
 
 	G_OBJECT_CLASS(fu_coswid_firmware_parent_class)->finalize(object);
 }
@@ -57,6 +57,92 @@ const struct {
     {FU_CRC_KIND_B8_AUTOSAR, 8, 0x2F, 0xFF, FALSE, 0xFF},
 };
 
+/* the slowest part of CRCing a whole firmware image is the per-bit loop, so reflected 32-bit
+ * polynomials get a sliced-by-8 table kernel, with the table built once per polynomial */
+typedef struct {
+	guint32 poly_reflected;
+	guint32 table[8][256];
+} FuCrcSlice8Table;
+
+static FuCrcSlice8Table *
+fu_crc_get_slice8_table(guint32 poly_reflected)
+{
+	static GMutex mutex;
+	static GPtrArray *tables = NULL;
+	FuCrcSlice8Table *tbl;
+	g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&mutex);
+
+	if (tables == NULL)
+		tables = g_ptr_array_new();
+	for (guint i = 0; i < tables->len; i++) {
+		tbl = g_ptr_array_index(tables, i);
+		if (tbl->poly_reflected == poly_reflected)
+			return tbl;
+	}
+	tbl = g_new0(FuCrcSlice8Table, 1);
+	tbl->poly_reflected = poly_reflected;
+	for (guint i = 0; i < 256; i++) {
+		guint32 crc = i;
+		for (guint j = 0; j < 8; j++)
+			crc = (crc >> 1) ^ ((crc & 1) ? poly_reflected : 0);
+		tbl->table[0][i] = crc;
+	}
+	for (guint i = 0; i < 256; i++) {
+		for (guint j = 1; j < 8; j++) {
+			tbl->table[j][i] = (tbl->table[j - 1][i] >> 8) ^
+					   tbl->table[0][tbl->table[j - 1][i] & 0xFF];
+		}
+	}
+	g_ptr_array_add(tables, tbl);
+	return tbl;
+}
+
+static guint32
+fu_crc32_step_slice8(const FuCrcSlice8Table *tbl, const guint8 *buf, gsize bufsz, guint32 crc)
+{
+	gsize i = 0;
+
+	/* 8 bytes per iteration, the words read as little-endian values */
+	for (; i + 8 <= bufsz; i += 8) {
+		guint32 lo = fu_memread_uint32(buf + i, G_LITTLE_ENDIAN) ^ crc;
+		guint32 hi = fu_memread_uint32(buf + i + 4, G_LITTLE_ENDIAN);
+		crc = tbl->table[7][lo & 0xFF] ^ tbl->table[6][(lo >> 8) & 0xFF] ^
+		      tbl->table[5][(lo >> 16) & 0xFF] ^ tbl->table[4][lo >> 24] ^
+		      tbl->table[3][hi & 0xFF] ^ tbl->table[2][(hi >> 8) & 0xFF] ^
+		      tbl->table[1][(hi >> 16) & 0xFF] ^ tbl->table[0][hi >> 24];
+	}
+	for (; i < bufsz; i++)
+		crc = (crc >> 8) ^ tbl->table[0][(crc ^ buf[i]) & 0xFF];
+	return crc;
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define FU_CRC_HAVE_HW_CRC32C
+__attribute__((target("sse4.2"))) static guint32
+fu_crc32c_step_hw(const guint8 *buf, gsize bufsz, guint32 crc)
+{
+	gsize i = 0;
+
+	for (; i + 8 <= bufsz; i += 8) {
+		guint64 tmp = fu_memread_uint64(buf + i, G_LITTLE_ENDIAN);
+		crc = (guint32)__builtin_ia32_crc32di(crc, tmp);
+	}
+	for (; i < bufsz; i++)
+		crc = __builtin_ia32_crc32qi(crc, buf[i]);
+	return crc;
+}
+
+static gboolean
+fu_crc32c_hw_supported(void)
+{
+	static gsize supported = 0;
+	if (g_once_init_enter(&supported)) {
+		g_once_init_leave(&supported, __builtin_cpu_supports("sse4.2") ? 2 : 1);
+	}
+	return supported == 2;
+}
+#endif
+
 static guint8
 fu_crc_reflect8(guint8 data)
 {
@@ -295,6 +381,24 @@ fu_crc32_step(FuCrcKind kind, const guint8 *buf, gsize bufsz, guint32 crc)
 	g_return_val_if_fail(kind < FU_CRC_KIND_LAST, 0x0);
 	g_return_val_if_fail(crc_map[kind].bitwidth == 32, 0x0);
 
+	/* reflected polynomials can run in the reflected domain, where the byte-at-a-time
+	 * reflection folds away and we can use the table or hardware kernels */
+	if (crc_map[kind].reflected && bufsz >= 16) {
+		guint32 crc_ref = fu_crc_reflect(crc, bitwidth);
+#ifdef FU_CRC_HAVE_HW_CRC32C
+		if (kind == FU_CRC_KIND_B32_C && fu_crc32c_hw_supported()) {
+			crc_ref = fu_crc32c_step_hw(buf, bufsz, crc_ref);
+			return fu_crc_reflect(crc_ref, bitwidth);
+		}
+#endif
+		crc_ref = fu_crc32_step_slice8(
+		    fu_crc_get_slice8_table(fu_crc_reflect(crc_map[kind].poly, bitwidth)),
+		    buf,
+		    bufsz,
+		    crc_ref);
+		return fu_crc_reflect(crc_ref, bitwidth);
+	}
+
 	for (gsize i = 0; i < bufsz; ++i) {
 		guint32 tmp = crc_map[kind].reflected ? fu_crc_reflect8(buf[i]) : buf[i];
 		crc ^= tmp << (bitwidth - 8);
@@ -0,0 +1,13 @@
+/*
+ * Copyright 2024 Richard Hughes <richard@hughsie.com>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#include "fu-csv-entry.h"
+
+gboolean
+fu_csv_entry_parse_data(FuCsvEntry *self, GBytes *blob, gsize offset, gsize length, GError **error)
+    G_GNUC_NON_NULL(1, 2);
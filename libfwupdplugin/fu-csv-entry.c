@@ -7,8 +7,9 @@
 #include "config.h"
 
 #include "fu-common.h"
-#include "fu-csv-entry.h"
+#include "fu-csv-entry-private.h"
 #include "fu-csv-firmware-private.h"
+#include "fu-input-stream.h"
 #include "fu-string.h"
 
 /**
@@ -19,14 +20,22 @@
  * See also: [class@FuFirmware]
  */
 
+typedef struct {
+	guint32 offset;
+	guint32 length;
+} FuCsvEntryExtent;
+
 typedef struct {
 	GPtrArray *values;
+	GBytes *blob;
+	GArray *extents; /* of FuCsvEntryExtent */
 } FuCsvEntryPrivate;
 
 G_DEFINE_TYPE_WITH_PRIVATE(FuCsvEntry, fu_csv_entry, FU_TYPE_FIRMWARE)
 #define GET_PRIVATE(o) (fu_csv_entry_get_instance_private(o))
 
-#define FU_CSV_ENTRY_COLUMNS_MAX 1000u
+#define FU_CSV_ENTRY_COLUMNS_MAX   1000u
+#define FU_CSV_ENTRY_EXTENT_UNSET  G_MAXUINT32
 
 /**
  * fu_csv_entry_add_value:
@@ -61,10 +70,24 @@ const gchar *
 fu_csv_entry_get_value_by_idx(FuCsvEntry *self, guint idx)
 {
 	FuCsvEntryPrivate *priv = GET_PRIVATE(self);
+	const gchar *value;
+
 	g_return_val_if_fail(FU_IS_CSV_ENTRY(self), NULL);
+
 	if (idx >= priv->values->len)
 		return NULL;
-	return g_ptr_array_index(priv->values, idx);
+	value = g_ptr_array_index(priv->values, idx);
+
+	/* materialize the string from the source buffer on first use */
+	if (value == NULL && priv->blob != NULL && idx < priv->extents->len) {
+		FuCsvEntryExtent *extent = &g_array_index(priv->extents, FuCsvEntryExtent, idx);
+		if (extent->offset != FU_CSV_ENTRY_EXTENT_UNSET) {
+			const gchar *data = g_bytes_get_data(priv->blob, NULL);
+			priv->values->pdata[idx] = g_strndup(data + extent->offset, extent->length);
+			value = g_ptr_array_index(priv->values, idx);
+		}
+	}
+	return value;
 }
 
 /**
@@ -81,7 +104,6 @@ fu_csv_entry_get_value_by_idx(FuCsvEntry *self, guint idx)
 const gchar *
 fu_csv_entry_get_value_by_column_id(FuCsvEntry *self, const gchar *column_id)
 {
-	FuCsvEntryPrivate *priv = GET_PRIVATE(self);
 	FuCsvFirmware *parent = FU_CSV_FIRMWARE(fu_firmware_get_parent(FU_FIRMWARE(self)));
 	guint idx = fu_csv_firmware_get_idx_for_column_id(parent, column_id);
 
@@ -90,7 +112,7 @@ fu_csv_entry_get_value_by_column_id(FuCsvEntry *self, const gchar *column_id)
 	g_return_val_if_fail(idx != G_MAXUINT, NULL);
 	g_return_val_if_fail(column_id != NULL, NULL);
 
-	return g_ptr_array_index(priv->values, idx);
+	return fu_csv_entry_get_value_by_idx(self, idx);
 }
 
 gboolean
@@ -119,7 +141,7 @@ fu_csv_entry_export(FuFirmware *firmware, FuFirmwareExportFlags flags, XbBuilder
 	g_autoptr(XbBuilderNode) bc = xb_builder_node_insert(bn, "values", NULL);
 
 	for (guint i = 0; i < priv->values->len; i++) {
-		const gchar *value = g_ptr_array_index(priv->values, i);
+		const gchar *value = fu_csv_entry_get_value_by_idx(self, i);
 		const gchar *key = fu_csv_firmware_get_column_id(parent, i);
 		if (key != NULL)
 			fu_xmlb_builder_insert_kv(bc, key, value);
@@ -147,15 +169,23 @@ fu_csv_entry_build(FuFirmware *firmware, XbNode *n, GError **error)
 }
 
 static gboolean
-fu_csv_entry_parse_token_cb(GString *token, guint token_idx, gpointer user_data, GError **error)
+fu_csv_entry_parse_cell(FuCsvEntry *self,
+			const gchar *data,
+			gsize offset,
+			gsize length,
+			guint cell_idx,
+			GError **error)
 {
-	FuCsvEntry *self = FU_CSV_ENTRY(user_data);
 	FuCsvEntryPrivate *priv = GET_PRIVATE(self);
 	FuCsvFirmware *parent = FU_CSV_FIRMWARE(fu_firmware_get_parent(FU_FIRMWARE(self)));
-	const gchar *column_id = fu_csv_firmware_get_column_id(parent, token_idx);
+	const gchar *column_id = fu_csv_firmware_get_column_id(parent, cell_idx);
+	FuCsvEntryExtent extent = {
+	    .offset = FU_CSV_ENTRY_EXTENT_UNSET,
+	    .length = FU_CSV_ENTRY_EXTENT_UNSET,
+	};
 
 	/* sanity check */
-	if (token_idx > FU_CSV_ENTRY_COLUMNS_MAX) {
+	if (cell_idx > FU_CSV_ENTRY_COLUMNS_MAX) {
 		g_set_error(error,
 			    FWUPD_ERROR,
 			    FWUPD_ERROR_INVALID_DATA,
@@ -165,33 +195,80 @@ fu_csv_entry_parse_token_cb(GString *token, guint token_idx, gpointer user_data,
 	}
 
 	if (g_strcmp0(column_id, "$id") == 0) {
+		g_autofree gchar *tmp = g_strndup(data + offset, length);
 		g_ptr_array_add(priv->values, NULL);
-		fu_firmware_set_id(FU_FIRMWARE(self), token->str);
+		g_array_append_val(priv->extents, extent);
+		fu_firmware_set_id(FU_FIRMWARE(self), tmp);
 		return TRUE;
 	}
 	if (g_strcmp0(column_id, "$idx") == 0) {
 		guint64 value = 0;
-		if (!fu_strtoull(token->str, &value, 0, G_MAXUINT64, FU_INTEGER_BASE_AUTO, error))
+		g_autofree gchar *tmp = g_strndup(data + offset, length);
+		if (!fu_strtoull(tmp, &value, 0, G_MAXUINT64, FU_INTEGER_BASE_AUTO, error))
 			return FALSE;
 		g_ptr_array_add(priv->values, NULL);
+		g_array_append_val(priv->extents, extent);
 		fu_firmware_set_idx(FU_FIRMWARE(self), value);
 		return TRUE;
 	}
 	if (g_strcmp0(column_id, "$version") == 0) {
+		g_autofree gchar *tmp = g_strndup(data + offset, length);
 		g_ptr_array_add(priv->values, NULL);
-		fu_firmware_set_version(FU_FIRMWARE(self), token->str); /* nocheck:set-version */
+		g_array_append_val(priv->extents, extent);
+		fu_firmware_set_version(FU_FIRMWARE(self), tmp); /* nocheck:set-version */
 		return TRUE;
 	}
 	if (g_strcmp0(column_id, "$version_raw") == 0) {
 		guint64 value = 0;
-		if (!fu_strtoull(token->str, &value, 0, G_MAXUINT64, FU_INTEGER_BASE_AUTO, error))
+		g_autofree gchar *tmp = g_strndup(data + offset, length);
+		if (!fu_strtoull(tmp, &value, 0, G_MAXUINT64, FU_INTEGER_BASE_AUTO, error))
 			return FALSE;
 		g_ptr_array_add(priv->values, NULL);
+		g_array_append_val(priv->extents, extent);
 		fu_firmware_set_version_raw(FU_FIRMWARE(self), value);
 		return TRUE;
 	}
 
-	g_ptr_array_add(priv->values, g_strdup(token->str));
+	/* record the extent and copy the string lazily on first access */
+	extent.offset = (guint32)offset;
+	extent.length = (guint32)length;
+	g_ptr_array_add(priv->values, NULL);
+	g_array_append_val(priv->extents, extent);
+	return TRUE;
+}
+
+/* private */
+gboolean
+fu_csv_entry_parse_data(FuCsvEntry *self, GBytes *blob, gsize offset, gsize length, GError **error)
+{
+	FuCsvEntryPrivate *priv = GET_PRIVATE(self);
+	const gchar *data = g_bytes_get_data(blob, NULL);
+	gsize cell_offset = offset;
+	guint cell_idx = 0;
+
+	g_return_val_if_fail(FU_IS_CSV_ENTRY(self), FALSE);
+	g_return_val_if_fail(blob != NULL, FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	/* keep the source buffer alive so cells can reference it */
+	if (priv->blob == NULL)
+		priv->blob = g_bytes_ref(blob);
+
+	/* split on commas, without copying anything */
+	for (gsize pos = offset; pos <= offset + length; pos++) {
+		if (pos == offset + length || data[pos] == ',') {
+			if (!fu_csv_entry_parse_cell(self,
+						     data,
+						     cell_offset,
+						     pos - cell_offset,
+						     cell_idx++,
+						     error))
+				return FALSE;
+			cell_offset = pos + 1;
+		}
+	}
+
+	/* success */
 	return TRUE;
 }
 
@@ -202,7 +279,12 @@ fu_csv_entry_parse(FuFirmware *firmware,
 		   GError **error)
 {
 	FuCsvEntry *self = FU_CSV_ENTRY(firmware);
-	return fu_strsplit_stream(stream, 0x0, ",", fu_csv_entry_parse_token_cb, self, error);
+	g_autoptr(GBytes) blob = NULL;
+
+	blob = fu_input_stream_read_bytes(stream, 0x0, G_MAXSIZE, NULL, error);
+	if (blob == NULL)
+		return FALSE;
+	return fu_csv_entry_parse_data(self, blob, 0x0, g_bytes_get_size(blob), error);
 }
 
 static GByteArray *
@@ -215,7 +297,7 @@ fu_csv_entry_write(FuFirmware *firmware, GError **error)
 
 	/* single line */
 	for (guint i = 0; i < priv->values->len; i++) {
-		const gchar *value = g_ptr_array_index(priv->values, i);
+		const gchar *value = fu_csv_entry_get_value_by_idx(self, i);
 		if (str->len > 0)
 			g_string_append(str, ",");
 		if (value != NULL)
@@ -233,6 +315,7 @@ fu_csv_entry_init(FuCsvEntry *self)
 {
 	FuCsvEntryPrivate *priv = GET_PRIVATE(self);
 	priv->values = g_ptr_array_new_with_free_func(g_free);
+	priv->extents = g_array_new(FALSE, FALSE, sizeof(FuCsvEntryExtent));
 }
 
 static void
@@ -241,6 +324,9 @@ fu_csv_entry_finalize(GObject *object)
 	FuCsvEntry *self = FU_CSV_ENTRY(object);
 	FuCsvEntryPrivate *priv = GET_PRIVATE(self);
 	g_ptr_array_unref(priv->values);
+	g_array_unref(priv->extents);
+	if (priv->blob != NULL)
+		g_bytes_unref(priv->blob);
 	G_OBJECT_CLASS(fu_csv_entry_parent_class)->finalize(object);
 }
 
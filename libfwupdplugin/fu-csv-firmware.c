@@ -8,8 +8,9 @@
 
 #include "fu-byte-array.h"
 #include "fu-common.h"
-#include "fu-csv-entry.h"
+#include "fu-csv-entry-private.h"
 #include "fu-csv-firmware-private.h"
+#include "fu-input-stream.h"
 #include "fu-string.h"
 
 /**
@@ -144,35 +145,42 @@ fu_csv_firmware_parse_token_cb(GString *token, guint token_idx, gpointer user_da
 }
 
 static gboolean
-fu_csv_firmware_parse_line_cb(GString *token, guint token_idx, gpointer user_data, GError **error)
+fu_csv_firmware_parse_line(FuCsvFirmware *self,
+			   GBytes *blob,
+			   gsize offset,
+			   gsize length,
+			   guint line_idx,
+			   GError **error)
 {
-	FuCsvFirmware *self = FU_CSV_FIRMWARE(user_data);
+	const gchar *data = g_bytes_get_data(blob, NULL);
 	g_autoptr(FuFirmware) entry = fu_csv_entry_new();
-	g_autoptr(GBytes) fw = NULL;
 
 	/* ignore blank lines */
-	if (token->len == 0)
+	if (length == 0)
+		return TRUE;
+
+	/* skip lines that are not valid UTF-8 */
+	if (!g_utf8_validate(data + offset, length, NULL)) {
+		g_debug("ignoring line %u as not UTF-8", line_idx);
 		return TRUE;
+	}
 
 	/* title */
-	if (g_str_has_prefix(token->str, "#")) {
-		return fu_strsplit_full(token->str + 1,
-					token->len - 1,
+	if (data[offset] == '#') {
+		g_autofree gchar *title = g_strndup(data + offset + 1, length - 1);
+		return fu_strsplit_full(title,
+					length - 1,
 					",",
 					fu_csv_firmware_parse_token_cb,
 					self,
 					error);
-		return TRUE;
 	}
 
-	/* parse entry */
-	fw = g_bytes_new(token->str, token->len);
-	fu_firmware_set_idx(entry, token_idx);
+	/* parse entry in-place, no per-line copy */
+	fu_firmware_set_idx(entry, line_idx);
 	if (!fu_firmware_add_image_full(FU_FIRMWARE(self), entry, error))
 		return FALSE;
-	if (!fu_firmware_parse_bytes(entry, fw, 0x0, FWUPD_INSTALL_FLAG_NONE, error))
-		return FALSE;
-	return TRUE;
+	return fu_csv_entry_parse_data(FU_CSV_ENTRY(entry), blob, offset, length, error);
 }
 
 static gboolean
@@ -182,7 +190,35 @@ fu_csv_firmware_parse(FuFirmware *firmware,
 		      GError **error)
 {
 	FuCsvFirmware *self = FU_CSV_FIRMWARE(firmware);
-	return fu_strsplit_stream(stream, 0x0, "\n", fu_csv_firmware_parse_line_cb, self, error);
+	const gchar *data;
+	gsize bufsz = 0;
+	gsize line_offset = 0;
+	guint line_idx = 0;
+	g_autoptr(GBytes) blob = NULL;
+
+	/* single pass over the whole buffer, splitting on newlines */
+	blob = fu_input_stream_read_bytes(stream, 0x0, G_MAXSIZE, NULL, error);
+	if (blob == NULL)
+		return FALSE;
+	data = g_bytes_get_data(blob, &bufsz);
+	for (gsize pos = 0; pos <= bufsz; pos++) {
+		if (pos == bufsz || data[pos] == '\n' || data[pos] == '\0') {
+			if (!fu_csv_firmware_parse_line(self,
+							blob,
+							line_offset,
+							pos - line_offset,
+							line_idx++,
+							error))
+				return FALSE;
+			/* no more valid data */
+			if (pos < bufsz && data[pos] == '\0')
+				break;
+			line_offset = pos + 1;
+		}
+	}
+
+	/* success */
+	return TRUE;
 }
 
 static GByteArray *
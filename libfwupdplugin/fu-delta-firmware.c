@@ -0,0 +1,385 @@
+/*
+ * Copyright 2024 Richard Hughes <richard@hughsie.com>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#define G_LOG_DOMAIN "FuFirmware"
+
+#include "config.h"
+
+#include "fu-byte-array.h"
+#include "fu-common.h"
+#include "fu-delta-firmware-struct.h"
+#include "fu-delta-firmware.h"
+#include "fu-input-stream.h"
+#include "fu-mem.h"
+
+/**
+ * FuDeltaFirmware:
+ *
+ * A binary delta container, holding the checksum of the base image the delta applies to, the
+ * checksum of the patched result, and a list of write operations. Plugins for devices that can
+ * read-modify-write their flash can use fu_delta_firmware_apply() to reconstruct the full target
+ * image from the current device contents, transferring only the changed regions.
+ *
+ * The operations are stored as chunks, where the chunk address is the write offset in the
+ * target image.
+ *
+ * See also: [class@FuFirmware]
+ */
+
+typedef struct {
+	gchar *source_checksum;
+	gchar *target_checksum;
+} FuDeltaFirmwarePrivate;
+
+G_DEFINE_TYPE_WITH_PRIVATE(FuDeltaFirmware, fu_delta_firmware, FU_TYPE_FIRMWARE)
+#define GET_PRIVATE(o) (fu_delta_firmware_get_instance_private(o))
+
+/**
+ * fu_delta_firmware_get_source_checksum:
+ * @self: a #FuDeltaFirmware
+ *
+ * Gets the SHA-256 checksum of the base image this delta applies to.
+ *
+ * Returns: a string, or %NULL if unset
+ *
+ * Since: 2.0.3
+ **/
+const gchar *
+fu_delta_firmware_get_source_checksum(FuDeltaFirmware *self)
+{
+	FuDeltaFirmwarePrivate *priv = GET_PRIVATE(self);
+	g_return_val_if_fail(FU_IS_DELTA_FIRMWARE(self), NULL);
+	return priv->source_checksum;
+}
+
+/**
+ * fu_delta_firmware_set_source_checksum:
+ * @self: a #FuDeltaFirmware
+ * @checksum: (not nullable): a SHA-256 checksum
+ *
+ * Sets the SHA-256 checksum of the base image this delta applies to.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_delta_firmware_set_source_checksum(FuDeltaFirmware *self, const gchar *checksum)
+{
+	FuDeltaFirmwarePrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FU_IS_DELTA_FIRMWARE(self));
+	g_return_if_fail(checksum != NULL);
+	g_free(priv->source_checksum);
+	priv->source_checksum = g_strdup(checksum);
+}
+
+/**
+ * fu_delta_firmware_get_target_checksum:
+ * @self: a #FuDeltaFirmware
+ *
+ * Gets the SHA-256 checksum of the patched target image.
+ *
+ * Returns: a string, or %NULL if unset
+ *
+ * Since: 2.0.3
+ **/
+const gchar *
+fu_delta_firmware_get_target_checksum(FuDeltaFirmware *self)
+{
+	FuDeltaFirmwarePrivate *priv = GET_PRIVATE(self);
+	g_return_val_if_fail(FU_IS_DELTA_FIRMWARE(self), NULL);
+	return priv->target_checksum;
+}
+
+/**
+ * fu_delta_firmware_set_target_checksum:
+ * @self: a #FuDeltaFirmware
+ * @checksum: (not nullable): a SHA-256 checksum
+ *
+ * Sets the SHA-256 checksum of the patched target image.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_delta_firmware_set_target_checksum(FuDeltaFirmware *self, const gchar *checksum)
+{
+	FuDeltaFirmwarePrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FU_IS_DELTA_FIRMWARE(self));
+	g_return_if_fail(checksum != NULL);
+	g_free(priv->target_checksum);
+	priv->target_checksum = g_strdup(checksum);
+}
+
+static gboolean
+fu_delta_firmware_validate(FuFirmware *firmware, GInputStream *stream, gsize offset, GError **error)
+{
+	return fu_struct_delta_hdr_validate_stream(stream, offset, error);
+}
+
+static gboolean
+fu_delta_firmware_parse(FuFirmware *firmware,
+			GInputStream *stream,
+			FwupdInstallFlags flags,
+			GError **error)
+{
+	FuDeltaFirmware *self = FU_DELTA_FIRMWARE(firmware);
+	FuDeltaFirmwarePrivate *priv = GET_PRIVATE(self);
+	gsize offset = 0;
+	guint32 ops_cnt;
+	g_autoptr(GByteArray) st = NULL;
+
+	/* header */
+	st = fu_struct_delta_hdr_parse_stream(stream, offset, error);
+	if (st == NULL)
+		return FALSE;
+	if (fu_struct_delta_hdr_get_version(st) != 0x1) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_DATA,
+			    "delta version 0x%x not supported",
+			    fu_struct_delta_hdr_get_version(st));
+		return FALSE;
+	}
+	g_free(priv->source_checksum);
+	priv->source_checksum = fu_struct_delta_hdr_get_source_csum(st);
+	g_free(priv->target_checksum);
+	priv->target_checksum = fu_struct_delta_hdr_get_target_csum(st);
+	fu_firmware_set_size(firmware, fu_struct_delta_hdr_get_target_sz(st));
+	ops_cnt = fu_struct_delta_hdr_get_ops_cnt(st);
+	offset += st->len;
+
+	/* each write operation */
+	for (guint32 i = 0; i < ops_cnt; i++) {
+		guint32 datasz;
+		g_autoptr(FuChunk) chk = NULL;
+		g_autoptr(GByteArray) st_op = NULL;
+		g_autoptr(GBytes) blob = NULL;
+
+		st_op = fu_struct_delta_op_parse_stream(stream, offset, error);
+		if (st_op == NULL)
+			return FALSE;
+		offset += st_op->len;
+		datasz = fu_struct_delta_op_get_datasz(st_op);
+		if (datasz == 0) {
+			g_set_error_literal(error,
+					    FWUPD_ERROR,
+					    FWUPD_ERROR_INVALID_DATA,
+					    "delta op size was invalid");
+			return FALSE;
+		}
+		blob = fu_input_stream_read_bytes(stream, offset, datasz, NULL, error);
+		if (blob == NULL)
+			return FALSE;
+		chk = fu_chunk_bytes_new(blob);
+		fu_chunk_set_address(chk, fu_struct_delta_op_get_offset(st_op));
+		fu_firmware_add_chunk(firmware, chk);
+
+		/* next! */
+		offset += datasz;
+	}
+
+	/* success */
+	return TRUE;
+}
+
+static GByteArray *
+fu_delta_firmware_write(FuFirmware *firmware, GError **error)
+{
+	FuDeltaFirmware *self = FU_DELTA_FIRMWARE(firmware);
+	FuDeltaFirmwarePrivate *priv = GET_PRIVATE(self);
+	g_autoptr(GByteArray) buf = fu_struct_delta_hdr_new();
+	g_autoptr(GPtrArray) chunks = NULL;
+
+	/* the delta is useless without knowing what it applies to */
+	if (priv->source_checksum == NULL) {
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INVALID_DATA,
+				    "no source checksum set");
+		return NULL;
+	}
+	if (!fu_struct_delta_hdr_set_source_csum(buf, priv->source_checksum, error))
+		return NULL;
+	if (priv->target_checksum != NULL) {
+		if (!fu_struct_delta_hdr_set_target_csum(buf, priv->target_checksum, error))
+			return NULL;
+	}
+	fu_struct_delta_hdr_set_target_sz(buf, fu_firmware_get_size(firmware));
+
+	/* each write operation */
+	chunks = fu_firmware_get_chunks(firmware, error);
+	if (chunks == NULL)
+		return NULL;
+	fu_struct_delta_hdr_set_ops_cnt(buf, chunks->len);
+	for (guint i = 0; i < chunks->len; i++) {
+		FuChunk *chk = g_ptr_array_index(chunks, i);
+		g_autoptr(GByteArray) st_op = fu_struct_delta_op_new();
+		fu_struct_delta_op_set_offset(st_op, fu_chunk_get_address(chk));
+		fu_struct_delta_op_set_datasz(st_op, fu_chunk_get_data_sz(chk));
+		g_byte_array_append(buf, st_op->data, st_op->len);
+		g_byte_array_append(buf, fu_chunk_get_data(chk), fu_chunk_get_data_sz(chk));
+	}
+	return g_steal_pointer(&buf);
+}
+
+/**
+ * fu_delta_firmware_apply:
+ * @self: a #FuDeltaFirmware
+ * @stream: a #GInputStream of the current device image
+ * @error: (nullable): optional return location for an error
+ *
+ * Reconstructs the full target image by applying the delta operations to the current device
+ * contents, verifying the device image matches the delta base first and the patched result
+ * matches the stored target checksum afterwards.
+ *
+ * Returns: (transfer full): the patched image, or %NULL on error
+ *
+ * Since: 2.0.3
+ **/
+GBytes *
+fu_delta_firmware_apply(FuDeltaFirmware *self, GInputStream *stream, GError **error)
+{
+	FuDeltaFirmwarePrivate *priv = GET_PRIVATE(self);
+	gsize streamsz = 0;
+	guint64 target_sz = fu_firmware_get_size(FU_FIRMWARE(self));
+	g_autofree gchar *checksum = NULL;
+	g_autoptr(GByteArray) buf = NULL;
+	g_autoptr(GPtrArray) chunks = NULL;
+
+	g_return_val_if_fail(FU_IS_DELTA_FIRMWARE(self), NULL);
+	g_return_val_if_fail(G_IS_INPUT_STREAM(stream), NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+	/* refuse to patch an image the delta was not built against */
+	checksum = fu_input_stream_compute_checksum(stream, G_CHECKSUM_SHA256, error);
+	if (checksum == NULL)
+		return NULL;
+	if (g_strcmp0(checksum, priv->source_checksum) != 0) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_DATA,
+			    "device image %s does not match delta base %s",
+			    checksum,
+			    priv->source_checksum);
+		return NULL;
+	}
+
+	/* read the current image, padding up to the target size with 0xFF */
+	if (!fu_input_stream_size(stream, &streamsz, error))
+		return NULL;
+	buf = fu_input_stream_read_byte_array(stream, 0x0, streamsz, NULL, error);
+	if (buf == NULL)
+		return NULL;
+	if (buf->len < target_sz) {
+		gsize bufsz_old = buf->len;
+		g_byte_array_set_size(buf, target_sz);
+		memset(buf->data + bufsz_old, 0xff, target_sz - bufsz_old);
+	}
+
+	/* apply each write operation */
+	chunks = fu_firmware_get_chunks(FU_FIRMWARE(self), error);
+	if (chunks == NULL)
+		return NULL;
+	for (guint i = 0; i < chunks->len; i++) {
+		FuChunk *chk = g_ptr_array_index(chunks, i);
+		if (!fu_memcpy_safe(buf->data,
+				    buf->len,
+				    fu_chunk_get_address(chk), /* dst */
+				    fu_chunk_get_data(chk),
+				    fu_chunk_get_data_sz(chk),
+				    0x0, /* src */
+				    fu_chunk_get_data_sz(chk),
+				    error))
+			return NULL;
+	}
+
+	/* the target may be smaller than the base image */
+	g_byte_array_set_size(buf, target_sz);
+
+	/* verify the patched result */
+	if (priv->target_checksum != NULL) {
+		g_autofree gchar *checksum_new =
+		    g_compute_checksum_for_data(G_CHECKSUM_SHA256, buf->data, buf->len);
+		if (g_strcmp0(checksum_new, priv->target_checksum) != 0) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INVALID_DATA,
+				    "patched image %s does not match target %s",
+				    checksum_new,
+				    priv->target_checksum);
+			return NULL;
+		}
+	}
+
+	/* success */
+	return g_byte_array_free_to_bytes(g_steal_pointer(&buf)); /* nocheck:blocked */
+}
+
+static void
+fu_delta_firmware_export(FuFirmware *firmware, FuFirmwareExportFlags flags, XbBuilderNode *bn)
+{
+	FuDeltaFirmware *self = FU_DELTA_FIRMWARE(firmware);
+	FuDeltaFirmwarePrivate *priv = GET_PRIVATE(self);
+	fu_xmlb_builder_insert_kv(bn, "source_checksum", priv->source_checksum);
+	fu_xmlb_builder_insert_kv(bn, "target_checksum", priv->target_checksum);
+}
+
+static gboolean
+fu_delta_firmware_build(FuFirmware *firmware, XbNode *n, GError **error)
+{
+	FuDeltaFirmware *self = FU_DELTA_FIRMWARE(firmware);
+	const gchar *tmp;
+
+	/* optional properties */
+	tmp = xb_node_query_text(n, "source_checksum", NULL);
+	if (tmp != NULL)
+		fu_delta_firmware_set_source_checksum(self, tmp);
+	tmp = xb_node_query_text(n, "target_checksum", NULL);
+	if (tmp != NULL)
+		fu_delta_firmware_set_target_checksum(self, tmp);
+
+	/* success */
+	return TRUE;
+}
+
+static void
+fu_delta_firmware_init(FuDeltaFirmware *self)
+{
+}
+
+static void
+fu_delta_firmware_finalize(GObject *object)
+{
+	FuDeltaFirmware *self = FU_DELTA_FIRMWARE(object);
+	FuDeltaFirmwarePrivate *priv = GET_PRIVATE(self);
+	g_free(priv->source_checksum);
+	g_free(priv->target_checksum);
+	G_OBJECT_CLASS(fu_delta_firmware_parent_class)->finalize(object);
+}
+
+static void
+fu_delta_firmware_class_init(FuDeltaFirmwareClass *klass)
+{
+	FuFirmwareClass *firmware_class = FU_FIRMWARE_CLASS(klass);
+	GObjectClass *object_class = G_OBJECT_CLASS(klass);
+	object_class->finalize = fu_delta_firmware_finalize;
+	firmware_class->validate = fu_delta_firmware_validate;
+	firmware_class->parse = fu_delta_firmware_parse;
+	firmware_class->write = fu_delta_firmware_write;
+	firmware_class->export = fu_delta_firmware_export;
+	firmware_class->build = fu_delta_firmware_build;
+}
+
+/**
+ * fu_delta_firmware_new:
+ *
+ * Creates a new #FuFirmware for a binary delta container
+ *
+ * Since: 2.0.3
+ **/
+FuFirmware *
+fu_delta_firmware_new(void)
+{
+	return FU_FIRMWARE(g_object_new(FU_TYPE_DELTA_FIRMWARE, NULL));
+}
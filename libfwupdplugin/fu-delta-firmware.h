@@ -0,0 +1,33 @@
+/*
+ * Copyright 2024 Richard Hughes <richard@hughsie.com>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#include "fu-firmware.h"
+
+#define FU_TYPE_DELTA_FIRMWARE (fu_delta_firmware_get_type())
+G_DECLARE_DERIVABLE_TYPE(FuDeltaFirmware, fu_delta_firmware, FU, DELTA_FIRMWARE, FuFirmware)
+
+struct _FuDeltaFirmwareClass {
+	FuFirmwareClass parent_class;
+};
+
+FuFirmware *
+fu_delta_firmware_new(void);
+const gchar *
+fu_delta_firmware_get_source_checksum(FuDeltaFirmware *self) G_GNUC_NON_NULL(1);
+void
+fu_delta_firmware_set_source_checksum(FuDeltaFirmware *self,
+				      const gchar *checksum) G_GNUC_NON_NULL(1, 2);
+const gchar *
+fu_delta_firmware_get_target_checksum(FuDeltaFirmware *self) G_GNUC_NON_NULL(1);
+void
+fu_delta_firmware_set_target_checksum(FuDeltaFirmware *self,
+				      const gchar *checksum) G_GNUC_NON_NULL(1, 2);
+GBytes *
+fu_delta_firmware_apply(FuDeltaFirmware *self,
+			GInputStream *stream,
+			GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
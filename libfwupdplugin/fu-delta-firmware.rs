@@ -0,0 +1,18 @@
+// Copyright 2024 Richard Hughes <richard@hughsie.com>
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#[derive(New, ValidateStream, ParseStream, Default)]
+struct FuStructDeltaHdr {
+    magic: [char; 4] == "FuDl",
+    version: u32le = 0x1,
+    source_csum: [char; 64],
+    target_csum: [char; 64],
+    target_sz: u64le,
+    ops_cnt: u32le,
+}
+
+#[derive(New, ParseStream)]
+struct FuStructDeltaOp {
+    offset: u64le,
+    datasz: u32le,
+}
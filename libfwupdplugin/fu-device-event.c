@@ -130,7 +130,8 @@ fu_device_event_set_i64(FuDeviceEvent *self, const gchar *key, gint64 value)
  * @key: (not nullable): a unique key, e.g. `Name`
  * @value: (not nullable): a #GBytes
  *
- * Sets a blob on the event. Note: blobs are stored internally as BASE-64 strings.
+ * Sets a blob on the event. Note: blobs are stored internally as raw data and are only BASE-64
+ * encoded when exported as JSON.
  *
  * Since: 2.0.0
  **/
@@ -141,13 +142,11 @@ fu_device_event_set_bytes(FuDeviceEvent *self, const gchar *key, GBytes *value)
 	g_return_if_fail(FU_IS_DEVICE_EVENT(self));
 	g_return_if_fail(key != NULL);
 	g_return_if_fail(value != NULL);
-	g_hash_table_insert(
-	    priv->values,
-	    g_strdup(key),
-	    fu_device_event_blob_create(
-		G_TYPE_STRING,
-		g_base64_encode(g_bytes_get_data(value, NULL), g_bytes_get_size(value)),
-		g_free));
+	g_hash_table_insert(priv->values,
+			    g_strdup(key),
+			    fu_device_event_blob_create(G_TYPE_BYTES,
+							g_bytes_ref(value),
+							(GDestroyNotify)g_bytes_unref));
 }
 
 /**
@@ -157,7 +156,8 @@ fu_device_event_set_bytes(FuDeviceEvent *self, const gchar *key, GBytes *value)
  * @buf: (nullable): a buffer
  * @bufsz: size of @buf
  *
- * Sets a memory buffer on the event. Note: memory buffers are stored internally as BASE-64 strings.
+ * Sets a memory buffer on the event. Note: memory buffers are stored internally as raw data and
+ * are only BASE-64 encoded when exported as JSON.
  *
  * Since: 2.0.0
  **/
@@ -167,10 +167,11 @@ fu_device_event_set_data(FuDeviceEvent *self, const gchar *key, const guint8 *bu
 	FuDeviceEventPrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FU_IS_DEVICE_EVENT(self));
 	g_return_if_fail(key != NULL);
-	g_hash_table_insert(
-	    priv->values,
-	    g_strdup(key),
-	    fu_device_event_blob_create(G_TYPE_STRING, g_base64_encode(buf, bufsz), g_free));
+	g_hash_table_insert(priv->values,
+			    g_strdup(key),
+			    fu_device_event_blob_create(G_TYPE_BYTES,
+							g_bytes_new(buf, bufsz),
+							(GDestroyNotify)g_bytes_unref));
 }
 
 static gpointer
@@ -193,6 +194,47 @@ fu_device_event_lookup(FuDeviceEvent *self, const gchar *key, GType gtype, GErro
 	return blob->data;
 }
 
+static GBytes *
+fu_device_event_lookup_bytes(FuDeviceEvent *self, const gchar *key, GError **error)
+{
+	FuDeviceEventPrivate *priv = GET_PRIVATE(self);
+	FuDeviceEventBlob *blob = g_hash_table_lookup(priv->values, key);
+
+	if (blob == NULL) {
+		g_set_error(error, FWUPD_ERROR, FWUPD_ERROR_NOT_FOUND, "no event for key %s", key);
+		return NULL;
+	}
+
+	/* loaded from JSON as BASE-64; convert in place so we only pay the decode cost once */
+	if (blob->gtype == G_TYPE_STRING) {
+		GBytes *bytes;
+		gsize bufsz = 0;
+		g_autofree guchar *buf = NULL;
+		const gchar *blobstr = (const gchar *)blob->data;
+
+		if (blobstr[0] == '\0') {
+			bytes = g_bytes_new(NULL, 0);
+		} else {
+			buf = g_base64_decode(blobstr, &bufsz);
+			bytes = g_bytes_new_take(g_steal_pointer(&buf), bufsz);
+		}
+		if (blob->destroy)
+			blob->destroy(blob->data);
+		blob->gtype = G_TYPE_BYTES;
+		blob->data = bytes;
+		blob->destroy = (GDestroyNotify)g_bytes_unref;
+	}
+	if (blob->gtype != G_TYPE_BYTES) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_DATA,
+			    "invalid event type for key %s",
+			    key);
+		return NULL;
+	}
+	return blob->data;
+}
+
 /**
  * fu_device_event_get_str:
  * @self: a #FuDeviceEvent
@@ -254,21 +296,16 @@ fu_device_event_get_i64(FuDeviceEvent *self, const gchar *key, GError **error)
 GBytes *
 fu_device_event_get_bytes(FuDeviceEvent *self, const gchar *key, GError **error)
 {
-	const gchar *blobstr;
-	gsize bufsz = 0;
-	g_autofree guchar *buf = NULL;
+	GBytes *bytes;
 
 	g_return_val_if_fail(FU_IS_DEVICE_EVENT(self), NULL);
 	g_return_val_if_fail(key != NULL, NULL);
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
-	blobstr = fu_device_event_lookup(self, key, G_TYPE_STRING, error);
-	if (blobstr == NULL)
+	bytes = fu_device_event_lookup_bytes(self, key, error);
+	if (bytes == NULL)
 		return NULL;
-	if (blobstr[0] == '\0')
-		return g_bytes_new(NULL, 0);
-	buf = g_base64_decode(blobstr, &bufsz);
-	return g_bytes_new_take(g_steal_pointer(&buf), bufsz);
+	return g_bytes_ref(bytes);
 }
 
 /**
@@ -294,18 +331,18 @@ fu_device_event_copy_data(FuDeviceEvent *self,
 			  gsize *actual_length,
 			  GError **error)
 {
-	const gchar *blobstr;
+	GBytes *bytes;
 	gsize bufsz_src = 0;
-	g_autofree guchar *buf_src = NULL;
+	const guint8 *buf_src;
 
 	g_return_val_if_fail(FU_IS_DEVICE_EVENT(self), FALSE);
 	g_return_val_if_fail(key != NULL, FALSE);
 	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
-	blobstr = fu_device_event_lookup(self, key, G_TYPE_STRING, error);
-	if (blobstr == NULL)
+	bytes = fu_device_event_lookup_bytes(self, key, error);
+	if (bytes == NULL)
 		return FALSE;
-	buf_src = g_base64_decode(blobstr, &bufsz_src);
+	buf_src = g_bytes_get_data(bytes, &bufsz_src);
 	if (actual_length != NULL)
 		*actual_length = bufsz_src;
 	if (buf != NULL)
@@ -332,7 +369,14 @@ fu_device_event_add_json(FwupdCodec *codec, JsonBuilder *builder, FwupdCodecFlag
 		if (blob->gtype == G_TYPE_INT) {
 			json_builder_set_member_name(builder, (const gchar *)key);
 			json_builder_add_int_value(builder, *((gint64 *)blob->data));
-		} else if (blob->gtype == G_TYPE_BYTES || blob->gtype == G_TYPE_STRING) {
+		} else if (blob->gtype == G_TYPE_BYTES) {
+			GBytes *bytes = (GBytes *)blob->data;
+			g_autofree gchar *blobstr =
+			    g_base64_encode(g_bytes_get_data(bytes, NULL),
+					    g_bytes_get_size(bytes));
+			json_builder_set_member_name(builder, (const gchar *)key);
+			json_builder_add_string_value(builder, blobstr);
+		} else if (blob->gtype == G_TYPE_STRING) {
 			json_builder_set_member_name(builder, (const gchar *)key);
 			json_builder_add_string_value(builder, (const gchar *)blob->data);
 		} else {
@@ -9,6 +9,7 @@
 #include "config.h"
 
 #include <gio/gio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "fwupd-common.h"
@@ -70,13 +71,20 @@ typedef struct {
 	GPtrArray *parent_backend_ids;	/* (nullable) */
 	GPtrArray *counterpart_guids;	/* (nullable) */
 	GPtrArray *events;		/* (nullable) (element-type FuDeviceEvent) */
+	GHashTable *events_by_id;	/* (nullable) (element-type utf8 GPtrArray) */
 	guint event_idx;
 	guint remove_delay;    /* ms */
 	guint acquiesce_delay; /* ms */
+	FuDeviceVerifyKind verify_kind;
 	guint request_cnts[FWUPD_REQUEST_KIND_LAST];
 	gint order;
 	guint priority;
 	guint poll_id;
+	guint poll_interval;	  /* ms */
+	guint poll_backoff;	  /* multiplier, power of two */
+	guint poll_unchanged_cnt; /* polls since the last property notification */
+	gboolean poll_changed_seen;
+	gulong notify_poll_handler_id;
 	gint poll_locker_cnt;
 	gboolean done_probe;
 	gboolean done_setup;
@@ -92,8 +100,14 @@ typedef struct {
 	GPtrArray *instance_id_quirks; /* (nullable) (element-type utf-8) */
 	GPtrArray *retry_recs;	       /* (nullable) (element-type FuDeviceRetryRecovery) */
 	guint retry_delay;
+	guint retry_failure_budget; /* 0 = unlimited */
+	guint retry_failure_cnt;
+	FuDeviceRetryPolicy retry_policy;
+	gint64 retry_deadline; /* monotonic, 0 = unset */
 	GPtrArray *private_flags_registered; /* (nullable) (element-type GRefString) */
 	GPtrArray *private_flags;	     /* (nullable) (element-type utf-8) */
+	GHashTable *private_flags_idx;	     /* (nullable) (element-type utf8 guint) */
+	GArray *private_flags_bitmask;	     /* (nullable) (element-type guint64) */
 	gchar *custom_flags;
 	gulong notify_flags_handler_id;
 	gulong notify_flags_proxy_id;
@@ -241,9 +255,22 @@ void
 fu_device_register_private_flag_safe(FuDevice *self, const gchar *flag)
 {
 	FuDevicePrivate *priv = GET_PRIVATE(self);
+	const gchar *flag_interned;
+
 	g_return_if_fail(FU_IS_DEVICE(self));
 	g_return_if_fail(flag != NULL);
-	g_ptr_array_add(priv->private_flags_registered, g_ref_string_new_intern(flag));
+
+	flag_interned = g_ref_string_new_intern(flag);
+	g_ptr_array_add(priv->private_flags_registered, (gpointer)flag_interned);
+
+	/* the key is borrowed from the registered array, and the 1-based index into that array
+	 * chooses the bit to use -- so testing a flag is a hash lookup and an array load rather
+	 * than a strcmp() of every registered flag */
+	g_hash_table_insert(priv->private_flags_idx,
+			    (gpointer)flag_interned,
+			    GUINT_TO_POINTER(priv->private_flags_registered->len));
+	g_array_set_size(priv->private_flags_bitmask,
+			 (priv->private_flags_registered->len / 64) + 1);
 }
 
 static void
@@ -299,6 +326,7 @@ fu_device_register_flags(FuDevice *self)
 	fu_device_register_private_flag_safe(self, FU_DEVICE_PRIVATE_FLAG_USE_RUNTIME_VERSION);
 	fu_device_register_private_flag_safe(self, FU_DEVICE_PRIVATE_FLAG_SKIPS_RESTART);
 	fu_device_register_private_flag_safe(self, FU_DEVICE_PRIVATE_FLAG_IS_FAKE);
+	fu_device_register_private_flag_safe(self, FU_DEVICE_PRIVATE_FLAG_COMPOSITE_ACQUIESCE);
 }
 
 static void
@@ -313,26 +341,38 @@ fu_device_ensure_private_flags(FuDevice *self)
 	priv->private_flags_registered =
 	    g_ptr_array_new_with_free_func((GDestroyNotify)g_ref_string_release);
 	priv->private_flags = g_ptr_array_new();
+	priv->private_flags_idx = g_hash_table_new(g_str_hash, g_str_equal);
+	priv->private_flags_bitmask = g_array_new(FALSE, TRUE, sizeof(guint64));
 
 	/* subclassed */
 	if (device_class->register_flags != NULL)
 		device_class->register_flags(self);
 }
 
-static const gchar *
-fu_device_find_private_flag_registered(FuDevice *self, const gchar *flag)
+/* returns the 0-based registration index, or %G_MAXUINT if the flag is unknown */
+static guint
+fu_device_find_private_flag_idx(FuDevice *self, const gchar *flag)
 {
 	FuDevicePrivate *priv = GET_PRIVATE(self);
+	gpointer value;
 
 	/* make sure base private flags are registered */
 	fu_device_ensure_private_flags(self);
 
-	for (guint i = 0; i < priv->private_flags_registered->len; i++) {
-		const gchar *flag_tmp = g_ptr_array_index(priv->private_flags_registered, i);
-		if (g_strcmp0(flag, flag_tmp) == 0)
-			return flag_tmp;
-	}
-	return NULL;
+	value = g_hash_table_lookup(priv->private_flags_idx, flag);
+	if (value == NULL)
+		return G_MAXUINT;
+	return GPOINTER_TO_UINT(value) - 1;
+}
+
+static const gchar *
+fu_device_find_private_flag_registered(FuDevice *self, const gchar *flag)
+{
+	FuDevicePrivate *priv = GET_PRIVATE(self);
+	guint idx = fu_device_find_private_flag_idx(self, flag);
+	if (idx == G_MAXUINT)
+		return NULL;
+	return g_ptr_array_index(priv->private_flags_registered, idx);
 }
 
 /**
@@ -349,6 +389,8 @@ fu_device_add_private_flag(FuDevice *self, const gchar *flag)
 {
 	FuDevicePrivate *priv = GET_PRIVATE(self);
 	const gchar *flag_registered;
+	guint64 *bitmask;
+	guint idx;
 
 	g_return_if_fail(FU_IS_DEVICE(self));
 	g_return_if_fail(flag != NULL);
@@ -369,8 +411,8 @@ fu_device_add_private_flag(FuDevice *self, const gchar *flag)
 	}
 
 	/* check exists */
-	flag_registered = fu_device_find_private_flag_registered(self, flag);
-	if (flag_registered == NULL) {
+	idx = fu_device_find_private_flag_idx(self, flag);
+	if (idx == G_MAXUINT) {
 #ifndef SUPPORTED_BUILD
 		g_critical("%s flag %s is unknown -- use fu_device_register_private_flag()",
 			   G_OBJECT_TYPE_NAME(self),
@@ -378,12 +420,15 @@ fu_device_add_private_flag(FuDevice *self, const gchar *flag)
 #endif
 		return;
 	}
+	flag_registered = g_ptr_array_index(priv->private_flags_registered, idx);
 
 	/* already set */
-	if (g_ptr_array_find(priv->private_flags, flag_registered, NULL))
+	bitmask = &g_array_index(priv->private_flags_bitmask, guint64, idx / 64);
+	if ((*bitmask & ((guint64)1 << (idx % 64))) > 0)
 		return;
 
 	/* add */
+	*bitmask |= (guint64)1 << (idx % 64);
 	g_ptr_array_add(priv->private_flags, (gpointer)flag_registered); /* no ref */
 	g_object_notify(G_OBJECT(self), "private-flags");
 }
@@ -402,6 +447,8 @@ fu_device_remove_private_flag(FuDevice *self, const gchar *flag)
 {
 	FuDevicePrivate *priv = GET_PRIVATE(self);
 	const gchar *flag_registered;
+	guint64 *bitmask;
+	guint idx;
 
 	g_return_if_fail(FU_IS_DEVICE(self));
 	g_return_if_fail(flag != NULL);
@@ -409,8 +456,8 @@ fu_device_remove_private_flag(FuDevice *self, const gchar *flag)
 	if (g_strcmp0(flag, FU_DEVICE_PRIVATE_FLAG_UNCONNECTED) == 0)
 		fu_device_uninhibit(self, "unconnected");
 
-	flag_registered = fu_device_find_private_flag_registered(self, flag);
-	if (flag_registered == NULL) {
+	idx = fu_device_find_private_flag_idx(self, flag);
+	if (idx == G_MAXUINT) {
 #ifndef SUPPORTED_BUILD
 		g_critical("%s flag %s is unknown -- use fu_device_register_private_flag()",
 			   G_OBJECT_TYPE_NAME(self),
@@ -418,6 +465,9 @@ fu_device_remove_private_flag(FuDevice *self, const gchar *flag)
 #endif
 		return;
 	}
+	flag_registered = g_ptr_array_index(priv->private_flags_registered, idx);
+	bitmask = &g_array_index(priv->private_flags_bitmask, guint64, idx / 64);
+	*bitmask &= ~((guint64)1 << (idx % 64));
 	g_ptr_array_remove(priv->private_flags, (gpointer)flag_registered);
 	g_object_notify(G_OBJECT(self), "private-flags");
 }
@@ -435,13 +485,13 @@ gboolean
 fu_device_has_private_flag(FuDevice *self, const gchar *flag)
 {
 	FuDevicePrivate *priv = GET_PRIVATE(self);
-	const gchar *flag_registered;
+	guint idx;
 
 	g_return_val_if_fail(FU_IS_DEVICE(self), FALSE);
 	g_return_val_if_fail(flag != NULL, FALSE);
 
-	flag_registered = fu_device_find_private_flag_registered(self, flag);
-	if (flag_registered == NULL) {
+	idx = fu_device_find_private_flag_idx(self, flag);
+	if (idx == G_MAXUINT) {
 #ifndef SUPPORTED_BUILD
 		g_critical("%s flag %s is unknown -- use fu_device_register_private_flag()",
 			   G_OBJECT_TYPE_NAME(self),
@@ -449,7 +499,8 @@ fu_device_has_private_flag(FuDevice *self, const gchar *flag)
 #endif
 		return FALSE;
 	}
-	return g_ptr_array_find(priv->private_flags, flag_registered, NULL);
+	return (g_array_index(priv->private_flags_bitmask, guint64, idx / 64) &
+		((guint64)1 << (idx % 64))) > 0;
 }
 
 /**
@@ -569,6 +620,86 @@ fu_device_retry_set_delay(FuDevice *self, guint delay)
 	priv->retry_delay = delay;
 }
 
+/**
+ * fu_device_retry_set_failure_budget:
+ * @self: a #FuDevice
+ * @failure_budget: number of failed tries, or 0 for unlimited
+ *
+ * Sets the cumulative number of failed tries allowed across every call to
+ * fu_device_retry() and fu_device_retry_full() before the operation is aborted.
+ *
+ * Each per-chunk timeout on a failing device can otherwise wait for the full retry count,
+ * and with many thousands of chunks this can wedge an install for hours. Setting a budget
+ * bounds the worst-case latency without changing the behavior of occasional glitches.
+ *
+ * The budget is not suitable for devices that use the retry functions to poll for
+ * device readiness, as each poll failure counts against it.
+ *
+ * The current failure count is reset when the budget is set, and also for each call to
+ * fu_device_write_firmware().
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_device_retry_set_failure_budget(FuDevice *self, guint failure_budget)
+{
+	FuDevicePrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FU_IS_DEVICE(self));
+	priv->retry_failure_budget = failure_budget;
+	priv->retry_failure_cnt = 0;
+}
+
+/**
+ * fu_device_retry_set_policy:
+ * @self: a #FuDevice
+ * @policy: a #FuDeviceRetryPolicy, e.g. %FU_DEVICE_RETRY_POLICY_EXPONENTIAL
+ *
+ * Sets how the delay given to fu_device_retry_full() is spaced between tries.
+ *
+ * With %FU_DEVICE_RETRY_POLICY_EXPONENTIAL the delay is used for the first wait only and
+ * doubles on each further failure, with jitter applied so that many devices retrying at
+ * once do not stay in lockstep -- transient glitches recover quickly and persistent
+ * failures back off instead of hammering the device.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_device_retry_set_policy(FuDevice *self, FuDeviceRetryPolicy policy)
+{
+	FuDevicePrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FU_IS_DEVICE(self));
+	g_return_if_fail(policy < FU_DEVICE_RETRY_POLICY_LAST);
+	priv->retry_policy = policy;
+}
+
+/**
+ * fu_device_retry_set_deadline:
+ * @self: a #FuDevice
+ * @timeout_ms: budget in milliseconds, or 0 to disarm
+ *
+ * Arms a deadline shared by every subsequent call to fu_device_retry() and
+ * fu_device_retry_full() on this device: a retry loop that would have to wait past the
+ * deadline aborts with the underlying error instead. This bounds the total time spent
+ * waiting on a failing device across a whole install transaction, regardless of how many
+ * individual operations retry.
+ *
+ * The deadline does not interrupt an operation that is already running, only the waits
+ * between tries.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_device_retry_set_deadline(FuDevice *self, guint timeout_ms)
+{
+	FuDevicePrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FU_IS_DEVICE(self));
+	if (timeout_ms == 0) {
+		priv->retry_deadline = 0;
+		return;
+	}
+	priv->retry_deadline = g_get_monotonic_time() + ((gint64)timeout_ms * 1000);
+}
+
 /**
  * fu_device_retry_full:
  * @self: a #FuDevice
@@ -598,6 +729,7 @@ fu_device_retry_full(FuDevice *self,
 		     GError **error)
 {
 	FuDevicePrivate *priv = GET_PRIVATE(self);
+	guint delay_cur = delay;
 
 	g_return_val_if_fail(FU_IS_DEVICE(self), FALSE);
 	g_return_val_if_fail(func != NULL, FALSE);
@@ -609,7 +741,7 @@ fu_device_retry_full(FuDevice *self,
 
 		/* delay */
 		if (i > 0)
-			fu_device_sleep(self, delay);
+			fu_device_sleep(self, delay_cur);
 
 		/* run function, if success return success */
 		if (func(self, user_data, &error_local))
@@ -624,6 +756,18 @@ fu_device_retry_full(FuDevice *self,
 			return FALSE;
 		}
 
+		/* check the optional cumulative failure budget so that a dying device cannot
+		 * wait out the full per-chunk retry count thousands of times over */
+		priv->retry_failure_cnt++;
+		if (priv->retry_failure_budget > 0 &&
+		    priv->retry_failure_cnt >= priv->retry_failure_budget) {
+			g_propagate_prefixed_error(error,
+						   g_steal_pointer(&error_local),
+						   "aborting after %u cumulative failures: ",
+						   priv->retry_failure_cnt);
+			return FALSE;
+		}
+
 		/* too many retries */
 		if (i >= count - 1) {
 			g_propagate_prefixed_error(error,
@@ -633,6 +777,25 @@ fu_device_retry_full(FuDevice *self,
 			return FALSE;
 		}
 
+		/* how long to wait before the next try */
+		if (priv->retry_policy == FU_DEVICE_RETRY_POLICY_IMMEDIATE) {
+			delay_cur = 0;
+		} else if (priv->retry_policy == FU_DEVICE_RETRY_POLICY_EXPONENTIAL && delay > 0) {
+			guint delay_max = delay * (1u << MIN(i, 6));
+			delay_cur = (guint)g_random_int_range(MAX(((gint)delay_max * 3) / 4, 1),
+							      (gint)delay_max + 1);
+		}
+
+		/* never sleep past the shared deadline; a persistent failure has to abort in
+		 * bounded time even when many operations retry in turn */
+		if (priv->retry_deadline != 0 && delay_cur > 0 &&
+		    g_get_monotonic_time() + ((gint64)delay_cur * 1000) > priv->retry_deadline) {
+			g_propagate_prefixed_error(error,
+						   g_steal_pointer(&error_local),
+						   "retry deadline reached: ");
+			return FALSE;
+		}
+
 		/* show recoverable error on the console */
 		if (priv->retry_recs == NULL || priv->retry_recs->len == 0) {
 			g_info("failed on try %u of %u: %s", i + 1, count, error_local->message);
@@ -1090,6 +1253,28 @@ fu_device_poll(FuDevice *self, GError **error)
 	return TRUE;
 }
 
+/* when consecutive polls see no property notifications the interval is doubled up to this
+ * multiplier, so dozens of idle polled devices do not keep waking up the daemon */
+#define FU_DEVICE_POLL_BACKOFF_MAX	   16
+#define FU_DEVICE_POLL_UNCHANGED_THRESHOLD 10
+
+static gboolean
+fu_device_poll_cb(gpointer user_data);
+
+static void
+fu_device_poll_rearm(FuDevice *self)
+{
+	FuDevicePrivate *priv = GET_PRIVATE(self);
+	guint interval = priv->poll_interval * priv->poll_backoff;
+
+	if (interval % 1000 == 0) {
+		/* align to the second boundary so that idle devices wake together */
+		priv->poll_id = g_timeout_add_seconds(interval / 1000, fu_device_poll_cb, self);
+	} else {
+		priv->poll_id = g_timeout_add(interval, fu_device_poll_cb, self);
+	}
+}
+
 static gboolean
 fu_device_poll_cb(gpointer user_data)
 {
@@ -1101,15 +1286,36 @@ fu_device_poll_cb(gpointer user_data)
 	if (fu_device_has_private_flag(self, FU_DEVICE_PRIVATE_FLAG_AUTO_PAUSE_POLLING) &&
 	    priv->poll_locker_cnt > 0) {
 		g_debug("ignoring poll callback as an action is in progress");
-		return G_SOURCE_CONTINUE;
+		fu_device_poll_rearm(self);
+		return G_SOURCE_REMOVE;
 	}
 
+	priv->poll_changed_seen = FALSE;
 	if (!fu_device_poll(self, &error_local)) {
 		g_warning("disabling polling: %s", error_local->message);
 		priv->poll_id = 0;
 		return G_SOURCE_REMOVE;
 	}
-	return G_SOURCE_CONTINUE;
+
+	/* back off while nothing is changing, and return to the base interval as soon as
+	 * the hardware reports something new */
+	if (priv->poll_changed_seen) {
+		priv->poll_backoff = 1;
+		priv->poll_unchanged_cnt = 0;
+	} else if (++priv->poll_unchanged_cnt >= FU_DEVICE_POLL_UNCHANGED_THRESHOLD &&
+		   priv->poll_backoff < FU_DEVICE_POLL_BACKOFF_MAX) {
+		priv->poll_backoff *= 2;
+		priv->poll_unchanged_cnt = 0;
+	}
+	fu_device_poll_rearm(self);
+	return G_SOURCE_REMOVE;
+}
+
+static void
+fu_device_poll_notify_cb(FuDevice *self, GParamSpec *pspec, gpointer user_data)
+{
+	FuDevicePrivate *priv = GET_PRIVATE(self);
+	priv->poll_changed_seen = TRUE;
 }
 
 /**
@@ -1134,13 +1340,53 @@ fu_device_set_poll_interval(FuDevice *self, guint interval)
 		g_source_remove(priv->poll_id);
 		priv->poll_id = 0;
 	}
-	if (interval == 0)
+	priv->poll_interval = interval;
+	priv->poll_backoff = 1;
+	priv->poll_unchanged_cnt = 0;
+	if (interval == 0) {
+		if (priv->notify_poll_handler_id != 0) {
+			g_signal_handler_disconnect(self, priv->notify_poll_handler_id);
+			priv->notify_poll_handler_id = 0;
+		}
 		return;
-	if (interval % 1000 == 0) {
-		priv->poll_id = g_timeout_add_seconds(interval / 1000, fu_device_poll_cb, self);
-	} else {
-		priv->poll_id = g_timeout_add(interval, fu_device_poll_cb, self);
 	}
+
+	/* watch for property notifications so backed-off devices speed up again on change */
+	if (priv->notify_poll_handler_id == 0) {
+		priv->notify_poll_handler_id =
+		    g_signal_connect(FWUPD_DEVICE(self),
+				     "notify",
+				     G_CALLBACK(fu_device_poll_notify_cb),
+				     NULL);
+	}
+	fu_device_poll_rearm(self);
+}
+
+/**
+ * fu_device_poll_reset:
+ * @self: a #FuDevice
+ *
+ * Resets any poll interval backoff and schedules the next poll at the base interval, for
+ * example when a uevent suggests the hardware state has changed.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_device_poll_reset(FuDevice *self)
+{
+	FuDevicePrivate *priv = GET_PRIVATE(self);
+
+	g_return_if_fail(FU_IS_DEVICE(self));
+
+	/* polling not enabled, or already at the base interval */
+	if (priv->poll_id == 0 || priv->poll_interval == 0)
+		return;
+	priv->poll_unchanged_cnt = 0;
+	if (priv->poll_backoff == 1)
+		return;
+	priv->poll_backoff = 1;
+	g_source_remove(priv->poll_id);
+	fu_device_poll_rearm(self);
 }
 
 /**
@@ -1983,6 +2229,104 @@ fu_device_set_quirk_inhibit_section(FuDevice *self, const gchar *value, GError *
 	return TRUE;
 }
 
+/* in the same alphabetical order as fu_device_quirk_keys so that the bsearch result
+ * index is also the enum value */
+typedef enum {
+	FU_DEVICE_QUIRK_KEY_ACQUIESCE_DELAY,
+	FU_DEVICE_QUIRK_KEY_BATTERY_THRESHOLD,
+	FU_DEVICE_QUIRK_KEY_BRANCH,
+	FU_DEVICE_QUIRK_KEY_CHILDREN,
+	FU_DEVICE_QUIRK_KEY_COUNTERPART_GUID,
+	FU_DEVICE_QUIRK_KEY_FIRMWARE_GTYPE,
+	FU_DEVICE_QUIRK_KEY_FIRMWARE_SIZE,
+	FU_DEVICE_QUIRK_KEY_FIRMWARE_SIZE_MAX,
+	FU_DEVICE_QUIRK_KEY_FIRMWARE_SIZE_MIN,
+	FU_DEVICE_QUIRK_KEY_FLAGS,
+	FU_DEVICE_QUIRK_KEY_GTYPE,
+	FU_DEVICE_QUIRK_KEY_GUID,
+	FU_DEVICE_QUIRK_KEY_GUID_QUIRK,
+	FU_DEVICE_QUIRK_KEY_ICON,
+	FU_DEVICE_QUIRK_KEY_INHIBIT,
+	FU_DEVICE_QUIRK_KEY_INSTALL_DURATION,
+	FU_DEVICE_QUIRK_KEY_ISSUE,
+	FU_DEVICE_QUIRK_KEY_NAME,
+	FU_DEVICE_QUIRK_KEY_PARENT_GUID,
+	FU_DEVICE_QUIRK_KEY_PLUGIN,
+	FU_DEVICE_QUIRK_KEY_PRIORITY,
+	FU_DEVICE_QUIRK_KEY_PROTOCOL,
+	FU_DEVICE_QUIRK_KEY_PROXY_GTYPE,
+	FU_DEVICE_QUIRK_KEY_PROXY_GUID,
+	FU_DEVICE_QUIRK_KEY_REMOVE_DELAY,
+	FU_DEVICE_QUIRK_KEY_SUMMARY,
+	FU_DEVICE_QUIRK_KEY_UPDATE_IMAGE,
+	FU_DEVICE_QUIRK_KEY_UPDATE_MESSAGE,
+	FU_DEVICE_QUIRK_KEY_VENDOR,
+	FU_DEVICE_QUIRK_KEY_VENDOR_ID,
+	FU_DEVICE_QUIRK_KEY_VERIFY_KIND,
+	FU_DEVICE_QUIRK_KEY_VERSION,
+	FU_DEVICE_QUIRK_KEY_VERSION_FORMAT,
+	FU_DEVICE_QUIRK_KEY_LAST,
+} FuDeviceQuirkKey;
+
+/* sorted by strcmp() */
+static const gchar *fu_device_quirk_keys[] = {
+    FU_QUIRKS_ACQUIESCE_DELAY,
+    FU_QUIRKS_BATTERY_THRESHOLD,
+    FU_QUIRKS_BRANCH,
+    FU_QUIRKS_CHILDREN,
+    FU_QUIRKS_COUNTERPART_GUID,
+    FU_QUIRKS_FIRMWARE_GTYPE,
+    FU_QUIRKS_FIRMWARE_SIZE,
+    FU_QUIRKS_FIRMWARE_SIZE_MAX,
+    FU_QUIRKS_FIRMWARE_SIZE_MIN,
+    FU_QUIRKS_FLAGS,
+    FU_QUIRKS_GTYPE,
+    FU_QUIRKS_GUID,
+    FU_QUIRKS_GUID_QUIRK,
+    FU_QUIRKS_ICON,
+    FU_QUIRKS_INHIBIT,
+    FU_QUIRKS_INSTALL_DURATION,
+    FU_QUIRKS_ISSUE,
+    FU_QUIRKS_NAME,
+    FU_QUIRKS_PARENT_GUID,
+    FU_QUIRKS_PLUGIN,
+    FU_QUIRKS_PRIORITY,
+    FU_QUIRKS_PROTOCOL,
+    FU_QUIRKS_PROXY_GTYPE,
+    FU_QUIRKS_PROXY_GUID,
+    FU_QUIRKS_REMOVE_DELAY,
+    FU_QUIRKS_SUMMARY,
+    FU_QUIRKS_UPDATE_IMAGE,
+    FU_QUIRKS_UPDATE_MESSAGE,
+    FU_QUIRKS_VENDOR,
+    FU_QUIRKS_VENDOR_ID,
+    FU_QUIRKS_VERIFY_KIND,
+    FU_QUIRKS_VERSION,
+    FU_QUIRKS_VERSION_FORMAT,
+};
+G_STATIC_ASSERT(G_N_ELEMENTS(fu_device_quirk_keys) == FU_DEVICE_QUIRK_KEY_LAST);
+
+static gint
+fu_device_quirk_key_cmp_cb(const void *a, const void *b)
+{
+	return strcmp((const gchar *)a, *(const gchar *const *)b);
+}
+
+/* applying quirks to a composite device does thousands of key matches, so a binary search
+ * over the sorted key list and an integer switch beats a linear strcmp() chain */
+static FuDeviceQuirkKey
+fu_device_quirk_key_from_string(const gchar *key)
+{
+	const gchar *const *item = bsearch(key,
+					   fu_device_quirk_keys,
+					   G_N_ELEMENTS(fu_device_quirk_keys),
+					   sizeof(const gchar *),
+					   fu_device_quirk_key_cmp_cb);
+	if (item == NULL)
+		return FU_DEVICE_QUIRK_KEY_LAST;
+	return (FuDeviceQuirkKey)(item - fu_device_quirk_keys);
+}
+
 /**
  * fu_device_set_quirk_kv:
  * @self: a #FuDevice
@@ -2013,67 +2357,60 @@ fu_device_set_quirk_kv(FuDevice *self,
 	g_return_val_if_fail(value != NULL, FALSE);
 	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
-	if (g_strcmp0(key, FU_QUIRKS_PLUGIN) == 0) {
+	switch (fu_device_quirk_key_from_string(key)) {
+	case FU_DEVICE_QUIRK_KEY_PLUGIN: {
 		g_auto(GStrv) sections = g_strsplit(value, ",", -1);
 		for (guint i = 0; sections[i] != NULL; i++)
 			fu_device_add_possible_plugin(self, sections[i]);
 		return TRUE;
 	}
-	if (g_strcmp0(key, FU_QUIRKS_FLAGS) == 0) {
+	case FU_DEVICE_QUIRK_KEY_FLAGS:
 		fu_device_set_custom_flags(self, value);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_NAME) == 0) {
+	case FU_DEVICE_QUIRK_KEY_NAME:
 		if (fu_device_get_name(self) != NULL && source >= FU_CONTEXT_QUIRK_SOURCE_DB)
 			return TRUE;
 		fu_device_set_name(self, value);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_SUMMARY) == 0) {
+	case FU_DEVICE_QUIRK_KEY_SUMMARY:
 		fu_device_set_summary(self, value);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_BRANCH) == 0) {
+	case FU_DEVICE_QUIRK_KEY_BRANCH:
 		fu_device_set_branch(self, value);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_VENDOR) == 0) {
+	case FU_DEVICE_QUIRK_KEY_VENDOR:
 		if (fu_device_get_vendor(self) != NULL && source >= FU_CONTEXT_QUIRK_SOURCE_DB)
 			return TRUE;
 		fu_device_set_vendor(self, value);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_VENDOR_ID) == 0) {
+	case FU_DEVICE_QUIRK_KEY_VENDOR_ID: {
 		g_auto(GStrv) sections = g_strsplit(value, ",", -1);
 		for (guint i = 0; sections[i] != NULL; i++)
 			fu_device_add_vendor_id(self, sections[i]);
 		return TRUE;
 	}
-	if (g_strcmp0(key, FU_QUIRKS_PROTOCOL) == 0) {
+	case FU_DEVICE_QUIRK_KEY_PROTOCOL: {
 		g_auto(GStrv) sections = g_strsplit(value, ",", -1);
 		for (guint i = 0; sections[i] != NULL; i++)
 			fu_device_add_protocol(self, sections[i]);
 		return TRUE;
 	}
-	if (g_strcmp0(key, FU_QUIRKS_ISSUE) == 0) {
+	case FU_DEVICE_QUIRK_KEY_ISSUE: {
 		g_auto(GStrv) sections = g_strsplit(value, ",", -1);
 		for (guint i = 0; sections[i] != NULL; i++)
 			fu_device_add_issue(self, sections[i]);
 		return TRUE;
 	}
-	if (g_strcmp0(key, FU_QUIRKS_VERSION) == 0) {
+	case FU_DEVICE_QUIRK_KEY_VERSION:
 		fu_device_set_version(self, value);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_UPDATE_MESSAGE) == 0) {
+	case FU_DEVICE_QUIRK_KEY_UPDATE_MESSAGE:
 		fu_device_set_update_message(self, value);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_UPDATE_IMAGE) == 0) {
+	case FU_DEVICE_QUIRK_KEY_UPDATE_IMAGE:
 		fu_device_set_update_image(self, value);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_ICON) == 0) {
+	case FU_DEVICE_QUIRK_KEY_ICON: {
 		g_auto(GStrv) sections = g_strsplit(value, ",", -1);
 		if (fu_device_get_icons(self)->len > 0 &&
 		    source >= FU_CONTEXT_QUIRK_SOURCE_FALLBACK)
@@ -2082,87 +2419,90 @@ fu_device_set_quirk_kv(FuDevice *self,
 			fu_device_add_icon(self, sections[i]);
 		return TRUE;
 	}
-	if (g_strcmp0(key, FU_QUIRKS_GUID) == 0) {
+	case FU_DEVICE_QUIRK_KEY_GUID: {
 		g_auto(GStrv) sections = g_strsplit(value, ",", -1);
 		for (guint i = 0; sections[i] != NULL; i++)
 			fu_device_add_guid(self, sections[i]);
 		return TRUE;
 	}
-	if (g_strcmp0(key, FU_QUIRKS_GUID_QUIRK) == 0) {
+	case FU_DEVICE_QUIRK_KEY_GUID_QUIRK: {
 		g_auto(GStrv) sections = g_strsplit(value, ",", -1);
 		for (guint i = 0; sections[i] != NULL; i++)
 			fu_device_add_guid_full(self, sections[i], FU_DEVICE_INSTANCE_FLAG_QUIRKS);
 		return TRUE;
 	}
-	if (g_strcmp0(key, FU_QUIRKS_COUNTERPART_GUID) == 0) {
+	case FU_DEVICE_QUIRK_KEY_COUNTERPART_GUID: {
 		g_auto(GStrv) sections = g_strsplit(value, ",", -1);
 		for (guint i = 0; sections[i] != NULL; i++)
 			fu_device_add_counterpart_guid(self, sections[i]);
 		return TRUE;
 	}
-	if (g_strcmp0(key, FU_QUIRKS_PARENT_GUID) == 0) {
+	case FU_DEVICE_QUIRK_KEY_PARENT_GUID: {
 		g_auto(GStrv) sections = g_strsplit(value, ",", -1);
 		for (guint i = 0; sections[i] != NULL; i++)
 			fu_device_add_parent_guid(self, sections[i]);
 		return TRUE;
 	}
-	if (g_strcmp0(key, FU_QUIRKS_PROXY_GUID) == 0) {
+	case FU_DEVICE_QUIRK_KEY_PROXY_GUID:
 		fu_device_set_proxy_guid(self, value);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_FIRMWARE_SIZE_MIN) == 0) {
+	case FU_DEVICE_QUIRK_KEY_FIRMWARE_SIZE_MIN:
 		if (!fu_strtoull(value, &tmp, 0, G_MAXUINT64, FU_INTEGER_BASE_AUTO, error))
 			return FALSE;
 		fu_device_set_firmware_size_min(self, tmp);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_FIRMWARE_SIZE_MAX) == 0) {
+	case FU_DEVICE_QUIRK_KEY_FIRMWARE_SIZE_MAX:
 		if (!fu_strtoull(value, &tmp, 0, G_MAXUINT64, FU_INTEGER_BASE_AUTO, error))
 			return FALSE;
 		fu_device_set_firmware_size_max(self, tmp);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_FIRMWARE_SIZE) == 0) {
+	case FU_DEVICE_QUIRK_KEY_FIRMWARE_SIZE:
 		if (!fu_strtoull(value, &tmp, 0, G_MAXUINT64, FU_INTEGER_BASE_AUTO, error))
 			return FALSE;
 		fu_device_set_firmware_size(self, tmp);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_INSTALL_DURATION) == 0) {
+	case FU_DEVICE_QUIRK_KEY_INSTALL_DURATION:
 		if (!fu_strtoull(value, &tmp, 0, 60 * 60 * 24, FU_INTEGER_BASE_AUTO, error))
 			return FALSE;
 		fu_device_set_install_duration(self, tmp);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_PRIORITY) == 0) {
+	case FU_DEVICE_QUIRK_KEY_PRIORITY:
 		if (!fu_strtoull(value, &tmp, 0, G_MAXUINT8, FU_INTEGER_BASE_AUTO, error))
 			return FALSE;
 		fu_device_set_priority(self, tmp);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_BATTERY_THRESHOLD) == 0) {
+	case FU_DEVICE_QUIRK_KEY_BATTERY_THRESHOLD:
 		if (!fu_strtoull(value, &tmp, 0, 100, FU_INTEGER_BASE_AUTO, error))
 			return FALSE;
 		fu_device_set_battery_threshold(self, tmp);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_REMOVE_DELAY) == 0) {
+	case FU_DEVICE_QUIRK_KEY_REMOVE_DELAY:
 		if (!fu_strtoull(value, &tmp, 0, G_MAXUINT, FU_INTEGER_BASE_AUTO, error))
 			return FALSE;
 		fu_device_set_remove_delay(self, tmp);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_ACQUIESCE_DELAY) == 0) {
+	case FU_DEVICE_QUIRK_KEY_ACQUIESCE_DELAY:
 		if (!fu_strtoull(value, &tmp, 0, G_MAXUINT, FU_INTEGER_BASE_AUTO, error))
 			return FALSE;
 		fu_device_set_acquiesce_delay(self, tmp);
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_VERSION_FORMAT) == 0) {
+	case FU_DEVICE_QUIRK_KEY_VERSION_FORMAT:
 		fu_device_set_version_format(self, fwupd_version_format_from_string(value));
 		return TRUE;
+	case FU_DEVICE_QUIRK_KEY_VERIFY_KIND: {
+		FuDeviceVerifyKind verify_kind = fu_device_verify_kind_from_string(value);
+		if (verify_kind == FU_DEVICE_VERIFY_KIND_UNKNOWN) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_NOT_SUPPORTED,
+				    "verify kind %s not supported",
+				    value);
+			return FALSE;
+		}
+		fu_device_set_verify_kind(self, verify_kind);
+		return TRUE;
 	}
-	if (g_strcmp0(key, FU_QUIRKS_INHIBIT) == 0) {
+	case FU_DEVICE_QUIRK_KEY_INHIBIT: {
 		g_auto(GStrv) sections = g_strsplit(value, ",", -1);
 		for (guint i = 0; sections[i] != NULL; i++) {
 			if (!fu_device_set_quirk_inhibit_section(self, sections[i], error))
@@ -2170,7 +2510,7 @@ fu_device_set_quirk_kv(FuDevice *self,
 		}
 		return TRUE;
 	}
-	if (g_strcmp0(key, FU_QUIRKS_GTYPE) == 0) {
+	case FU_DEVICE_QUIRK_KEY_GTYPE:
 		if (priv->specialized_gtype != G_TYPE_INVALID) {
 			g_debug("already set GType to %s, ignoring %s",
 				g_type_name(priv->specialized_gtype),
@@ -2187,8 +2527,7 @@ fu_device_set_quirk_kv(FuDevice *self,
 			return FALSE;
 		}
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_PROXY_GTYPE) == 0) {
+	case FU_DEVICE_QUIRK_KEY_PROXY_GTYPE:
 		if (priv->proxy_gtype != G_TYPE_INVALID) {
 			g_debug("already set proxy GType to %s, ignoring %s",
 				g_type_name(priv->proxy_gtype),
@@ -2205,8 +2544,7 @@ fu_device_set_quirk_kv(FuDevice *self,
 			return FALSE;
 		}
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_FIRMWARE_GTYPE) == 0) {
+	case FU_DEVICE_QUIRK_KEY_FIRMWARE_GTYPE:
 		if (priv->firmware_gtype != G_TYPE_INVALID) {
 			g_debug("already set firmware GType to %s, ignoring %s",
 				g_type_name(priv->firmware_gtype),
@@ -2223,8 +2561,7 @@ fu_device_set_quirk_kv(FuDevice *self,
 			return FALSE;
 		}
 		return TRUE;
-	}
-	if (g_strcmp0(key, FU_QUIRKS_CHILDREN) == 0) {
+	case FU_DEVICE_QUIRK_KEY_CHILDREN: {
 		g_auto(GStrv) sections = g_strsplit(value, ",", -1);
 		for (guint i = 0; sections[i] != NULL; i++) {
 			if (!fu_device_add_child_by_kv(self, sections[i], error))
@@ -2232,6 +2569,9 @@ fu_device_set_quirk_kv(FuDevice *self,
 		}
 		return TRUE;
 	}
+	default:
+		break;
+	}
 
 	/* optional device-specific method */
 	if (device_class->set_quirk_kv != NULL)
@@ -2365,9 +2705,11 @@ fu_device_quirks_iter_cb(FuContext *ctx,
 }
 
 static void
-fu_device_add_guid_quirks(FuDevice *self, const gchar *guid)
+fu_device_add_guids_quirks(FuDevice *self, GPtrArray *guids)
 {
 	FuDevicePrivate *priv = GET_PRIVATE(self);
+	g_autoptr(GPtrArray) guids_new = g_ptr_array_new();
+
 	if (priv->ctx == NULL) {
 		g_autofree gchar *str = fu_device_to_string(self);
 		g_critical("no FuContext assigned for %s", str);
@@ -2375,16 +2717,32 @@ fu_device_add_guid_quirks(FuDevice *self, const gchar *guid)
 	}
 
 	/* do not run the query multiple times on the same device */
-	if (priv->guid_quirks == NULL) {
+	if (priv->guid_quirks == NULL)
 		priv->guid_quirks = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
-	} else {
+	for (guint i = 0; i < guids->len; i++) {
+		const gchar *guid = g_ptr_array_index(guids, i);
 		if (g_hash_table_contains(priv->guid_quirks, guid))
-			return;
+			continue;
+		g_hash_table_add(priv->guid_quirks, g_strdup(guid));
+		g_ptr_array_add(guids_new, (gpointer)guid);
 	}
-	g_hash_table_add(priv->guid_quirks, g_strdup(guid));
+	if (guids_new->len == 0)
+		return;
 
-	/* run the query */
-	fu_context_lookup_quirk_by_id_iter(priv->ctx, guid, NULL, fu_device_quirks_iter_cb, self);
+	/* run one query for all the GUIDs */
+	fu_context_lookup_quirk_by_ids_iter(priv->ctx,
+					    guids_new,
+					    NULL,
+					    fu_device_quirks_iter_cb,
+					    self);
+}
+
+static void
+fu_device_add_guid_quirks(FuDevice *self, const gchar *guid)
+{
+	g_autoptr(GPtrArray) guids = g_ptr_array_new();
+	g_ptr_array_add(guids, (gpointer)guid);
+	fu_device_add_guids_quirks(self, guids);
 }
 
 /**
@@ -2537,8 +2895,9 @@ fu_device_add_instance_id_quirk(FuDevice *self, const gchar *instance_id)
 	if (fu_device_has_instance_id_quirk(self, instance_id))
 		return;
 	if (priv->instance_id_quirks == NULL)
-		priv->instance_id_quirks = g_ptr_array_new_with_free_func(g_free);
-	g_ptr_array_add(priv->instance_id_quirks, g_strdup(instance_id));
+		priv->instance_id_quirks =
+		    g_ptr_array_new_with_free_func((GDestroyNotify)g_ref_string_release);
+	g_ptr_array_add(priv->instance_id_quirks, g_ref_string_new_intern(instance_id));
 }
 
 /**
@@ -3361,6 +3720,48 @@ fu_device_ensure_inhibits(FuDevice *self)
 		g_signal_handler_unblock(self, priv->notify_flags_handler_id);
 }
 
+static void
+fu_device_ensure_inhibits_added(FuDevice *self, FuDeviceInhibit *inhibit)
+{
+	FuDevicePrivate *priv = GET_PRIVATE(self);
+
+	/* disable */
+	if (priv->notify_flags_handler_id != 0)
+		g_signal_handler_block(self, priv->notify_flags_handler_id);
+
+	/* updatable -> updatable-hidden -- which is required as devices might have
+	 * inhibits and *not* be automatically updatable */
+	if (fu_device_has_flag(self, FWUPD_DEVICE_FLAG_UPDATABLE)) {
+		fu_device_remove_flag(self, FWUPD_DEVICE_FLAG_UPDATABLE);
+		fu_device_add_flag(self, FWUPD_DEVICE_FLAG_UPDATABLE_HIDDEN);
+	}
+
+	/* append the new reason rather than re-joining every inhibit */
+	if (g_hash_table_size(priv->inhibits) == 1) {
+		fu_device_set_update_error(self, inhibit->reason);
+	} else if (inhibit->reason != NULL) {
+		const gchar *update_error = fu_device_get_update_error(self);
+		if (update_error == NULL || update_error[0] == '\0') {
+			fu_device_set_update_error(self, inhibit->reason);
+		} else {
+			g_autofree gchar *update_error_new =
+			    g_strdup_printf("%s, %s", update_error, inhibit->reason);
+			fu_device_set_update_error(self, update_error_new);
+		}
+	}
+
+	/* sync with baseclass */
+	if (inhibit->problem != FWUPD_DEVICE_PROBLEM_NONE) {
+		fwupd_device_set_problems(FWUPD_DEVICE(self),
+					  fwupd_device_get_problems(FWUPD_DEVICE(self)) |
+					      inhibit->problem);
+	}
+
+	/* enable */
+	if (priv->notify_flags_handler_id != 0)
+		g_signal_handler_unblock(self, priv->notify_flags_handler_id);
+}
+
 static gchar *
 fu_device_problem_to_inhibit_reason(FuDevice *self, guint64 device_problem)
 {
@@ -3448,8 +3849,8 @@ fu_device_inhibit_full(FuDevice *self,
 	}
 	g_hash_table_insert(priv->inhibits, inhibit->inhibit_id, inhibit);
 
-	/* refresh */
-	fu_device_ensure_inhibits(self);
+	/* refresh incrementally, as only one inhibit was added */
+	fu_device_ensure_inhibits_added(self, inhibit);
 
 	/* propagate to children */
 	if (fu_device_has_private_flag(self, FU_DEVICE_PRIVATE_FLAG_INHIBIT_CHILDREN)) {
@@ -3525,6 +3926,10 @@ fu_device_remove_problem(FuDevice *self, FwupdDeviceProblem problem)
 {
 	g_return_if_fail(FU_IS_DEVICE(self));
 	g_return_if_fail(problem != FWUPD_DEVICE_PROBLEM_UNKNOWN);
+
+	/* fast path for battery and power flapping, which hits every device */
+	if (!fu_device_has_problem(self, problem))
+		return;
 	return fu_device_uninhibit(self, fwupd_device_problem_to_string(problem));
 }
 
@@ -3544,7 +3949,9 @@ fu_device_has_problem(FuDevice *self, FwupdDeviceProblem problem)
 {
 	g_return_val_if_fail(FU_IS_DEVICE(self), FALSE);
 	g_return_val_if_fail(problem != FWUPD_DEVICE_PROBLEM_UNKNOWN, FALSE);
-	return fu_device_has_inhibit(self, fwupd_device_problem_to_string(problem));
+
+	/* the bitmask is kept in sync with the inhibits, so no string lookup required */
+	return (fwupd_device_get_problems(FWUPD_DEVICE(self)) & problem) > 0;
 }
 
 /**
@@ -3565,6 +3972,10 @@ fu_device_add_problem(FuDevice *self, FwupdDeviceProblem problem)
 {
 	g_return_if_fail(FU_IS_DEVICE(self));
 	g_return_if_fail(problem != FWUPD_DEVICE_PROBLEM_UNKNOWN);
+
+	/* fast path for battery and power flapping, which hits every device */
+	if (fu_device_has_problem(self, problem))
+		return;
 	fu_device_inhibit_full(self, problem, NULL, NULL);
 }
 
@@ -4461,6 +4872,49 @@ fu_device_set_acquiesce_delay(FuDevice *self, guint acquiesce_delay)
 	priv->acquiesce_delay = acquiesce_delay;
 }
 
+/**
+ * fu_device_get_verify_kind:
+ * @self: a #FuDevice
+ *
+ * Returns how the device firmware should be verified after writing.
+ *
+ * If the value has not been explicitly set then %FU_DEVICE_VERIFY_KIND_UNKNOWN is
+ * returned and the plugin should assume %FU_DEVICE_VERIFY_KIND_FULL.
+ *
+ * Returns: the verify kind, e.g. %FU_DEVICE_VERIFY_KIND_SAMPLED
+ *
+ * Since: 2.0.3
+ **/
+FuDeviceVerifyKind
+fu_device_get_verify_kind(FuDevice *self)
+{
+	FuDevicePrivate *priv = GET_PRIVATE(self);
+	g_return_val_if_fail(FU_IS_DEVICE(self), FU_DEVICE_VERIFY_KIND_UNKNOWN);
+	return priv->verify_kind;
+}
+
+/**
+ * fu_device_set_verify_kind:
+ * @self: a #FuDevice
+ * @verify_kind: the verify kind, e.g. %FU_DEVICE_VERIFY_KIND_SAMPLED
+ *
+ * Sets how the device firmware should be verified after writing.
+ *
+ * A full read back is always the safe choice, but transports that support
+ * on-device checksum commands can use %FU_DEVICE_VERIFY_KIND_ATTESTED or
+ * %FU_DEVICE_VERIFY_KIND_SAMPLED to avoid re-reading the entire flash over a
+ * slow link. This can be also be set using `VerifyKind=` in a quirk file.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_device_set_verify_kind(FuDevice *self, FuDeviceVerifyKind verify_kind)
+{
+	FuDevicePrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FU_IS_DEVICE(self));
+	priv->verify_kind = verify_kind;
+}
+
 /**
  * fu_device_set_update_state:
  * @self: a #FuDevice
@@ -4792,6 +5246,12 @@ fu_device_to_string_impl(FuDevice *self, guint idt, GString *str)
 	fwupd_codec_string_append(str, idt, "ProxyGuid", priv->proxy_guid);
 	fwupd_codec_string_append_int(str, idt, "RemoveDelay", priv->remove_delay);
 	fwupd_codec_string_append_int(str, idt, "AcquiesceDelay", priv->acquiesce_delay);
+	if (priv->verify_kind != FU_DEVICE_VERIFY_KIND_UNKNOWN) {
+		fwupd_codec_string_append(str,
+					  idt,
+					  "VerifyKind",
+					  fu_device_verify_kind_to_string(priv->verify_kind));
+	}
 	fwupd_codec_string_append(str, idt, "CustomFlags", priv->custom_flags);
 	if (priv->specialized_gtype != G_TYPE_INVALID)
 		fwupd_codec_string_append(str, idt, "GType", g_type_name(priv->specialized_gtype));
@@ -5024,6 +5484,11 @@ fu_device_get_results(FuDevice *self, GError **error)
  *
  * Writes firmware to the device by calling a plugin-specific vfunc.
  *
+ * The stream is seekable and is typically a #FuPartialInputStream pointing into the
+ * archive contents, so nothing has been copied into memory. Plugins should keep it
+ * that way by chunking with fu_chunk_array_new_from_stream() rather than converting
+ * the firmware to a #GBytes; the daemon reports the peak memory used by each install.
+ *
  * Returns: %TRUE on success
  *
  * Since: 1.0.8
@@ -5068,6 +5533,9 @@ fu_device_write_firmware(FuDevice *self,
 	g_info("installing onto %s:\n%s", fu_device_get_id(self), str);
 	fu_progress_step_done(progress);
 
+	/* each install gets a fresh retry failure budget */
+	priv->retry_failure_cnt = 0;
+
 	/* call vfunc */
 	g_set_object(&priv->progress, fu_progress_get_child(progress));
 	if (!device_class->write_firmware(self, firmware, priv->progress, flags, error))
@@ -5266,6 +5734,48 @@ fu_device_dump_firmware(FuDevice *self, FuProgress *progress, GError **error)
 	return device_class->dump_firmware(self, progress, error);
 }
 
+/**
+ * fu_device_compute_checksum:
+ * @self: a #FuDevice
+ * @checksum_type: a #GChecksumType, e.g. %G_CHECKSUM_SHA256
+ * @progress: a #FuProgress
+ * @error: (nullable): optional return location for an error
+ *
+ * Asks the device to compute the firmware checksum itself by calling a plugin-specific
+ * vfunc, typically implemented using a vendor command. This avoids reading the entire
+ * image back over a slow transport just to hash it on the host.
+ *
+ * Returns: (transfer full): a checksum string, or %NULL for error
+ *
+ * Since: 2.0.3
+ **/
+gchar *
+fu_device_compute_checksum(FuDevice *self,
+			   GChecksumType checksum_type,
+			   FuProgress *progress,
+			   GError **error)
+{
+	FuDeviceClass *device_class = FU_DEVICE_GET_CLASS(self);
+	FuDevicePrivate *priv = GET_PRIVATE(self);
+
+	g_return_val_if_fail(FU_IS_DEVICE(self), NULL);
+	g_return_val_if_fail(FU_IS_PROGRESS(progress), NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+	/* not implemented */
+	if (device_class->compute_checksum == NULL) {
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_NOT_SUPPORTED,
+				    "computing a checksum is not supported by device");
+		return NULL;
+	}
+
+	/* proxy */
+	g_set_object(&priv->progress, progress);
+	return device_class->compute_checksum(self, checksum_type, progress, error);
+}
+
 /**
  * fu_device_detach:
  * @self: a #FuDevice
@@ -6423,11 +6933,15 @@ fu_device_incorporate(FuDevice *self, FuDevice *donor, FuDeviceIncorporateFlags
 			}
 		}
 
-		/* call the set_quirk_kv() vfunc for the superclassed object */
-		for (guint i = 0; i < instance_ids->len; i++) {
-			const gchar *instance_id = g_ptr_array_index(instance_ids, i);
-			g_autofree gchar *guid = fwupd_guid_hash_string(instance_id);
-			fu_device_add_guid_quirks(self, guid);
+		/* call the set_quirk_kv() vfunc for the superclassed object, batching
+		 * the lookups so the quirk database is only walked once */
+		if (instance_ids->len > 0) {
+			g_autoptr(GPtrArray) guids = g_ptr_array_new_with_free_func(g_free);
+			for (guint i = 0; i < instance_ids->len; i++) {
+				const gchar *instance_id = g_ptr_array_index(instance_ids, i);
+				g_ptr_array_add(guids, fwupd_guid_hash_string(instance_id));
+			}
+			fu_device_add_guids_quirks(self, guids);
 		}
 	}
 }
@@ -7283,6 +7797,10 @@ fu_device_ensure_events(FuDevice *self)
 	if (priv->events != NULL)
 		return;
 	priv->events = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	priv->events_by_id = g_hash_table_new_full(g_str_hash,
+						   g_str_equal,
+						   g_free,
+						   (GDestroyNotify)g_ptr_array_unref);
 }
 
 /**
@@ -7310,6 +7828,19 @@ fu_device_add_event(FuDevice *self, FuDeviceEvent *event)
 
 	fu_device_ensure_events(self);
 	g_ptr_array_add(priv->events, g_object_ref(event));
+
+	/* index the position so that fu_device_load_event() does not have to do a linear scan */
+	if (fu_device_event_get_id(event) != NULL) {
+		GPtrArray *positions =
+		    g_hash_table_lookup(priv->events_by_id, fu_device_event_get_id(event));
+		if (positions == NULL) {
+			positions = g_ptr_array_new();
+			g_hash_table_insert(priv->events_by_id,
+					    g_strdup(fu_device_event_get_id(event)),
+					    positions);
+		}
+		g_ptr_array_add(positions, GUINT_TO_POINTER(priv->events->len - 1));
+	}
 }
 
 /**
@@ -7359,6 +7890,7 @@ FuDeviceEvent *
 fu_device_load_event(FuDevice *self, const gchar *id, GError **error)
 {
 	FuDevicePrivate *priv = GET_PRIVATE(self);
+	GPtrArray *positions;
 
 	g_return_val_if_fail(FU_IS_DEVICE(self), NULL);
 	g_return_val_if_fail(id != NULL, NULL);
@@ -7380,23 +7912,35 @@ fu_device_load_event(FuDevice *self, const gchar *id, GError **error)
 		priv->event_idx = 0;
 	}
 
-	/* look for the next event in the sequence */
-	for (guint i = priv->event_idx; i < priv->events->len; i++) {
-		FuDeviceEvent *event = g_ptr_array_index(priv->events, i);
+	/* the common case is an in-order replay, so check the very next event before doing
+	 * any hash lookup at all */
+	if (priv->event_idx < priv->events->len) {
+		FuDeviceEvent *event = g_ptr_array_index(priv->events, priv->event_idx);
 		if (g_strcmp0(fu_device_event_get_id(event), id) == 0) {
-			g_debug("found in-order %s at position %u", id, i);
-			priv->event_idx = i + 1;
+			priv->event_idx++;
 			return event;
 		}
 	}
 
-	/* look for *any* event that matches */
-	for (guint i = 0; i < priv->events->len; i++) {
-		FuDeviceEvent *event = g_ptr_array_index(priv->events, i);
-		if (g_strcmp0(fu_device_event_get_id(event), id) == 0) {
-			g_debug("found out-of-order %s at position %u", id, i);
-			priv->event_idx = i + 1;
-			return event;
+	/* all the positions with this ID, in the order the events were added */
+	positions = g_hash_table_lookup(priv->events_by_id, id);
+	if (positions != NULL) {
+		/* look for the next event in the sequence */
+		for (guint i = 0; i < positions->len; i++) {
+			guint pos = GPOINTER_TO_UINT(g_ptr_array_index(positions, i));
+			if (pos >= priv->event_idx) {
+				g_debug("found in-order %s at position %u", id, pos);
+				priv->event_idx = pos + 1;
+				return g_ptr_array_index(priv->events, pos);
+			}
+		}
+
+		/* use the *first* event that matches */
+		if (positions->len > 0) {
+			guint pos = GPOINTER_TO_UINT(g_ptr_array_index(positions, 0));
+			g_debug("found out-of-order %s at position %u", id, pos);
+			priv->event_idx = pos + 1;
+			return g_ptr_array_index(priv->events, pos);
 		}
 	}
 
@@ -7458,6 +8002,7 @@ fu_device_clear_events(FuDevice *self)
 	if (priv->events == NULL)
 		return;
 	g_ptr_array_set_size(priv->events, 0);
+	g_hash_table_remove_all(priv->events_by_id);
 	priv->event_idx = 0;
 }
 
@@ -7806,6 +8351,8 @@ fu_device_finalize(GObject *object)
 		g_ptr_array_unref(priv->counterpart_guids);
 	if (priv->events != NULL)
 		g_ptr_array_unref(priv->events);
+	if (priv->events_by_id != NULL)
+		g_hash_table_unref(priv->events_by_id);
 	if (priv->retry_recs != NULL)
 		g_ptr_array_unref(priv->retry_recs);
 	if (priv->instance_id_quirks != NULL)
@@ -7816,6 +8363,10 @@ fu_device_finalize(GObject *object)
 		g_ptr_array_unref(priv->private_flags);
 	if (priv->private_flags_registered != NULL)
 		g_ptr_array_unref(priv->private_flags_registered);
+	if (priv->private_flags_idx != NULL)
+		g_hash_table_unref(priv->private_flags_idx);
+	if (priv->private_flags_bitmask != NULL)
+		g_array_unref(priv->private_flags_bitmask);
 	g_ptr_array_unref(priv->possible_plugins);
 	g_free(priv->equivalent_id);
 	g_free(priv->physical_id);
@@ -90,6 +90,10 @@ struct _FuDeviceClass {
 	void (*invalidate)(FuDevice *self);
 	gchar *(*convert_version)(FuDevice *self, guint64 version_raw);
 	void (*register_flags)(FuDevice *self);
+	gchar *(*compute_checksum)(FuDevice *self,
+				   GChecksumType checksum_type,
+				   FuProgress *progress,
+				   GError **error)G_GNUC_WARN_UNUSED_RESULT;
 #endif
 };
 
@@ -289,6 +293,24 @@ typedef gboolean (*FuDeviceRetryFunc)(FuDevice *self,
 				      gpointer user_data,
 				      GError **error) G_GNUC_WARN_UNUSED_RESULT;
 
+/**
+ * FuDeviceRetryPolicy:
+ * @FU_DEVICE_RETRY_POLICY_FIXED: wait the same delay between every try
+ * @FU_DEVICE_RETRY_POLICY_IMMEDIATE: retry with no delay at all
+ * @FU_DEVICE_RETRY_POLICY_EXPONENTIAL: double the delay on each failure, with jitter
+ *
+ * The policy used by fu_device_retry_full() to space out tries.
+ *
+ * Since: 2.0.3
+ **/
+typedef enum {
+	FU_DEVICE_RETRY_POLICY_FIXED,
+	FU_DEVICE_RETRY_POLICY_IMMEDIATE,
+	FU_DEVICE_RETRY_POLICY_EXPONENTIAL,
+	/*< private >*/
+	FU_DEVICE_RETRY_POLICY_LAST,
+} FuDeviceRetryPolicy;
+
 FuDevice *
 fu_device_new(FuContext *ctx);
 
@@ -781,6 +803,16 @@ fu_device_new(FuContext *ctx);
  */
 #define FU_DEVICE_PRIVATE_FLAG_IS_FAKE "is-fake"
 
+/**
+ * FU_DEVICE_PRIVATE_FLAG_COMPOSITE_ACQUIESCE:
+ *
+ * The device settles at the same time as the other members of the composite device, and so the
+ * per-member acquiescence delay can be deferred until the last member has been updated.
+ *
+ * Since: 2.0.3
+ */
+#define FU_DEVICE_PRIVATE_FLAG_COMPOSITE_ACQUIESCE "composite-acquiesce"
+
 /* accessors */
 gchar *
 fu_device_to_string(FuDevice *self) G_GNUC_NON_NULL(1);
@@ -908,6 +940,10 @@ guint
 fu_device_get_acquiesce_delay(FuDevice *self) G_GNUC_NON_NULL(1);
 void
 fu_device_set_acquiesce_delay(FuDevice *self, guint acquiesce_delay) G_GNUC_NON_NULL(1);
+FuDeviceVerifyKind
+fu_device_get_verify_kind(FuDevice *self) G_GNUC_NON_NULL(1);
+void
+fu_device_set_verify_kind(FuDevice *self, FuDeviceVerifyKind verify_kind) G_GNUC_NON_NULL(1);
 void
 fu_device_set_firmware_size(FuDevice *self, guint64 size) G_GNUC_NON_NULL(1);
 void
@@ -989,6 +1025,11 @@ GBytes *
 fu_device_dump_firmware(FuDevice *self,
 			FuProgress *progress,
 			GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
+gchar *
+fu_device_compute_checksum(FuDevice *self,
+			   GChecksumType checksum_type,
+			   FuProgress *progress,
+			   GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 3);
 gboolean
 fu_device_attach(FuDevice *self, GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
 gboolean
@@ -1037,8 +1078,16 @@ fu_device_poll(FuDevice *self, GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_
 void
 fu_device_set_poll_interval(FuDevice *self, guint interval) G_GNUC_NON_NULL(1);
 void
+fu_device_poll_reset(FuDevice *self) G_GNUC_NON_NULL(1);
+void
 fu_device_retry_set_delay(FuDevice *self, guint delay) G_GNUC_NON_NULL(1);
 void
+fu_device_retry_set_failure_budget(FuDevice *self, guint failure_budget) G_GNUC_NON_NULL(1);
+void
+fu_device_retry_set_policy(FuDevice *self, FuDeviceRetryPolicy policy) G_GNUC_NON_NULL(1);
+void
+fu_device_retry_set_deadline(FuDevice *self, guint timeout_ms) G_GNUC_NON_NULL(1);
+void
 fu_device_retry_add_recovery(FuDevice *self, GQuark domain, gint code, FuDeviceRetryFunc func)
     G_GNUC_NON_NULL(1);
 gboolean
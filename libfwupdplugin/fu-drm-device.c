@@ -27,6 +27,7 @@
 
 typedef struct {
 	gchar *connector_id;
+	gchar *edid_hash;
 	gboolean enabled;
 	FuDisplayState display_state;
 	FuEdid *edid;
@@ -40,6 +41,11 @@ G_DEFINE_TYPE_WITH_PRIVATE(FuDrmDevice, fu_drm_device, FU_TYPE_UDEV_DEVICE)
 
 #define GET_PRIVATE(o) (fu_drm_device_get_instance_private(o))
 
+/* str:FuEdid, keyed by connector-id + EDID hash and shared across the whole enumeration
+ * pass -- a multi-GPU box probes dozens of connectors and the parsed EDID never differs
+ * for the same panel */
+static GHashTable *fu_drm_device_edid_cache = NULL;
+
 #ifdef HAVE_LIBDRM
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(drmModeCrtc, drmModeFreeCrtc)
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(drmModeRes, drmModeFreeResources)
@@ -262,20 +268,56 @@ fu_drm_device_probe(FuDevice *device, GError **error)
 
 	/* read EDID and parse it */
 	if (priv->display_state == FU_DISPLAY_STATE_CONNECTED) {
+		static GMutex mutex;
+		FuEdid *edid_cached;
+		g_autofree gchar *cache_key = NULL;
+		g_autofree gchar *edid_hash = NULL;
 		g_autofree gchar *edid_path = g_build_filename(sysfs_path, "edid", NULL);
-		g_autoptr(FuEdid) edid = fu_edid_new();
+		g_autoptr(FuEdid) edid = NULL;
 		g_autoptr(GBytes) blob = NULL;
+		g_autoptr(GMutexLocker) locker = NULL;
 
 		blob = fu_bytes_get_contents(edid_path, error);
 		if (blob == NULL)
 			return FALSE;
-		if (!fu_firmware_parse_bytes(FU_FIRMWARE(edid),
-					     blob,
-					     0x0,
-					     FWUPD_INSTALL_FLAG_NONE,
-					     error))
-			return FALSE;
+
+		/* a change uevent that did not alter the EDID, e.g. a mode set -- everything
+		 * we derived from it last time is still valid */
+		edid_hash = g_compute_checksum_for_bytes(G_CHECKSUM_SHA1, blob);
+		if (priv->edid != NULL && g_strcmp0(edid_hash, priv->edid_hash) == 0)
+			return TRUE;
+
+		cache_key = g_strdup_printf("%s-%s",
+					    priv->connector_id != NULL ? priv->connector_id
+								       : physical_id,
+					    edid_hash);
+		locker = g_mutex_locker_new(&mutex);
+		if (fu_drm_device_edid_cache == NULL) {
+			fu_drm_device_edid_cache =
+			    g_hash_table_new_full(g_str_hash,
+						  g_str_equal,
+						  g_free,
+						  (GDestroyNotify)g_object_unref);
+		}
+		edid_cached = g_hash_table_lookup(fu_drm_device_edid_cache, cache_key);
+		if (edid_cached != NULL) {
+			edid = g_object_ref(edid_cached);
+		} else {
+			edid = fu_edid_new();
+			if (!fu_firmware_parse_bytes(FU_FIRMWARE(edid),
+						     blob,
+						     0x0,
+						     FWUPD_INSTALL_FLAG_NONE,
+						     error))
+				return FALSE;
+			g_hash_table_insert(fu_drm_device_edid_cache,
+					    g_strdup(cache_key),
+					    g_object_ref(edid));
+		}
+		g_clear_pointer(&locker, g_mutex_locker_free);
 		g_set_object(&priv->edid, edid);
+		g_free(priv->edid_hash);
+		priv->edid_hash = g_strdup(edid_hash);
 
 		/* add instance ID */
 		fu_device_add_instance_str(device, "VEN", fu_edid_get_pnp_id(edid));
@@ -355,6 +397,8 @@ fu_drm_device_incorporate(FuDevice *device, FuDevice *donor)
 		priv->connector_id = g_strdup(priv_donor->connector_id);
 	if (priv->edid == NULL && priv_donor->edid != NULL)
 		priv->edid = g_object_ref(priv_donor->edid);
+	if (priv->edid_hash == NULL && priv_donor->edid_hash != NULL)
+		priv->edid_hash = g_strdup(priv_donor->edid_hash);
 	if (priv->crtc_x == 0 && priv_donor->crtc_x > 0)
 		priv->crtc_x = priv_donor->crtc_x;
 	if (priv->crtc_y == 0 && priv_donor->crtc_y > 0)
@@ -378,6 +422,7 @@ fu_drm_device_finalize(GObject *object)
 	FuDrmDevicePrivate *priv = GET_PRIVATE(self);
 
 	g_free(priv->connector_id);
+	g_free(priv->edid_hash);
 	if (priv->edid != NULL)
 		g_object_unref(priv->edid);
 
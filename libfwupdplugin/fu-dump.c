@@ -10,6 +10,8 @@
 
 #include "fu-dump.h"
 
+static const gchar fu_dump_hex_digits[] = "0123456789abcdef";
+
 /**
  * fu_dump_full:
  * @log_domain: (nullable): optional log domain, typically %G_LOG_DOMAIN
@@ -31,7 +33,7 @@ fu_dump_full(const gchar *log_domain,
 	     guint columns,
 	     FuDumpFlags flags)
 {
-	g_autoptr(GString) str = g_string_new(NULL);
+	g_autoptr(GString) str = NULL;
 
 	g_return_if_fail(columns > 0);
 
@@ -40,6 +42,9 @@ fu_dump_full(const gchar *log_domain,
 	if (g_getenv("FWUPD_VERBOSE") == NULL)
 		return;
 
+	/* each byte costs at most 7 chars plus the row prefixes, so one allocation is enough */
+	str = g_string_sized_new((len * 7) + ((len / columns) + 2) * 16);
+
 	/* optional */
 	if (title != NULL)
 		g_string_append_printf(str, "%s:", title);
@@ -69,17 +74,24 @@ fu_dump_full(const gchar *log_domain,
 		g_string_append_printf(str, "\n0x%04x │ ", (guint)0);
 	}
 
-	/* print each row */
+	/* print each row; not using g_string_append_printf() per cell as formatting dominated
+	 * the cost of dumping large buffers */
 	for (gsize i = 0; i < len; i++) {
-		g_string_append_printf(str, "%02x ", data[i]);
+		gchar cell[7];
+		guint cellsz = 0;
+
+		cell[cellsz++] = fu_dump_hex_digits[data[i] >> 4];
+		cell[cellsz++] = fu_dump_hex_digits[data[i] & 0xFu];
+		cell[cellsz++] = ' ';
 
 		/* optionally print ASCII char */
 		if (flags & FU_DUMP_FLAGS_SHOW_ASCII) {
-			if (g_ascii_isprint(data[i]))
-				g_string_append_printf(str, "[%c] ", data[i]);
-			else
-				g_string_append(str, "[?] ");
+			cell[cellsz++] = '[';
+			cell[cellsz++] = g_ascii_isprint(data[i]) ? (gchar)data[i] : '?';
+			cell[cellsz++] = ']';
+			cell[cellsz++] = ' ';
 		}
+		g_string_append_len(str, cell, cellsz);
 
 		/* new row required */
 		if (i > 0 && i != len - 1 && (i + 1) % columns == 0) {
@@ -8,8 +8,10 @@
 
 #include "fu-byte-array.h"
 #include "fu-bytes.h"
+#include "fu-common.h"
 #include "fu-efi-file.h"
 #include "fu-efi-filesystem.h"
+#include "fu-efi-struct.h"
 #include "fu-input-stream.h"
 #include "fu-partial-input-stream.h"
 
@@ -26,6 +28,84 @@ G_DEFINE_TYPE(FuEfiFilesystem, fu_efi_filesystem, FU_TYPE_FIRMWARE)
 #define FU_EFI_FILESYSTEM_FILES_MAX 10000
 #define FU_EFI_FILESYSTEM_SIZE_MAX  0x10000000 /* 256 MB */
 
+typedef struct {
+	FuFirmware *img;
+	GBytes *blob;
+	gsize offset;
+	FwupdInstallFlags flags;
+	GError *error;
+} FuEfiFilesystemItem;
+
+static void
+fu_efi_filesystem_item_free(FuEfiFilesystemItem *item)
+{
+	g_object_unref(item->img);
+	if (item->blob != NULL)
+		g_bytes_unref(item->blob);
+	if (item->error != NULL)
+		g_error_free(item->error);
+	g_free(item);
+}
+
+/* set on pool threads so that nested filesystems do not create nested pools */
+static GPrivate fu_efi_filesystem_worker_key = G_PRIVATE_INIT(NULL);
+
+static void
+fu_efi_filesystem_parse_item(FuEfiFilesystemItem *item)
+{
+	g_autoptr(GInputStream) stream = g_memory_input_stream_new_from_bytes(item->blob);
+	if (!fu_firmware_parse_stream(item->img,
+				      stream,
+				      0x0,
+				      item->flags | FWUPD_INSTALL_FLAG_NO_SEARCH,
+				      &item->error)) {
+		g_prefix_error(&item->error,
+			       "failed to parse EFI file at 0x%x: ",
+			       (guint)item->offset);
+	}
+}
+
+static void
+fu_efi_filesystem_parse_item_cb(gpointer data, gpointer user_data)
+{
+	g_private_set(&fu_efi_filesystem_worker_key, GUINT_TO_POINTER(TRUE));
+	fu_efi_filesystem_parse_item((FuEfiFilesystemItem *)data);
+}
+
+/* just enough of the FFS header to know the file extent, done up-front so that the expensive
+ * section decode can happen out-of-order on the pool */
+static gboolean
+fu_efi_filesystem_get_file_size(GInputStream *stream, gsize offset, gsize *size, GError **error)
+{
+	guint32 size_tmp;
+	g_autoptr(GByteArray) st = NULL;
+
+	st = fu_struct_efi_file_parse_stream(stream, offset, error);
+	if (st == NULL)
+		return FALSE;
+	if (fu_struct_efi_file_get_attrs(st) & FU_EFI_FILE_ATTRIB_LARGE_FILE) {
+		g_autoptr(GByteArray) st2 = NULL;
+		st2 = fu_struct_efi_file2_parse_stream(stream, offset, error);
+		if (st2 == NULL)
+			return FALSE;
+		size_tmp = fu_struct_efi_file2_get_extended_size(st2);
+	} else {
+		size_tmp = fu_struct_efi_file_get_size(st);
+	}
+	if (size_tmp < st->len) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INTERNAL,
+			    "invalid FFS length, got 0x%x",
+			    (guint)size_tmp);
+		return FALSE;
+	}
+
+	/* success */
+	*size = size_tmp;
+	return TRUE;
+}
+
 static gboolean
 fu_efi_filesystem_parse(FuFirmware *firmware,
 			GInputStream *stream,
@@ -34,12 +114,20 @@ fu_efi_filesystem_parse(FuFirmware *firmware,
 {
 	gsize offset = 0;
 	gsize streamsz = 0;
+	guint images_max = fu_firmware_get_images_max(firmware);
+	g_autoptr(GPtrArray) items =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)fu_efi_filesystem_item_free);
+
 	if (!fu_input_stream_size(stream, &streamsz, error))
 		return FALSE;
+
+	/* walk the file headers to find each extent */
 	while (offset < streamsz) {
-		g_autoptr(FuFirmware) img = fu_efi_file_new();
-		g_autoptr(GInputStream) stream_tmp = NULL;
+		gsize size = 0;
 		gboolean is_freespace = TRUE;
+		FuEfiFilesystemItem *item;
+		g_autoptr(FuFirmware) img = fu_efi_file_new();
+		g_autoptr(GBytes) blob = NULL;
 
 		/* ignore free space */
 		for (guint i = 0; i < 0x18; i++) {
@@ -57,23 +145,65 @@ fu_efi_filesystem_parse(FuFirmware *firmware,
 				(guint)streamsz);
 			break;
 		}
-		stream_tmp = fu_partial_input_stream_new(stream, offset, streamsz - offset, error);
-		if (stream_tmp == NULL)
-			return FALSE;
-		if (!fu_firmware_parse_stream(img,
-					      stream_tmp,
-					      0x0,
-					      flags | FWUPD_INSTALL_FLAG_NO_SEARCH,
-					      error)) {
+		if (!fu_efi_filesystem_get_file_size(stream, offset, &size, error)) {
 			g_prefix_error(error, "failed to parse EFI file at 0x%x: ", (guint)offset);
 			return FALSE;
 		}
-		fu_firmware_set_offset(firmware, offset);
-		if (!fu_firmware_add_image_full(firmware, img, error))
+		blob = fu_input_stream_read_bytes(stream,
+						  offset,
+						  MIN(size, streamsz - offset),
+						  NULL,
+						  error);
+		if (blob == NULL) {
+			g_prefix_error(error, "failed to parse EFI file at 0x%x: ", (guint)offset);
 			return FALSE;
+		}
+		item = g_new0(FuEfiFilesystemItem, 1);
+		item->img = g_object_ref(img);
+		item->blob = g_steal_pointer(&blob);
+		item->offset = offset;
+		item->flags = flags;
+		g_ptr_array_add(items, item);
+
+		/* no point decoding any more than the image limit can hold */
+		if (images_max > 0 && items->len > images_max)
+			break;
 
 		/* next! */
-		offset += fu_firmware_get_size(img);
+		offset += fu_common_align_up(size, fu_firmware_get_alignment(img));
+	}
+
+	/* decode each file, using all the cores when there is enough work to be worth it --
+	 * but never from inside a pool thread to avoid nested pools for nested volumes */
+	if (items->len > 1 && g_get_num_processors() > 1 &&
+	    !GPOINTER_TO_UINT(g_private_get(&fu_efi_filesystem_worker_key))) {
+		GThreadPool *pool = g_thread_pool_new(fu_efi_filesystem_parse_item_cb,
+						      NULL,
+						      (gint)g_get_num_processors(),
+						      FALSE,
+						      error);
+		if (pool == NULL)
+			return FALSE;
+		for (guint i = 0; i < items->len; i++) {
+			FuEfiFilesystemItem *item = g_ptr_array_index(items, i);
+			g_thread_pool_push(pool, item, NULL);
+		}
+		g_thread_pool_free(pool, FALSE, TRUE);
+	} else {
+		for (guint i = 0; i < items->len; i++)
+			fu_efi_filesystem_parse_item(g_ptr_array_index(items, i));
+	}
+
+	/* attach in file order so the output is deterministic */
+	for (guint i = 0; i < items->len; i++) {
+		FuEfiFilesystemItem *item = g_ptr_array_index(items, i);
+		if (item->error != NULL) {
+			g_propagate_error(error, g_steal_pointer(&item->error));
+			return FALSE;
+		}
+		fu_firmware_set_offset(firmware, item->offset);
+		if (!fu_firmware_add_image_full(firmware, item->img, error))
+			return FALSE;
 	}
 
 	/* success */
@@ -29,12 +29,102 @@
 
 struct _FuEfiSignatureList {
 	FuFirmware parent_instance;
+	GHashTable *checksum_index; /* (nullable) (element-type utf8): SHA256 */
+	guint checksum_index_cnt;
 };
 
 G_DEFINE_TYPE(FuEfiSignatureList, fu_efi_signature_list, FU_TYPE_FIRMWARE)
 
 const guint8 FU_EFI_SIGLIST_HEADER_MAGIC[] = {0x26, 0x16, 0xC4, 0xC1, 0x4C};
 
+/* index the SHA256 checksum of every signature so that lookups are O(1),
+ * rebuilding if more images have been added since the last query */
+static void
+fu_efi_signature_list_ensure_index(FuEfiSignatureList *self)
+{
+	g_autoptr(GPtrArray) sigs = fu_firmware_get_images(FU_FIRMWARE(self));
+
+	if (self->checksum_index != NULL && self->checksum_index_cnt == sigs->len)
+		return;
+	if (self->checksum_index == NULL) {
+		self->checksum_index =
+		    g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	} else {
+		g_hash_table_remove_all(self->checksum_index);
+	}
+	for (guint i = 0; i < sigs->len; i++) {
+		FuEfiSignature *sig = g_ptr_array_index(sigs, i);
+		g_autofree gchar *checksum = NULL;
+		checksum = fu_firmware_get_checksum(FU_FIRMWARE(sig), G_CHECKSUM_SHA256, NULL);
+		if (checksum == NULL)
+			continue;
+		g_hash_table_add(self->checksum_index, g_steal_pointer(&checksum));
+	}
+	self->checksum_index_cnt = sigs->len;
+}
+
+/**
+ * fu_efi_signature_list_has_checksum:
+ * @self: a #FuEfiSignatureList
+ * @checksum: a SHA256 checksum
+ *
+ * Finds out if any signature in the list has a specific checksum, using an
+ * internal index rather than comparing each signature in turn.
+ *
+ * Returns: %TRUE if the checksum was found
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_efi_signature_list_has_checksum(FuEfiSignatureList *self, const gchar *checksum)
+{
+	g_return_val_if_fail(FU_IS_EFI_SIGNATURE_LIST(self), FALSE);
+	g_return_val_if_fail(checksum != NULL, FALSE);
+	fu_efi_signature_list_ensure_index(self);
+	return g_hash_table_contains(self->checksum_index, checksum);
+}
+
+/**
+ * fu_efi_signature_list_get_missing:
+ * @self: a #FuEfiSignatureList
+ * @other: another #FuEfiSignatureList
+ * @error: (nullable): optional return location for an error
+ *
+ * Computes the signatures contained in @self that are missing from @other,
+ * for instance the dbx update entries that have not yet been applied to the
+ * system dbx.
+ *
+ * Returns: (transfer container) (element-type FuEfiSignature): signatures
+ *
+ * Since: 2.0.3
+ **/
+GPtrArray *
+fu_efi_signature_list_get_missing(FuEfiSignatureList *self,
+				  FuEfiSignatureList *other,
+				  GError **error)
+{
+	g_autoptr(GPtrArray) missing = g_ptr_array_new_with_free_func(g_object_unref);
+	g_autoptr(GPtrArray) sigs = NULL;
+
+	g_return_val_if_fail(FU_IS_EFI_SIGNATURE_LIST(self), NULL);
+	g_return_val_if_fail(FU_IS_EFI_SIGNATURE_LIST(other), NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+	sigs = fu_firmware_get_images(FU_FIRMWARE(self));
+	for (guint i = 0; i < sigs->len; i++) {
+		FuEfiSignature *sig = g_ptr_array_index(sigs, i);
+		g_autofree gchar *checksum = NULL;
+		checksum = fu_firmware_get_checksum(FU_FIRMWARE(sig), G_CHECKSUM_SHA256, error);
+		if (checksum == NULL)
+			return NULL;
+		if (!fu_efi_signature_list_has_checksum(other, checksum))
+			g_ptr_array_add(missing, g_object_ref(sig));
+	}
+
+	/* success */
+	return g_steal_pointer(&missing);
+}
+
 static gboolean
 fu_efi_signature_list_parse_item(FuEfiSignatureList *self,
 				 FuEfiSignatureKind sig_kind,
@@ -292,10 +382,21 @@ fu_efi_signature_list_new(void)
 	return g_object_new(FU_TYPE_EFI_SIGNATURE_LIST, NULL);
 }
 
+static void
+fu_efi_signature_list_finalize(GObject *object)
+{
+	FuEfiSignatureList *self = FU_EFI_SIGNATURE_LIST(object);
+	if (self->checksum_index != NULL)
+		g_hash_table_unref(self->checksum_index);
+	G_OBJECT_CLASS(fu_efi_signature_list_parent_class)->finalize(object);
+}
+
 static void
 fu_efi_signature_list_class_init(FuEfiSignatureListClass *klass)
 {
+	GObjectClass *object_class = G_OBJECT_CLASS(klass);
 	FuFirmwareClass *firmware_class = FU_FIRMWARE_CLASS(klass);
+	object_class->finalize = fu_efi_signature_list_finalize;
 	firmware_class->validate = fu_efi_signature_list_validate;
 	firmware_class->parse = fu_efi_signature_list_parse;
 	firmware_class->write = fu_efi_signature_list_write;
@@ -13,3 +13,10 @@ G_DECLARE_FINAL_TYPE(FuEfiSignatureList, fu_efi_signature_list, FU, EFI_SIGNATUR
 
 FuFirmware *
 fu_efi_signature_list_new(void);
+gboolean
+fu_efi_signature_list_has_checksum(FuEfiSignatureList *self, const gchar *checksum)
+    G_GNUC_NON_NULL(1, 2);
+GPtrArray *
+fu_efi_signature_list_get_missing(FuEfiSignatureList *self,
+				  FuEfiSignatureList *other,
+				  GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
@@ -18,7 +18,66 @@
 #include "fu-pefile-firmware.h"
 #include "fu-volume-private.h"
 
-G_DEFINE_TYPE(FuEfivars, fu_efivars, G_TYPE_OBJECT)
+typedef struct {
+	GHashTable *cache; /* (nullable) (element-type utf8 FuEfivarsCacheItem) */
+	GMutex cache_mutex;
+} FuEfivarsPrivate;
+
+G_DEFINE_TYPE_WITH_PRIVATE(FuEfivars, fu_efivars, G_TYPE_OBJECT)
+
+#define GET_PRIVATE(o) (fu_efivars_get_instance_private(o))
+
+typedef struct {
+	GBytes *blob;
+	guint32 attr;
+} FuEfivarsCacheItem;
+
+static void
+fu_efivars_cache_item_free(FuEfivarsCacheItem *item)
+{
+	g_bytes_unref(item->blob);
+	g_free(item);
+}
+
+/* variables that cannot change without a reboot, or that only change when we
+ * write them ourselves -- notably not BootOrder, which other OS tools modify */
+static gboolean
+fu_efivars_is_cacheable(const gchar *guid, const gchar *name)
+{
+	if (g_strcmp0(guid, FU_EFIVARS_GUID_EFI_GLOBAL) == 0) {
+		const gchar *names[] = {
+		    "AuditMode",
+		    "BootCurrent",
+		    "DeployedMode",
+		    "KEK",
+		    "PK",
+		    "SecureBoot",
+		    "SetupMode",
+		    NULL,
+		};
+		return g_strv_contains(names, name);
+	}
+	if (g_strcmp0(guid, FU_EFIVARS_GUID_SECURITY_DATABASE) == 0)
+		return g_strcmp0(name, "db") == 0 || g_strcmp0(name, "dbx") == 0;
+	return FALSE;
+}
+
+static void
+fu_efivars_cache_remove(FuEfivars *self, const gchar *guid, const gchar *name)
+{
+	FuEfivarsPrivate *priv = GET_PRIVATE(self);
+	g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&priv->cache_mutex);
+
+	g_return_if_fail(locker != NULL);
+	if (priv->cache == NULL)
+		return;
+	if (name == NULL) {
+		g_hash_table_remove_all(priv->cache);
+	} else {
+		g_autofree gchar *cache_key = g_strdup_printf("%s/%s", guid, name);
+		g_hash_table_remove(priv->cache, cache_key);
+	}
+}
 
 /**
  * fu_efivars_supported:
@@ -73,6 +132,7 @@ fu_efivars_delete(FuEfivars *self, const gchar *guid, const gchar *name, GError
 		g_set_error_literal(error, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED, "not supported");
 		return FALSE;
 	}
+	fu_efivars_cache_remove(self, guid, name);
 	return efivars_class->delete (self, guid, name, error);
 }
 
@@ -106,6 +166,7 @@ fu_efivars_delete_with_glob(FuEfivars *self,
 		g_set_error_literal(error, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED, "not supported");
 		return FALSE;
 	}
+	fu_efivars_cache_remove(self, guid, NULL);
 	return efivars_class->delete_with_glob(self, guid, name_glob, error);
 }
 
@@ -170,6 +231,50 @@ fu_efivars_get_data(FuEfivars *self,
 		g_set_error_literal(error, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED, "not supported");
 		return FALSE;
 	}
+
+	/* something that cannot change until we reboot, or until we write it ourselves */
+	if (fu_efivars_is_cacheable(guid, name)) {
+		FuEfivarsPrivate *priv = GET_PRIVATE(self);
+		FuEfivarsCacheItem *item;
+		g_autofree gchar *cache_key = g_strdup_printf("%s/%s", guid, name);
+		g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&priv->cache_mutex);
+
+		g_return_val_if_fail(locker != NULL, FALSE);
+		if (priv->cache == NULL) {
+			priv->cache =
+			    g_hash_table_new_full(g_str_hash,
+						  g_str_equal,
+						  g_free,
+						  (GDestroyNotify)fu_efivars_cache_item_free);
+		}
+		item = g_hash_table_lookup(priv->cache, cache_key);
+		if (item == NULL) {
+			guint8 *data_tmp = NULL;
+			gsize data_sz_tmp = 0;
+			guint32 attr_tmp = 0;
+			if (!efivars_class->get_data(self,
+						     guid,
+						     name,
+						     &data_tmp,
+						     &data_sz_tmp,
+						     &attr_tmp,
+						     error))
+				return FALSE;
+			item = g_new0(FuEfivarsCacheItem, 1);
+			item->blob = g_bytes_new_take(data_tmp, data_sz_tmp);
+			item->attr = attr_tmp;
+			g_hash_table_insert(priv->cache, g_steal_pointer(&cache_key), item);
+		}
+		if (data != NULL)
+			*data = g_memdup2(g_bytes_get_data(item->blob, NULL),
+					  g_bytes_get_size(item->blob));
+		if (data_sz != NULL)
+			*data_sz = g_bytes_get_size(item->blob);
+		if (attr != NULL)
+			*attr = item->attr;
+		return TRUE;
+	}
+
 	return efivars_class->get_data(self, guid, name, data, data_sz, attr, error);
 }
 
@@ -329,6 +434,7 @@ fu_efivars_set_data(FuEfivars *self,
 		g_set_error_literal(error, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED, "not supported");
 		return FALSE;
 	}
+	fu_efivars_cache_remove(self, guid, name);
 	return efivars_class->set_data(self, guid, name, data, sz, attr, error);
 }
 
@@ -368,6 +474,196 @@ fu_efivars_set_data_bytes(FuEfivars *self,
 	return fu_efivars_set_data(self, guid, name, buf, bufsz, attr, error);
 }
 
+typedef struct {
+	gchar *guid;
+	gchar *name;
+	GBytes *bytes;
+	guint32 attr;
+} FuEfivarsAsyncHelper;
+
+static void
+fu_efivars_async_helper_free(FuEfivarsAsyncHelper *helper)
+{
+	if (helper->bytes != NULL)
+		g_bytes_unref(helper->bytes);
+	g_free(helper->guid);
+	g_free(helper->name);
+	g_free(helper);
+}
+
+static void
+fu_efivars_get_data_bytes_thread_cb(GTask *task,
+				    gpointer source_object,
+				    gpointer task_data,
+				    GCancellable *cancellable)
+{
+	FuEfivars *self = FU_EFIVARS(source_object);
+	FuEfivarsAsyncHelper *helper = (FuEfivarsAsyncHelper *)task_data;
+	GBytes *blob;
+	GError *error = NULL;
+
+	blob = fu_efivars_get_data_bytes(self, helper->guid, helper->name, &helper->attr, &error);
+	if (blob == NULL) {
+		g_task_return_error(task, error);
+		return;
+	}
+	g_task_return_pointer(task, blob, (GDestroyNotify)g_bytes_unref);
+}
+
+/**
+ * fu_efivars_get_data_bytes_async:
+ * @self: a #FuEfivars
+ * @guid: Globally unique identifier
+ * @name: Variable name
+ * @cancellable: (nullable): optional #GCancellable
+ * @callback: function to call when the request is satisfied
+ * @callback_data: data to pass to @callback
+ *
+ * Gets the data from a UEFI variable in NVRAM without blocking the calling
+ * thread, as reading NVRAM can take hundreds of milliseconds on some firmware.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_efivars_get_data_bytes_async(FuEfivars *self,
+				const gchar *guid,
+				const gchar *name,
+				GCancellable *cancellable,
+				GAsyncReadyCallback callback,
+				gpointer callback_data)
+{
+	FuEfivarsAsyncHelper *helper;
+	g_autoptr(GTask) task = NULL;
+
+	g_return_if_fail(FU_IS_EFIVARS(self));
+	g_return_if_fail(guid != NULL);
+	g_return_if_fail(name != NULL);
+	g_return_if_fail(cancellable == NULL || G_IS_CANCELLABLE(cancellable));
+
+	helper = g_new0(FuEfivarsAsyncHelper, 1);
+	helper->guid = g_strdup(guid);
+	helper->name = g_strdup(name);
+	task = g_task_new(self, cancellable, callback, callback_data);
+	g_task_set_task_data(task, helper, (GDestroyNotify)fu_efivars_async_helper_free);
+	g_task_run_in_thread(task, fu_efivars_get_data_bytes_thread_cb);
+}
+
+/**
+ * fu_efivars_get_data_bytes_finish:
+ * @self: a #FuEfivars
+ * @res: the asynchronous result
+ * @attr: (out) (optional): attributes
+ * @error: (nullable): optional return location for an error
+ *
+ * Gets the result of fu_efivars_get_data_bytes_async().
+ *
+ * Returns: (transfer full): a #GBytes, or %NULL
+ *
+ * Since: 2.0.3
+ **/
+GBytes *
+fu_efivars_get_data_bytes_finish(FuEfivars *self, GAsyncResult *res, guint32 *attr, GError **error)
+{
+	g_return_val_if_fail(FU_IS_EFIVARS(self), NULL);
+	g_return_val_if_fail(g_task_is_valid(res, self), NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+	if (attr != NULL) {
+		FuEfivarsAsyncHelper *helper = g_task_get_task_data(G_TASK(res));
+		*attr = helper->attr;
+	}
+	return g_task_propagate_pointer(G_TASK(res), error);
+}
+
+static void
+fu_efivars_set_data_bytes_thread_cb(GTask *task,
+				    gpointer source_object,
+				    gpointer task_data,
+				    GCancellable *cancellable)
+{
+	FuEfivars *self = FU_EFIVARS(source_object);
+	FuEfivarsAsyncHelper *helper = (FuEfivarsAsyncHelper *)task_data;
+	GError *error = NULL;
+
+	if (!fu_efivars_set_data_bytes(self,
+				       helper->guid,
+				       helper->name,
+				       helper->bytes,
+				       helper->attr,
+				       &error)) {
+		g_task_return_error(task, error);
+		return;
+	}
+	g_task_return_boolean(task, TRUE);
+}
+
+/**
+ * fu_efivars_set_data_bytes_async:
+ * @self: a #FuEfivars
+ * @guid: globally unique identifier
+ * @name: variable name
+ * @bytes: data blob
+ * @attr: attributes
+ * @cancellable: (nullable): optional #GCancellable
+ * @callback: function to call when the request is satisfied
+ * @callback_data: data to pass to @callback
+ *
+ * Sets the data to a UEFI variable in NVRAM without blocking the calling
+ * thread, as a single SetVariable can take hundreds of milliseconds on some
+ * firmware.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_efivars_set_data_bytes_async(FuEfivars *self,
+				const gchar *guid,
+				const gchar *name,
+				GBytes *bytes,
+				guint32 attr,
+				GCancellable *cancellable,
+				GAsyncReadyCallback callback,
+				gpointer callback_data)
+{
+	FuEfivarsAsyncHelper *helper;
+	g_autoptr(GTask) task = NULL;
+
+	g_return_if_fail(FU_IS_EFIVARS(self));
+	g_return_if_fail(guid != NULL);
+	g_return_if_fail(name != NULL);
+	g_return_if_fail(bytes != NULL);
+	g_return_if_fail(cancellable == NULL || G_IS_CANCELLABLE(cancellable));
+
+	helper = g_new0(FuEfivarsAsyncHelper, 1);
+	helper->guid = g_strdup(guid);
+	helper->name = g_strdup(name);
+	helper->bytes = g_bytes_ref(bytes);
+	helper->attr = attr;
+	task = g_task_new(self, cancellable, callback, callback_data);
+	g_task_set_task_data(task, helper, (GDestroyNotify)fu_efivars_async_helper_free);
+	g_task_run_in_thread(task, fu_efivars_set_data_bytes_thread_cb);
+}
+
+/**
+ * fu_efivars_set_data_bytes_finish:
+ * @self: a #FuEfivars
+ * @res: the asynchronous result
+ * @error: (nullable): optional return location for an error
+ *
+ * Gets the result of fu_efivars_set_data_bytes_async().
+ *
+ * Returns: %TRUE on success
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_efivars_set_data_bytes_finish(FuEfivars *self, GAsyncResult *res, GError **error)
+{
+	g_return_val_if_fail(FU_IS_EFIVARS(self), FALSE);
+	g_return_val_if_fail(g_task_is_valid(res, self), FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+	return g_task_propagate_boolean(G_TASK(res), error);
+}
+
 /**
  * fu_efivars_get_secure_boot:
  * @self: a #FuEfivars
@@ -886,9 +1182,26 @@ fu_efivars_get_boot_entries(FuEfivars *self, GError **error)
 static void
 fu_efivars_init(FuEfivars *self)
 {
+	FuEfivarsPrivate *priv = GET_PRIVATE(self);
+	g_mutex_init(&priv->cache_mutex);
+}
+
+static void
+fu_efivars_finalize(GObject *object)
+{
+	FuEfivars *self = FU_EFIVARS(object);
+	FuEfivarsPrivate *priv = GET_PRIVATE(self);
+
+	if (priv->cache != NULL)
+		g_hash_table_unref(priv->cache);
+	g_mutex_clear(&priv->cache_mutex);
+
+	G_OBJECT_CLASS(fu_efivars_parent_class)->finalize(object);
 }
 
 static void
 fu_efivars_class_init(FuEfivarsClass *klass)
 {
+	GObjectClass *object_class = G_OBJECT_CLASS(klass);
+	object_class->finalize = fu_efivars_finalize;
 }
@@ -88,6 +88,16 @@ fu_efivars_get_data_bytes(FuEfivars *self,
 			  const gchar *name,
 			  guint32 *attr,
 			  GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2, 3);
+void
+fu_efivars_get_data_bytes_async(FuEfivars *self,
+				const gchar *guid,
+				const gchar *name,
+				GCancellable *cancellable,
+				GAsyncReadyCallback callback,
+				gpointer callback_data) G_GNUC_NON_NULL(1, 2, 3);
+GBytes *
+fu_efivars_get_data_bytes_finish(FuEfivars *self, GAsyncResult *res, guint32 *attr, GError **error)
+    G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
 gboolean
 fu_efivars_set_data(FuEfivars *self,
 		    const gchar *guid,
@@ -103,6 +113,18 @@ fu_efivars_set_data_bytes(FuEfivars *self,
 			  GBytes *bytes,
 			  guint32 attr,
 			  GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2, 3);
+void
+fu_efivars_set_data_bytes_async(FuEfivars *self,
+				const gchar *guid,
+				const gchar *name,
+				GBytes *bytes,
+				guint32 attr,
+				GCancellable *cancellable,
+				GAsyncReadyCallback callback,
+				gpointer callback_data) G_GNUC_NON_NULL(1, 2, 3, 4);
+gboolean
+fu_efivars_set_data_bytes_finish(FuEfivars *self, GAsyncResult *res, GError **error)
+    G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
 gboolean
 fu_efivars_delete(FuEfivars *self, const gchar *guid, const gchar *name, GError **error)
     G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2, 3);
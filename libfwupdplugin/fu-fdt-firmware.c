@@ -9,15 +9,13 @@
 #include "config.h"
 
 #include "fu-byte-array.h"
-#include "fu-bytes.h"
 #include "fu-common.h"
-#include "fu-crc.h"
-#include "fu-dump.h"
 #include "fu-fdt-firmware.h"
 #include "fu-fdt-image.h"
 #include "fu-fdt-struct.h"
 #include "fu-input-stream.h"
 #include "fu-mem.h"
+#include "fu-partial-input-stream.h"
 
 /**
  * FuFdtFirmware:
@@ -45,6 +43,7 @@ G_DEFINE_TYPE_WITH_PRIVATE(FuFdtFirmware, fu_fdt_firmware, FU_TYPE_FIRMWARE)
 
 #define FDT_LAST_COMP_VERSION 2
 #define FDT_DEPTH_MAX	      128
+#define FDT_PROP_INLINE_MAX   0x100 /* larger properties are kept as lazy stream views */
 
 static GString *
 fu_fdt_firmware_string_new_safe(const guint8 *buf, gsize bufsz, gsize offset, GError **error)
@@ -146,26 +145,47 @@ fu_fdt_firmware_get_image_by_path(FuFdtFirmware *self, const gchar *path, GError
 	return FU_FDT_IMAGE(g_steal_pointer(&img_current));
 }
 
+/* like fu_fdt_firmware_string_new_safe(), but reading byte-at-a-time from the stream */
+static GString *
+fu_fdt_firmware_string_new_stream(GInputStream *stream, gsize streamsz, gsize offset, GError **error)
+{
+	g_autoptr(GString) str = g_string_new(NULL);
+	for (gsize i = offset; i < streamsz; i++) {
+		guint8 tmp = 0;
+		if (!fu_input_stream_read_u8(stream, i, &tmp, error))
+			return NULL;
+		if (tmp == '\0')
+			return g_steal_pointer(&str);
+		g_string_append_c(str, (gchar)tmp);
+	}
+	g_set_error_literal(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_DATA,
+			    "buffer not NULL terminated");
+	return NULL;
+}
+
 static gboolean
-fu_fdt_firmware_parse_dt_struct(FuFdtFirmware *self, GBytes *fw, GByteArray *strtab, GError **error)
+fu_fdt_firmware_parse_dt_struct(FuFdtFirmware *self,
+				GInputStream *stream,
+				GByteArray *strtab,
+				GError **error)
 {
-	gsize bufsz = 0;
+	gsize streamsz = 0;
 	gsize offset = 0;
 	guint depth = 0;
 	gboolean has_end = FALSE;
-	const guint8 *buf = g_bytes_get_data(fw, &bufsz);
 	g_autoptr(FuFirmware) firmware_current = g_object_ref(FU_FIRMWARE(self));
 
-	/* debug */
-	fu_dump_bytes(G_LOG_DOMAIN, "dt_struct", fw);
-
 	/* parse */
-	while (offset < bufsz) {
+	if (!fu_input_stream_size(stream, &streamsz, error))
+		return FALSE;
+	while (offset < streamsz) {
 		guint32 token = 0;
 
 		/* read tag from aligned offset */
 		offset = fu_common_align_up(offset, FU_FIRMWARE_ALIGNMENT_4);
-		if (!fu_memread_uint32_safe(buf, bufsz, offset, &token, G_BIG_ENDIAN, error))
+		if (!fu_input_stream_read_u32(stream, offset, &token, G_BIG_ENDIAN, error))
 			return FALSE;
 		g_debug("token: 0x%x", token);
 		offset += sizeof(guint32);
@@ -202,7 +222,7 @@ fu_fdt_firmware_parse_dt_struct(FuFdtFirmware *self, GBytes *fw, GByteArray *str
 				return FALSE;
 			}
 
-			str = fu_fdt_firmware_string_new_safe(buf, bufsz, offset, error);
+			str = fu_fdt_firmware_string_new_stream(stream, streamsz, offset, error);
 			if (str == NULL)
 				return FALSE;
 			offset += str->len + 1;
@@ -235,7 +255,6 @@ fu_fdt_firmware_parse_dt_struct(FuFdtFirmware *self, GBytes *fw, GByteArray *str
 		if (token == FDT_PROP) {
 			guint32 prop_len;
 			guint32 prop_nameoff;
-			g_autoptr(GBytes) blob = NULL;
 			g_autoptr(GString) str = NULL;
 			g_autoptr(GByteArray) st_prp = NULL;
 
@@ -249,7 +268,7 @@ fu_fdt_firmware_parse_dt_struct(FuFdtFirmware *self, GBytes *fw, GByteArray *str
 			}
 
 			/* parse */
-			st_prp = fu_struct_fdt_prop_parse(buf, bufsz, offset, error);
+			st_prp = fu_struct_fdt_prop_parse_stream(stream, offset, error);
 			if (st_prp == NULL)
 				return FALSE;
 			prop_len = fu_struct_fdt_prop_get_len(st_prp);
@@ -265,10 +284,32 @@ fu_fdt_firmware_parse_dt_struct(FuFdtFirmware *self, GBytes *fw, GByteArray *str
 				g_prefix_error(error, "invalid strtab offset 0x%x: ", prop_nameoff);
 				return FALSE;
 			}
-			blob = fu_bytes_new_offset(fw, offset, prop_len, error);
-			if (blob == NULL)
-				return FALSE;
-			fu_fdt_image_set_attr(FU_FDT_IMAGE(firmware_current), str->str, blob);
+
+			/* small properties are read now, but anything big -- for instance the
+			 * kernel payload of a FIT image -- stays as a zero-copy view into the
+			 * source stream until somebody asks for the data */
+			if (prop_len <= FDT_PROP_INLINE_MAX) {
+				g_autoptr(GBytes) blob = NULL;
+				blob = fu_input_stream_read_bytes(stream,
+								  offset,
+								  prop_len,
+								  NULL,
+								  error);
+				if (blob == NULL)
+					return FALSE;
+				fu_fdt_image_set_attr(FU_FDT_IMAGE(firmware_current),
+						      str->str,
+						      blob);
+			} else {
+				g_autoptr(GInputStream) partial_stream = NULL;
+				partial_stream =
+				    fu_partial_input_stream_new(stream, offset, prop_len, error);
+				if (partial_stream == NULL)
+					return FALSE;
+				fu_fdt_image_set_attr_stream(FU_FDT_IMAGE(firmware_current),
+							     str->str,
+							     partial_stream);
+			}
 			offset += prop_len;
 			continue;
 		}
@@ -384,8 +425,7 @@ fu_fdt_firmware_parse(FuFirmware *firmware,
 	if (fu_struct_fdt_get_size_dt_struct(st_hdr) != 0x0 &&
 	    fu_struct_fdt_get_size_dt_strings(st_hdr) != 0x0) {
 		g_autoptr(GByteArray) dt_strings = NULL;
-		g_autoptr(GByteArray) dt_struct = NULL;
-		g_autoptr(GBytes) dt_struct_buf = NULL;
+		g_autoptr(GInputStream) dt_struct_stream = NULL;
 		dt_strings =
 		    fu_input_stream_read_byte_array(stream,
 						    fu_struct_fdt_get_off_dt_strings(st_hdr),
@@ -394,24 +434,18 @@ fu_fdt_firmware_parse(FuFirmware *firmware,
 						    error);
 		if (dt_strings == NULL)
 			return FALSE;
-		dt_struct =
-		    fu_input_stream_read_byte_array(stream,
-						    fu_struct_fdt_get_off_dt_struct(st_hdr),
-						    fu_struct_fdt_get_size_dt_struct(st_hdr),
-						    NULL,
-						    error);
-		if (dt_struct == NULL)
-			return FALSE;
-		if (dt_struct->len != fu_struct_fdt_get_size_dt_struct(st_hdr)) {
-			g_set_error(error,
-				    FWUPD_ERROR,
-				    FWUPD_ERROR_INVALID_DATA,
-				    "invalid firmware -- dt_struct invalid");
+
+		/* walked in-place so that huge properties are never duplicated */
+		dt_struct_stream =
+		    fu_partial_input_stream_new(stream,
+						fu_struct_fdt_get_off_dt_struct(st_hdr),
+						fu_struct_fdt_get_size_dt_struct(st_hdr),
+						error);
+		if (dt_struct_stream == NULL) {
+			g_prefix_error(error, "invalid firmware -- dt_struct invalid: ");
 			return FALSE;
 		}
-		dt_struct_buf =
-		    g_byte_array_free_to_bytes(g_steal_pointer(&dt_struct)); /* nocheck:blocked */
-		if (!fu_fdt_firmware_parse_dt_struct(self, dt_struct_buf, dt_strings, error))
+		if (!fu_fdt_firmware_parse_dt_struct(self, dt_struct_stream, dt_strings, error))
 			return FALSE;
 	}
 
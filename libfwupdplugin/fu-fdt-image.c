@@ -11,6 +11,7 @@
 #include "fu-byte-array.h"
 #include "fu-common.h"
 #include "fu-fdt-image.h"
+#include "fu-input-stream.h"
 #include "fu-mem.h"
 #include "fu-string.h"
 
@@ -24,6 +25,7 @@
 
 typedef struct {
 	GHashTable *hash_attrs;
+	GHashTable *hash_attrs_stream; /* (element-type utf8 GInputStream): not yet read */
 	GHashTable *hash_attrs_format;
 } FuFdtImagePrivate;
 
@@ -128,6 +130,20 @@ fu_fdt_image_export(FuFirmware *firmware, FuFirmwareExportFlags flags, XbBuilder
 		if (format != NULL)
 			xb_builder_node_set_attr(bc, "format", format);
 	}
+
+	/* deliberately not materialized, so just show the size */
+	g_hash_table_iter_init(&iter, priv->hash_attrs_stream);
+	while (g_hash_table_iter_next(&iter, &key, &value)) {
+		gsize streamsz = 0;
+		g_autofree gchar *size = NULL;
+		g_autoptr(XbBuilderNode) bc = NULL;
+
+		if (!fu_input_stream_size(G_INPUT_STREAM(value), &streamsz, NULL))
+			continue;
+		size = g_strdup_printf("0x%x", (guint)streamsz);
+		bc = xb_builder_node_insert(bn, "metadata", "key", key, NULL);
+		xb_builder_node_set_attr(bc, "size", size);
+	}
 }
 
 /**
@@ -146,6 +162,7 @@ fu_fdt_image_get_attrs(FuFdtImage *self)
 	FuFdtImagePrivate *priv = GET_PRIVATE(self);
 	GPtrArray *array = g_ptr_array_new_with_free_func(g_free);
 	g_autoptr(GList) keys = NULL;
+	g_autoptr(GList) keys_stream = NULL;
 
 	g_return_val_if_fail(FU_IS_FDT_IMAGE(self), NULL);
 
@@ -154,6 +171,11 @@ fu_fdt_image_get_attrs(FuFdtImage *self)
 		const gchar *key = l->data;
 		g_ptr_array_add(array, g_strdup(key));
 	}
+	keys_stream = g_hash_table_get_keys(priv->hash_attrs_stream);
+	for (GList *l = keys_stream; l != NULL; l = l->next) {
+		const gchar *key = l->data;
+		g_ptr_array_add(array, g_strdup(key));
+	}
 	return array;
 }
 
@@ -181,8 +203,25 @@ fu_fdt_image_get_attr(FuFdtImage *self, const gchar *key, GError **error)
 
 	blob = g_hash_table_lookup(priv->hash_attrs, key);
 	if (blob == NULL) {
-		g_set_error(error, FWUPD_ERROR, FWUPD_ERROR_NOT_FOUND, "no data for %s", key);
-		return NULL;
+		GInputStream *stream = g_hash_table_lookup(priv->hash_attrs_stream, key);
+		g_autoptr(GBytes) blob_tmp = NULL;
+
+		if (stream == NULL) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_NOT_FOUND,
+				    "no data for %s",
+				    key);
+			return NULL;
+		}
+
+		/* read the deferred stream view, then cache for next time */
+		blob_tmp = fu_input_stream_read_bytes(stream, 0x0, G_MAXSIZE, NULL, error);
+		if (blob_tmp == NULL)
+			return NULL;
+		g_hash_table_insert(priv->hash_attrs, g_strdup(key), g_bytes_ref(blob_tmp));
+		g_hash_table_remove(priv->hash_attrs_stream, key);
+		return g_steal_pointer(&blob_tmp);
 	}
 
 	/* success */
@@ -402,6 +441,30 @@ fu_fdt_image_set_attr(FuFdtImage *self, const gchar *key, GBytes *blob)
 	g_return_if_fail(FU_IS_FDT_IMAGE(self));
 	g_return_if_fail(key != NULL);
 	g_hash_table_insert(priv->hash_attrs, g_strdup(key), g_bytes_ref(blob));
+	g_hash_table_remove(priv->hash_attrs_stream, key);
+}
+
+/**
+ * fu_fdt_image_set_attr_stream:
+ * @self: a #FuFdtImage
+ * @key: string, e.g. `data`
+ * @stream: a #GInputStream, typically a #FuPartialInputStream of the parse source
+ *
+ * Sets an attribute for the image as a stream view, deferring the actual read until the
+ * first fu_fdt_image_get_attr() call. This avoids duplicating huge properties, for
+ * instance the kernel payload of a FIT image, when only the small properties are needed.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_fdt_image_set_attr_stream(FuFdtImage *self, const gchar *key, GInputStream *stream)
+{
+	FuFdtImagePrivate *priv = GET_PRIVATE(self);
+	g_return_if_fail(FU_IS_FDT_IMAGE(self));
+	g_return_if_fail(key != NULL);
+	g_return_if_fail(G_IS_INPUT_STREAM(stream));
+	g_hash_table_insert(priv->hash_attrs_stream, g_strdup(key), g_object_ref(stream));
+	g_hash_table_remove(priv->hash_attrs, key);
 }
 
 static void
@@ -635,6 +698,8 @@ fu_fdt_image_init(FuFdtImage *self)
 	FuFdtImagePrivate *priv = GET_PRIVATE(self);
 	priv->hash_attrs =
 	    g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_bytes_unref);
+	priv->hash_attrs_stream =
+	    g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_object_unref);
 	priv->hash_attrs_format = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
 	fu_firmware_set_images_max(FU_FIRMWARE(self), 10000);
 }
@@ -645,6 +710,7 @@ fu_fdt_image_finalize(GObject *object)
 	FuFdtImage *self = FU_FDT_IMAGE(object);
 	FuFdtImagePrivate *priv = GET_PRIVATE(self);
 	g_hash_table_unref(priv->hash_attrs);
+	g_hash_table_unref(priv->hash_attrs_stream);
 	g_hash_table_unref(priv->hash_attrs_format);
 	G_OBJECT_CLASS(fu_fdt_image_parent_class)->finalize(object);
 }
@@ -35,6 +35,9 @@ fu_fdt_image_get_attr_strlist(FuFdtImage *self, const gchar *key, gchar ***val,
 void
 fu_fdt_image_set_attr(FuFdtImage *self, const gchar *key, GBytes *blob) G_GNUC_NON_NULL(1, 2);
 void
+fu_fdt_image_set_attr_stream(FuFdtImage *self, const gchar *key, GInputStream *stream)
+    G_GNUC_NON_NULL(1, 2, 3);
+void
 fu_fdt_image_set_attr_uint32(FuFdtImage *self, const gchar *key, guint32 value)
     G_GNUC_NON_NULL(1, 2);
 void
@@ -15,6 +15,76 @@
 #include "fu-mem.h"
 #include "fu-string.h"
 
+static gint
+fu_firmware_strparse_nibble(gchar val)
+{
+	if (val >= '0' && val <= '9')
+		return val - '0';
+	if (val >= 'A' && val <= 'F')
+		return val - 'A' + 0xA;
+	if (val >= 'a' && val <= 'f')
+		return val - 'a' + 0xA;
+	return -1;
+}
+
+/**
+ * fu_firmware_strparse_buf_safe:
+ * @data: source string
+ * @datasz: size of @data, typically the same as `strlen(data)`
+ * @offset: offset in chars into @data to read
+ * @buf: (out caller-allocates): destination buffer
+ * @bufsz: size of @buf, which consumes `2 × bufsz` chars of @data
+ * @error: (nullable): optional return location for an error
+ *
+ * Parses a base 16 string of hex pairs directly into a buffer, which is
+ * considerably faster than calling fu_firmware_strparse_uint8_safe() for
+ * each byte when converting an entire record.
+ *
+ * Returns: %TRUE if parsed, %FALSE otherwise
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_firmware_strparse_buf_safe(const gchar *data,
+			      gsize datasz,
+			      gsize offset,
+			      guint8 *buf,
+			      gsize bufsz,
+			      GError **error)
+{
+	g_return_val_if_fail(data != NULL, FALSE);
+	g_return_val_if_fail(buf != NULL, FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	if (offset > datasz || bufsz * 2 > datasz - offset) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_DATA,
+			    "cannot parse 0x%x bytes of hex at offset 0x%x with size 0x%x",
+			    (guint)bufsz,
+			    (guint)offset,
+			    (guint)datasz);
+		return FALSE;
+	}
+	for (gsize i = 0; i < bufsz; i++) {
+		gint val_hi = fu_firmware_strparse_nibble(data[offset + (i * 2)]);
+		gint val_lo = fu_firmware_strparse_nibble(data[offset + (i * 2) + 1]);
+		if (val_hi < 0 || val_lo < 0) {
+			g_autofree gchar *str = fu_strsafe(data + offset + (i * 2), 2);
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INVALID_DATA,
+				    "cannot parse %s as hex",
+				    str);
+			return FALSE;
+		}
+		buf[i] = ((guint8)val_hi << 4) | (guint8)val_lo;
+	}
+
+	/* success */
+	return TRUE;
+}
+
 /**
  * fu_firmware_strparse_uint4_safe:
  * @data: destination buffer
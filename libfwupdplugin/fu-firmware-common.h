@@ -8,6 +8,13 @@
 
 #include <fwupd.h>
 
+gboolean
+fu_firmware_strparse_buf_safe(const gchar *data,
+			      gsize datasz,
+			      gsize offset,
+			      guint8 *buf,
+			      gsize bufsz,
+			      GError **error) G_GNUC_NON_NULL(1, 4);
 gboolean
 fu_firmware_strparse_uint4_safe(const gchar *data,
 				gsize datasz,
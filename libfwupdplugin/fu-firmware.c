@@ -29,7 +29,9 @@
 typedef struct {
 	FuFirmwareFlags flags;
 	FuFirmware *parent; /* noref */
-	GPtrArray *images;  /* FuFirmware */
+	GPtrArray *images;	   /* FuFirmware */
+	GHashTable *images_by_id;  /* (nullable): utf8 (no-copy) -> FuFirmware (no-ref) */
+	GHashTable *images_by_idx; /* (nullable): guint64 -> FuFirmware (no-ref) */
 	gchar *version;
 	guint64 version_raw;
 	FwupdVersionFormat version_format;
@@ -46,8 +48,9 @@ typedef struct {
 	gsize size_max;
 	guint images_max;
 	guint depth;
-	GPtrArray *chunks;  /* nullable, element-type FuChunk */
-	GPtrArray *patches; /* nullable, element-type FuFirmwarePatch */
+	GPtrArray *chunks;    /* nullable, element-type FuChunk */
+	GPtrArray *patches;   /* nullable, element-type FuFirmwarePatch */
+	GHashTable *checksums; /* nullable, element-type GChecksumType utf8 */
 } FuFirmwarePrivate;
 
 G_DEFINE_TYPE_WITH_PRIVATE(FuFirmware, fu_firmware, G_TYPE_OBJECT)
@@ -57,6 +60,40 @@ enum { PROP_0, PROP_PARENT, PROP_LAST };
 
 #define FU_FIRMWARE_IMAGE_DEPTH_MAX 50
 
+/* containers with fewer images than this keep using a linear scan for lookups */
+#define FU_FIRMWARE_IMAGES_INDEX_THRESHOLD 32
+
+static void
+fu_firmware_image_index_invalidate(FuFirmware *self)
+{
+	FuFirmwarePrivate *priv = GET_PRIVATE(self);
+	g_clear_pointer(&priv->images_by_id, g_hash_table_unref);
+	g_clear_pointer(&priv->images_by_idx, g_hash_table_unref);
+}
+
+static void
+fu_firmware_image_index_build(FuFirmware *self)
+{
+	FuFirmwarePrivate *priv = GET_PRIVATE(self);
+
+	priv->images_by_id = g_hash_table_new(g_str_hash, g_str_equal);
+	priv->images_by_idx = g_hash_table_new_full(g_int64_hash, g_int64_equal, g_free, NULL);
+	for (guint i = 0; i < priv->images->len; i++) {
+		FuFirmware *img = g_ptr_array_index(priv->images, i);
+		const gchar *img_id = fu_firmware_get_id(img);
+		guint64 img_idx = fu_firmware_get_idx(img);
+
+		/* first match wins, as with the linear scan */
+		if (img_id != NULL && !g_hash_table_contains(priv->images_by_id, img_id))
+			g_hash_table_insert(priv->images_by_id, (gpointer)img_id, img);
+		if (!g_hash_table_contains(priv->images_by_idx, &img_idx)) {
+			g_hash_table_insert(priv->images_by_idx,
+					    g_memdup2(&img_idx, sizeof(img_idx)),
+					    img);
+		}
+	}
+}
+
 /**
  * fu_firmware_flag_to_string:
  * @flag: a #FuFirmwareFlags, e.g. %FU_FIRMWARE_FLAG_DEDUPE_ID
@@ -372,6 +409,10 @@ fu_firmware_set_id(FuFirmware *self, const gchar *id)
 
 	g_free(priv->id);
 	priv->id = g_strdup(id);
+
+	/* the parent may have this image indexed under the old ID */
+	if (priv->parent != NULL)
+		fu_firmware_image_index_invalidate(priv->parent);
 }
 
 /**
@@ -599,7 +640,15 @@ fu_firmware_set_idx(FuFirmware *self, guint64 idx)
 {
 	FuFirmwarePrivate *priv = GET_PRIVATE(self);
 	g_return_if_fail(FU_IS_FIRMWARE(self));
+
+	/* not changed */
+	if (priv->idx == idx)
+		return;
 	priv->idx = idx;
+
+	/* the parent may have this image indexed under the old index */
+	if (priv->parent != NULL)
+		fu_firmware_image_index_invalidate(priv->parent);
 }
 
 /**
@@ -620,6 +669,15 @@ fu_firmware_get_idx(FuFirmware *self)
 	return priv->idx;
 }
 
+/* any cached digests are no longer valid when the payload changes */
+static void
+fu_firmware_invalidate_checksums(FuFirmware *self)
+{
+	FuFirmwarePrivate *priv = GET_PRIVATE(self);
+	if (priv->checksums != NULL)
+		g_hash_table_remove_all(priv->checksums);
+}
+
 /**
  * fu_firmware_set_bytes:
  * @self: a #FuPlugin
@@ -640,6 +698,7 @@ fu_firmware_set_bytes(FuFirmware *self, GBytes *bytes)
 	if (priv->bytes != NULL)
 		g_bytes_unref(priv->bytes);
 	priv->bytes = g_bytes_ref(bytes);
+	fu_firmware_invalidate_checksums(self);
 
 	/* the input stream is no longer valid */
 	g_clear_object(&priv->stream);
@@ -728,7 +787,7 @@ fu_firmware_get_bytes_with_patches(FuFirmware *self, GError **error)
 	}
 
 	/* success */
-	return g_bytes_new(buf->data, buf->len);
+	return g_byte_array_free_to_bytes(g_steal_pointer(&buf)); /* nocheck:blocked */
 }
 
 /**
@@ -800,6 +859,7 @@ fu_firmware_set_stream(FuFirmware *self, GInputStream *stream, GError **error)
 		priv->streamsz = 0;
 	}
 	g_set_object(&priv->stream, stream);
+	fu_firmware_invalidate_checksums(self);
 	return TRUE;
 }
 
@@ -921,11 +981,35 @@ fu_firmware_get_checksum(FuFirmware *self, GChecksumType csum_kind, GError **err
 		}
 	}
 
-	/* internal data */
-	if (priv->bytes != NULL)
-		return g_compute_checksum_for_bytes(csum_kind, priv->bytes);
-	if (priv->stream != NULL)
-		return fu_input_stream_compute_checksum(priv->stream, csum_kind, error);
+	/* internal data, memoized so that requirement checks, history recording and report
+	 * building do not each re-hash the same payload */
+	if (priv->bytes != NULL || priv->stream != NULL) {
+		g_autofree gchar *checksum = NULL;
+		if (priv->checksums != NULL) {
+			const gchar *checksum_tmp =
+			    g_hash_table_lookup(priv->checksums, GINT_TO_POINTER(csum_kind));
+			if (checksum_tmp != NULL)
+				return g_strdup(checksum_tmp);
+		}
+		if (priv->bytes != NULL) {
+			checksum = g_compute_checksum_for_bytes(csum_kind, priv->bytes);
+		} else {
+			checksum =
+			    fu_input_stream_compute_checksum(priv->stream, csum_kind, error);
+			if (checksum == NULL)
+				return NULL;
+		}
+		if (priv->checksums == NULL) {
+			priv->checksums = g_hash_table_new_full(g_direct_hash,
+								g_direct_equal,
+								NULL,
+								g_free);
+		}
+		g_hash_table_insert(priv->checksums,
+				    GINT_TO_POINTER(csum_kind),
+				    g_strdup(checksum));
+		return g_steal_pointer(&checksum);
+	}
 
 	/* write */
 	blob = fu_firmware_write(self, error);
@@ -1144,6 +1228,7 @@ fu_firmware_parse_stream(FuFirmware *self,
 			return FALSE;
 		g_set_object(&priv->stream, partial_stream);
 	}
+	fu_firmware_invalidate_checksums(self);
 
 	/* optional */
 	if (klass->tokenize != NULL) {
@@ -1558,7 +1643,8 @@ fu_firmware_write(FuFirmware *self, GError **error)
 		g_autoptr(GByteArray) buf = klass->write(self, error);
 		if (buf == NULL)
 			return NULL;
-		return g_bytes_new(buf->data, buf->len);
+		/* steal the buffer rather than duplicating what may be many megabytes */
+		return g_byte_array_free_to_bytes(g_steal_pointer(&buf)); /* nocheck:blocked */
 	}
 
 	/* just add default blob */
@@ -1774,7 +1860,7 @@ fu_firmware_add_image_full(FuFirmware *self, FuFirmware *img, GError **error)
 	}
 
 	/* dedupe */
-	for (guint i = 0; i < priv->images->len; i++) {
+	for (guint i = 0; priv->images != NULL && i < priv->images->len; i++) {
 		FuFirmware *img_tmp = g_ptr_array_index(priv->images, i);
 		if (priv->flags & FU_FIRMWARE_FLAG_DEDUPE_ID) {
 			if (g_strcmp0(fu_firmware_get_id(img_tmp), fu_firmware_get_id(img)) == 0) {
@@ -1791,7 +1877,7 @@ fu_firmware_add_image_full(FuFirmware *self, FuFirmware *img, GError **error)
 	}
 
 	/* sanity check */
-	if (priv->images_max > 0 && priv->images->len >= priv->images_max) {
+	if (priv->images_max > 0 && priv->images != NULL && priv->images->len >= priv->images_max) {
 		g_set_error(error,
 			    FWUPD_ERROR,
 			    FWUPD_ERROR_INVALID_DATA,
@@ -1800,7 +1886,11 @@ fu_firmware_add_image_full(FuFirmware *self, FuFirmware *img, GError **error)
 		return FALSE;
 	}
 
+	/* most firmware nodes are leaves, so this is allocated on demand */
+	if (priv->images == NULL)
+		priv->images = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
 	g_ptr_array_add(priv->images, g_object_ref(img));
+	fu_firmware_image_index_invalidate(self);
 
 	/* set the other way around */
 	fu_firmware_set_parent(img, self);
@@ -1893,8 +1983,10 @@ fu_firmware_remove_image(FuFirmware *self, FuFirmware *img, GError **error)
 	g_return_val_if_fail(FU_IS_FIRMWARE(img), FALSE);
 	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
-	if (g_ptr_array_remove(priv->images, img))
+	if (priv->images != NULL && g_ptr_array_remove(priv->images, img)) {
+		fu_firmware_image_index_invalidate(self);
 		return TRUE;
+	}
 
 	/* did not exist */
 	g_set_error(error,
@@ -1930,6 +2022,7 @@ fu_firmware_remove_image_by_idx(FuFirmware *self, guint64 idx, GError **error)
 	if (img == NULL)
 		return FALSE;
 	g_ptr_array_remove(priv->images, img);
+	fu_firmware_image_index_invalidate(self);
 	return TRUE;
 }
 
@@ -1958,6 +2051,7 @@ fu_firmware_remove_image_by_id(FuFirmware *self, const gchar *id, GError **error
 	if (img == NULL)
 		return FALSE;
 	g_ptr_array_remove(priv->images, img);
+	fu_firmware_image_index_invalidate(self);
 	return TRUE;
 }
 
@@ -1980,7 +2074,7 @@ fu_firmware_get_images(FuFirmware *self)
 	g_return_val_if_fail(FU_IS_FIRMWARE(self), NULL);
 
 	imgs = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
-	for (guint i = 0; i < priv->images->len; i++) {
+	for (guint i = 0; priv->images != NULL && i < priv->images->len; i++) {
 		FuFirmware *img = g_ptr_array_index(priv->images, i);
 		g_ptr_array_add(imgs, g_object_ref(img));
 	}
@@ -2007,10 +2101,21 @@ fu_firmware_get_image_by_id(FuFirmware *self, const gchar *id, GError **error)
 	g_return_val_if_fail(FU_IS_FIRMWARE(self), NULL);
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
-	for (guint i = 0; i < priv->images->len; i++) {
-		FuFirmware *img = g_ptr_array_index(priv->images, i);
-		if (g_strcmp0(fu_firmware_get_id(img), id) == 0)
+	/* use the id-keyed index for large containers */
+	if (id != NULL && priv->images != NULL &&
+	    priv->images->len >= FU_FIRMWARE_IMAGES_INDEX_THRESHOLD) {
+		FuFirmware *img;
+		if (priv->images_by_id == NULL)
+			fu_firmware_image_index_build(self);
+		img = g_hash_table_lookup(priv->images_by_id, id);
+		if (img != NULL)
 			return g_object_ref(img);
+	} else {
+		for (guint i = 0; priv->images != NULL && i < priv->images->len; i++) {
+			FuFirmware *img = g_ptr_array_index(priv->images, i);
+			if (g_strcmp0(fu_firmware_get_id(img), id) == 0)
+				return g_object_ref(img);
+		}
 	}
 	g_set_error(error,
 		    FWUPD_ERROR,
@@ -2082,10 +2187,20 @@ fu_firmware_get_image_by_idx(FuFirmware *self, guint64 idx, GError **error)
 	g_return_val_if_fail(FU_IS_FIRMWARE(self), NULL);
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
-	for (guint i = 0; i < priv->images->len; i++) {
-		FuFirmware *img = g_ptr_array_index(priv->images, i);
-		if (fu_firmware_get_idx(img) == idx)
+	/* use the idx-keyed index for large containers */
+	if (priv->images != NULL && priv->images->len >= FU_FIRMWARE_IMAGES_INDEX_THRESHOLD) {
+		FuFirmware *img;
+		if (priv->images_by_idx == NULL)
+			fu_firmware_image_index_build(self);
+		img = g_hash_table_lookup(priv->images_by_idx, &idx);
+		if (img != NULL)
 			return g_object_ref(img);
+	} else {
+		for (guint i = 0; priv->images != NULL && i < priv->images->len; i++) {
+			FuFirmware *img = g_ptr_array_index(priv->images, i);
+			if (fu_firmware_get_idx(img) == idx)
+				return g_object_ref(img);
+		}
 	}
 	g_set_error(error,
 		    FWUPD_ERROR,
@@ -2119,7 +2234,7 @@ fu_firmware_get_image_by_checksum(FuFirmware *self, const gchar *checksum, GErro
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
 	csum_kind = fwupd_checksum_guess_kind(checksum);
-	for (guint i = 0; i < priv->images->len; i++) {
+	for (guint i = 0; priv->images != NULL && i < priv->images->len; i++) {
 		FuFirmware *img = g_ptr_array_index(priv->images, i);
 		g_autofree gchar *checksum_tmp = NULL;
 
@@ -2223,7 +2338,7 @@ fu_firmware_get_image_by_gtype(FuFirmware *self, GType gtype, GError **error)
 	g_return_val_if_fail(gtype != G_TYPE_INVALID, NULL);
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
-	for (guint i = 0; i < priv->images->len; i++) {
+	for (guint i = 0; priv->images != NULL && i < priv->images->len; i++) {
 		FuFirmware *img = g_ptr_array_index(priv->images, i);
 		if (g_type_is_a(G_OBJECT_TYPE(img), gtype))
 			return g_object_ref(img);
@@ -2342,7 +2457,7 @@ fu_firmware_export(FuFirmware *self, FuFirmwareExportFlags flags, XbBuilderNode
 		klass->export(self, flags, bn);
 
 	/* children */
-	if (priv->images->len > 0) {
+	if (priv->images != NULL && priv->images->len > 0) {
 		for (guint i = 0; i < priv->images->len; i++) {
 			FuFirmware *img = g_ptr_array_index(priv->images, i);
 			g_autoptr(XbBuilderNode) bc = xb_builder_node_insert(bn, "firmware", NULL);
@@ -2432,8 +2547,6 @@ fu_firmware_set_property(GObject *object, guint prop_id, const GValue *value, GP
 static void
 fu_firmware_init(FuFirmware *self)
 {
-	FuFirmwarePrivate *priv = GET_PRIVATE(self);
-	priv->images = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
 }
 
 static void
@@ -2452,9 +2565,13 @@ fu_firmware_finalize(GObject *object)
 		g_ptr_array_unref(priv->chunks);
 	if (priv->patches != NULL)
 		g_ptr_array_unref(priv->patches);
+	if (priv->checksums != NULL)
+		g_hash_table_unref(priv->checksums);
 	if (priv->parent != NULL)
 		g_object_remove_weak_pointer(G_OBJECT(priv->parent), (gpointer *)&priv->parent);
-	g_ptr_array_unref(priv->images);
+	if (priv->images != NULL)
+		g_ptr_array_unref(priv->images);
+	fu_firmware_image_index_invalidate(self);
 	G_OBJECT_CLASS(fu_firmware_parent_class)->finalize(object);
 }
 
@@ -2564,11 +2681,16 @@ fu_firmware_new_from_gtypes(GInputStream *stream,
 		return NULL;
 	}
 
-	/* try each GType in turn */
+	/* try each GType in turn, rejecting candidates on the cheap magic check first with no
+	 * error set at all -- probing dozens of formats against a disk image would otherwise
+	 * build and free a GError chain for every single miss */
 	for (guint i = 0; i < gtypes->len; i++) {
 		GType gtype = g_array_index(gtypes, GType, i);
+		gsize offset_tmp = offset;
 		g_autoptr(FuFirmware) firmware = g_object_new(gtype, NULL);
 		g_autoptr(GError) error_local = NULL;
+		if (!fu_firmware_validate_for_offset(firmware, stream, &offset_tmp, flags, NULL))
+			continue;
 		if (!fu_firmware_parse_stream(firmware, stream, offset, flags, &error_local)) {
 			g_debug("%s", error_local->message);
 			if (error_all == NULL) {
@@ -2581,7 +2703,17 @@ fu_firmware_new_from_gtypes(GInputStream *stream,
 		return g_steal_pointer(&firmware);
 	}
 
-	/* failed */
+	/* failed; the error is only materialized here at the API boundary */
+	if (error_all == NULL) {
+		g_autoptr(GString) str = g_string_new("no firmware format matched: ");
+		for (guint i = 0; i < gtypes->len; i++) {
+			GType gtype = g_array_index(gtypes, GType, i);
+			g_string_append_printf(str, "%s,", g_type_name(gtype));
+		}
+		g_string_truncate(str, str->len - 1);
+		g_set_error_literal(error, FWUPD_ERROR, FWUPD_ERROR_INVALID_FILE, str->str);
+		return NULL;
+	}
 	g_propagate_error(error, g_steal_pointer(&error_all));
 	return NULL;
 }
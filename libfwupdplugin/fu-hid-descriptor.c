@@ -33,6 +33,10 @@ G_DEFINE_TYPE(FuHidDescriptor, fu_hid_descriptor, FU_TYPE_FIRMWARE)
 #define FU_HID_DESCRIPTOR_TABLE_LOCAL_DUPES_MAX	 16
 #define FU_HID_DESCRIPTOR_TABLE_GLOBAL_SIZE_MAX	 1024
 #define FU_HID_DESCRIPTOR_TABLE_GLOBAL_DUPES_MAX 64
+#define FU_HID_DESCRIPTOR_CACHE_SIZE_MAX	 64
+
+/* process-wide cache of report trees, keyed by the raw descriptor bytes */
+static GHashTable *fu_hid_descriptor_cache = NULL; /* (element-type GBytes GPtrArray) */
 
 static guint
 fu_hid_descriptor_count_table_dupes(GPtrArray *table, FuHidReportItem *item)
@@ -50,10 +54,10 @@ fu_hid_descriptor_count_table_dupes(GPtrArray *table, FuHidReportItem *item)
 }
 
 static gboolean
-fu_hid_descriptor_parse(FuFirmware *firmware,
-			GInputStream *stream,
-			FwupdInstallFlags flags,
-			GError **error)
+fu_hid_descriptor_parse_items(FuFirmware *firmware,
+			      GInputStream *stream,
+			      FwupdInstallFlags flags,
+			      GError **error)
 {
 	gsize offset = 0;
 	gsize streamsz = 0;
@@ -156,6 +160,60 @@ fu_hid_descriptor_parse(FuFirmware *firmware,
 	return TRUE;
 }
 
+static gboolean
+fu_hid_descriptor_parse(FuFirmware *firmware,
+			GInputStream *stream,
+			FwupdInstallFlags flags,
+			GError **error)
+{
+	static GMutex mutex;
+	GPtrArray *reports_cached;
+	g_autoptr(GBytes) blob = NULL;
+	g_autoptr(GMutexLocker) locker = NULL;
+	g_autoptr(GPtrArray) reports = NULL;
+
+	/* the fuzzer wants each run to be independent */
+	if (g_getenv("FWUPD_FUZZER_RUNNING") != NULL)
+		return fu_hid_descriptor_parse_items(firmware, stream, flags, error);
+
+	blob = fu_input_stream_read_bytes(stream, 0x0, G_MAXSIZE, NULL, error);
+	if (blob == NULL)
+		return FALSE;
+	locker = g_mutex_locker_new(&mutex);
+	if (fu_hid_descriptor_cache == NULL) {
+		fu_hid_descriptor_cache = g_hash_table_new_full((GHashFunc)g_bytes_hash,
+								(GEqualFunc)g_bytes_equal,
+								(GDestroyNotify)g_bytes_unref,
+								(GDestroyNotify)g_ptr_array_unref);
+	}
+
+	/* identical peripherals only parse once; the report tree is never modified in-place
+	 * after parsing (callers build new reports instead) so the objects can be shared
+	 * between descriptors -- the parent pointer is only a weak reference */
+	reports_cached = g_hash_table_lookup(fu_hid_descriptor_cache, blob);
+	if (reports_cached != NULL) {
+		for (guint i = 0; i < reports_cached->len; i++) {
+			FuFirmware *report = g_ptr_array_index(reports_cached, i);
+			if (!fu_firmware_add_image_full(firmware, report, error))
+				return FALSE;
+		}
+		return TRUE;
+	}
+
+	/* parse, then save the report tree for any other devices with the same descriptor */
+	if (!fu_hid_descriptor_parse_items(firmware, stream, flags, error))
+		return FALSE;
+	if (g_hash_table_size(fu_hid_descriptor_cache) >= FU_HID_DESCRIPTOR_CACHE_SIZE_MAX)
+		g_hash_table_remove_all(fu_hid_descriptor_cache);
+	reports = fu_firmware_get_images(firmware);
+	g_hash_table_insert(fu_hid_descriptor_cache,
+			    g_steal_pointer(&blob),
+			    g_steal_pointer(&reports));
+
+	/* success */
+	return TRUE;
+}
+
 static gboolean
 fu_hid_descriptor_write_report_item(FuFirmware *report_item,
 				    GByteArray *buf,
@@ -10,6 +10,7 @@
 
 #include "fu-context-private.h"
 #include "fu-hwids-private.h"
+#include "fu-path.h"
 #include "fu-smbios-private.h"
 #include "fu-string.h"
 
@@ -52,10 +53,82 @@ fu_hwids_smbios_convert_integer_cb(FuSmbios *smbios, guint8 type, guint8 offset,
 	return g_strdup_printf("%x", tmp);
 }
 
+static gchar *
+fu_hwids_smbios_get_cache_fn(void)
+{
+	g_autofree gchar *cachedir = fu_path_from_kind(FU_PATH_KIND_CACHEDIR_PKG);
+	return g_build_filename(cachedir, "hwids-smbios.ini", NULL);
+}
+
+/* the DMI tables are invariant per-boot, so hash the raw data to detect both
+ * firmware updates and the cache being copied between machines */
+static gchar *
+fu_hwids_smbios_get_checksum(void)
+{
+	gsize bufsz = 0;
+	g_autofree gchar *buf = NULL;
+	g_autofree gchar *dmi_fn = NULL;
+	g_autofree gchar *ep_fn = NULL;
+	g_autofree gchar *sysfsfwdir = fu_path_from_kind(FU_PATH_KIND_SYSFSDIR_FW);
+	g_autoptr(GChecksum) csum = g_checksum_new(G_CHECKSUM_SHA256);
+
+	ep_fn = g_build_filename(sysfsfwdir, "dmi", "tables", "smbios_entry_point", NULL);
+	if (!g_file_get_contents(ep_fn, &buf, &bufsz, NULL))
+		return NULL;
+	g_checksum_update(csum, (const guchar *)buf, (gssize)bufsz);
+	g_clear_pointer(&buf, g_free);
+	dmi_fn = g_build_filename(sysfsfwdir, "dmi", "tables", "DMI", NULL);
+	if (!g_file_get_contents(dmi_fn, &buf, &bufsz, NULL))
+		return NULL;
+	g_checksum_update(csum, (const guchar *)buf, (gssize)bufsz);
+	return g_strdup(g_checksum_get_string(csum));
+}
+
+static gboolean
+fu_hwids_smbios_setup_from_cache(FuContext *ctx, FuHwids *self, const gchar *checksum)
+{
+	g_autofree gchar *cache_fn = fu_hwids_smbios_get_cache_fn();
+	g_autofree gchar *checksum_old = NULL;
+	g_auto(GStrv) keys = NULL;
+	g_autoptr(GKeyFile) kf = g_key_file_new();
+
+	if (!g_key_file_load_from_file(kf, cache_fn, G_KEY_FILE_NONE, NULL))
+		return FALSE;
+	checksum_old = g_key_file_get_string(kf, "fwupd", "Checksum", NULL);
+	if (g_strcmp0(checksum_old, checksum) != 0)
+		return FALSE;
+	keys = g_key_file_get_keys(kf, "hwids", NULL, NULL);
+	if (keys == NULL)
+		return FALSE;
+	fu_context_set_chassis_kind(ctx, g_key_file_get_uint64(kf, "fwupd", "ChassisKind", NULL));
+	for (guint i = 0; keys[i] != NULL; i++) {
+		g_autofree gchar *value = g_key_file_get_string(kf, "hwids", keys[i], NULL);
+		fu_hwids_add_value(self, keys[i], value);
+	}
+	return TRUE;
+}
+
+static void
+fu_hwids_smbios_save_to_cache(GKeyFile *kf, const gchar *checksum, guint chassis_kind)
+{
+	g_autofree gchar *cache_fn = fu_hwids_smbios_get_cache_fn();
+	g_autoptr(GError) error_local = NULL;
+
+	g_key_file_set_string(kf, "fwupd", "Checksum", checksum);
+	g_key_file_set_uint64(kf, "fwupd", "ChassisKind", chassis_kind);
+	if (!fu_path_mkdir_parent(cache_fn, &error_local) ||
+	    !g_key_file_save_to_file(kf, cache_fn, &error_local)) {
+		g_debug("failed to save HWID cache: %s", error_local->message);
+	}
+}
+
 gboolean
 fu_hwids_smbios_setup(FuContext *ctx, FuHwids *self, GError **error)
 {
 	FuSmbios *smbios = fu_context_get_smbios(ctx);
+	guint chassis_kind;
+	g_autofree gchar *checksum = fu_hwids_smbios_get_checksum();
+	g_autoptr(GKeyFile) kf = g_key_file_new();
 	struct {
 		const gchar *key;
 		guint8 type;
@@ -115,13 +188,19 @@ fu_hwids_smbios_setup(FuContext *ctx, FuHwids *self, GError **error)
 		    fu_hwids_smbios_convert_string_table_cb},
 		   {NULL, 0x00, 0x00, NULL}};
 
+	/* the values parsed on a previous run are still valid for this boot */
+	if (checksum != NULL && fu_hwids_smbios_setup_from_cache(ctx, self, checksum)) {
+		g_debug("using cached SMBIOS HWID values");
+		fu_smbios_set_setup_lazy(smbios);
+		return TRUE;
+	}
+
 	if (!fu_smbios_setup(smbios, error))
 		return FALSE;
 
 	/* get all DMI data from SMBIOS */
-	fu_context_set_chassis_kind(
-	    ctx,
-	    fu_smbios_get_integer(smbios, FU_SMBIOS_STRUCTURE_TYPE_CHASSIS, 0x05, NULL));
+	chassis_kind = fu_smbios_get_integer(smbios, FU_SMBIOS_STRUCTURE_TYPE_CHASSIS, 0x05, NULL);
+	fu_context_set_chassis_kind(ctx, chassis_kind);
 	for (guint i = 0; map[i].key != NULL; i++) {
 		const gchar *contents_hdr = NULL;
 		g_autofree gchar *contents = NULL;
@@ -140,8 +219,13 @@ fu_hwids_smbios_setup(FuContext *ctx, FuHwids *self, GError **error)
 		       map[i].func != fu_hwids_smbios_convert_padded_integer_cb)
 			contents_hdr++;
 		fu_hwids_add_value(self, map[i].key, contents_hdr);
+		g_key_file_set_string(kf, "hwids", map[i].key, contents_hdr);
 	}
 
+	/* save the values for the next short-lived process */
+	if (checksum != NULL)
+		fu_hwids_smbios_save_to_cache(kf, checksum, chassis_kind);
+
 	/* success */
 	return TRUE;
 }
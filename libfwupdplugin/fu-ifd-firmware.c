@@ -299,7 +299,8 @@ fu_ifd_firmware_write(FuFirmware *firmware, GError **error)
 		fu_byte_array_set_size(buf_desc, FU_IFD_SIZE, 0x00);
 
 		/* success */
-		blob_desc = g_bytes_new(buf_desc->data, buf_desc->len);
+		blob_desc =
+		    g_byte_array_free_to_bytes(g_steal_pointer(&buf_desc)); /* nocheck:blocked */
 		img_desc = fu_firmware_new_from_bytes(blob_desc);
 		fu_firmware_set_addr(img_desc, 0x0);
 		fu_firmware_set_idx(img_desc, FU_IFD_REGION_DESC);
@@ -93,7 +93,8 @@ fu_ihex_firmware_record_new(guint ln, const gchar *line, FwupdInstallFlags flags
 	g_autoptr(FuIhexFirmwareRecord) rcd = NULL;
 	gsize linesz = strlen(line);
 	guint line_end;
-	guint16 addr16 = 0;
+	guint8 hdr[4] = {0};
+	g_autofree guint8 *buf = NULL;
 
 	/* check starting token */
 	if (line[0] != ':') {
@@ -118,13 +119,11 @@ fu_ihex_firmware_record_new(guint ln, const gchar *line, FwupdInstallFlags flags
 	rcd->ln = ln;
 	rcd->data = g_byte_array_new();
 	rcd->buf = g_string_new(line);
-	if (!fu_firmware_strparse_uint8_safe(line, linesz, 1, &rcd->byte_cnt, error))
-		return NULL;
-	if (!fu_firmware_strparse_uint16_safe(line, linesz, 3, &addr16, error))
-		return NULL;
-	rcd->addr = addr16;
-	if (!fu_firmware_strparse_uint8_safe(line, linesz, 7, &rcd->record_type, error))
+	if (!fu_firmware_strparse_buf_safe(line, linesz, 1, hdr, sizeof(hdr), error))
 		return NULL;
+	rcd->byte_cnt = hdr[0];
+	rcd->addr = fu_memread_uint16(hdr + 1, G_BIG_ENDIAN);
+	rcd->record_type = hdr[3];
 
 	/* position of checksum */
 	line_end = 9 + rcd->byte_cnt * 2;
@@ -137,15 +136,27 @@ fu_ihex_firmware_record_new(guint ln, const gchar *line, FwupdInstallFlags flags
 		return NULL;
 	}
 
+	/* convert data in one pass, with one extra byte so that zero-length
+	 * records like EOF do not get a NULL buffer */
+	buf = g_malloc0(rcd->byte_cnt + 1);
+	if (!fu_firmware_strparse_buf_safe(line, linesz, 9, buf, rcd->byte_cnt, error))
+		return NULL;
+
 	/* verify checksum */
 	if ((flags & FWUPD_INSTALL_FLAG_IGNORE_CHECKSUM) == 0) {
 		guint8 checksum = 0;
-		for (guint i = 1; i < line_end + 2; i += 2) {
-			guint8 data_tmp = 0;
-			if (!fu_firmware_strparse_uint8_safe(line, linesz, i, &data_tmp, error))
-				return NULL;
-			checksum += data_tmp;
-		}
+		guint8 checksum_expected = 0;
+		if (!fu_firmware_strparse_uint8_safe(line,
+						     linesz,
+						     line_end,
+						     &checksum_expected,
+						     error))
+			return NULL;
+		for (guint i = 0; i < sizeof(hdr); i++)
+			checksum += hdr[i];
+		for (guint i = 0; i < rcd->byte_cnt; i++)
+			checksum += buf[i];
+		checksum += checksum_expected;
 		if (checksum != 0) {
 			g_set_error(error,
 				    FWUPD_ERROR,
@@ -157,12 +168,7 @@ fu_ihex_firmware_record_new(guint ln, const gchar *line, FwupdInstallFlags flags
 	}
 
 	/* add data */
-	for (guint i = 9; i < line_end; i += 2) {
-		guint8 tmp_c = 0;
-		if (!fu_firmware_strparse_uint8_safe(line, linesz, i, &tmp_c, error))
-			return NULL;
-		fu_byte_array_append_uint8(rcd->data, tmp_c);
-	}
+	g_byte_array_append(rcd->data, buf, rcd->byte_cnt);
 	return g_steal_pointer(&rcd);
 }
 
@@ -454,6 +460,18 @@ fu_ihex_firmware_parse(FuFirmware *firmware,
 	return TRUE;
 }
 
+static const gchar fu_ihex_firmware_hexdigits[] = "0123456789ABCDEF";
+
+static inline void
+fu_ihex_firmware_emit_hex8(GString *str, guint8 value)
+{
+	g_string_append_c(str, fu_ihex_firmware_hexdigits[value >> 4]);
+	g_string_append_c(str, fu_ihex_firmware_hexdigits[value & 0xF]);
+}
+
+/* each record is ':' + len + address + type + data + checksum + '\n' */
+#define FU_IHEX_FIRMWARE_RECORD_OVERHEAD 12
+
 static void
 fu_ihex_firmware_emit_chunk(GString *str,
 			    guint16 address,
@@ -461,17 +479,40 @@ fu_ihex_firmware_emit_chunk(GString *str,
 			    const guint8 *data,
 			    gsize sz)
 {
-	guint8 checksum = 0x00;
-	g_string_append_printf(str, ":%02X%04X%02X", (guint)sz, (guint)address, (guint)record_type);
-	for (gsize j = 0; j < sz; j++)
-		g_string_append_printf(str, "%02X", data[j]);
-	checksum = (guint8)sz;
+	guint8 checksum = (guint8)sz;
+	g_string_append_c(str, ':');
+	fu_ihex_firmware_emit_hex8(str, (guint8)sz);
+	fu_ihex_firmware_emit_hex8(str, (guint8)((address & 0xff00) >> 8));
+	fu_ihex_firmware_emit_hex8(str, (guint8)(address & 0xff));
+	fu_ihex_firmware_emit_hex8(str, record_type);
 	checksum += (guint8)((address & 0xff00) >> 8);
 	checksum += (guint8)(address & 0xff);
 	checksum += record_type;
-	for (gsize j = 0; j < sz; j++)
+	for (gsize j = 0; j < sz; j++) {
+		fu_ihex_firmware_emit_hex8(str, data[j]);
 		checksum += data[j];
-	g_string_append_printf(str, "%02X\n", (guint)(((~checksum) + 0x01) & 0xff));
+	}
+	fu_ihex_firmware_emit_hex8(str, (guint8)((~checksum) + 0x01));
+	g_string_append_c(str, '\n');
+}
+
+static gsize
+fu_ihex_firmware_image_writesz(GBytes *bytes, guint32 addr)
+{
+	const guint chunk_size = 16;
+	gsize len = g_bytes_get_size(bytes);
+	gsize total = 0;
+	guint32 address_offset_last = 0x0;
+
+	for (gsize i = 0; i < len; i += chunk_size) {
+		guint32 address_offset = ((addr + i) >> 16) & 0xffff;
+		if (address_offset != address_offset_last) {
+			total += FU_IHEX_FIRMWARE_RECORD_OVERHEAD + 4;
+			address_offset_last = address_offset;
+		}
+		total += FU_IHEX_FIRMWARE_RECORD_OVERHEAD + 2 * MIN(len - i, chunk_size);
+	}
+	return total;
 }
 
 static gboolean
@@ -513,28 +554,40 @@ fu_ihex_firmware_image_to_string(GBytes *bytes,
 static GByteArray *
 fu_ihex_firmware_write(FuFirmware *firmware, GError **error)
 {
-	g_autoptr(GByteArray) buf = g_byte_array_new();
+	gsize bufsz;
+	gsize total;
 	g_autoptr(GBytes) fw = NULL;
+	g_autoptr(GBytes) img_fw = NULL;
 	g_autoptr(FuFirmware) img_sig = NULL;
-	g_autoptr(GString) str = g_string_new("");
+	g_autoptr(GString) str = NULL;
 
 	/* payload */
 	fw = fu_firmware_get_bytes_with_patches(firmware, error);
 	if (fw == NULL)
 		return NULL;
-	if (!fu_ihex_firmware_image_to_string(fw,
-					      fu_firmware_get_addr(firmware),
-					      FU_IHEX_FIRMWARE_RECORD_TYPE_DATA,
-					      str,
-					      error))
-		return NULL;
 
 	/* signature */
 	img_sig = fu_firmware_get_image_by_id(firmware, FU_FIRMWARE_ID_SIGNATURE, NULL);
 	if (img_sig != NULL) {
-		g_autoptr(GBytes) img_fw = fu_firmware_get_bytes(img_sig, error);
+		img_fw = fu_firmware_get_bytes(img_sig, error);
 		if (img_fw == NULL)
 			return NULL;
+	}
+
+	/* preallocate the exact output size so the per-record appends never reallocate */
+	total = fu_ihex_firmware_image_writesz(fw, fu_firmware_get_addr(firmware));
+	if (img_fw != NULL)
+		total += fu_ihex_firmware_image_writesz(img_fw, 0);
+	total += FU_IHEX_FIRMWARE_RECORD_OVERHEAD; /* EOF */
+	str = g_string_sized_new(total);
+
+	if (!fu_ihex_firmware_image_to_string(fw,
+					      fu_firmware_get_addr(firmware),
+					      FU_IHEX_FIRMWARE_RECORD_TYPE_DATA,
+					      str,
+					      error))
+		return NULL;
+	if (img_fw != NULL) {
 		if (!fu_ihex_firmware_image_to_string(img_fw,
 						      0,
 						      FU_IHEX_FIRMWARE_RECORD_TYPE_SIGNATURE,
@@ -543,10 +596,11 @@ fu_ihex_firmware_write(FuFirmware *firmware, GError **error)
 			return NULL;
 	}
 
-	/* add EOF */
+	/* add EOF, then take ownership of the buffer to avoid a copy */
 	fu_ihex_firmware_emit_chunk(str, 0x0, FU_IHEX_FIRMWARE_RECORD_TYPE_EOF, NULL, 0);
-	g_byte_array_append(buf, (const guint8 *)str->str, str->len);
-	return g_steal_pointer(&buf);
+	bufsz = str->len;
+	return g_byte_array_new_take((guint8 *)g_string_free(g_steal_pointer(&str), FALSE),
+				     bufsz);
 }
 
 static void
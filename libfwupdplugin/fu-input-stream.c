@@ -8,6 +8,12 @@
 
 #include "config.h"
 
+#ifdef HAVE_POSIX_FADVISE
+#include <fcntl.h>
+#include <gio/gunixinputstream.h>
+#include <glib/gstdio.h>
+#endif
+
 #include "fu-chunk-array.h"
 #include "fu-crc-private.h"
 #include "fu-input-stream.h"
@@ -19,7 +25,8 @@
  * @path: a filename
  * @error: (nullable): optional return location for an error
  *
- * Opens the file as n input stream.
+ * Opens the file as n input stream, preferring a memory-mapped window so that
+ * partial streams taken from it do not copy the source data.
  *
  * Returns: (transfer full): a #GInputStream, or %NULL on error
  *
@@ -28,12 +35,24 @@
 GInputStream *
 fu_input_stream_from_path(const gchar *path, GError **error)
 {
+	g_autoptr(GError) error_local = NULL;
 	g_autoptr(GFile) file = NULL;
 	g_autoptr(GFileInputStream) stream = NULL;
+	g_autoptr(GMappedFile) mapped_file = NULL;
 
 	g_return_val_if_fail(path != NULL, NULL);
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
+	/* try as a mapped file, falling back to a syscall-backed stream for
+	 * things like pipes and zero-length sysfs attributes */
+	mapped_file = g_mapped_file_new(path, FALSE, &error_local);
+	if (mapped_file != NULL && g_mapped_file_get_length(mapped_file) != 0) {
+		g_autoptr(GBytes) bytes = g_mapped_file_get_bytes(mapped_file);
+		fu_memadvise_sequential(g_bytes_get_data(bytes, NULL), g_bytes_get_size(bytes));
+		return g_memory_input_stream_new_from_bytes(bytes);
+	}
+	if (error_local != NULL)
+		g_debug("failed to mmap %s, using stream: %s", path, error_local->message);
 	file = g_file_new_for_path(path);
 	stream = g_file_read(file, NULL, error);
 	if (stream == NULL)
@@ -41,6 +60,49 @@ fu_input_stream_from_path(const gchar *path, GError **error)
 	return G_INPUT_STREAM(g_steal_pointer(&stream));
 }
 
+/**
+ * fu_input_stream_from_path_full:
+ * @path: a filename
+ * @flags: some #FuInputStreamFlags, e.g. %FU_INPUT_STREAM_FLAG_NO_CACHE
+ * @error: (nullable): optional return location for an error
+ *
+ * Opens the file as an input stream.
+ *
+ * Using %FU_INPUT_STREAM_FLAG_NO_CACHE advises the kernel that the data is read
+ * sequentially and should not evict more useful pages from the page cache,
+ * which matters when dumping huge block devices on busy systems.
+ *
+ * Returns: (transfer full): a #GInputStream, or %NULL on error
+ *
+ * Since: 2.0.3
+ **/
+GInputStream *
+fu_input_stream_from_path_full(const gchar *path, FuInputStreamFlags flags, GError **error)
+{
+	g_return_val_if_fail(path != NULL, NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+#ifdef HAVE_POSIX_FADVISE
+	if (flags & FU_INPUT_STREAM_FLAG_NO_CACHE) {
+		gint fd = g_open(path, O_RDONLY | O_CLOEXEC | O_NOCTTY, 0);
+		if (fd < 0) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INVALID_FILE,
+				    "failed to open %s",
+				    path);
+			return NULL;
+		}
+		/* best effort; NOREUSE needs a recent kernel to do anything */
+		if (posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL) != 0 ||
+		    posix_fadvise(fd, 0, 0, POSIX_FADV_NOREUSE) != 0)
+			g_debug("failed to fadvise %s", path);
+		return g_unix_input_stream_new(fd, TRUE);
+	}
+#endif
+	return fu_input_stream_from_path(path, error);
+}
+
 /**
  * fu_input_stream_read_safe:
  * @stream: a #GInputStream
@@ -489,6 +551,56 @@ fu_input_stream_compute_checksum(GInputStream *stream, GChecksumType checksum_ty
 	return g_strdup(g_checksum_get_string(csum));
 }
 
+static gboolean
+fu_input_stream_compute_checksums_cb(const guint8 *buf,
+				     gsize bufsz,
+				     gpointer user_data,
+				     GError **error)
+{
+	GPtrArray *csums = (GPtrArray *)user_data;
+	for (guint i = 0; i < csums->len; i++) {
+		GChecksum *csum = g_ptr_array_index(csums, i);
+		g_checksum_update(csum, buf, bufsz);
+	}
+	return TRUE;
+}
+
+/**
+ * fu_input_stream_compute_checksums:
+ * @stream: a #GInputStream
+ * @checksum_types: (array zero-terminated=1): #GChecksumType values, zero terminated
+ * @error: (nullable): optional return location for an error
+ *
+ * Generates several checksums of the entire stream in a single pass, which is much faster
+ * than calling fu_input_stream_compute_checksum() once per type for large streams.
+ *
+ * Returns: (transfer container) (element-type utf8): checksums in argument order, or %NULL
+ *
+ * Since: 2.0.3
+ **/
+GPtrArray *
+fu_input_stream_compute_checksums(GInputStream *stream,
+				  const GChecksumType *checksum_types,
+				  GError **error)
+{
+	g_autoptr(GPtrArray) csums = g_ptr_array_new_with_free_func((GDestroyNotify)g_checksum_free);
+	g_autoptr(GPtrArray) strs = g_ptr_array_new_with_free_func(g_free);
+
+	g_return_val_if_fail(G_IS_INPUT_STREAM(stream), NULL);
+	g_return_val_if_fail(checksum_types != NULL, NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+	for (guint i = 0; checksum_types[i] != 0; i++)
+		g_ptr_array_add(csums, g_checksum_new(checksum_types[i]));
+	if (!fu_input_stream_chunkify(stream, fu_input_stream_compute_checksums_cb, csums, error))
+		return NULL;
+	for (guint i = 0; i < csums->len; i++) {
+		GChecksum *csum = g_ptr_array_index(csums, i);
+		g_ptr_array_add(strs, g_strdup(g_checksum_get_string(csum)));
+	}
+	return g_steal_pointer(&strs);
+}
+
 static gboolean
 fu_input_stream_compute_sum8_cb(const guint8 *buf, gsize bufsz, gpointer user_data, GError **error)
 {
@@ -12,9 +12,27 @@
 #include "fu-endian.h"
 #include "fu-progress.h"
 
+/**
+ * FuInputStreamFlags:
+ * @FU_INPUT_STREAM_FLAG_NONE:		No flags set
+ * @FU_INPUT_STREAM_FLAG_NO_CACHE:	Advise the kernel not to keep the data in the page cache
+ *
+ * The flags to use when opening an input stream from a path.
+ **/
+typedef enum {
+	FU_INPUT_STREAM_FLAG_NONE = 0,
+	FU_INPUT_STREAM_FLAG_NO_CACHE = 1 << 0,
+	/*< private >*/
+	FU_INPUT_STREAM_FLAG_LAST
+} FuInputStreamFlags;
+
 GInputStream *
 fu_input_stream_from_path(const gchar *path, GError **error) G_GNUC_WARN_UNUSED_RESULT
     G_GNUC_NON_NULL(1);
+GInputStream *
+fu_input_stream_from_path_full(const gchar *path,
+			       FuInputStreamFlags flags,
+			       GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
 gboolean
 fu_input_stream_size(GInputStream *stream, gsize *val, GError **error) G_GNUC_NON_NULL(1);
 gboolean
@@ -100,6 +118,10 @@ gchar *
 fu_input_stream_compute_checksum(GInputStream *stream,
 				 GChecksumType checksum_type,
 				 GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
+GPtrArray *
+fu_input_stream_compute_checksums(GInputStream *stream,
+				  const GChecksumType *checksum_types,
+				  GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
 gboolean
 fu_input_stream_find(GInputStream *stream,
 		     const guint8 *buf,
@@ -175,6 +175,108 @@ fu_intel_thunderbolt_nvm_get_flash_size(FuIntelThunderboltNvm *self)
 	return priv->flash_size;
 }
 
+/**
+ * fu_intel_thunderbolt_nvm_read_windowed:
+ * @bufsz: number of NVM header bytes a full read would pull, e.g. 0x224
+ * @func: (scope call): function used to read a window of NVM data
+ * @user_data: (closure): user data to pass to @func
+ * @error: (nullable): optional return location for an error
+ *
+ * Reads only the byte ranges that parsing the NVM image will actually inspect -- the
+ * digital section fields, the DROM pointer and the DROM vendor and model fields --
+ * rather than the whole header. This matters when the NVM sits behind a slow mailbox
+ * window where every read is a device round-trip.
+ *
+ * The gaps between the windows are zero-filled in the returned blob, so this should
+ * only be used on the probe path where the IDs and version are required; parsing an
+ * update payload should always use the complete image.
+ *
+ * Returns: (transfer full): a #GBytes of size @bufsz, or %NULL on error
+ *
+ * Since: 2.0.3
+ **/
+GBytes *
+fu_intel_thunderbolt_nvm_read_windowed(gsize bufsz,
+				       FuIntelThunderboltNvmReadFunc func,
+				       gpointer user_data,
+				       GError **error)
+{
+	guint32 arc_params_offset = 0;
+	guint32 drom_offset = 0;
+	g_autofree guint8 *buf = NULL;
+
+	g_return_val_if_fail(func != NULL, NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+	/* too small to be windowed */
+	buf = g_malloc0(bufsz);
+	if (bufsz < FU_INTEL_THUNDERBOLT_NVM_DIGITAL_SIZE) {
+		if (!func(buf, bufsz, 0x0, user_data, error))
+			return NULL;
+		return g_bytes_new_take(g_steal_pointer(&buf), bufsz);
+	}
+
+	/* every digital section field except the DROM pointer is in the first 0x80 bytes */
+	if (!func(buf, 0x80, 0x0, user_data, error))
+		return NULL;
+
+	/* the DROM pointer, aligned down to a DWORD boundary for mailbox readers */
+	if (!func(buf + (FU_INTEL_THUNDERBOLT_NVM_DIGITAL_OFFSET_DROM & ~0x3u),
+		  0x8,
+		  FU_INTEL_THUNDERBOLT_NVM_DIGITAL_OFFSET_DROM & ~0x3u,
+		  user_data,
+		  error))
+		return NULL;
+	if (!fu_memread_uint32_safe(buf,
+				    bufsz,
+				    FU_INTEL_THUNDERBOLT_NVM_DIGITAL_OFFSET_DROM,
+				    &drom_offset,
+				    G_LITTLE_ENDIAN,
+				    error))
+		return NULL;
+
+	/* the DROM vendor and model fields; if the section lies outside the window then
+	 * fall back to reading everything after the digital section fields */
+	if (drom_offset % 4 == 0 &&
+	    drom_offset + FU_INTEL_THUNDERBOLT_NVM_DROM_SIZE <= bufsz) {
+		if (!func(buf + drom_offset,
+			  FU_INTEL_THUNDERBOLT_NVM_DROM_SIZE,
+			  drom_offset,
+			  user_data,
+			  error))
+			return NULL;
+	} else {
+		if (!func(buf + 0x80, bufsz - 0x80, 0x80, user_data, error))
+			return NULL;
+		return g_bytes_new_take(g_steal_pointer(&buf), bufsz);
+	}
+
+	/* the ARC params PD pointer, when it fits inside the window */
+	if (!fu_memread_uint32_safe(buf,
+				    bufsz,
+				    FU_INTEL_THUNDERBOLT_NVM_DIGITAL_OFFSET_ARC_PARAMS,
+				    &arc_params_offset,
+				    G_LITTLE_ENDIAN,
+				    error))
+		return NULL;
+	if (arc_params_offset % 4 == 0 && arc_params_offset > 0 &&
+	    arc_params_offset + FU_INTEL_THUNDERBOLT_NVM_ARC_PARAMS_OFFSET_PD_POINTER +
+		    sizeof(guint32) <=
+		bufsz) {
+		if (!func(buf + arc_params_offset +
+			      FU_INTEL_THUNDERBOLT_NVM_ARC_PARAMS_OFFSET_PD_POINTER,
+			  0x4,
+			  arc_params_offset +
+			      FU_INTEL_THUNDERBOLT_NVM_ARC_PARAMS_OFFSET_PD_POINTER,
+			  user_data,
+			  error))
+			return NULL;
+	}
+
+	/* success */
+	return g_bytes_new_take(g_steal_pointer(&buf), bufsz);
+}
+
 static void
 fu_intel_thunderbolt_nvm_export(FuFirmware *firmware,
 				FuFirmwareExportFlags flags,
@@ -22,6 +22,26 @@ struct _FuIntelThunderboltNvmClass {
 	FuFirmwareClass parent_class;
 };
 
+/**
+ * FuIntelThunderboltNvmReadFunc:
+ * @buf: (out): buffer to fill
+ * @bufsz: size of @buf, a DWORD multiple
+ * @offset: offset into the NVM in bytes, DWORD aligned
+ * @user_data: (closure): user data
+ * @error: (nullable): optional return location for an error
+ *
+ * The callback used to read a window of NVM data from the device.
+ *
+ * Returns: %TRUE on success
+ *
+ * Since: 2.0.3
+ */
+typedef gboolean (*FuIntelThunderboltNvmReadFunc)(guint8 *buf,
+						  gsize bufsz,
+						  gsize offset,
+						  gpointer user_data,
+						  GError **error) G_GNUC_WARN_UNUSED_RESULT;
+
 guint16
 fu_intel_thunderbolt_nvm_get_vendor_id(FuIntelThunderboltNvm *self) G_GNUC_NON_NULL(1);
 guint16
@@ -37,5 +57,12 @@ fu_intel_thunderbolt_nvm_has_pd(FuIntelThunderboltNvm *self) G_GNUC_NON_NULL(1);
 guint8
 fu_intel_thunderbolt_nvm_get_flash_size(FuIntelThunderboltNvm *self) G_GNUC_NON_NULL(1);
 
+GBytes *
+fu_intel_thunderbolt_nvm_read_windowed(gsize bufsz,
+				       FuIntelThunderboltNvmReadFunc func,
+				       gpointer user_data,
+				       GError **error) G_GNUC_WARN_UNUSED_RESULT
+    G_GNUC_NON_NULL(2);
+
 FuFirmware *
 fu_intel_thunderbolt_nvm_new(void);
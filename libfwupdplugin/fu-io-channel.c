@@ -12,6 +12,7 @@
 #include <fcntl.h>
 #include <gio/gio.h>
 #include <glib/gstdio.h>
+#include <limits.h>
 #ifdef HAVE_POLL_H
 #include <poll.h>
 #endif
@@ -20,6 +21,9 @@
 #ifdef HAVE_MEMFD_CREATE
 #include <sys/mman.h>
 #endif
+#ifdef HAVE_SYS_UIO_H
+#include <sys/uio.h>
+#endif
 
 #include "fwupd-error.h"
 
@@ -34,9 +38,16 @@
  * A bidirectional IO channel which can be read from and written to.
  */
 
+/* backoff for channels whose fd cannot be polled */
+#define FU_IO_CHANNEL_WAIT_BACKOFF_MIN 1  /* ms */
+#define FU_IO_CHANNEL_WAIT_BACKOFF_MAX 32 /* ms */
+
 struct _FuIOChannel {
 	GObject parent_instance;
 	gint fd;
+	guint wait_cnt;
+	gdouble wait_total_ms;
+	guint wait_backoff_ms;
 };
 
 G_DEFINE_TYPE(FuIOChannel, fu_io_channel, G_TYPE_OBJECT)
@@ -354,6 +365,164 @@ fu_io_channel_write_raw(FuIOChannel *self,
 	return TRUE;
 }
 
+/**
+ * fu_io_channel_writev:
+ * @self: a #FuIOChannel
+ * @blobs: (element-type GBytes): buffers to write in order
+ * @timeout_ms: timeout in ms
+ * @flags: channel flags, e.g. %FU_IO_CHANNEL_FLAG_SINGLE_SHOT
+ * @error: (nullable): optional return location for an error
+ *
+ * Writes multiple buffers to the TTY in one vectored syscall, which keeps a protocol header
+ * and its payload in the same write without copying them into a scratch buffer.
+ * This will fail if exceeding @timeout_ms.
+ *
+ * If the platform does not support writev() the buffers are written sequentially instead.
+ *
+ * Returns: %TRUE if all the bytes was written
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_io_channel_writev(FuIOChannel *self,
+		     GPtrArray *blobs,
+		     guint timeout_ms,
+		     FuIOChannelFlags flags,
+		     GError **error)
+{
+#ifdef HAVE_SYS_UIO_H
+	gsize idx = 0;
+	gsize total = 0;
+	guint iov_idx = 0;
+	g_autofree struct iovec *iov = NULL;
+#endif
+
+	g_return_val_if_fail(FU_IS_IO_CHANNEL(self), FALSE);
+	g_return_val_if_fail(blobs != NULL, FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+#ifdef HAVE_SYS_UIO_H
+	/* flush pending reads */
+	if (flags & FU_IO_CHANNEL_FLAG_FLUSH_INPUT) {
+		if (!fu_io_channel_flush_input(self, error))
+			return FALSE;
+	}
+
+	/* build the vector once, then advance it over partial writes */
+	iov = g_new0(struct iovec, blobs->len);
+	for (guint i = 0; i < blobs->len; i++) {
+		GBytes *blob = g_ptr_array_index(blobs, i);
+		iov[i].iov_base = (void *)g_bytes_get_data(blob, NULL);
+		iov[i].iov_len = g_bytes_get_size(blob);
+		total += iov[i].iov_len;
+	}
+
+	/* blocking IO */
+	if (flags & FU_IO_CHANNEL_FLAG_USE_BLOCKING_IO) {
+		gssize wrote = writev(self->fd, iov, (gint)MIN(blobs->len, (guint)IOV_MAX));
+		if (wrote != (gssize)total) {
+			if (errno == EPROTO) {
+				g_set_error(error,
+					    FWUPD_ERROR,
+					    FWUPD_ERROR_NOT_FOUND,
+					    "failed to write: %s",
+					    g_strerror(errno));
+				return FALSE;
+			}
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_WRITE,
+				    "failed to write: "
+				    "wrote %" G_GSSIZE_FORMAT " of %" G_GSIZE_FORMAT,
+				    wrote,
+				    total);
+			return FALSE;
+		}
+		return TRUE;
+	}
+
+	/* nonblocking IO */
+	while (idx < total) {
+		gint rc;
+		GPollFD fds = {
+		    .fd = self->fd,
+		    .events = G_IO_OUT | G_IO_ERR,
+		};
+
+		/* wait for data to be allowed to write without blocking */
+		rc = g_poll(&fds, 1, (gint)timeout_ms);
+		if (rc == 0)
+			break;
+		if (rc < 0) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_READ,
+				    "failed to poll %i",
+				    self->fd);
+			return FALSE;
+		}
+
+		/* we can write data */
+		if (fds.revents & G_IO_OUT) {
+			gssize len = writev(self->fd,
+					    iov + iov_idx,
+					    (gint)MIN(blobs->len - iov_idx, (guint)IOV_MAX));
+			if (len < 0) {
+				if (errno == EAGAIN) {
+					g_debug("got EAGAIN, trying harder");
+					continue;
+				}
+				if (errno == EPROTO) {
+					g_set_error(error,
+						    FWUPD_ERROR,
+						    FWUPD_ERROR_NOT_FOUND,
+						    "failed to write: %s",
+						    g_strerror(errno));
+					return FALSE;
+				}
+				g_set_error(error,
+					    FWUPD_ERROR,
+					    FWUPD_ERROR_WRITE,
+					    "failed to write %" G_GSIZE_FORMAT " bytes to %i: %s",
+					    total,
+					    self->fd,
+					    g_strerror(errno));
+				return FALSE;
+			}
+			if (flags & FU_IO_CHANNEL_FLAG_SINGLE_SHOT)
+				break;
+			idx += len;
+
+			/* skip over the segments that were written in full, then trim the
+			 * segment that was only partially consumed */
+			while (iov_idx < blobs->len && (gsize)len >= iov[iov_idx].iov_len) {
+				len -= (gssize)iov[iov_idx].iov_len;
+				iov_idx++;
+			}
+			if (iov_idx < blobs->len && len > 0) {
+				iov[iov_idx].iov_base = (guint8 *)iov[iov_idx].iov_base + len;
+				iov[iov_idx].iov_len -= len;
+			}
+		}
+	}
+
+	return TRUE;
+#else
+	for (guint i = 0; i < blobs->len; i++) {
+		GBytes *blob = g_ptr_array_index(blobs, i);
+		FuIOChannelFlags flags_tmp = flags;
+
+		/* only flush before the first buffer so nothing between the header and the
+		 * payload is discarded */
+		if (i > 0)
+			flags_tmp &= ~FU_IO_CHANNEL_FLAG_FLUSH_INPUT;
+		if (!fu_io_channel_write_bytes(self, blob, timeout_ms, flags_tmp, error))
+			return FALSE;
+	}
+	return TRUE;
+#endif
+}
+
 /**
  * fu_io_channel_read_bytes:
  * @self: a #FuIOChannel
@@ -570,6 +739,121 @@ fu_io_channel_read_raw(FuIOChannel *self,
 	return TRUE;
 }
 
+/**
+ * fu_io_channel_wait_for_data:
+ * @self: a #FuIOChannel
+ * @timeout_ms: timeout in ms
+ * @error: (nullable): optional return location for an error
+ *
+ * Waits until the channel has data to read. Where the file descriptor signals
+ * readiness this is a single event-driven poll with no added latency; where it
+ * does not, the call sleeps with an exponentially increasing interval so a retry
+ * loop around it neither spins nor waits a fixed coarse period.
+ *
+ * The observed wait latencies are tracked per-channel, see
+ * fu_io_channel_get_mean_wait().
+ *
+ * Returns: %TRUE if data is waiting to be read
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_io_channel_wait_for_data(FuIOChannel *self, guint timeout_ms, GError **error)
+{
+	GPollFD fds = {
+	    .fd = self->fd,
+	    .events = G_IO_IN | G_IO_PRI | G_IO_ERR,
+	};
+	gint64 start = g_get_monotonic_time();
+
+	g_return_val_if_fail(FU_IS_IO_CHANNEL(self), FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	while (TRUE) {
+		gint64 elapsed_ms = (g_get_monotonic_time() - start) / 1000;
+		gint rc;
+
+		if (elapsed_ms >= timeout_ms) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_TIMED_OUT,
+				    "no data after %ums",
+				    timeout_ms);
+			return FALSE;
+		}
+		rc = g_poll(&fds, 1, (gint)(timeout_ms - elapsed_ms));
+		if (rc < 0) {
+			if (errno == EINTR)
+				continue;
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_READ,
+				    "failed to poll %i",
+				    self->fd);
+			return FALSE;
+		}
+		if (rc == 0) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_TIMED_OUT,
+				    "no data after %ums",
+				    timeout_ms);
+			return FALSE;
+		}
+		if (fds.revents & G_IO_NVAL) {
+			/* the fd cannot signal readiness; back off and let the caller
+			 * attempt the read, sleeping longer on each call until reset by
+			 * a successful event-driven wait */
+			g_usleep((gulong)self->wait_backoff_ms * 1000);
+			if (self->wait_backoff_ms < FU_IO_CHANNEL_WAIT_BACKOFF_MAX)
+				self->wait_backoff_ms *= 2;
+			return TRUE;
+		}
+		if (fds.revents & (G_IO_IN | G_IO_PRI))
+			break;
+		if (fds.revents & G_IO_HUP) {
+			g_set_error_literal(error,
+					    FWUPD_ERROR,
+					    FWUPD_ERROR_READ,
+					    "connection hung up");
+			return FALSE;
+		}
+		if (fds.revents & G_IO_ERR) {
+			g_set_error_literal(error,
+					    FWUPD_ERROR,
+					    FWUPD_ERROR_READ,
+					    "error condition");
+			return FALSE;
+		}
+	}
+
+	/* success */
+	self->wait_backoff_ms = FU_IO_CHANNEL_WAIT_BACKOFF_MIN;
+	self->wait_cnt += 1;
+	self->wait_total_ms += (gdouble)(g_get_monotonic_time() - start) / 1000.f;
+	return TRUE;
+}
+
+/**
+ * fu_io_channel_get_mean_wait:
+ * @self: a #FuIOChannel
+ *
+ * Gets the mean time spent waiting for data in fu_io_channel_wait_for_data(),
+ * which is useful when choosing protocol timeouts for heterogeneous hardware.
+ *
+ * Returns: mean wait in ms, or 0 if nothing has been waited for
+ *
+ * Since: 2.0.3
+ **/
+gdouble
+fu_io_channel_get_mean_wait(FuIOChannel *self)
+{
+	g_return_val_if_fail(FU_IS_IO_CHANNEL(self), 0.f);
+	if (self->wait_cnt == 0)
+		return 0.f;
+	return self->wait_total_ms / self->wait_cnt;
+}
+
 static void
 fu_io_channel_finalize(GObject *object)
 {
@@ -590,6 +874,7 @@ static void
 fu_io_channel_init(FuIOChannel *self)
 {
 	self->fd = -1;
+	self->wait_backoff_ms = FU_IO_CHANNEL_WAIT_BACKOFF_MIN;
 }
 
 /**
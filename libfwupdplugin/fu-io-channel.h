@@ -78,6 +78,12 @@ fu_io_channel_write_stream(FuIOChannel *self,
 			   FuIOChannelFlags flags,
 			   GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
 gboolean
+fu_io_channel_writev(FuIOChannel *self,
+		     GPtrArray *blobs,
+		     guint timeout_ms,
+		     FuIOChannelFlags flags,
+		     GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
+gboolean
 fu_io_channel_write_byte_array(FuIOChannel *self,
 			       GByteArray *buf,
 			       guint timeout_ms,
@@ -95,3 +101,9 @@ fu_io_channel_read_byte_array(FuIOChannel *self,
 			      guint timeout_ms,
 			      FuIOChannelFlags flags,
 			      GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
+gboolean
+fu_io_channel_wait_for_data(FuIOChannel *self,
+			    guint timeout_ms,
+			    GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
+gdouble
+fu_io_channel_get_mean_wait(FuIOChannel *self) G_GNUC_NON_NULL(1);
@@ -16,6 +16,7 @@ struct _FuIoctl {
 	FuUdevDevice *udev_device; /* ref */
 	GString *event_id;
 	GPtrArray *fixups; /* of FuIoctlFixup */
+	GPtrArray *bufs;   /* of FuIoctlBuffer */
 };
 
 G_DEFINE_TYPE(FuIoctl, fu_ioctl, G_TYPE_OBJECT)
@@ -28,6 +29,12 @@ typedef struct {
 	FuIoctlFixupFunc fixup_cb;
 } FuIoctlFixup;
 
+typedef struct {
+	gchar *key;
+	const guint8 *buf;
+	gsize bufsz;
+} FuIoctlBuffer;
+
 static void
 fu_ioctl_fixup_free(FuIoctlFixup *fixup)
 {
@@ -35,6 +42,13 @@ fu_ioctl_fixup_free(FuIoctlFixup *fixup)
 	g_free(fixup);
 }
 
+static void
+fu_ioctl_buffer_free(FuIoctlBuffer *ioctl_buf)
+{
+	g_free(ioctl_buf->key);
+	g_free(ioctl_buf);
+}
+
 static gchar *
 fu_ioctl_fixup_build_key(FuIoctlFixup *fixup, const gchar *suffix)
 {
@@ -150,7 +164,14 @@ fu_ioctl_add_buffer(FuIoctl *self,
 		    gboolean is_mutable,
 		    FuIoctlFixupFunc fixup_cb)
 {
-	fu_ioctl_append_key_from_buf(self->event_id, key, buf, bufsz);
+	FuIoctlBuffer *ioctl_buf = g_new0(FuIoctlBuffer, 1);
+
+	/* defer the base64 encode until we know an emulation event is actually needed */
+	ioctl_buf->key = g_strdup(key);
+	ioctl_buf->buf = buf;
+	ioctl_buf->bufsz = bufsz;
+	g_ptr_array_add(self->bufs, ioctl_buf);
+
 	if (fixup_cb != NULL) {
 		FuIoctlFixup *fixup = g_new0(FuIoctlFixup, 1);
 		fixup->key = g_strdup(key);
@@ -247,6 +268,13 @@ fu_ioctl_execute(FuIoctl *self,
 	    fu_context_has_flag(fu_device_get_context(FU_DEVICE(self->udev_device)),
 				FU_CONTEXT_FLAG_SAVE_EVENTS)) {
 		event_id = g_string_new(self->event_id->str);
+		for (guint i = 0; i < self->bufs->len; i++) {
+			FuIoctlBuffer *ioctl_buf = g_ptr_array_index(self->bufs, i);
+			fu_ioctl_append_key_from_buf(event_id,
+						     ioctl_buf->key,
+						     ioctl_buf->buf,
+						     ioctl_buf->bufsz);
+		}
 		if (g_strcmp0(event_id->str, "Ioctl:") == 0) {
 			fu_ioctl_append_key_as_u16(event_id, "Request", request);
 			fu_ioctl_append_key_from_buf(event_id, NULL, buf, bufsz);
@@ -331,6 +359,7 @@ fu_ioctl_init(FuIoctl *self)
 {
 	self->event_id = g_string_new("Ioctl:");
 	self->fixups = g_ptr_array_new_with_free_func((GDestroyNotify)fu_ioctl_fixup_free);
+	self->bufs = g_ptr_array_new_with_free_func((GDestroyNotify)fu_ioctl_buffer_free);
 }
 
 static void
@@ -340,6 +369,7 @@ fu_ioctl_finalize(GObject *object)
 
 	g_string_free(self->event_id, TRUE);
 	g_ptr_array_unref(self->fixups);
+	g_ptr_array_unref(self->bufs);
 	if (self->udev_device != NULL)
 		g_object_unref(self->udev_device);
 
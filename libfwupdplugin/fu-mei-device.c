@@ -495,6 +495,124 @@ fu_mei_device_write(FuMeiDevice *self,
 #endif
 }
 
+/**
+ * fu_mei_device_batch_execute:
+ * @self: a #FuMeiDevice
+ * @bufs_req: (element-type GByteArray): request buffers
+ * @bufs_res: (element-type GByteArray): response buffers, pre-sized to the expected length
+ * @timeout_ms: per-command timeout
+ * @error: (nullable): optional return location for an error
+ *
+ * Writes all the requests back-to-back, then reads each response in submission order.
+ * The device processes commands sequentially and so the kernel round-trip latency is only
+ * paid once for the whole batch rather than once per command.
+ *
+ * Each response gets its own @timeout_ms budget, and each buffer in @bufs_res is truncated
+ * to the number of bytes actually read.
+ *
+ * Returns: %TRUE for success
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_mei_device_batch_execute(FuMeiDevice *self,
+			    GPtrArray *bufs_req,
+			    GPtrArray *bufs_res,
+			    guint timeout_ms,
+			    GError **error)
+{
+#ifdef HAVE_SELECT_H
+	FuIOChannel *io_channel = fu_udev_device_get_io_channel(FU_UDEV_DEVICE(self));
+	guint fd = fu_io_channel_unix_get_fd(io_channel);
+
+	g_return_val_if_fail(FU_IS_MEI_DEVICE(self), FALSE);
+	g_return_val_if_fail(bufs_req != NULL, FALSE);
+	g_return_val_if_fail(bufs_res != NULL, FALSE);
+	g_return_val_if_fail(bufs_req->len == bufs_res->len, FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	/* pipeline all the requests without waiting for the responses */
+	for (guint i = 0; i < bufs_req->len; i++) {
+		GByteArray *buf_req = g_ptr_array_index(bufs_req, i);
+		gssize written;
+
+		fu_dump_raw(G_LOG_DOMAIN, "write", buf_req->data, buf_req->len);
+		written = write(fd, buf_req->data, buf_req->len);
+		if (written < 0) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_WRITE,
+				    "write of command %u failed: %s",
+				    i,
+				    g_strerror(errno));
+			return FALSE;
+		}
+		if ((gsize)written != buf_req->len) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_WRITE,
+				    "only wrote %" G_GSSIZE_FORMAT " of %u for command %u",
+				    written,
+				    buf_req->len,
+				    i);
+			return FALSE;
+		}
+	}
+
+	/* read each response in submission order */
+	for (guint i = 0; i < bufs_res->len; i++) {
+		GByteArray *buf_res = g_ptr_array_index(bufs_res, i);
+		struct timeval tv;
+		gssize rc;
+		fd_set set;
+
+		tv.tv_sec = timeout_ms / 1000;
+		tv.tv_usec = (timeout_ms % 1000) * 1000;
+		FD_ZERO(&set);
+		FD_SET(fd, &set);
+		rc = select(fd + 1, &set, NULL, NULL, &tv);
+		if (rc == 0) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_READ,
+				    "timed out waiting for response %u",
+				    i);
+			return FALSE;
+		}
+		if (rc < 0) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_READ,
+				    "select failed for response %u with status %" G_GSSIZE_FORMAT,
+				    i,
+				    rc);
+			return FALSE;
+		}
+		rc = read(fd, buf_res->data, buf_res->len);
+		if (rc < 0) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_READ,
+				    "read of response %u failed: %s",
+				    i,
+				    g_strerror(errno));
+			return FALSE;
+		}
+		fu_dump_raw(G_LOG_DOMAIN, "read", buf_res->data, rc);
+		g_byte_array_set_size(buf_res, (guint)rc);
+	}
+
+	/* success */
+	return TRUE;
+#else
+	g_set_error_literal(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_NOT_SUPPORTED,
+			    "linux/select.h not supported");
+	return FALSE;
+#endif
+}
+
 static void
 fu_mei_device_incorporate(FuDevice *device, FuDevice *donor)
 {
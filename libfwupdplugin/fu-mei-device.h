@@ -31,6 +31,12 @@ fu_mei_device_write(FuMeiDevice *self,
 		    gsize bufsz,
 		    guint timeout_ms,
 		    GError **error) G_GNUC_NON_NULL(1);
+gboolean
+fu_mei_device_batch_execute(FuMeiDevice *self,
+			    GPtrArray *bufs_req,
+			    GPtrArray *bufs_res,
+			    guint timeout_ms,
+			    GError **error) G_GNUC_NON_NULL(1, 2, 3);
 guint
 fu_mei_device_get_max_msg_length(FuMeiDevice *self) G_GNUC_NON_NULL(1);
 guint8
@@ -14,3 +14,5 @@ gboolean
 fu_memchk_read(gsize bufsz, gsize offset, gsize n, GError **error);
 gboolean
 fu_memchk_write(gsize bufsz, gsize offset, gsize n, GError **error);
+void
+fu_memadvise_sequential(const guint8 *buf, gsize bufsz);
@@ -8,11 +8,151 @@
 
 #include "config.h"
 
+#ifdef HAVE_MALLINFO2
+#include <malloc.h>
+#endif
+#ifdef HAVE_MADVISE
+#include <errno.h>
+#include <sys/mman.h>
+#endif
+
 #include "fwupd-error.h"
 
 #include "fu-mem-private.h"
 #include "fu-string.h"
 
+struct _FuMemTracker {
+	gchar *id;
+	gsize heapsz_start;
+};
+
+static gsize
+fu_mem_tracker_get_heapsz(void)
+{
+#ifdef HAVE_MALLINFO2
+	struct mallinfo2 mi = mallinfo2();
+	return (gsize)mi.uordblks + (gsize)mi.hblkhd;
+#else
+	return 0;
+#endif
+}
+
+/**
+ * fu_mem_tracker_new:
+ * @id: scope identifier, e.g. %G_STRLOC
+ *
+ * Creates a tracker that records the heap usage at the start of a named scope so that
+ * the bytes allocated by a hot operation can be checked against a declared budget.
+ *
+ * The usage is sampled using the C library allocator statistics, so only allocations
+ * made by the calling process are counted, and a freed buffer no longer contributes.
+ * On a C library without mallinfo2() the usage is always reported as zero.
+ *
+ * Returns: (transfer full): a #FuMemTracker
+ *
+ * Since: 2.0.3
+ **/
+FuMemTracker *
+fu_mem_tracker_new(const gchar *id)
+{
+	FuMemTracker *self;
+
+	g_return_val_if_fail(id != NULL, NULL);
+
+	self = g_new0(FuMemTracker, 1);
+	self->id = g_strdup(id);
+	self->heapsz_start = fu_mem_tracker_get_heapsz();
+	return self;
+}
+
+/**
+ * fu_mem_tracker_get_usage:
+ * @self: a #FuMemTracker
+ *
+ * Gets the number of heap bytes allocated since the tracker was created, not counting
+ * anything that has already been freed.
+ *
+ * Returns: number of bytes, or 0 if unsupported
+ *
+ * Since: 2.0.3
+ **/
+gsize
+fu_mem_tracker_get_usage(FuMemTracker *self)
+{
+	gsize heapsz = fu_mem_tracker_get_heapsz();
+
+	g_return_val_if_fail(self != NULL, 0);
+
+	if (heapsz < self->heapsz_start)
+		return 0;
+	return heapsz - self->heapsz_start;
+}
+
+/**
+ * fu_mem_tracker_check:
+ * @self: a #FuMemTracker
+ * @budget: maximum number of heap bytes the scope is allowed to keep allocated
+ * @error: (nullable): optional return location for an error
+ *
+ * Checks the heap usage of the scope against a declared allocation budget, which allows
+ * self tests to fail when a hot operation starts allocating per-chunk or per-event data.
+ *
+ * On a C library without mallinfo2() this always succeeds.
+ *
+ * Returns: %TRUE if within budget
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_mem_tracker_check(FuMemTracker *self, gsize budget, GError **error)
+{
+#ifdef HAVE_MALLINFO2
+	gsize usage;
+#endif
+
+	g_return_val_if_fail(self != NULL, FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+#ifndef HAVE_MALLINFO2
+	g_debug("allocation tracking not supported, assuming %s is within budget", self->id);
+	return TRUE;
+#else
+	usage = fu_mem_tracker_get_usage(self);
+	if (usage > budget) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INTERNAL,
+			    "%s allocated %" G_GSIZE_FORMAT " bytes, "
+			    "more than the budget of %" G_GSIZE_FORMAT " bytes",
+			    self->id,
+			    usage,
+			    budget);
+		return FALSE;
+	}
+	g_debug("%s allocated %" G_GSIZE_FORMAT " of %" G_GSIZE_FORMAT " bytes",
+		self->id,
+		usage,
+		budget);
+	return TRUE;
+#endif
+}
+
+/**
+ * fu_mem_tracker_free:
+ * @self: a #FuMemTracker
+ *
+ * Frees the tracker.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_mem_tracker_free(FuMemTracker *self)
+{
+	g_return_if_fail(self != NULL);
+	g_free(self->id);
+	g_free(self);
+}
+
 /**
  * fu_memwrite_uint16:
  * @buf: a writable buffer
@@ -973,3 +1113,34 @@ fu_memstrsafe(const guint8 *buf, gsize bufsz, gsize offset, gsize maxsz, GError
 	}
 	return g_steal_pointer(&str);
 }
+
+/*
+ * fu_memadvise_sequential:
+ * @buf: a page-aligned memory-mapped buffer
+ * @bufsz: size of @buf in bytes
+ *
+ * Tells the kernel that @buf is going to be read front-to-back, typically for a checksum or
+ * verify pass, so that it can read ahead aggressively -- and for large mappings asks for
+ * transparent huge pages to reduce TLB pressure.
+ *
+ * Hints are best-effort and any failure is only logged.
+ */
+void
+fu_memadvise_sequential(const guint8 *buf, gsize bufsz)
+{
+#ifdef HAVE_MADVISE
+	g_return_if_fail(buf != NULL);
+
+	if (bufsz == 0)
+		return;
+	if (madvise((void *)buf, bufsz, MADV_SEQUENTIAL) != 0)
+		g_debug("failed to advise MADV_SEQUENTIAL: %s", g_strerror(errno));
+#ifdef MADV_HUGEPAGE
+	/* only worth promoting to huge pages when there is at least one 2MB extent */
+	if (bufsz >= 0x200000) {
+		if (madvise((void *)buf, bufsz, MADV_HUGEPAGE) != 0)
+			g_debug("failed to advise MADV_HUGEPAGE: %s", g_strerror(errno));
+	}
+#endif
+#endif
+}
@@ -113,3 +113,16 @@ fu_memread_uint64(const guint8 *buf, FuEndianType endian) G_GNUC_NON_NULL(1);
 gchar *
 fu_memstrsafe(const guint8 *buf, gsize bufsz, gsize offset, gsize maxsz, GError **error)
     G_GNUC_NON_NULL(1);
+
+typedef struct _FuMemTracker FuMemTracker;
+
+FuMemTracker *
+fu_mem_tracker_new(const gchar *id) G_GNUC_NON_NULL(1);
+gsize
+fu_mem_tracker_get_usage(FuMemTracker *self) G_GNUC_NON_NULL(1);
+gboolean
+fu_mem_tracker_check(FuMemTracker *self, gsize budget, GError **error) G_GNUC_WARN_UNUSED_RESULT
+    G_GNUC_NON_NULL(1);
+void
+fu_mem_tracker_free(FuMemTracker *self) G_GNUC_NON_NULL(1);
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(FuMemTracker, fu_mem_tracker_free)
@@ -10,5 +10,7 @@
 
 gboolean
 fu_msgpack_item_append(FuMsgpackItem *self, GByteArray *buf, GError **error) G_GNUC_NON_NULL(1, 2);
+gsize
+fu_msgpack_item_get_size_max(FuMsgpackItem *self) G_GNUC_NON_NULL(1);
 FuMsgpackItem *
 fu_msgpack_item_parse(GByteArray *buf, gsize *offset, GError **error) G_GNUC_NON_NULL(1, 2);
@@ -538,6 +538,29 @@ fu_msgpack_item_append_binary(GByteArray *buf, GByteArray *donor, GError **error
 	return FALSE;
 }
 
+/* private */
+gsize
+fu_msgpack_item_get_size_max(FuMsgpackItem *self)
+{
+	/* the largest header of any encoding is the command byte plus a 64-bit value */
+	const gsize hdrsz_max = sizeof(guint8) + sizeof(guint64);
+
+	g_return_val_if_fail(FU_IS_MSGPACK_ITEM(self), 0);
+
+	if (self->kind == FU_MSGPACK_ITEM_KIND_STRING)
+		return hdrsz_max + self->value.str->len;
+	if (self->kind == FU_MSGPACK_ITEM_KIND_BINARY) {
+		if (self->stream != NULL) {
+			gsize streamsz = 0;
+			if (!fu_input_stream_size(self->stream, &streamsz, NULL))
+				return hdrsz_max;
+			return hdrsz_max + streamsz;
+		}
+		return hdrsz_max + self->value.buf->len;
+	}
+	return hdrsz_max;
+}
+
 /* private */
 gboolean
 fu_msgpack_item_append(FuMsgpackItem *self, GByteArray *buf, GError **error)
@@ -44,6 +44,49 @@ fu_msgpack_parse(GByteArray *buf, GError **error)
 	return g_steal_pointer(&items);
 }
 
+/**
+ * fu_msgpack_write_buf:
+ * @items: (element-type FuMsgpackItem): items
+ * @buf: a #GByteArray
+ * @error: (nullable): optional return location for an error
+ *
+ * Writes messagepack items into an existing buffer, replacing any previous contents.
+ *
+ * The buffer is grown to the worst-case encoded size in one step, and the allocation is
+ * retained between calls -- so encoding many messages of a similar size into the same
+ * scratch buffer needs no allocations at all in the steady state.
+ *
+ * Returns: %TRUE for success
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_msgpack_write_buf(GPtrArray *items, GByteArray *buf, GError **error)
+{
+	gsize bufsz_max = 0;
+
+	g_return_val_if_fail(items != NULL, FALSE);
+	g_return_val_if_fail(buf != NULL, FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	/* reserve enough space for the worst case in a single allocation */
+	for (guint i = 0; i < items->len; i++) {
+		FuMsgpackItem *item = g_ptr_array_index(items, i);
+		bufsz_max += fu_msgpack_item_get_size_max(item);
+	}
+	g_byte_array_set_size(buf, bufsz_max);
+	g_byte_array_set_size(buf, 0);
+
+	for (guint i = 0; i < items->len; i++) {
+		FuMsgpackItem *item = g_ptr_array_index(items, i);
+		if (!fu_msgpack_item_append(item, buf, error))
+			return FALSE;
+	}
+
+	/* success */
+	return TRUE;
+}
+
 /**
  * fu_msgpack_write:
  * @items: (element-type FuMsgpackItem): items
@@ -63,11 +106,8 @@ fu_msgpack_write(GPtrArray *items, GError **error)
 	g_return_val_if_fail(items != NULL, NULL);
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
-	for (guint i = 0; i < items->len; i++) {
-		FuMsgpackItem *item = g_ptr_array_index(items, i);
-		if (!fu_msgpack_item_append(item, buf, error))
-			return NULL;
-	}
+	if (!fu_msgpack_write_buf(items, buf, error))
+		return NULL;
 
 	/* success */
 	return g_steal_pointer(&buf);
@@ -14,6 +14,8 @@ GPtrArray *
 fu_msgpack_parse(GByteArray *buf, GError **error) G_GNUC_NON_NULL(1);
 GByteArray *
 fu_msgpack_write(GPtrArray *items, GError **error) G_GNUC_NON_NULL(1);
+gboolean
+fu_msgpack_write_buf(GPtrArray *items, GByteArray *buf, GError **error) G_GNUC_NON_NULL(1, 2);
 FuMsgpackItem *
 fu_msgpack_map_lookup(GPtrArray *items, guint idx, const gchar *key, GError **error)
     G_GNUC_NON_NULL(1, 3);
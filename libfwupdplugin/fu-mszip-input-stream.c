@@ -0,0 +1,433 @@
+/*
+ * Copyright 2025 Richard Hughes <richard@hughsie.com>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#define G_LOG_DOMAIN "FuMszipInputStream"
+
+#include "config.h"
+
+#include <string.h>
+#include <zlib.h>
+
+#include "fwupd-codec.h"
+
+#include "fu-input-stream.h"
+#include "fu-mszip-input-stream.h"
+
+/**
+ * FuMszipInputStream:
+ *
+ * A input stream that decompresses MSZIP blocks from a donor stream on demand,
+ * rather than inflating the entire folder up-front.
+ *
+ * MSZIP blocks have to be inflated in order as each block uses the previous
+ * uncompressed block as the deflate dictionary, so only the most recent block
+ * is cached; seeking backwards restarts decompression from the first block.
+ */
+
+typedef struct {
+	gsize offset; /* of the compressed payload in the base stream */
+	gsize comp_sz;
+	gsize uncomp_sz;
+	gsize global_offset; /* in the uncompressed folder */
+} FuMszipInputStreamBlock;
+
+struct _FuMszipInputStream {
+	GInputStream parent_instance;
+	GInputStream *base_stream;
+	GPtrArray *blocks; /* of FuMszipInputStreamBlock */
+	gsize base_sz;
+	gsize total_size;
+	goffset pos;
+	z_stream zstrm;
+	guint block_idx;     /* next block to inflate */
+	GByteArray *buf_cur; /* uncompressed data for block_idx - 1 */
+};
+
+static void
+fu_mszip_input_stream_seekable_iface_init(GSeekableIface *iface);
+static void
+fu_mszip_input_stream_codec_iface_init(FwupdCodecInterface *iface);
+
+G_DEFINE_TYPE_WITH_CODE(FuMszipInputStream,
+			fu_mszip_input_stream,
+			G_TYPE_INPUT_STREAM,
+			G_IMPLEMENT_INTERFACE(G_TYPE_SEEKABLE,
+					      fu_mszip_input_stream_seekable_iface_init)
+			    G_IMPLEMENT_INTERFACE(FWUPD_TYPE_CODEC,
+						  fu_mszip_input_stream_codec_iface_init))
+
+static void
+fu_mszip_input_stream_add_string(FwupdCodec *codec, guint idt, GString *str)
+{
+	FuMszipInputStream *self = FU_MSZIP_INPUT_STREAM(codec);
+	fwupd_codec_string_append_hex(str, idt, "Pos", self->pos);
+	fwupd_codec_string_append_hex(str, idt, "TotalSize", self->total_size);
+	fwupd_codec_string_append_hex(str, idt, "Blocks", self->blocks->len);
+	fwupd_codec_string_append_hex(str, idt, "BlockIdx", self->block_idx);
+}
+
+static void
+fu_mszip_input_stream_codec_iface_init(FwupdCodecInterface *iface)
+{
+	iface->add_string = fu_mszip_input_stream_add_string;
+}
+
+static voidpf
+fu_mszip_input_stream_zalloc(voidpf opaque, uInt items, uInt size)
+{
+	return g_malloc0_n(items, size);
+}
+
+static void
+fu_mszip_input_stream_zfree(voidpf opaque, voidpf address)
+{
+	g_free(address);
+}
+
+/**
+ * fu_mszip_input_stream_add_block:
+ * @self: a #FuMszipInputStream
+ * @offset: offset of the compressed payload in the donor stream, including the CK signature
+ * @comp_sz: size of the compressed payload in bytes
+ * @uncomp_sz: size of the uncompressed data in bytes
+ * @error: (nullable): optional return location for an error
+ *
+ * Adds a MSZIP block, which is decompressed when the stream offset is first read.
+ *
+ * Returns: %TRUE for success
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_mszip_input_stream_add_block(FuMszipInputStream *self,
+				gsize offset,
+				gsize comp_sz,
+				gsize uncomp_sz,
+				GError **error)
+{
+	FuMszipInputStreamBlock *block;
+
+	g_return_val_if_fail(FU_IS_MSZIP_INPUT_STREAM(self), FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	/* sanity check */
+	if (offset + comp_sz > self->base_sz) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_DATA,
+			    "base stream was 0x%x bytes in size, and tried to add "
+			    "block @0x%x of 0x%x bytes",
+			    (guint)self->base_sz,
+			    (guint)offset,
+			    (guint)comp_sz);
+		return FALSE;
+	}
+
+	block = g_new0(FuMszipInputStreamBlock, 1);
+	block->offset = offset;
+	block->comp_sz = comp_sz;
+	block->uncomp_sz = uncomp_sz;
+	block->global_offset = self->total_size;
+	self->total_size += uncomp_sz;
+	g_ptr_array_add(self->blocks, block);
+
+	/* success */
+	return TRUE;
+}
+
+/* inflate the block at self->block_idx, leaving the deflate dictionary primed
+ * for the block that follows */
+static gboolean
+fu_mszip_input_stream_inflate_next(FuMszipInputStream *self,
+				   GCancellable *cancellable,
+				   GError **error)
+{
+	FuMszipInputStreamBlock *block = g_ptr_array_index(self->blocks, self->block_idx);
+	int zret;
+	g_autoptr(GByteArray) buf = g_byte_array_new();
+	g_autoptr(GBytes) bytes_comp = NULL;
+
+	/* read the compressed payload, checking the signature */
+	bytes_comp = fu_input_stream_read_bytes(self->base_stream,
+						block->offset,
+						block->comp_sz,
+						cancellable,
+						error);
+	if (bytes_comp == NULL)
+		return FALSE;
+	if (g_bytes_get_size(bytes_comp) < 2 ||
+	    memcmp(g_bytes_get_data(bytes_comp, NULL), "CK", 2) != 0) {
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INVALID_DATA,
+				    "compressed header invalid");
+		return FALSE;
+	}
+
+	/* inflate into a buffer of the declared size */
+	g_byte_array_set_size(buf, block->uncomp_sz);
+	self->zstrm.avail_in = g_bytes_get_size(bytes_comp) - 2;
+	self->zstrm.next_in = (z_const Bytef *)g_bytes_get_data(bytes_comp, NULL) + 2;
+	self->zstrm.avail_out = buf->len;
+	self->zstrm.next_out = buf->data;
+	while (1) {
+		uInt avail_in_old = self->zstrm.avail_in;
+		uInt avail_out_old = self->zstrm.avail_out;
+		zret = inflate(&self->zstrm, Z_BLOCK);
+		if (zret == Z_STREAM_END)
+			break;
+		if (zret != Z_OK) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INVALID_DATA,
+				    "inflate error @0x%x: %s",
+				    (guint)block->offset,
+				    zError(zret));
+			return FALSE;
+		}
+		if (self->zstrm.avail_in == avail_in_old &&
+		    self->zstrm.avail_out == avail_out_old) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INVALID_DATA,
+				    "inflate made no progress @0x%x",
+				    (guint)block->offset);
+			return FALSE;
+		}
+	}
+	if (buf->len - self->zstrm.avail_out != block->uncomp_sz) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_DATA,
+			    "expected 0x%x bytes of uncompressed data, got 0x%x",
+			    (guint)block->uncomp_sz,
+			    (guint)(buf->len - self->zstrm.avail_out));
+		return FALSE;
+	}
+
+	/* the next block uses this one as the dictionary */
+	zret = inflateReset(&self->zstrm);
+	if (zret != Z_OK) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_DATA,
+			    "failed to reset inflate: %s",
+			    zError(zret));
+		return FALSE;
+	}
+	zret = inflateSetDictionary(&self->zstrm, buf->data, buf->len);
+	if (zret != Z_OK) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_DATA,
+			    "failed to set inflate dictionary: %s",
+			    zError(zret));
+		return FALSE;
+	}
+
+	/* only the most recent block is cached */
+	g_byte_array_unref(self->buf_cur);
+	self->buf_cur = g_steal_pointer(&buf);
+	self->block_idx++;
+
+	/* success */
+	return TRUE;
+}
+
+static gssize
+fu_mszip_input_stream_read(GInputStream *stream,
+			   void *buffer,
+			   gsize count,
+			   GCancellable *cancellable,
+			   GError **error)
+{
+	FuMszipInputStream *self = FU_MSZIP_INPUT_STREAM(stream);
+	FuMszipInputStreamBlock *block = NULL;
+	gsize block_off;
+	guint idx = G_MAXUINT;
+
+	g_return_val_if_fail(FU_IS_MSZIP_INPUT_STREAM(self), -1);
+	g_return_val_if_fail(error == NULL || *error == NULL, -1);
+
+	/* end of stream */
+	if (self->pos < 0 || (gsize)self->pos >= self->total_size)
+		return 0;
+
+	/* find the block that contains the position */
+	for (guint i = 0; i < self->blocks->len; i++) {
+		FuMszipInputStreamBlock *block_tmp = g_ptr_array_index(self->blocks, i);
+		if ((gsize)self->pos < block_tmp->global_offset + block_tmp->uncomp_sz) {
+			block = block_tmp;
+			idx = i;
+			break;
+		}
+	}
+	if (block == NULL)
+		return 0;
+
+	/* seeking backwards restarts decompression from the first block */
+	if (idx + 1 < self->block_idx) {
+		int zret = inflateReset(&self->zstrm);
+		if (zret != Z_OK) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INVALID_DATA,
+				    "failed to reset inflate: %s",
+				    zError(zret));
+			return -1;
+		}
+		self->block_idx = 0;
+	}
+	while (self->block_idx <= idx) {
+		if (!fu_mszip_input_stream_inflate_next(self, cancellable, error))
+			return -1;
+	}
+
+	/* copy out of the cached block */
+	block_off = (gsize)self->pos - block->global_offset;
+	count = MIN(count, self->buf_cur->len - block_off);
+	memcpy(buffer, self->buf_cur->data + block_off, count); /* nocheck:blocked */
+	self->pos += count;
+	return count;
+}
+
+static goffset
+fu_mszip_input_stream_tell(GSeekable *seekable)
+{
+	FuMszipInputStream *self = FU_MSZIP_INPUT_STREAM(seekable);
+	g_return_val_if_fail(FU_IS_MSZIP_INPUT_STREAM(self), -1);
+	return self->pos;
+}
+
+static gboolean
+fu_mszip_input_stream_can_seek(GSeekable *seekable)
+{
+	return TRUE;
+}
+
+static gboolean
+fu_mszip_input_stream_seek(GSeekable *seekable,
+			   goffset offset,
+			   GSeekType type,
+			   GCancellable *cancellable,
+			   GError **error)
+{
+	FuMszipInputStream *self = FU_MSZIP_INPUT_STREAM(seekable);
+
+	g_return_val_if_fail(FU_IS_MSZIP_INPUT_STREAM(self), FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	if (type == G_SEEK_CUR) {
+		self->pos += offset;
+	} else if (type == G_SEEK_END) {
+		self->pos = self->total_size + offset;
+	} else {
+		self->pos = offset;
+	}
+	return TRUE;
+}
+
+static gboolean
+fu_mszip_input_stream_can_truncate(GSeekable *seekable)
+{
+	return FALSE;
+}
+
+static gboolean
+fu_mszip_input_stream_truncate(GSeekable *seekable,
+			       goffset offset,
+			       GCancellable *cancellable,
+			       GError **error)
+{
+	g_set_error_literal(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_NOT_SUPPORTED,
+			    "cannot truncate FuMszipInputStream");
+	return FALSE;
+}
+
+static void
+fu_mszip_input_stream_seekable_iface_init(GSeekableIface *iface)
+{
+	iface->tell = fu_mszip_input_stream_tell;
+	iface->can_seek = fu_mszip_input_stream_can_seek;
+	iface->seek = fu_mszip_input_stream_seek;
+	iface->can_truncate = fu_mszip_input_stream_can_truncate;
+	iface->truncate_fn = fu_mszip_input_stream_truncate;
+}
+
+static void
+fu_mszip_input_stream_finalize(GObject *object)
+{
+	FuMszipInputStream *self = FU_MSZIP_INPUT_STREAM(object);
+	inflateEnd(&self->zstrm);
+	if (self->base_stream != NULL)
+		g_object_unref(self->base_stream);
+	g_ptr_array_unref(self->blocks);
+	g_byte_array_unref(self->buf_cur);
+	G_OBJECT_CLASS(fu_mszip_input_stream_parent_class)->finalize(object);
+}
+
+static void
+fu_mszip_input_stream_class_init(FuMszipInputStreamClass *klass)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS(klass);
+	GInputStreamClass *istream_class = G_INPUT_STREAM_CLASS(klass);
+	istream_class->read_fn = fu_mszip_input_stream_read;
+	object_class->finalize = fu_mszip_input_stream_finalize;
+}
+
+static void
+fu_mszip_input_stream_init(FuMszipInputStream *self)
+{
+	self->blocks = g_ptr_array_new_with_free_func(g_free);
+	self->buf_cur = g_byte_array_new();
+}
+
+/**
+ * fu_mszip_input_stream_new:
+ * @base_stream: the donor #GInputStream, typically the cabinet archive
+ * @error: (nullable): optional return location for an error
+ *
+ * Creates a stream that lazily decompresses MSZIP blocks added with
+ * fu_mszip_input_stream_add_block().
+ *
+ * Returns: (transfer full): a #FuMszipInputStream, or %NULL on error
+ *
+ * Since: 2.0.3
+ **/
+GInputStream *
+fu_mszip_input_stream_new(GInputStream *base_stream, GError **error)
+{
+	int zret;
+	g_autoptr(FuMszipInputStream) self = g_object_new(FU_TYPE_MSZIP_INPUT_STREAM, NULL);
+
+	g_return_val_if_fail(G_IS_INPUT_STREAM(base_stream), NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+	/* zlib */
+	self->zstrm.zalloc = fu_mszip_input_stream_zalloc;
+	self->zstrm.zfree = fu_mszip_input_stream_zfree;
+	zret = inflateInit2(&self->zstrm, -MAX_WBITS);
+	if (zret != Z_OK) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_NOT_SUPPORTED,
+			    "failed to initialize inflate: %s",
+			    zError(zret));
+		return NULL;
+	}
+
+	/* sanity check */
+	self->base_stream = g_object_ref(base_stream);
+	if (!fu_input_stream_size(base_stream, &self->base_sz, error)) {
+		g_prefix_error(error, "failed to get size: ");
+		return NULL;
+	}
+
+	/* success */
+	return G_INPUT_STREAM(g_steal_pointer(&self));
+}
@@ -0,0 +1,22 @@
+/*
+ * Copyright 2025 Richard Hughes <richard@hughsie.com>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#include <gio/gio.h>
+
+#define FU_TYPE_MSZIP_INPUT_STREAM (fu_mszip_input_stream_get_type())
+
+G_DECLARE_FINAL_TYPE(FuMszipInputStream, fu_mszip_input_stream, FU, MSZIP_INPUT_STREAM, GInputStream)
+
+GInputStream *
+fu_mszip_input_stream_new(GInputStream *base_stream, GError **error) G_GNUC_NON_NULL(1);
+gboolean
+fu_mszip_input_stream_add_block(FuMszipInputStream *self,
+				gsize offset,
+				gsize comp_sz,
+				gsize uncomp_sz,
+				GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
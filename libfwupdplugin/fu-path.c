@@ -9,11 +9,18 @@
 #include "config.h"
 
 #include <errno.h>
+#include <fcntl.h>
 #include <glib/gstdio.h>
 
 #ifdef _WIN32
 #include <stdlib.h>
 #endif
+#ifdef HAVE_IOCTL_H
+#include <sys/ioctl.h>
+#endif
+#ifdef __linux__
+#include <linux/fs.h>
+#endif
 
 #include "fwupd-error.h"
 
@@ -75,6 +82,78 @@ fu_path_rmtree(const gchar *directory, GError **error)
 	return TRUE;
 }
 
+/**
+ * fu_path_copy_file:
+ * @source: the source filename
+ * @target: the target filename, which is replaced if it already exists
+ * @error: (nullable): optional return location for an error
+ *
+ * Copies a file, preferring a filesystem clone so that copy-on-write filesystems like btrfs
+ * and XFS only duplicate metadata rather than the file contents.
+ *
+ * Returns: %TRUE for success, %FALSE otherwise
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_path_copy_file(const gchar *source, const gchar *target, GError **error)
+{
+	g_autoptr(GFile) file_source = NULL;
+	g_autoptr(GFile) file_target = NULL;
+
+	g_return_val_if_fail(source != NULL, FALSE);
+	g_return_val_if_fail(target != NULL, FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+#if defined(HAVE_IOCTL_H) && defined(FICLONE)
+	{
+		gint fd_source = g_open(source, O_RDONLY | O_CLOEXEC, 0);
+		if (fd_source >= 0) {
+			gint fd_target =
+			    g_open(target, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+			if (fd_target >= 0) {
+				gint rc =
+				    ioctl(fd_target, FICLONE, fd_source); /* nocheck:blocked */
+				if (!g_close(fd_target, error)) {
+					g_close(fd_source, NULL);
+					return FALSE;
+				}
+				if (!g_close(fd_source, error))
+					return FALSE;
+				if (rc == 0)
+					return TRUE;
+				/* not on the same filesystem, or one that cannot reflink --
+				 * remove the truncated file and do a full data copy instead */
+				g_debug("cannot clone %s to %s: %s",
+					source,
+					target,
+					g_strerror(errno));
+				g_unlink(target);
+			} else {
+				g_close(fd_source, NULL);
+			}
+		}
+	}
+#endif
+
+	/* fall back to a full copy */
+	file_source = g_file_new_for_path(source);
+	file_target = g_file_new_for_path(target);
+	if (!g_file_copy(file_source,
+			 file_target,
+			 G_FILE_COPY_OVERWRITE,
+			 NULL,
+			 NULL,
+			 NULL,
+			 error)) {
+		fwupd_error_convert(error);
+		return FALSE;
+	}
+
+	/* success */
+	return TRUE;
+}
+
 static gboolean
 fu_path_get_file_list_internal(GPtrArray *files, const gchar *directory, GError **error)
 {
@@ -100,6 +100,9 @@ fu_path_glob(const gchar *directory, const gchar *pattern, GError **error) G_GNU
     G_GNUC_NON_NULL(1, 2);
 gboolean
 fu_path_rmtree(const gchar *directory, GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
+gboolean
+fu_path_copy_file(const gchar *source, const gchar *target, GError **error)
+    G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
 GPtrArray *
 fu_path_get_files(const gchar *path, GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
 gboolean
@@ -36,6 +36,8 @@ GPtrArray *
 fu_plugin_get_rules(FuPlugin *self, FuPluginRule rule) G_GNUC_NON_NULL(1);
 GHashTable *
 fu_plugin_get_report_metadata(FuPlugin *self) G_GNUC_NON_NULL(1);
+GHashTable *
+fu_plugin_get_timings(FuPlugin *self) G_GNUC_NON_NULL(1);
 gboolean
 fu_plugin_open(FuPlugin *self, const gchar *filename, GError **error) G_GNUC_WARN_UNUSED_RESULT
     G_GNUC_NON_NULL(1, 2);
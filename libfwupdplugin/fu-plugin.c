@@ -50,8 +50,10 @@ typedef struct {
 	GType device_gtype_default;
 	GHashTable *cache;	     /* (nullable): platform_id:GObject */
 	GHashTable *report_metadata; /* (nullable): key:value */
+	GHashTable *timings;	     /* (nullable): step:usec */
 	GFileMonitor *config_monitor;
 	FuPluginData *data;
+	gsize data_sz;
 	FuPluginVfuncs vfuncs;
 } FuPluginPrivate;
 
@@ -264,9 +266,31 @@ fu_plugin_alloc_data(FuPlugin *self, gsize data_sz)
 		return priv->data;
 	}
 	priv->data = g_malloc0(data_sz);
+	priv->data_sz = data_sz;
 	return priv->data;
 }
 
+/**
+ * fu_plugin_get_data_size:
+ * @self: a #FuPlugin
+ *
+ * Gets the size of the per-plugin allocated private data, which will be 0 unless
+ * fu_plugin_alloc_data() has been called by the plugin.
+ *
+ * This is useful to attribute daemon memory usage to specific plugins.
+ *
+ * Returns: size in bytes
+ *
+ * Since: 2.0.3
+ **/
+gsize
+fu_plugin_get_data_size(FuPlugin *self)
+{
+	FuPluginPrivate *priv = GET_PRIVATE(self);
+	g_return_val_if_fail(FU_IS_PLUGIN(self), 0);
+	return priv->data_sz;
+}
+
 /**
  * fu_plugin_guess_name_from_fn:
  * @filename: filename to guess
@@ -308,6 +332,7 @@ fu_plugin_open(FuPlugin *self, const gchar *filename, GError **error)
 	FuPluginPrivate *priv = GET_PRIVATE(self);
 	FuPluginVfuncs *vfuncs;
 	FuPluginInitVfuncsFunc init_vfuncs = NULL;
+	gint64 timestamp = g_get_monotonic_time();
 
 	g_return_val_if_fail(FU_IS_PLUGIN(self), FALSE);
 	g_return_val_if_fail(filename != NULL, FALSE);
@@ -357,6 +382,8 @@ fu_plugin_open(FuPlugin *self, const gchar *filename, GError **error)
 		vfuncs->load(ctx);
 	}
 
+	/* success */
+	fu_plugin_add_timing(self, "open", g_get_monotonic_time() - timestamp);
 	return TRUE;
 }
 
@@ -859,6 +886,7 @@ fu_plugin_runner_startup(FuPlugin *self, FuProgress *progress, GError **error)
 
 	/* optional */
 	if (vfuncs->startup != NULL) {
+		gint64 timestamp = g_get_monotonic_time();
 		g_debug("startup(%s)", fu_plugin_get_name(self));
 		if (!vfuncs->startup(self, progress, &error_local)) {
 			if (error_local == NULL) {
@@ -875,6 +903,7 @@ fu_plugin_runner_startup(FuPlugin *self, FuProgress *progress, GError **error)
 						   fu_plugin_get_name(self));
 			return FALSE;
 		}
+		fu_plugin_add_timing(self, "startup", g_get_monotonic_time() - timestamp);
 	}
 
 	/* success */
@@ -1129,6 +1158,7 @@ fu_plugin_runner_coldplug(FuPlugin *self, FuProgress *progress, GError **error)
 {
 	FuPluginPrivate *priv = GET_PRIVATE(self);
 	FuPluginVfuncs *vfuncs = fu_plugin_get_vfuncs(self);
+	gint64 timestamp = g_get_monotonic_time();
 	g_autoptr(GError) error_local = NULL;
 
 	g_return_val_if_fail(FU_IS_PLUGIN(self), FALSE);
@@ -1171,6 +1201,9 @@ fu_plugin_runner_coldplug(FuPlugin *self, FuProgress *progress, GError **error)
 					   fu_plugin_get_name(self));
 		return FALSE;
 	}
+
+	/* success */
+	fu_plugin_add_timing(self, "coldplug", g_get_monotonic_time() - timestamp);
 	return TRUE;
 }
 
@@ -2597,6 +2630,44 @@ fu_plugin_get_report_metadata(FuPlugin *self)
 	return priv->report_metadata;
 }
 
+/**
+ * fu_plugin_add_timing:
+ * @self: a #FuPlugin
+ * @step: a string, e.g. `startup`
+ * @duration_usec: duration in microseconds
+ *
+ * Records how long a plugin step took so that plugins that are slow to start
+ * on a specific piece of hardware can be identified without tracing.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_plugin_add_timing(FuPlugin *self, const gchar *step, guint duration_usec)
+{
+	FuPluginPrivate *priv = fu_plugin_get_instance_private(self);
+	if (priv->timings == NULL)
+		priv->timings = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	g_hash_table_insert(priv->timings, g_strdup(step), GUINT_TO_POINTER(duration_usec));
+}
+
+/**
+ * fu_plugin_get_timings:
+ * @self: a #FuPlugin
+ *
+ * Returns the recorded duration of each plugin step, with each value in
+ * microseconds stored using GUINT_TO_POINTER().
+ *
+ * Returns: (transfer none) (nullable): the map of step timings
+ *
+ * Since: 2.0.3
+ **/
+GHashTable *
+fu_plugin_get_timings(FuPlugin *self)
+{
+	FuPluginPrivate *priv = fu_plugin_get_instance_private(self);
+	return priv->timings;
+}
+
 /**
  * fu_plugin_get_config_value:
  * @self: a #FuPlugin
@@ -3057,6 +3128,8 @@ fu_plugin_finalize(GObject *object)
 		g_hash_table_unref(priv->compile_versions);
 	if (priv->report_metadata != NULL)
 		g_hash_table_unref(priv->report_metadata);
+	if (priv->timings != NULL)
+		g_hash_table_unref(priv->timings);
 	if (priv->cache != NULL)
 		g_hash_table_unref(priv->cache);
 	if (priv->device_gtypes != NULL)
@@ -477,6 +477,8 @@ FuPluginData *
 fu_plugin_get_data(FuPlugin *self) G_GNUC_NON_NULL(1);
 FuPluginData *
 fu_plugin_alloc_data(FuPlugin *self, gsize data_sz) G_GNUC_NON_NULL(1);
+gsize
+fu_plugin_get_data_size(FuPlugin *self) G_GNUC_NON_NULL(1);
 FuContext *
 fu_plugin_get_context(FuPlugin *self) G_GNUC_NON_NULL(1);
 void
@@ -511,6 +513,8 @@ void
 fu_plugin_add_report_metadata(FuPlugin *self, const gchar *key, const gchar *value)
     G_GNUC_NON_NULL(1, 2, 3);
 void
+fu_plugin_add_timing(FuPlugin *self, const gchar *step, guint duration_usec) G_GNUC_NON_NULL(1, 2);
+void
 fu_plugin_set_config_default(FuPlugin *self, const gchar *key, const gchar *value)
     G_GNUC_NON_NULL(1, 2);
 gchar *
@@ -8,6 +8,7 @@
 
 #include "config.h"
 
+#include <json-glib/json-glib.h>
 #include <math.h>
 
 #include "fu-progress.h"
@@ -63,6 +64,13 @@ struct _FuProgress {
 	gchar *name;
 	FuProgressFlag flags;
 	guint percentage;
+	guint emit_interval_ms;
+	gint64 emit_last_usec;
+	guint64 bytes_done;
+	guint64 bytes_total;
+	gdouble bytes_per_sec; /* EMA, only tracked on the root */
+	guint64 rate_last_bytes;
+	gint64 rate_last_usec;
 	FwupdStatus status;
 	GPtrArray *children; /* of FuProgress */
 	gboolean profile;
@@ -287,6 +295,100 @@ fu_progress_get_percentage(FuProgress *self)
 	return self->percentage;
 }
 
+/* keep a smoothed transfer rate on the root so that the daemon can export it without
+ * having to know which leaf is driving the chunked operation */
+static void
+fu_progress_update_rate(FuProgress *self, gsize progress_done, gsize progress_total)
+{
+	FuProgress *root = self;
+	gint64 now_usec = g_get_monotonic_time();
+	gdouble bytes_per_sec;
+
+	while (root->parent != NULL)
+		root = root->parent;
+
+	/* a different operation has started, so restart the estimator */
+	if (progress_total != root->bytes_total || progress_done < root->rate_last_bytes) {
+		root->bytes_total = progress_total;
+		root->bytes_done = progress_done;
+		root->bytes_per_sec = 0.f;
+		root->rate_last_bytes = progress_done;
+		root->rate_last_usec = now_usec;
+		return;
+	}
+	root->bytes_done = progress_done;
+
+	/* too soon to get a stable sample */
+	if (now_usec - root->rate_last_usec < G_USEC_PER_SEC / 10)
+		return;
+
+	/* exponential moving average so that ETAs do not jump around on bursty transports */
+	bytes_per_sec = (gdouble)(progress_done - root->rate_last_bytes) * G_USEC_PER_SEC /
+			(gdouble)(now_usec - root->rate_last_usec);
+	if (root->bytes_per_sec > 0.f)
+		bytes_per_sec = (0.75 * root->bytes_per_sec) + (0.25 * bytes_per_sec);
+	root->bytes_per_sec = bytes_per_sec;
+	root->rate_last_bytes = progress_done;
+	root->rate_last_usec = now_usec;
+}
+
+/**
+ * fu_progress_get_bytes_transferred:
+ * @self: a #FuProgress
+ *
+ * Gets the number of bytes already transferred in the current chunked operation, as last
+ * reported using fu_progress_set_percentage_full().
+ *
+ * Return value: the number of bytes, or 0 for unknown
+ *
+ * Since: 2.0.3
+ **/
+guint64
+fu_progress_get_bytes_transferred(FuProgress *self)
+{
+	g_return_val_if_fail(FU_IS_PROGRESS(self), 0);
+	return self->bytes_done;
+}
+
+/**
+ * fu_progress_get_transfer_rate:
+ * @self: a #FuProgress
+ *
+ * Gets the smoothed transfer rate of the current chunked operation. A sudden drop can be
+ * used to detect a degraded transport, e.g. a USB device that renegotiated at full-speed.
+ *
+ * Return value: the transfer rate in bytes per second, or 0 for unknown
+ *
+ * Since: 2.0.3
+ **/
+guint64
+fu_progress_get_transfer_rate(FuProgress *self)
+{
+	g_return_val_if_fail(FU_IS_PROGRESS(self), 0);
+	return (guint64)self->bytes_per_sec;
+}
+
+/**
+ * fu_progress_get_eta:
+ * @self: a #FuProgress
+ *
+ * Gets the estimated number of seconds until the current chunked operation completes,
+ * computed from the smoothed transfer rate.
+ *
+ * Return value: the remaining time in seconds, or 0 for unknown
+ *
+ * Since: 2.0.3
+ **/
+guint
+fu_progress_get_eta(FuProgress *self)
+{
+	g_return_val_if_fail(FU_IS_PROGRESS(self), 0);
+	if (self->bytes_per_sec <= 0.f || self->bytes_total == 0 ||
+	    self->bytes_done >= self->bytes_total)
+		return 0;
+	return (guint)((gdouble)(self->bytes_total - self->bytes_done) / self->bytes_per_sec);
+}
+
 static void
 fu_progress_set_parent(FuProgress *self, FuProgress *parent)
 {
@@ -376,9 +478,36 @@ fu_progress_set_percentage(FuProgress *self, guint percentage)
 
 	/* save */
 	self->percentage = percentage;
+
+	/* rate-limit the emission for devices updated in tiny chunks */
+	if (self->emit_interval_ms > 0 && percentage != 0 && percentage != 100) {
+		gint64 now_usec = g_get_monotonic_time();
+		if (now_usec - self->emit_last_usec < (gint64)self->emit_interval_ms * 1000)
+			return;
+		self->emit_last_usec = now_usec;
+	}
 	g_signal_emit(self, signals[SIGNAL_PERCENTAGE_CHANGED], 0, percentage);
 }
 
+/**
+ * fu_progress_set_emit_interval:
+ * @self: a #FuProgress
+ * @emit_interval_ms: the minimum time between emissions in ms, or 0 for every change
+ *
+ * Rate-limits the ::percentage-changed signal so that progress bookkeeping does
+ * not dominate the install time of devices that are written in tiny chunks.
+ *
+ * Values of 0% and 100% are always emitted.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_progress_set_emit_interval(FuProgress *self, guint emit_interval_ms)
+{
+	g_return_if_fail(FU_IS_PROGRESS(self));
+	self->emit_interval_ms = emit_interval_ms;
+}
+
 /**
  * fu_progress_set_percentage_full:
  * @self: a #FuDevice
@@ -395,8 +524,10 @@ fu_progress_set_percentage_full(FuProgress *self, gsize progress_done, gsize pro
 	gdouble percentage = 0.f;
 	g_return_if_fail(FU_IS_PROGRESS(self));
 	g_return_if_fail(progress_done <= progress_total);
-	if (progress_total > 0)
+	if (progress_total > 0) {
 		percentage = (100.f * (gdouble)progress_done) / (gdouble)progress_total;
+		fu_progress_update_rate(self, progress_done, progress_total);
+	}
 	fu_progress_set_percentage(self, (guint)percentage);
 }
 
@@ -450,6 +581,12 @@ fu_progress_reset(FuProgress *self)
 	/* reset values */
 	self->step_now = 0;
 	self->percentage = G_MAXUINT;
+	self->emit_last_usec = 0;
+	self->bytes_done = 0;
+	self->bytes_total = 0;
+	self->bytes_per_sec = 0.f;
+	self->rate_last_bytes = 0;
+	self->rate_last_usec = 0;
 
 	/* only use the timer if profiling; it's expensive */
 	if (self->profile) {
@@ -978,6 +1115,83 @@ fu_progress_traceback(FuProgress *self)
 	return g_string_free(g_steal_pointer(&str), FALSE);
 }
 
+static void
+fu_progress_to_trace_cb(FuProgress *self, guint child_idx, gdouble ts, JsonBuilder *builder)
+{
+	gdouble ts_child = ts;
+
+	if (self->flags & FU_PROGRESS_FLAG_NO_TRACEBACK)
+		return;
+	if (self->children->len == 0 && fu_progress_get_duration(self) < 0.0001)
+		return;
+
+	/* use the same identifier as the traceback */
+	if (self->id != NULL || self->name != NULL || child_idx != G_MAXUINT) {
+		g_autoptr(GString) title = g_string_new(NULL);
+		if (self->id != NULL)
+			g_string_append(title, self->id);
+		if (self->name != NULL)
+			g_string_append_printf(title, ":%s", self->name);
+		if (title->len == 0)
+			g_string_append_printf(title, "@%u", child_idx);
+		json_builder_begin_object(builder);
+		json_builder_set_member_name(builder, "name");
+		json_builder_add_string_value(builder, title->str);
+		json_builder_set_member_name(builder, "ph");
+		json_builder_add_string_value(builder, "X");
+		json_builder_set_member_name(builder, "ts");
+		json_builder_add_int_value(builder, (gint64)(ts * 1000000.f));
+		json_builder_set_member_name(builder, "dur");
+		json_builder_add_int_value(builder,
+					   (gint64)(fu_progress_get_duration(self) * 1000000.f));
+		json_builder_set_member_name(builder, "pid");
+		json_builder_add_int_value(builder, 0);
+		json_builder_set_member_name(builder, "tid");
+		json_builder_add_int_value(builder, 0);
+		json_builder_end_object(builder);
+	}
+
+	/* the children ran back-to-back, so reconstruct their start times from the durations */
+	for (guint i = 0; i < self->children->len; i++) {
+		FuProgress *child = g_ptr_array_index(self->children, i);
+		fu_progress_to_trace_cb(child, i, ts_child, builder);
+		ts_child += fu_progress_get_duration(child);
+	}
+}
+
+/**
+ * fu_progress_to_trace_string:
+ * @self: A #FuProgress
+ *
+ * Exports the hierarchy of completed steps as Chrome trace-event JSON, suitable for loading
+ * into Perfetto or `chrome://tracing` to visualize where the time was spent.
+ *
+ * Profiling must have been enabled with fu_progress_set_profile() before the steps ran,
+ * otherwise no durations will have been recorded.
+ *
+ * Return value: (transfer full): string, or %NULL if nothing was recorded
+ *
+ * Since: 2.0.3
+ **/
+gchar *
+fu_progress_to_trace_string(FuProgress *self)
+{
+	g_autoptr(JsonBuilder) builder = json_builder_new();
+	g_autoptr(JsonGenerator) generator = json_generator_new();
+	g_autoptr(JsonNode) root = NULL;
+
+	g_return_val_if_fail(FU_IS_PROGRESS(self), NULL);
+
+	json_builder_begin_array(builder);
+	fu_progress_to_trace_cb(self, G_MAXUINT, 0.f, builder);
+	json_builder_end_array(builder);
+	root = json_builder_get_root(builder);
+	if (json_array_get_length(json_node_get_array(root)) == 0)
+		return NULL;
+	json_generator_set_root(generator, root);
+	return json_generator_to_data(generator, NULL);
+}
+
 static void
 fu_progress_add_string(FwupdCodec *codec, guint idt, GString *str)
 {
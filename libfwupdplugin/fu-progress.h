@@ -39,8 +39,16 @@ fu_progress_set_percentage(FuProgress *self, guint percentage) G_GNUC_NON_NULL(1
 void
 fu_progress_set_percentage_full(FuProgress *self, gsize progress_done, gsize progress_total)
     G_GNUC_NON_NULL(1);
+void
+fu_progress_set_emit_interval(FuProgress *self, guint emit_interval_ms) G_GNUC_NON_NULL(1);
 guint
 fu_progress_get_percentage(FuProgress *self) G_GNUC_NON_NULL(1);
+guint64
+fu_progress_get_bytes_transferred(FuProgress *self) G_GNUC_NON_NULL(1);
+guint64
+fu_progress_get_transfer_rate(FuProgress *self) G_GNUC_NON_NULL(1);
+guint
+fu_progress_get_eta(FuProgress *self) G_GNUC_NON_NULL(1);
 gdouble
 fu_progress_get_duration(FuProgress *self) G_GNUC_NON_NULL(1);
 void
@@ -66,3 +74,5 @@ void
 fu_progress_sleep(FuProgress *self, guint delay_ms) G_GNUC_NON_NULL(1);
 gchar *
 fu_progress_traceback(FuProgress *self) G_GNUC_NON_NULL(1);
+gchar *
+fu_progress_to_trace_string(FuProgress *self) G_GNUC_NON_NULL(1);
@@ -80,6 +80,8 @@ struct _FuQuirks {
 	XbSilo *silo;
 	XbQuery *query_kv;
 	XbQuery *query_vs;
+	guint silo_generation;
+	gboolean silo_rebuild_pending;
 	gboolean verbose;
 #ifdef HAVE_SQLITE
 	sqlite3 *db;
@@ -100,6 +102,37 @@ fu_quirks_build_group_key(const gchar *group)
 	return fwupd_guid_hash_string(group);
 }
 
+typedef struct {
+	const gchar *key;
+	guint64 max;
+} FuQuirksIntegerKey;
+
+/* keys whose values are integers parsed with FU_INTEGER_BASE_AUTO at application
+ * time; the ranges match the fu_strtoull() calls in the set_quirk_kv handlers */
+static const FuQuirksIntegerKey fu_quirks_integer_keys[] = {
+    {FU_QUIRKS_ACQUIESCE_DELAY, G_MAXUINT},
+    {FU_QUIRKS_BATTERY_THRESHOLD, 100},
+    {FU_QUIRKS_CFI_DEVICE_BLOCK_SIZE, G_MAXUINT32},
+    {FU_QUIRKS_CFI_DEVICE_CMD_BLOCK_ERASE, G_MAXUINT8},
+    {FU_QUIRKS_CFI_DEVICE_CMD_CHIP_ERASE, G_MAXUINT8},
+    {FU_QUIRKS_CFI_DEVICE_CMD_PAGE_PROG, G_MAXUINT8},
+    {FU_QUIRKS_CFI_DEVICE_CMD_READ_DATA, G_MAXUINT8},
+    {FU_QUIRKS_CFI_DEVICE_CMD_READ_ID, G_MAXUINT8},
+    {FU_QUIRKS_CFI_DEVICE_CMD_READ_ID_SZ, G_MAXUINT8},
+    {FU_QUIRKS_CFI_DEVICE_CMD_READ_STATUS, G_MAXUINT8},
+    {FU_QUIRKS_CFI_DEVICE_CMD_SECTOR_ERASE, G_MAXUINT8},
+    {FU_QUIRKS_CFI_DEVICE_CMD_WRITE_EN, G_MAXUINT8},
+    {FU_QUIRKS_CFI_DEVICE_CMD_WRITE_STATUS, G_MAXUINT8},
+    {FU_QUIRKS_CFI_DEVICE_PAGE_SIZE, G_MAXUINT32},
+    {FU_QUIRKS_CFI_DEVICE_SECTOR_SIZE, G_MAXUINT32},
+    {FU_QUIRKS_FIRMWARE_SIZE, G_MAXUINT64},
+    {FU_QUIRKS_FIRMWARE_SIZE_MAX, G_MAXUINT64},
+    {FU_QUIRKS_FIRMWARE_SIZE_MIN, G_MAXUINT64},
+    {FU_QUIRKS_INSTALL_DURATION, 60 * 60 * 24},
+    {FU_QUIRKS_PRIORITY, G_MAXUINT8},
+    {FU_QUIRKS_REMOVE_DELAY, G_MAXUINT},
+};
+
 static gboolean
 fu_quirks_validate_flags(const gchar *value, GError **error)
 {
@@ -229,6 +262,31 @@ fu_quirks_convert_keyfile_to_xml_cb(GString *token,
 		}
 	}
 
+	/* parse integer keys once at silo compile time, storing the canonical base-10
+	 * form so that malformed values are caught here and not at every coldplug */
+	for (guint i = 0; i < G_N_ELEMENTS(fu_quirks_integer_keys); i++) {
+		guint64 tmp = 0;
+		g_autoptr(GError) error_local = NULL;
+		if (g_strcmp0(key, fu_quirks_integer_keys[i].key) != 0)
+			continue;
+		if (!fu_strtoull(value,
+				 &tmp,
+				 0,
+				 fu_quirks_integer_keys[i].max,
+				 FU_INTEGER_BASE_AUTO,
+				 &error_local)) {
+			g_warning("[%s] %s = %s is invalid: %s",
+				  helper->group->str,
+				  key,
+				  value,
+				  error_local->message);
+			break;
+		}
+		g_free(value);
+		value = g_strdup_printf("%" G_GUINT64_FORMAT, tmp);
+		break;
+	}
+
 	/* add */
 	xb_builder_node_insert_text(helper->bn, "value", value, "key", key, NULL);
 	return TRUE;
@@ -353,59 +411,104 @@ fu_quirks_strcasecmp_cb(gconstpointer a, gconstpointer b)
 }
 
 static gboolean
-fu_quirks_check_silo(FuQuirks *self, GError **error)
+fu_quirks_add_content_hash_for_path(GChecksum *checksum, const gchar *path, GError **error)
 {
-	XbBuilderCompileFlags compile_flags = XB_BUILDER_COMPILE_FLAG_WATCH_BLOB;
-	g_autofree gchar *datadir = NULL;
-	g_autofree gchar *localstatedir = NULL;
-	g_autoptr(GFile) file = NULL;
-	g_autoptr(XbBuilder) builder = NULL;
-	g_autoptr(XbNode) n_any = NULL;
+	const gchar *tmp;
+	g_autoptr(GDir) dir = NULL;
+	g_autoptr(GPtrArray) filenames = g_ptr_array_new_with_free_func(g_free);
 
-	/* everything is okay */
-	if (self->silo != NULL && xb_silo_is_valid(self->silo))
+	/* hash the sorted file contents so that the key is stable across mtime changes */
+	if (!g_file_test(path, G_FILE_TEST_EXISTS))
 		return TRUE;
-
-	/* system datadir */
-	builder = xb_builder_new();
-	datadir = fu_path_from_kind(FU_PATH_KIND_DATADIR_QUIRKS);
-	if (!fu_quirks_add_quirks_for_path(self, builder, datadir, error))
+	dir = g_dir_open(path, 0, error);
+	if (dir == NULL)
 		return FALSE;
+	while ((tmp = g_dir_read_name(dir)) != NULL) {
+		if (!g_str_has_suffix(tmp, ".quirk") && !g_str_has_suffix(tmp, ".quirk.gz"))
+			continue;
+		g_ptr_array_add(filenames, g_build_filename(path, tmp, NULL));
+	}
+	g_ptr_array_sort(filenames, fu_quirks_filename_sort_cb);
+	for (guint i = 0; i < filenames->len; i++) {
+		const gchar *filename = g_ptr_array_index(filenames, i);
+		gsize bufsz = 0;
+		g_autofree gchar *buf = NULL;
+		if (!g_file_get_contents(filename, &buf, &bufsz, error))
+			return FALSE;
+		g_checksum_update(checksum, (const guchar *)filename, (gssize)strlen(filename));
+		g_checksum_update(checksum, (const guchar *)buf, (gssize)bufsz);
+	}
 
-	/* something we can write when using Ostree */
-	localstatedir = fu_path_from_kind(FU_PATH_KIND_LOCALSTATEDIR_QUIRKS);
-	if (!fu_quirks_add_quirks_for_path(self, builder, localstatedir, error))
-		return FALSE;
+	/* success */
+	return TRUE;
+}
+
+static XbBuilderCompileFlags
+fu_quirks_get_compile_flags(FuQuirks *self)
+{
+	XbBuilderCompileFlags compile_flags = XB_BUILDER_COMPILE_FLAG_WATCH_BLOB;
+	if (self->load_flags & FU_QUIRKS_LOAD_FLAG_READONLY_FS)
+		compile_flags |= XB_BUILDER_COMPILE_FLAG_IGNORE_GUID;
+	return compile_flags;
+}
+
+/* key the cache on the content hash of the quirk sources, so that image-based
+ * deployments that reset mtimes can still memory-map the compiled blob directly
+ * with zero parsing on a warm boot */
+static GFile *
+fu_quirks_silo_file_new(FuQuirks *self, GError **error)
+{
+	g_autofree gchar *cachedirpkg = NULL;
+	g_autofree gchar *datadir = NULL;
+	g_autofree gchar *localstatedir = NULL;
+	g_autofree gchar *xmlbbn = NULL;
+	g_autofree gchar *xmlbfn = NULL;
+	g_autoptr(GChecksum) checksum = g_checksum_new(G_CHECKSUM_SHA256);
 
-	/* load silo */
 	if (self->load_flags & FU_QUIRKS_LOAD_FLAG_NO_CACHE) {
 		g_autoptr(GFileIOStream) iostr = NULL;
-		file = g_file_new_tmp(NULL, &iostr, error);
-		if (file == NULL)
-			return FALSE;
-	} else {
-		g_autofree gchar *cachedirpkg = fu_path_from_kind(FU_PATH_KIND_CACHEDIR_PKG);
-		g_autofree gchar *xmlbfn = g_build_filename(cachedirpkg, "quirks.xmlb", NULL);
-		file = g_file_new_for_path(xmlbfn);
+		return g_file_new_tmp(NULL, &iostr, error);
 	}
+	datadir = fu_path_from_kind(FU_PATH_KIND_DATADIR_QUIRKS);
+	localstatedir = fu_path_from_kind(FU_PATH_KIND_LOCALSTATEDIR_QUIRKS);
+	if (!fu_quirks_add_content_hash_for_path(checksum, datadir, error))
+		return NULL;
+	if (!fu_quirks_add_content_hash_for_path(checksum, localstatedir, error))
+		return NULL;
+	cachedirpkg = fu_path_from_kind(FU_PATH_KIND_CACHEDIR_PKG);
+	xmlbbn = g_strdup_printf("quirks-%s.xmlb", g_checksum_get_string(checksum));
+	xmlbfn = g_build_filename(cachedirpkg, xmlbbn, NULL);
+	return g_file_new_for_path(xmlbfn);
+}
+
+static XbBuilder *
+fu_quirks_builder_new(FuQuirks *self, GError **error)
+{
+	g_autofree gchar *datadir = fu_path_from_kind(FU_PATH_KIND_DATADIR_QUIRKS);
+	g_autofree gchar *localstatedir = fu_path_from_kind(FU_PATH_KIND_LOCALSTATEDIR_QUIRKS);
+	g_autoptr(XbBuilder) builder = xb_builder_new();
+
+	/* system datadir, and something we can write when using Ostree */
+	if (!fu_quirks_add_quirks_for_path(self, builder, datadir, error))
+		return NULL;
+	if (!fu_quirks_add_quirks_for_path(self, builder, localstatedir, error))
+		return NULL;
 	if (g_getenv("FWUPD_XMLB_VERBOSE") != NULL) {
 		xb_builder_set_profile_flags(builder,
 					     XB_SILO_PROFILE_FLAG_XPATH |
 						 XB_SILO_PROFILE_FLAG_DEBUG);
 	}
-	if (self->load_flags & FU_QUIRKS_LOAD_FLAG_READONLY_FS)
-		compile_flags |= XB_BUILDER_COMPILE_FLAG_IGNORE_GUID;
-	self->silo = xb_builder_ensure(builder, file, compile_flags, NULL, error);
-	if (self->silo == NULL)
-		return FALSE;
+	return g_steal_pointer(&builder);
+}
 
-	/* dump warnings to console, just once */
-	if (self->invalid_keys->len > 0) {
-		g_autofree gchar *str = NULL;
-		g_ptr_array_sort(self->invalid_keys, fu_quirks_strcasecmp_cb);
-		str = fu_strjoin(",", self->invalid_keys);
-		g_info("invalid key names: %s", str);
-	}
+static gboolean
+fu_quirks_setup_silo_queries(FuQuirks *self, GError **error)
+{
+	g_autoptr(XbNode) n_any = NULL;
+
+	/* the prepared queries are bound to the old generation */
+	g_clear_object(&self->query_kv);
+	g_clear_object(&self->query_vs);
 
 	/* check if there is any quirk data to load, as older libxmlb versions will not be able to
 	 * create the prepared query with an unknown text ID */
@@ -441,6 +544,170 @@ fu_quirks_check_silo(FuQuirks *self, GError **error)
 	return TRUE;
 }
 
+typedef struct {
+	XbBuilder *builder;
+	GFile *file;
+	XbBuilderCompileFlags compile_flags;
+	guint generation;
+} FuQuirksSiloRebuildHelper;
+
+static void
+fu_quirks_silo_rebuild_helper_free(FuQuirksSiloRebuildHelper *helper)
+{
+	g_object_unref(helper->builder);
+	g_object_unref(helper->file);
+	g_free(helper);
+}
+
+static void
+fu_quirks_silo_rebuild_thread_cb(GTask *task,
+				 gpointer source_object,
+				 gpointer task_data,
+				 GCancellable *cancellable)
+{
+	FuQuirksSiloRebuildHelper *helper = (FuQuirksSiloRebuildHelper *)task_data;
+	XbSilo *silo;
+	GError *error = NULL;
+
+	silo = xb_builder_ensure(helper->builder,
+				 helper->file,
+				 helper->compile_flags,
+				 cancellable,
+				 &error);
+	if (silo == NULL) {
+		g_task_return_error(task, error);
+		return;
+	}
+	g_task_return_pointer(task, silo, (GDestroyNotify)g_object_unref);
+}
+
+static void
+fu_quirks_silo_rebuild_done_cb(GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+	FuQuirks *self = FU_QUIRKS(source_object);
+	FuQuirksSiloRebuildHelper *helper = g_task_get_task_data(G_TASK(res));
+	g_autoptr(GError) error = NULL;
+	g_autoptr(XbSilo) silo = NULL;
+
+	self->silo_rebuild_pending = FALSE;
+	silo = g_task_propagate_pointer(G_TASK(res), &error);
+	if (silo == NULL) {
+		g_warning("failed to rebuild quirk silo: %s", error->message);
+		return;
+	}
+
+	/* a newer rebuild has been scheduled since */
+	if (helper->generation != self->silo_generation) {
+		g_debug("quirk silo rebuild was superseded, ignoring");
+		return;
+	}
+
+	/* swap the pointer; in-flight lookups keep references to the old generation */
+	g_set_object(&self->silo, silo);
+	if (!fu_quirks_setup_silo_queries(self, &error)) {
+		g_warning("failed to prepare quirk queries: %s", error->message);
+		return;
+	}
+	g_debug("swapped in quirk silo generation %u", self->silo_generation);
+}
+
+static void
+fu_quirks_silo_rebuild_async(FuQuirks *self)
+{
+	g_autoptr(FuQuirksSiloRebuildHelper) helper = NULL;
+	g_autoptr(GError) error_local = NULL;
+	g_autoptr(GFile) file = NULL;
+	g_autoptr(GTask) task = NULL;
+	g_autoptr(XbBuilder) builder = NULL;
+
+	/* already building; the new silo picks up any further changes on the next watch */
+	if (self->silo_rebuild_pending)
+		return;
+
+	/* convert the keyfiles on this thread, compile off-thread */
+	file = fu_quirks_silo_file_new(self, &error_local);
+	if (file == NULL) {
+		g_warning("failed to rebuild quirk silo: %s", error_local->message);
+		return;
+	}
+	builder = fu_quirks_builder_new(self, &error_local);
+	if (builder == NULL) {
+		g_warning("failed to rebuild quirk silo: %s", error_local->message);
+		return;
+	}
+	helper = g_new0(FuQuirksSiloRebuildHelper, 1);
+	helper->builder = g_object_ref(builder);
+	helper->file = g_object_ref(file);
+	helper->compile_flags = fu_quirks_get_compile_flags(self);
+	helper->generation = ++self->silo_generation;
+	self->silo_rebuild_pending = TRUE;
+	task = g_task_new(self, NULL, fu_quirks_silo_rebuild_done_cb, NULL);
+	g_task_set_task_data(task,
+			     g_steal_pointer(&helper),
+			     (GDestroyNotify)fu_quirks_silo_rebuild_helper_free);
+	g_task_run_in_thread(task, fu_quirks_silo_rebuild_thread_cb);
+}
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(FuQuirksSiloRebuildHelper, fu_quirks_silo_rebuild_helper_free)
+
+static gboolean
+fu_quirks_check_silo(FuQuirks *self, GError **error)
+{
+	g_autoptr(GFile) file = NULL;
+
+	/* everything is okay */
+	if (self->silo != NULL) {
+		if (xb_silo_is_valid(self->silo))
+			return TRUE;
+		/* a quirk file changed: rebuild off-thread and swap the pointer when done,
+		 * answering lookups from the old generation in the meantime */
+		fu_quirks_silo_rebuild_async(self);
+		return TRUE;
+	}
+
+	file = fu_quirks_silo_file_new(self, error);
+	if (file == NULL)
+		return FALSE;
+	if ((self->load_flags & FU_QUIRKS_LOAD_FLAG_NO_CACHE) == 0 &&
+	    g_file_query_exists(file, NULL)) {
+		g_autoptr(GError) error_local = NULL;
+		g_autoptr(XbSilo) silo = xb_silo_new();
+		if (xb_silo_load_from_file(silo, file, XB_SILO_LOAD_FLAG_NONE, NULL, &error_local)) {
+			g_debug("mapped prebuilt quirk silo %s", g_file_peek_path(file));
+			self->silo = g_steal_pointer(&silo);
+		} else {
+			g_debug("failed to load %s, rebuilding: %s",
+				g_file_peek_path(file),
+				error_local->message);
+		}
+	}
+
+	/* fall back to converting and compiling the keyfiles */
+	if (self->silo == NULL) {
+		g_autoptr(XbBuilder) builder = fu_quirks_builder_new(self, error);
+		if (builder == NULL)
+			return FALSE;
+		self->silo = xb_builder_ensure(builder,
+					       file,
+					       fu_quirks_get_compile_flags(self),
+					       NULL,
+					       error);
+		if (self->silo == NULL)
+			return FALSE;
+	}
+
+	/* dump warnings to console, just once */
+	if (self->invalid_keys->len > 0) {
+		g_autofree gchar *str = NULL;
+		g_ptr_array_sort(self->invalid_keys, fu_quirks_strcasecmp_cb);
+		str = fu_strjoin(",", self->invalid_keys);
+		g_info("invalid key names: %s", str);
+	}
+
+	/* create prepared queries to save time later */
+	return fu_quirks_setup_silo_queries(self, error);
+}
+
 /**
  * fu_quirks_lookup_by_id:
  * @self: a #FuQuirks
@@ -622,6 +889,152 @@ fu_quirks_lookup_by_id_iter(FuQuirks *self,
 	return TRUE;
 }
 
+/**
+ * fu_quirks_lookup_by_ids_iter:
+ * @self: a #FuQuirks
+ * @guids: (element-type utf8): GUIDs to lookup
+ * @key: (nullable): an ID to match the entry, e.g. `Name`, or %NULL for all keys
+ * @iter_cb: (scope call) (closure user_data): a function to call for each result
+ * @user_data: user data passed to @iter_cb
+ *
+ * Looks up all entries in the hardware database using a set of GUID values,
+ * resolving them in a single indexed silo pass rather than one query per GUID.
+ *
+ * Results are returned grouped by GUID, in the order the GUIDs were provided.
+ *
+ * Returns: %TRUE if any ID was found, and @iter was called
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_quirks_lookup_by_ids_iter(FuQuirks *self,
+			     GPtrArray *guids,
+			     const gchar *key,
+			     FuQuirksIter iter_cb,
+			     gpointer user_data)
+{
+	gboolean found = FALSE;
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GPtrArray) results = NULL;
+	g_autoptr(GString) xpath = g_string_new(NULL);
+	g_autoptr(XbQuery) query = NULL;
+	g_auto(XbQueryContext) context = XB_QUERY_CONTEXT_INIT();
+
+	g_return_val_if_fail(FU_IS_QUIRKS(self), FALSE);
+	g_return_val_if_fail(guids != NULL, FALSE);
+	g_return_val_if_fail(iter_cb != NULL, FALSE);
+
+	/* nothing to do */
+	if (guids->len == 0)
+		return FALSE;
+
+	/* no point building a custom query, and the prepared one uses bound values */
+	if (guids->len == 1)
+		return fu_quirks_lookup_by_id_iter(self,
+						   g_ptr_array_index(guids, 0),
+						   key,
+						   iter_cb,
+						   user_data);
+
+#ifdef HAVE_SQLITE
+	/* this is generated from usb.ids and other static sources */
+	if (self->db != NULL && (self->load_flags & FU_QUIRKS_LOAD_FLAG_NO_CACHE) == 0) {
+		g_autoptr(sqlite3_stmt) stmt = NULL;
+		if (key == NULL) {
+			if (sqlite3_prepare_v2(self->db,
+					       "SELECT key, value FROM quirks WHERE guid = ?1",
+					       -1,
+					       &stmt,
+					       NULL) != SQLITE_OK) {
+				g_warning("failed to prepare SQL: %s", sqlite3_errmsg(self->db));
+				return FALSE;
+			}
+		} else {
+			if (sqlite3_prepare_v2(self->db,
+					       "SELECT key, value FROM quirks WHERE guid = ?1 "
+					       "AND key = ?2",
+					       -1,
+					       &stmt,
+					       NULL) != SQLITE_OK) {
+				g_warning("failed to prepare SQL: %s", sqlite3_errmsg(self->db));
+				return FALSE;
+			}
+		}
+		for (guint i = 0; i < guids->len; i++) {
+			const gchar *guid = g_ptr_array_index(guids, i);
+			sqlite3_reset(stmt);
+			sqlite3_bind_text(stmt, 1, guid, -1, SQLITE_STATIC);
+			if (key != NULL)
+				sqlite3_bind_text(stmt, 2, key, -1, SQLITE_STATIC);
+			while (sqlite3_step(stmt) == SQLITE_ROW) {
+				const gchar *key_tmp =
+				    (const gchar *)sqlite3_column_text(stmt, 0);
+				const gchar *value = (const gchar *)sqlite3_column_text(stmt, 1);
+				iter_cb(self, key_tmp, value, FU_CONTEXT_QUIRK_SOURCE_DB, user_data);
+				found = TRUE;
+			}
+		}
+	}
+#endif
+
+	/* ensure up to date */
+	if (!fu_quirks_check_silo(self, &error)) {
+		g_warning("failed to build silo: %s", error->message);
+		return FALSE;
+	}
+
+	/* no quirk data */
+	if (self->query_vs == NULL) {
+		g_debug("no quirk data");
+		return found;
+	}
+
+	/* build a union query of all the GUIDs; each section is matched with the
+	 * indexes and the results come back in section order, which keeps the
+	 * per-GUID precedence identical to issuing one query per GUID */
+	for (guint i = 0; i < guids->len; i++) {
+		const gchar *guid = g_ptr_array_index(guids, i);
+		if (!fwupd_guid_is_valid(guid)) {
+			g_warning("%s is not a valid GUID", guid);
+			return found;
+		}
+		if (xpath->len > 0)
+			g_string_append_c(xpath, '|');
+		g_string_append_printf(xpath, "quirk/device[@id='%s']/value", guid);
+		if (key != NULL)
+			g_string_append_printf(xpath, "[@key='%s']", key);
+	}
+	query = xb_query_new_full(self->silo, xpath->str, XB_QUERY_FLAG_OPTIMIZE, &error);
+	if (query == NULL) {
+		g_warning("failed to prepare query: %s", error->message);
+		return found;
+	}
+
+	/* query */
+	xb_query_context_set_flags(&context, XB_QUERY_FLAG_USE_INDEXES);
+	results = xb_silo_query_with_context(self->silo, query, &context, &error);
+	if (results == NULL) {
+		if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND))
+			return found;
+		if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT))
+			return found;
+		g_warning("failed to query: %s", error->message);
+		return found;
+	}
+	for (guint i = 0; i < results->len; i++) {
+		XbNode *n = g_ptr_array_index(results, i);
+		if (self->verbose)
+			g_debug("%s → %s", xb_node_get_attr(n, "key"), xb_node_get_text(n));
+		iter_cb(self,
+			xb_node_get_attr(n, "key"),
+			xb_node_get_text(n),
+			FU_CONTEXT_QUIRK_SOURCE_FILE,
+			user_data);
+	}
+
+	return TRUE;
+}
+
 #ifdef HAVE_SQLITE
 
 typedef struct {
@@ -1023,6 +1436,51 @@ fu_quirks_load(FuQuirks *self, FuQuirksLoadFlags load_flags, GError **error)
 	return fu_quirks_check_silo(self, error);
 }
 
+/**
+ * fu_quirks_check_file:
+ * @self: a #FuQuirks
+ * @file: a #GFile for a `.quirk` keyfile
+ * @error: (nullable): optional return location for an error
+ *
+ * Converts and compiles a single quirk file into a throwaway silo, without
+ * writing anything to the cache. This allows validating a file before
+ * dropping it into the quirk directory, where a syntax error would otherwise
+ * only show up as a failed rebuild at lookup time.
+ *
+ * Returns: %TRUE if the file compiled
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_quirks_check_file(FuQuirks *self, GFile *file, GError **error)
+{
+	g_autoptr(GBytes) bytes = NULL;
+	g_autoptr(GBytes) bytes_xml = NULL;
+	g_autoptr(XbBuilder) builder = xb_builder_new();
+	g_autoptr(XbBuilderSource) source = xb_builder_source_new();
+	g_autoptr(XbSilo) silo = NULL;
+
+	g_return_val_if_fail(FU_IS_QUIRKS(self), FALSE);
+	g_return_val_if_fail(G_IS_FILE(file), FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	bytes = g_file_load_bytes(file, NULL, NULL, error);
+	if (bytes == NULL)
+		return FALSE;
+	bytes_xml = fu_quirks_convert_keyfile_to_xml(self, bytes, error);
+	if (bytes_xml == NULL)
+		return FALSE;
+	if (!xb_builder_source_load_bytes(source, bytes_xml, XB_BUILDER_SOURCE_FLAG_NONE, error))
+		return FALSE;
+	xb_builder_import_source(builder, source);
+	silo = xb_builder_compile(builder, XB_BUILDER_COMPILE_FLAG_NONE, NULL, error);
+	if (silo == NULL)
+		return FALSE;
+
+	/* success */
+	return TRUE;
+}
+
 /**
  * fu_quirks_add_possible_key:
  * @self: a #FuQuirks
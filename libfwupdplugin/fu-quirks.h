@@ -60,8 +60,18 @@ fu_quirks_lookup_by_id_iter(FuQuirks *self,
 			    const gchar *key,
 			    FuQuirksIter iter_cb,
 			    gpointer user_data) G_GNUC_NON_NULL(1, 2);
+gboolean
+fu_quirks_lookup_by_ids_iter(FuQuirks *self,
+			     GPtrArray *guids,
+			     const gchar *key,
+			     FuQuirksIter iter_cb,
+			     gpointer user_data) G_GNUC_NON_NULL(1, 2);
 void
 fu_quirks_add_possible_key(FuQuirks *self, const gchar *possible_key) G_GNUC_NON_NULL(1, 2);
+gboolean
+fu_quirks_check_file(FuQuirks *self,
+		     GFile *file,
+		     GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
 
 /**
  * FU_QUIRKS_PLUGIN:
@@ -440,3 +450,11 @@ fu_quirks_add_possible_key(FuQuirks *self, const gchar *possible_key) G_GNUC_NON
  * Since: 1.8.2
  **/
 #define FU_QUIRKS_CFI_DEVICE_BLOCK_SIZE "CfiDeviceBlockSize"
+/**
+ * FU_QUIRKS_VERIFY_KIND:
+ *
+ * The quirk key to set how the firmware is verified after writing, e.g. `sampled`.
+ *
+ * Since: 2.0.3
+ **/
+#define FU_QUIRKS_VERIFY_KIND "VerifyKind"
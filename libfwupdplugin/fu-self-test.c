@@ -27,11 +27,13 @@
 #include "fu-device-progress.h"
 #include "fu-dummy-efivars.h"
 #include "fu-efi-lz77-decompressor.h"
+#include "fu-efi-signature-private.h"
 #include "fu-efivars-private.h"
 #include "fu-lzma-common.h"
 #include "fu-plugin-private.h"
 #include "fu-security-attrs-private.h"
 #include "fu-self-test-struct.h"
+#include "fu-zstd-common.h"
 #include "fu-smbios-private.h"
 #include "fu-test-device.h"
 #include "fu-volume-private.h"
@@ -186,9 +188,11 @@ fu_msgpack_parse_binary_func(void)
 static void
 fu_msgpack_func(void)
 {
+	gboolean ret;
 	g_autoptr(GByteArray) buf1 = NULL;
 	g_autoptr(GByteArray) buf2 = NULL;
 	g_autoptr(GByteArray) buf_in = g_byte_array_new();
+	g_autoptr(GByteArray) buf_scratch = g_byte_array_new();
 	g_autoptr(GError) error = NULL;
 	g_autoptr(GPtrArray) items_new = NULL;
 	g_autoptr(GPtrArray) items = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
@@ -230,6 +234,15 @@ fu_msgpack_func(void)
 	g_assert_nonnull(buf2);
 	g_assert_cmpint(buf2->len, ==, 53);
 
+	/* encoding into a reused scratch buffer has to give the same answer */
+	for (guint i = 0; i < 2; i++) {
+		ret = fu_msgpack_write_buf(items, buf_scratch, &error);
+		g_assert_no_error(error);
+		g_assert_true(ret);
+		g_assert_cmpint(buf_scratch->len, ==, buf2->len);
+		g_assert_cmpint(memcmp(buf_scratch->data, buf2->data, buf2->len), ==, 0);
+	}
+
 	/* parse it back */
 	items_new = fu_msgpack_parse(buf2, &error);
 	g_assert_no_error(error);
@@ -426,6 +439,80 @@ fu_common_crc_func(void)
 	g_assert_cmpint(fu_crc32(FU_CRC_KIND_B32_Q, buf, sizeof(buf)), ==, 0xE955C875);
 }
 
+static void
+fu_common_crc32_large_func(void)
+{
+	FuCrcKind kinds[] = {FU_CRC_KIND_B32_STANDARD,
+			     FU_CRC_KIND_B32_JAMCRC,
+			     FU_CRC_KIND_B32_C,
+			     FU_CRC_KIND_B32_D};
+	guint8 buf[1000] = {0x0};
+
+	for (guint i = 0; i < sizeof(buf); i++)
+		buf[i] = (guint8)(i * 7 + 3);
+
+	/* buffers above the sliced-by-8 threshold have to match byte-at-a-time stepping,
+	 * even when split at unaligned chunk boundaries; all these kinds init to 0xFFFFFFFF */
+	for (guint i = 0; i < G_N_ELEMENTS(kinds); i++) {
+		guint32 crc_whole = fu_crc32(kinds[i], buf, sizeof(buf));
+		guint32 crc_bitwise = 0xFFFFFFFF;
+		guint32 crc_steps = 0xFFFFFFFF;
+		for (guint j = 0; j < sizeof(buf); j++)
+			crc_bitwise = fu_crc32_step(kinds[i], buf + j, 1, crc_bitwise);
+		g_assert_cmpint(fu_crc32_done(kinds[i], crc_bitwise), ==, crc_whole);
+		crc_steps = fu_crc32_step(kinds[i], buf, 0x7B, crc_steps);
+		crc_steps = fu_crc32_step(kinds[i], buf + 0x7B, sizeof(buf) - 0x7B, crc_steps);
+		g_assert_cmpint(fu_crc32_done(kinds[i], crc_steps), ==, crc_whole);
+	}
+}
+
+static void
+fu_common_sum_func(void)
+{
+	guint8 buf[4099] = {0x0};
+
+	for (guint i = 0; i < sizeof(buf); i++)
+		buf[i] = (guint8)(i * 13 + 1);
+
+	/* the wide kernels have to match byte-at-a-time and word-at-a-time stepping for any
+	 * size and alignment, including the scalar tail */
+	for (guint i = 0; i < 32; i++) {
+		gsize bufsz = sizeof(buf) - i;
+		guint8 sum8 = 0;
+		guint16 sum16 = 0;
+		guint16 sum16w_le = 0;
+		guint16 sum16w_be = 0;
+		guint32 sum32 = 0;
+		guint32 sum32w_le = 0;
+		guint32 sum32w_be = 0;
+
+		for (gsize j = 0; j < bufsz; j++) {
+			sum8 += buf[j];
+			sum16 += buf[j];
+			sum32 += buf[j];
+		}
+		g_assert_cmpint(fu_sum8(buf, bufsz), ==, sum8);
+		g_assert_cmpint(fu_sum16(buf, bufsz), ==, sum16);
+		g_assert_cmpint(fu_sum32(buf, bufsz), ==, sum32);
+		if (bufsz % 2 == 0) {
+			for (gsize j = 0; j < bufsz; j += 2) {
+				sum16w_le += fu_memread_uint16(&buf[j], G_LITTLE_ENDIAN);
+				sum16w_be += fu_memread_uint16(&buf[j], G_BIG_ENDIAN);
+			}
+			g_assert_cmpint(fu_sum16w(buf, bufsz, G_LITTLE_ENDIAN), ==, sum16w_le);
+			g_assert_cmpint(fu_sum16w(buf, bufsz, G_BIG_ENDIAN), ==, sum16w_be);
+		}
+		if (bufsz % 4 == 0) {
+			for (gsize j = 0; j < bufsz; j += 4) {
+				sum32w_le += fu_memread_uint32(&buf[j], G_LITTLE_ENDIAN);
+				sum32w_be += fu_memread_uint32(&buf[j], G_BIG_ENDIAN);
+			}
+			g_assert_cmpint(fu_sum32w(buf, bufsz, G_LITTLE_ENDIAN), ==, sum32w_le);
+			g_assert_cmpint(fu_sum32w(buf, bufsz, G_BIG_ENDIAN), ==, sum32w_be);
+		}
+	}
+}
+
 static void
 fu_string_append_func(void)
 {
@@ -563,6 +650,36 @@ fu_device_cfi_device_func(void)
 	g_assert_cmpint(fu_cfi_device_get_block_size(cfi_device), ==, 0x8000);
 }
 
+static void
+fu_device_verify_kind_func(void)
+{
+	gboolean ret;
+	g_autoptr(FuDevice) device = fu_device_new(NULL);
+	g_autoptr(GError) error = NULL;
+
+	/* default is unset */
+	g_assert_cmpint(fu_device_get_verify_kind(device), ==, FU_DEVICE_VERIFY_KIND_UNKNOWN);
+
+	/* from quirk */
+	ret = fu_device_set_quirk_kv(device,
+				     FU_QUIRKS_VERIFY_KIND,
+				     "attested",
+				     FU_CONTEXT_QUIRK_SOURCE_FILE,
+				     &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+	g_assert_cmpint(fu_device_get_verify_kind(device), ==, FU_DEVICE_VERIFY_KIND_ATTESTED);
+
+	/* not a thing */
+	ret = fu_device_set_quirk_kv(device,
+				     FU_QUIRKS_VERIFY_KIND,
+				     "sometimes",
+				     FU_CONTEXT_QUIRK_SOURCE_FILE,
+				     &error);
+	g_assert_error(error, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED);
+	g_assert_false(ret);
+}
+
 static void
 fu_device_metadata_func(void)
 {
@@ -891,6 +1008,45 @@ fu_common_memmem_func(void)
 	g_assert_false(ret);
 }
 
+static void
+fu_mem_tracker_func(void)
+{
+	gboolean ret;
+	gsize bufsz = 1000 * 0x400;
+	g_autofree guint8 *buf = NULL;
+	g_autoptr(FuChunkArray) chunks = NULL;
+	g_autoptr(FuMemTracker) tracker = fu_mem_tracker_new(G_STRLOC);
+	g_autoptr(GBytes) fw = NULL;
+	g_autoptr(GError) error = NULL;
+
+	/* a huge allocation has to be noticed */
+	buf = g_malloc0(0x100000);
+	if (fu_mem_tracker_check(tracker, 0x1000, NULL)) {
+		g_test_skip("allocation tracking not supported");
+		return;
+	}
+	g_assert_cmpuint(fu_mem_tracker_get_usage(tracker), >=, 0x100000);
+	g_free(g_steal_pointer(&buf));
+	fu_mem_tracker_free(g_steal_pointer(&tracker));
+
+	/* iterating 1000 chunks must allocate O(1) per chunk, not copy the payload */
+	fw = g_bytes_new_take(g_malloc0(bufsz), bufsz);
+	tracker = fu_mem_tracker_new(G_STRLOC);
+	chunks = fu_chunk_array_new_from_bytes(fw,
+					       FU_CHUNK_ADDR_OFFSET_NONE,
+					       FU_CHUNK_PAGESZ_NONE,
+					       0x400);
+	g_assert_cmpuint(fu_chunk_array_length(chunks), ==, 1000);
+	for (guint i = 0; i < fu_chunk_array_length(chunks); i++) {
+		g_autoptr(FuChunk) chk = fu_chunk_array_index(chunks, i, &error);
+		g_assert_no_error(error);
+		g_assert_nonnull(chk);
+	}
+	ret = fu_mem_tracker_check(tracker, 0x10000, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+}
+
 static void
 fu_strpassmask_func(void)
 {
@@ -1424,6 +1580,12 @@ fu_plugin_quirks_func(void)
 	/* GUID */
 	tmp = fu_context_lookup_quirk_by_id(ctx, "bb9ec3e2-77b3-53bc-a1f1-b05916715627", "Flags");
 	g_assert_cmpstr(tmp, ==, "clever");
+
+	/* integer values are canonicalized at silo compile time */
+	tmp = fu_context_lookup_quirk_by_id(ctx,
+					    "afba9555-8a93-5963-9902-3cc566b60270",
+					    "CfiDevicePageSize");
+	g_assert_cmpstr(tmp, ==, "512");
 }
 
 static void
@@ -1526,6 +1688,32 @@ fu_plugin_quirks_append_func(void)
 	g_assert_true(helper.seen_two);
 }
 
+static void
+fu_plugin_quirks_batch_func(void)
+{
+	FuPluginQuirksAppendHelper helper = {0};
+	gboolean ret;
+	g_autoptr(FuContext) ctx = fu_context_new();
+	g_autoptr(FuQuirks) quirks = fu_quirks_new(ctx);
+	g_autoptr(GPtrArray) guids = g_ptr_array_new();
+	g_autoptr(GError) error = NULL;
+
+	/* look up several GUIDs at once, one of which has no quirk data */
+	ret = fu_quirks_load(quirks, FU_QUIRKS_LOAD_FLAG_NO_CACHE, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+	g_ptr_array_add(guids, (gpointer) "deadbeef-dead-dead-dead-deaddeadbeef");
+	g_ptr_array_add(guids, (gpointer) "b19d1c67-a29a-51ce-9cae-f7b40fe5505b");
+	ret = fu_quirks_lookup_by_ids_iter(quirks,
+					   guids,
+					   NULL,
+					   fu_plugin_quirks_append_cb,
+					   &helper);
+	g_assert_true(ret);
+	g_assert_true(helper.seen_one);
+	g_assert_true(helper.seen_two);
+}
+
 static void
 fu_quirks_vendor_ids_func(void)
 {
@@ -2720,6 +2908,97 @@ fu_chunk_array_func(void)
 	g_assert_null(chk4);
 }
 
+static void
+fu_chunk_array_zero_copy_func(void)
+{
+	g_autoptr(FuChunk) chk1 = NULL;
+	g_autoptr(FuChunk) chk2 = NULL;
+	g_autoptr(FuChunkArray) chunks = NULL;
+	g_autoptr(GBytes) fw = g_bytes_new_static("hello world", 11);
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GInputStream) stream = g_memory_input_stream_new_from_bytes(fw);
+
+	chunks = fu_chunk_array_new_from_stream_full(stream,
+						     FU_CHUNK_ADDR_OFFSET_NONE,
+						     FU_CHUNK_PAGESZ_NONE,
+						     5,
+						     FU_CHUNK_ARRAY_FLAG_ZERO_COPY,
+						     &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(chunks);
+	g_assert_cmpint(fu_chunk_array_length(chunks), ==, 3);
+
+	/* the chunks are slices of the same shared buffer */
+	chk1 = fu_chunk_array_index(chunks, 0, &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(chk1);
+	g_assert_cmpint(fu_chunk_get_data_sz(chk1), ==, 0x5);
+	g_assert_cmpint(strncmp((const gchar *)fu_chunk_get_data(chk1), "hello", 5), ==, 0);
+	chk2 = fu_chunk_array_index(chunks, 1, &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(chk2);
+	g_assert_cmpint(fu_chunk_get_data_sz(chk2), ==, 0x5);
+	g_assert_cmpint(strncmp((const gchar *)fu_chunk_get_data(chk2), " worl", 5), ==, 0);
+	g_assert_true(fu_chunk_get_data(chk2) == fu_chunk_get_data(chk1) + 0x5);
+}
+
+static gboolean
+fu_chunk_array_pipelined_write_cb(FuChunkArray *chunks,
+				  FuChunk *chk,
+				  gpointer user_data,
+				  GError **error)
+{
+	GByteArray *buf = (GByteArray *)user_data;
+	g_byte_array_append(buf, fu_chunk_get_data(chk), fu_chunk_get_data_sz(chk));
+	return TRUE;
+}
+
+static gboolean
+fu_chunk_array_pipelined_fail_cb(FuChunkArray *chunks,
+				 FuChunk *chk,
+				 gpointer user_data,
+				 GError **error)
+{
+	guint *cnt = (guint *)user_data;
+	(*cnt)++;
+	g_set_error_literal(error, FWUPD_ERROR, FWUPD_ERROR_WRITE, "mock failure");
+	return FALSE;
+}
+
+static void
+fu_chunk_array_pipelined_func(void)
+{
+	gboolean ret;
+	guint cnt = 0;
+	g_autoptr(GByteArray) buf = g_byte_array_new();
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GError) error2 = NULL;
+	g_autoptr(GBytes) fw = g_bytes_new_static("hello world", 11);
+	g_autoptr(FuChunkArray) chunks =
+	    fu_chunk_array_new_from_bytes(fw, FU_CHUNK_ADDR_OFFSET_NONE, FU_CHUNK_PAGESZ_NONE, 3);
+
+	/* the callback has to see every chunk, in order */
+	ret = fu_chunk_array_write_pipelined(chunks,
+					     2,
+					     fu_chunk_array_pipelined_write_cb,
+					     buf,
+					     &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+	g_assert_cmpint(buf->len, ==, 11);
+	g_assert_cmpint(memcmp(buf->data, "hello world", buf->len), ==, 0);
+
+	/* a write failure stops the pipeline after the first chunk */
+	ret = fu_chunk_array_write_pipelined(chunks,
+					     2,
+					     fu_chunk_array_pipelined_fail_cb,
+					     &cnt,
+					     &error2);
+	g_assert_error(error2, FWUPD_ERROR, FWUPD_ERROR_WRITE);
+	g_assert_false(ret);
+	g_assert_cmpint(cnt, ==, 1);
+}
+
 static void
 fu_chunk_func(void)
 {
@@ -3128,6 +3407,38 @@ fu_common_vercmp_func(void)
 	g_assert_cmpint(fu_version_compare("1", NULL, FWUPD_VERSION_FORMAT_UNKNOWN), ==, G_MAXINT);
 	g_assert_cmpint(fu_version_compare(NULL, "1", FWUPD_VERSION_FORMAT_UNKNOWN), ==, G_MAXINT);
 	g_assert_cmpint(fu_version_compare(NULL, NULL, FWUPD_VERSION_FORMAT_UNKNOWN), ==, G_MAXINT);
+
+	/* pre-parsed versions give the same answers */
+	{
+		struct {
+			const gchar *ver_a;
+			const gchar *ver_b;
+			FwupdVersionFormat fmt;
+		} map[] = {
+		    {"1.2.3", "1.2.3", FWUPD_VERSION_FORMAT_UNKNOWN},
+		    {"1.2.3", "1.2.4", FWUPD_VERSION_FORMAT_UNKNOWN},
+		    {"1.2.3", "1.2.3.1", FWUPD_VERSION_FORMAT_UNKNOWN},
+		    {"1.2.3a", "1.2.3b", FWUPD_VERSION_FORMAT_UNKNOWN},
+		    {"1.2.3", "1.2.3a", FWUPD_VERSION_FORMAT_UNKNOWN},
+		    {"1.2.3~rc1", "1.2.3", FWUPD_VERSION_FORMAT_UNKNOWN},
+		    {"alpha", "beta", FWUPD_VERSION_FORMAT_UNKNOWN},
+		    {"0x00000002", "0x2", FWUPD_VERSION_FORMAT_HEX},
+		    {"1.2.3", "1.2.4", FWUPD_VERSION_FORMAT_PLAIN},
+		};
+		for (guint i = 0; i < G_N_ELEMENTS(map); i++) {
+			g_autoptr(FuVersionParsed) parsed_a =
+			    fu_version_parsed_new(map[i].ver_a, map[i].fmt);
+			g_autoptr(FuVersionParsed) parsed_b =
+			    fu_version_parsed_new(map[i].ver_b, map[i].fmt);
+			g_assert_cmpint(fu_version_parsed_compare(parsed_a, parsed_b),
+					==,
+					fu_version_compare(map[i].ver_a, map[i].ver_b, map[i].fmt));
+			g_assert_cmpint(fu_version_parsed_compare(parsed_b, parsed_a),
+					==,
+					fu_version_compare(map[i].ver_b, map[i].ver_a, map[i].fmt));
+		}
+		g_assert_cmpint(fu_version_parsed_compare(NULL, NULL), ==, G_MAXINT);
+	}
 }
 
 static void
@@ -3723,6 +4034,49 @@ fu_firmware_archive_func(void)
 	g_assert_null(img_both);
 }
 
+static void
+fu_firmware_archive_on_demand_func(void)
+{
+	gboolean ret;
+	g_autofree gchar *fn = NULL;
+	g_autoptr(FuFirmware) firmware = fu_archive_firmware_new();
+	g_autoptr(FuFirmware) img_bin = NULL;
+	g_autoptr(GBytes) blob = NULL;
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GFile) file = NULL;
+	g_autoptr(GPtrArray) imgs = NULL;
+
+#ifndef HAVE_LIBARCHIVE
+	g_test_skip("no libarchive support");
+	return;
+#endif
+
+	/* parse only scans the member names */
+	fu_archive_firmware_set_on_demand(FU_ARCHIVE_FIRMWARE(firmware), TRUE);
+	fn = g_test_build_filename(G_TEST_BUILT, "tests", "firmware.zip", NULL);
+	file = g_file_new_for_path(fn);
+	ret = fu_firmware_parse_file(firmware, file, FWUPD_INSTALL_FLAG_NONE, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+	imgs = fu_firmware_get_images(firmware);
+	g_assert_cmpint(imgs->len, ==, 2);
+	for (guint i = 0; i < imgs->len; i++) {
+		FuFirmware *img = g_ptr_array_index(imgs, i);
+		g_autoptr(GBytes) blob_tmp = fu_firmware_get_bytes(img, NULL);
+		g_assert_null(blob_tmp);
+	}
+
+	/* the member is decompressed on first use */
+	img_bin =
+	    fu_archive_firmware_get_image_fnmatch(FU_ARCHIVE_FIRMWARE(firmware), "*.txt", &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(img_bin);
+	blob = fu_firmware_get_bytes(img_bin, &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(blob);
+	g_assert_cmpint(g_bytes_get_size(blob), >, 0);
+}
+
 static void
 fu_firmware_linear_func(void)
 {
@@ -3760,6 +4114,53 @@ fu_firmware_linear_func(void)
 	g_assert_cmpint(imgs->len, ==, 2);
 }
 
+static void
+fu_firmware_delta_func(void)
+{
+	gboolean ret;
+	const guint8 buf_src[] = {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H'};
+	const guint8 buf_dst[] = {'A', 'B', 'X', 'Y', 'E', 'F'};
+	g_autofree gchar *csum_src = NULL;
+	g_autofree gchar *csum_dst = NULL;
+	g_autoptr(FuChunk) chk = NULL;
+	g_autoptr(FuFirmware) firmware1 = fu_delta_firmware_new();
+	g_autoptr(FuFirmware) firmware2 = fu_delta_firmware_new();
+	g_autoptr(GBytes) blob_delta = NULL;
+	g_autoptr(GBytes) blob_op = g_bytes_new_static("XY", 2);
+	g_autoptr(GBytes) blob_patched = NULL;
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GInputStream) stream_src = NULL;
+
+	/* build a delta patching the 8 byte source into the 6 byte target */
+	csum_src = g_compute_checksum_for_data(G_CHECKSUM_SHA256, buf_src, sizeof(buf_src));
+	csum_dst = g_compute_checksum_for_data(G_CHECKSUM_SHA256, buf_dst, sizeof(buf_dst));
+	fu_delta_firmware_set_source_checksum(FU_DELTA_FIRMWARE(firmware1), csum_src);
+	fu_delta_firmware_set_target_checksum(FU_DELTA_FIRMWARE(firmware1), csum_dst);
+	fu_firmware_set_size(firmware1, sizeof(buf_dst));
+	chk = fu_chunk_bytes_new(blob_op);
+	fu_chunk_set_address(chk, 0x2);
+	fu_firmware_add_chunk(firmware1, chk);
+	blob_delta = fu_firmware_write(firmware1, &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(blob_delta);
+
+	/* parse it back and apply to the source image */
+	ret = fu_firmware_parse_bytes(firmware2, blob_delta, 0x0, FWUPD_INSTALL_FLAG_NONE, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+	g_assert_cmpstr(fu_delta_firmware_get_source_checksum(FU_DELTA_FIRMWARE(firmware2)),
+			==,
+			csum_src);
+	stream_src = g_memory_input_stream_new_from_data(buf_src, sizeof(buf_src), NULL);
+	blob_patched = fu_delta_firmware_apply(FU_DELTA_FIRMWARE(firmware2), stream_src, &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(blob_patched);
+	g_assert_cmpint(g_bytes_get_size(blob_patched), ==, sizeof(buf_dst));
+	g_assert_cmpint(memcmp(g_bytes_get_data(blob_patched, NULL), buf_dst, sizeof(buf_dst)),
+			==,
+			0);
+}
+
 static void
 fu_firmware_dfu_func(void)
 {
@@ -3916,6 +4317,47 @@ fu_firmware_dfu_patch_func(void)
 	g_assert_cmpstr(csum, ==, "676c039e8cb1d2f51831fcb77be36db24bb8ecf8");
 }
 
+static void
+fu_hid_descriptor_cache_func(void)
+{
+	gboolean ret;
+	g_autofree gchar *filename = NULL;
+	g_autoptr(FuFirmware) firmware = fu_hid_descriptor_new();
+	g_autoptr(FuFirmware) firmware1 = fu_hid_descriptor_new();
+	g_autoptr(FuFirmware) firmware2 = fu_hid_descriptor_new();
+	g_autoptr(FuHidReport) report1 = NULL;
+	g_autoptr(FuHidReport) report2 = NULL;
+	g_autoptr(GBytes) blob = NULL;
+	g_autoptr(GError) error = NULL;
+
+	filename = g_test_build_filename(G_TEST_DIST, "tests", "hid-descriptor.builder.xml", NULL);
+	ret = fu_firmware_build_from_filename(firmware, filename, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+	blob = fu_firmware_write(firmware, &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(blob);
+
+	/* parse the same descriptor bytes twice */
+	ret = fu_firmware_parse_bytes(firmware1, blob, 0x0, FWUPD_INSTALL_FLAG_NONE, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+	ret = fu_firmware_parse_bytes(firmware2, blob, 0x0, FWUPD_INSTALL_FLAG_NONE, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+
+	/* the second parse should have shared the report tree from the cache */
+	report1 =
+	    fu_hid_descriptor_find_report(FU_HID_DESCRIPTOR(firmware1), &error, "usage", 0xC8, NULL);
+	g_assert_no_error(error);
+	g_assert_nonnull(report1);
+	report2 =
+	    fu_hid_descriptor_find_report(FU_HID_DESCRIPTOR(firmware2), &error, "usage", 0xC8, NULL);
+	g_assert_no_error(error);
+	g_assert_nonnull(report2);
+	g_assert_true(report1 == report2);
+}
+
 static void
 fu_hid_descriptor_container_func(void)
 {
@@ -4176,6 +4618,115 @@ fu_firmware_dedupe_func(void)
 	g_assert_false(ret);
 }
 
+static void
+fu_firmware_image_index_func(void)
+{
+	gboolean ret;
+	g_autoptr(FuFirmware) firmware = fu_firmware_new();
+	g_autoptr(FuFirmware) img_id = NULL;
+	g_autoptr(FuFirmware) img_idx = NULL;
+	g_autoptr(FuFirmware) img_renamed = NULL;
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GError) error2 = NULL;
+
+	/* add enough images to flip the lookups over to the hash indexes */
+	for (guint i = 0; i < 50; i++) {
+		g_autofree gchar *id = g_strdup_printf("img%u", i);
+		g_autoptr(FuFirmware) img = fu_firmware_new();
+		fu_firmware_set_id(img, id);
+		fu_firmware_set_idx(img, i);
+		fu_firmware_add_image(firmware, img);
+	}
+
+	img_id = fu_firmware_get_image_by_id(firmware, "img42", &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(img_id);
+	g_assert_cmpint(fu_firmware_get_idx(img_id), ==, 42);
+
+	img_idx = fu_firmware_get_image_by_idx(firmware, 7, &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(img_idx);
+	g_assert_cmpstr(fu_firmware_get_id(img_idx), ==, "img7");
+
+	/* renaming a child has to invalidate the parent index */
+	fu_firmware_set_id(img_id, "renamed");
+	img_renamed = fu_firmware_get_image_by_id(firmware, "renamed", &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(img_renamed);
+
+	/* removing an image has to invalidate the index too */
+	ret = fu_firmware_remove_image(firmware, img_renamed, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+	g_clear_object(&img_renamed);
+	img_renamed = fu_firmware_get_image_by_id(firmware, "renamed", &error2);
+	g_assert_error(error2, FWUPD_ERROR, FWUPD_ERROR_NOT_FOUND);
+	g_assert_null(img_renamed);
+}
+
+static void
+fu_efi_signature_list_missing_func(void)
+{
+	g_autofree gchar *checksum = NULL;
+	g_autoptr(FuFirmware) siglist_new = fu_efi_signature_list_new();
+	g_autoptr(FuFirmware) siglist_old = fu_efi_signature_list_new();
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GPtrArray) imgs_old = NULL;
+	g_autoptr(GPtrArray) missing = NULL;
+
+	/* build an old list with one entry, and a new list with two */
+	for (guint i = 0; i < 2; i++) {
+		g_autoptr(FuEfiSignature) sig =
+		    fu_efi_signature_new(FU_EFI_SIGNATURE_KIND_SHA256,
+					 FU_EFI_SIGNATURE_GUID_MICROSOFT);
+		g_autoptr(GBytes) blob = g_bytes_new(&i, sizeof(i));
+		fu_firmware_set_bytes(FU_FIRMWARE(sig), blob);
+		if (i == 0) {
+			g_autoptr(FuEfiSignature) sig_old =
+			    fu_efi_signature_new(FU_EFI_SIGNATURE_KIND_SHA256,
+						 FU_EFI_SIGNATURE_GUID_MICROSOFT);
+			fu_firmware_set_bytes(FU_FIRMWARE(sig_old), blob);
+			fu_firmware_add_image(siglist_old, FU_FIRMWARE(sig_old));
+		}
+		fu_firmware_add_image(siglist_new, FU_FIRMWARE(sig));
+	}
+
+	/* the shared entry is indexed */
+	imgs_old = fu_firmware_get_images(siglist_old);
+	checksum = fu_firmware_get_checksum(FU_FIRMWARE(g_ptr_array_index(imgs_old, 0)),
+					    G_CHECKSUM_SHA256,
+					    &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(checksum);
+	g_assert_true(
+	    fu_efi_signature_list_has_checksum(FU_EFI_SIGNATURE_LIST(siglist_new), checksum));
+	g_assert_false(fu_efi_signature_list_has_checksum(FU_EFI_SIGNATURE_LIST(siglist_new),
+							  "deadbeef"));
+
+	/* exactly one entry from the new list has not been applied */
+	missing = fu_efi_signature_list_get_missing(FU_EFI_SIGNATURE_LIST(siglist_new),
+						    FU_EFI_SIGNATURE_LIST(siglist_old),
+						    &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(missing);
+	g_assert_cmpint(missing->len, ==, 1);
+}
+
+static void
+fu_efivar_async_cb(GObject *source, GAsyncResult *res, gpointer user_data)
+{
+	guint32 attr = 0;
+	g_autoptr(GBytes) blob = NULL;
+	g_autoptr(GError) error = NULL;
+
+	blob = fu_efivars_get_data_bytes_finish(FU_EFIVARS(source), res, &attr, &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(blob);
+	g_assert_cmpint(g_bytes_get_size(blob), ==, 1);
+	g_assert_cmpint(attr, ==, FU_EFIVARS_ATTR_NON_VOLATILE | FU_EFIVARS_ATTR_RUNTIME_ACCESS);
+	fu_test_loop_quit();
+}
+
 static void
 fu_efivar_func(void)
 {
@@ -4216,6 +4767,15 @@ fu_efivar_func(void)
 	g_assert_cmpint(attr, ==, FU_EFIVARS_ATTR_NON_VOLATILE | FU_EFIVARS_ATTR_RUNTIME_ACCESS);
 	g_assert_cmpint(data[0], ==, '1');
 
+	/* read it back without blocking the main thread */
+	fu_efivars_get_data_bytes_async(efivars,
+					FU_EFIVARS_GUID_EFI_GLOBAL,
+					"Test",
+					NULL,
+					fu_efivar_async_cb,
+					NULL);
+	fu_test_loop_run_with_timeout(5000);
+
 	/* check existing keys */
 	g_assert_false(fu_efivars_exists(efivars, FU_EFIVARS_GUID_EFI_GLOBAL, "NotGoingToExist"));
 	g_assert_true(fu_efivars_exists(efivars, FU_EFIVARS_GUID_EFI_GLOBAL, "Test"));
@@ -4459,6 +5019,54 @@ fu_device_retry_hardware_func(void)
 	g_assert_cmpint(helper.cnt_failed, ==, 2);
 }
 
+static void
+fu_device_retry_failure_budget_func(void)
+{
+	gboolean ret;
+	g_autoptr(FuDevice) device = fu_device_new(NULL);
+	g_autoptr(GError) error = NULL;
+	FuDeviceRetryHelper helper = {
+	    .cnt_success = 0,
+	    .cnt_failed = 0,
+	};
+
+	/* the budget is shared between both calls, so the second aborts on its first failure */
+	fu_device_retry_set_failure_budget(device, 3);
+	ret = fu_device_retry(device, fu_device_retry_success_3rd_try, 3, &helper, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+	ret = fu_device_retry(device, fu_device_retry_failed, 3, &helper, &error);
+	g_assert_error(error, FWUPD_ERROR, FWUPD_ERROR_INTERNAL);
+	g_assert_true(!ret);
+	g_assert_cmpint(helper.cnt_failed, ==, 3);
+}
+
+static void
+fu_device_retry_deadline_func(void)
+{
+	gboolean ret;
+	g_autoptr(FuDevice) device = fu_device_new(NULL);
+	g_autoptr(GError) error = NULL;
+	FuDeviceRetryHelper helper = {
+	    .cnt_success = 0,
+	    .cnt_failed = 0,
+	};
+
+	/* no time left to wait out the 50ms delay, so the first failure is fatal */
+	fu_device_retry_set_deadline(device, 1);
+	ret = fu_device_retry_full(device, fu_device_retry_failed, 3, 50, &helper, &error);
+	g_assert_error(error, FWUPD_ERROR, FWUPD_ERROR_INTERNAL);
+	g_assert_true(!ret);
+	g_assert_cmpint(helper.cnt_failed, ==, 1);
+	g_clear_error(&error);
+
+	/* an immediate policy never has to wait, so the deadline cannot trip */
+	fu_device_retry_set_policy(device, FU_DEVICE_RETRY_POLICY_IMMEDIATE);
+	ret = fu_device_retry_full(device, fu_device_retry_success_3rd_try, 3, 50, &helper, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+}
+
 static void
 fu_bios_settings_load_func(void)
 {
@@ -4972,6 +5580,7 @@ fu_progress_func(void)
 	FuProgressHelper helper = {0};
 	g_autoptr(FuProgress) progress = fu_progress_new(G_STRLOC);
 	g_autofree gchar *str = NULL;
+	g_autofree gchar *str_trace = NULL;
 
 	g_signal_connect(FU_PROGRESS(progress),
 			 "percentage-changed",
@@ -4999,6 +5608,57 @@ fu_progress_func(void)
 	g_assert_cmpfloat_with_epsilon(fu_progress_get_duration(progress), 0.1f, 0.05);
 	str = fu_progress_traceback(progress);
 	g_debug("\n%s", str);
+	str_trace = fu_progress_to_trace_string(progress);
+	g_assert_nonnull(str_trace);
+	g_assert_nonnull(g_strstr_len(str_trace, -1, "\"ph\""));
+	g_debug("\n%s", str_trace);
+}
+
+static void
+fu_progress_emit_interval_func(void)
+{
+	FuProgressHelper helper = {0};
+	g_autoptr(FuProgress) progress = fu_progress_new(G_STRLOC);
+
+	g_signal_connect(FU_PROGRESS(progress),
+			 "percentage-changed",
+			 G_CALLBACK(fu_progress_percentage_changed_cb),
+			 &helper);
+
+	/* only the first and final updates survive the coalescing */
+	fu_progress_set_emit_interval(progress, 5000);
+	for (guint i = 1; i < 100; i++)
+		fu_progress_set_percentage(progress, i);
+	g_assert_cmpint(helper.updates, ==, 1);
+	fu_progress_set_percentage(progress, 100);
+	g_assert_cmpint(helper.updates, ==, 2);
+	g_assert_cmpint(helper.last_percentage, ==, 100);
+}
+
+static void
+fu_progress_transfer_rate_func(void)
+{
+	g_autoptr(FuProgress) progress = fu_progress_new(G_STRLOC);
+
+	/* nothing reported yet */
+	g_assert_cmpuint(fu_progress_get_bytes_transferred(progress), ==, 0);
+	g_assert_cmpuint(fu_progress_get_transfer_rate(progress), ==, 0);
+	g_assert_cmpuint(fu_progress_get_eta(progress), ==, 0);
+
+	/* a slow chunked operation gets a rate and a nonzero ETA */
+	fu_progress_set_percentage_full(progress, 0, 0x100000);
+	g_usleep(150 * 1000);
+	fu_progress_set_percentage_full(progress, 0x400, 0x100000);
+	g_assert_cmpuint(fu_progress_get_bytes_transferred(progress), ==, 0x400);
+	g_assert_cmpuint(fu_progress_get_transfer_rate(progress), >, 0);
+	g_assert_cmpuint(fu_progress_get_transfer_rate(progress), <, 0x400 * 10);
+	g_assert_cmpuint(fu_progress_get_eta(progress), >, 0);
+
+	/* starting a different operation resets the estimator */
+	fu_progress_set_percentage_full(progress, 0, 0x1000);
+	g_assert_cmpuint(fu_progress_get_bytes_transferred(progress), ==, 0);
+	g_assert_cmpuint(fu_progress_get_transfer_rate(progress), ==, 0);
+	g_assert_cmpuint(fu_progress_get_eta(progress), ==, 0);
 }
 
 static void
@@ -5742,6 +6402,43 @@ fu_lzma_func(void)
 	g_assert_true(ret);
 }
 
+static void
+fu_zstd_func(void)
+{
+	gboolean ret;
+	g_autoptr(GByteArray) buf_in = g_byte_array_new();
+	g_autoptr(GBytes) blob_in = NULL;
+	g_autoptr(GBytes) blob_orig = NULL;
+	g_autoptr(GBytes) blob_out = NULL;
+	g_autoptr(GError) error = NULL;
+
+#ifndef HAVE_ZSTD
+	g_test_skip("not compiled with zstd support");
+	return;
+#endif
+
+	/* create a repeating pattern */
+	for (guint i = 0; i < 10000; i++) {
+		guint8 tmp = i % 8;
+		g_byte_array_append(buf_in, &tmp, sizeof(tmp));
+	}
+	blob_in = g_bytes_new(buf_in->data, buf_in->len);
+
+	/* compress */
+	blob_out = fu_zstd_compress_bytes(blob_in, &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(blob_out);
+	g_assert_cmpint(g_bytes_get_size(blob_out), <, 500);
+
+	/* decompress */
+	blob_orig = fu_zstd_decompress_bytes(blob_out, &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(blob_orig);
+	ret = fu_bytes_compare(blob_in, blob_orig, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+}
+
 static void
 fu_efi_lz77_decompressor_func(void)
 {
@@ -5797,6 +6494,29 @@ fu_efi_lz77_decompressor_func(void)
 	g_assert_cmpstr(csum_legacy, ==, "40f7fbaff684a6bcf67c81b3079422c2529741e1");
 }
 
+static void
+fu_input_stream_checksums_func(void)
+{
+	GChecksumType checksum_types[] = {G_CHECKSUM_SHA256, G_CHECKSUM_SHA1, 0};
+	g_autofree gchar *csum_sha1 = NULL;
+	g_autofree gchar *csum_sha256 = NULL;
+	g_autoptr(GBytes) blob = g_bytes_new_static("hello world", 11);
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GInputStream) stream = g_memory_input_stream_new_from_bytes(blob);
+	g_autoptr(GPtrArray) csums = NULL;
+
+	csum_sha256 = g_compute_checksum_for_bytes(G_CHECKSUM_SHA256, blob);
+	csum_sha1 = g_compute_checksum_for_bytes(G_CHECKSUM_SHA1, blob);
+
+	/* both digests in one pass, in argument order */
+	csums = fu_input_stream_compute_checksums(stream, checksum_types, &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(csums);
+	g_assert_cmpint(csums->len, ==, 2);
+	g_assert_cmpstr(g_ptr_array_index(csums, 0), ==, csum_sha256);
+	g_assert_cmpstr(g_ptr_array_index(csums, 1), ==, csum_sha1);
+}
+
 static void
 fu_input_stream_func(void)
 {
@@ -6077,36 +6797,15 @@ fu_efi_load_option_func(void)
 	}
 }
 
-int
-main(int argc, char **argv)
+/* pure-unit tests with no shared on-disk state, safe to run in parallel */
+static void
+fu_self_test_register_common_suite(void)
 {
-	g_autofree gchar *testdatadir = NULL;
-
-	(void)g_setenv("G_TEST_SRCDIR", SRCDIR, FALSE);
-	g_test_init(&argc, &argv, NULL);
-	g_type_ensure(FU_TYPE_IFD_BIOS);
-
-	/* only critical and error are fatal */
-	g_log_set_fatal_mask(NULL, G_LOG_LEVEL_ERROR | G_LOG_LEVEL_CRITICAL);
-	(void)g_setenv("G_MESSAGES_DEBUG", "all", TRUE);
-
-	testdatadir = g_test_build_filename(G_TEST_DIST, "tests", NULL);
-	(void)g_setenv("FWUPD_DATADIR", testdatadir, TRUE);
-	(void)g_setenv("FWUPD_DATADIR_VENDOR_IDS", testdatadir, TRUE);
-	(void)g_setenv("FWUPD_LIBDIR_PKG", testdatadir, TRUE);
-	(void)g_setenv("FWUPD_SYSCONFDIR", testdatadir, TRUE);
-	(void)g_setenv("FWUPD_SYSFSFWDIR", testdatadir, TRUE);
-	(void)g_setenv("FWUPD_SYSFSFWATTRIBDIR", testdatadir, TRUE);
-	(void)g_setenv("FWUPD_SYSFSDMIDIR", testdatadir, TRUE);
-	(void)g_setenv("FWUPD_LOCALSTATEDIR", "/tmp/fwupd-self-test/var", TRUE);
-	(void)g_setenv("FWUPD_PROFILE", "1", TRUE);
-	(void)g_setenv("FWUPD_EFIVARS", "dummy", TRUE);
-	(void)g_setenv("CACHE_DIRECTORY", "/tmp/fwupd-self-test/cache", TRUE);
-
 	g_test_add_func("/fwupd/efi-lz77{decompressor}", fu_efi_lz77_decompressor_func);
 	g_test_add_func("/fwupd/input-stream", fu_input_stream_func);
 	g_test_add_func("/fwupd/input-stream{sum-overflow}", fu_input_stream_sum_overflow_func);
 	g_test_add_func("/fwupd/input-stream{chunkify}", fu_input_stream_chunkify_func);
+	g_test_add_func("/fwupd/input-stream{checksums}", fu_input_stream_checksums_func);
 	g_test_add_func("/fwupd/input-stream{find}", fu_input_stream_find_func);
 	g_test_add_func("/fwupd/partial-input-stream", fu_partial_input_stream_func);
 	g_test_add_func("/fwupd/partial-input-stream{simple}", fu_partial_input_stream_simple_func);
@@ -6114,49 +6813,37 @@ main(int argc, char **argv)
 	g_test_add_func("/fwupd/struct", fu_plugin_struct_func);
 	g_test_add_func("/fwupd/struct{bits}", fu_plugin_struct_bits_func);
 	g_test_add_func("/fwupd/struct{wrapped}", fu_plugin_struct_wrapped_func);
-	g_test_add_func("/fwupd/plugin{quirks-append}", fu_plugin_quirks_append_func);
-	g_test_add_func("/fwupd/quirks{vendor-ids}", fu_quirks_vendor_ids_func);
 	g_test_add_func("/fwupd/string{password-mask}", fu_strpassmask_func);
 	g_test_add_func("/fwupd/string{strsplit-stream}", fu_strsplit_stream_func);
 	g_test_add_func("/fwupd/lzma", fu_lzma_func);
+	g_test_add_func("/fwupd/zstd", fu_zstd_func);
 	g_test_add_func("/fwupd/common{strnsplit}", fu_strsplit_func);
 	g_test_add_func("/fwupd/common{olson-timezone-id}", fu_common_olson_timezone_id_func);
 	g_test_add_func("/fwupd/common{memmem}", fu_common_memmem_func);
+	g_test_add_func("/fwupd/mem{tracker}", fu_mem_tracker_func);
 	if (g_test_slow())
 		g_test_add_func("/fwupd/progress", fu_progress_func);
+	g_test_add_func("/fwupd/progress{emit-interval}", fu_progress_emit_interval_func);
+	g_test_add_func("/fwupd/progress{transfer-rate}", fu_progress_transfer_rate_func);
 	g_test_add_func("/fwupd/progress{scaling}", fu_progress_scaling_func);
 	g_test_add_func("/fwupd/progress{child}", fu_progress_child_func);
 	g_test_add_func("/fwupd/progress{child-finished}", fu_progress_child_finished);
 	g_test_add_func("/fwupd/progress{parent-1-step}", fu_progress_parent_one_step_proxy_func);
 	g_test_add_func("/fwupd/progress{no-equal}", fu_progress_non_equal_steps_func);
 	g_test_add_func("/fwupd/progress{finish}", fu_progress_finish_func);
-	g_test_add_func("/fwupd/bios-attrs{load}", fu_bios_settings_load_func);
 	g_test_add_func("/fwupd/security-attrs{hsi}", fu_security_attrs_hsi_func);
 	g_test_add_func("/fwupd/security-attrs{compare}", fu_security_attrs_compare_func);
-	g_test_add_func("/fwupd/config", fu_config_func);
-	g_test_add_func("/fwupd/plugin", fu_plugin_func);
-	g_test_add_func("/fwupd/plugin{vfuncs}", fu_plugin_vfuncs_func);
-	g_test_add_func("/fwupd/plugin{device-gtype}", fu_plugin_device_gtype_func);
-	g_test_add_func("/fwupd/plugin{backend-device}", fu_plugin_backend_device_func);
-	g_test_add_func("/fwupd/plugin{backend-proxy-device}", fu_plugin_backend_proxy_device_func);
-	g_test_add_func("/fwupd/plugin{config}", fu_plugin_config_func);
-	g_test_add_func("/fwupd/plugin{devices}", fu_plugin_devices_func);
-	g_test_add_func("/fwupd/plugin{device-inhibit-children}",
-			fu_plugin_device_inhibit_children_func);
-	g_test_add_func("/fwupd/plugin{delay}", fu_plugin_delay_func);
-	g_test_add_func("/fwupd/plugin{quirks}", fu_plugin_quirks_func);
-	g_test_add_func("/fwupd/plugin{fdt}", fu_plugin_fdt_func);
-	g_test_add_func("/fwupd/plugin{quirks-performance}", fu_plugin_quirks_performance_func);
-	g_test_add_func("/fwupd/plugin{quirks-device}", fu_plugin_quirks_device_func);
-	g_test_add_func("/fwupd/backend", fu_backend_func);
-	g_test_add_func("/fwupd/backend{emulate}", fu_backend_emulate_func);
 	g_test_add_func("/fwupd/chunk", fu_chunk_func);
 	g_test_add_func("/fwupd/chunks", fu_chunk_array_func);
+	g_test_add_func("/fwupd/chunks{pipelined}", fu_chunk_array_pipelined_func);
+	g_test_add_func("/fwupd/chunks{zero-copy}", fu_chunk_array_zero_copy_func);
 	g_test_add_func("/fwupd/common{align-up}", fu_common_align_up_func);
 	g_test_add_func("/fwupd/volume{gpt-type}", fu_volume_gpt_type_func);
 	g_test_add_func("/fwupd/common{bitwise}", fu_common_bitwise_func);
 	g_test_add_func("/fwupd/common{byte-array}", fu_common_byte_array_func);
 	g_test_add_func("/fwupd/common{crc}", fu_common_crc_func);
+	g_test_add_func("/fwupd/common{crc32-large}", fu_common_crc32_large_func);
+	g_test_add_func("/fwupd/common{sum}", fu_common_sum_func);
 	g_test_add_func("/fwupd/common{string-append-kv}", fu_string_append_func);
 	g_test_add_func("/fwupd/common{version-guess-format}", fu_version_guess_format_func);
 	g_test_add_func("/fwupd/common{strtoull}", fu_strtoull_func);
@@ -6173,7 +6860,41 @@ main(int argc, char **argv)
 	g_test_add_func("/fwupd/msgpack{binary-stream}", fu_msgpack_binary_stream_func);
 	g_test_add_func("/fwupd/msgpack{parse-binary}", fu_msgpack_parse_binary_func);
 	g_test_add_func("/fwupd/msgpack{lookup}", fu_msgpack_lookup_func);
+	g_test_add_func("/fwupd/string{utf16}", fu_string_utf16_func);
+	g_test_add_func("/fwupd/smbios", fu_smbios_func);
+	g_test_add_func("/fwupd/smbios3", fu_smbios3_func);
+	g_test_add_func("/fwupd/kernel{cmdline}", fu_kernel_cmdline_func);
+	g_test_add_func("/fwupd/kernel{config}", fu_kernel_config_func);
+}
+
+/* these touch shared paths such as /tmp/fwupd-self-test and the quirk silo
+ * cache, so the suite has to stay serial with respect to the other tests */
+static void
+fu_self_test_register_plugin_suite(void)
+{
+	g_test_add_func("/fwupd/plugin{quirks-append}", fu_plugin_quirks_append_func);
+	g_test_add_func("/fwupd/plugin{quirks-batch}", fu_plugin_quirks_batch_func);
+	g_test_add_func("/fwupd/quirks{vendor-ids}", fu_quirks_vendor_ids_func);
+	g_test_add_func("/fwupd/bios-attrs{load}", fu_bios_settings_load_func);
+	g_test_add_func("/fwupd/config", fu_config_func);
+	g_test_add_func("/fwupd/plugin", fu_plugin_func);
+	g_test_add_func("/fwupd/plugin{vfuncs}", fu_plugin_vfuncs_func);
+	g_test_add_func("/fwupd/plugin{device-gtype}", fu_plugin_device_gtype_func);
+	g_test_add_func("/fwupd/plugin{backend-device}", fu_plugin_backend_device_func);
+	g_test_add_func("/fwupd/plugin{backend-proxy-device}", fu_plugin_backend_proxy_device_func);
+	g_test_add_func("/fwupd/plugin{config}", fu_plugin_config_func);
+	g_test_add_func("/fwupd/plugin{devices}", fu_plugin_devices_func);
+	g_test_add_func("/fwupd/plugin{device-inhibit-children}",
+			fu_plugin_device_inhibit_children_func);
+	g_test_add_func("/fwupd/plugin{delay}", fu_plugin_delay_func);
+	g_test_add_func("/fwupd/plugin{quirks}", fu_plugin_quirks_func);
+	g_test_add_func("/fwupd/plugin{fdt}", fu_plugin_fdt_func);
+	g_test_add_func("/fwupd/plugin{quirks-performance}", fu_plugin_quirks_performance_func);
+	g_test_add_func("/fwupd/plugin{quirks-device}", fu_plugin_quirks_device_func);
+	g_test_add_func("/fwupd/backend", fu_backend_func);
+	g_test_add_func("/fwupd/backend{emulate}", fu_backend_emulate_func);
 	g_test_add_func("/fwupd/efi-load-option", fu_efi_load_option_func);
+	g_test_add_func("/fwupd/efi-signature-list{missing}", fu_efi_signature_list_missing_func);
 	g_test_add_func("/fwupd/efivar", fu_efivar_func);
 	g_test_add_func("/fwupd/efivar{bootxxxx}", fu_efivar_boot_func);
 	g_test_add_func("/fwupd/hwids", fu_hwids_func);
@@ -6183,20 +6904,24 @@ main(int argc, char **argv)
 	g_test_add_func("/fwupd/context{firmware-gtypes}", fu_context_firmware_gtypes_func);
 	g_test_add_func("/fwupd/context{state}", fu_context_state_func);
 	g_test_add_func("/fwupd/context{udev-subsystems}", fu_context_udev_subsystems_func);
-	g_test_add_func("/fwupd/string{utf16}", fu_string_utf16_func);
-	g_test_add_func("/fwupd/smbios", fu_smbios_func);
-	g_test_add_func("/fwupd/smbios3", fu_smbios3_func);
-	g_test_add_func("/fwupd/kernel{cmdline}", fu_kernel_cmdline_func);
-	g_test_add_func("/fwupd/kernel{config}", fu_kernel_config_func);
+}
+
+/* firmware parsers only read distributed test data, safe to run in parallel */
+static void
+fu_self_test_register_firmware_suite(void)
+{
 	g_test_add_func("/fwupd/hid{descriptor}", fu_hid_descriptor_func);
 	g_test_add_func("/fwupd/hid{descriptor-container}", fu_hid_descriptor_container_func);
+	g_test_add_func("/fwupd/hid{descriptor-cache}", fu_hid_descriptor_cache_func);
 	g_test_add_func("/fwupd/firmware", fu_firmware_func);
 	g_test_add_func("/fwupd/firmware{common}", fu_firmware_common_func);
 	g_test_add_func("/fwupd/firmware{convert-version}", fu_firmware_convert_version_func);
 	g_test_add_func("/fwupd/firmware{csv}", fu_firmware_csv_func);
 	g_test_add_func("/fwupd/firmware{archive}", fu_firmware_archive_func);
+	g_test_add_func("/fwupd/firmware{archive-on-demand}", fu_firmware_archive_on_demand_func);
 	g_test_add_func("/fwupd/firmware{linear}", fu_firmware_linear_func);
 	g_test_add_func("/fwupd/firmware{dedupe}", fu_firmware_dedupe_func);
+	g_test_add_func("/fwupd/firmware{image-index}", fu_firmware_image_index_func);
 	g_test_add_func("/fwupd/firmware{build}", fu_firmware_build_func);
 	g_test_add_func("/fwupd/firmware{raw-aligned}", fu_firmware_raw_aligned_func);
 	g_test_add_func("/fwupd/firmware{ihex}", fu_firmware_ihex_func);
@@ -6209,6 +6934,7 @@ main(int argc, char **argv)
 	g_test_add_func("/fwupd/firmware{ifwi-cpd}", fu_firmware_ifwi_cpd_func);
 	g_test_add_func("/fwupd/firmware{ifwi-fpt}", fu_firmware_ifwi_fpt_func);
 	g_test_add_func("/fwupd/firmware{oprom}", fu_firmware_oprom_func);
+	g_test_add_func("/fwupd/firmware{delta}", fu_firmware_delta_func);
 	g_test_add_func("/fwupd/firmware{dfu}", fu_firmware_dfu_func);
 	g_test_add_func("/fwupd/firmware{dfu-patch}", fu_firmware_dfu_patch_func);
 	g_test_add_func("/fwupd/firmware{dfuse}", fu_firmware_dfuse_func);
@@ -6217,6 +6943,12 @@ main(int argc, char **argv)
 	g_test_add_func("/fwupd/firmware{gtypes}", fu_firmware_new_from_gtypes_func);
 	g_test_add_func("/fwupd/archive{invalid}", fu_archive_invalid_func);
 	g_test_add_func("/fwupd/archive{cab}", fu_archive_cab_func);
+}
+
+/* FuDevice tests only use in-process state, safe to run in parallel */
+static void
+fu_self_test_register_device_suite(void)
+{
 	g_test_add_func("/fwupd/device", fu_device_func);
 	g_test_add_func("/fwupd/device{event}", fu_device_event_func);
 	g_test_add_func("/fwupd/device{event-donor}", fu_device_event_donor_func);
@@ -6226,6 +6958,7 @@ main(int argc, char **argv)
 	g_test_add_func("/fwupd/device{flags}", fu_device_flags_func);
 	g_test_add_func("/fwupd/device{private-flags}", fu_device_custom_flags_func);
 	g_test_add_func("/fwupd/device{inhibit}", fu_device_inhibit_func);
+	g_test_add_func("/fwupd/device{verify-kind}", fu_device_verify_kind_func);
 	g_test_add_func("/fwupd/device{inhibit-updateable}", fu_device_inhibit_updateable_func);
 	g_test_add_func("/fwupd/device{parent}", fu_device_parent_func);
 	g_test_add_func("/fwupd/device{children}", fu_device_children_func);
@@ -6244,7 +6977,52 @@ main(int argc, char **argv)
 	g_test_add_func("/fwupd/device{retry-success}", fu_device_retry_success_func);
 	g_test_add_func("/fwupd/device{retry-failed}", fu_device_retry_failed_func);
 	g_test_add_func("/fwupd/device{retry-hardware}", fu_device_retry_hardware_func);
+	g_test_add_func("/fwupd/device{retry-failure-budget}", fu_device_retry_failure_budget_func);
+	g_test_add_func("/fwupd/device{retry-deadline}", fu_device_retry_deadline_func);
 	g_test_add_func("/fwupd/device{cfi-device}", fu_device_cfi_device_func);
 	g_test_add_func("/fwupd/device{progress}", fu_plugin_device_progress_func);
+}
+
+int
+main(int argc, char **argv)
+{
+	struct {
+		const gchar *name;
+		void (*register_func)(void);
+	} suites[] = {
+	    {"common", fu_self_test_register_common_suite},
+	    {"plugin", fu_self_test_register_plugin_suite},
+	    {"firmware", fu_self_test_register_firmware_suite},
+	    {"device", fu_self_test_register_device_suite},
+	};
+	const gchar *suite_name = g_getenv("FWUPD_SELF_TEST_SUITE");
+	g_autofree gchar *testdatadir = NULL;
+
+	(void)g_setenv("G_TEST_SRCDIR", SRCDIR, FALSE);
+	g_test_init(&argc, &argv, NULL);
+	g_type_ensure(FU_TYPE_IFD_BIOS);
+
+	/* only critical and error are fatal */
+	g_log_set_fatal_mask(NULL, G_LOG_LEVEL_ERROR | G_LOG_LEVEL_CRITICAL);
+	(void)g_setenv("G_MESSAGES_DEBUG", "all", TRUE);
+
+	testdatadir = g_test_build_filename(G_TEST_DIST, "tests", NULL);
+	(void)g_setenv("FWUPD_DATADIR", testdatadir, TRUE);
+	(void)g_setenv("FWUPD_DATADIR_VENDOR_IDS", testdatadir, TRUE);
+	(void)g_setenv("FWUPD_LIBDIR_PKG", testdatadir, TRUE);
+	(void)g_setenv("FWUPD_SYSCONFDIR", testdatadir, TRUE);
+	(void)g_setenv("FWUPD_SYSFSFWDIR", testdatadir, TRUE);
+	(void)g_setenv("FWUPD_SYSFSFWATTRIBDIR", testdatadir, TRUE);
+	(void)g_setenv("FWUPD_SYSFSDMIDIR", testdatadir, TRUE);
+	(void)g_setenv("FWUPD_LOCALSTATEDIR", "/tmp/fwupd-self-test/var", TRUE);
+	(void)g_setenv("FWUPD_PROFILE", "1", TRUE);
+	(void)g_setenv("FWUPD_EFIVARS", "dummy", TRUE);
+	(void)g_setenv("CACHE_DIRECTORY", "/tmp/fwupd-self-test/cache", TRUE);
+
+	/* all suites when unsharded, one suite per worker process when sharded */
+	for (guint i = 0; i < G_N_ELEMENTS(suites); i++) {
+		if (suite_name == NULL || g_strcmp0(suite_name, suites[i].name) == 0)
+			suites[i].register_func();
+	}
 	return g_test_run();
 }
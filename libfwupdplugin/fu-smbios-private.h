@@ -10,6 +10,8 @@
 
 gboolean
 fu_smbios_setup(FuSmbios *self, GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
+void
+fu_smbios_set_setup_lazy(FuSmbios *self) G_GNUC_NON_NULL(1);
 gboolean
 fu_smbios_setup_from_path(FuSmbios *self,
 			  const gchar *path,
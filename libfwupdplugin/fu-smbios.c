@@ -38,18 +38,58 @@
 struct _FuSmbios {
 	FuFirmware parent_instance;
 	guint32 structure_table_len;
+	gboolean setup_lazy;
 	GPtrArray *items;
+	GStringChunk *string_chunk; /* interned, so duplicate strings are stored once */
 };
 
 typedef struct {
 	guint8 type;
 	guint16 handle;
-	GByteArray *buf;
-	GPtrArray *strings;
+	GBytes *blob;	    /* the whole structure table */
+	gsize offset;	    /* of the formatted area in ::blob */
+	guint8 length;	    /* of the formatted area */
+	GPtrArray *strings; /* (element-type utf8): interned in ::string_chunk */
 } FuSmbiosItem;
 
 G_DEFINE_TYPE(FuSmbios, fu_smbios, FU_TYPE_FIRMWARE)
 
+/* set by fu_smbios_set_setup_lazy() when the HWID values came from the per-boot
+ * cache; the hardware tables are then only parsed if something needs them */
+static void
+fu_smbios_ensure_setup(FuSmbios *self)
+{
+	g_autoptr(GError) error_local = NULL;
+
+	if (!self->setup_lazy || self->items->len > 0)
+		return;
+	self->setup_lazy = FALSE;
+	if (!fu_smbios_setup(self, &error_local))
+		g_warning("failed to lazy-setup SMBIOS: %s", error_local->message);
+}
+
+/**
+ * fu_smbios_set_setup_lazy:
+ * @self: a #FuSmbios
+ *
+ * Defers reading the SMBIOS values from the hardware until they are first used.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_smbios_set_setup_lazy(FuSmbios *self)
+{
+	g_return_if_fail(FU_IS_SMBIOS(self));
+	self->setup_lazy = TRUE;
+}
+
+static const guint8 *
+fu_smbios_item_get_data(FuSmbiosItem *item)
+{
+	const guint8 *data = g_bytes_get_data(item->blob, NULL);
+	return data + item->offset;
+}
+
 static FuSmbiosItem *
 fu_smbios_get_item_for_type(FuSmbios *self, guint8 type)
 {
@@ -64,6 +104,8 @@ fu_smbios_get_item_for_type(FuSmbios *self, guint8 type)
 static gboolean
 fu_smbios_setup_from_data(FuSmbios *self, const guint8 *buf, gsize bufsz, GError **error)
 {
+	g_autoptr(GBytes) blob = g_bytes_new(buf, bufsz);
+
 	/* go through each structure */
 	for (gsize i = 0; i < bufsz; i++) {
 		FuSmbiosItem *item;
@@ -92,21 +134,24 @@ fu_smbios_setup_from_data(FuSmbios *self, const guint8 *buf, gsize bufsz, GError
 			return FALSE;
 		}
 
-		/* create a new result */
+		/* create a new result, referencing the formatted area rather than
+		 * copying it -- one retained blob serves every structure */
 		item = g_new0(FuSmbiosItem, 1);
 		item->type = fu_struct_smbios_structure_get_type(st_str);
 		item->handle = fu_struct_smbios_structure_get_handle(st_str);
-		item->buf = g_byte_array_sized_new(length);
-		item->strings = g_ptr_array_new_with_free_func(g_free);
-		g_byte_array_append(item->buf, buf + i, length);
+		item->blob = g_bytes_ref(blob);
+		item->offset = i;
+		item->length = length;
+		item->strings = g_ptr_array_new();
 		g_ptr_array_add(self->items, item);
 
 		/* jump to the end of the formatted area of the struct */
 		i += length;
 
-		/* add strings from table */
+		/* add strings from table, interned so that e.g. a server with dozens of
+		 * identical "NO DIMM" strings stores the bytes only once */
 		while (i < bufsz) {
-			GString *str;
+			g_autoptr(GString) str = NULL;
 
 			/* end of string section */
 			if (item->strings->len > 0 && buf[i] == 0x0)
@@ -115,7 +160,8 @@ fu_smbios_setup_from_data(FuSmbios *self, const guint8 *buf, gsize bufsz, GError
 			/* copy into string table */
 			str = fu_strdup((const gchar *)buf, bufsz, i);
 			i += str->len + 1;
-			g_ptr_array_add(item->strings, g_string_free(str, FALSE));
+			g_ptr_array_add(item->strings,
+					g_string_chunk_insert_const(self->string_chunk, str->str));
 		}
 	}
 
@@ -438,7 +484,7 @@ fu_smbios_export(FuFirmware *firmware, FuFirmwareExportFlags flags, XbBuilderNod
 		FuSmbiosItem *item = g_ptr_array_index(self->items, i);
 		g_autoptr(XbBuilderNode) bc = xb_builder_node_insert(bn, "item", NULL);
 		fu_xmlb_builder_insert_kx(bc, "type", item->type);
-		fu_xmlb_builder_insert_kx(bc, "length", item->buf->len);
+		fu_xmlb_builder_insert_kx(bc, "length", item->length);
 		fu_xmlb_builder_insert_kx(bc, "handle", item->handle);
 		for (guint j = 0; j < item->strings->len; j++) {
 			const gchar *tmp = g_ptr_array_index(item->strings, j);
@@ -469,10 +515,15 @@ fu_smbios_get_data(FuSmbios *self, guint8 type, GError **error)
 	g_return_val_if_fail(FU_IS_SMBIOS(self), NULL);
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
+	fu_smbios_ensure_setup(self);
 	for (guint i = 0; i < self->items->len; i++) {
 		FuSmbiosItem *item = g_ptr_array_index(self->items, i);
-		if (item->type == type && item->buf->len > 0)
-			g_ptr_array_add(array, g_bytes_new(item->buf->data, item->buf->len));
+		if (item->type == type && item->length > 0) {
+			g_ptr_array_add(array,
+					g_bytes_new_from_bytes(item->blob,
+							       item->offset,
+							       item->length));
+		}
 	}
 	if (array->len == 0) {
 		g_set_error(error,
@@ -510,6 +561,7 @@ fu_smbios_get_integer(FuSmbios *self, guint8 type, guint8 offset, GError **error
 	g_return_val_if_fail(error == NULL || *error == NULL, 0);
 
 	/* get item */
+	fu_smbios_ensure_setup(self);
 	item = fu_smbios_get_item_for_type(self, type);
 	if (item == NULL) {
 		g_set_error(error,
@@ -521,17 +573,17 @@ fu_smbios_get_integer(FuSmbios *self, guint8 type, guint8 offset, GError **error
 	}
 
 	/* check offset valid */
-	if (offset >= item->buf->len) {
+	if (offset >= item->length) {
 		g_set_error(error,
 			    FWUPD_ERROR,
 			    FWUPD_ERROR_INVALID_FILE,
 			    "offset bigger than size %u",
-			    item->buf->len);
+			    item->length);
 		return G_MAXUINT;
 	}
 
 	/* success */
-	return item->buf->data[offset];
+	return fu_smbios_item_get_data(item)[offset];
 }
 
 /**
@@ -559,6 +611,7 @@ fu_smbios_get_string(FuSmbios *self, guint8 type, guint8 offset, GError **error)
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
 	/* get item */
+	fu_smbios_ensure_setup(self);
 	item = fu_smbios_get_item_for_type(self, type);
 	if (item == NULL) {
 		g_set_error(error,
@@ -570,21 +623,21 @@ fu_smbios_get_string(FuSmbios *self, guint8 type, guint8 offset, GError **error)
 	}
 
 	/* check offset valid */
-	if (offset >= item->buf->len) {
+	if (offset >= item->length) {
 		g_set_error(error,
 			    FWUPD_ERROR,
 			    FWUPD_ERROR_INVALID_FILE,
 			    "offset bigger than size %u",
-			    item->buf->len);
+			    item->length);
 		return NULL;
 	}
-	if (item->buf->data[offset] == 0x00) {
+	if (fu_smbios_item_get_data(item)[offset] == 0x00) {
 		g_set_error(error, FWUPD_ERROR, FWUPD_ERROR_NOT_FOUND, "no data available");
 		return NULL;
 	}
 
 	/* check string index valid */
-	if (item->buf->data[offset] > item->strings->len) {
+	if (fu_smbios_item_get_data(item)[offset] > item->strings->len) {
 		g_set_error(error,
 			    FWUPD_ERROR,
 			    FWUPD_ERROR_INVALID_FILE,
@@ -592,13 +645,13 @@ fu_smbios_get_string(FuSmbios *self, guint8 type, guint8 offset, GError **error)
 			    item->strings->len);
 		return NULL;
 	}
-	return g_ptr_array_index(item->strings, item->buf->data[offset] - 1);
+	return g_ptr_array_index(item->strings, fu_smbios_item_get_data(item)[offset] - 1);
 }
 
 static void
 fu_smbios_item_free(FuSmbiosItem *item)
 {
-	g_byte_array_unref(item->buf);
+	g_bytes_unref(item->blob);
 	g_ptr_array_unref(item->strings);
 	g_free(item);
 }
@@ -608,6 +661,7 @@ fu_smbios_finalize(GObject *object)
 {
 	FuSmbios *self = FU_SMBIOS(object);
 	g_ptr_array_unref(self->items);
+	g_string_chunk_free(self->string_chunk);
 	G_OBJECT_CLASS(fu_smbios_parent_class)->finalize(object);
 }
 
@@ -625,6 +679,7 @@ static void
 fu_smbios_init(FuSmbios *self)
 {
 	self->items = g_ptr_array_new_with_free_func((GDestroyNotify)fu_smbios_item_free);
+	self->string_chunk = g_string_chunk_new(0x1000);
 }
 
 /**
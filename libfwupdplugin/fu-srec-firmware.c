@@ -14,6 +14,7 @@
 #include "fu-chunk-array.h"
 #include "fu-common.h"
 #include "fu-firmware-common.h"
+#include "fu-mem.h"
 #include "fu-srec-firmware.h"
 #include "fu-string.h"
 
@@ -170,6 +171,7 @@ fu_srec_firmware_tokenize_cb(GString *token, guint token_idx, gpointer user_data
 	FuSrecFirmwareTokenHelper *helper = (FuSrecFirmwareTokenHelper *)user_data;
 	FuSrecFirmwarePrivate *priv = GET_PRIVATE(helper->self);
 	g_autoptr(FuSrecFirmwareRecord) rcd = NULL;
+	g_autofree guint8 *buf = NULL;
 	gboolean require_data = FALSE;
 	guint32 rec_addr32;
 	guint16 rec_addr16;
@@ -229,28 +231,29 @@ fu_srec_firmware_tokenize_cb(GString *token, guint token_idx, gpointer user_data
 			    (guint)rec_count * 2);
 		return FALSE;
 	}
+	if (rec_count == 0) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_FILE,
+			    "count invalid at line %u",
+			    token_idx + 1);
+		return FALSE;
+	}
+
+	/* convert the address, data and checksum in one pass */
+	buf = g_malloc0(rec_count);
+	if (!fu_firmware_strparse_buf_safe(token->str, token->len, 4, buf, rec_count, error)) {
+		g_prefix_error(error, "invalid data at line %u: ", token_idx + 1);
+		return FALSE;
+	}
 
 	/* checksum check */
 	if ((helper->flags & FWUPD_INSTALL_FLAG_IGNORE_CHECKSUM) == 0) {
-		guint8 rec_csum = 0;
-		guint8 rec_csum_expected;
-		for (guint8 i = 0; i < rec_count; i++) {
-			guint8 csum_tmp = 0;
-			if (!fu_firmware_strparse_uint8_safe(token->str,
-							     token->len,
-							     (i * 2) + 2,
-							     &csum_tmp,
-							     error))
-				return FALSE;
-			rec_csum += csum_tmp;
-		}
+		guint8 rec_csum = rec_count;
+		guint8 rec_csum_expected = buf[rec_count - 1];
+		for (guint8 i = 0; i < rec_count - 1; i++)
+			rec_csum += buf[i];
 		rec_csum ^= 0xff;
-		if (!fu_firmware_strparse_uint8_safe(token->str,
-						     token->len,
-						     (rec_count * 2) + 2,
-						     &rec_csum_expected,
-						     error))
-			return FALSE;
 		if (rec_csum != rec_csum_expected) {
 			g_set_error(error,
 				    FWUPD_ERROR,
@@ -311,28 +314,21 @@ fu_srec_firmware_tokenize_cb(GString *token, guint token_idx, gpointer user_data
 	/* parse address */
 	switch (addrsz) {
 	case 2:
-		if (!fu_firmware_strparse_uint16_safe(token->str,
-						      token->len,
-						      4,
-						      &rec_addr16,
-						      error))
+		if (!fu_memread_uint16_safe(buf,
+					    rec_count,
+					    0x0,
+					    &rec_addr16,
+					    G_BIG_ENDIAN,
+					    error))
 			return FALSE;
 		rec_addr32 = rec_addr16;
 		break;
 	case 3:
-		if (!fu_firmware_strparse_uint24_safe(token->str,
-						      token->len,
-						      4,
-						      &rec_addr32,
-						      error))
+		if (!fu_memread_uint24_safe(buf, rec_count, 0x0, &rec_addr32, G_BIG_ENDIAN, error))
 			return FALSE;
 		break;
 	case 4:
-		if (!fu_firmware_strparse_uint32_safe(token->str,
-						      token->len,
-						      4,
-						      &rec_addr32,
-						      error))
+		if (!fu_memread_uint32_safe(buf, rec_count, 0x0, &rec_addr32, G_BIG_ENDIAN, error))
 			return FALSE;
 		break;
 	default:
@@ -354,18 +350,8 @@ fu_srec_firmware_tokenize_cb(GString *token, guint token_idx, gpointer user_data
 
 	/* data */
 	rcd = fu_srec_firmware_record_new(token_idx + 1, rec_kind, rec_addr32);
-	if (rec_kind == 1 || rec_kind == 2 || rec_kind == 3) {
-		for (gsize i = 4 + (addrsz * 2); i <= rec_count * 2; i += 2) {
-			guint8 tmp = 0;
-			if (!fu_firmware_strparse_uint8_safe(token->str,
-							     token->len,
-							     i,
-							     &tmp,
-							     error))
-				return FALSE;
-			fu_byte_array_append_uint8(rcd->buf, tmp);
-		}
-	}
+	if (rec_kind == 1 || rec_kind == 2 || rec_kind == 3)
+		g_byte_array_append(rcd->buf, buf + addrsz, rec_count - addrsz - 1);
 	g_ptr_array_add(priv->records, g_steal_pointer(&rcd));
 	return TRUE;
 }
@@ -542,6 +528,40 @@ fu_srec_firmware_parse(FuFirmware *firmware,
 	return TRUE;
 }
 
+static const gchar fu_srec_firmware_hexdigits[] = "0123456789ABCDEF";
+
+static inline void
+fu_srec_firmware_emit_hex8(GString *str, guint8 value)
+{
+	g_string_append_c(str, fu_srec_firmware_hexdigits[value >> 4]);
+	g_string_append_c(str, fu_srec_firmware_hexdigits[value & 0xF]);
+}
+
+static guint
+fu_srec_firmware_record_addrsz(FuFirmareSrecRecordKind kind)
+{
+	if (kind == FU_FIRMWARE_SREC_RECORD_KIND_S0_HEADER ||
+	    kind == FU_FIRMWARE_SREC_RECORD_KIND_S1_DATA_16 ||
+	    kind == FU_FIRMWARE_SREC_RECORD_KIND_S5_COUNT_16 ||
+	    kind == FU_FIRMWARE_SREC_RECORD_KIND_S9_TERMINATION_16)
+		return 2;
+	if (kind == FU_FIRMWARE_SREC_RECORD_KIND_S2_DATA_24 ||
+	    kind == FU_FIRMWARE_SREC_RECORD_KIND_S6_COUNT_24 ||
+	    kind == FU_FIRMWARE_SREC_RECORD_KIND_S8_TERMINATION_24)
+		return 3;
+	if (kind == FU_FIRMWARE_SREC_RECORD_KIND_S3_DATA_32 ||
+	    kind == FU_FIRMWARE_SREC_RECORD_KIND_S7_COUNT_32)
+		return 4;
+	return 0;
+}
+
+/* 'S' + kind + bytecount + address + data + checksum + '\n' */
+static gsize
+fu_srec_firmware_record_writesz(FuFirmareSrecRecordKind kind, gsize bufsz)
+{
+	return 7 + 2 * fu_srec_firmware_record_addrsz(kind) + 2 * bufsz;
+}
+
 static void
 fu_srec_firmware_write_line(GString *str,
 			    FuFirmareSrecRecordKind kind,
@@ -549,47 +569,36 @@ fu_srec_firmware_write_line(GString *str,
 			    const guint8 *buf,
 			    gsize bufsz)
 {
-	guint8 csum = 0;
-	g_autoptr(GByteArray) buf_addr = g_byte_array_new();
-
-	if (kind == FU_FIRMWARE_SREC_RECORD_KIND_S0_HEADER ||
-	    kind == FU_FIRMWARE_SREC_RECORD_KIND_S1_DATA_16 ||
-	    kind == FU_FIRMWARE_SREC_RECORD_KIND_S5_COUNT_16 ||
-	    kind == FU_FIRMWARE_SREC_RECORD_KIND_S9_TERMINATION_16) {
-		fu_byte_array_append_uint16(buf_addr, addr, G_BIG_ENDIAN);
-	} else if (kind == FU_FIRMWARE_SREC_RECORD_KIND_S2_DATA_24 ||
-		   kind == FU_FIRMWARE_SREC_RECORD_KIND_S6_COUNT_24 ||
-		   kind == FU_FIRMWARE_SREC_RECORD_KIND_S8_TERMINATION_24) {
-		fu_byte_array_append_uint32(buf_addr, addr, G_BIG_ENDIAN);
-		g_byte_array_remove_index(buf_addr, 0);
-	} else if (kind == FU_FIRMWARE_SREC_RECORD_KIND_S3_DATA_32 ||
-		   kind == FU_FIRMWARE_SREC_RECORD_KIND_S7_COUNT_32) {
-		fu_byte_array_append_uint32(buf_addr, addr, G_BIG_ENDIAN);
-	}
+	guint8 csum;
+	guint8 buf_addr[4] = {0};
+	guint addrsz = fu_srec_firmware_record_addrsz(kind);
 
 	/* bytecount + address + data */
-	csum = buf_addr->len + bufsz + 1;
-	for (guint i = 0; i < buf_addr->len; i++)
-		csum += buf_addr->data[i];
-	for (guint i = 0; i < bufsz; i++)
-		csum += buf[i];
-	csum ^= 0xff;
+	fu_memwrite_uint32(buf_addr, addr, G_BIG_ENDIAN);
+	csum = (guint8)(addrsz + bufsz + 1);
 
 	/* output record */
-	g_string_append_printf(str, "S%X", kind);
-	g_string_append_printf(str, "%02X", (guint)(buf_addr->len + bufsz + 1));
-	for (guint i = 0; i < buf_addr->len; i++)
-		g_string_append_printf(str, "%02X", buf_addr->data[i]);
-	for (guint i = 0; i < bufsz; i++)
-		g_string_append_printf(str, "%02X", buf[i]);
-	g_string_append_printf(str, "%02X\n", csum);
+	g_string_append_c(str, 'S');
+	g_string_append_c(str, fu_srec_firmware_hexdigits[kind]);
+	fu_srec_firmware_emit_hex8(str, (guint8)(addrsz + bufsz + 1));
+	for (guint i = 4 - addrsz; i < 4; i++) {
+		fu_srec_firmware_emit_hex8(str, buf_addr[i]);
+		csum += buf_addr[i];
+	}
+	for (gsize i = 0; i < bufsz; i++) {
+		fu_srec_firmware_emit_hex8(str, buf[i]);
+		csum += buf[i];
+	}
+	fu_srec_firmware_emit_hex8(str, csum ^ 0xff);
+	g_string_append_c(str, '\n');
 }
 
 static GByteArray *
 fu_srec_firmware_write(FuFirmware *firmware, GError **error)
 {
-	g_autoptr(GByteArray) buf = g_byte_array_new();
-	g_autoptr(GString) str = g_string_new(NULL);
+	gsize bufsz;
+	gsize total;
+	g_autoptr(GString) str = NULL;
 	g_autoptr(GBytes) buf_blob = NULL;
 	const gchar *id = fu_firmware_get_id(firmware);
 	gsize id_strlen = id != NULL ? strlen(id) : 0;
@@ -611,6 +620,20 @@ fu_srec_firmware_write(FuFirmware *firmware, GError **error)
 	if (buf_blob == NULL)
 		return NULL;
 
+	/* preallocate the exact output size so the per-record appends never reallocate */
+	total = fu_srec_firmware_record_writesz(FU_FIRMWARE_SREC_RECORD_KIND_S0_HEADER,
+						id_strlen);
+	if (g_bytes_get_size(buf_blob) > 0) {
+		gsize len = g_bytes_get_size(buf_blob);
+		gsize n_chunks = (len + 63) / 64;
+		if (n_chunks > G_MAXUINT16)
+			kind_coun = FU_FIRMWARE_SREC_RECORD_KIND_S6_COUNT_24;
+		total += n_chunks * fu_srec_firmware_record_writesz(kind_data, 0) + 2 * len;
+		total += fu_srec_firmware_record_writesz(kind_coun, 0);
+	}
+	total += fu_srec_firmware_record_writesz(kind_term, 0);
+	str = g_string_sized_new(total);
+
 	/* header */
 	fu_srec_firmware_write_line(str,
 				    FU_FIRMWARE_SREC_RECORD_KIND_S0_HEADER,
@@ -638,18 +661,14 @@ fu_srec_firmware_write(FuFirmware *firmware, GError **error)
 						    fu_chunk_get_data(chk),
 						    fu_chunk_get_data_sz(chk));
 		}
-		/* upgrade to longer format */
-		if (fu_chunk_array_length(chunks) > G_MAXUINT16)
-			kind_coun = FU_FIRMWARE_SREC_RECORD_KIND_S6_COUNT_24;
 		fu_srec_firmware_write_line(str, kind_coun, fu_chunk_array_length(chunks), NULL, 0);
 	}
 
-	/* EOF */
+	/* EOF, then take ownership of the buffer to avoid a copy */
 	fu_srec_firmware_write_line(str, kind_term, 0x0, NULL, 0);
-
-	/* success */
-	g_byte_array_append(buf, (const guint8 *)str->str, str->len);
-	return g_steal_pointer(&buf);
+	bufsz = str->len;
+	return g_byte_array_new_take((guint8 *)g_string_free(g_steal_pointer(&str), FALSE),
+				     bufsz);
 }
 
 static void
@@ -382,15 +382,16 @@ typedef struct {
 	const gchar *delimiter;
 	gsize delimiter_sz;
 	gboolean detected_nul;
+	GString *token; /* (not nullable): reused between every callback */
 } FuStrsplitHelper;
 
 static gboolean
 fu_strsplit_buffer_drain(GByteArray *buf, FuStrsplitHelper *helper, GError **error)
 {
+	GString *token = helper->token;
 	gsize buf_offset = 0;
 	while (buf_offset < buf->len) {
 		gsize offset;
-		g_autoptr(GString) token = g_string_new(NULL);
 
 		/* find first match in buffer, starting at the buffer offset */
 		for (offset = buf_offset; offset < buf->len; offset++) {
@@ -409,6 +410,7 @@ fu_strsplit_buffer_drain(GByteArray *buf, FuStrsplitHelper *helper, GError **err
 			break;
 
 		/* sanity check is valid UTF-8 */
+		g_string_truncate(token, 0);
 		g_string_append_len(token,
 				    (const gchar *)buf->data + buf_offset,
 				    offset - buf_offset);
@@ -458,11 +460,13 @@ fu_strsplit_stream(GInputStream *stream,
 	g_autoptr(FuChunkArray) chunks = NULL;
 	g_autoptr(GByteArray) buf = g_byte_array_new();
 	g_autoptr(GInputStream) stream_partial = NULL;
+	g_autoptr(GString) token = g_string_new(NULL);
 	FuStrsplitHelper helper = {
 	    .callback = callback,
 	    .user_data = user_data,
 	    .delimiter = delimiter,
 	    .token_idx = 0,
+	    .token = token,
 	};
 
 	g_return_val_if_fail(G_IS_INPUT_STREAM(stream), FALSE);
@@ -529,6 +533,7 @@ fu_strsplit_full(const gchar *str,
 	gsize offset_old = 0;
 	gsize str_sz;
 	guint token_idx = 0;
+	g_autoptr(GString) token = g_string_new(NULL);
 
 	g_return_val_if_fail(str != NULL, FALSE);
 	g_return_val_if_fail(delimiter != NULL && delimiter[0] != '\0', FALSE);
@@ -541,19 +546,20 @@ fu_strsplit_full(const gchar *str,
 
 	/* cannot split */
 	if (delimiter_sz > str_sz) {
-		g_autoptr(GString) token = g_string_new(str);
+		g_string_append(token, str);
 		return callback(token, token_idx, user_data, error);
 	}
 
-	/* start splittin' */
+	/* start splittin', reusing the same token buffer for each call -- parse-heavy callers
+	 * split millions of lines and the per-token allocation dominates otherwise */
 	while (offset_old <= str_sz) {
 		gsize offset;
-		g_autoptr(GString) token = g_string_new(NULL);
 
 		for (offset = offset_old; offset < str_sz; offset++) {
 			if (strncmp(str + offset, delimiter, delimiter_sz) == 0)
 				break;
 		}
+		g_string_truncate(token, 0);
 		g_string_append_len(token, str + offset_old, offset - offset_old);
 		if (!callback(token, token_idx++, user_data, error))
 			return FALSE;
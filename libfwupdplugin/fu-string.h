@@ -57,6 +57,9 @@ fu_strdup(const gchar *str, gsize bufsz, gsize offset) G_GNUC_NON_NULL(1);
  * @error: a #GError or NULL
  *
  * The fu_strsplit_full() iteration callback.
+ *
+ * The same @token is reused for every call to avoid a per-token allocation, so copy the
+ * contents with g_strdup() if they need to outlive the callback.
  */
 typedef gboolean (*FuStrsplitFunc)(GString *token,
 				   guint token_idx,
@@ -17,6 +17,9 @@
 #include <sys/ioctl.h>
 #endif
 #include <glib/gstdio.h>
+#ifdef HAVE_SCHED_SETAFFINITY
+#include <sched.h>
+#endif
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -24,6 +27,7 @@
 #include "fu-device-event-private.h"
 #include "fu-device-private.h"
 #include "fu-i2c-device.h"
+#include "fu-input-stream.h"
 #include "fu-ioctl-private.h"
 #include "fu-path.h"
 #include "fu-string.h"
@@ -48,6 +52,10 @@ typedef struct {
 	FuIoChannelOpenFlag open_flags;
 	GHashTable *properties;
 	gboolean properties_valid;
+	GHashTable *attrs; /* element-type utf8 utf8 */
+	gboolean attrs_cacheable;
+	gint sysfs_dirfd;	 /* -1 = unset */
+	gchar *sysfs_dirfd_path; /* (nullable): path the dirfd was opened for */
 } FuUdevDevicePrivate;
 
 static void
@@ -530,6 +538,10 @@ fu_udev_device_probe_complete(FuDevice *device)
 	FuUdevDevicePrivate *priv = GET_PRIVATE(self);
 	g_hash_table_remove_all(priv->properties);
 	priv->properties_valid = FALSE;
+
+	/* plugins polling an attribute after this point always want fresh data */
+	g_hash_table_remove_all(priv->attrs);
+	priv->attrs_cacheable = FALSE;
 }
 
 static gboolean
@@ -644,6 +656,10 @@ fu_udev_device_invalidate(FuDevice *device)
 	FuUdevDevicePrivate *priv = GET_PRIVATE(self);
 	priv->properties_valid = FALSE;
 	g_hash_table_remove_all(priv->properties);
+
+	/* the device is going to be probed again, so cache attributes until that completes */
+	g_hash_table_remove_all(priv->attrs);
+	priv->attrs_cacheable = TRUE;
 }
 
 static void
@@ -652,10 +668,26 @@ fu_udev_device_incorporate(FuDevice *self, FuDevice *donor)
 	FuUdevDevice *uself = FU_UDEV_DEVICE(self);
 	FuUdevDevice *udonor = FU_UDEV_DEVICE(donor);
 	FuUdevDevicePrivate *priv = GET_PRIVATE(uself);
+	FuUdevDevicePrivate *priv_donor = GET_PRIVATE(udonor);
+	GHashTableIter iter;
+	gpointer key;
+	gpointer value;
 
 	g_return_if_fail(FU_IS_UDEV_DEVICE(self));
 	g_return_if_fail(FU_IS_UDEV_DEVICE(donor));
 
+	/* attributes the donor read from the same sysfs device are valid for us too */
+	if (priv->attrs_cacheable &&
+	    g_strcmp0(fu_udev_device_get_sysfs_path(uself),
+		      fu_udev_device_get_sysfs_path(udonor)) == 0) {
+		g_hash_table_iter_init(&iter, priv_donor->attrs);
+		while (g_hash_table_iter_next(&iter, &key, &value)) {
+			if (g_hash_table_contains(priv->attrs, key))
+				continue;
+			g_hash_table_insert(priv->attrs, g_strdup(key), g_strdup(value));
+		}
+	}
+
 	if (priv->device_file == NULL)
 		fu_udev_device_set_device_file(uself, fu_udev_device_get_device_file(udonor));
 	if (priv->subsystem == NULL)
@@ -1438,6 +1470,44 @@ fu_udev_device_pwrite(FuUdevDevice *self,
 #endif
 }
 
+#ifdef O_DIRECTORY
+/* a cached directory fd for the sysfs path so each attribute read costs one openat()
+ * rather than a full path resolution -- measurable with tens of thousands of reads
+ * during coldplug on big systems */
+static gint
+fu_udev_device_get_sysfs_dirfd(FuUdevDevice *self, GError **error)
+{
+	FuUdevDevicePrivate *priv = GET_PRIVATE(self);
+	const gchar *sysfs_path = fu_udev_device_get_sysfs_path(self);
+
+	/* the backend ID can change on replug */
+	if (priv->sysfs_dirfd >= 0 && g_strcmp0(priv->sysfs_dirfd_path, sysfs_path) == 0)
+		return priv->sysfs_dirfd;
+	if (priv->sysfs_dirfd >= 0) {
+		g_close(priv->sysfs_dirfd, NULL);
+		priv->sysfs_dirfd = -1;
+	}
+	priv->sysfs_dirfd = g_open(sysfs_path, O_RDONLY | O_CLOEXEC | O_DIRECTORY, 0);
+	if (priv->sysfs_dirfd < 0) {
+		g_set_error(error,
+			    G_IO_ERROR, /* nocheck:error */
+#ifdef HAVE_ERRNO_H
+			    g_io_error_from_errno(errno),
+#else
+			    G_IO_ERROR_FAILED, /* nocheck:blocked */
+#endif
+			    "failed to open %s: %s",
+			    sysfs_path,
+			    g_strerror(errno));
+		fwupd_error_convert(error);
+		return -1;
+	}
+	g_free(priv->sysfs_dirfd_path);
+	priv->sysfs_dirfd_path = g_strdup(sysfs_path);
+	return priv->sysfs_dirfd;
+}
+#endif
+
 /**
  * fu_udev_device_read_sysfs:
  * @self: a #FuUdevDevice
@@ -1447,6 +1517,10 @@ fu_udev_device_pwrite(FuUdevDevice *self,
  *
  * Reads data from a sysfs attribute, removing any newline trailing chars.
  *
+ * Values read while the device is being probed are cached in-memory, so plugins matching the
+ * same physical device do not re-read the same attribute from the kernel; the cache is dropped
+ * when probing completes, and also when the device gets a `change` uevent.
+ *
  * Returns: (transfer full): string value, or %NULL
  *
  * Since: 2.0.0
@@ -1454,9 +1528,12 @@ fu_udev_device_pwrite(FuUdevDevice *self,
 gchar *
 fu_udev_device_read_sysfs(FuUdevDevice *self, const gchar *attr, guint timeout_ms, GError **error)
 {
+	FuUdevDevicePrivate *priv = GET_PRIVATE(self);
 	FuDeviceEvent *event = NULL;
 	g_autofree gchar *event_id = NULL;
+#ifndef O_DIRECTORY
 	g_autofree gchar *path = NULL;
+#endif
 	g_autofree gchar *value = NULL;
 	g_autoptr(FuIOChannel) io_channel = NULL;
 	g_autoptr(GByteArray) buf = NULL;
@@ -1484,6 +1561,14 @@ fu_udev_device_read_sysfs(FuUdevDevice *self, const gchar *attr, guint timeout_m
 	if (event_id != NULL)
 		event = fu_device_save_event(FU_DEVICE(self), event_id);
 
+	/* perhaps another plugin already read this attribute during probe */
+	value = g_strdup(g_hash_table_lookup(priv->attrs, attr));
+	if (value != NULL) {
+		if (event != NULL)
+			fu_device_event_set_str(event, "Data", value);
+		return g_steal_pointer(&value);
+	}
+
 	/* open the file */
 	if (fu_udev_device_get_sysfs_path(self) == NULL) {
 		g_set_error_literal(error,
@@ -1492,10 +1577,36 @@ fu_udev_device_read_sysfs(FuUdevDevice *self, const gchar *attr, guint timeout_m
 				    "sysfs_path undefined");
 		return NULL;
 	}
+#ifdef O_DIRECTORY
+	{
+		gint dirfd = fu_udev_device_get_sysfs_dirfd(self, error);
+		gint fd;
+		if (dirfd < 0)
+			return NULL;
+		fd = openat(dirfd, attr, O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			g_set_error(error,
+				    G_IO_ERROR, /* nocheck:error */
+#ifdef HAVE_ERRNO_H
+				    g_io_error_from_errno(errno),
+#else
+				    G_IO_ERROR_FAILED, /* nocheck:blocked */
+#endif
+				    "failed to open %s/%s: %s",
+				    fu_udev_device_get_sysfs_path(self),
+				    attr,
+				    g_strerror(errno));
+			fwupd_error_convert(error);
+			return NULL;
+		}
+		io_channel = fu_io_channel_unix_new(fd);
+	}
+#else
 	path = g_build_filename(fu_udev_device_get_sysfs_path(self), attr, NULL);
 	io_channel = fu_io_channel_new_file(path, FU_IO_CHANNEL_OPEN_FLAG_READ, error);
 	if (io_channel == NULL)
 		return NULL;
+#endif
 	buf = fu_io_channel_read_byte_array(io_channel,
 					    -1,
 					    timeout_ms,
@@ -1521,6 +1632,10 @@ fu_udev_device_read_sysfs(FuUdevDevice *self, const gchar *attr, guint timeout_m
 	if (event != NULL)
 		fu_device_event_set_str(event, "Data", value);
 
+	/* keep for the other plugins probing this device */
+	if (priv->attrs_cacheable)
+		g_hash_table_insert(priv->attrs, g_strdup(attr), g_strdup(value));
+
 	/* success */
 	return g_steal_pointer(&value);
 }
@@ -1622,6 +1737,7 @@ fu_udev_device_write_sysfs(FuUdevDevice *self,
 			   guint timeout_ms,
 			   GError **error)
 {
+	FuUdevDevicePrivate *priv = GET_PRIVATE(self);
 	FuDeviceEvent *event = NULL;
 	g_autofree gchar *event_id = NULL;
 	g_autofree gchar *path = NULL;
@@ -1658,6 +1774,9 @@ fu_udev_device_write_sysfs(FuUdevDevice *self,
 	if (io_channel == NULL)
 		return FALSE;
 
+	/* the kernel may now report something different */
+	g_hash_table_remove(priv->attrs, attr);
+
 	/* save */
 	if (event_id != NULL)
 		event = fu_device_save_event(FU_DEVICE(self), event_id);
@@ -1690,6 +1809,7 @@ fu_udev_device_write_sysfs_byte_array(FuUdevDevice *self,
 				      guint timeout_ms,
 				      GError **error)
 {
+	FuUdevDevicePrivate *priv = GET_PRIVATE(self);
 	FuDeviceEvent *event = NULL;
 	g_autofree gchar *event_id = NULL;
 	g_autofree gchar *path = NULL;
@@ -1727,6 +1847,9 @@ fu_udev_device_write_sysfs_byte_array(FuUdevDevice *self,
 	if (io_channel == NULL)
 		return FALSE;
 
+	/* the kernel may now report something different */
+	g_hash_table_remove(priv->attrs, attr);
+
 	/* save */
 	if (event_id != NULL)
 		event = fu_device_save_event(FU_DEVICE(self), event_id);
@@ -1758,6 +1881,7 @@ fu_udev_device_write_sysfs_bytes(FuUdevDevice *self,
 				 guint timeout_ms,
 				 GError **error)
 {
+	FuUdevDevicePrivate *priv = GET_PRIVATE(self);
 	FuDeviceEvent *event = NULL;
 	g_autofree gchar *event_id = NULL;
 	g_autofree gchar *path = NULL;
@@ -1796,6 +1920,9 @@ fu_udev_device_write_sysfs_bytes(FuUdevDevice *self,
 	if (io_channel == NULL)
 		return FALSE;
 
+	/* the kernel may now report something different */
+	g_hash_table_remove(priv->attrs, attr);
+
 	/* save */
 	if (event_id != NULL)
 		event = fu_device_save_event(FU_DEVICE(self), event_id);
@@ -1806,6 +1933,127 @@ fu_udev_device_write_sysfs_bytes(FuUdevDevice *self,
 					 error);
 }
 
+#ifdef HAVE_SCHED_SETAFFINITY
+static gboolean
+fu_udev_device_parse_cpulist(const gchar *cpulist, cpu_set_t *set, GError **error)
+{
+	g_auto(GStrv) ranges = g_strsplit(cpulist, ",", -1);
+
+	CPU_ZERO(set);
+	for (guint i = 0; ranges[i] != NULL; i++) {
+		guint64 cpu_min = 0;
+		guint64 cpu_max = 0;
+		g_auto(GStrv) parts = g_strsplit(ranges[i], "-", -1);
+
+		if (!fu_strtoull(parts[0],
+				 &cpu_min,
+				 0,
+				 CPU_SETSIZE - 1,
+				 FU_INTEGER_BASE_10,
+				 error))
+			return FALSE;
+		cpu_max = cpu_min;
+		if (parts[1] != NULL) {
+			if (!fu_strtoull(parts[1],
+					 &cpu_max,
+					 cpu_min,
+					 CPU_SETSIZE - 1,
+					 FU_INTEGER_BASE_10,
+					 error))
+				return FALSE;
+		}
+		for (guint64 cpu = cpu_min; cpu <= cpu_max; cpu++)
+			CPU_SET((gint)cpu, set);
+	}
+
+	/* success */
+	return TRUE;
+}
+#endif
+
+/**
+ * fu_udev_device_set_cpu_affinity:
+ * @self: a #FuUdevDevice
+ * @error: (nullable): optional return location for an error
+ *
+ * Pins the calling thread to the CPUs local to the device, as reported by the
+ * `local_cpulist` attribute of the closest ancestor in sysfs -- typically the PCI
+ * device the IRQs are delivered to.
+ *
+ * This is useful for worker threads doing large transfers on multi-socket machines
+ * where cross-node memory traffic is expensive.
+ *
+ * Returns: %TRUE for success
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_udev_device_set_cpu_affinity(FuUdevDevice *self, GError **error)
+{
+#ifdef HAVE_SCHED_SETAFFINITY
+	cpu_set_t set;
+	g_autofree gchar *cpulist = NULL;
+	g_autofree gchar *path = NULL;
+
+	g_return_val_if_fail(FU_IS_UDEV_DEVICE(self), FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	/* sanity check */
+	if (fu_udev_device_get_sysfs_path(self) == NULL) {
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INTERNAL,
+				    "sysfs_path undefined");
+		return FALSE;
+	}
+
+	/* look for the closest ancestor that knows its locality */
+	path = g_strdup(fu_udev_device_get_sysfs_path(self));
+	while (cpulist == NULL) {
+		g_autofree gchar *dirname = NULL;
+		g_autofree gchar *fn = g_build_filename(path, "local_cpulist", NULL);
+
+		if (g_file_test(fn, G_FILE_TEST_EXISTS)) {
+			if (!g_file_get_contents(fn, &cpulist, NULL, error))
+				return FALSE;
+			break;
+		}
+		dirname = g_path_get_dirname(path);
+		if (g_strcmp0(dirname, path) == 0 || g_strcmp0(dirname, "/sys/devices") == 0) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_NOT_SUPPORTED,
+				    "no local_cpulist for %s",
+				    fu_udev_device_get_sysfs_path(self));
+			return FALSE;
+		}
+		g_free(path);
+		path = g_steal_pointer(&dirname);
+	}
+
+	/* pin the calling thread to the device-local CPUs */
+	if (!fu_udev_device_parse_cpulist(g_strchomp(cpulist), &set, error))
+		return FALSE;
+	if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_NOT_SUPPORTED,
+			    "failed to set affinity: %s",
+			    g_strerror(errno));
+		return FALSE;
+	}
+
+	/* success */
+	return TRUE;
+#else
+	g_set_error_literal(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_NOT_SUPPORTED,
+			    "sched_setaffinity() not supported");
+	return FALSE;
+#endif
+}
+
 /**
  * fu_udev_device_get_devtype:
  * @self: a #FuUdevDevice
@@ -1849,6 +2097,7 @@ fu_udev_device_dump_firmware(FuDevice *device, FuProgress *progress, GError **er
 {
 	FuUdevDevice *self = FU_UDEV_DEVICE(device);
 	FuUdevDevicePrivate *priv = GET_PRIVATE(self);
+	gint64 timestamp;
 	guint number_reads = 0;
 	g_autofree gchar *fn = NULL;
 	g_autoptr(GByteArray) buf = g_byte_array_new();
@@ -1865,9 +2114,11 @@ fu_udev_device_dump_firmware(FuDevice *device, FuProgress *progress, GError **er
 		return NULL;
 	}
 
-	/* open file */
+	/* open file, telling the kernel not to pollute the page cache */
 	file = g_file_new_for_path(priv->device_file);
-	stream = G_INPUT_STREAM(g_file_read(file, NULL, &error_local));
+	stream = fu_input_stream_from_path_full(priv->device_file,
+						FU_INPUT_STREAM_FLAG_NO_CACHE,
+						&error_local);
 	if (stream == NULL) {
 		g_set_error_literal(error,
 				    FWUPD_ERROR,
@@ -1897,6 +2148,7 @@ fu_udev_device_dump_firmware(FuDevice *device, FuProgress *progress, GError **er
 	}
 
 	/* ensure we got enough data to fill the buffer */
+	timestamp = g_get_monotonic_time();
 	while (TRUE) {
 		gssize sz;
 		guint8 tmp[32 * 1024] = {0x0};
@@ -1917,6 +2169,11 @@ fu_udev_device_dump_firmware(FuDevice *device, FuProgress *progress, GError **er
 			return NULL;
 		}
 	}
+	if (g_get_monotonic_time() > timestamp) {
+		g_debug("read 0x%x bytes at %.2f MB/s",
+			(guint)buf->len,
+			(gdouble)buf->len / (gdouble)(g_get_monotonic_time() - timestamp));
+	}
 	return g_bytes_new(buf->data, buf->len);
 }
 
@@ -2182,11 +2439,15 @@ fu_udev_device_finalize(GObject *object)
 	FuUdevDevicePrivate *priv = GET_PRIVATE(self);
 
 	g_hash_table_unref(priv->properties);
+	g_hash_table_unref(priv->attrs);
 	g_free(priv->subsystem);
 	g_free(priv->devtype);
 	g_free(priv->bind_id);
 	g_free(priv->driver);
 	g_free(priv->device_file);
+	g_free(priv->sysfs_dirfd_path);
+	if (priv->sysfs_dirfd >= 0)
+		g_close(priv->sysfs_dirfd, NULL);
 	if (priv->io_channel != NULL)
 		g_object_unref(priv->io_channel);
 
@@ -2210,6 +2471,9 @@ fu_udev_device_init(FuUdevDevice *self)
 {
 	FuUdevDevicePrivate *priv = GET_PRIVATE(self);
 	priv->properties = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+	priv->attrs = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+	priv->attrs_cacheable = TRUE;
+	priv->sysfs_dirfd = -1;
 	fu_device_set_acquiesce_delay(FU_DEVICE(self), 2500);
 	fu_device_add_flag(FU_DEVICE(self), FWUPD_DEVICE_FLAG_CAN_EMULATION_TAG);
 	g_signal_connect(FU_DEVICE(self),
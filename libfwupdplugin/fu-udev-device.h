@@ -104,6 +104,8 @@ fu_udev_device_write_sysfs_bytes(FuUdevDevice *self,
 				 GBytes *blob,
 				 guint timeout_ms,
 				 GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2, 3);
+gboolean
+fu_udev_device_set_cpu_affinity(FuUdevDevice *self, GError **error) G_GNUC_NON_NULL(1);
 const gchar *
 fu_udev_device_get_devtype(FuUdevDevice *self) G_GNUC_NON_NULL(1);
 gchar *
@@ -55,30 +55,28 @@ fu_usb_device_ds20_set_version_lowest(FuUsbDeviceDs20 *self, guint32 version_low
 }
 
 /**
- * fu_usb_device_ds20_apply_to_device:
+ * fu_usb_device_ds20_query_blob:
  * @self: a #FuUsbDeviceDs20
  * @device: a #FuUsbDevice
  * @error: (nullable): optional return location for an error
  *
- * Sets the DS20 descriptor onto @device.
+ * Reads the DS20 descriptor set from the device using a vendor control transfer.
  *
- * Returns: %TRUE for success
+ * Returns: (transfer full): the descriptor set, or %NULL on error
  *
- * Since: 1.8.5
+ * Since: 2.0.3
  **/
-gboolean
-fu_usb_device_ds20_apply_to_device(FuUsbDeviceDs20 *self, FuUsbDevice *device, GError **error)
+GBytes *
+fu_usb_device_ds20_query_blob(FuUsbDeviceDs20 *self, FuUsbDevice *device, GError **error)
 {
-	FuUsbDeviceDs20Class *klass = FU_USB_DEVICE_DS20_GET_CLASS(self);
 	gsize actual_length = 0;
 	gsize total_length = fu_firmware_get_size(FU_FIRMWARE(self));
 	guint8 vendor_code = fu_firmware_get_idx(FU_FIRMWARE(self));
 	g_autofree guint8 *buf = g_malloc0(total_length);
-	g_autoptr(GInputStream) stream = NULL;
 
-	g_return_val_if_fail(FU_IS_USB_DEVICE_DS20(self), FALSE);
-	g_return_val_if_fail(FU_IS_USB_DEVICE(device), FALSE);
-	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+	g_return_val_if_fail(FU_IS_USB_DEVICE_DS20(self), NULL);
+	g_return_val_if_fail(FU_IS_USB_DEVICE(device), NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
 	if (!fu_usb_device_control_transfer(device,
 					    FU_USB_DIRECTION_DEVICE_TO_HOST,
@@ -94,7 +92,7 @@ fu_usb_device_ds20_apply_to_device(FuUsbDeviceDs20 *self, FuUsbDevice *device, G
 					    NULL, /* cancellable */
 					    error)) {
 		g_prefix_error(error, "requested vendor code 0x%02x: ", vendor_code);
-		return FALSE;
+		return NULL;
 	}
 	if (total_length != actual_length) {
 		g_set_error(error,
@@ -104,17 +102,75 @@ fu_usb_device_ds20_apply_to_device(FuUsbDeviceDs20 *self, FuUsbDevice *device, G
 			    (guint)total_length,
 			    vendor_code,
 			    (guint)actual_length);
-		return FALSE;
+		return NULL;
 	}
 
 	/* debug */
 	fu_dump_raw(G_LOG_DOMAIN, "PlatformCapabilityOs20", buf, actual_length);
 
+	/* success */
+	return g_bytes_new_take(g_steal_pointer(&buf), actual_length);
+}
+
+/**
+ * fu_usb_device_ds20_apply_blob_to_device:
+ * @self: a #FuUsbDeviceDs20
+ * @device: a #FuUsbDevice
+ * @blob: a #GBytes, typically from fu_usb_device_ds20_query_blob()
+ * @error: (nullable): optional return location for an error
+ *
+ * Sets an already-read DS20 descriptor set onto @device, without performing any transfers.
+ *
+ * Returns: %TRUE for success
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_usb_device_ds20_apply_blob_to_device(FuUsbDeviceDs20 *self,
+					FuUsbDevice *device,
+					GBytes *blob,
+					GError **error)
+{
+	FuUsbDeviceDs20Class *klass = FU_USB_DEVICE_DS20_GET_CLASS(self);
+	g_autoptr(GInputStream) stream = NULL;
+
+	g_return_val_if_fail(FU_IS_USB_DEVICE_DS20(self), FALSE);
+	g_return_val_if_fail(FU_IS_USB_DEVICE(device), FALSE);
+	g_return_val_if_fail(blob != NULL, FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
 	/* FuUsbDeviceDs20->parse */
-	stream = g_memory_input_stream_new_from_data(buf, actual_length, NULL);
+	stream = g_memory_input_stream_new_from_bytes(blob);
 	return klass->parse(self, stream, device, error);
 }
 
+/**
+ * fu_usb_device_ds20_apply_to_device:
+ * @self: a #FuUsbDeviceDs20
+ * @device: a #FuUsbDevice
+ * @error: (nullable): optional return location for an error
+ *
+ * Sets the DS20 descriptor onto @device.
+ *
+ * Returns: %TRUE for success
+ *
+ * Since: 1.8.5
+ **/
+gboolean
+fu_usb_device_ds20_apply_to_device(FuUsbDeviceDs20 *self, FuUsbDevice *device, GError **error)
+{
+	g_autoptr(GBytes) blob = NULL;
+
+	g_return_val_if_fail(FU_IS_USB_DEVICE_DS20(self), FALSE);
+	g_return_val_if_fail(FU_IS_USB_DEVICE(device), FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	blob = fu_usb_device_ds20_query_blob(self, device, error);
+	if (blob == NULL)
+		return FALSE;
+	return fu_usb_device_ds20_apply_blob_to_device(self, device, blob, error);
+}
+
 static gboolean
 fu_usb_device_ds20_validate(FuFirmware *firmware,
 			    GInputStream *stream,
@@ -26,3 +26,11 @@ fu_usb_device_ds20_set_version_lowest(FuUsbDeviceDs20 *self, guint32 version_low
 gboolean
 fu_usb_device_ds20_apply_to_device(FuUsbDeviceDs20 *self, FuUsbDevice *device, GError **error)
     G_GNUC_NON_NULL(1, 2);
+GBytes *
+fu_usb_device_ds20_query_blob(FuUsbDeviceDs20 *self, FuUsbDevice *device, GError **error)
+    G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1, 2);
+gboolean
+fu_usb_device_ds20_apply_blob_to_device(FuUsbDeviceDs20 *self,
+					FuUsbDevice *device,
+					GBytes *blob,
+					GError **error) G_GNUC_NON_NULL(1, 2, 3);
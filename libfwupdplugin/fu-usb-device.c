@@ -17,6 +17,7 @@
 #include "fu-dump.h"
 #include "fu-input-stream.h"
 #include "fu-mem.h"
+#include "fu-path.h"
 #include "fu-string.h"
 #include "fu-usb-bos-descriptor-private.h"
 #include "fu-usb-config-descriptor-private.h"
@@ -49,6 +50,11 @@ typedef struct {
 	gint configuration;
 	GPtrArray *device_interfaces; /* (nullable) (element-type FuUsbDeviceInterface) */
 	guint claim_retry_count;
+	GHashTable *bulk_stats; /* (element-type int FuUsbDeviceBulkStats): per endpoint */
+	GHashTable *claim_refcounts; /* (element-type int uint): claim count per interface */
+	guint8 *transfer_buf; /* (nullable): scratch buffer, possibly DMA-capable */
+	gsize transfer_bufsz;
+	gboolean transfer_buf_dma;
 } FuUsbDevicePrivate;
 
 typedef struct {
@@ -56,8 +62,17 @@ typedef struct {
 	gboolean claimed;
 } FuUsbDeviceInterface;
 
+typedef struct {
+	guint transfers;
+	guint failures;
+	guint64 bytes;
+	gint64 elapsed_us;
+} FuUsbDeviceBulkStats;
+
 static void
 fu_usb_device_codec_iface_init(FwupdCodecInterface *iface);
+static void
+fu_usb_device_transfer_buf_free(FuUsbDevice *self);
 static gboolean
 fu_usb_device_ensure_interfaces(FuUsbDevice *self, GError **error);
 
@@ -271,6 +286,7 @@ fu_usb_device_finalize(GObject *object)
 	FuUsbDevice *self = FU_USB_DEVICE(object);
 	FuUsbDevicePrivate *priv = GET_PRIVATE(self);
 
+	fu_usb_device_transfer_buf_free(self);
 	if (priv->handle != NULL)
 		libusb_close(priv->handle);
 	if (priv->usb_device != NULL)
@@ -281,6 +297,8 @@ fu_usb_device_finalize(GObject *object)
 	g_ptr_array_unref(priv->bos_descriptors);
 	g_ptr_array_unref(priv->hid_descriptors);
 	g_ptr_array_unref(priv->cfg_descriptors);
+	g_hash_table_unref(priv->bulk_stats);
+	g_hash_table_unref(priv->claim_refcounts);
 
 	G_OBJECT_CLASS(fu_usb_device_parent_class)->finalize(object);
 }
@@ -294,6 +312,8 @@ fu_usb_device_init(FuUsbDevice *self)
 	priv->bos_descriptors = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
 	priv->cfg_descriptors = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
 	priv->hid_descriptors = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	priv->bulk_stats = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+	priv->claim_refcounts = g_hash_table_new(g_direct_hash, g_direct_equal);
 	fu_device_set_acquiesce_delay(FU_DEVICE(self), 2500);
 	fu_device_retry_add_recovery(FU_DEVICE(self), FWUPD_ERROR, FWUPD_ERROR_NOT_FOUND, NULL);
 	fu_device_retry_add_recovery(FU_DEVICE(self),
@@ -501,6 +521,27 @@ fu_usb_device_open_internal(FuUsbDevice *self, GError **error)
 	return TRUE;
 }
 
+static void
+fu_usb_device_transfer_buf_free(FuUsbDevice *self)
+{
+	FuUsbDevicePrivate *priv = GET_PRIVATE(self);
+
+	if (priv->transfer_buf == NULL)
+		return;
+#ifdef HAVE_LIBUSB_DEV_MEM_ALLOC
+	if (priv->transfer_buf_dma) {
+		libusb_dev_mem_free(priv->handle, priv->transfer_buf, priv->transfer_bufsz);
+		priv->transfer_buf = NULL;
+		priv->transfer_bufsz = 0;
+		priv->transfer_buf_dma = FALSE;
+		return;
+	}
+#endif
+	g_free(priv->transfer_buf);
+	priv->transfer_buf = NULL;
+	priv->transfer_bufsz = 0;
+}
+
 static gboolean
 fu_usb_device_close_internal(FuUsbDevice *self, GError **error)
 {
@@ -512,8 +553,14 @@ fu_usb_device_close_internal(FuUsbDevice *self, GError **error)
 	if (priv->handle == NULL)
 		return fu_usb_device_not_open_error(self, error);
 
+	/* the zerocopy mapping is tied to the usbfs fd, so it cannot outlive the handle */
+	fu_usb_device_transfer_buf_free(self);
+
 	libusb_close(priv->handle);
 	priv->handle = NULL;
+
+	/* any claims died with the handle */
+	g_hash_table_remove_all(priv->claim_refcounts);
 	return TRUE;
 }
 
@@ -842,11 +889,27 @@ fu_usb_device_close(FuDevice *device, GError **error)
 	return FU_DEVICE_CLASS(fu_usb_device_parent_class)->close(device, error);
 }
 
+static gchar *
+fu_usb_device_get_ds20_cache_fn(FuUsbDevice *self, FuFirmware *ds20)
+{
+	g_autofree gchar *cachedir = fu_path_from_kind(FU_PATH_KIND_CACHEDIR_PKG);
+	g_autofree gchar *basename =
+	    g_strdup_printf("%04x-%04x-%04x-%s.bin",
+			    fu_device_get_vid(FU_DEVICE(self)),
+			    fu_device_get_pid(FU_DEVICE(self)),
+			    fu_usb_device_get_release(self),
+			    fu_firmware_get_id(ds20));
+	return g_build_filename(cachedir, "usb-ds20", basename, NULL);
+}
+
 static gboolean
 fu_usb_device_probe_bos_descriptor(FuUsbDevice *self, FuUsbBosDescriptor *bos, GError **error)
 {
+	gboolean use_cache;
+	g_autofree gchar *cache_fn = NULL;
 	g_autofree gchar *str = NULL;
 	g_autoptr(FuFirmware) ds20 = NULL;
+	g_autoptr(GBytes) blob = NULL;
 	g_autoptr(GInputStream) stream = NULL;
 	g_autoptr(FuDeviceLocker) usb_locker = NULL;
 
@@ -869,6 +932,27 @@ fu_usb_device_probe_bos_descriptor(FuUsbDevice *self, FuUsbBosDescriptor *bos, G
 	str = fu_firmware_to_string(ds20);
 	g_debug("DS20: %s", str);
 
+	/* never short-circuit the transfers when recording or replaying device events */
+	use_cache = !fu_device_has_flag(FU_DEVICE(self), FWUPD_DEVICE_FLAG_EMULATED) &&
+		    !fu_context_has_flag(fu_device_get_context(FU_DEVICE(self)),
+					 FU_CONTEXT_FLAG_SAVE_EVENTS);
+
+	/* the descriptor set is immutable for a given bcdDevice, so devices we have already
+	 * seen can skip the control transfers entirely */
+	cache_fn = fu_usb_device_get_ds20_cache_fn(self, ds20);
+	if (use_cache && g_file_test(cache_fn, G_FILE_TEST_EXISTS)) {
+		g_autoptr(GError) error_local = NULL;
+		g_autoptr(GBytes) blob_cached = fu_bytes_get_contents(cache_fn, &error_local);
+		if (blob_cached != NULL &&
+		    fu_usb_device_ds20_apply_blob_to_device(FU_USB_DEVICE_DS20(ds20),
+							    self,
+							    blob_cached,
+							    &error_local)) {
+			return TRUE;
+		}
+		g_debug("ignoring cached DS20 %s: %s", cache_fn, error_local->message);
+	}
+
 	/* set the quirks onto the device */
 	usb_locker = fu_device_locker_new_full(self,
 					       (FuDeviceLockerFunc)fu_usb_device_open,
@@ -876,10 +960,22 @@ fu_usb_device_probe_bos_descriptor(FuUsbDevice *self, FuUsbBosDescriptor *bos, G
 					       error);
 	if (usb_locker == NULL)
 		return FALSE;
-	if (!fu_usb_device_ds20_apply_to_device(FU_USB_DEVICE_DS20(ds20), self, error)) {
+	blob = fu_usb_device_ds20_query_blob(FU_USB_DEVICE_DS20(ds20), self, error);
+	if (blob == NULL) {
 		g_prefix_error(error, "failed to apply DS20 data: ");
 		return FALSE;
 	}
+	if (!fu_usb_device_ds20_apply_blob_to_device(FU_USB_DEVICE_DS20(ds20),
+						     self,
+						     blob,
+						     error)) {
+		g_prefix_error(error, "failed to apply DS20 data: ");
+		return FALSE;
+	}
+
+	/* save for next time, ignoring failure as the cache directory may not be writable */
+	if (use_cache && !fu_bytes_set_contents(cache_fn, blob, NULL))
+		g_debug("failed to save DS20 descriptor set to %s", cache_fn);
 
 	/* success */
 	return TRUE;
@@ -1483,6 +1579,175 @@ fu_usb_device_control_transfer(FuUsbDevice *self,
 	return TRUE;
 }
 
+typedef struct {
+	GMutex mutex;
+	GCond cond;
+	guint pending;
+} FuUsbDeviceBatchHelper;
+
+static void LIBUSB_CALL
+fu_usb_device_control_transfer_batch_cb(struct libusb_transfer *transfer)
+{
+	FuUsbDeviceBatchHelper *helper = transfer->user_data;
+	g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&helper->mutex);
+	helper->pending--;
+	g_cond_signal(&helper->cond);
+}
+
+/**
+ * fu_usb_device_control_transfer_batch:
+ * @self: a #FuUsbDevice
+ * @requests: (array length=n_requests): requests to submit
+ * @n_requests: number of @requests
+ * @timeout: timeout timeout (in milliseconds) that each transfer should wait
+ * before giving up due to no response being received. For an unlimited
+ * timeout, use 0.
+ * @cancellable: a #GCancellable, or %NULL
+ * @error: a #GError, or %NULL
+ *
+ * Perform several USB control transfers, submitting them all asynchronously and waiting for every
+ * one to complete. This allows the device to work on the next request while the host is still
+ * processing the last reply, and so only makes sense where the requests do not depend on each
+ * other, e.g. reading back a scattered set of registers.
+ *
+ * When the device is emulated, or events are being recorded, the requests are performed one at a
+ * time so that the event stream is deterministic.
+ *
+ * Warning: this function is synchronous, and cannot be cancelled.
+ *
+ * Return value: %TRUE on success
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_usb_device_control_transfer_batch(FuUsbDevice *self,
+				     FuUsbDeviceControlRequest *requests,
+				     guint n_requests,
+				     guint timeout,
+				     GCancellable *cancellable,
+				     GError **error)
+{
+	FuUsbDevicePrivate *priv = GET_PRIVATE(self);
+	libusb_context *usb_ctx =
+	    fu_context_get_data(fu_device_get_context(FU_DEVICE(self)), "libusb_context");
+	FuUsbDeviceBatchHelper helper = {.pending = 0};
+	gboolean ret = TRUE;
+	g_autofree struct libusb_transfer **transfers = NULL;
+
+	g_return_val_if_fail(FU_IS_USB_DEVICE(self), FALSE);
+	g_return_val_if_fail(requests != NULL, FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	/* nothing to do */
+	if (n_requests == 0)
+		return TRUE;
+
+	/* perform each transfer in order when emulating or recording, or when there is no event
+	 * thread to deliver the async completions */
+	if (fu_device_has_flag(FU_DEVICE(self), FWUPD_DEVICE_FLAG_EMULATED) ||
+	    fu_context_has_flag(fu_device_get_context(FU_DEVICE(self)),
+				FU_CONTEXT_FLAG_SAVE_EVENTS) ||
+	    usb_ctx == NULL) {
+		for (guint i = 0; i < n_requests; i++) {
+			FuUsbDeviceControlRequest *req = &requests[i];
+			if (!fu_usb_device_control_transfer(self,
+							    req->direction,
+							    req->request_type,
+							    req->recipient,
+							    req->request,
+							    req->value,
+							    req->idx,
+							    req->data,
+							    req->length,
+							    &req->actual_length,
+							    timeout,
+							    cancellable,
+							    error))
+				return FALSE;
+		}
+		return TRUE;
+	}
+
+	/* sanity check */
+	if (priv->handle == NULL)
+		return fu_usb_device_not_open_error(self, error);
+
+	g_mutex_init(&helper.mutex);
+	g_cond_init(&helper.cond);
+
+	/* allocate and submit all the transfers */
+	transfers = g_new0(struct libusb_transfer *, n_requests);
+	for (guint i = 0; i < n_requests; i++) {
+		FuUsbDeviceControlRequest *req = &requests[i];
+		guint8 request_type_raw = 0;
+		guint8 *buf;
+
+		/* munge back to flags */
+		if (req->direction == FU_USB_DIRECTION_DEVICE_TO_HOST)
+			request_type_raw |= 0x80;
+		request_type_raw |= (req->request_type << 5);
+		request_type_raw |= req->recipient;
+
+		buf = g_malloc0(LIBUSB_CONTROL_SETUP_SIZE + req->length);
+		libusb_fill_control_setup(buf,
+					  request_type_raw,
+					  req->request,
+					  req->value,
+					  req->idx,
+					  req->length);
+		if (req->direction == FU_USB_DIRECTION_HOST_TO_DEVICE && req->data != NULL)
+			memcpy(buf + LIBUSB_CONTROL_SETUP_SIZE, req->data, req->length); /* nocheck:blocked */
+		transfers[i] = libusb_alloc_transfer(0);
+		libusb_fill_control_transfer(transfers[i],
+					     priv->handle,
+					     buf,
+					     fu_usb_device_control_transfer_batch_cb,
+					     &helper,
+					     timeout);
+		transfers[i]->flags = LIBUSB_TRANSFER_FREE_BUFFER;
+	}
+	g_mutex_lock(&helper.mutex);
+	for (guint i = 0; i < n_requests; i++) {
+		gint rc = libusb_submit_transfer(transfers[i]);
+		if (rc < 0) {
+			ret = fu_usb_device_libusb_error_to_gerror(rc, error);
+			break;
+		}
+		helper.pending++;
+	}
+
+	/* cancel anything already in flight on submit failure, then wait for all the completion
+	 * callbacks -- the libusb event thread delivers these */
+	if (!ret) {
+		for (guint i = 0; i < n_requests; i++) {
+			if (transfers[i] != NULL)
+				libusb_cancel_transfer(transfers[i]);
+		}
+	}
+	while (helper.pending > 0)
+		g_cond_wait(&helper.cond, &helper.mutex);
+	g_mutex_unlock(&helper.mutex);
+
+	/* aggregate the results, keeping the first failure */
+	for (guint i = 0; i < n_requests; i++) {
+		FuUsbDeviceControlRequest *req = &requests[i];
+		if (ret && transfers[i]->status != LIBUSB_TRANSFER_COMPLETED) {
+			ret = fu_usb_device_libusb_status_to_gerror(transfers[i]->status, error);
+		} else if (transfers[i]->status == LIBUSB_TRANSFER_COMPLETED) {
+			req->actual_length = transfers[i]->actual_length;
+			if (req->direction == FU_USB_DIRECTION_DEVICE_TO_HOST && req->data != NULL) {
+				memcpy(req->data, /* nocheck:blocked */
+				       libusb_control_transfer_get_data(transfers[i]),
+				       req->actual_length);
+			}
+		}
+		libusb_free_transfer(transfers[i]);
+	}
+	g_mutex_clear(&helper.mutex);
+	g_cond_clear(&helper.cond);
+	return ret;
+}
+
 /**
  * fu_usb_device_bulk_transfer:
  * @self: a #FuUsbDevice
@@ -1518,7 +1783,9 @@ fu_usb_device_bulk_transfer(FuUsbDevice *self,
 	FuUsbDevicePrivate *priv = GET_PRIVATE(self);
 	gint rc;
 	gint transferred = 0;
+	gint64 ts_start;
 	FuDeviceEvent *event = NULL;
+	FuUsbDeviceBulkStats *stats;
 	g_autofree gchar *event_id = NULL;
 
 	g_return_val_if_fail(FU_IS_USB_DEVICE(self), FALSE);
@@ -1565,12 +1832,24 @@ fu_usb_device_bulk_transfer(FuUsbDevice *self,
 	}
 
 	/* sync request */
+	ts_start = g_get_monotonic_time();
 	rc = libusb_bulk_transfer(priv->handle, endpoint, data, length, &transferred, timeout);
+
+	/* track per-endpoint throughput, useful to spot throttled or flaky links */
+	stats = g_hash_table_lookup(priv->bulk_stats, GUINT_TO_POINTER(endpoint));
+	if (stats == NULL) {
+		stats = g_new0(FuUsbDeviceBulkStats, 1);
+		g_hash_table_insert(priv->bulk_stats, GUINT_TO_POINTER(endpoint), stats);
+	}
+	stats->transfers++;
+	stats->elapsed_us += g_get_monotonic_time() - ts_start;
 	if (!fu_usb_device_libusb_error_to_gerror(rc, error)) {
+		stats->failures++;
 		if (event != NULL)
 			fu_device_event_set_i64(event, "Error", rc);
 		return FALSE;
 	}
+	stats->bytes += transferred;
 	if (actual_length != NULL)
 		*actual_length = transferred;
 
@@ -1582,6 +1861,63 @@ fu_usb_device_bulk_transfer(FuUsbDevice *self,
 	return TRUE;
 }
 
+/**
+ * fu_usb_device_get_transfer_buffer:
+ * @self: a #FuUsbDevice
+ * @length: the minimum required buffer size in bytes
+ *
+ * Gets a zeroed scratch buffer of at least @length bytes suitable for bulk transfers.
+ *
+ * Where supported by the platform the buffer is allocated with libusb_dev_mem_alloc() and is
+ * backed by a usbfs zerocopy mapping, which avoids the kernel bounce-buffering each transfer.
+ * If DMA-capable memory is not available a plain heap buffer is returned instead, so callers
+ * do not have to care which kind they got.
+ *
+ * The buffer is owned by the device and stays valid until the device is closed; do not free
+ * it, and do not use it after calling fu_device_close().
+ *
+ * Return value: (transfer none): a buffer of at least @length bytes, or %NULL if @length is 0
+ *
+ * Since: 2.0.3
+ **/
+guint8 *
+fu_usb_device_get_transfer_buffer(FuUsbDevice *self, gsize length)
+{
+	FuUsbDevicePrivate *priv = GET_PRIVATE(self);
+
+	g_return_val_if_fail(FU_IS_USB_DEVICE(self), NULL);
+
+	/* sanity check */
+	if (length == 0)
+		return NULL;
+
+	/* already big enough */
+	if (priv->transfer_buf != NULL && priv->transfer_bufsz >= length) {
+		memset(priv->transfer_buf, 0x0, priv->transfer_bufsz);
+		return priv->transfer_buf;
+	}
+
+	/* replace any existing smaller buffer */
+	fu_usb_device_transfer_buf_free(self);
+#ifdef HAVE_LIBUSB_DEV_MEM_ALLOC
+	if (priv->handle != NULL &&
+	    !fu_device_has_flag(FU_DEVICE(self), FWUPD_DEVICE_FLAG_EMULATED)) {
+		priv->transfer_buf = libusb_dev_mem_alloc(priv->handle, length);
+		if (priv->transfer_buf != NULL) {
+			priv->transfer_bufsz = length;
+			priv->transfer_buf_dma = TRUE;
+			memset(priv->transfer_buf, 0x0, priv->transfer_bufsz);
+			return priv->transfer_buf;
+		}
+		g_debug("libusb_dev_mem_alloc of 0x%x bytes failed, falling back to the heap",
+			(guint)length);
+	}
+#endif
+	priv->transfer_buf = g_malloc0(length);
+	priv->transfer_bufsz = length;
+	return priv->transfer_buf;
+}
+
 /**
  * fu_usb_device_interrupt_transfer:
  * @self: a #FuUsbDevice
@@ -1720,6 +2056,7 @@ static gboolean
 fu_usb_device_parse_descriptor(FuUsbDevice *self, GInputStream *stream, GError **error)
 {
 	FuUsbDevicePrivate *priv = GET_PRIVATE(self);
+	FuUsbDeviceHdrUnpacked st_unp = {0};
 	gsize offset = 0;
 	gsize streamsz = 0;
 	g_autoptr(FuUsbDeviceHdr) st = NULL;
@@ -1730,22 +2067,23 @@ fu_usb_device_parse_descriptor(FuUsbDevice *self, GInputStream *stream, GError *
 	st = fu_usb_device_hdr_parse_stream(stream, offset, error);
 	if (st == NULL)
 		return FALSE;
-	priv->desc.bLength = fu_usb_device_hdr_get_length(st);
-	priv->desc.bDescriptorType = FU_USB_DEVICE_HDR_DEFAULT_DESCRIPTOR_TYPE;
-	priv->desc.bcdUSB = fu_usb_device_hdr_get_usb(st);
-	priv->desc.bDeviceClass = fu_usb_device_hdr_get_device_class(st);
-	priv->desc.bDeviceSubClass = fu_usb_device_hdr_get_device_sub_class(st);
-	priv->desc.bDeviceProtocol = fu_usb_device_hdr_get_device_protocol(st);
-	priv->desc.bMaxPacketSize0 = fu_usb_device_hdr_get_max_packet_size0(st);
-	fu_device_set_vid(FU_DEVICE(self), fu_usb_device_hdr_get_vendor(st));
-	fu_device_set_pid(FU_DEVICE(self), fu_usb_device_hdr_get_product(st));
-	priv->desc.bcdDevice = fu_usb_device_hdr_get_device(st);
-	priv->desc.iManufacturer = fu_usb_device_hdr_get_manufacturer_idx(st);
-	priv->desc.iProduct = fu_usb_device_hdr_get_product_idx(st);
-	priv->desc.iSerialNumber = fu_usb_device_hdr_get_serial_number_idx(st);
-	priv->desc.bNumConfigurations = fu_usb_device_hdr_get_num_configurations(st);
-
-	offset += fu_usb_device_hdr_get_length(st);
+	fu_usb_device_hdr_unpack(st, &st_unp);
+	priv->desc.bLength = st_unp.length;
+	priv->desc.bDescriptorType = st_unp.descriptor_type;
+	priv->desc.bcdUSB = st_unp.usb;
+	priv->desc.bDeviceClass = st_unp.device_class;
+	priv->desc.bDeviceSubClass = st_unp.device_sub_class;
+	priv->desc.bDeviceProtocol = st_unp.device_protocol;
+	priv->desc.bMaxPacketSize0 = st_unp.max_packet_size0;
+	fu_device_set_vid(FU_DEVICE(self), st_unp.vendor);
+	fu_device_set_pid(FU_DEVICE(self), st_unp.product);
+	priv->desc.bcdDevice = st_unp.device;
+	priv->desc.iManufacturer = st_unp.manufacturer_idx;
+	priv->desc.iProduct = st_unp.product_idx;
+	priv->desc.iSerialNumber = st_unp.serial_number_idx;
+	priv->desc.bNumConfigurations = st_unp.num_configurations;
+
+	offset += st_unp.length;
 	while (offset < streamsz) {
 		FuUsbDescriptorKind descriptor_kind;
 		g_autoptr(FuUsbBaseHdr) st_base = NULL;
@@ -2192,6 +2530,7 @@ fu_usb_device_claim_interface(FuUsbDevice *self,
 			      GError **error)
 {
 	FuUsbDevicePrivate *priv = GET_PRIVATE(self);
+	guint claim_cnt;
 
 	g_return_val_if_fail(FU_IS_USB_DEVICE(self), FALSE);
 	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
@@ -2203,16 +2542,34 @@ fu_usb_device_claim_interface(FuUsbDevice *self,
 	if (priv->handle == NULL)
 		return fu_usb_device_not_open_error(self, error);
 
+	/* already claimed on this handle, so do not unbind the kernel driver again --
+	 * just extend the existing claim window */
+	claim_cnt = GPOINTER_TO_UINT(
+	    g_hash_table_lookup(priv->claim_refcounts, GUINT_TO_POINTER(iface)));
+	if (claim_cnt > 0) {
+		g_hash_table_insert(priv->claim_refcounts,
+				    GUINT_TO_POINTER(iface),
+				    GUINT_TO_POINTER(claim_cnt + 1));
+		return TRUE;
+	}
+
 	if (priv->claim_retry_count > 0) {
 		FuUsbDeviceClaimHelper helper = {.iface = iface, .flags = flags};
-		return fu_device_retry_full(FU_DEVICE(self),
-					    fu_usb_device_claim_interface_cb,
-					    priv->claim_retry_count,
-					    FU_DEVICE_CLAIM_INTERFACE_DELAY,
-					    &helper,
-					    error);
+		if (!fu_device_retry_full(FU_DEVICE(self),
+					  fu_usb_device_claim_interface_cb,
+					  priv->claim_retry_count,
+					  FU_DEVICE_CLAIM_INTERFACE_DELAY,
+					  &helper,
+					  error))
+			return FALSE;
+	} else {
+		if (!fu_usb_device_claim_interface_internal(self, iface, flags, error))
+			return FALSE;
 	}
-	return fu_usb_device_claim_interface_internal(self, iface, flags, error);
+
+	/* success */
+	g_hash_table_insert(priv->claim_refcounts, GUINT_TO_POINTER(iface), GUINT_TO_POINTER(1));
+	return TRUE;
 }
 
 /**
@@ -2235,6 +2592,7 @@ fu_usb_device_release_interface(FuUsbDevice *self,
 				GError **error)
 {
 	FuUsbDevicePrivate *priv = GET_PRIVATE(self);
+	guint claim_cnt;
 	gint rc;
 
 	g_return_val_if_fail(FU_IS_USB_DEVICE(self), FALSE);
@@ -2247,6 +2605,18 @@ fu_usb_device_release_interface(FuUsbDevice *self,
 	if (priv->handle == NULL)
 		return fu_usb_device_not_open_error(self, error);
 
+	/* another claimant is still using the interface, so defer the actual release
+	 * (and any kernel driver rebind) until the last one has finished */
+	claim_cnt = GPOINTER_TO_UINT(
+	    g_hash_table_lookup(priv->claim_refcounts, GUINT_TO_POINTER(iface)));
+	if (claim_cnt > 1) {
+		g_hash_table_insert(priv->claim_refcounts,
+				    GUINT_TO_POINTER(iface),
+				    GUINT_TO_POINTER(claim_cnt - 1));
+		return TRUE;
+	}
+	g_hash_table_remove(priv->claim_refcounts, GUINT_TO_POINTER(iface));
+
 	rc = libusb_release_interface(priv->handle, iface);
 	if (rc != LIBUSB_SUCCESS)
 		return fu_usb_device_libusb_error_to_gerror(rc, error);
@@ -2947,11 +3317,47 @@ fu_usb_device_new(FuContext *ctx, libusb_device *usb_device)
 	return g_object_new(FU_TYPE_USB_DEVICE, "context", ctx, "libusb-device", usb_device, NULL);
 }
 
+static gchar *
+fu_usb_device_bulk_stats_to_string(FuUsbDeviceBulkStats *stats)
+{
+	guint64 kbps = 0;
+
+	/* bytes per millisecond is also kB per second */
+	if (stats->elapsed_us > 0)
+		kbps = (stats->bytes * 1000) / stats->elapsed_us;
+	return g_strdup_printf("transfers=%u,failures=%u,kBps=%" G_GUINT64_FORMAT,
+			       stats->transfers,
+			       stats->failures,
+			       kbps);
+}
+
+static void
+fu_usb_device_report_metadata_post(FuDevice *device, GHashTable *metadata)
+{
+	FuUsbDevice *self = FU_USB_DEVICE(device);
+	FuUsbDevicePrivate *priv = GET_PRIVATE(self);
+	GHashTableIter iter;
+	gpointer key;
+	gpointer value;
+
+	/* the achieved bulk rate per endpoint */
+	g_hash_table_iter_init(&iter, priv->bulk_stats);
+	while (g_hash_table_iter_next(&iter, &key, &value)) {
+		g_hash_table_insert(
+		    metadata,
+		    g_strdup_printf("UsbBulkStats[0x%02x]", GPOINTER_TO_UINT(key)),
+		    fu_usb_device_bulk_stats_to_string((FuUsbDeviceBulkStats *)value));
+	}
+}
+
 static void
 fu_usb_device_to_string(FuDevice *device, guint idt, GString *str)
 {
 	FuUsbDevice *self = FU_USB_DEVICE(device);
 	FuUsbDevicePrivate *priv = GET_PRIVATE(self);
+	GHashTableIter iter;
+	gpointer key;
+	gpointer value;
 
 	if (priv->configuration >= 0)
 		fwupd_codec_string_append_hex(str, idt, "Configuration", priv->configuration);
@@ -3002,6 +3408,13 @@ fu_usb_device_to_string(FuDevice *device, guint idt, GString *str)
 						      g_bytes_get_size(hid_descriptor));
 		}
 	}
+	g_hash_table_iter_init(&iter, priv->bulk_stats);
+	while (g_hash_table_iter_next(&iter, &key, &value)) {
+		g_autofree gchar *tmp = g_strdup_printf("BulkStats#%02x", GPOINTER_TO_UINT(key));
+		g_autofree gchar *stats_str =
+		    fu_usb_device_bulk_stats_to_string((FuUsbDeviceBulkStats *)value);
+		fwupd_codec_string_append(str, idt, tmp, stats_str);
+	}
 }
 
 static void
@@ -3023,6 +3436,7 @@ fu_usb_device_class_init(FuUsbDeviceClass *klass)
 	device_class->to_string = fu_usb_device_to_string;
 	device_class->incorporate = fu_usb_device_incorporate;
 	device_class->convert_version = fu_usb_device_convert_version;
+	device_class->report_metadata_post = fu_usb_device_report_metadata_post;
 
 	/**
 	 * FuUsbDevice:libusb-device:
@@ -74,6 +74,42 @@ fu_usb_device_control_transfer(FuUsbDevice *self,
 			       guint timeout,
 			       GCancellable *cancellable,
 			       GError **error) G_GNUC_NON_NULL(1);
+
+/**
+ * FuUsbDeviceControlRequest:
+ * @direction: a #FuUsbDirection
+ * @request_type: a #FuUsbRequestType
+ * @recipient: a #FuUsbRecipient
+ * @request: the request field for the setup packet
+ * @value: the value field for the setup packet
+ * @idx: the index field for the setup packet
+ * @data: (nullable): a suitably-sized data buffer for either input or output
+ * @length: the length field for the setup packet
+ * @actual_length: the actual number of bytes sent, set on completion
+ *
+ * One control transfer in a batched submission.
+ *
+ * Since: 2.0.3
+ **/
+typedef struct {
+	FuUsbDirection direction;
+	FuUsbRequestType request_type;
+	FuUsbRecipient recipient;
+	guint8 request;
+	guint16 value;
+	guint16 idx;
+	guint8 *data;
+	gsize length;
+	gsize actual_length;
+} FuUsbDeviceControlRequest;
+
+gboolean
+fu_usb_device_control_transfer_batch(FuUsbDevice *self,
+				     FuUsbDeviceControlRequest *requests,
+				     guint n_requests,
+				     guint timeout,
+				     GCancellable *cancellable,
+				     GError **error) G_GNUC_NON_NULL(1, 2);
 gboolean
 fu_usb_device_bulk_transfer(FuUsbDevice *self,
 			    guint8 endpoint,
@@ -83,6 +119,8 @@ fu_usb_device_bulk_transfer(FuUsbDevice *self,
 			    guint timeout,
 			    GCancellable *cancellable,
 			    GError **error) G_GNUC_NON_NULL(1);
+guint8 *
+fu_usb_device_get_transfer_buffer(FuUsbDevice *self, gsize length) G_GNUC_NON_NULL(1);
 gboolean
 fu_usb_device_interrupt_transfer(FuUsbDevice *self,
 				 guint8 endpoint,
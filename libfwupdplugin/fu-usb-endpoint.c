@@ -194,6 +194,7 @@ fu_usb_endpoint_parse(FuFirmware *firmware,
 		      GError **error)
 {
 	FuUsbEndpoint *self = FU_USB_ENDPOINT(firmware);
+	FuUsbEndpointHdrUnpacked st_unp = {0};
 	g_autoptr(FuUsbEndpointHdr) st = NULL;
 
 	/* FuUsbDescriptor */
@@ -204,12 +205,13 @@ fu_usb_endpoint_parse(FuFirmware *firmware,
 	st = fu_usb_endpoint_hdr_parse_stream(stream, 0x0, error);
 	if (st == NULL)
 		return FALSE;
-	self->endpoint_descriptor.bLength = fu_usb_endpoint_hdr_get_length(st);
-	self->endpoint_descriptor.bDescriptorType = fu_usb_endpoint_hdr_get_descriptor_type(st);
-	self->endpoint_descriptor.bEndpointAddress = fu_usb_endpoint_hdr_get_endpoint_address(st);
-	self->endpoint_descriptor.bmAttributes = fu_usb_endpoint_hdr_get_attributes(st);
-	self->endpoint_descriptor.wMaxPacketSize = fu_usb_endpoint_hdr_get_max_packet_size(st);
-	self->endpoint_descriptor.bInterval = fu_usb_endpoint_hdr_get_interval(st);
+	fu_usb_endpoint_hdr_unpack(st, &st_unp);
+	self->endpoint_descriptor.bLength = st_unp.length;
+	self->endpoint_descriptor.bDescriptorType = st_unp.descriptor_type;
+	self->endpoint_descriptor.bEndpointAddress = st_unp.endpoint_address;
+	self->endpoint_descriptor.bmAttributes = st_unp.attributes;
+	self->endpoint_descriptor.wMaxPacketSize = st_unp.max_packet_size;
+	self->endpoint_descriptor.bInterval = st_unp.interval;
 	self->endpoint_descriptor.bRefresh = 0;
 	self->endpoint_descriptor.bSynchAddress = 0;
 
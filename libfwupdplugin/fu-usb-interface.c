@@ -365,6 +365,7 @@ fu_usb_interface_parse(FuFirmware *firmware,
 		       GError **error)
 {
 	FuUsbInterface *self = FU_USB_INTERFACE(firmware);
+	FuUsbInterfaceHdrUnpacked st_unp = {0};
 	g_autoptr(FuUsbInterfaceHdr) st = NULL;
 
 	/* FuUsbDescriptor */
@@ -376,15 +377,16 @@ fu_usb_interface_parse(FuFirmware *firmware,
 	st = fu_usb_interface_hdr_parse_stream(stream, 0x0, error);
 	if (st == NULL)
 		return FALSE;
-	self->iface.bLength = fu_usb_interface_hdr_get_length(st);
-	self->iface.bDescriptorType = FU_USB_INTERFACE_HDR_DEFAULT_DESCRIPTOR_TYPE;
-	self->iface.bInterfaceNumber = fu_usb_interface_hdr_get_interface_number(st);
-	self->iface.bAlternateSetting = fu_usb_interface_hdr_get_alternate_setting(st);
-	self->iface.bNumEndpoints = fu_usb_interface_hdr_get_num_endpoints(st);
-	self->iface.bInterfaceClass = fu_usb_interface_hdr_get_interface_class(st);
-	self->iface.bInterfaceSubClass = fu_usb_interface_hdr_get_interface_sub_class(st);
-	self->iface.bInterfaceProtocol = fu_usb_interface_hdr_get_interface_protocol(st);
-	self->iface.iInterface = fu_usb_interface_hdr_get_interface(st);
+	fu_usb_interface_hdr_unpack(st, &st_unp);
+	self->iface.bLength = st_unp.length;
+	self->iface.bDescriptorType = st_unp.descriptor_type;
+	self->iface.bInterfaceNumber = st_unp.interface_number;
+	self->iface.bAlternateSetting = st_unp.alternate_setting;
+	self->iface.bNumEndpoints = st_unp.num_endpoints;
+	self->iface.bInterfaceClass = st_unp.interface_class;
+	self->iface.bInterfaceSubClass = st_unp.interface_sub_class;
+	self->iface.bInterfaceProtocol = st_unp.interface_protocol;
+	self->iface.iInterface = st_unp.interface;
 	fu_firmware_set_size(FU_FIRMWARE(self), self->iface.bLength);
 
 	/* extra data */
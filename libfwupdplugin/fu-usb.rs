@@ -76,7 +76,7 @@ struct FuUsbBaseHdr {
     descriptor_type: FuUsbDescriptorKind,
 }
 
-#[derive(ParseStream, Default)]
+#[derive(ParseStream, Default, Unpack)]
 struct FuUsbDeviceHdr {
     length: u8,
     descriptor_type: FuUsbDescriptorKind == Device,
@@ -127,7 +127,7 @@ struct FuUsbDfuDescriptorHdr {
     dfu_version: u16le,
 }
 
-#[derive(ParseStream, Default)]
+#[derive(ParseStream, Default, Unpack)]
 struct FuUsbInterfaceHdr {
     length: u8,
     descriptor_type: FuUsbDescriptorKind == Interface,
@@ -140,7 +140,7 @@ struct FuUsbInterfaceHdr {
     interface: u8,
 }
 
-#[derive(ParseStream)]
+#[derive(ParseStream, Unpack)]
 struct FuUsbEndpointHdr {
     length: u8,
     descriptor_type: FuUsbDescriptorKind,
@@ -168,8 +168,13 @@ fu_v4l_device_setup(FuDevice *device, GError **error)
 	FuV4lDevice *self = FU_V4L_DEVICE(device);
 	FuV4lDevicePrivate *priv = GET_PRIVATE(self);
 	struct v4l2_capability v2cap = {0};
-	g_autoptr(FuIoctl) ioctl = fu_udev_device_ioctl_new(FU_UDEV_DEVICE(self));
+	g_autoptr(FuIoctl) ioctl = NULL;
 
+	/* a re-setup after a change uevent does not need to query the caps again */
+	if (priv->caps != FU_V4L_CAP_NONE)
+		return TRUE;
+
+	ioctl = fu_udev_device_ioctl_new(FU_UDEV_DEVICE(self));
 	if (!fu_ioctl_execute(ioctl,
 			      VIDIOC_QUERYCAP,
 			      (guint8 *)&v2cap,
@@ -11,6 +11,16 @@
 
 gint
 fu_version_compare(const gchar *version_a, const gchar *version_b, FwupdVersionFormat fmt);
+
+typedef struct _FuVersionParsed FuVersionParsed;
+FuVersionParsed *
+fu_version_parsed_new(const gchar *version, FwupdVersionFormat fmt) G_GNUC_NON_NULL(1);
+void
+fu_version_parsed_free(FuVersionParsed *self) G_GNUC_NON_NULL(1);
+gint
+fu_version_parsed_compare(FuVersionParsed *version_a, FuVersionParsed *version_b);
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(FuVersionParsed, fu_version_parsed_free)
+
 gchar *
 fu_version_from_uint64(guint64 val, FwupdVersionFormat kind);
 gchar *
@@ -9,6 +9,7 @@
 
 #include "config.h"
 
+#include <errno.h>
 #include <gio/gio.h>
 #include <glib/gstdio.h>
 
@@ -17,10 +18,15 @@
 #include <sys/ioctl.h>
 #include <sys/mount.h>
 #endif
+#ifdef HAVE_SYNCFS
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #include "fwupd-error.h"
 
 #include "fu-common-private.h"
+#include "fu-path.h"
 #include "fu-volume-private.h"
 
 /**
@@ -37,8 +43,22 @@ struct _FuVolume {
 	gchar *mount_path;     /* only when mounted ourselves */
 	gchar *partition_kind; /* only for tests */
 	gchar *partition_uuid; /* only for tests */
+	GPtrArray *staged_files; /* of FuVolumeStagedFile */
 };
 
+typedef struct {
+	gchar *filename; /* relative to the mount point */
+	GBytes *blob;
+} FuVolumeStagedFile;
+
+static void
+fu_volume_staged_file_free(FuVolumeStagedFile *staged_file)
+{
+	g_free(staged_file->filename);
+	g_bytes_unref(staged_file->blob);
+	g_free(staged_file);
+}
+
 enum {
 	PROP_0,
 	PROP_MOUNT_PATH,
@@ -90,6 +110,7 @@ fu_volume_finalize(GObject *obj)
 	g_free(self->mount_path);
 	g_free(self->partition_kind);
 	g_free(self->partition_uuid);
+	g_ptr_array_unref(self->staged_files);
 	if (self->proxy_blk != NULL)
 		g_object_unref(self->proxy_blk);
 	if (self->proxy_fs != NULL)
@@ -219,6 +240,8 @@ fu_volume_class_init(FuVolumeClass *klass)
 static void
 fu_volume_init(FuVolume *self)
 {
+	self->staged_files =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)fu_volume_staged_file_free);
 }
 
 /**
@@ -684,6 +707,151 @@ fu_volume_check_free_space(FuVolume *self, guint64 required, GError **error)
 	return TRUE;
 }
 
+/**
+ * fu_volume_stage_contents:
+ * @self: a @FuVolume
+ * @filename: an absolute filename below the volume mount point
+ * @bytes: data to write
+ *
+ * Stages a blob of data to be written to the volume on the next call to
+ * fu_volume_stage_commit(), replacing any file already staged with the same filename.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_volume_stage_contents(FuVolume *self, const gchar *filename, GBytes *bytes)
+{
+	FuVolumeStagedFile *staged_file;
+
+	g_return_if_fail(FU_IS_VOLUME(self));
+	g_return_if_fail(filename != NULL);
+	g_return_if_fail(bytes != NULL);
+
+	/* replace any duplicate */
+	for (guint i = 0; i < self->staged_files->len; i++) {
+		staged_file = g_ptr_array_index(self->staged_files, i);
+		if (g_strcmp0(staged_file->filename, filename) == 0) {
+			g_bytes_unref(staged_file->blob);
+			staged_file->blob = g_bytes_ref(bytes);
+			return;
+		}
+	}
+
+	staged_file = g_new0(FuVolumeStagedFile, 1);
+	staged_file->filename = g_strdup(filename);
+	staged_file->blob = g_bytes_ref(bytes);
+	g_ptr_array_add(self->staged_files, staged_file);
+}
+
+/**
+ * fu_volume_stage_commit:
+ * @self: a @FuVolume
+ * @error: (nullable): optional return location for an error
+ *
+ * Writes all the staged files to the volume. Each file is first written unsynced beside the
+ * destination, then a single flush barrier is issued for the whole filesystem -- rather than one
+ * fsync() per file, which is very slow on FAT -- and only then is each file renamed into place.
+ * A crash mid-commit leaves either the old file or the complete new file.
+ *
+ * Returns: %TRUE for success
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_volume_stage_commit(FuVolume *self, GError **error)
+{
+	g_autofree gchar *mount_point = NULL;
+#ifdef HAVE_SYNCFS
+	GFileSetContentsFlags set_contents_flags = G_FILE_SET_CONTENTS_NONE;
+#else
+	GFileSetContentsFlags set_contents_flags = G_FILE_SET_CONTENTS_CONSISTENT;
+#endif
+
+	g_return_val_if_fail(FU_IS_VOLUME(self), FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	/* nothing to do */
+	if (self->staged_files->len == 0)
+		return TRUE;
+
+	/* sanity check */
+	mount_point = fu_volume_get_mount_point(self);
+	if (mount_point == NULL) {
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_NOT_SUPPORTED,
+				    "volume is not mounted");
+		return FALSE;
+	}
+
+	/* write all the files without any per-file flushing */
+	for (guint i = 0; i < self->staged_files->len; i++) {
+		FuVolumeStagedFile *staged_file = g_ptr_array_index(self->staged_files, i);
+		gsize bufsz = 0;
+		const gchar *buf = g_bytes_get_data(staged_file->blob, &bufsz);
+		g_autofree gchar *filename_tmp = g_strdup_printf("%s.new", staged_file->filename);
+		if (!fu_path_mkdir_parent(filename_tmp, error))
+			return FALSE;
+		g_debug("writing %s with 0x%x bytes", filename_tmp, (guint)bufsz);
+		if (!g_file_set_contents_full(filename_tmp,
+					      buf,
+					      bufsz,
+					      set_contents_flags,
+					      0644,
+					      error)) {
+			fwupd_error_convert(error);
+			return FALSE;
+		}
+	}
+
+	/* one flush barrier for the whole filesystem */
+#ifdef HAVE_SYNCFS
+	{
+		gint fd = g_open(mount_point, O_RDONLY | O_CLOEXEC | O_DIRECTORY, 0);
+		if (fd < 0) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_WRITE,
+				    "failed to open %s: %s",
+				    mount_point,
+				    g_strerror(errno));
+			return FALSE;
+		}
+		if (syncfs(fd) < 0) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_WRITE,
+				    "failed to sync %s: %s",
+				    mount_point,
+				    g_strerror(errno));
+			g_close(fd, NULL);
+			return FALSE;
+		}
+		if (!g_close(fd, error))
+			return FALSE;
+	}
+#endif
+
+	/* move each durable file into place */
+	for (guint i = 0; i < self->staged_files->len; i++) {
+		FuVolumeStagedFile *staged_file = g_ptr_array_index(self->staged_files, i);
+		g_autofree gchar *filename_tmp = g_strdup_printf("%s.new", staged_file->filename);
+		if (g_rename(filename_tmp, staged_file->filename) != 0) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_WRITE,
+				    "failed to rename %s: %s",
+				    filename_tmp,
+				    g_strerror(errno));
+			return FALSE;
+		}
+	}
+
+	/* success */
+	g_ptr_array_set_size(self->staged_files, 0);
+	return TRUE;
+}
+
 /**
  * fu_volume_is_mounted:
  * @self: a @FuVolume
@@ -38,6 +38,11 @@ gboolean
 fu_volume_check_free_space(FuVolume *self,
 			   guint64 required,
 			   GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
+void
+fu_volume_stage_contents(FuVolume *self, const gchar *filename, GBytes *bytes)
+    G_GNUC_NON_NULL(1, 2, 3);
+gboolean
+fu_volume_stage_commit(FuVolume *self, GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_NON_NULL(1);
 gboolean
 fu_volume_is_mounted(FuVolume *self) G_GNUC_NON_NULL(1);
 gboolean
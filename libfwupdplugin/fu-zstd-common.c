@@ -0,0 +1,155 @@
+/*
+ * Copyright 2024 Richard Hughes <richard@hughsie.com>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "config.h"
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "fu-zstd-common.h"
+
+/**
+ * fu_zstd_decompress_bytes:
+ * @blob: data
+ * @error: (nullable): optional return location for an error
+ *
+ * Decompresses a Zstandard stream.
+ *
+ * Returns: decompressed data
+ *
+ * Since: 2.0.3
+ **/
+GBytes *
+fu_zstd_decompress_bytes(GBytes *blob, GError **error)
+{
+#ifdef HAVE_ZSTD
+	gsize rc = 1;
+	g_autofree guint8 *tmpbuf = NULL;
+	g_autoptr(GByteArray) buf = g_byte_array_new();
+	ZSTD_DStream *dstream = ZSTD_createDStream();
+	ZSTD_inBuffer strm_in = {
+	    .src = g_bytes_get_data(blob, NULL),
+	    .size = g_bytes_get_size(blob),
+	    .pos = 0,
+	};
+
+	if (dstream == NULL) {
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_NOT_SUPPORTED,
+				    "failed to set up zstd decoder");
+		return NULL;
+	}
+	tmpbuf = g_malloc0(ZSTD_DStreamOutSize());
+	while (strm_in.pos < strm_in.size || rc != 0) {
+		ZSTD_outBuffer strm_out = {
+		    .dst = tmpbuf,
+		    .size = ZSTD_DStreamOutSize(),
+		    .pos = 0,
+		};
+		gsize pos_old = strm_in.pos;
+		rc = ZSTD_decompressStream(dstream, &strm_out, &strm_in);
+		if (ZSTD_isError(rc))
+			break;
+		g_byte_array_append(buf, tmpbuf, strm_out.pos);
+
+		/* no forward progress, probably a truncated stream */
+		if (strm_in.pos == pos_old && strm_out.pos == 0)
+			break;
+	}
+	ZSTD_freeDStream(dstream);
+
+	/* success */
+	if (ZSTD_isError(rc)) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_NOT_SUPPORTED,
+			    "failed to decode zstd data: %s",
+			    ZSTD_getErrorName(rc));
+		return NULL;
+	}
+	if (rc != 0) {
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_NOT_SUPPORTED,
+				    "failed to decode zstd data: truncated stream");
+		return NULL;
+	}
+	return g_bytes_new(buf->data, buf->len);
+#else
+	g_set_error_literal(error, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED, "missing zstd support");
+	return NULL;
+#endif
+}
+
+/**
+ * fu_zstd_compress_bytes:
+ * @blob: data
+ * @error: (nullable): optional return location for an error
+ *
+ * Compresses into a Zstandard stream, using all available CPU cores when
+ * libzstd has been built with multi-threading support.
+ *
+ * Returns: compressed data
+ *
+ * Since: 2.0.3
+ **/
+GBytes *
+fu_zstd_compress_bytes(GBytes *blob, GError **error)
+{
+#ifdef HAVE_ZSTD
+	gsize rc = 1;
+	g_autofree guint8 *tmpbuf = NULL;
+	g_autoptr(GByteArray) buf = g_byte_array_new();
+	ZSTD_CCtx *cctx = ZSTD_createCCtx();
+	ZSTD_inBuffer strm_in = {
+	    .src = g_bytes_get_data(blob, NULL),
+	    .size = g_bytes_get_size(blob),
+	    .pos = 0,
+	};
+
+	if (cctx == NULL) {
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_NOT_SUPPORTED,
+				    "failed to set up zstd encoder");
+		return NULL;
+	}
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, 9);
+
+	/* this fails harmlessly when libzstd was built without threading */
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, g_get_num_processors());
+
+	tmpbuf = g_malloc0(ZSTD_CStreamOutSize());
+	while (rc != 0) {
+		ZSTD_outBuffer strm_out = {
+		    .dst = tmpbuf,
+		    .size = ZSTD_CStreamOutSize(),
+		    .pos = 0,
+		};
+		rc = ZSTD_compressStream2(cctx, &strm_out, &strm_in, ZSTD_e_end);
+		if (ZSTD_isError(rc))
+			break;
+		g_byte_array_append(buf, tmpbuf, strm_out.pos);
+	}
+	ZSTD_freeCCtx(cctx);
+
+	/* success */
+	if (ZSTD_isError(rc)) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_NOT_SUPPORTED,
+			    "failed to encode zstd data: %s",
+			    ZSTD_getErrorName(rc));
+		return NULL;
+	}
+	return g_bytes_new(buf->data, buf->len);
+#else
+	g_set_error_literal(error, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED, "missing zstd support");
+	return NULL;
+#endif
+}
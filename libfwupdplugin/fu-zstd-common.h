@@ -0,0 +1,14 @@
+/*
+ * Copyright 2024 Richard Hughes <richard@hughsie.com>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#pragma once
+
+#include <fwupd.h>
+
+GBytes *
+fu_zstd_decompress_bytes(GBytes *blob, GError **error) G_GNUC_NON_NULL(1);
+GBytes *
+fu_zstd_compress_bytes(GBytes *blob, GError **error) G_GNUC_NON_NULL(1);
@@ -38,6 +38,7 @@
 #include <libfwupdplugin/fu-device-event.h>
 #include <libfwupdplugin/fu-device-locker.h>
 #include <libfwupdplugin/fu-device-metadata.h>
+#include <libfwupdplugin/fu-delta-firmware.h>
 #include <libfwupdplugin/fu-device.h>
 #include <libfwupdplugin/fu-dfu-firmware.h>
 #include <libfwupdplugin/fu-dfuse-firmware.h>
@@ -89,6 +90,7 @@
 #include <libfwupdplugin/fu-mem.h>
 #include <libfwupdplugin/fu-msgpack-item.h>
 #include <libfwupdplugin/fu-msgpack.h>
+#include <libfwupdplugin/fu-mszip-input-stream.h>
 #include <libfwupdplugin/fu-oprom-firmware.h>
 #include <libfwupdplugin/fu-partial-input-stream.h>
 #include <libfwupdplugin/fu-path.h>
@@ -160,6 +160,7 @@ class StructObj:
             "ParseInternal": Export.NONE,
             "New": Export.NONE,
             "ToString": Export.NONE,
+            "Unpack": Export.NONE,
             "Default": Export.NONE,
         }
 
@@ -339,6 +340,24 @@ class StructItem:
             return False
         return True
 
+    @property
+    def scalar(self) -> bool:
+        # a plain integer field that can be batch-extracted by Unpack
+        if self.multiplier or self.struct_obj:
+            return False
+        return self.type in [
+            Type.U8,
+            Type.U16,
+            Type.U24,
+            Type.U32,
+            Type.U64,
+            Type.I8,
+            Type.I16,
+            Type.I32,
+            Type.I64,
+            Type.B32,
+        ]
+
     @property
     def endian_glib(self) -> str:
         if self.endian == Endian.LITTLE:
@@ -18,11 +18,9 @@ G_DEFINE_TYPE(FuAcpiDmarPlugin, fu_acpi_dmar_plugin, FU_TYPE_PLUGIN)
 static void
 fu_acpi_dmar_plugin_add_security_attrs(FuPlugin *plugin, FuSecurityAttrs *attrs)
 {
-	g_autofree gchar *fn = NULL;
-	g_autofree gchar *path = NULL;
 	g_autoptr(FuAcpiDmar) dmar = fu_acpi_dmar_new();
 	g_autoptr(FwupdSecurityAttr) attr = NULL;
-	g_autoptr(GInputStream) stream = NULL;
+	g_autoptr(GBytes) blob = NULL;
 	g_autoptr(GError) error_local = NULL;
 
 	/* only Intel */
@@ -35,20 +33,18 @@ fu_acpi_dmar_plugin_add_security_attrs(FuPlugin *plugin, FuSecurityAttrs *attrs)
 	fu_security_attrs_append(attrs, attr);
 
 	/* load DMAR table */
-	path = fu_path_from_kind(FU_PATH_KIND_ACPI_TABLES);
-	fn = g_build_filename(path, "DMAR", NULL);
-	stream = fu_input_stream_from_path(fn, &error_local);
-	if (stream == NULL) {
-		g_debug("failed to load %s: %s", fn, error_local->message);
+	blob = fu_context_get_acpi_table(fu_plugin_get_context(plugin), "DMAR", &error_local);
+	if (blob == NULL) {
+		g_debug("failed to load DMAR: %s", error_local->message);
 		fwupd_security_attr_set_result(attr, FWUPD_SECURITY_ATTR_RESULT_NOT_VALID);
 		return;
 	}
-	if (!fu_firmware_parse_stream(FU_FIRMWARE(dmar),
-				      stream,
-				      0x0,
-				      FWUPD_INSTALL_FLAG_NONE,
-				      &error_local)) {
-		g_warning("failed to parse %s: %s", fn, error_local->message);
+	if (!fu_firmware_parse_bytes(FU_FIRMWARE(dmar),
+				     blob,
+				     0x0,
+				     FWUPD_INSTALL_FLAG_NONE,
+				     &error_local)) {
+		g_warning("failed to parse DMAR: %s", error_local->message);
 		fwupd_security_attr_set_result(attr, FWUPD_SECURITY_ATTR_RESULT_NOT_VALID);
 		return;
 	}
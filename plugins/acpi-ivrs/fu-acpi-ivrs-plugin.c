@@ -19,11 +19,9 @@ G_DEFINE_TYPE(FuAcpiIvrsPlugin, fu_acpi_ivrs_plugin, FU_TYPE_PLUGIN)
 static void
 fu_acpi_ivrs_plugin_add_security_attrs(FuPlugin *plugin, FuSecurityAttrs *attrs)
 {
-	g_autofree gchar *fn = NULL;
-	g_autofree gchar *path = NULL;
 	g_autoptr(FuAcpiIvrs) ivrs = fu_acpi_ivrs_new();
 	g_autoptr(FwupdSecurityAttr) attr = NULL;
-	g_autoptr(GInputStream) stream = NULL;
+	g_autoptr(GBytes) blob = NULL;
 	g_autoptr(GError) error_local = NULL;
 
 	/* only AMD */
@@ -36,20 +34,18 @@ fu_acpi_ivrs_plugin_add_security_attrs(FuPlugin *plugin, FuSecurityAttrs *attrs)
 	fu_security_attrs_append(attrs, attr);
 
 	/* load IVRS table */
-	path = fu_path_from_kind(FU_PATH_KIND_ACPI_TABLES);
-	fn = g_build_filename(path, "IVRS", NULL);
-	stream = fu_input_stream_from_path(fn, &error_local);
-	if (stream == NULL) {
-		g_debug("failed to load %s: %s", fn, error_local->message);
+	blob = fu_context_get_acpi_table(fu_plugin_get_context(plugin), "IVRS", &error_local);
+	if (blob == NULL) {
+		g_debug("failed to load IVRS: %s", error_local->message);
 		fwupd_security_attr_set_result(attr, FWUPD_SECURITY_ATTR_RESULT_NOT_VALID);
 		return;
 	}
-	if (!fu_firmware_parse_stream(FU_FIRMWARE(ivrs),
-				      stream,
-				      0x0,
-				      FWUPD_INSTALL_FLAG_NONE,
-				      &error_local)) {
-		g_warning("failed to parse %s: %s", fn, error_local->message);
+	if (!fu_firmware_parse_bytes(FU_FIRMWARE(ivrs),
+				     blob,
+				     0x0,
+				     FWUPD_INSTALL_FLAG_NONE,
+				     &error_local)) {
+		g_warning("failed to parse IVRS: %s", error_local->message);
 		fwupd_security_attr_set_result(attr, FWUPD_SECURITY_ATTR_RESULT_NOT_VALID);
 		return;
 	}
@@ -32,6 +32,7 @@
 struct _FuBcm57xxDevice {
 	FuPciDevice parent_instance;
 	gchar *ethtool_iface;
+	GBytes *fw_old;
 };
 
 G_DEFINE_TYPE(FuBcm57xxDevice, fu_bcm57xx_device, FU_TYPE_PCI_DEVICE)
@@ -327,6 +328,7 @@ fu_bcm57xx_device_prepare_firmware(FuDevice *device,
 				   FwupdInstallFlags flags,
 				   GError **error)
 {
+	FuBcm57xxDevice *self = FU_BCM57XX_DEVICE(device);
 	guint dict_cnt = 0;
 	g_autofree gchar *str_existing = NULL;
 	g_autofree gchar *str_proposed = NULL;
@@ -372,6 +374,11 @@ fu_bcm57xx_device_prepare_firmware(FuDevice *device,
 		g_prefix_error(error, "failed to parse existing firmware: ");
 		return NULL;
 	}
+
+	/* keep the device contents so the write stage can skip unchanged blocks */
+	if (self->fw_old != NULL)
+		g_bytes_unref(self->fw_old);
+	self->fw_old = g_bytes_ref(fw_old);
 	str_existing = fu_firmware_to_string(firmware);
 	g_info("existing device firmware: %s", str_existing);
 
@@ -405,9 +412,15 @@ fu_bcm57xx_device_prepare_firmware(FuDevice *device,
 static gboolean
 fu_bcm57xx_device_write_chunks(FuBcm57xxDevice *self,
 			       FuChunkArray *chunks,
+			       gboolean *chunks_dirty,
 			       FuProgress *progress,
 			       GError **error)
 {
+	gsize bufsz_old = 0;
+	const guint8 *buf_old = NULL;
+
+	if (self->fw_old != NULL)
+		buf_old = g_bytes_get_data(self->fw_old, &bufsz_old);
 	fu_progress_set_id(progress, G_STRLOC);
 	fu_progress_set_steps(progress, fu_chunk_array_length(chunks));
 	for (guint i = 0; i < fu_chunk_array_length(chunks); i++) {
@@ -417,6 +430,18 @@ fu_bcm57xx_device_write_chunks(FuBcm57xxDevice *self,
 		chk = fu_chunk_array_index(chunks, i, error);
 		if (chk == NULL)
 			return FALSE;
+
+		/* skip blocks that already have the right contents, which also means the
+		 * verify stage does not have to read them back */
+		if (buf_old != NULL &&
+		    fu_chunk_get_address(chk) + fu_chunk_get_data_sz(chk) <= bufsz_old &&
+		    memcmp(buf_old + fu_chunk_get_address(chk),
+			   fu_chunk_get_data(chk),
+			   fu_chunk_get_data_sz(chk)) == 0) {
+			fu_progress_step_done(progress);
+			continue;
+		}
+		chunks_dirty[i] = TRUE;
 		if (!fu_bcm57xx_device_nvram_write(self,
 						   fu_chunk_get_address(chk),
 						   fu_chunk_get_data(chk),
@@ -428,6 +453,56 @@ fu_bcm57xx_device_write_chunks(FuBcm57xxDevice *self,
 	return TRUE;
 }
 
+static gboolean
+fu_bcm57xx_device_verify_chunks(FuBcm57xxDevice *self,
+				FuChunkArray *chunks,
+				const gboolean *chunks_dirty,
+				FuProgress *progress,
+				GError **error)
+{
+	g_autofree guint8 *buf = g_malloc0(FU_BCM57XX_BLOCK_SZ);
+
+	fu_progress_set_id(progress, G_STRLOC);
+	fu_progress_set_status(progress, FWUPD_STATUS_DEVICE_VERIFY);
+	fu_progress_set_steps(progress, fu_chunk_array_length(chunks));
+	for (guint i = 0; i < fu_chunk_array_length(chunks); i++) {
+		g_autoptr(FuChunk) chk = NULL;
+
+		/* was never written */
+		if (!chunks_dirty[i]) {
+			fu_progress_step_done(progress);
+			continue;
+		}
+
+		/* read back each written block and abort at the first mismatch, rather than
+		 * dumping the entire flash contents into memory and comparing at the end */
+		chk = fu_chunk_array_index(chunks, i, error);
+		if (chk == NULL)
+			return FALSE;
+		if (!fu_bcm57xx_device_nvram_read(self,
+						  fu_chunk_get_address(chk),
+						  buf,
+						  fu_chunk_get_data_sz(chk),
+						  error))
+			return FALSE;
+		if (!fu_memcmp_safe(buf,
+				    fu_chunk_get_data_sz(chk),
+				    0x0,
+				    fu_chunk_get_data(chk),
+				    fu_chunk_get_data_sz(chk),
+				    0x0,
+				    fu_chunk_get_data_sz(chk),
+				    error)) {
+			g_prefix_error(error,
+				       "verify failed @0x%x: ",
+				       (guint)fu_chunk_get_address(chk));
+			return FALSE;
+		}
+		fu_progress_step_done(progress);
+	}
+	return TRUE;
+}
+
 static gboolean
 fu_bcm57xx_device_write_firmware(FuDevice *device,
 				 FuFirmware *firmware,
@@ -436,8 +511,8 @@ fu_bcm57xx_device_write_firmware(FuDevice *device,
 				 GError **error)
 {
 	FuBcm57xxDevice *self = FU_BCM57XX_DEVICE(device);
+	g_autofree gboolean *chunks_dirty = NULL;
 	g_autoptr(GBytes) blob = NULL;
-	g_autoptr(GBytes) blob_verify = NULL;
 	g_autoptr(FuChunkArray) chunks = NULL;
 
 	/* progress */
@@ -458,16 +533,27 @@ fu_bcm57xx_device_write_firmware(FuDevice *device,
 					       FU_CHUNK_ADDR_OFFSET_NONE,
 					       FU_CHUNK_PAGESZ_NONE,
 					       FU_BCM57XX_BLOCK_SZ);
-	if (!fu_bcm57xx_device_write_chunks(self, chunks, fu_progress_get_child(progress), error))
+	chunks_dirty = g_new0(gboolean, fu_chunk_array_length(chunks));
+	if (!fu_bcm57xx_device_write_chunks(self,
+					    chunks,
+					    chunks_dirty,
+					    fu_progress_get_child(progress),
+					    error))
 		return FALSE;
 	fu_progress_step_done(progress);
 
-	/* verify */
-	blob_verify =
-	    fu_bcm57xx_device_dump_firmware(device, fu_progress_get_child(progress), error);
-	if (blob_verify == NULL)
-		return FALSE;
-	if (!fu_bytes_compare(blob, blob_verify, error))
+	/* the stashed contents are now stale */
+	if (self->fw_old != NULL) {
+		g_bytes_unref(self->fw_old);
+		self->fw_old = NULL;
+	}
+
+	/* verify each written block */
+	if (!fu_bcm57xx_device_verify_chunks(self,
+					     chunks,
+					     chunks_dirty,
+					     fu_progress_get_child(progress),
+					     error))
 		return FALSE;
 	fu_progress_step_done(progress);
 
@@ -652,6 +738,8 @@ fu_bcm57xx_device_finalize(GObject *object)
 {
 	FuBcm57xxDevice *self = FU_BCM57XX_DEVICE(object);
 	g_free(self->ethtool_iface);
+	if (self->fw_old != NULL)
+		g_bytes_unref(self->fw_old);
 	G_OBJECT_CLASS(fu_bcm57xx_device_parent_class)->finalize(object);
 }
 
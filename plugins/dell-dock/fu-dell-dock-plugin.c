@@ -202,6 +202,10 @@ fu_dell_dock_plugin_separate_activation(FuPlugin *plugin)
 static void
 fu_dell_dock_plugin_device_registered(FuPlugin *plugin, FuDevice *device)
 {
+	/* the dock components settle together, so only wait once at the end */
+	if (g_strcmp0(fu_device_get_plugin(device), fu_plugin_get_name(plugin)) == 0)
+		fu_device_add_private_flag(device, FU_DEVICE_PRIVATE_FLAG_COMPOSITE_ACQUIESCE);
+
 	/* dell dock delays the activation so skips device restart */
 	if (fu_device_has_guid(device, DELL_DOCK_TBT_INSTANCE_ID)) {
 		fu_device_add_private_flag(device, FU_DEVICE_PRIVATE_FLAG_SKIPS_RESTART);
@@ -30,6 +30,9 @@
 
 #define DFU_TARGET_MANIFEST_MAX_POLLING_TRIES 200
 
+/* how often to check the device status when the GetStatus poll is deferred */
+#define DFU_TARGET_DEFER_STATUS_INTERVAL 32
+
 typedef struct {
 	gboolean done_setup;
 	guint8 alt_setting;
@@ -659,13 +662,12 @@ fu_dfu_target_setup(FuDfuTarget *self, GError **error)
 	return TRUE;
 }
 
-gboolean
-fu_dfu_target_download_chunk(FuDfuTarget *self,
-			     guint16 index,
-			     GByteArray *buf,
-			     guint timeout_ms,
-			     FuProgress *progress,
-			     GError **error)
+static gboolean
+fu_dfu_target_download_chunk_raw(FuDfuTarget *self,
+				 guint16 index,
+				 GByteArray *buf,
+				 guint timeout_ms,
+				 GError **error)
 {
 	FuDfuDevice *device = FU_DFU_DEVICE(fu_device_get_proxy(FU_DEVICE(self)));
 	g_autoptr(GError) error_local = NULL;
@@ -699,6 +701,22 @@ fu_dfu_target_download_chunk(FuDfuTarget *self,
 			    error_local->message);
 		return FALSE;
 	}
+	g_assert_cmpint(actual_length, ==, buf->len);
+	return TRUE;
+}
+
+gboolean
+fu_dfu_target_download_chunk(FuDfuTarget *self,
+			     guint16 index,
+			     GByteArray *buf,
+			     guint timeout_ms,
+			     FuProgress *progress,
+			     GError **error)
+{
+	FuDfuDevice *device = FU_DFU_DEVICE(fu_device_get_proxy(FU_DEVICE(self)));
+
+	if (!fu_dfu_target_download_chunk_raw(self, index, buf, timeout_ms, error))
+		return FALSE;
 
 	/* for STM32 devices, the action only occurs when we do GetStatus --
 	 * and it can take a long time to complete! */
@@ -721,7 +739,6 @@ fu_dfu_target_download_chunk(FuDfuTarget *self,
 		return FALSE;
 	}
 
-	g_assert_cmpint(actual_length, ==, buf->len);
 	return TRUE;
 }
 
@@ -1042,10 +1059,18 @@ fu_dfu_target_download_element_dfu(FuDfuTarget *self,
 				   GError **error)
 {
 	FuDfuDevice *device = FU_DFU_DEVICE(fu_device_get_proxy(FU_DEVICE(self)));
+	gboolean defer_status;
 	guint32 nr_chunks;
 	guint16 transfer_size = fu_dfu_device_get_transfer_size(device);
 	g_autoptr(GBytes) bytes = NULL;
 
+	/* devices that advertise bwPollTimeout of zero can accept the next block while still
+	 * flashing the previous one, so only poll GetStatus every few blocks and at the end */
+	defer_status =
+	    fu_device_has_private_flag(FU_DEVICE(device), FU_DFU_DEVICE_FLAG_DNLOAD_DEFER_STATUS) &&
+	    fu_dfu_device_get_download_timeout(device) == 0 &&
+	    fu_dfu_device_get_version(device) != FU_DFU_FIRMARE_VERSION_DFUSE;
+
 	/* round up as we have to transfer incomplete blocks */
 	bytes = fu_chunk_get_bytes(chk);
 	nr_chunks = (guint)ceil((gdouble)g_bytes_get_size(bytes) / (gdouble)transfer_size);
@@ -1077,9 +1102,17 @@ fu_dfu_target_download_element_dfu(FuDfuTarget *self,
 			fu_byte_array_append_bytes(buf, bytes_tmp);
 		}
 		g_debug("writing #%04x chunk of size 0x%x", i, buf->len);
-		if (!fu_dfu_target_download_chunk(self, i, buf, 0, progress, error)) {
-			g_prefix_error(error, "failed to write chunk %u: ", i);
-			return FALSE;
+		if (defer_status && i < nr_chunks &&
+		    (i + 1) % DFU_TARGET_DEFER_STATUS_INTERVAL != 0) {
+			if (!fu_dfu_target_download_chunk_raw(self, i, buf, 0, error)) {
+				g_prefix_error(error, "failed to write chunk %u: ", i);
+				return FALSE;
+			}
+		} else {
+			if (!fu_dfu_target_download_chunk(self, i, buf, 0, progress, error)) {
+				g_prefix_error(error, "failed to write chunk %u: ", i);
+				return FALSE;
+			}
 		}
 
 		/* update UI */
@@ -1112,6 +1112,9 @@ fu_elantp_hid_haptic_device_init(FuElantpHidHapticDevice *self)
 	fu_device_set_logical_id(FU_DEVICE(self), "eeprom");
 	fu_device_set_version_format(FU_DEVICE(self), FWUPD_VERSION_FORMAT_PLAIN);
 	fu_device_set_priority(FU_DEVICE(self), 1); /* better than i2c */
+
+	/* a dying EEPROM timing out on every block would otherwise take hours to fail */
+	fu_device_retry_set_failure_budget(FU_DEVICE(self), 10);
 }
 
 static void
@@ -118,6 +118,7 @@ struct _FuGenesysUsbhubDevice {
 	 */
 	gboolean backup_hub_fw_bank1;
 	GBytes *hub_fw_bank1_data; /* restore hub bank1 fw for backup */
+	gboolean hub_fw_unchanged; /* hub image matched flash and was not erased */
 
 	/* codesign info */
 	gboolean has_codesign;
@@ -2434,6 +2435,7 @@ static gboolean
 fu_genesys_usbhub_device_update_firmware(FuGenesysUsbhubDevice *self,
 					 FuFirmware *firmware,
 					 FuProgress *progress,
+					 FwupdInstallFlags flags,
 					 GError **error)
 {
 	gboolean skip_erase = FALSE;
@@ -2449,8 +2451,9 @@ fu_genesys_usbhub_device_update_firmware(FuGenesysUsbhubDevice *self,
 	buf = g_bytes_get_data(blob, &bufsz);
 
 	if (fu_firmware_get_idx(firmware) == FU_GENESYS_FW_TYPE_CODESIGN) {
-		/* already erase at FU_GENESYS_FW_TYPE_HUB before */
-		if (self->is_gl352350)
+		/* already erase at FU_GENESYS_FW_TYPE_HUB before, unless that image was
+		 * skipped as unchanged and its erase never happened */
+		if (self->is_gl352350 && !self->hub_fw_unchanged)
 			skip_erase = TRUE;
 
 		/* jump ECDSA hash on HW codesign */
@@ -2470,6 +2473,29 @@ fu_genesys_usbhub_device_update_firmware(FuGenesysUsbhubDevice *self,
 		}
 	}
 
+	/* reading back the bank is much cheaper than an erase cycle, so skip any image that
+	 * is already on the flash -- incremental releases often change only one of them */
+	if ((flags & FWUPD_INSTALL_FLAG_FORCE) == 0 && !skip_erase) {
+		g_autofree guint8 *buf_old = g_malloc0(bufsz);
+		g_autoptr(GError) error_local = NULL;
+		if (!fu_genesys_usbhub_device_read_flash(self,
+							 start_addr,
+							 buf_old,
+							 bufsz,
+							 NULL, /* progress */
+							 &error_local)) {
+			g_debug("failed to read back %s, ignoring: %s",
+				fu_firmware_get_id(firmware),
+				error_local->message);
+		} else if (fu_memcmp_safe(buf_old, bufsz, 0x0, buf, bufsz, 0x0, bufsz, NULL)) {
+			g_info("%s image already up to date, skipping",
+			       fu_firmware_get_id(firmware));
+			if (fu_firmware_get_idx(firmware) == FU_GENESYS_FW_TYPE_HUB)
+				self->hub_fw_unchanged = TRUE;
+			return TRUE;
+		}
+	}
+
 	/* progress */
 	fu_progress_set_id(progress, fu_firmware_get_id(firmware));
 	if (skip_erase) {
@@ -2908,6 +2934,9 @@ fu_genesys_usbhub_device_write_firmware(FuDevice *device,
 	if (!fu_genesys_usbhub_device_enter_isp_mode(self, error))
 		return FALSE;
 
+	/* set when the hub image matches the flash contents and no erase took place */
+	self->hub_fw_unchanged = FALSE;
+
 	/* progress */
 	fu_progress_set_id(progress, G_STRLOC);
 	if (self->backup_hub_fw_bank1) {
@@ -2949,6 +2978,7 @@ fu_genesys_usbhub_device_write_firmware(FuDevice *device,
 	if (!fu_genesys_usbhub_device_update_firmware(self,
 						      firmware,
 						      fu_progress_get_child(progress),
+						      flags,
 						      error))
 		return FALSE;
 	fu_progress_step_done(progress);
@@ -2959,6 +2989,7 @@ fu_genesys_usbhub_device_write_firmware(FuDevice *device,
 		if (!fu_genesys_usbhub_device_update_firmware(self,
 							      img,
 							      fu_progress_get_child(progress),
+							      flags,
 							      error))
 			return FALSE;
 		fu_progress_step_done(progress);
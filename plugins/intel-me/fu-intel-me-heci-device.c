@@ -133,6 +133,87 @@ fu_intel_me_heci_device_read_file_ex(FuIntelMeHeciDevice *self,
 	return g_steal_pointer(&bufout);
 }
 
+/* issues all the READ_FILE_EX commands as one pipelined batch, returning only the payloads
+ * that the ME could actually supply */
+GPtrArray *
+fu_intel_me_heci_device_read_files_ex(FuIntelMeHeciDevice *self,
+				      const guint32 *file_ids,
+				      guint file_idsz,
+				      guint32 section,
+				      guint32 datasz_req,
+				      GError **error)
+{
+	g_autoptr(GPtrArray) bufs_req =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)g_byte_array_unref);
+	g_autoptr(GPtrArray) bufs_res =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)g_byte_array_unref);
+	g_autoptr(GPtrArray) bufs_out =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)g_byte_array_unref);
+
+	/* queue each request */
+	for (guint i = 0; i < file_idsz; i++) {
+		g_autoptr(FuMkhiReadFileExRequest) st_req = fu_mkhi_read_file_ex_request_new();
+		g_autoptr(GByteArray) buf_res = g_byte_array_new();
+
+		fu_mkhi_read_file_ex_request_set_file_id(st_req, file_ids[i]);
+		fu_mkhi_read_file_ex_request_set_data_size(st_req, datasz_req);
+		fu_mkhi_read_file_ex_request_set_flags(st_req, section);
+		g_ptr_array_add(bufs_req, g_byte_array_ref(st_req));
+		fu_byte_array_set_size(buf_res, FU_MKHI_READ_FILE_EX_REQUEST_SIZE + datasz_req, 0x0);
+		g_ptr_array_add(bufs_res, g_steal_pointer(&buf_res));
+	}
+
+	/* the ME processes the commands sequentially so only pay the round-trip latency once */
+	if (!fu_mei_device_batch_execute(FU_MEI_DEVICE(self),
+					 bufs_req,
+					 bufs_res,
+					 FU_INTEL_ME_HECI_DEVICE_TIMEOUT,
+					 error))
+		return NULL;
+
+	/* parse each response, skipping the files the ME could not supply */
+	for (guint i = 0; i < bufs_res->len; i++) {
+		GByteArray *buf_res = g_ptr_array_index(bufs_res, i);
+		guint32 data_size;
+		g_autoptr(FuMkhiReadFileExResponse) st_res = NULL;
+		g_autoptr(GByteArray) bufout = g_byte_array_new();
+		g_autoptr(GError) error_local = NULL;
+
+		st_res =
+		    fu_mkhi_read_file_ex_response_parse(buf_res->data, buf_res->len, 0x0, &error_local);
+		if (st_res == NULL) {
+			g_debug("failed to parse response for file-id 0x%x: %s",
+				file_ids[i],
+				error_local->message);
+			continue;
+		}
+		if (!fu_intel_me_mkhi_result_to_error(
+			fu_mkhi_read_file_ex_response_get_result(st_res),
+			&error_local)) {
+			g_debug("failed to read file-id 0x%x: %s",
+				file_ids[i],
+				error_local->message);
+			continue;
+		}
+
+		/* verify we got what we asked for */
+		data_size = fu_mkhi_read_file_ex_response_get_data_size(st_res);
+		if (data_size > datasz_req) {
+			g_debug("invalid response data size for file-id 0x%x, "
+				"requested 0x%x and got 0x%x",
+				file_ids[i],
+				datasz_req,
+				data_size);
+			continue;
+		}
+		g_byte_array_append(bufout, &buf_res->data[st_res->len], data_size);
+		g_ptr_array_add(bufs_out, g_steal_pointer(&bufout));
+	}
+
+	/* success */
+	return g_steal_pointer(&bufs_out);
+}
+
 static void
 fu_intel_me_heci_device_version_notify_cb(FuDevice *device, GParamSpec *pspec, gpointer user_data)
 {
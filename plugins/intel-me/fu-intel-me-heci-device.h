@@ -29,3 +29,10 @@ fu_intel_me_heci_device_read_file_ex(FuIntelMeHeciDevice *self,
 				     guint32 section,
 				     guint32 datasz_req,
 				     GError **error);
+GPtrArray *
+fu_intel_me_heci_device_read_files_ex(FuIntelMeHeciDevice *self,
+				      const guint32 *file_ids,
+				      guint file_idsz,
+				      guint32 section,
+				      guint32 datasz_req,
+				      GError **error);
@@ -16,63 +16,44 @@ struct _FuIntelMeMcaDevice {
 G_DEFINE_TYPE(FuIntelMeMcaDevice, fu_intel_me_mca_device, FU_TYPE_INTEL_ME_HECI_DEVICE)
 
 static gboolean
-fu_intel_me_mca_device_add_checksum_for_id(FuIntelMeMcaDevice *self,
-					   guint32 file_id,
-					   guint32 section,
-					   GError **error)
+fu_intel_me_mca_device_setup(FuDevice *device, GError **error)
 {
-	g_autoptr(GByteArray) buf = NULL;
-	g_autoptr(GString) checksum = NULL;
+	FuIntelMeMcaDevice *self = FU_INTEL_ME_MCA_DEVICE(device);
+	const guint32 file_ids[] = {0x40002300, /* CometLake: OEM Public Key Hash */
+				    0x40005B00, /* TigerLake: 1st OEM Public Key Hash */
+				    0x40005C00 /* TigerLake: 2nd OEM Public Key Hash */};
+	g_autoptr(GPtrArray) bufs = NULL;
 
 	/*
-	 * Call READ_FILE_EX with a larger-than-required data size -- which hopefully works when
-	 * SHA512 results start being returned too.
+	 * Look for all the possible OEM Public Key hashes using the CML+ method, reading with a
+	 * larger-than-required data size -- which hopefully works when SHA512 results start
+	 * being returned too.
 	 *
 	 * Icelake/Jasperlake/Cometlake: 0x20 (SHA256)
 	 * Elkhartlake/Tigerlake/Alderlake/Raptorlake: 0x30 (SHA384)
+	 *
+	 * The commands are pipelined as one batch as each kernel round-trip is expensive.
 	 */
-	buf = fu_intel_me_heci_device_read_file_ex(FU_INTEL_ME_HECI_DEVICE(self),
-						   file_id,
-						   section,
-						   0x40,
-						   error);
-	if (buf == NULL)
+	bufs = fu_intel_me_heci_device_read_files_ex(FU_INTEL_ME_HECI_DEVICE(self),
+						     file_ids,
+						     G_N_ELEMENTS(file_ids),
+						     0x0,
+						     0x40,
+						     error);
+	if (bufs == NULL)
 		return FALSE;
-
-	/* convert into checksum, but only if non-zero and set */
-	checksum = fu_intel_me_convert_checksum(buf, error);
-	if (checksum == NULL)
-		return FALSE;
-	fu_device_add_checksum(FU_DEVICE(self), checksum->str);
-
-	/* success */
-	return TRUE;
-}
-
-static gboolean
-fu_intel_me_mca_device_setup(FuDevice *device, GError **error)
-{
-	FuIntelMeMcaDevice *self = FU_INTEL_ME_MCA_DEVICE(device);
-	const guint32 file_ids[] = {0x40002300, /* CometLake: OEM Public Key Hash */
-				    0x40005B00, /* TigerLake: 1st OEM Public Key Hash */
-				    0x40005C00 /* TigerLake: 2nd OEM Public Key Hash */,
-				    G_MAXUINT32};
-
-	/* look for all the possible OEM Public Key hashes using the CML+ method */
-	for (guint i = 0; file_ids[i] != G_MAXUINT32; i++) {
+	for (guint i = 0; i < bufs->len; i++) {
+		GByteArray *buf = g_ptr_array_index(bufs, i);
 		g_autoptr(GError) error_local = NULL;
-		if (!fu_intel_me_mca_device_add_checksum_for_id(self,
-								file_ids[i],
-								0x0,
-								&error_local)) {
-			if (g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED) ||
-			    g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_INVALID_DATA)) {
-				continue;
-			}
-			g_warning("failed to get public key using file-id 0x%x: %s",
-				  file_ids[i],
-				  error_local->message);
+		g_autoptr(GString) checksum = NULL;
+
+		/* convert into checksum, but only if non-zero and set */
+		checksum = fu_intel_me_convert_checksum(buf, &error_local);
+		if (checksum == NULL) {
+			g_warning("failed to get public key: %s", error_local->message);
+			continue;
 		}
+		fu_device_add_checksum(FU_DEVICE(self), checksum->str);
 	}
 
 	/* no point even adding */
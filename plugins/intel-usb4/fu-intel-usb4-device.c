@@ -519,11 +519,21 @@ fu_intel_usb4_device_write_firmware(FuDevice *device,
 	return TRUE;
 }
 
+static gboolean
+fu_intel_usb4_device_nvm_read_cb(guint8 *buf,
+				 gsize bufsz,
+				 gsize offset,
+				 gpointer user_data,
+				 GError **error)
+{
+	FuIntelUsb4Device *self = FU_INTEL_USB4_DEVICE(user_data);
+	return fu_intel_usb4_device_nvm_read(self, buf, bufsz, offset, error);
+}
+
 static gboolean
 fu_intel_usb4_device_setup(FuDevice *device, GError **error)
 {
 	FuIntelUsb4Device *self = FU_INTEL_USB4_DEVICE(device);
-	guint8 buf[NVM_READ_LENGTH] = {0x0};
 	g_autofree gchar *name = NULL;
 	g_autoptr(FuFirmware) fw = fu_intel_thunderbolt_nvm_new();
 	g_autoptr(GBytes) blob = NULL;
@@ -532,12 +542,16 @@ fu_intel_usb4_device_setup(FuDevice *device, GError **error)
 	if (!FU_DEVICE_CLASS(fu_intel_usb4_device_parent_class)->setup(device, error))
 		return FALSE;
 
-	/* read from device and parse firmware */
-	if (!fu_intel_usb4_device_nvm_read(self, buf, sizeof(buf), 0, error)) {
+	/* read only the windows the NVM parser inspects; each 64 byte mailbox read is a
+	 * slow device round-trip so pulling the whole header dominates dock attach time */
+	blob = fu_intel_thunderbolt_nvm_read_windowed(NVM_READ_LENGTH,
+						      fu_intel_usb4_device_nvm_read_cb,
+						      self,
+						      error);
+	if (blob == NULL) {
 		g_prefix_error(error, "NVM read error: ");
 		return FALSE;
 	}
-	blob = g_bytes_new(buf, sizeof(buf));
 	if (!fu_firmware_parse_bytes(fw, blob, 0x0, FWUPD_INSTALL_FLAG_NONE, error)) {
 		g_prefix_error(error, "NVM parse error: ");
 		return FALSE;
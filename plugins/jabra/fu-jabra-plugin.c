@@ -62,6 +62,7 @@ fu_jabra_plugin_constructed(GObject *obj)
 	FuContext *ctx = fu_plugin_get_context(plugin);
 	fu_context_add_quirk_key(ctx, "JabraMagic");
 	fu_plugin_add_device_gtype(plugin, FU_TYPE_JABRA_DEVICE);
+	fu_plugin_add_flag(plugin, FWUPD_PLUGIN_FLAG_PARALLEL_INSTALLS);
 }
 
 static void
@@ -282,7 +282,7 @@ static FuLogitechBulkcontrollerResponse *
 fu_logitech_bulkcontroller_device_sync_wait_any(FuLogitechBulkcontrollerDevice *self,
 						GError **error)
 {
-	g_autofree guint8 *buf = g_malloc0(self->transfer_bufsz);
+	guint8 *buf = fu_usb_device_get_transfer_buffer(FU_USB_DEVICE(self), self->transfer_bufsz);
 	g_autoptr(GByteArray) st = NULL;
 	g_autoptr(FuLogitechBulkcontrollerResponse) response =
 	    fu_logitech_bulkcontroller_device_response_new();
@@ -613,7 +613,8 @@ fu_logitech_bulkcontroller_device_upd_send_cmd(FuLogitechBulkcontrollerDevice *s
 					       guint timeout,
 					       GError **error)
 {
-	g_autofree guint8 *buf_tmp = g_malloc0(self->transfer_bufsz);
+	guint8 *buf_tmp =
+	    fu_usb_device_get_transfer_buffer(FU_USB_DEVICE(self), self->transfer_bufsz);
 	GByteArray buf_ack = {.data = buf_tmp, .len = self->transfer_bufsz};
 	g_autoptr(GByteArray) buf_pkt = fu_struct_logitech_bulkcontroller_update_req_new();
 
@@ -1290,7 +1291,7 @@ fu_logitech_bulkcontroller_device_clear_queue_cb(FuDevice *device,
 						 GError **error)
 {
 	FuLogitechBulkcontrollerDevice *self = FU_LOGITECH_BULKCONTROLLER_DEVICE(device);
-	g_autofree guint8 *buf = g_malloc0(self->transfer_bufsz);
+	guint8 *buf = fu_usb_device_get_transfer_buffer(FU_USB_DEVICE(self), self->transfer_bufsz);
 	g_autoptr(GError) error_local = NULL;
 
 	if (!fu_logitech_bulkcontroller_device_recv(self,
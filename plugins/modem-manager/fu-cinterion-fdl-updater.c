@@ -136,22 +136,14 @@ fu_cinterion_fdl_updater_write_chunk(FuCinterionFdlUpdater *self,
 				     GBytes *chunk_bytes,
 				     GError **error)
 {
-	if (!fu_io_channel_write_bytes(self->io_channel,
-				       size_bytes,
-				       1500,
-				       FU_IO_CHANNEL_FLAG_USE_BLOCKING_IO,
-				       error)) {
-		return FALSE;
-	}
-	if (!fu_io_channel_write_bytes(self->io_channel,
-				       chunk_bytes,
-				       1500,
-				       FU_IO_CHANNEL_FLAG_USE_BLOCKING_IO,
-				       error)) {
-		return FALSE;
-	}
-
-	return TRUE;
+	g_autoptr(GPtrArray) blobs = g_ptr_array_new();
+	g_ptr_array_add(blobs, size_bytes);
+	g_ptr_array_add(blobs, chunk_bytes);
+	return fu_io_channel_writev(self->io_channel,
+				    blobs,
+				    1500,
+				    FU_IO_CHANNEL_FLAG_USE_BLOCKING_IO,
+				    error);
 }
 
 static gboolean
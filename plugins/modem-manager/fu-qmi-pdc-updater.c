@@ -244,6 +244,11 @@ fu_qmi_pdc_updater_close(FuQmiPdcUpdater *self, GError **error)
 
 #define QMI_LOAD_CHUNK_SIZE 0x400
 
+/* how many load-config requests may be outstanding at once; the window starts at one and
+ * only grows while the device keeps acknowledging chunks, so modems that require strict
+ * request/response alternation never see a second in-flight request */
+#define QMI_LOAD_WINDOW_SIZE_MAX 8
+
 typedef struct {
 	GMainLoop *mainloop;
 	QmiClientPdc *qmi_client;
@@ -254,10 +259,27 @@ typedef struct {
 	GArray *digest;
 	gsize offset;
 	guint token;
+	guint pending;	   /* chunks sent but not yet acknowledged */
+	guint window_size; /* current limit for @pending */
+	gboolean completed;
 } WriteContext;
 
 static void
-fu_qmi_pdc_updater_load_config(WriteContext *ctx);
+fu_qmi_pdc_updater_load_config_fill_window(WriteContext *ctx);
+
+static void
+fu_qmi_pdc_updater_load_config_teardown(WriteContext *ctx)
+{
+	if (ctx->timeout_id != 0) {
+		g_source_remove(ctx->timeout_id);
+		ctx->timeout_id = 0;
+	}
+	if (ctx->indication_id != 0) {
+		g_signal_handler_disconnect(ctx->qmi_client, ctx->indication_id);
+		ctx->indication_id = 0;
+	}
+	g_main_loop_quit(ctx->mainloop);
+}
 
 static gboolean
 fu_qmi_pdc_updater_load_config_timeout(gpointer user_data)
@@ -265,18 +287,23 @@ fu_qmi_pdc_updater_load_config_timeout(gpointer user_data)
 	WriteContext *ctx = user_data;
 
 	ctx->timeout_id = 0;
-	g_signal_handler_disconnect(ctx->qmi_client, ctx->indication_id);
-	ctx->indication_id = 0;
-
 	g_set_error_literal(&ctx->error,
 			    FWUPD_ERROR,
 			    FWUPD_ERROR_TIMED_OUT,
 			    "couldn't load mcfg: timed out");
-	g_main_loop_quit(ctx->mainloop);
+	fu_qmi_pdc_updater_load_config_teardown(ctx);
 
 	return G_SOURCE_REMOVE;
 }
 
+static void
+fu_qmi_pdc_updater_load_config_reset_timeout(WriteContext *ctx)
+{
+	if (ctx->timeout_id != 0)
+		g_source_remove(ctx->timeout_id);
+	ctx->timeout_id = g_timeout_add_seconds(5, fu_qmi_pdc_updater_load_config_timeout, ctx);
+}
+
 static void
 fu_qmi_pdc_updater_load_config_indication(QmiClientPdc *client,
 					  QmiIndicationPdcLoadConfigOutput *output,
@@ -286,15 +313,13 @@ fu_qmi_pdc_updater_load_config_indication(QmiClientPdc *client,
 	guint32 remaining_size;
 	guint16 error_code = 0;
 
-	g_source_remove(ctx->timeout_id);
-	ctx->timeout_id = 0;
-	g_signal_handler_disconnect(ctx->qmi_client, ctx->indication_id);
-	ctx->indication_id = 0;
+	if (ctx->pending > 0)
+		ctx->pending--;
 
 	if (!qmi_indication_pdc_load_config_output_get_indication_result(output,
 									 &error_code,
 									 &ctx->error)) {
-		g_main_loop_quit(ctx->mainloop);
+		fu_qmi_pdc_updater_load_config_teardown(ctx);
 		return;
 	}
 
@@ -305,7 +330,7 @@ fu_qmi_pdc_updater_load_config_indication(QmiClientPdc *client,
 		 */
 		if (error_code == QMI_PROTOCOL_ERROR_INVALID_QOS_ID) {
 			g_debug("file already available in device");
-			g_main_loop_quit(ctx->mainloop);
+			fu_qmi_pdc_updater_load_config_teardown(ctx);
 			return;
 		}
 
@@ -314,7 +339,7 @@ fu_qmi_pdc_updater_load_config_indication(QmiClientPdc *client,
 			    FWUPD_ERROR_INTERNAL,
 			    "couldn't load mcfg: %s",
 			    qmi_protocol_error_get_string((QmiProtocolError)error_code));
-		g_main_loop_quit(ctx->mainloop);
+		fu_qmi_pdc_updater_load_config_teardown(ctx);
 		return;
 	}
 
@@ -324,7 +349,7 @@ fu_qmi_pdc_updater_load_config_indication(QmiClientPdc *client,
 			    FWUPD_ERROR,
 			    FWUPD_ERROR_INTERNAL,
 			    "couldn't load mcfg: sent data discarded");
-		g_main_loop_quit(ctx->mainloop);
+		fu_qmi_pdc_updater_load_config_teardown(ctx);
 		return;
 	}
 
@@ -332,18 +357,32 @@ fu_qmi_pdc_updater_load_config_indication(QmiClientPdc *client,
 								      &remaining_size,
 								      &ctx->error)) {
 		g_prefix_error(&ctx->error, "couldn't load remaining size: ");
-		g_main_loop_quit(ctx->mainloop);
+		fu_qmi_pdc_updater_load_config_teardown(ctx);
 		return;
 	}
 
-	if (remaining_size == 0) {
-		g_debug("finished loading mcfg");
-		g_main_loop_quit(ctx->mainloop);
+	if (remaining_size == 0)
+		ctx->completed = TRUE;
+	if (ctx->completed) {
+		/* wait for the stragglers still in flight to be acknowledged */
+		if (ctx->pending == 0) {
+			g_debug("finished loading mcfg");
+			fu_qmi_pdc_updater_load_config_teardown(ctx);
+			return;
+		}
+		fu_qmi_pdc_updater_load_config_reset_timeout(ctx);
 		return;
 	}
 
-	g_debug("loading next chunk (%u bytes remaining)", remaining_size);
-	fu_qmi_pdc_updater_load_config(ctx);
+	/* the device is keeping up, so allow one more chunk in flight */
+	if (ctx->window_size < QMI_LOAD_WINDOW_SIZE_MAX)
+		ctx->window_size++;
+
+	g_debug("loading next chunks (%u bytes remaining, window %u)",
+		remaining_size,
+		ctx->window_size);
+	fu_qmi_pdc_updater_load_config_fill_window(ctx);
+	fu_qmi_pdc_updater_load_config_reset_timeout(ctx);
 }
 
 static void
@@ -351,29 +390,28 @@ fu_qmi_pdc_updater_load_config_ready(GObject *qmi_client, GAsyncResult *res, gpo
 {
 	WriteContext *ctx = (WriteContext *)user_data;
 	g_autoptr(QmiMessagePdcLoadConfigOutput) output = NULL;
+	g_autoptr(GError) error_local = NULL;
 
-	output = qmi_client_pdc_load_config_finish(QMI_CLIENT_PDC(qmi_client), res, &ctx->error);
+	/* several requests may be in flight; only the first failure is reported */
+	output = qmi_client_pdc_load_config_finish(QMI_CLIENT_PDC(qmi_client), res, &error_local);
 	if (output == NULL) {
-		g_main_loop_quit(ctx->mainloop);
+		if (ctx->error == NULL) {
+			g_propagate_error(&ctx->error, g_steal_pointer(&error_local));
+			fu_qmi_pdc_updater_load_config_teardown(ctx);
+		}
 		return;
 	}
 
-	if (!qmi_message_pdc_load_config_output_get_result(output, &ctx->error)) {
-		g_main_loop_quit(ctx->mainloop);
+	if (!qmi_message_pdc_load_config_output_get_result(output, &error_local)) {
+		if (ctx->error == NULL) {
+			g_propagate_error(&ctx->error, g_steal_pointer(&error_local));
+			fu_qmi_pdc_updater_load_config_teardown(ctx);
+		}
 		return;
 	}
 
-	/* after receiving the response to our request, we now expect an indication
-	 * with the actual result of the operation */
-	g_warn_if_fail(ctx->indication_id == 0);
-	ctx->indication_id = g_signal_connect(QMI_CLIENT_PDC(ctx->qmi_client),
-					      "load-config",
-					      G_CALLBACK(fu_qmi_pdc_updater_load_config_indication),
-					      ctx);
-
-	/* don't wait forever */
-	g_warn_if_fail(ctx->timeout_id == 0);
-	ctx->timeout_id = g_timeout_add_seconds(5, fu_qmi_pdc_updater_load_config_timeout, ctx);
+	/* the actual result of the operation arrives in a load-config indication, and the
+	 * persistent handler connected before the first request processes it */
 }
 
 static void
@@ -421,6 +459,15 @@ fu_qmi_pdc_updater_load_config(WriteContext *ctx)
 				   NULL,
 				   fu_qmi_pdc_updater_load_config_ready,
 				   ctx);
+	ctx->pending++;
+}
+
+static void
+fu_qmi_pdc_updater_load_config_fill_window(WriteContext *ctx)
+{
+	while (ctx->error == NULL && !ctx->completed && ctx->offset < g_bytes_get_size(ctx->blob) &&
+	       ctx->pending < ctx->window_size)
+		fu_qmi_pdc_updater_load_config(ctx);
 }
 
 static GArray *
@@ -459,9 +506,19 @@ fu_qmi_pdc_updater_write(FuQmiPdcUpdater *self, const gchar *filename, GBytes *b
 	    .digest = digest,
 	    .offset = 0,
 	    .token = 0,
+	    .pending = 0,
+	    .window_size = 1,
+	    .completed = FALSE,
 	};
 
-	fu_qmi_pdc_updater_load_config(&ctx);
+	/* the indication handler stays connected for the whole transfer as several
+	 * requests may be in flight at once */
+	ctx.indication_id = g_signal_connect(QMI_CLIENT_PDC(self->qmi_client),
+					     "load-config",
+					     G_CALLBACK(fu_qmi_pdc_updater_load_config_indication),
+					     &ctx);
+	fu_qmi_pdc_updater_load_config_reset_timeout(&ctx);
+	fu_qmi_pdc_updater_load_config_fill_window(&ctx);
 	g_main_loop_run(mainloop);
 
 	if (ctx.error != NULL) {
@@ -71,6 +71,7 @@ struct _FuSynapticsMstDevice {
 	guint8 active_bank;
 	guint16 board_id;
 	guint16 chip_id;
+	guint rc_enabled_cnt;
 };
 
 G_DEFINE_TYPE(FuSynapticsMstDevice, fu_synaptics_mst_device, FU_TYPE_DPAUX_DEVICE)
@@ -409,6 +410,13 @@ fu_synaptics_mst_device_disable_rc(FuSynapticsMstDevice *self, GError **error)
 				       FU_SYNAPTICS_MST_DEVICE_FLAG_IS_SOMEWHAT_EMULATED))
 		return TRUE;
 
+	/* a caller further up the stack still needs the session */
+	if (self->rc_enabled_cnt > 1) {
+		self->rc_enabled_cnt--;
+		return TRUE;
+	}
+	self->rc_enabled_cnt = 0;
+
 	if (!fu_synaptics_mst_device_rc_set_command(self,
 						    FU_SYNAPTICS_MST_UPDC_CMD_DISABLE_RC,
 						    0,
@@ -436,6 +444,14 @@ fu_synaptics_mst_device_enable_rc(FuSynapticsMstDevice *self, GError **error)
 				       FU_SYNAPTICS_MST_DEVICE_FLAG_IS_SOMEWHAT_EMULATED))
 		return TRUE;
 
+	/* join the session already open, e.g. for the whole install transaction; each DISABLE_RC
+	 * plus ENABLE_RC round trip over the aux channel is far from free */
+	if (self->rc_enabled_cnt > 0) {
+		self->rc_enabled_cnt++;
+		g_debug("remote control already enabled, now %u users", self->rc_enabled_cnt);
+		return TRUE;
+	}
+
 	if (!fu_synaptics_mst_device_disable_rc(self, error)) {
 		g_prefix_error(error, "failed to disable-to-enable: ");
 		return FALSE;
@@ -449,6 +465,7 @@ fu_synaptics_mst_device_enable_rc(FuSynapticsMstDevice *self, GError **error)
 		g_prefix_error(error, "failed to enable remote control: ");
 		return FALSE;
 	}
+	self->rc_enabled_cnt = 1;
 	return TRUE;
 }
 
@@ -1365,6 +1382,8 @@ fu_synaptics_mst_device_restart(FuSynapticsMstDevice *self, GError **error)
 						    &error_local))
 		g_debug("failed to restart: %s", error_local->message);
 
+	/* the reboot tears down the remote control session */
+	self->rc_enabled_cnt = 0;
 	return TRUE;
 }
 
@@ -1420,6 +1439,33 @@ fu_synaptics_mst_device_attach(FuDevice *device, FuProgress *progress, GError **
 	return TRUE;
 }
 
+static gboolean
+fu_synaptics_mst_device_prepare(FuDevice *device,
+				FuProgress *progress,
+				FwupdInstallFlags flags,
+				GError **error)
+{
+	FuSynapticsMstDevice *self = FU_SYNAPTICS_MST_DEVICE(device);
+
+	/* open one remote control session for the whole install transaction; the per-operation
+	 * lockers then join this session rather than cycling it */
+	return fu_synaptics_mst_device_enable_rc(self, error);
+}
+
+static gboolean
+fu_synaptics_mst_device_cleanup(FuDevice *device,
+				FuProgress *progress,
+				FwupdInstallFlags flags,
+				GError **error)
+{
+	FuSynapticsMstDevice *self = FU_SYNAPTICS_MST_DEVICE(device);
+
+	/* if the device was restarted the session has already gone */
+	if (self->rc_enabled_cnt == 0)
+		return TRUE;
+	return fu_synaptics_mst_device_disable_rc(self, error);
+}
+
 static gboolean
 fu_synaptics_mst_device_write_firmware(FuDevice *device,
 				       FuFirmware *firmware,
@@ -1628,8 +1674,7 @@ fu_synaptics_mst_device_setup(FuDevice *device, GError **error)
 	FuDevice *parent;
 	const gchar *name_family;
 	const gchar *name_parent = NULL;
-	guint8 buf_ver[3] = {0x0};
-	guint8 buf_cid[2] = {0x0};
+	guint8 buf_ids[6] = {0x0};
 	guint8 rc_cap = 0x0;
 	g_autofree gchar *guid0 = NULL;
 	g_autofree gchar *guid1 = NULL;
@@ -1675,31 +1720,27 @@ fu_synaptics_mst_device_setup(FuDevice *device, GError **error)
 		return FALSE;
 	}
 
-	/* read firmware version: the third byte is vendor-specific usage */
+	/* the chip ID and firmware version registers are adjacent, so coalesce the reads into
+	 * one aux channel transaction */
 	if (!fu_dpaux_device_read(FU_DPAUX_DEVICE(self),
-				  REG_FIRMWARE_VERSION,
-				  buf_ver,
-				  sizeof(buf_ver),
+				  REG_CHIP_ID,
+				  buf_ids,
+				  sizeof(buf_ids),
 				  FU_SYNAPTICS_MST_DEVICE_READ_TIMEOUT,
 				  error)) {
-		g_prefix_error(error, "failed to read firmware version: ");
+		g_prefix_error(error, "failed to read chip id and firmware version: ");
 		return FALSE;
 	}
 
-	version = g_strdup_printf("%1d.%02d.%02d", buf_ver[0], buf_ver[1], buf_ver[2]);
+	/* firmware version: the third byte is vendor-specific usage */
+	version = g_strdup_printf("%1d.%02d.%02d",
+				  buf_ids[REG_FIRMWARE_VERSION - REG_CHIP_ID],
+				  buf_ids[REG_FIRMWARE_VERSION - REG_CHIP_ID + 1],
+				  buf_ids[REG_FIRMWARE_VERSION - REG_CHIP_ID + 2]);
 	fu_device_set_version(FU_DEVICE(self), version);
 
-	/* read board chip_id */
-	if (!fu_dpaux_device_read(FU_DPAUX_DEVICE(self),
-				  REG_CHIP_ID,
-				  buf_cid,
-				  sizeof(buf_cid),
-				  FU_SYNAPTICS_MST_DEVICE_READ_TIMEOUT,
-				  error)) {
-		g_prefix_error(error, "failed to read chip id: ");
-		return FALSE;
-	}
-	self->chip_id = fu_memread_uint16(buf_cid, G_BIG_ENDIAN);
+	/* board chip_id */
+	self->chip_id = fu_memread_uint16(buf_ids, G_BIG_ENDIAN);
 	if (self->chip_id == 0) {
 		g_set_error_literal(error,
 				    FWUPD_ERROR,
@@ -1855,6 +1896,8 @@ fu_synaptics_mst_device_class_init(FuSynapticsMstDeviceClass *klass)
 	device_class->setup = fu_synaptics_mst_device_setup;
 	device_class->write_firmware = fu_synaptics_mst_device_write_firmware;
 	device_class->attach = fu_synaptics_mst_device_attach;
+	device_class->prepare = fu_synaptics_mst_device_prepare;
+	device_class->cleanup = fu_synaptics_mst_device_cleanup;
 	device_class->prepare_firmware = fu_synaptics_mst_device_prepare_firmware;
 	device_class->set_progress = fu_synaptics_mst_device_set_progress;
 }
@@ -101,13 +101,27 @@ enum EStickDeviceType {
 };
 
 #define FU_SYNAPTICS_RMI_DEVICE_BIND_TIMEOUT 1000 /* ms */
+#define FU_SYNAPTICS_RMI_DEVICE_ACK_TIMEOUT  660  /* ms */
 
 static gboolean
 fu_synaptics_rmi_ps2_device_read_ack(FuSynapticsRmiPs2Device *self, guint8 *pbuf, GError **error)
 {
 	FuIOChannel *io_channel = fu_udev_device_get_io_channel(FU_UDEV_DEVICE(self));
-	for (guint i = 0; i < 60; i++) {
+	gint64 start = g_get_monotonic_time();
+	while (TRUE) {
+		gint64 elapsed_ms = (g_get_monotonic_time() - start) / 1000;
 		g_autoptr(GError) error_local = NULL;
+		if (elapsed_ms >= FU_SYNAPTICS_RMI_DEVICE_ACK_TIMEOUT)
+			break;
+		if (!fu_io_channel_wait_for_data(
+			io_channel,
+			(guint)(FU_SYNAPTICS_RMI_DEVICE_ACK_TIMEOUT - elapsed_ms),
+			&error_local)) {
+			if (g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_TIMED_OUT))
+				break;
+			g_propagate_error(error, g_steal_pointer(&error_local));
+			return FALSE;
+		}
 		if (!fu_io_channel_read_raw(io_channel,
 					    pbuf,
 					    0x1,
@@ -115,11 +129,8 @@ fu_synaptics_rmi_ps2_device_read_ack(FuSynapticsRmiPs2Device *self, guint8 *pbuf
 					    10,
 					    FU_IO_CHANNEL_FLAG_USE_BLOCKING_IO,
 					    &error_local)) {
-			if (g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_TIMED_OUT)) {
-				g_warning("read timed out: %u", i);
-				fu_device_sleep(FU_DEVICE(self), 1); /* ms */
+			if (g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_TIMED_OUT))
 				continue;
-			}
 			g_propagate_error(error, g_steal_pointer(&error_local));
 			return FALSE;
 		}
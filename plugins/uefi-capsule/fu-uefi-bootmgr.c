@@ -344,6 +344,7 @@ fu_uefi_bootmgr_bootnext(FuEfivars *efivars,
 			 GError **error)
 {
 	const gchar *filepath = NULL;
+	gboolean shim_staged = FALSE;
 	gboolean use_fwup_path = TRUE;
 	gboolean secureboot_enabled = FALSE;
 	g_autofree gchar *shim_app = NULL;
@@ -380,17 +381,20 @@ fu_uefi_bootmgr_bootnext(FuEfivars *efivars,
 					return FALSE;
 				if (!fu_uefi_esp_target_copy(source_shim, esp, shim_app, error))
 					return FALSE;
+				shim_staged = TRUE;
 			}
 		}
 
-		if (fu_uefi_esp_target_exists(esp, shim_app)) {
-			/* use a custom copy of shim for firmware updates */
+		if (shim_staged || fu_uefi_esp_target_exists(esp, shim_app)) {
+			/* use a custom copy of shim for firmware updates; if the shim on the ESP
+			 * is itself only staged then copy from the source again */
 			if (flags & FU_UEFI_BOOTMGR_FLAG_USE_SHIM_UNIQUE) {
+				const gchar *shim_src = shim_staged ? source_shim : shim_app;
 				shim_cpy = fu_uefi_get_esp_app_path(esp_path, "shimfwupd", error);
 				if (shim_cpy == NULL)
 					return FALSE;
-				if (!fu_uefi_esp_target_verify(shim_app, esp, shim_cpy)) {
-					if (!fu_uefi_esp_target_copy(shim_app,
+				if (!fu_uefi_esp_target_verify(shim_src, esp, shim_cpy)) {
+					if (!fu_uefi_esp_target_copy(shim_src,
 								     esp,
 								     shim_cpy,
 								     error))
@@ -440,6 +444,10 @@ fu_uefi_bootmgr_bootnext(FuEfivars *efivars,
 	fu_firmware_add_image(FU_FIRMWARE(loadopt), FU_FIRMWARE(dp_buf));
 	fu_firmware_set_id(FU_FIRMWARE(loadopt), description);
 
+	/* make the capsule and EFI binaries durable with one flush before BootNext is set */
+	if (!fu_volume_stage_commit(esp, error))
+		return FALSE;
+
 	/* save as BootNext */
 	return fu_uefi_bootmgr_setup_bootnext_with_loadopt(efivars, loadopt, flags, error);
 }
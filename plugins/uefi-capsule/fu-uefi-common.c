@@ -291,19 +291,14 @@ fu_uefi_esp_target_copy(const gchar *source_fn,
 {
 	g_autofree gchar *esp_path = fu_volume_get_mount_point(esp);
 	g_autofree gchar *target_fn = g_build_filename(esp_path, target_no_mountpoint, NULL);
-	g_autoptr(GFile) source_file = g_file_new_for_path(source_fn);
-	g_autoptr(GFile) target_file = g_file_new_for_path(target_fn);
+	g_autoptr(GBytes) blob = NULL;
 
-	if (!g_file_copy(source_file,
-			 target_file,
-			 G_FILE_COPY_OVERWRITE,
-			 NULL,
-			 NULL,
-			 NULL,
-			 error)) {
-		g_prefix_error(error, "Failed to copy %s to %s: ", source_fn, target_fn);
+	/* staged, not written -- the caller has to fu_volume_stage_commit() the ESP */
+	blob = fu_bytes_get_contents(source_fn, error);
+	if (blob == NULL) {
+		g_prefix_error(error, "failed to copy %s to %s: ", source_fn, target_fn);
 		return FALSE;
 	}
-
+	fu_volume_stage_contents(esp, target_fn, blob);
 	return TRUE;
 }
@@ -195,6 +195,8 @@ fu_uefi_grub_device_write_firmware(FuDevice *device,
 		if (!fu_uefi_esp_target_copy(source_app, esp, target_app, error))
 			return FALSE;
 	}
+	if (!fu_volume_stage_commit(esp, error))
+		return FALSE;
 
 	/* we are using GRUB instead of NVRAM variables */
 	return fu_uefi_grub_device_mkconfig(device, esp_path, target_app, error);
@@ -81,18 +81,16 @@ fu_uefi_nvram_device_write_firmware(FuDevice *device,
 	if (fw == NULL)
 		return FALSE;
 
-	/* save the blob to the ESP */
+	/* stage the blob for the ESP; fu_uefi_bootmgr_bootnext() commits it with the EFI
+	 * binaries in one flush so nothing is synced per-file */
 	directory = fu_uefi_get_esp_path_for_os(esp_path);
 	basename = g_strdup_printf("fwupd-%s.cap", fw_class);
 	capsule_path = g_build_filename(directory, "fw", basename, NULL);
 	fn = g_build_filename(esp_path, capsule_path, NULL);
-	if (!fu_path_mkdir_parent(fn, error))
-		return FALSE;
 	fixed_fw = fu_uefi_device_fixup_firmware(self, fw, error);
 	if (fixed_fw == NULL)
 		return FALSE;
-	if (!fu_bytes_set_contents(fn, fixed_fw, error))
-		return FALSE;
+	fu_volume_stage_contents(esp, fn, fixed_fw);
 
 	/* enable debugging in the EFI binary */
 	if (!fu_uefi_device_perhaps_enable_debugging(self, error))
@@ -58,19 +58,11 @@ fu_dbxtool_get_siglist_local(const gchar *filename, GError **error)
 static gboolean
 fu_dbxtool_siglist_inclusive(FuFirmware *outer, FuFirmware *inner)
 {
-	g_autoptr(GPtrArray) sigs = fu_firmware_get_images(inner);
-	for (guint i = 0; i < sigs->len; i++) {
-		FuEfiSignature *sig = g_ptr_array_index(sigs, i);
-		g_autofree gchar *checksum = NULL;
-		g_autoptr(FuFirmware) img = NULL;
-		checksum = fu_firmware_get_checksum(FU_FIRMWARE(sig), G_CHECKSUM_SHA256, NULL);
-		if (checksum == NULL)
-			continue;
-		img = fu_firmware_get_image_by_checksum(outer, checksum, NULL);
-		if (img == NULL)
-			return FALSE;
-	}
-	return TRUE;
+	g_autoptr(GPtrArray) missing = NULL;
+	missing = fu_efi_signature_list_get_missing(FU_EFI_SIGNATURE_LIST(inner),
+						    FU_EFI_SIGNATURE_LIST(outer),
+						    NULL);
+	return missing != NULL && missing->len == 0;
 }
 
 static const gchar *
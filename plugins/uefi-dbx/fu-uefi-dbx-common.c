@@ -26,7 +26,6 @@ fu_uefi_dbx_signature_list_validate_filename(FuContext *ctx,
 					     GError **error)
 {
 	g_autofree gchar *checksum = NULL;
-	g_autoptr(FuFirmware) img = NULL;
 	g_autoptr(GError) error_local = NULL;
 
 	/* get checksum of file */
@@ -38,8 +37,7 @@ fu_uefi_dbx_signature_list_validate_filename(FuContext *ctx,
 
 	/* Authenticode signature is present in dbx! */
 	g_debug("fn=%s, checksum=%s", fn, checksum);
-	img = fu_firmware_get_image_by_checksum(FU_FIRMWARE(siglist), checksum, NULL);
-	if (img != NULL) {
+	if (fu_efi_signature_list_has_checksum(siglist, checksum)) {
 		g_set_error(error,
 			    FWUPD_ERROR,
 			    FWUPD_ERROR_NEEDS_USER_ACTION,
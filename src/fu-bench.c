@@ -0,0 +1,369 @@
+/*
+ * Copyright 2024 Richard Hughes <richard@hughsie.com>
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#define G_LOG_DOMAIN "FuBench"
+
+#include "config.h"
+
+#include <fwupdplugin.h>
+
+#include <json-glib/json-glib.h>
+
+#include "fu-context-private.h"
+#include "fu-device-event-private.h"
+#include "fu-device-list.h"
+#include "fu-engine.h"
+
+#define FU_BENCH_DEVICE_LIST_SIZE 1000
+#define FU_BENCH_CHECKSUM_BUFSZ	  (16 * 1024 * 1024)
+#define FU_BENCH_CAB_PAYLOADSZ	  (1 * 1024 * 1024)
+#define FU_BENCH_DUMP_BUFSZ	  (256 * 1024)
+#define FU_BENCH_EVENT_BLOBSZ	  (4 * 1024 * 1024)
+
+typedef struct {
+	FuContext *ctx;
+	JsonBuilder *builder;
+	guint iterations;
+	gchar **emulation_fns;
+} FuBenchPrivate;
+
+static void
+fu_bench_private_free(FuBenchPrivate *priv)
+{
+	if (priv->ctx != NULL)
+		g_object_unref(priv->ctx);
+	if (priv->builder != NULL)
+		g_object_unref(priv->builder);
+	g_strfreev(priv->emulation_fns);
+	g_free(priv);
+}
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(FuBenchPrivate, fu_bench_private_free)
+
+static void
+fu_bench_add_result(FuBenchPrivate *priv,
+		    const gchar *name,
+		    guint iterations,
+		    gint64 duration_usec)
+{
+	json_builder_set_member_name(priv->builder, name);
+	json_builder_begin_object(priv->builder);
+	json_builder_set_member_name(priv->builder, "Iterations");
+	json_builder_add_int_value(priv->builder, iterations);
+	json_builder_set_member_name(priv->builder, "TotalUsec");
+	json_builder_add_int_value(priv->builder, duration_usec);
+	json_builder_set_member_name(priv->builder, "MeanUsec");
+	json_builder_add_double_value(priv->builder, (gdouble)duration_usec / iterations);
+	json_builder_end_object(priv->builder);
+}
+
+static gboolean
+fu_bench_quirks_lookup(FuBenchPrivate *priv, GError **error)
+{
+	gint64 timestamp;
+	g_autofree gchar *guid = fwupd_guid_hash_string("USB\\VID_273F");
+
+	if (!fu_context_load_quirks(priv->ctx, FU_QUIRKS_LOAD_FLAG_NO_CACHE, error))
+		return FALSE;
+	timestamp = g_get_monotonic_time();
+	for (guint i = 0; i < priv->iterations; i++)
+		fu_context_lookup_quirk_by_id(priv->ctx, guid, FU_QUIRKS_PLUGIN);
+	fu_bench_add_result(priv,
+			    "QuirksLookupById",
+			    priv->iterations,
+			    g_get_monotonic_time() - timestamp);
+
+	/* success */
+	return TRUE;
+}
+
+static gboolean
+fu_bench_device_list(FuBenchPrivate *priv, GError **error)
+{
+	gint64 timestamp;
+	g_autoptr(FuDeviceList) device_list = fu_device_list_new();
+
+	for (guint i = 0; i < FU_BENCH_DEVICE_LIST_SIZE; i++) {
+		g_autofree gchar *physical_id = g_strdup_printf("/bench/%u", i);
+		g_autofree gchar *guid = fwupd_guid_hash_string(physical_id);
+		g_autoptr(FuDevice) device = fu_device_new(priv->ctx);
+		fu_device_set_id(device, physical_id);
+		fu_device_add_guid(device, guid);
+		fu_device_list_add(device_list, device);
+	}
+	timestamp = g_get_monotonic_time();
+	for (guint i = 0; i < priv->iterations; i++) {
+		g_autofree gchar *physical_id =
+		    g_strdup_printf("/bench/%u", i % FU_BENCH_DEVICE_LIST_SIZE);
+		g_autofree gchar *guid = fwupd_guid_hash_string(physical_id);
+		g_autoptr(FuDevice) device =
+		    fu_device_list_get_by_guid(device_list, guid, error);
+		if (device == NULL)
+			return FALSE;
+	}
+	fu_bench_add_result(priv,
+			    "DeviceListGetByGuid",
+			    priv->iterations,
+			    g_get_monotonic_time() - timestamp);
+
+	/* success */
+	return TRUE;
+}
+
+static gboolean
+fu_bench_cab_parse(FuBenchPrivate *priv, GError **error)
+{
+	gint64 timestamp;
+	g_autofree guint8 *buf = g_malloc0(FU_BENCH_CAB_PAYLOADSZ);
+	g_autoptr(FuCabFirmware) cab = fu_cab_firmware_new();
+	g_autoptr(FuCabImage) img = fu_cab_image_new();
+	g_autoptr(GBytes) blob = NULL;
+	g_autoptr(GBytes) payload = NULL;
+
+	/* not compressible, so the parse cost is dominated by the container */
+	for (gsize i = 0; i < FU_BENCH_CAB_PAYLOADSZ; i++)
+		buf[i] = (guint8)g_random_int_range(0, 0xFF);
+	payload = g_bytes_new_take(g_steal_pointer(&buf), FU_BENCH_CAB_PAYLOADSZ);
+	fu_firmware_set_id(FU_FIRMWARE(img), "firmware.bin");
+	fu_firmware_set_bytes(FU_FIRMWARE(img), payload);
+	fu_firmware_add_image(FU_FIRMWARE(cab), FU_FIRMWARE(img));
+	blob = fu_firmware_write(FU_FIRMWARE(cab), error);
+	if (blob == NULL)
+		return FALSE;
+	timestamp = g_get_monotonic_time();
+	for (guint i = 0; i < priv->iterations; i++) {
+		g_autoptr(FuCabFirmware) cab_tmp = fu_cab_firmware_new();
+		if (!fu_firmware_parse_bytes(FU_FIRMWARE(cab_tmp),
+					     blob,
+					     0x0,
+					     FWUPD_INSTALL_FLAG_NONE,
+					     error))
+			return FALSE;
+	}
+	fu_bench_add_result(priv,
+			    "CabFirmwareParse",
+			    priv->iterations,
+			    g_get_monotonic_time() - timestamp);
+
+	/* success */
+	return TRUE;
+}
+
+static gboolean
+fu_bench_checksum(FuBenchPrivate *priv, GError **error)
+{
+	gint64 timestamp;
+	g_autofree guint8 *buf = g_malloc0(FU_BENCH_CHECKSUM_BUFSZ);
+	g_autoptr(GBytes) blob = NULL;
+	g_autoptr(GInputStream) stream = NULL;
+
+	blob = g_bytes_new_take(g_steal_pointer(&buf), FU_BENCH_CHECKSUM_BUFSZ);
+	stream = g_memory_input_stream_new_from_bytes(blob);
+	timestamp = g_get_monotonic_time();
+	for (guint i = 0; i < priv->iterations; i++) {
+		g_autofree gchar *checksum =
+		    fu_input_stream_compute_checksum(stream, G_CHECKSUM_SHA256, error);
+		if (checksum == NULL)
+			return FALSE;
+	}
+	fu_bench_add_result(priv,
+			    "InputStreamComputeChecksum",
+			    priv->iterations,
+			    g_get_monotonic_time() - timestamp);
+
+	/* success */
+	return TRUE;
+}
+
+static gboolean
+fu_bench_dump(FuBenchPrivate *priv, GError **error)
+{
+	gboolean verbose_was_set = g_getenv("FWUPD_VERBOSE") != NULL;
+	gint64 timestamp;
+	g_autofree guint8 *buf = g_malloc0(FU_BENCH_DUMP_BUFSZ);
+
+	for (gsize i = 0; i < FU_BENCH_DUMP_BUFSZ; i++)
+		buf[i] = (guint8)i;
+
+	/* fu_dump_full() is a no-op without this; debug output is still swallowed by the
+	 * default log handler so only the string building is measured */
+	(void)g_setenv("FWUPD_VERBOSE", "1", FALSE);
+	timestamp = g_get_monotonic_time();
+	for (guint i = 0; i < priv->iterations; i++)
+		fu_dump_raw(G_LOG_DOMAIN, "bench", buf, FU_BENCH_DUMP_BUFSZ);
+	fu_bench_add_result(priv,
+			    "DumpHexEncode",
+			    priv->iterations,
+			    g_get_monotonic_time() - timestamp);
+	if (!verbose_was_set)
+		g_unsetenv("FWUPD_VERBOSE");
+
+	/* success */
+	return TRUE;
+}
+
+static gboolean
+fu_bench_device_event(FuBenchPrivate *priv, GError **error)
+{
+	gint64 timestamp;
+	g_autofree guint8 *buf = g_malloc0(FU_BENCH_EVENT_BLOBSZ);
+	g_autoptr(FuDeviceEvent) event = fu_device_event_new("bench");
+	g_autoptr(GBytes) blob = NULL;
+
+	/* not compressible, like most firmware reads */
+	for (gsize i = 0; i < FU_BENCH_EVENT_BLOBSZ; i++)
+		buf[i] = (guint8)g_random_int_range(0, 0xFF);
+	blob = g_bytes_new_take(g_steal_pointer(&buf), FU_BENCH_EVENT_BLOBSZ);
+	fu_device_event_set_bytes(event, "Data", blob);
+
+	/* the BASE-64 encode cost of recording an emulation blob */
+	timestamp = g_get_monotonic_time();
+	for (guint i = 0; i < priv->iterations; i++) {
+		g_autofree gchar *json =
+		    fwupd_codec_to_json_string(FWUPD_CODEC(event), FWUPD_CODEC_FLAG_NONE, error);
+		if (json == NULL)
+			return FALSE;
+	}
+	fu_bench_add_result(priv,
+			    "DeviceEventToJson",
+			    priv->iterations,
+			    g_get_monotonic_time() - timestamp);
+
+	/* success */
+	return TRUE;
+}
+
+static gboolean
+fu_bench_emulation_machine(FuBenchPrivate *priv, const gchar *emulation_fn, GError **error)
+{
+	gint64 timestamp;
+	g_autofree gchar *basename = g_path_get_basename(emulation_fn);
+	g_autofree gchar *name_coldplug = g_strdup_printf("EmulationColdplug[%s]", basename);
+	g_autofree gchar *name_devices = g_strdup_printf("EmulationGetDevices[%s]", basename);
+	g_autofree gchar *name_ndevices = g_strdup_printf("EmulationDeviceCount[%s]", basename);
+	g_autoptr(FuContext) ctx = fu_context_new();
+	g_autoptr(FuEngine) engine = fu_engine_new(ctx);
+	g_autoptr(FuProgress) progress = fu_progress_new(G_STRLOC);
+	g_autoptr(GError) error_local = NULL;
+	g_autoptr(GInputStream) stream = NULL;
+	g_autoptr(GPtrArray) devices = NULL;
+
+	if (!fu_engine_load(engine,
+			    FU_ENGINE_LOAD_FLAG_READONLY | FU_ENGINE_LOAD_FLAG_COLDPLUG |
+				FU_ENGINE_LOAD_FLAG_BUILTIN_PLUGINS |
+				FU_ENGINE_LOAD_FLAG_NO_CACHE,
+			    progress,
+			    error))
+		return FALSE;
+	stream = fu_input_stream_from_path(emulation_fn, error);
+	if (stream == NULL)
+		return FALSE;
+	timestamp = g_get_monotonic_time();
+	if (!fu_engine_emulation_load(engine, stream, error))
+		return FALSE;
+	fu_bench_add_result(priv, name_coldplug, 1, g_get_monotonic_time() - timestamp);
+
+	/* some corpus files only carry host attributes */
+	devices = fu_engine_get_devices(engine, &error_local);
+	if (devices == NULL &&
+	    !g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_NOTHING_TO_DO)) {
+		g_propagate_error(error, g_steal_pointer(&error_local));
+		return FALSE;
+	}
+
+	/* the work the daemon does for every GetDevices method call */
+	if (devices != NULL) {
+		timestamp = g_get_monotonic_time();
+		for (guint i = 0; i < priv->iterations; i++) {
+			g_autoptr(GPtrArray) devices_tmp = fu_engine_get_devices(engine, error);
+			g_autoptr(GVariant) val = NULL;
+			if (devices_tmp == NULL)
+				return FALSE;
+			val = g_variant_ref_sink(
+			    fwupd_codec_array_to_variant(devices_tmp, FWUPD_CODEC_FLAG_NONE));
+		}
+		fu_bench_add_result(priv,
+				    name_devices,
+				    priv->iterations,
+				    g_get_monotonic_time() - timestamp);
+	}
+
+	/* so a corpus change shows up in the tracked metrics */
+	json_builder_set_member_name(priv->builder, name_ndevices);
+	json_builder_add_int_value(priv->builder, devices != NULL ? devices->len : 0);
+
+	/* success */
+	return TRUE;
+}
+
+int
+main(int argc, char *argv[])
+{
+	gint iterations = 100;
+	g_auto(GStrv) emulation_fns = NULL;
+	g_autofree gchar *str = NULL;
+	g_autoptr(FuBenchPrivate) priv = g_new0(FuBenchPrivate, 1);
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GOptionContext) context = g_option_context_new(NULL);
+	g_autoptr(JsonGenerator) generator = json_generator_new();
+	g_autoptr(JsonNode) root = NULL;
+	const GOptionEntry options[] = {
+	    {"iterations",
+	     'n',
+	     0,
+	     G_OPTION_ARG_INT,
+	     &iterations,
+	     "Iterations for each benchmark",
+	     NULL},
+	    {"emulation",
+	     'e',
+	     0,
+	     G_OPTION_ARG_FILENAME_ARRAY,
+	     &emulation_fns,
+	     "Also boot the engine against the specified emulation machine, repeatable",
+	     "FILENAME"},
+	    {NULL}};
+
+	g_option_context_add_main_entries(context, options, NULL);
+	g_option_context_set_summary(context, "fwupd performance benchmark harness");
+	if (!g_option_context_parse(context, &argc, &argv, &error)) {
+		g_printerr("failed to parse arguments: %s\n", error->message);
+		return EXIT_FAILURE;
+	}
+	if (iterations <= 0) {
+		g_printerr("invalid number of iterations\n");
+		return EXIT_FAILURE;
+	}
+
+	priv->iterations = (guint)iterations;
+	priv->emulation_fns = g_steal_pointer(&emulation_fns);
+	priv->ctx = fu_context_new();
+	priv->builder = json_builder_new();
+	json_builder_begin_object(priv->builder);
+	if (!fu_bench_quirks_lookup(priv, &error) || !fu_bench_device_list(priv, &error) ||
+	    !fu_bench_cab_parse(priv, &error) || !fu_bench_checksum(priv, &error) ||
+	    !fu_bench_dump(priv, &error) || !fu_bench_device_event(priv, &error)) {
+		g_printerr("failed to run benchmarks: %s\n", error->message);
+		return EXIT_FAILURE;
+	}
+	if (priv->emulation_fns != NULL) {
+		for (guint i = 0; priv->emulation_fns[i] != NULL; i++) {
+			if (!fu_bench_emulation_machine(priv, priv->emulation_fns[i], &error)) {
+				g_printerr("failed to run benchmarks: %s\n", error->message);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	json_builder_end_object(priv->builder);
+
+	/* export as a JSON object, one member per benchmark */
+	root = json_builder_get_root(priv->builder);
+	json_generator_set_pretty(generator, TRUE);
+	json_generator_set_root(generator, root);
+	str = json_generator_to_data(generator, NULL);
+	g_print("%s\n", str);
+	return EXIT_SUCCESS;
+}
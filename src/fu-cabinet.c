@@ -24,6 +24,7 @@ struct _FuCabinet {
 	FuCabFirmware parent_instance;
 	gchar *container_checksum;
 	gchar *container_checksum_alt;
+	gboolean only_metadata;
 	XbBuilder *builder;
 	XbSilo *silo;
 	JcatContext *jcat_context;
@@ -50,6 +51,27 @@ fu_cabinet_set_jcat_context(FuCabinet *self, JcatContext *jcat_context)
 	g_set_object(&self->jcat_context, jcat_context);
 }
 
+/**
+ * fu_cabinet_set_only_metadata: (skip):
+ * @self: a #FuCabinet
+ * @only_metadata: boolean
+ *
+ * Sets if only the metainfo and metadata members should be processed, which
+ * keeps the peak memory usage independent of the archive size as the firmware
+ * payload members are never read or verified.
+ *
+ * An archive parsed this way must not be used for an actual install, as no
+ * payload checksums are checked and the trusted-payload flag is never set.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_cabinet_set_only_metadata(FuCabinet *self, gboolean only_metadata)
+{
+	g_return_if_fail(FU_IS_CABINET(self));
+	self->only_metadata = only_metadata;
+}
+
 /**
  * fu_cabinet_get_silo: (skip):
  * @self: a #FuCabinet
@@ -98,31 +120,61 @@ fu_cabinet_add_file(FuCabinet *self, const gchar *basename, GBytes *data)
 	fu_firmware_add_image(FU_FIRMWARE(self), FU_FIRMWARE(img));
 }
 
-/* sets the firmware and signature blobs on XbNode */
-static gboolean
-fu_cabinet_parse_release(FuCabinet *self, XbNode *release, GError **error)
+typedef struct {
+	GBytes *blob;
+	GChecksumType content_type;
+	gboolean content_required;
+	gboolean target_required;
+	gchar *content_checksum;
+	GPtrArray *target_checksums;
+	GError *error;
+} FuCabinetChecksumHelper;
+
+static void
+fu_cabinet_checksum_helper_free(FuCabinetChecksumHelper *helper)
+{
+	if (helper->blob != NULL)
+		g_bytes_unref(helper->blob);
+	if (helper->target_checksums != NULL)
+		g_ptr_array_unref(helper->target_checksums);
+	if (helper->error != NULL)
+		g_error_free(helper->error);
+	g_free(helper->content_checksum);
+	g_free(helper);
+}
+
+static void
+fu_cabinet_parse_release_checksum_cb(gpointer data, gpointer user_data)
+{
+	FuCabinetChecksumHelper *helper = (FuCabinetChecksumHelper *)data;
+	g_autoptr(GInputStream) stream = g_memory_input_stream_new_from_bytes(helper->blob);
+
+	if (helper->content_required) {
+		helper->content_checksum =
+		    fu_input_stream_compute_checksum(stream, helper->content_type, &helper->error);
+		if (helper->content_checksum == NULL)
+			return;
+	}
+	if (helper->target_required) {
+		GChecksumType checksum_types[] = {G_CHECKSUM_SHA256, G_CHECKSUM_SHA512, 0};
+		helper->target_checksums =
+		    fu_input_stream_compute_checksums(stream, checksum_types, &helper->error);
+	}
+}
+
+/* resolves the payload like fu_cabinet_parse_release(), which also reports any failures */
+static void
+fu_cabinet_parse_release_precompute(FuCabinet *self, GHashTable *checksum_helpers, XbNode *release)
 {
 	const gchar *csum_filename = NULL;
-	gsize streamsz = 0;
+	FuCabinetChecksumHelper *helper;
 	g_autofree gchar *basename = NULL;
 	g_autoptr(FuFirmware) img_blob = NULL;
-	g_autoptr(GInputStream) stream = NULL;
-	g_autoptr(GError) error_local2 = NULL;
+	g_autoptr(GBytes) blob = NULL;
+	g_autoptr(JcatItem) item = NULL;
 	g_autoptr(XbNode) artifact = NULL;
 	g_autoptr(XbNode) csum_tmp = NULL;
-	g_autoptr(XbNode) metadata_trust = NULL;
-	g_autoptr(XbNode) nsize = NULL;
-	g_autoptr(JcatItem) item = NULL;
-	g_autoptr(GBytes) release_flags_blob = NULL;
-	g_autoptr(GBytes) filename_blob = NULL;
-	FwupdReleaseFlags release_flags = FWUPD_RELEASE_FLAG_NONE;
-
-	/* we set this with XbBuilderSource before the silo was created */
-	metadata_trust = xb_node_query_first(release, "../../info/metadata_trust", NULL);
-	if (metadata_trust != NULL)
-		release_flags |= FWUPD_RELEASE_FLAG_TRUSTED_METADATA;
 
-	/* look for source artifact first */
 	artifact = xb_node_query_first(release, "artifacts/artifact[@type='source']", NULL);
 	if (artifact != NULL) {
 		csum_filename = xb_node_query_text(artifact, "filename", NULL);
@@ -134,66 +186,62 @@ fu_cabinet_parse_release(FuCabinet *self, XbNode *release, GError **error)
 		if (csum_tmp != NULL)
 			csum_filename = xb_node_get_attr(csum_tmp, "filename");
 	}
-
-	/* if this isn't true, a firmware needs to set in the metainfo.xml file
-	 * something like: <checksum target="content" filename="FLASH.ROM"/> */
 	if (csum_filename == NULL)
 		csum_filename = "firmware.bin";
-
-	/* get the main firmware file */
 	basename = g_path_get_basename(csum_filename);
-	img_blob = fu_firmware_get_image_by_id(FU_FIRMWARE(self), basename, &error_local2);
-	if (img_blob == NULL) {
-		/* we have to set this exact error code */
-		g_set_error_literal(error,
-				    FWUPD_ERROR,
-				    FWUPD_ERROR_INVALID_FILE,
-				    error_local2->message);
-		return FALSE;
+	img_blob = fu_firmware_get_image_by_id(FU_FIRMWARE(self), basename, NULL);
+	if (img_blob == NULL)
+		return;
+
+	/* releases sharing a payload share a helper, so each file is hashed only once */
+	helper = g_hash_table_lookup(checksum_helpers, basename);
+	if (helper == NULL) {
+		blob = fu_firmware_get_bytes(img_blob, NULL);
+		if (blob == NULL)
+			return;
+		helper = g_new0(FuCabinetChecksumHelper, 1);
+		helper->blob = g_steal_pointer(&blob);
+		g_hash_table_insert(checksum_helpers, g_strdup(basename), helper);
 	}
-	filename_blob = g_bytes_new(basename, strlen(basename) + 1);
-	xb_node_set_data(release, "fwupd::FirmwareBasename", filename_blob);
-
-	/* set as metadata if unset, but error if specified and incorrect */
-	stream = fu_firmware_get_stream(img_blob, error);
-	if (stream == NULL)
-		return FALSE;
-	if (!fu_input_stream_size(stream, &streamsz, error))
-		return FALSE;
-	nsize = xb_node_query_first(release, "size[@type='installed']", NULL);
-	if (nsize != NULL) {
-		guint64 size = 0;
-		if (!fu_strtoull(xb_node_get_text(nsize),
-				 &size,
-				 0,
-				 G_MAXSIZE,
-				 FU_INTEGER_BASE_AUTO,
-				 error))
-			return FALSE;
-		if (size != streamsz) {
-			g_set_error(error,
-				    FWUPD_ERROR,
-				    FWUPD_ERROR_INVALID_FILE,
-				    "contents size invalid, expected "
-				    "%" G_GSIZE_FORMAT ", got %" G_GUINT64_FORMAT,
-				    streamsz,
-				    size);
-			return FALSE;
-		}
-	} else {
-		guint64 size = streamsz;
-		g_autoptr(GBytes) blob_sz = g_bytes_new(&size, sizeof(guint64));
-		xb_node_set_data(release, "fwupd::ReleaseSize", blob_sz);
+	if (csum_tmp != NULL && xb_node_get_text(csum_tmp) != NULL && !helper->content_required) {
+		helper->content_required = TRUE;
+		helper->content_type = fwupd_checksum_guess_kind(xb_node_get_text(csum_tmp));
 	}
+	item = jcat_file_get_item_by_id(self->jcat_file, basename, NULL);
+	if (item != NULL && jcat_item_has_target(item))
+		helper->target_required = TRUE;
+}
+
+/* sets the firmware and signature blobs on XbNode */
+static gboolean
+fu_cabinet_parse_release_verify(FuCabinet *self,
+				GHashTable *checksum_helpers,
+				const gchar *basename,
+				FuFirmware *img_blob,
+				GInputStream *stream,
+				XbNode *csum_tmp,
+				FwupdReleaseFlags *release_flags,
+				GError **error)
+{
+	g_autoptr(JcatItem) item = NULL;
 
 	/* set if unspecified, but error out if specified and incorrect */
 	if (csum_tmp != NULL && xb_node_get_text(csum_tmp) != NULL) {
 		const gchar *checksum_old = xb_node_get_text(csum_tmp);
 		GChecksumType checksum_type = fwupd_checksum_guess_kind(checksum_old);
+		FuCabinetChecksumHelper *helper;
 		g_autofree gchar *checksum = NULL;
-		checksum = fu_input_stream_compute_checksum(stream, checksum_type, error);
-		if (checksum == NULL)
-			return FALSE;
+
+		/* use the precomputed digest where possible */
+		helper = g_hash_table_lookup(checksum_helpers, basename);
+		if (helper != NULL && helper->content_checksum != NULL &&
+		    helper->content_type == checksum_type) {
+			checksum = g_strdup(helper->content_checksum);
+		} else {
+			checksum = fu_input_stream_compute_checksum(stream, checksum_type, error);
+			if (checksum == NULL)
+				return FALSE;
+		}
 		if (g_strcmp0(checksum, checksum_old) != 0) {
 			g_set_error(error,
 				    FWUPD_ERROR,
@@ -208,28 +256,29 @@ fu_cabinet_parse_release(FuCabinet *self, XbNode *release, GError **error)
 	/* the jcat file signed the *checksum of the payload*, not the payload itself */
 	item = jcat_file_get_item_by_id(self->jcat_file, basename, NULL);
 	if (item != NULL && jcat_item_has_target(item)) {
-		g_autofree gchar *checksum_sha256 = NULL;
-		g_autofree gchar *checksum_sha512 = NULL;
+		GChecksumType checksum_types[] = {G_CHECKSUM_SHA256, G_CHECKSUM_SHA512, 0};
+		FuCabinetChecksumHelper *helper;
 		g_autoptr(GError) error_local = NULL;
+		g_autoptr(GPtrArray) checksums = NULL;
 		g_autoptr(GPtrArray) results = NULL;
 		g_autoptr(JcatBlob) blob_target_sha256 = NULL;
 		g_autoptr(JcatBlob) blob_target_sha512 = NULL;
 		g_autoptr(JcatItem) item_target = jcat_item_new(basename);
 
-		/* add SHA-256 */
-		checksum_sha256 =
-		    fu_input_stream_compute_checksum(stream, G_CHECKSUM_SHA256, error);
-		if (checksum_sha256 == NULL)
-			return FALSE;
-		blob_target_sha256 = jcat_blob_new_utf8(JCAT_BLOB_KIND_SHA256, checksum_sha256);
+		/* add SHA-256 and SHA-512, reading the payload only once */
+		helper = g_hash_table_lookup(checksum_helpers, basename);
+		if (helper != NULL && helper->target_checksums != NULL) {
+			checksums = g_ptr_array_ref(helper->target_checksums);
+		} else {
+			checksums = fu_input_stream_compute_checksums(stream, checksum_types, error);
+			if (checksums == NULL)
+				return FALSE;
+		}
+		blob_target_sha256 = jcat_blob_new_utf8(JCAT_BLOB_KIND_SHA256,
+							g_ptr_array_index(checksums, 0));
 		jcat_item_add_blob(item_target, blob_target_sha256);
-
-		/* add SHA-512 */
-		checksum_sha512 =
-		    fu_input_stream_compute_checksum(stream, G_CHECKSUM_SHA512, error);
-		if (checksum_sha512 == NULL)
-			return FALSE;
-		blob_target_sha512 = jcat_blob_new_utf8(JCAT_BLOB_KIND_SHA512, checksum_sha512);
+		blob_target_sha512 = jcat_blob_new_utf8(JCAT_BLOB_KIND_SHA512,
+							g_ptr_array_index(checksums, 1));
 		jcat_item_add_blob(item_target, blob_target_sha512);
 
 		results = jcat_context_verify_target(self->jcat_context,
@@ -244,7 +293,7 @@ fu_cabinet_parse_release(FuCabinet *self, XbNode *release, GError **error)
 			       error_local->message);
 		} else {
 			g_info("verified indirect payload %s: %u", basename, results->len);
-			release_flags |= FWUPD_RELEASE_FLAG_TRUSTED_PAYLOAD;
+			*release_flags |= FWUPD_RELEASE_FLAG_TRUSTED_PAYLOAD;
 		}
 	} else if (item != NULL) {
 		g_autoptr(GBytes) blob = NULL;
@@ -265,7 +314,7 @@ fu_cabinet_parse_release(FuCabinet *self, XbNode *release, GError **error)
 			g_info("failed to verify payload %s: %s", basename, error_local->message);
 		} else {
 			g_info("verified payload %s: %u", basename, results->len);
-			release_flags |= FWUPD_RELEASE_FLAG_TRUSTED_PAYLOAD;
+			*release_flags |= FWUPD_RELEASE_FLAG_TRUSTED_PAYLOAD;
 		}
 
 	} else {
@@ -302,11 +351,118 @@ fu_cabinet_parse_release(FuCabinet *self, XbNode *release, GError **error)
 				       error_local->message);
 			} else {
 				g_info("verified payload %s using detached", basename);
-				release_flags |= FWUPD_RELEASE_FLAG_TRUSTED_PAYLOAD;
+				*release_flags |= FWUPD_RELEASE_FLAG_TRUSTED_PAYLOAD;
 			}
 		}
 	}
 
+	/* success */
+	return TRUE;
+}
+
+static gboolean
+fu_cabinet_parse_release(FuCabinet *self,
+			 XbNode *release,
+			 GHashTable *checksum_helpers,
+			 GError **error)
+{
+	const gchar *csum_filename = NULL;
+	gsize streamsz = 0;
+	g_autofree gchar *basename = NULL;
+	g_autoptr(FuFirmware) img_blob = NULL;
+	g_autoptr(GInputStream) stream = NULL;
+	g_autoptr(GError) error_local2 = NULL;
+	g_autoptr(XbNode) artifact = NULL;
+	g_autoptr(XbNode) csum_tmp = NULL;
+	g_autoptr(XbNode) metadata_trust = NULL;
+	g_autoptr(XbNode) nsize = NULL;
+	g_autoptr(GBytes) release_flags_blob = NULL;
+	g_autoptr(GBytes) filename_blob = NULL;
+	FwupdReleaseFlags release_flags = FWUPD_RELEASE_FLAG_NONE;
+
+	/* we set this with XbBuilderSource before the silo was created */
+	metadata_trust = xb_node_query_first(release, "../../info/metadata_trust", NULL);
+	if (metadata_trust != NULL)
+		release_flags |= FWUPD_RELEASE_FLAG_TRUSTED_METADATA;
+
+	/* look for source artifact first */
+	artifact = xb_node_query_first(release, "artifacts/artifact[@type='source']", NULL);
+	if (artifact != NULL) {
+		csum_filename = xb_node_query_text(artifact, "filename", NULL);
+		csum_tmp = xb_node_query_first(artifact, "checksum[@type='sha256']", NULL);
+		if (csum_tmp == NULL)
+			csum_tmp = xb_node_query_first(artifact, "checksum", NULL);
+	} else {
+		csum_tmp = xb_node_query_first(release, "checksum[@target='content']", NULL);
+		if (csum_tmp != NULL)
+			csum_filename = xb_node_get_attr(csum_tmp, "filename");
+	}
+
+	/* if this isn't true, a firmware needs to set in the metainfo.xml file
+	 * something like: <checksum target="content" filename="FLASH.ROM"/> */
+	if (csum_filename == NULL)
+		csum_filename = "firmware.bin";
+
+	/* get the main firmware file */
+	basename = g_path_get_basename(csum_filename);
+	img_blob = fu_firmware_get_image_by_id(FU_FIRMWARE(self), basename, &error_local2);
+	if (img_blob == NULL) {
+		/* we have to set this exact error code */
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INVALID_FILE,
+				    error_local2->message);
+		return FALSE;
+	}
+	filename_blob = g_bytes_new(basename, strlen(basename) + 1);
+	xb_node_set_data(release, "fwupd::FirmwareBasename", filename_blob);
+
+	/* set as metadata if unset, but error if specified and incorrect */
+	stream = fu_firmware_get_stream(img_blob, error);
+	if (stream == NULL)
+		return FALSE;
+	if (!fu_input_stream_size(stream, &streamsz, error))
+		return FALSE;
+	nsize = xb_node_query_first(release, "size[@type='installed']", NULL);
+	if (nsize != NULL) {
+		guint64 size = 0;
+		if (!fu_strtoull(xb_node_get_text(nsize),
+				 &size,
+				 0,
+				 G_MAXSIZE,
+				 FU_INTEGER_BASE_AUTO,
+				 error))
+			return FALSE;
+		if (size != streamsz) {
+			g_set_error(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INVALID_FILE,
+				    "contents size invalid, expected "
+				    "%" G_GSIZE_FORMAT ", got %" G_GUINT64_FORMAT,
+				    streamsz,
+				    size);
+			return FALSE;
+		}
+	} else {
+		guint64 size = streamsz;
+		g_autoptr(GBytes) blob_sz = g_bytes_new(&size, sizeof(guint64));
+		xb_node_set_data(release, "fwupd::ReleaseSize", blob_sz);
+	}
+
+	/* the details-only path must never read the payload, so no checksum verification is
+	 * possible and the trusted-payload flag cannot be set */
+	if (!self->only_metadata) {
+		if (!fu_cabinet_parse_release_verify(self,
+						     checksum_helpers,
+						     basename,
+						     img_blob,
+						     stream,
+						     csum_tmp,
+						     &release_flags,
+						     error))
+			return FALSE;
+	}
+
 	/* this means we can get the data from fu_keyring_get_release_flags */
 	release_flags_blob = g_bytes_new(&release_flags, sizeof(release_flags));
 	xb_node_set_data(release, "fwupd::ReleaseFlags", release_flags_blob);
@@ -866,9 +1022,17 @@ fu_cabinet_parse(FuFirmware *firmware,
 		 GError **error)
 {
 	FuCabinet *self = FU_CABINET(firmware);
+	guint max_threads;
 
 	g_autoptr(GError) error_local = NULL;
+	g_autoptr(GHashTable) checksum_helpers =
+	    g_hash_table_new_full(g_str_hash,
+				  g_str_equal,
+				  g_free,
+				  (GDestroyNotify)fu_cabinet_checksum_helper_free);
+	g_autoptr(GList) helpers = NULL;
 	g_autoptr(GPtrArray) components = NULL;
+	g_autoptr(GPtrArray) releases_all = g_ptr_array_new_with_free_func(g_object_unref);
 	g_autoptr(XbQuery) query = NULL;
 
 	g_return_val_if_fail(FU_IS_CABINET(self), FALSE);
@@ -913,7 +1077,7 @@ fu_cabinet_parse(FuFirmware *firmware,
 	if (query == NULL)
 		return FALSE;
 
-	/* process each listed release */
+	/* find each listed release */
 	for (guint i = 0; i < components->len; i++) {
 		XbNode *component = g_ptr_array_index(components, i);
 		g_autoptr(GPtrArray) releases = NULL;
@@ -930,12 +1094,54 @@ fu_cabinet_parse(FuFirmware *firmware,
 		}
 		for (guint j = 0; j < releases->len; j++) {
 			XbNode *rel = g_ptr_array_index(releases, j);
-			g_info("processing release: %s", xb_node_get_attr(rel, "version"));
-			if (!fu_cabinet_parse_release(self, rel, error))
-				return FALSE;
+			g_ptr_array_add(releases_all, g_object_ref(rel));
 		}
 	}
 
+	/* compute the payload digests on a bounded worker pool; the xmlb and jcat calls are
+	 * not thread-safe so only the hashing is moved off the main thread -- skipped entirely
+	 * for metadata-only parsing as the payloads are never verified */
+	if (!self->only_metadata) {
+		for (guint i = 0; i < releases_all->len; i++) {
+			XbNode *rel = g_ptr_array_index(releases_all, i);
+			fu_cabinet_parse_release_precompute(self, checksum_helpers, rel);
+		}
+		helpers = g_hash_table_get_values(checksum_helpers);
+		max_threads = MIN(g_get_num_processors(), g_hash_table_size(checksum_helpers));
+		if (max_threads > 1) {
+			GThreadPool *pool;
+			g_autoptr(GError) error_pool = NULL;
+
+			pool = g_thread_pool_new(fu_cabinet_parse_release_checksum_cb,
+						 self,
+						 (gint)max_threads,
+						 FALSE,
+						 &error_pool);
+			if (pool == NULL) {
+				g_debug(
+				    "failed to create checksum pool, falling back to serial: %s",
+				    error_pool->message);
+				max_threads = 1;
+			} else {
+				for (GList *l = helpers; l != NULL; l = l->next)
+					g_thread_pool_push(pool, l->data, NULL);
+				g_thread_pool_free(pool, FALSE, TRUE);
+			}
+		}
+		if (max_threads <= 1) {
+			for (GList *l = helpers; l != NULL; l = l->next)
+				fu_cabinet_parse_release_checksum_cb(l->data, self);
+		}
+	}
+
+	/* process each listed release */
+	for (guint i = 0; i < releases_all->len; i++) {
+		XbNode *rel = g_ptr_array_index(releases_all, i);
+		g_info("processing release: %s", xb_node_get_attr(rel, "version"));
+		if (!fu_cabinet_parse_release(self, rel, checksum_helpers, error))
+			return FALSE;
+	}
+
 	/* success */
 	return TRUE;
 }
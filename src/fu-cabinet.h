@@ -31,6 +31,8 @@ FuCabinet *
 fu_cabinet_new(void);
 void
 fu_cabinet_set_jcat_context(FuCabinet *self, JcatContext *jcat_context) G_GNUC_NON_NULL(1);
+void
+fu_cabinet_set_only_metadata(FuCabinet *self, gboolean only_metadata) G_GNUC_NON_NULL(1);
 gboolean
 fu_cabinet_sign(FuCabinet *self,
 		GBytes *cert,
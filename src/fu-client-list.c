@@ -12,8 +12,9 @@
 
 struct _FuClientList {
 	GObject parent_instance;
-	GPtrArray *array;	     /* (element-type FuClientListItem) */
-	GDBusConnection *connection; /* nullable */
+	GPtrArray *array;	      /* (element-type FuClientListItem) */
+	GHashTable *items_by_sender;  /* (element-type utf8 FuClientListItem), no-ref */
+	GDBusConnection *connection;  /* nullable */
 };
 
 typedef struct {
@@ -53,6 +54,8 @@ fu_client_list_sender_name_vanished_cb(GDBusConnection *connection,
 	FuClientList *self = FU_CLIENT_LIST(item->self);
 	g_autoptr(FuClient) client = g_object_ref(item->client);
 	fu_client_remove_flag(client, FU_CLIENT_FLAG_ACTIVE);
+	if (fu_client_get_sender(client) != NULL)
+		g_hash_table_remove(self->items_by_sender, fu_client_get_sender(client));
 	g_ptr_array_remove(self->array, item);
 	fu_client_list_emit_removed(self, client);
 }
@@ -85,6 +88,11 @@ fu_client_list_register(FuClientList *self, const gchar *sender)
 						   NULL);
 	}
 	g_ptr_array_add(self->array, item);
+	if (sender != NULL) {
+		g_hash_table_insert(self->items_by_sender,
+				    (gpointer)fu_client_get_sender(item->client),
+				    item);
+	}
 
 	/* success */
 	fu_client_list_emit_added(self, item->client);
@@ -106,10 +114,20 @@ fu_client_list_get_all(FuClientList *self)
 FuClient *
 fu_client_list_get_by_sender(FuClientList *self, const gchar *sender)
 {
+	FuClientListItem *item;
+
 	g_return_val_if_fail(FU_IS_CLIENT_LIST(self), NULL);
+
+	/* look up in the index, falling back to a scan for a NULL sender */
+	if (sender != NULL) {
+		item = g_hash_table_lookup(self->items_by_sender, sender);
+		if (item != NULL)
+			return g_object_ref(item->client);
+		return NULL;
+	}
 	for (guint i = 0; i < self->array->len; i++) {
-		FuClientListItem *item = g_ptr_array_index(self->array, i);
-		if (g_strcmp0(sender, fu_client_get_sender(item->client)) == 0)
+		item = g_ptr_array_index(self->array, i);
+		if (fu_client_get_sender(item->client) == NULL)
 			return g_object_ref(item->client);
 	}
 	return NULL;
@@ -156,12 +174,14 @@ static void
 fu_client_list_init(FuClientList *self)
 {
 	self->array = g_ptr_array_new_with_free_func((GDestroyNotify)fu_client_list_item_free);
+	self->items_by_sender = g_hash_table_new(g_str_hash, g_str_equal);
 }
 
 static void
 fu_client_list_finalize(GObject *obj)
 {
 	FuClientList *self = FU_CLIENT_LIST(obj);
+	g_hash_table_unref(self->items_by_sender);
 	g_ptr_array_unref(self->array);
 	if (self->connection != NULL)
 		g_object_unref(self->connection);
@@ -18,6 +18,9 @@
 #include <windows.h>
 #endif
 
+/* do not repaint the progressbar more often than this, e.g. for slow serial consoles */
+#define FU_CONSOLE_REFRESH_INTERVAL_MS 50
+
 struct _FuConsole {
 	GObject parent_instance;
 	GMainContext *main_ctx;
@@ -29,6 +32,8 @@ struct _FuConsole {
 	guint percentage;
 	GSource *timer_source;
 	gint64 last_animated; /* monotonic */
+	gint64 last_refresh;  /* monotonic */
+	gchar *frame_last;
 	GTimer *time_elapsed;
 	gdouble last_estimate;
 	gboolean interactive;
@@ -112,6 +117,7 @@ fu_console_reset_line(FuConsole *self)
 		fu_console_erase_line(self);
 		g_print("\n");
 		self->contents_to_clear = FALSE;
+		g_clear_pointer(&self->frame_last, g_free);
 	}
 }
 
@@ -451,6 +457,34 @@ fu_console_time_remaining_str(FuConsole *self)
 	    self->last_estimate / 60);
 }
 
+static void
+fu_console_refresh_frame(FuConsole *self, const gchar *frame)
+{
+	gsize offset = 0;
+
+	/* identical frame, so nothing to write */
+	if (g_strcmp0(frame, self->frame_last) == 0)
+		return;
+
+	/* diff against the previous frame so only the changed suffix is sent */
+	if (self->frame_last != NULL) {
+		while (frame[offset] != '\0' && frame[offset] == self->frame_last[offset])
+			offset++;
+		/* do not split a UTF-8 sequence */
+		while (offset > 0 && ((guchar)frame[offset] & 0xC0) == 0x80)
+			offset--;
+	}
+	if (offset > 0) {
+		g_autofree gchar *prefix = g_strndup(frame, offset);
+		g_print("\033[%uG%s\033[K", (guint)fu_strwidth(prefix) + 1, frame + offset);
+	} else {
+		g_print("\033[G%s\033[K", frame);
+	}
+	g_free(self->frame_last);
+	self->frame_last = g_strdup(frame);
+	self->last_refresh = g_get_monotonic_time();
+}
+
 static void
 fu_console_refresh(FuConsole *self)
 {
@@ -462,9 +496,6 @@ fu_console_refresh(FuConsole *self)
 	if (self->status == FWUPD_STATUS_IDLE || self->status == FWUPD_STATUS_UNKNOWN)
 		return;
 
-	/* erase previous line */
-	fu_console_erase_line(self);
-
 	/* add status */
 	title = fu_console_status_to_string(self->status);
 	g_string_append(str, title);
@@ -500,8 +531,8 @@ fu_console_refresh(FuConsole *self)
 			g_string_append_printf(str, " %s…", remaining);
 	}
 
-	/* dump to screen */
-	g_print("%s", str->str);
+	/* dump to screen, writing only the part of the frame that changed */
+	fu_console_refresh_frame(self, str->str);
 	self->contents_to_clear = TRUE;
 }
 
@@ -578,7 +609,8 @@ fu_console_set_progress_title(FuConsole *self, const gchar *title)
 	if (!self->interactive)
 		return;
 	fu_console_erase_line(self);
-	g_print("%s\n", title);
+	g_print("%s\033[K\n", title);
+	g_clear_pointer(&self->frame_last, g_free);
 	fu_console_refresh(self);
 }
 
@@ -662,6 +694,8 @@ fu_console_spin_start(FuConsole *self)
 void
 fu_console_set_progress(FuConsole *self, FwupdStatus status, guint percentage)
 {
+	gboolean status_changed;
+
 	g_return_if_fail(FU_IS_CONSOLE(self));
 
 	/* not useful */
@@ -673,6 +707,7 @@ fu_console_set_progress(FuConsole *self, FwupdStatus status, guint percentage)
 		return;
 
 	/* cache */
+	status_changed = self->status != status;
 	self->status = status;
 	self->percentage = percentage;
 
@@ -682,6 +717,11 @@ fu_console_set_progress(FuConsole *self, FwupdStatus status, guint percentage)
 		return;
 	}
 
+	/* cap the repaint rate; the next percentage update will catch up */
+	if (!status_changed && percentage > 0 && percentage < 100 &&
+	    (g_get_monotonic_time() - self->last_refresh) / 1000 < FU_CONSOLE_REFRESH_INTERVAL_MS)
+		return;
+
 	/* if the main loop isn't spinning and we've not had a chance to
 	 * execute the callback just do the refresh now manually */
 	if (percentage == 0 && status != FWUPD_STATUS_IDLE &&
@@ -777,6 +817,7 @@ fu_console_finalize(GObject *obj)
 		g_source_destroy(self->timer_source);
 	if (self->main_ctx != NULL)
 		g_main_context_unref(self->main_ctx);
+	g_free(self->frame_last);
 	g_timer_destroy(self->time_elapsed);
 
 	G_OBJECT_CLASS(fu_console_parent_class)->finalize(obj);
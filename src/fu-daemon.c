@@ -216,6 +216,20 @@ fu_daemon_setup(FuDaemon *self, const gchar *socket_address, GError **error)
 			g_print("\n%s\n", str);
 	}
 
+	/* also dump the startup spans in a format Perfetto can load */
+	if (g_getenv("FWUPD_PROFILE_TRACE") != NULL) {
+		const gchar *fn = g_getenv("FWUPD_PROFILE_TRACE");
+		g_autofree gchar *str = fu_progress_to_trace_string(progress);
+		g_autoptr(GError) error_local = NULL;
+		if (str == NULL) {
+			g_warning("no trace data recorded");
+		} else if (!g_file_set_contents(fn, str, -1, &error_local)) {
+			g_warning("failed to write %s: %s", fn, error_local->message);
+		} else {
+			g_info("wrote startup trace to %s", fn);
+		}
+	}
+
 	/* success */
 	return TRUE;
 }
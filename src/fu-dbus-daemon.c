@@ -8,6 +8,8 @@
 
 #include "config.h"
 
+#include <fcntl.h>
+
 #include <fwupdplugin.h>
 #ifdef HAVE_GIO_UNIX
 #include <gio/gunixfdlist.h>
@@ -45,9 +47,22 @@ struct _FuDbusDaemon {
 	guint32 clients_inhibit_id;
 	FuPolkitAuthority *authority;
 	FwupdStatus status; /* last emitted */
-	guint percentage;   /* last emitted */
+	guint percentage;	   /* last emitted */
+	guint64 bytes_transferred; /* last emitted */
+	guint64 transfer_rate;	   /* last emitted */
+	guint eta;		   /* last emitted */
 	guint owner_id;
 	GPtrArray *system_inhibits;
+	GPtrArray *install_pending; /* (element-type FuMainAuthHelper) */
+	guint64 install_pending_sz;
+	gint install_in_progress; /* atomic, read from the GDBus worker thread */
+	GHashTable *device_changed_last;    /* (element-type utf8 GVariant) */
+	GHashTable *device_variant_trusted; /* (element-type utf8 GVariant) */
+	GMutex device_variant_mutex; /* guards the two variant caches above */
+	GMutex snapshot_mutex;		 /* accessed from the GDBus worker thread */
+	GVariant *snapshot_devices;	 /* (nullable) last-known GetDevices reply */
+	GVariant *snapshot_plugins;	 /* (nullable) last-known GetPlugins reply */
+	guint snapshot_rebuild_id;
 };
 
 G_DEFINE_TYPE(FuDbusDaemon, fu_dbus_daemon, FU_TYPE_DAEMON)
@@ -57,6 +72,127 @@ G_DEFINE_TYPE(FuDbusDaemon, fu_dbus_daemon, FU_TYPE_DAEMON)
 	 FWUPD_INSTALL_FLAG_ALLOW_BRANCH_SWITCH | FWUPD_INSTALL_FLAG_FORCE |                       \
 	 FWUPD_INSTALL_FLAG_NO_HISTORY | FWUPD_INSTALL_FLAG_IGNORE_REQUIREMENTS)
 
+/* emit at most ten progress updates per second during an install */
+#define FU_DBUS_DAEMON_PROGRESS_EMIT_INTERVAL_MS 100
+
+/* the serialized form of each device only changes when the engine emits ::device-changed,
+ * so keep it cached between enumeration calls and only re-marshal the devices that moved */
+static GVariant *
+fu_dbus_daemon_device_to_variant_cached(FuDbusDaemon *self, FuDevice *device, FwupdCodecFlags flags)
+{
+	GHashTable *cache = NULL;
+	GVariant *val;
+	g_autoptr(GMutexLocker) locker = NULL;
+
+	if (flags == FWUPD_CODEC_FLAG_NONE)
+		cache = self->device_changed_last;
+	else if (flags == FWUPD_CODEC_FLAG_TRUSTED)
+		cache = self->device_variant_trusted;
+	if (cache == NULL)
+		return g_variant_take_ref(fwupd_codec_to_variant(FWUPD_CODEC(device), flags));
+
+	/* the engine emits device signals from whatever thread registered the device,
+	 * so the caches race the main loop without this */
+	locker = g_mutex_locker_new(&self->device_variant_mutex);
+	val = g_hash_table_lookup(cache, fu_device_get_id(device));
+	if (val == NULL) {
+		val = g_variant_take_ref(fwupd_codec_to_variant(FWUPD_CODEC(device), flags));
+		g_hash_table_insert(cache, g_strdup(fu_device_get_id(device)), val);
+	}
+	return g_variant_ref(val);
+}
+
+static gboolean
+fu_dbus_daemon_snapshot_rebuild_cb(gpointer user_data)
+{
+	FuDbusDaemon *self = FU_DBUS_DAEMON(user_data);
+	FuEngine *engine = fu_daemon_get_engine(FU_DAEMON(self));
+	g_autoptr(GMutexLocker) locker = NULL;
+	g_autoptr(GPtrArray) devices = NULL;
+	g_autoptr(GVariant) val_devices = NULL;
+	g_autoptr(GVariant) val_plugins = NULL;
+
+	self->snapshot_rebuild_id = 0;
+
+	/* serialized with no per-caller trust flags, so safe to hand to anyone */
+	devices = fu_engine_get_devices(engine, NULL);
+	if (devices != NULL) {
+		GVariantBuilder builder;
+		g_variant_builder_init(&builder, G_VARIANT_TYPE("aa{sv}"));
+		for (guint i = 0; i < devices->len; i++) {
+			FuDevice *device = g_ptr_array_index(devices, i);
+			g_autoptr(GVariant) value =
+			    fu_dbus_daemon_device_to_variant_cached(self,
+								    device,
+								    FWUPD_CODEC_FLAG_NONE);
+			g_variant_builder_add_value(&builder, value);
+		}
+		val_devices = g_variant_take_ref(g_variant_new("(aa{sv})", &builder));
+	}
+	val_plugins = g_variant_take_ref(
+	    fwupd_codec_array_to_variant(fu_engine_get_plugins(engine), FWUPD_CODEC_FLAG_NONE));
+
+	locker = g_mutex_locker_new(&self->snapshot_mutex);
+	if (val_devices != NULL) {
+		if (self->snapshot_devices != NULL)
+			g_variant_unref(self->snapshot_devices);
+		self->snapshot_devices = g_steal_pointer(&val_devices);
+	}
+	if (self->snapshot_plugins != NULL)
+		g_variant_unref(self->snapshot_plugins);
+	self->snapshot_plugins = g_steal_pointer(&val_plugins);
+	return G_SOURCE_REMOVE;
+}
+
+static void
+fu_dbus_daemon_snapshot_invalidate(FuDbusDaemon *self)
+{
+	if (self->snapshot_rebuild_id != 0)
+		return;
+	self->snapshot_rebuild_id = g_idle_add(fu_dbus_daemon_snapshot_rebuild_cb, self);
+}
+
+/* runs in the GDBus worker thread: while the main loop is wedged by a long-running
+ * install, answer trivial enumeration calls from the last-known snapshot so that
+ * fleet tooling can still observe the device inventory */
+static GDBusMessage *
+fu_dbus_daemon_message_filter_cb(GDBusConnection *connection,
+				 GDBusMessage *message,
+				 gboolean incoming,
+				 gpointer user_data)
+{
+	FuDbusDaemon *self = FU_DBUS_DAEMON(user_data);
+	const gchar *member;
+	g_autoptr(GDBusMessage) reply = NULL;
+	g_autoptr(GMutexLocker) locker = NULL;
+	g_autoptr(GVariant) val = NULL;
+
+	if (!incoming)
+		return message;
+	if (!g_atomic_int_get(&self->install_in_progress))
+		return message;
+	if (g_dbus_message_get_message_type(message) != G_DBUS_MESSAGE_TYPE_METHOD_CALL)
+		return message;
+	if (g_strcmp0(g_dbus_message_get_path(message), FWUPD_DBUS_PATH) != 0 ||
+	    g_strcmp0(g_dbus_message_get_interface(message), FWUPD_DBUS_INTERFACE) != 0)
+		return message;
+	member = g_dbus_message_get_member(message);
+	locker = g_mutex_locker_new(&self->snapshot_mutex);
+	if (g_strcmp0(member, "GetDevices") == 0 && self->snapshot_devices != NULL)
+		val = g_variant_ref(self->snapshot_devices);
+	else if (g_strcmp0(member, "GetPlugins") == 0 && self->snapshot_plugins != NULL)
+		val = g_variant_ref(self->snapshot_plugins);
+	if (val == NULL)
+		return message;
+	g_clear_pointer(&locker, g_mutex_locker_free);
+
+	reply = g_dbus_message_new_method_reply(message);
+	g_dbus_message_set_body(reply, g_variant_new_tuple(&val, 1));
+	g_dbus_connection_send_message(connection, reply, G_DBUS_SEND_MESSAGE_FLAGS_NONE, NULL, NULL);
+	g_object_unref(message);
+	return NULL;
+}
+
 static void
 fu_dbus_daemon_engine_changed_cb(FuEngine *engine, FuDbusDaemon *self)
 {
@@ -70,18 +206,27 @@ fu_dbus_daemon_engine_changed_cb(FuEngine *engine, FuDbusDaemon *self)
 				      "Changed",
 				      NULL,
 				      NULL);
+	fu_dbus_daemon_snapshot_invalidate(self);
 	fu_daemon_schedule_housekeeping(FU_DAEMON(self));
 }
 
 static void
 fu_dbus_daemon_engine_device_added_cb(FuEngine *engine, FuDevice *device, FuDbusDaemon *self)
 {
-	GVariant *val;
+	g_autoptr(GMutexLocker) locker = NULL;
+	g_autoptr(GVariant) val = NULL;
 
 	/* not yet connected */
 	if (self->connection == NULL)
 		return;
-	val = fwupd_codec_to_variant(FWUPD_CODEC(device), FWUPD_CODEC_FLAG_NONE);
+	val = g_variant_take_ref(
+	    fwupd_codec_to_variant(FWUPD_CODEC(device), FWUPD_CODEC_FLAG_NONE));
+	locker = g_mutex_locker_new(&self->device_variant_mutex);
+	g_hash_table_insert(self->device_changed_last,
+			    g_strdup(fu_device_get_id(device)),
+			    g_variant_ref(val));
+	g_hash_table_remove(self->device_variant_trusted, fu_device_get_id(device));
+	g_clear_pointer(&locker, g_mutex_locker_free);
 	g_dbus_connection_emit_signal(self->connection,
 				      NULL,
 				      FWUPD_DBUS_PATH,
@@ -89,18 +234,25 @@ fu_dbus_daemon_engine_device_added_cb(FuEngine *engine, FuDevice *device, FuDbus
 				      "DeviceAdded",
 				      g_variant_new_tuple(&val, 1),
 				      NULL);
+	fu_dbus_daemon_snapshot_invalidate(self);
 	fu_daemon_schedule_housekeeping(FU_DAEMON(self));
 }
 
 static void
 fu_dbus_daemon_engine_device_removed_cb(FuEngine *engine, FuDevice *device, FuDbusDaemon *self)
 {
-	GVariant *val;
+	g_autoptr(GMutexLocker) locker = NULL;
+	g_autoptr(GVariant) val = NULL;
 
 	/* not yet connected */
 	if (self->connection == NULL)
 		return;
-	val = fwupd_codec_to_variant(FWUPD_CODEC(device), FWUPD_CODEC_FLAG_NONE);
+	val = g_variant_take_ref(
+	    fwupd_codec_to_variant(FWUPD_CODEC(device), FWUPD_CODEC_FLAG_NONE));
+	locker = g_mutex_locker_new(&self->device_variant_mutex);
+	g_hash_table_remove(self->device_changed_last, fu_device_get_id(device));
+	g_hash_table_remove(self->device_variant_trusted, fu_device_get_id(device));
+	g_clear_pointer(&locker, g_mutex_locker_free);
 	g_dbus_connection_emit_signal(self->connection,
 				      NULL,
 				      FWUPD_DBUS_PATH,
@@ -108,18 +260,38 @@ fu_dbus_daemon_engine_device_removed_cb(FuEngine *engine, FuDevice *device, FuDb
 				      "DeviceRemoved",
 				      g_variant_new_tuple(&val, 1),
 				      NULL);
+	fu_dbus_daemon_snapshot_invalidate(self);
 	fu_daemon_schedule_housekeeping(FU_DAEMON(self));
 }
 
 static void
 fu_dbus_daemon_engine_device_changed_cb(FuEngine *engine, FuDevice *device, FuDbusDaemon *self)
 {
-	GVariant *val;
+	GVariant *val_last;
+	g_autoptr(GMutexLocker) locker = NULL;
+	g_autoptr(GVariant) val = NULL;
 
 	/* not yet connected */
 	if (self->connection == NULL)
 		return;
-	val = fwupd_codec_to_variant(FWUPD_CODEC(device), FWUPD_CODEC_FLAG_NONE);
+	val = g_variant_take_ref(
+	    fwupd_codec_to_variant(FWUPD_CODEC(device), FWUPD_CODEC_FLAG_NONE));
+	locker = g_mutex_locker_new(&self->device_variant_mutex);
+
+	/* the trusted form may have changed even if the redacted form did not */
+	g_hash_table_remove(self->device_variant_trusted, fu_device_get_id(device));
+
+	/* nothing in the serialized form actually changed, so do not wake up all the clients */
+	val_last = g_hash_table_lookup(self->device_changed_last, fu_device_get_id(device));
+	if (val_last != NULL && g_variant_equal(val_last, val)) {
+		g_debug("suppressing duplicate DeviceChanged for %s", fu_device_get_id(device));
+		return;
+	}
+	g_hash_table_insert(self->device_changed_last,
+			    g_strdup(fu_device_get_id(device)),
+			    g_variant_ref(val));
+	g_clear_pointer(&locker, g_mutex_locker_free);
+
 	g_dbus_connection_emit_signal(self->connection,
 				      NULL,
 				      FWUPD_DBUS_PATH,
@@ -127,18 +299,20 @@ fu_dbus_daemon_engine_device_changed_cb(FuEngine *engine, FuDevice *device, FuDb
 				      "DeviceChanged",
 				      g_variant_new_tuple(&val, 1),
 				      NULL);
+	fu_dbus_daemon_snapshot_invalidate(self);
 	fu_daemon_schedule_housekeeping(FU_DAEMON(self));
 }
 
 static void
 fu_dbus_daemon_engine_device_request_cb(FuEngine *engine, FwupdRequest *request, FuDbusDaemon *self)
 {
-	GVariant *val;
+	g_autoptr(GVariant) val = NULL;
 
 	/* not yet connected */
 	if (self->connection == NULL)
 		return;
-	val = fwupd_codec_to_variant(FWUPD_CODEC(request), FWUPD_CODEC_FLAG_NONE);
+	val = g_variant_take_ref(
+	    fwupd_codec_to_variant(FWUPD_CODEC(request), FWUPD_CODEC_FLAG_NONE));
 	g_dbus_connection_emit_signal(self->connection,
 				      NULL,
 				      FWUPD_DBUS_PATH,
@@ -210,6 +384,11 @@ fu_dbus_daemon_create_request(FuDbusDaemon *self, const gchar *sender, GError **
 	g_autoptr(FuEngineRequest) request = fu_engine_request_new(sender);
 	g_autoptr(GVariant) value = NULL;
 
+	/* cap how much daemon memory any one request is allowed to pin */
+	fu_engine_request_set_memory_limit(
+	    request,
+	    fu_engine_config_get_request_size_max(fu_engine_get_config(engine)));
+
 	/* if using FWUPD_DBUS_SOCKET... */
 	if (sender == NULL) {
 		fu_engine_request_set_converter_flags(request, FWUPD_CODEC_FLAG_TRUSTED);
@@ -259,6 +438,29 @@ fu_dbus_daemon_device_array_to_variant(FuDbusDaemon *self,
 	return fwupd_codec_array_to_variant(devices, flags);
 }
 
+/* as above, but for the live device inventory only: history and per-release snapshots
+ * serialize differently for the same device ID and so must not share the cache */
+static GVariant *
+fu_dbus_daemon_device_array_to_variant_cached(FuDbusDaemon *self,
+					      FuEngineRequest *request,
+					      GPtrArray *devices)
+{
+	FuEngine *engine = fu_daemon_get_engine(FU_DAEMON(self));
+	FwupdCodecFlags flags = fu_engine_request_get_converter_flags(request);
+	GVariantBuilder builder;
+
+	if (fu_engine_config_get_show_device_private(fu_engine_get_config(engine)))
+		flags |= FWUPD_CODEC_FLAG_TRUSTED;
+	g_variant_builder_init(&builder, G_VARIANT_TYPE("aa{sv}"));
+	for (guint i = 0; i < devices->len; i++) {
+		FuDevice *device = g_ptr_array_index(devices, i);
+		g_autoptr(GVariant) value =
+		    fu_dbus_daemon_device_to_variant_cached(self, device, flags);
+		g_variant_builder_add_value(&builder, value);
+	}
+	return g_variant_new("(aa{sv})", &builder);
+}
+
 typedef struct {
 	GDBusMethodInvocation *invocation;
 	FuEngineRequest *request;
@@ -281,6 +483,8 @@ typedef struct {
 	FuCabinet *cabinet;
 	GHashTable *bios_settings; /* str:str */
 	gboolean is_fix;
+	gboolean batch;
+	guint64 archive_sz;
 } FuMainAuthHelper;
 
 static void
@@ -568,6 +772,28 @@ fu_dbus_daemon_progress_percentage_changed_cb(FuProgress *progress,
 					      guint percentage,
 					      FuDbusDaemon *self)
 {
+	guint64 bytes_transferred = fu_progress_get_bytes_transferred(progress);
+	guint64 transfer_rate = fu_progress_get_transfer_rate(progress);
+	guint eta = fu_progress_get_eta(progress);
+
+	/* updated engine-side so the fleet tooling does not have to guess from percentages */
+	if (bytes_transferred != self->bytes_transferred) {
+		self->bytes_transferred = bytes_transferred;
+		fu_dbus_daemon_emit_property_changed(self,
+						     "BytesTransferred",
+						     g_variant_new_uint64(bytes_transferred));
+	}
+	if (transfer_rate != self->transfer_rate) {
+		self->transfer_rate = transfer_rate;
+		fu_dbus_daemon_emit_property_changed(self,
+						     "TransferRate",
+						     g_variant_new_uint64(transfer_rate));
+	}
+	if (eta != self->eta) {
+		self->eta = eta;
+		fu_dbus_daemon_emit_property_changed(self, "Eta", g_variant_new_uint32(eta));
+	}
+
 	/* sanity check */
 	if (self->percentage == percentage)
 		return;
@@ -695,6 +921,12 @@ fu_dbus_daemon_engine_request_get_authority_check_flags(FuEngineRequest *request
 #ifdef HAVE_GIO_UNIX
 static void
 fu_dbus_daemon_authorize_install_queue(FuMainAuthHelper *helper);
+static void
+fu_dbus_daemon_install_helper_run(FuDbusDaemon *self, FuMainAuthHelper *helper_ref);
+static void
+fu_dbus_daemon_install_queue_push(FuDbusDaemon *self, FuMainAuthHelper *helper);
+static gboolean
+fu_dbus_daemon_install_queue_idle_cb(gpointer user_data);
 
 static void
 fu_dbus_daemon_authorize_install_cb(GObject *source, GAsyncResult *res, gpointer user_data)
@@ -717,9 +949,6 @@ fu_dbus_daemon_authorize_install_queue(FuMainAuthHelper *helper_ref)
 {
 	FuDbusDaemon *self = helper_ref->self;
 	g_autoptr(FuMainAuthHelper) helper = helper_ref;
-	g_autoptr(GError) error = NULL;
-	gboolean ret;
-	FuEngine *engine = fu_daemon_get_engine(FU_DAEMON(helper->self));
 
 	/* still more things to to authenticate */
 	if (helper->action_ids->len > 0) {
@@ -738,8 +967,26 @@ fu_dbus_daemon_authorize_install_queue(FuMainAuthHelper *helper_ref)
 		return;
 	}
 
+	/* another client install is running; park this one in the pending queue and reply
+	 * when it has had its turn */
+	if (g_atomic_int_get(&self->install_in_progress)) {
+		fu_dbus_daemon_install_queue_push(self, g_steal_pointer(&helper));
+		return;
+	}
+	fu_dbus_daemon_install_helper_run(self, g_steal_pointer(&helper));
+}
+
+static void
+fu_dbus_daemon_install_helper_run(FuDbusDaemon *self, FuMainAuthHelper *helper_ref)
+{
+	FuEngine *engine = fu_daemon_get_engine(FU_DAEMON(self));
+	gboolean ret;
+	g_autoptr(FuMainAuthHelper) helper = helper_ref;
+	g_autoptr(GError) error = NULL;
+
 	/* all authenticated, so install all the things */
 	fu_progress_set_profile(helper->progress, g_getenv("FWUPD_VERBOSE") != NULL);
+	fu_progress_set_emit_interval(helper->progress, FU_DBUS_DAEMON_PROGRESS_EMIT_INTERVAL_MS);
 	g_signal_connect(FU_PROGRESS(helper->progress),
 			 "percentage-changed",
 			 G_CALLBACK(fu_dbus_daemon_progress_percentage_changed_cb),
@@ -750,6 +997,7 @@ fu_dbus_daemon_authorize_install_queue(FuMainAuthHelper *helper_ref)
 			 helper->self);
 
 	/* all authenticated, so install all the things */
+	g_atomic_int_set(&self->install_in_progress, TRUE);
 	fu_daemon_set_update_in_progress(FU_DAEMON(self), TRUE);
 	ret = fu_engine_install_releases(engine,
 					 helper->request,
@@ -759,6 +1007,12 @@ fu_dbus_daemon_authorize_install_queue(FuMainAuthHelper *helper_ref)
 					 helper->flags,
 					 &error);
 	fu_daemon_set_update_in_progress(FU_DAEMON(self), FALSE);
+	g_atomic_int_set(&self->install_in_progress, FALSE);
+
+	/* start anything that queued up behind us */
+	if (self->install_pending->len > 0)
+		g_idle_add(fu_dbus_daemon_install_queue_idle_cb, self);
+
 	if (fu_daemon_get_pending_stop(FU_DAEMON(self))) {
 		g_set_error_literal(&error,
 				    FWUPD_ERROR,
@@ -775,6 +1029,47 @@ fu_dbus_daemon_authorize_install_queue(FuMainAuthHelper *helper_ref)
 	/* success */
 	g_dbus_method_invocation_return_value(helper->invocation, NULL);
 }
+
+static gboolean
+fu_dbus_daemon_install_queue_idle_cb(gpointer user_data)
+{
+	FuDbusDaemon *self = FU_DBUS_DAEMON(user_data);
+	FuMainAuthHelper *helper;
+
+	/* all done, or something else got in first */
+	if (self->install_pending->len == 0 || g_atomic_int_get(&self->install_in_progress))
+		return G_SOURCE_REMOVE;
+	helper = g_ptr_array_index(self->install_pending, 0);
+	self->install_pending_sz -= helper->archive_sz;
+	g_ptr_array_steal_index(self->install_pending, 0);
+	fu_dbus_daemon_install_helper_run(self, helper);
+	return G_SOURCE_REMOVE;
+}
+
+static void
+fu_dbus_daemon_install_queue_push(FuDbusDaemon *self, FuMainAuthHelper *helper)
+{
+	guint idx = self->install_pending->len;
+
+	/* interactive requests jump ahead of any queued batch work, e.g. so an urgent
+	 * single-device fix does not wait for a whole fleet rollout to drain */
+	if (!helper->batch) {
+		for (guint i = 0; i < self->install_pending->len; i++) {
+			FuMainAuthHelper *helper_tmp = g_ptr_array_index(self->install_pending, i);
+			if (helper_tmp->batch) {
+				idx = i;
+				break;
+			}
+		}
+	}
+	g_ptr_array_insert(self->install_pending, idx, helper);
+	self->install_pending_sz += helper->archive_sz;
+	g_info("queued %s install of %s at position %u of %u",
+	       helper->batch ? "batch" : "interactive",
+	       helper->device_id,
+	       idx,
+	       self->install_pending->len);
+}
 #endif /* HAVE_GIO_UNIX */
 
 #ifdef HAVE_GIO_UNIX
@@ -1067,6 +1362,26 @@ fu_dbus_daemon_invocation_get_input_stream(GDBusMethodInvocation *invocation, GE
 	if (fd < 0)
 		return NULL;
 
+#ifdef F_GET_SEALS
+	/* a write-sealed memfd cannot change under us, so map it once and share the pages
+	 * between every queued install rather than re-reading the whole archive */
+	{
+		gint seals = fcntl(fd, F_GET_SEALS);
+		if (seals > 0 && (seals & (F_SEAL_SHRINK | F_SEAL_WRITE)) ==
+				     (F_SEAL_SHRINK | F_SEAL_WRITE)) {
+			g_autoptr(GMappedFile) mapped_file =
+			    g_mapped_file_new_from_fd(fd, FALSE, NULL);
+			if (mapped_file != NULL) {
+				g_autoptr(GBytes) bytes = g_mapped_file_get_bytes(mapped_file);
+				g_close(fd, NULL);
+				g_debug("mapped sealed memfd of size 0x%x",
+					(guint)g_bytes_get_size(bytes));
+				return g_memory_input_stream_new_from_bytes(bytes);
+			}
+		}
+	}
+#endif
+
 	/* get details about the file (will close the fd when done) */
 	stream = fu_unix_seekable_input_stream_new(fd, TRUE);
 	if (stream == NULL) {
@@ -1168,7 +1483,132 @@ fu_dbus_daemon_method_get_devices(FuDbusDaemon *self,
 		fu_dbus_daemon_method_invocation_return_gerror(invocation, error);
 		return;
 	}
-	val = fu_dbus_daemon_device_array_to_variant(self, request, devices, &error);
+	val = fu_dbus_daemon_device_array_to_variant_cached(self, request, devices);
+	g_dbus_method_invocation_return_value(invocation, val);
+}
+
+static void
+fu_dbus_daemon_method_get_devices_filtered(FuDbusDaemon *self,
+					   GVariant *parameters,
+					   FuEngineRequest *request,
+					   GDBusMethodInvocation *invocation)
+{
+	FuEngine *engine = fu_daemon_get_engine(FU_DAEMON(self));
+	GVariant *prop_value;
+	GVariant *val;
+	const gchar *prop_key;
+	guint64 flags = FWUPD_DEVICE_FLAG_NONE;
+	guint offset = 0;
+	guint limit = 0;
+	g_autofree gchar *vendor_id = NULL;
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GPtrArray) devices = NULL;
+	g_autoptr(GPtrArray) devices_filtered =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	g_autoptr(GVariantIter) iter = NULL;
+
+	/* get options */
+	g_variant_get(parameters, "(a{sv})", &iter);
+	while (g_variant_iter_next(iter, "{&sv}", &prop_key, &prop_value)) {
+		g_debug("got option %s", prop_key);
+		if (g_strcmp0(prop_key, "flags") == 0)
+			flags = g_variant_get_uint64(prop_value);
+		if (g_strcmp0(prop_key, "updatable-only") == 0 &&
+		    g_variant_get_boolean(prop_value) == TRUE)
+			flags |= FWUPD_DEVICE_FLAG_UPDATABLE;
+		if (g_strcmp0(prop_key, "vendor-id") == 0)
+			vendor_id = g_variant_dup_string(prop_value, NULL);
+		if (g_strcmp0(prop_key, "offset") == 0)
+			offset = g_variant_get_uint32(prop_value);
+		if (g_strcmp0(prop_key, "limit") == 0)
+			limit = g_variant_get_uint32(prop_value);
+		g_variant_unref(prop_value);
+	}
+
+	/* filter before serializing so the reply only contains what the caller wants */
+	devices = fu_engine_get_devices(engine, &error);
+	if (devices == NULL) {
+		fu_dbus_daemon_method_invocation_return_gerror(invocation, error);
+		return;
+	}
+	for (guint i = 0; i < devices->len; i++) {
+		FuDevice *device = g_ptr_array_index(devices, i);
+		if (flags != FWUPD_DEVICE_FLAG_NONE &&
+		    (fu_device_get_flags(device) & flags) != flags)
+			continue;
+		if (vendor_id != NULL &&
+		    !fwupd_device_has_vendor_id(FWUPD_DEVICE(device), vendor_id))
+			continue;
+		g_ptr_array_add(devices_filtered, g_object_ref(device));
+	}
+
+	/* paging is applied to the filtered list */
+	if (offset >= devices_filtered->len) {
+		g_ptr_array_set_size(devices_filtered, 0);
+	} else if (offset > 0) {
+		g_ptr_array_remove_range(devices_filtered, 0, offset);
+	}
+	if (limit > 0 && devices_filtered->len > limit)
+		g_ptr_array_set_size(devices_filtered, limit);
+
+	val = fu_dbus_daemon_device_array_to_variant_cached(self, request, devices_filtered);
+	g_dbus_method_invocation_return_value(invocation, val);
+}
+
+static void
+fu_dbus_daemon_method_get_inventory(FuDbusDaemon *self,
+				    GVariant *parameters,
+				    FuEngineRequest *request,
+				    GDBusMethodInvocation *invocation)
+{
+	FuEngine *engine = fu_daemon_get_engine(FU_DAEMON(self));
+	GVariant *val;
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GError) error_releases = NULL;
+	g_autoptr(GHashTable) releases_map = NULL;
+	g_autoptr(GPtrArray) devices = NULL;
+	g_autoptr(GPtrArray) devices_updatable =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	g_autoptr(GPtrArray) devices_snap =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+
+	devices = fu_engine_get_devices(engine, &error);
+	if (devices == NULL) {
+		fu_dbus_daemon_method_invocation_return_gerror(invocation, error);
+		return;
+	}
+
+	/* resolve all the release sets in one concurrent pass */
+	for (guint i = 0; i < devices->len; i++) {
+		FuDevice *device = g_ptr_array_index(devices, i);
+		if (fu_device_has_flag(device, FWUPD_DEVICE_FLAG_UPDATABLE))
+			g_ptr_array_add(devices_updatable, g_object_ref(device));
+	}
+	releases_map = fu_engine_get_releases_for_devices(engine,
+							  request,
+							  devices_updatable,
+							  &error_releases);
+	if (releases_map == NULL)
+		g_debug("no releases for any device: %s", error_releases->message);
+
+	for (guint i = 0; i < devices->len; i++) {
+		FuDevice *device = g_ptr_array_index(devices, i);
+		GPtrArray *releases = NULL;
+		g_autoptr(FwupdDevice) device_snap = fwupd_device_new();
+
+		/* snapshot so that attaching releases does not modify the engine copy */
+		fwupd_device_incorporate(device_snap, FWUPD_DEVICE(device));
+		if (releases_map != NULL)
+			releases = g_hash_table_lookup(releases_map, fu_device_get_id(device));
+		if (releases != NULL) {
+			for (guint j = 0; j < releases->len; j++) {
+				FwupdRelease *release = g_ptr_array_index(releases, j);
+				fwupd_device_add_release(device_snap, release);
+			}
+		}
+		g_ptr_array_add(devices_snap, g_steal_pointer(&device_snap));
+	}
+	val = fu_dbus_daemon_device_array_to_variant(self, request, devices_snap, &error);
 	if (val == NULL) {
 		fu_dbus_daemon_method_invocation_return_gerror(invocation, error);
 		return;
@@ -1189,6 +1629,59 @@ fu_dbus_daemon_method_get_plugins(FuDbusDaemon *self,
 	g_dbus_method_invocation_return_value(invocation, val);
 }
 
+/* the client can fetch the description on demand with GetReleaseDetails, so keep the
+ * enumeration payload small -- the releases are built fresh for each call */
+static GVariant *
+fu_dbus_daemon_release_array_to_variant(FuEngineRequest *request, GPtrArray *releases)
+{
+	if (fu_engine_request_has_feature_flag(request, FWUPD_FEATURE_FLAG_LAZY_RELEASE_DETAILS)) {
+		for (guint i = 0; i < releases->len; i++) {
+			FwupdRelease *release = g_ptr_array_index(releases, i);
+			fwupd_release_set_description(release, NULL);
+		}
+	}
+	return fwupd_codec_array_to_variant(releases, FWUPD_CODEC_FLAG_NONE);
+}
+
+static void
+fu_dbus_daemon_method_get_release_details(FuDbusDaemon *self,
+					  GVariant *parameters,
+					  FuEngineRequest *request,
+					  GDBusMethodInvocation *invocation)
+{
+	FuEngine *engine = fu_daemon_get_engine(FU_DAEMON(self));
+	const gchar *device_id;
+	const gchar *version;
+	g_autoptr(GError) error = NULL;
+	g_autoptr(GPtrArray) releases = NULL;
+
+	g_variant_get(parameters, "(&s&s)", &device_id, &version);
+	if (!fu_dbus_daemon_device_id_valid(device_id, &error)) {
+		fu_dbus_daemon_method_invocation_return_gerror(invocation, error);
+		return;
+	}
+	releases = fu_engine_get_releases(engine, request, device_id, &error);
+	if (releases == NULL) {
+		fu_dbus_daemon_method_invocation_return_gerror(invocation, error);
+		return;
+	}
+	for (guint i = 0; i < releases->len; i++) {
+		FwupdRelease *release = g_ptr_array_index(releases, i);
+		if (g_strcmp0(fwupd_release_get_version(release), version) == 0) {
+			g_dbus_method_invocation_return_value(
+			    invocation,
+			    fwupd_codec_to_variant(FWUPD_CODEC(release), FWUPD_CODEC_FLAG_NONE));
+			return;
+		}
+	}
+	g_dbus_method_invocation_return_error(invocation,
+					      FWUPD_ERROR,
+					      FWUPD_ERROR_NOT_FOUND,
+					      "no release %s for %s",
+					      version,
+					      device_id);
+}
+
 static void
 fu_dbus_daemon_method_get_releases(FuDbusDaemon *self,
 				   GVariant *parameters,
@@ -1212,7 +1705,7 @@ fu_dbus_daemon_method_get_releases(FuDbusDaemon *self,
 	}
 	g_dbus_method_invocation_return_value(
 	    invocation,
-	    fwupd_codec_array_to_variant(releases, FWUPD_CODEC_FLAG_NONE));
+	    fu_dbus_daemon_release_array_to_variant(request, releases));
 }
 
 static void
@@ -1284,6 +1777,30 @@ fu_dbus_daemon_method_get_report_metadata(FuDbusDaemon *self,
 	g_dbus_method_invocation_return_value(invocation, g_variant_new_tuple(&val, 1));
 }
 
+static void
+fu_dbus_daemon_method_get_metrics(FuDbusDaemon *self,
+				  GVariant *parameters,
+				  FuEngineRequest *request,
+				  GDBusMethodInvocation *invocation)
+{
+	FuEngine *engine = fu_daemon_get_engine(FU_DAEMON(self));
+	const gchar *key;
+	const gchar *value;
+	GHashTableIter iter;
+	GVariantBuilder builder;
+	GVariant *val;
+	g_autoptr(GHashTable) metrics = NULL;
+
+	metrics = fu_engine_get_metrics(engine);
+	g_variant_builder_init(&builder, G_VARIANT_TYPE("a{ss}"));
+	g_hash_table_iter_init(&iter, metrics);
+	while (g_hash_table_iter_next(&iter, (gpointer *)&key, (gpointer *)&value)) {
+		g_variant_builder_add_value(&builder, g_variant_new("{ss}", key, value));
+	}
+	val = g_variant_builder_end(&builder);
+	g_dbus_method_invocation_return_value(invocation, g_variant_new_tuple(&val, 1));
+}
+
 static void
 fu_dbus_daemon_method_set_approved_firmware(FuDbusDaemon *self,
 					    GVariant *parameters,
@@ -1459,7 +1976,7 @@ fu_dbus_daemon_method_get_downgrades(FuDbusDaemon *self,
 	}
 	g_dbus_method_invocation_return_value(
 	    invocation,
-	    fwupd_codec_array_to_variant(releases, FWUPD_CODEC_FLAG_NONE));
+	    fu_dbus_daemon_release_array_to_variant(request, releases));
 }
 
 static void
@@ -1485,7 +2002,7 @@ fu_dbus_daemon_method_get_upgrades(FuDbusDaemon *self,
 	}
 	g_dbus_method_invocation_return_value(
 	    invocation,
-	    fwupd_codec_array_to_variant(releases, FWUPD_CODEC_FLAG_NONE));
+	    fu_dbus_daemon_release_array_to_variant(request, releases));
 }
 
 static void
@@ -1800,7 +2317,7 @@ fu_dbus_daemon_method_get_results(FuDbusDaemon *self,
 				  GDBusMethodInvocation *invocation)
 {
 	FuEngine *engine = fu_daemon_get_engine(FU_DAEMON(self));
-	GVariant *val;
+	g_autoptr(GVariant) val = NULL;
 	g_autoptr(GError) error = NULL;
 
 	const gchar *device_id = NULL;
@@ -1815,7 +2332,8 @@ fu_dbus_daemon_method_get_results(FuDbusDaemon *self,
 		fu_dbus_daemon_method_invocation_return_gerror(invocation, error);
 		return;
 	}
-	val = fwupd_codec_to_variant(FWUPD_CODEC(result), FWUPD_CODEC_FLAG_TRUSTED);
+	val = g_variant_take_ref(
+	    fwupd_codec_to_variant(FWUPD_CODEC(result), FWUPD_CODEC_FLAG_TRUSTED));
 	g_dbus_method_invocation_return_value(invocation, g_variant_new_tuple(&val, 1));
 }
 
@@ -2172,6 +2690,8 @@ fu_dbus_daemon_method_install(FuDbusDaemon *self,
 	const gchar *device_id = NULL;
 	const gchar *prop_key;
 	gint32 fd_handle = 0;
+	gsize streamsz = 0;
+	guint64 archive_size_max;
 	g_autoptr(FuMainAuthHelper) helper = NULL;
 	g_autoptr(GError) error = NULL;
 	g_autoptr(GVariantIter) iter = NULL;
@@ -2208,6 +2728,12 @@ fu_dbus_daemon_method_install(FuDbusDaemon *self,
 		    g_variant_get_boolean(prop_value) == TRUE)
 			helper->flags |= FWUPD_INSTALL_FLAG_ALLOW_BRANCH_SWITCH;
 
+		/* fleet tools can opt into being queued behind interactive requests */
+		if (g_strcmp0(prop_key, "priority") == 0 &&
+		    g_variant_is_of_type(prop_value, G_VARIANT_TYPE_STRING) &&
+		    g_strcmp0(g_variant_get_string(prop_value, NULL), "batch") == 0)
+			helper->batch = TRUE;
+
 		g_variant_unref(prop_value);
 	}
 
@@ -2231,6 +2757,27 @@ fu_dbus_daemon_method_install(FuDbusDaemon *self,
 		return;
 	}
 
+	/* admission control: never hold more pending archive data in memory than the
+	 * configured ArchiveSizeMax budget */
+	if (!fu_input_stream_size(helper->stream, &streamsz, &error)) {
+		fu_dbus_daemon_method_invocation_return_gerror(invocation, error);
+		return;
+	}
+	helper->archive_sz = streamsz;
+	archive_size_max = fu_engine_config_get_archive_size_max(fu_engine_get_config(engine));
+	if (archive_size_max > 0 &&
+	    self->install_pending_sz + helper->archive_sz > archive_size_max) {
+		g_set_error(&error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_BUSY,
+			    "%" G_GUINT64_FORMAT " bytes of installs already queued, "
+			    "not admitting %" G_GUINT64_FORMAT " more",
+			    self->install_pending_sz,
+			    helper->archive_sz);
+		fu_dbus_daemon_method_invocation_return_gerror(invocation, error);
+		return;
+	}
+
 	/* relax these */
 	if (fu_engine_config_get_ignore_requirements(fu_engine_get_config(engine)))
 		helper->flags |= FWUPD_INSTALL_FLAG_IGNORE_REQUIREMENTS;
@@ -2479,11 +3026,15 @@ fu_dbus_daemon_method_call(GDBusConnection *connection,
 		FuDbusDaemonMethodFunc func;
 	} method_funcs[] = {
 	    {"GetDevices", fu_dbus_daemon_method_get_devices},
+	    {"GetDevicesFiltered", fu_dbus_daemon_method_get_devices_filtered},
+	    {"GetInventory", fu_dbus_daemon_method_get_inventory},
 	    {"GetPlugins", fu_dbus_daemon_method_get_plugins},
 	    {"GetReleases", fu_dbus_daemon_method_get_releases},
+	    {"GetReleaseDetails", fu_dbus_daemon_method_get_release_details},
 	    {"GetApprovedFirmware", fu_dbus_daemon_method_get_approved_firmware},
 	    {"GetBlockedFirmware", fu_dbus_daemon_method_get_blocked_firmware},
 	    {"GetReportMetadata", fu_dbus_daemon_method_get_report_metadata},
+	    {"GetMetrics", fu_dbus_daemon_method_get_metrics},
 	    {"SetApprovedFirmware", fu_dbus_daemon_method_set_approved_firmware},
 	    {"SetBlockedFirmware", fu_dbus_daemon_method_set_blocked_firmware},
 	    {"Quit", fu_dbus_daemon_method_quit},
@@ -2577,6 +3128,15 @@ fu_dbus_daemon_get_property(GDBusConnection *connection_,
 	if (g_strcmp0(property_name, "Percentage") == 0)
 		return g_variant_new_uint32(self->percentage);
 
+	if (g_strcmp0(property_name, "BytesTransferred") == 0)
+		return g_variant_new_uint64(self->bytes_transferred);
+
+	if (g_strcmp0(property_name, "TransferRate") == 0)
+		return g_variant_new_uint64(self->transfer_rate);
+
+	if (g_strcmp0(property_name, "Eta") == 0)
+		return g_variant_new_uint32(self->eta);
+
 	if (g_strcmp0(property_name, FWUPD_RESULT_KEY_BATTERY_LEVEL) == 0) {
 		FuContext *ctx = fu_engine_get_context(engine);
 		return g_variant_new_uint32(fu_context_get_battery_level(ctx));
@@ -2627,6 +3187,9 @@ fu_dbus_daemon_get_property(GDBusConnection *connection_,
 		    fu_engine_config_get_only_trusted(fu_engine_get_config(engine)));
 	}
 
+	if (g_strcmp0(property_name, "PluginTimings") == 0)
+		return fu_engine_get_plugin_timings(engine);
+
 	/* return an error */
 	g_set_error(error,
 		    G_DBUS_ERROR,
@@ -2701,6 +3264,10 @@ fu_dbus_daemon_set_connection(FuDbusDaemon *self, GDBusConnection *connection)
 	g_set_object(&self->connection, connection);
 	if (connection != NULL) {
 		g_autoptr(FuClientList) client_list = fu_client_list_new(connection);
+		g_dbus_connection_add_filter(connection,
+					     fu_dbus_daemon_message_filter_cb,
+					     self,
+					     NULL);
 		g_signal_connect(client_list,
 				 "added",
 				 G_CALLBACK(fu_dbus_daemon_client_list_added_cb),
@@ -2799,6 +3366,18 @@ fu_dbus_daemon_load_introspection(const gchar *filename, GError **error)
 	return g_dbus_node_info_new_for_xml(g_bytes_get_data(data, NULL), error);
 }
 
+static void
+fu_dbus_daemon_setup_percentage_changed_cb(FuProgress *progress,
+					   guint percentage,
+					   FuDbusDaemon *self)
+{
+	/* the name is owned before the engine has loaded, so answer any queued client calls
+	 * with the devices enumerated so far rather than blocking them on full coldplug */
+	while (g_main_context_iteration(NULL, FALSE))
+		;
+	fu_dbus_daemon_progress_percentage_changed_cb(progress, percentage, self);
+}
+
 static gboolean
 fu_dbus_daemon_setup(FuDaemon *daemon,
 		     const gchar *socket_address,
@@ -2810,49 +3389,13 @@ fu_dbus_daemon_setup(FuDaemon *daemon,
 
 	/* progress */
 	fu_progress_set_id(progress, G_STRLOC);
-	fu_progress_set_profile(progress, g_getenv("FWUPD_VERBOSE") != NULL);
-	fu_progress_add_step(progress, FWUPD_STATUS_LOADING, 99, "load-engine");
+	fu_progress_set_profile(progress,
+				g_getenv("FWUPD_VERBOSE") != NULL ||
+				    g_getenv("FWUPD_PROFILE_TRACE") != NULL);
 	fu_progress_add_step(progress, FWUPD_STATUS_LOADING, 1, "load-introspection");
 	fu_progress_add_step(progress, FWUPD_STATUS_LOADING, 1, "load-authority");
 	fu_progress_add_step(progress, FWUPD_STATUS_LOADING, 1, "own-name");
-
-	/* load engine */
-	g_signal_connect(FU_ENGINE(engine),
-			 "changed",
-			 G_CALLBACK(fu_dbus_daemon_engine_changed_cb),
-			 self);
-	g_signal_connect(FU_ENGINE(engine),
-			 "device-added",
-			 G_CALLBACK(fu_dbus_daemon_engine_device_added_cb),
-			 self);
-	g_signal_connect(FU_ENGINE(engine),
-			 "device-removed",
-			 G_CALLBACK(fu_dbus_daemon_engine_device_removed_cb),
-			 self);
-	g_signal_connect(FU_ENGINE(engine),
-			 "device-changed",
-			 G_CALLBACK(fu_dbus_daemon_engine_device_changed_cb),
-			 self);
-	g_signal_connect(FU_ENGINE(engine),
-			 "device-request",
-			 G_CALLBACK(fu_dbus_daemon_engine_device_request_cb),
-			 self);
-	g_signal_connect(FU_ENGINE(engine),
-			 "status-changed",
-			 G_CALLBACK(fu_dbus_daemon_engine_status_changed_cb),
-			 self);
-	if (!fu_engine_load(engine,
-			    FU_ENGINE_LOAD_FLAG_COLDPLUG | FU_ENGINE_LOAD_FLAG_HWINFO |
-				FU_ENGINE_LOAD_FLAG_REMOTES | FU_ENGINE_LOAD_FLAG_EXTERNAL_PLUGINS |
-				FU_ENGINE_LOAD_FLAG_BUILTIN_PLUGINS |
-				FU_ENGINE_LOAD_FLAG_ENSURE_CLIENT_CERT |
-				FU_ENGINE_LOAD_FLAG_DEVICE_HOTPLUG,
-			    fu_progress_get_child(progress),
-			    error)) {
-		g_prefix_error(error, "failed to load engine: ");
-		return FALSE;
-	}
-	fu_progress_step_done(progress);
+	fu_progress_add_step(progress, FWUPD_STATUS_LOADING, 97, "load-engine");
 
 	/* load introspection from file */
 	self->introspection_daemon =
@@ -2869,7 +3412,8 @@ fu_dbus_daemon_setup(FuDaemon *daemon,
 		return FALSE;
 	fu_progress_step_done(progress);
 
-	/* own the object */
+	/* own the object before loading the engine so that boot-time clients are answered
+	 * incrementally, with DeviceAdded emitted as the remaining devices arrive */
 	if (socket_address != NULL) {
 		g_autofree gchar *guid = g_dbus_generate_guid();
 		g_autoptr(GDBusServer) server = NULL;
@@ -2903,6 +3447,57 @@ fu_dbus_daemon_setup(FuDaemon *daemon,
 	}
 	fu_progress_step_done(progress);
 
+	/* dispatch queued calls between coldplug phases */
+	g_signal_connect(FU_PROGRESS(progress),
+			 "percentage-changed",
+			 G_CALLBACK(fu_dbus_daemon_setup_percentage_changed_cb),
+			 self);
+
+	/* load engine */
+	g_signal_connect(FU_ENGINE(engine),
+			 "changed",
+			 G_CALLBACK(fu_dbus_daemon_engine_changed_cb),
+			 self);
+	g_signal_connect(FU_ENGINE(engine),
+			 "device-added",
+			 G_CALLBACK(fu_dbus_daemon_engine_device_added_cb),
+			 self);
+	g_signal_connect(FU_ENGINE(engine),
+			 "device-removed",
+			 G_CALLBACK(fu_dbus_daemon_engine_device_removed_cb),
+			 self);
+	g_signal_connect(FU_ENGINE(engine),
+			 "device-changed",
+			 G_CALLBACK(fu_dbus_daemon_engine_device_changed_cb),
+			 self);
+	g_signal_connect(FU_ENGINE(engine),
+			 "device-request",
+			 G_CALLBACK(fu_dbus_daemon_engine_device_request_cb),
+			 self);
+	g_signal_connect(FU_ENGINE(engine),
+			 "status-changed",
+			 G_CALLBACK(fu_dbus_daemon_engine_status_changed_cb),
+			 self);
+	if (!fu_engine_load(engine,
+			    FU_ENGINE_LOAD_FLAG_COLDPLUG | FU_ENGINE_LOAD_FLAG_HWINFO |
+				FU_ENGINE_LOAD_FLAG_REMOTES | FU_ENGINE_LOAD_FLAG_EXTERNAL_PLUGINS |
+				FU_ENGINE_LOAD_FLAG_BUILTIN_PLUGINS |
+				FU_ENGINE_LOAD_FLAG_ENSURE_CLIENT_CERT |
+				FU_ENGINE_LOAD_FLAG_DEVICE_HOTPLUG,
+			    fu_progress_get_child(progress),
+			    error)) {
+		g_prefix_error(error, "failed to load engine: ");
+		return FALSE;
+	}
+	fu_progress_step_done(progress);
+
+	/* seed the read-only snapshot even if no device events arrive */
+	fu_dbus_daemon_snapshot_invalidate(self);
+
+	/* answer anything that arrived during the last coldplug phase */
+	while (g_main_context_iteration(NULL, FALSE))
+		;
+
 	/* success */
 	return TRUE;
 }
@@ -2911,8 +3506,22 @@ static void
 fu_dbus_daemon_init(FuDbusDaemon *self)
 {
 	self->status = FWUPD_STATUS_IDLE;
+	g_mutex_init(&self->snapshot_mutex);
+	g_mutex_init(&self->device_variant_mutex);
 	self->system_inhibits =
 	    g_ptr_array_new_with_free_func((GDestroyNotify)fu_dbus_daemon_system_inhibit_free);
+	self->install_pending =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)fu_dbus_daemon_auth_helper_free);
+	self->device_changed_last =
+	    g_hash_table_new_full(g_str_hash,
+				  g_str_equal,
+				  g_free,
+				  (GDestroyNotify)g_variant_unref);
+	self->device_variant_trusted =
+	    g_hash_table_new_full(g_str_hash,
+				  g_str_equal,
+				  g_free,
+				  (GDestroyNotify)g_variant_unref);
 }
 
 static void
@@ -2921,6 +3530,17 @@ fu_dbus_daemon_finalize(GObject *obj)
 	FuDbusDaemon *self = FU_DBUS_DAEMON(obj);
 
 	g_ptr_array_unref(self->system_inhibits);
+	g_ptr_array_unref(self->install_pending);
+	g_hash_table_unref(self->device_changed_last);
+	g_hash_table_unref(self->device_variant_trusted);
+	if (self->snapshot_rebuild_id != 0)
+		g_source_remove(self->snapshot_rebuild_id);
+	if (self->snapshot_devices != NULL)
+		g_variant_unref(self->snapshot_devices);
+	if (self->snapshot_plugins != NULL)
+		g_variant_unref(self->snapshot_plugins);
+	g_mutex_clear(&self->snapshot_mutex);
+	g_mutex_clear(&self->device_variant_mutex);
 	if (self->client_list != NULL)
 		g_object_unref(self->client_list);
 	if (self->owner_id > 0)
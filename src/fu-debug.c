@@ -20,6 +20,15 @@
 #include <windows.h>
 #endif
 
+#define FU_DEBUG_RING_SIZE 256
+
+typedef struct {
+	gint64 ts_utc;
+	GLogLevelFlags log_level;
+	gchar *domain;
+	gchar *message;
+} FuDebugRingRecord;
+
 typedef struct {
 	GOptionGroup *group;
 	GLogLevelFlags log_level;
@@ -27,6 +36,9 @@ typedef struct {
 	gboolean no_timestamp;
 	gboolean no_domain;
 	gchar **daemon_verbose;
+	FuDebugRingRecord ring[FU_DEBUG_RING_SIZE];
+	guint ring_idx;
+	GMutex ring_mutex;
 #ifdef _WIN32
 	HANDLE event_source;
 #endif
@@ -56,12 +68,74 @@ fu_debug_free(FuDebug *self)
 	g_option_group_set_parse_hooks(self->group, NULL, NULL);
 	g_option_group_unref(self->group);
 	g_strfreev(self->daemon_verbose);
+	for (guint i = 0; i < FU_DEBUG_RING_SIZE; i++) {
+		g_free(self->ring[i].domain);
+		g_free(self->ring[i].message);
+	}
+	g_mutex_clear(&self->ring_mutex);
 #ifdef _WIN32
 	DeregisterEventSource(self->event_source);
 #endif
 	g_free(self);
 }
 
+/* keep suppressed messages in a fixed-size flight recorder; no I/O on this path */
+static void
+fu_debug_ring_add(FuDebug *self,
+		  const gchar *log_domain,
+		  GLogLevelFlags log_level,
+		  const gchar *message)
+{
+	FuDebugRingRecord *rec;
+	g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->ring_mutex);
+
+	rec = &self->ring[self->ring_idx % FU_DEBUG_RING_SIZE];
+	g_free(rec->domain);
+	g_free(rec->message);
+	rec->ts_utc = g_get_real_time();
+	rec->log_level = log_level & G_LOG_LEVEL_MASK;
+	rec->domain = g_strdup(log_domain);
+	rec->message = g_strdup(message);
+	self->ring_idx++;
+}
+
+static void
+fu_debug_ring_dump(FuDebug *self)
+{
+	guint cnt;
+	g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->ring_mutex);
+
+	/* nothing suppressed since the last problem */
+	cnt = MIN(self->ring_idx, FU_DEBUG_RING_SIZE);
+	if (cnt == 0)
+		return;
+	g_printerr("-- flight recorder: replaying %u suppressed messages --\n", cnt);
+	for (guint i = 0; i < cnt; i++) {
+		FuDebugRingRecord *rec = &self->ring[(self->ring_idx - cnt + i) % FU_DEBUG_RING_SIZE];
+		const gchar *log_level_str = fu_debug_log_level_to_string(rec->log_level);
+		g_autofree gchar *message_safe = fu_strpassmask(rec->message);
+		g_autoptr(GDateTime) dt = g_date_time_new_from_unix_utc(rec->ts_utc / G_USEC_PER_SEC);
+		g_printerr("%02i:%02i:%02i.%03i %s %s %s\n",
+			   g_date_time_get_hour(dt),
+			   g_date_time_get_minute(dt),
+			   g_date_time_get_second(dt),
+			   (gint)((rec->ts_utc % G_USEC_PER_SEC) / 1000),
+			   log_level_str != NULL ? log_level_str : "unknown",
+			   rec->domain != NULL ? rec->domain : "FIXME",
+			   message_safe);
+	}
+	g_printerr("-- flight recorder end --\n");
+
+	/* only replay each message once */
+	for (guint i = 0; i < FU_DEBUG_RING_SIZE; i++) {
+		g_free(self->ring[i].domain);
+		g_free(self->ring[i].message);
+		self->ring[i].domain = NULL;
+		self->ring[i].message = NULL;
+	}
+	self->ring_idx = 0;
+}
+
 static gboolean
 fu_debug_filter_cb(FuDebug *self, const gchar *log_domain, GLogLevelFlags log_level)
 {
@@ -129,9 +203,15 @@ fu_debug_handler_cb(const gchar *log_domain,
 	g_autofree gchar *message_safe = NULL;
 	g_autoptr(GString) domain = NULL;
 
-	/* should ignore */
-	if (!fu_debug_filter_cb(self, log_domain, log_level))
+	/* should ignore; keep it in the flight recorder in case something goes wrong later */
+	if (!fu_debug_filter_cb(self, log_domain, log_level)) {
+		fu_debug_ring_add(self, log_domain, log_level, message);
 		return;
+	}
+
+	/* replay the suppressed messages leading up to the problem */
+	if ((log_level & (G_LOG_LEVEL_ERROR | G_LOG_LEVEL_CRITICAL | G_LOG_LEVEL_WARNING)) != 0)
+		fu_debug_ring_dump(self);
 
 	/* make sure passwords never appear in logs */
 	message_safe = fu_strpassmask(message);
@@ -340,6 +420,7 @@ fu_debug_get_option_group(void)
 {
 	FuDebug *self = g_new0(FuDebug, 1);
 	self->log_level = G_LOG_LEVEL_MESSAGE;
+	g_mutex_init(&self->ring_mutex);
 	self->group = g_option_group_new("debug",
 					 /* TRANSLATORS: for the --verbose arg */
 					 _("Debugging Options"),
@@ -32,7 +32,9 @@ fu_device_list_finalize(GObject *obj);
 
 struct _FuDeviceList {
 	GObject parent_instance;
-	GPtrArray *devices; /* of FuDeviceItem */
+	GPtrArray *devices;	   /* of FuDeviceItem */
+	GHashTable *items_by_id;   /* (element-type utf8 GPtrArray) */
+	GHashTable *items_by_guid; /* (element-type utf8 GPtrArray) */
 	GRWLock devices_mutex;
 };
 
@@ -45,6 +47,8 @@ typedef struct {
 	FuDevice *device_old;
 	FuDeviceList *self; /* no ref */
 	guint remove_id;
+	GPtrArray *index_ids;	/* (nullable) (element-type utf8) */
+	GPtrArray *index_guids; /* (nullable) (element-type utf8) */
 } FuDeviceItem;
 
 static void
@@ -77,6 +81,92 @@ fu_device_list_emit_device_changed(FuDeviceList *self, FuDevice *device)
 	g_signal_emit(self, signals[SIGNAL_CHANGED], 0, device);
 }
 
+static void
+fu_device_list_index_bucket_add(GHashTable *index,
+				const gchar *key,
+				FuDeviceItem *item,
+				GPtrArray *keys)
+{
+	GPtrArray *items = g_hash_table_lookup(index, key);
+	if (items == NULL) {
+		items = g_ptr_array_new();
+		g_hash_table_insert(index, g_strdup(key), items);
+	}
+	g_ptr_array_add(items, item);
+	g_ptr_array_add(keys, g_strdup(key));
+}
+
+static void
+fu_device_list_index_bucket_remove(GHashTable *index, const gchar *key, FuDeviceItem *item)
+{
+	GPtrArray *items = g_hash_table_lookup(index, key);
+	if (items == NULL)
+		return;
+	g_ptr_array_remove(items, item);
+	if (items->len == 0)
+		g_hash_table_remove(index, key);
+}
+
+/* add the item to the ID and GUID indexes, remembering the keys used so the
+ * item can be removed even if the device gains GUIDs later -- the writer lock
+ * must be held by the caller */
+static void
+fu_device_list_item_index_add(FuDeviceList *self, FuDeviceItem *item)
+{
+	GPtrArray *guids = fu_device_get_guids(item->device);
+
+	item->index_ids = g_ptr_array_new_with_free_func(g_free);
+	item->index_guids = g_ptr_array_new_with_free_func(g_free);
+	if (fu_device_get_id(item->device) != NULL) {
+		fu_device_list_index_bucket_add(self->items_by_id,
+						fu_device_get_id(item->device),
+						item,
+						item->index_ids);
+	}
+	if (fu_device_get_equivalent_id(item->device) != NULL) {
+		fu_device_list_index_bucket_add(self->items_by_id,
+						fu_device_get_equivalent_id(item->device),
+						item,
+						item->index_ids);
+	}
+	for (guint i = 0; i < guids->len; i++) {
+		fu_device_list_index_bucket_add(self->items_by_guid,
+						g_ptr_array_index(guids, i),
+						item,
+						item->index_guids);
+	}
+}
+
+/* the writer lock must be held by the caller */
+static void
+fu_device_list_item_index_remove(FuDeviceList *self, FuDeviceItem *item)
+{
+	if (item->index_ids != NULL) {
+		for (guint i = 0; i < item->index_ids->len; i++) {
+			const gchar *key = g_ptr_array_index(item->index_ids, i);
+			fu_device_list_index_bucket_remove(self->items_by_id, key, item);
+		}
+		g_clear_pointer(&item->index_ids, g_ptr_array_unref);
+	}
+	if (item->index_guids != NULL) {
+		for (guint i = 0; i < item->index_guids->len; i++) {
+			const gchar *key = g_ptr_array_index(item->index_guids, i);
+			fu_device_list_index_bucket_remove(self->items_by_guid, key, item);
+		}
+		g_clear_pointer(&item->index_guids, g_ptr_array_unref);
+	}
+}
+
+/* update both indexes after item->device has been swapped out */
+static void
+fu_device_list_item_reindex(FuDeviceList *self, FuDeviceItem *item)
+{
+	g_rw_lock_writer_lock(&self->devices_mutex);
+	fu_device_list_item_index_remove(self, item);
+	fu_device_list_item_index_add(self, item);
+	g_rw_lock_writer_unlock(&self->devices_mutex);
+}
+
 static void
 fu_device_list_add_string(FwupdCodec *codec, guint idt, GString *str)
 {
@@ -254,8 +344,21 @@ fu_device_list_find_by_device(FuDeviceList *self, FuDevice *device)
 static FuDeviceItem *
 fu_device_list_find_by_guid(FuDeviceList *self, const gchar *guid)
 {
+	GPtrArray *items_fast;
 	g_autoptr(GRWLockReaderLocker) locker = g_rw_lock_reader_locker_new(&self->devices_mutex);
 	g_return_val_if_fail(locker != NULL, NULL);
+
+	/* fast path: the GUID was known when the item was indexed */
+	items_fast = g_hash_table_lookup(self->items_by_guid, guid);
+	if (items_fast != NULL) {
+		for (guint i = 0; i < items_fast->len; i++) {
+			FuDeviceItem *item = g_ptr_array_index(items_fast, i);
+			if (fu_device_has_guid(item->device, guid))
+				return item;
+		}
+	}
+
+	/* slow path: GUIDs can be added after the device was indexed */
 	for (guint i = 0; i < self->devices->len; i++) {
 		FuDeviceItem *item = g_ptr_array_index(self->devices, i);
 		if (fu_device_has_guid(item->device, guid))
@@ -316,10 +419,24 @@ static GPtrArray *
 fu_device_list_filter_by_id(FuDeviceList *self, const gchar *device_id, GError **error)
 {
 	gsize device_id_len;
+	GPtrArray *items_fast;
 	g_autoptr(GPtrArray) items = g_ptr_array_new();
 
 	g_return_val_if_fail(device_id != NULL, NULL);
 
+	/* fast path: exact matches on the ID or equivalent ID come from the index */
+	g_rw_lock_reader_lock(&self->devices_mutex);
+	items_fast = g_hash_table_lookup(self->items_by_id, device_id);
+	if (items_fast != NULL) {
+		for (guint i = 0; i < items_fast->len; i++)
+			g_ptr_array_add(items, g_ptr_array_index(items_fast, i));
+	}
+	g_rw_lock_reader_unlock(&self->devices_mutex);
+	if (items->len > 0) {
+		g_ptr_array_sort(items, fu_device_list_item_sort_by_priority_cb);
+		return g_steal_pointer(&items);
+	}
+
 	/* support abbreviated hashes */
 	device_id_len = strlen(device_id);
 	g_rw_lock_reader_lock(&self->devices_mutex);
@@ -773,6 +890,7 @@ fu_device_list_replace(FuDeviceList *self, FuDeviceItem *item, FuDevice *device)
 	/* assign the new device */
 	fu_device_list_item_set_device_old(item, item->device);
 	fu_device_list_item_set_device(item, device);
+	fu_device_list_item_reindex(self, item);
 	fu_device_list_emit_device_changed(self, device);
 
 	/* debug */
@@ -836,6 +954,7 @@ fu_device_list_add(FuDeviceList *self, FuDevice *device)
 						  FU_DEVICE_INCORPORATE_FLAG_UPDATE_ERROR);
 			g_set_object(&item->device_old, item->device);
 			fu_device_list_item_set_device(item, device);
+			fu_device_list_item_reindex(self, item);
 			fu_device_list_clear_wait_for_replug(self, item);
 			fu_device_list_emit_device_changed(self, device);
 			return;
@@ -907,6 +1026,7 @@ fu_device_list_add(FuDeviceList *self, FuDevice *device)
 	fu_device_list_item_set_device(item, device);
 	g_rw_lock_writer_lock(&self->devices_mutex);
 	g_ptr_array_add(self->devices, item);
+	fu_device_list_item_index_add(self, item);
 	g_rw_lock_writer_unlock(&self->devices_mutex);
 	fu_device_list_emit_device_added(self, device);
 }
@@ -1073,6 +1193,7 @@ fu_device_list_get_by_id(FuDeviceList *self, const gchar *device_id, GError **er
 static void
 fu_device_list_item_free(FuDeviceItem *item)
 {
+	fu_device_list_item_index_remove(item->self, item);
 	if (item->remove_id != 0)
 		g_source_remove(item->remove_id);
 	if (item->device_old != NULL)
@@ -1162,6 +1283,14 @@ static void
 fu_device_list_init(FuDeviceList *self)
 {
 	self->devices = g_ptr_array_new_with_free_func((GDestroyNotify)fu_device_list_item_free);
+	self->items_by_id = g_hash_table_new_full(g_str_hash,
+						  g_str_equal,
+						  g_free,
+						  (GDestroyNotify)g_ptr_array_unref);
+	self->items_by_guid = g_hash_table_new_full(g_str_hash,
+						    g_str_equal,
+						    g_free,
+						    (GDestroyNotify)g_ptr_array_unref);
 	g_rw_lock_init(&self->devices_mutex);
 }
 
@@ -1172,6 +1301,8 @@ fu_device_list_finalize(GObject *obj)
 
 	g_rw_lock_clear(&self->devices_mutex);
 	g_ptr_array_unref(self->devices);
+	g_hash_table_unref(self->items_by_id);
+	g_hash_table_unref(self->items_by_guid);
 
 	G_OBJECT_CLASS(fu_device_list_parent_class)->finalize(obj);
 }
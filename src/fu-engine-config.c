@@ -23,6 +23,23 @@ struct _FuEngineConfig {
 	GArray *trusted_uids;	      /* (element-type guint64) */
 	gchar *host_bkc;
 	gchar *esp_location;
+	guint64 archive_size_max;
+	guint64 request_size_max;
+	guint64 verify_scrub_interval;
+	guint idle_timeout;
+	guint idle_trim_timeout;
+	FuReleasePriority release_priority;
+	FuP2pPolicy p2p_policy;
+	gboolean update_motd;
+	gboolean enumerate_all_devices;
+	gboolean ignore_power;
+	gboolean only_trusted;
+	gboolean show_device_private;
+	gboolean test_devices;
+	gboolean lazy_plugins;
+	gboolean parallel_installs;
+	gboolean ignore_requirements;
+	gboolean release_dedupe;
 };
 
 G_DEFINE_TYPE(FuEngineConfig, fu_engine_config, FU_TYPE_CONFIG)
@@ -121,6 +138,9 @@ fu_engine_config_reload(FuEngineConfig *self)
 	g_autofree gchar *domains = NULL;
 	g_autofree gchar *host_bkc = NULL;
 	g_autofree gchar *esp_location = NULL;
+	g_autofree gchar *release_priority = NULL;
+	g_autofree gchar *p2p_policy = NULL;
+	g_auto(GStrv) p2p_policy_split = NULL;
 
 	/* get disabled devices */
 	g_ptr_array_set_size(self->disabled_devices, 0);
@@ -173,15 +193,48 @@ fu_engine_config_reload(FuEngineConfig *self)
 		(void)g_setenv("FWUPD_VERBOSE", domains, FALSE);
 
 	/* fetch host best known configuration */
+	g_clear_pointer(&self->host_bkc, g_free);
 	host_bkc = fu_config_get_value(FU_CONFIG(self), "fwupd", "HostBkc");
 	if (host_bkc != NULL && host_bkc[0] != '\0')
 		self->host_bkc = g_steal_pointer(&host_bkc);
 
 	/* fetch hardcoded ESP mountpoint */
+	g_clear_pointer(&self->esp_location, g_free);
 	esp_location = fu_config_get_value(FU_CONFIG(self), "fwupd", "EspLocation");
 	if (esp_location != NULL && esp_location[0] != '\0')
 		self->esp_location = g_steal_pointer(&esp_location);
 
+	/* cache all the scalar keys in one pass so the getters used in per-request
+	 * paths are just struct field reads */
+	self->archive_size_max = fu_config_get_value_u64(FU_CONFIG(self), "fwupd", "ArchiveSizeMax");
+	self->request_size_max = fu_config_get_value_u64(FU_CONFIG(self), "fwupd", "RequestSizeMax");
+	self->verify_scrub_interval =
+	    fu_config_get_value_u64(FU_CONFIG(self), "fwupd", "VerifyScrubInterval");
+	self->idle_timeout = fu_config_get_value_u64(FU_CONFIG(self), "fwupd", "IdleTimeout");
+	self->idle_trim_timeout =
+	    fu_config_get_value_u64(FU_CONFIG(self), "fwupd", "IdleTrimTimeout");
+	self->update_motd = fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "UpdateMotd");
+	self->enumerate_all_devices =
+	    fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "EnumerateAllDevices");
+	self->ignore_power = fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "IgnorePower");
+	self->only_trusted = fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "OnlyTrusted");
+	self->show_device_private =
+	    fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "ShowDevicePrivate");
+	self->test_devices = fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "TestDevices");
+	self->lazy_plugins = fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "LazyPlugins");
+	self->parallel_installs =
+	    fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "ParallelInstalls");
+	self->ignore_requirements =
+	    fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "IgnoreRequirements");
+	self->release_dedupe = fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "ReleaseDedupe");
+	release_priority = fu_config_get_value(FU_CONFIG(self), "fwupd", "ReleasePriority");
+	self->release_priority = fu_release_priority_from_string(release_priority);
+	self->p2p_policy = FU_P2P_POLICY_NOTHING;
+	p2p_policy = fu_config_get_value(FU_CONFIG(self), "fwupd", "P2pPolicy");
+	p2p_policy_split = g_strsplit(p2p_policy, ",", -1);
+	for (guint i = 0; p2p_policy_split[i] != NULL; i++)
+		self->p2p_policy |= fu_p2p_policy_from_string(p2p_policy_split[i]);
+
 	/* get trusted uids */
 	g_array_set_size(self->trusted_uids, 0);
 	uids = fu_config_get_value_strv(FU_CONFIG(self), "fwupd", "TrustedUids");
@@ -233,7 +286,22 @@ fu_engine_config_changed_cb(FuEngineConfig *config, gpointer user_data)
 guint
 fu_engine_config_get_idle_timeout(FuEngineConfig *self)
 {
-	return fu_config_get_value_u64(FU_CONFIG(self), "fwupd", "IdleTimeout");
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), 0);
+	return self->idle_timeout;
+}
+
+guint
+fu_engine_config_get_idle_trim_timeout(FuEngineConfig *self)
+{
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), 0);
+	return self->idle_trim_timeout;
+}
+
+guint64
+fu_engine_config_get_verify_scrub_interval(FuEngineConfig *self)
+{
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), 0);
+	return self->verify_scrub_interval;
 }
 
 GPtrArray *
@@ -276,7 +344,15 @@ fu_engine_config_get_uri_scheme_prio(FuEngineConfig *self, const gchar *scheme)
 guint64
 fu_engine_config_get_archive_size_max(FuEngineConfig *self)
 {
-	return fu_config_get_value_u64(FU_CONFIG(self), "fwupd", "ArchiveSizeMax");
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), 0);
+	return self->archive_size_max;
+}
+
+guint64
+fu_engine_config_get_request_size_max(FuEngineConfig *self)
+{
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), 0);
+	return self->request_size_max;
 }
 
 GPtrArray *
@@ -296,67 +372,85 @@ fu_engine_config_get_approved_firmware(FuEngineConfig *self)
 gboolean
 fu_engine_config_get_update_motd(FuEngineConfig *self)
 {
-	return fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "UpdateMotd");
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), FALSE);
+	return self->update_motd;
 }
 
 gboolean
 fu_engine_config_get_ignore_power(FuEngineConfig *self)
 {
-	return fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "IgnorePower");
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), FALSE);
+	return self->ignore_power;
 }
 
 gboolean
 fu_engine_config_get_only_trusted(FuEngineConfig *self)
 {
-	return fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "OnlyTrusted");
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), FALSE);
+	return self->only_trusted;
 }
 
 gboolean
 fu_engine_config_get_show_device_private(FuEngineConfig *self)
 {
-	return fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "ShowDevicePrivate");
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), FALSE);
+	return self->show_device_private;
 }
 
 gboolean
 fu_engine_config_get_test_devices(FuEngineConfig *self)
 {
-	return fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "TestDevices");
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), FALSE);
+	return self->test_devices;
+}
+
+gboolean
+fu_engine_config_get_lazy_plugins(FuEngineConfig *self)
+{
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), FALSE);
+	return self->lazy_plugins;
+}
+
+gboolean
+fu_engine_config_get_parallel_installs(FuEngineConfig *self)
+{
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), FALSE);
+	return self->parallel_installs;
 }
 
 gboolean
 fu_engine_config_get_ignore_requirements(FuEngineConfig *self)
 {
-	return fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "IgnoreRequirements");
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), FALSE);
+	return self->ignore_requirements;
 }
 
 gboolean
 fu_engine_config_get_release_dedupe(FuEngineConfig *self)
 {
-	return fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "ReleaseDedupe");
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), FALSE);
+	return self->release_dedupe;
 }
 
 FuReleasePriority
 fu_engine_config_get_release_priority(FuEngineConfig *self)
 {
-	g_autofree gchar *tmp = fu_config_get_value(FU_CONFIG(self), "fwupd", "ReleasePriority");
-	return fu_release_priority_from_string(tmp);
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), FU_RELEASE_PRIORITY_NONE);
+	return self->release_priority;
 }
 
 FuP2pPolicy
 fu_engine_config_get_p2p_policy(FuEngineConfig *self)
 {
-	FuP2pPolicy p2p_policy = FU_P2P_POLICY_NOTHING;
-	g_autofree gchar *tmp = fu_config_get_value(FU_CONFIG(self), "fwupd", "P2pPolicy");
-	g_auto(GStrv) split = g_strsplit(tmp, ",", -1);
-	for (guint i = 0; split[i] != NULL; i++)
-		p2p_policy |= fu_p2p_policy_from_string(split[i]);
-	return p2p_policy;
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), FU_P2P_POLICY_NOTHING);
+	return self->p2p_policy;
 }
 
 gboolean
 fu_engine_config_get_enumerate_all_devices(FuEngineConfig *self)
 {
-	return fu_config_get_value_bool(FU_CONFIG(self), "fwupd", "EnumerateAllDevices");
+	g_return_val_if_fail(FU_IS_ENGINE_CONFIG(self), FALSE);
+	return self->enumerate_all_devices;
 }
 
 const gchar *
@@ -413,11 +507,15 @@ fu_engine_config_init(FuEngineConfig *self)
 	fu_engine_config_set_default(self, "HostBkc", NULL);
 	fu_engine_config_set_default(self, "IdleTimeout", "300");		  /* s */
 	fu_engine_config_set_default(self, "IdleInhibitStartupThreshold", "500"); /* ms */
+	fu_engine_config_set_default(self, "IdleTrimTimeout", "900");		  /* s */
 	fu_engine_config_set_default(self, "IgnorePower", "false");
 	fu_engine_config_set_default(self, "IgnoreRequirements", "false");
+	fu_engine_config_set_default(self, "LazyPlugins", "false");
 	fu_engine_config_set_default(self, "OnlyTrusted", "true");
 	fu_engine_config_set_default(self, "P2pPolicy", FU_DEFAULT_P2P_POLICY);
+	fu_engine_config_set_default(self, "ParallelInstalls", "false");
 	fu_engine_config_set_default(self, "ReleaseDedupe", "true");
+	fu_engine_config_set_default(self, "RequestSizeMax", archive_size_max_default);
 	fu_engine_config_set_default(self, "ReleasePriority", "local");
 	fu_engine_config_set_default(self, "ShowDevicePrivate", "true");
 	fu_engine_config_set_default(self, "TestDevices", "false");
@@ -426,6 +524,10 @@ fu_engine_config_init(FuEngineConfig *self)
 	fu_engine_config_set_default(self, "UpdateMotd", "true");
 	fu_engine_config_set_default(self, "UriSchemes", "file;https;http;ipfs");
 	fu_engine_config_set_default(self, "VerboseDomains", NULL);
+	fu_engine_config_set_default(self, "VerifyScrubInterval", "0"); /* s */
+
+	/* seed the cached values from the defaults in case a getter is used before load */
+	fu_engine_config_reload(self);
 }
 
 static void
@@ -17,8 +17,14 @@ FuEngineConfig *
 fu_engine_config_new(void);
 guint64
 fu_engine_config_get_archive_size_max(FuEngineConfig *self) G_GNUC_NON_NULL(1);
+guint64
+fu_engine_config_get_request_size_max(FuEngineConfig *self) G_GNUC_NON_NULL(1);
 guint
 fu_engine_config_get_idle_timeout(FuEngineConfig *self) G_GNUC_NON_NULL(1);
+guint
+fu_engine_config_get_idle_trim_timeout(FuEngineConfig *self) G_GNUC_NON_NULL(1);
+guint64
+fu_engine_config_get_verify_scrub_interval(FuEngineConfig *self) G_GNUC_NON_NULL(1);
 GPtrArray *
 fu_engine_config_get_disabled_devices(FuEngineConfig *self) G_GNUC_NON_NULL(1);
 GPtrArray *
@@ -47,6 +53,10 @@ fu_engine_config_get_show_device_private(FuEngineConfig *self) G_GNUC_NON_NULL(1
 gboolean
 fu_engine_config_get_test_devices(FuEngineConfig *self) G_GNUC_NON_NULL(1);
 gboolean
+fu_engine_config_get_lazy_plugins(FuEngineConfig *self) G_GNUC_NON_NULL(1);
+gboolean
+fu_engine_config_get_parallel_installs(FuEngineConfig *self) G_GNUC_NON_NULL(1);
+gboolean
 fu_engine_config_get_ignore_requirements(FuEngineConfig *self) G_GNUC_NON_NULL(1);
 gboolean
 fu_engine_config_get_release_dedupe(FuEngineConfig *self) G_GNUC_NON_NULL(1);
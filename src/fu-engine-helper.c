@@ -155,11 +155,9 @@ fu_engine_update_motd(FuEngine *self, GError **error)
 gboolean
 fu_engine_update_devices_file(FuEngine *self, GError **error)
 {
-	FwupdCodecFlags flags = FWUPD_CODEC_FLAG_NONE;
-	gsize len;
-	g_autoptr(JsonBuilder) builder = NULL;
-	g_autoptr(JsonGenerator) generator = NULL;
-	g_autoptr(JsonNode) root = NULL;
+	/* this file is only ever read back by machines, so skip the pretty-printing
+	 * generator -- this gets rewritten on every device change */
+	FwupdCodecFlags flags = FWUPD_CODEC_FLAG_COMPACT;
 	g_autoptr(GPtrArray) devices = NULL;
 	g_autofree gchar *data = NULL;
 	g_autofree gchar *directory = NULL;
@@ -168,29 +166,16 @@ fu_engine_update_devices_file(FuEngine *self, GError **error)
 	if (fu_engine_config_get_show_device_private(fu_engine_get_config(self)))
 		flags |= FWUPD_CODEC_FLAG_TRUSTED;
 
-	builder = json_builder_new();
-	json_builder_begin_object(builder);
-
 	devices = fu_engine_get_devices(self, NULL);
-	if (devices != NULL)
-		fwupd_codec_array_to_json(devices, "Devices", builder, flags);
-
-	root = json_builder_get_root(builder);
-	generator = json_generator_new();
-	json_generator_set_pretty(generator, TRUE);
-	json_generator_set_root(generator, root);
-	data = json_generator_to_data(generator, &len);
-	if (data == NULL) {
-		g_set_error_literal(error,
-				    FWUPD_ERROR,
-				    FWUPD_ERROR_INTERNAL,
-				    "Failed to convert to JSON string");
+	if (devices == NULL)
+		devices = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	data = fwupd_codec_array_to_json_string(devices, "Devices", flags, error);
+	if (data == NULL)
 		return FALSE;
-	}
 
 	directory = fu_path_from_kind(FU_PATH_KIND_CACHEDIR_PKG);
 	target = g_build_filename(directory, "devices.json", NULL);
-	return g_file_set_contents(target, data, (gssize)len, error);
+	return g_file_set_contents(target, data, -1, error);
 }
 
 static void
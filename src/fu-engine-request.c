@@ -19,6 +19,9 @@ struct _FuEngineRequest {
 	FwupdCodecFlags converter_flags;
 	gchar *sender;
 	gchar *locale;
+	guint64 memory_limit; /* 0 = unlimited */
+	guint64 memory_used;
+	GHashTable *memory_breakdown; /* (element-type utf8 guint64*) */
 };
 
 static void
@@ -40,6 +43,19 @@ fu_engine_request_add_string(FwupdCodec *codec, guint idt, GString *str)
 	fwupd_codec_string_append_hex(str, idt, "FeatureFlags", self->feature_flags);
 	fwupd_codec_string_append_hex(str, idt, "ConverterFlags", self->converter_flags);
 	fwupd_codec_string_append(str, idt, "Locale", self->locale);
+	if (self->memory_limit > 0)
+		fwupd_codec_string_append_hex(str, idt, "MemoryLimit", self->memory_limit);
+	if (g_hash_table_size(self->memory_breakdown) > 0) {
+		GHashTableIter iter;
+		gpointer key;
+		gpointer value;
+		g_hash_table_iter_init(&iter, self->memory_breakdown);
+		while (g_hash_table_iter_next(&iter, &key, &value)) {
+			g_autofree gchar *title =
+			    g_strdup_printf("MemoryUsed[%s]", (const gchar *)key);
+			fwupd_codec_string_append_hex(str, idt, title, *((guint64 *)value));
+		}
+	}
 }
 
 static void
@@ -135,12 +151,66 @@ fu_engine_request_has_converter_flag(FuEngineRequest *self, FwupdCodecFlags devi
 	return (self->converter_flags & device_flag) > 0;
 }
 
+void
+fu_engine_request_set_memory_limit(FuEngineRequest *self, guint64 memory_limit)
+{
+	g_return_if_fail(FU_IS_ENGINE_REQUEST(self));
+	self->memory_limit = memory_limit;
+}
+
+guint64
+fu_engine_request_get_memory_used(FuEngineRequest *self)
+{
+	g_return_val_if_fail(FU_IS_ENGINE_REQUEST(self), G_MAXUINT64);
+	return self->memory_used;
+}
+
+/* attribute @sz bytes of daemon memory to this request, failing cleanly when the
+ * configured per-request cap would be exceeded */
+gboolean
+fu_engine_request_reserve_memory(FuEngineRequest *self,
+				 const gchar *what,
+				 guint64 sz,
+				 GError **error)
+{
+	guint64 *cnt;
+
+	g_return_val_if_fail(FU_IS_ENGINE_REQUEST(self), FALSE);
+	g_return_val_if_fail(what != NULL, FALSE);
+	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+	if (self->memory_limit > 0 && self->memory_used + sz > self->memory_limit) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_DATA,
+			    "request needs %" G_GUINT64_FORMAT " bytes for %s but only "
+			    "%" G_GUINT64_FORMAT " of the %" G_GUINT64_FORMAT
+			    " byte RequestSizeMax budget remains",
+			    sz,
+			    what,
+			    self->memory_limit - self->memory_used,
+			    self->memory_limit);
+		return FALSE;
+	}
+	self->memory_used += sz;
+	cnt = g_hash_table_lookup(self->memory_breakdown, what);
+	if (cnt == NULL) {
+		cnt = g_new0(guint64, 1);
+		g_hash_table_insert(self->memory_breakdown, g_strdup(what), cnt);
+	}
+	*cnt += sz;
+
+	/* success */
+	return TRUE;
+}
+
 static void
 fu_engine_request_init(FuEngineRequest *self)
 {
 	self->flags = FU_ENGINE_REQUEST_FLAG_NONE;
 	self->converter_flags = FWUPD_CODEC_FLAG_NONE;
 	self->feature_flags = FWUPD_FEATURE_FLAG_NONE;
+	self->memory_breakdown = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
 }
 
 static void
@@ -149,6 +219,7 @@ fu_engine_request_finalize(GObject *obj)
 	FuEngineRequest *self = FU_ENGINE_REQUEST(obj);
 	g_free(self->sender);
 	g_free(self->locale);
+	g_hash_table_unref(self->memory_breakdown);
 	G_OBJECT_CLASS(fu_engine_request_parent_class)->finalize(obj);
 }
 
@@ -41,3 +41,10 @@ fu_engine_request_get_converter_flags(FuEngineRequest *self) G_GNUC_NON_NULL(1);
 void
 fu_engine_request_set_converter_flags(FuEngineRequest *self, FwupdCodecFlags device_flags)
     G_GNUC_NON_NULL(1);
+void
+fu_engine_request_set_memory_limit(FuEngineRequest *self, guint64 memory_limit) G_GNUC_NON_NULL(1);
+guint64
+fu_engine_request_get_memory_used(FuEngineRequest *self) G_GNUC_NON_NULL(1);
+gboolean
+fu_engine_request_reserve_memory(FuEngineRequest *self, const gchar *what, guint64 sz, GError **error)
+    G_GNUC_NON_NULL(1, 2);
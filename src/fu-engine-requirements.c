@@ -524,9 +524,8 @@ fu_engine_requirements_check_hardware(FuEngine *self,
 				      const gchar *fwupd_version,
 				      GError **error)
 {
-	FuContext *ctx = fu_engine_get_context(self);
 	const gchar *fwupd_required = "1.0.1";
-	g_auto(GStrv) hwid_split = NULL;
+	const gchar *hwid_matched;
 
 	/* sanity check */
 	if (xb_node_get_text(req) == NULL) {
@@ -550,13 +549,11 @@ fu_engine_requirements_check_hardware(FuEngine *self,
 		return FALSE;
 	}
 
-	/* split and treat as OR */
-	hwid_split = g_strsplit(xb_node_get_text(req), "|", -1);
-	for (guint i = 0; hwid_split[i] != NULL; i++) {
-		if (fu_context_has_hwid_guid(ctx, hwid_split[i])) {
-			g_debug("HWID provided %s", hwid_split[i]);
-			return TRUE;
-		}
+	/* treat as OR; the verdict is memoized per requirement text */
+	hwid_matched = fu_engine_has_hwid_guids(self, xb_node_get_text(req));
+	if (hwid_matched != NULL) {
+		g_debug("HWID provided %s", hwid_matched);
+		return TRUE;
 	}
 
 	/* nothing matched */
@@ -574,8 +571,7 @@ fu_engine_requirements_check_not_hardware(FuEngine *self,
 					  const gchar *fwupd_version,
 					  GError **error)
 {
-	FuContext *ctx = fu_engine_get_context(self);
-	g_auto(GStrv) hwid_split = NULL;
+	const gchar *hwid_matched;
 
 	/* check fwupd version requirement */
 	if (fu_version_compare(fwupd_version, "1.9.10", FWUPD_VERSION_FORMAT_UNKNOWN) < 0) {
@@ -596,17 +592,15 @@ fu_engine_requirements_check_not_hardware(FuEngine *self,
 		return FALSE;
 	}
 
-	/* split and treat as OR */
-	hwid_split = g_strsplit(xb_node_get_text(req), "|", -1);
-	for (guint i = 0; hwid_split[i] != NULL; i++) {
-		if (fu_context_has_hwid_guid(ctx, hwid_split[i])) {
-			g_set_error(error,
-				    FWUPD_ERROR,
-				    FWUPD_ERROR_INVALID_FILE,
-				    "%s HWIDs matched",
-				    hwid_split[i]);
-			return FALSE;
-		}
+	/* treat as OR; the verdict is memoized per requirement text */
+	hwid_matched = fu_engine_has_hwid_guids(self, xb_node_get_text(req));
+	if (hwid_matched != NULL) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_FILE,
+			    "%s HWIDs matched",
+			    hwid_matched);
+		return FALSE;
 	}
 
 	/* nothing matched */
@@ -9,6 +9,11 @@
 #include "config.h"
 
 #include <fcntl.h>
+#include <glib/gstdio.h>
+
+#ifdef HAVE_MALLOC_H
+#include <malloc.h>
+#endif
 
 #ifdef HAVE_GIO_UNIX
 #include <gio/gunixinputstream.h>
@@ -91,6 +96,18 @@
 #define FU_ENGINE_MAX_METADATA_SIZE  0x2000000 /* 32MB */
 #define FU_ENGINE_MAX_SIGNATURE_SIZE 0x100000  /* 1MB */
 
+#define FU_ENGINE_CABINET_CACHE_MAX_ITEMS 4
+
+/* granularity of the per-block container checksums generated for local remotes */
+#define FU_ENGINE_METADATA_CHECKSUM_BLOCK_SIZE 0x100000u /* 1MB */
+
+/* do not verify scrub more often than this, however short the configured period */
+#define FU_ENGINE_VERIFY_SCRUB_DELAY_MIN 60 /* s */
+
+/* how many devices from one plugin may be flashed at the same time; the transport
+ * behind a single plugin saturates long before the host does */
+#define FU_ENGINE_PARALLEL_INSTALL_PLUGIN_MAX 8
+
 static void
 fu_engine_constructed(GObject *obj);
 static void
@@ -101,6 +118,21 @@ static gboolean
 fu_engine_backends_save_phase(FuEngine *self, GError **error);
 static gboolean
 fu_engine_emulation_load_phase(FuEngine *self, GError **error);
+static gboolean
+fu_engine_ensure_silo(FuEngine *self, GError **error);
+
+typedef enum {
+	FU_ENGINE_METRIC_DEVICES_ADDED,
+	FU_ENGINE_METRIC_DEVICES_REMOVED,
+	FU_ENGINE_METRIC_HWID_REQ_CACHE_HITS,
+	FU_ENGINE_METRIC_HWID_REQ_CACHE_MISSES,
+	FU_ENGINE_METRIC_STREAM_CHECKSUMS,
+	FU_ENGINE_METRIC_SILO_REBUILDS,
+	FU_ENGINE_METRIC_INSTALLS,
+	FU_ENGINE_METRIC_INSTALL_DURATION_MS,
+	FU_ENGINE_METRIC_INSTALL_PEAK_RSS_KB,
+	FU_ENGINE_METRIC_LAST
+} FuEngineMetric;
 
 struct _FuEngine {
 	GObject parent_instance;
@@ -112,12 +144,16 @@ struct _FuEngine {
 	gboolean host_emulation;
 	guint percentage;
 	FuHistory *history;
+	GThread *history_thread;
 	FuIdle *idle;
 	XbSilo *silo;
+	GCancellable *silo_rebuild_cancellable; /* (nullable) */
+	guint silo_rebuild_generation;
 	XbQuery *query_component_by_guid;
 	XbQuery *query_container_checksum1; /* container checksum -> release */
 	XbQuery *query_container_checksum2; /* artifact checksum -> release */
 	XbQuery *query_tag_by_guid_version;
+	GHashTable *release_csum_priority; /* (nullable) (element-type utf8 gint64) */
 	guint coldplug_id;
 	FuPluginList *plugin_list;
 	GPtrArray *plugin_filter;
@@ -125,17 +161,36 @@ struct _FuEngine {
 	GHashTable *approved_firmware;	      /* (nullable) */
 	GHashTable *blocked_firmware;	      /* (nullable) */
 	GHashTable *emulation_phases;	      /* (element-type int GBytes) */
+	GHashTable *emulation_recorded_ids;   /* (element-type utf8 unused): backend IDs */
 	GHashTable *device_changed_allowlist; /* (element-type str int) */
+	GHashTable *plugin_probe_mutexes;     /* (element-type str GMutex) */
+	GMutex plugin_probe_mutexes_mutex;
+	GHashTable *plugin_lazy_fns; /* (nullable) (element-type str str): name:filename */
+	GHashTable *cabinet_cache;   /* (element-type str FuCabinet): archive checksum */
+	guint cabinet_cache_hits;
+	guint cabinet_cache_misses;
+	GHashTable *report_trusted_cache; /* (element-type str int): report fingerprint */
+	GMutex report_trusted_cache_mutex;
+	GHashTable *hwid_req_cache; /* (element-type str str): requirement text */
+	GMutex hwid_req_cache_mutex;
 	gchar *host_machine_id;
 	JcatContext *jcat_context;
 	gboolean loaded;
 	gchar *host_security_id;
 	FuSecurityAttrs *host_security_attrs;
+	FuSecurityAttrs *host_security_attrs_devices; /* (nullable) */
+	FuSecurityAttrs *host_security_attrs_plugins; /* (nullable) */
 	GPtrArray *local_monitors; /* (element-type GFileMonitor) */
 	GMainLoop *acquiesce_loop;
 	guint acquiesce_id;
 	guint acquiesce_delay;
+	gboolean acquiesce_defer_allowed;
+	guint acquiesce_deferred_delay;
 	guint update_motd_id;
+	guint verify_scrub_id;
+	guint verify_scrub_idx;
+	gboolean verify_scrub_allowed;
+	gint metrics[FU_ENGINE_METRIC_LAST]; /* updated atomically, no locks */
 	FuEngineInstallPhase install_phase;
 #ifdef HAVE_PASSIM
 	PassimClient *passim_client;
@@ -164,6 +219,26 @@ fu_engine_get_loaded(FuEngine *self)
 	return self->loaded;
 }
 
+/* cheap enough to use from any hot path or thread */
+static void
+fu_engine_metric_inc(FuEngine *self, FuEngineMetric metric)
+{
+	g_atomic_int_inc(&self->metrics[metric]);
+}
+
+static void
+fu_engine_metric_add(FuEngine *self, FuEngineMetric metric, gint value)
+{
+	g_atomic_int_add(&self->metrics[metric], value);
+}
+
+static void
+fu_engine_metric_max(FuEngine *self, FuEngineMetric metric, gint value)
+{
+	if (value > g_atomic_int_get(&self->metrics[metric]))
+		g_atomic_int_set(&self->metrics[metric], value);
+}
+
 static gboolean
 fu_engine_update_motd_timeout_cb(gpointer user_data)
 {
@@ -222,6 +297,7 @@ fu_engine_emit_device_changed_safe(FuEngine *self, FuDevice *device)
 
 	/* invalidate host security attributes */
 	g_clear_pointer(&self->host_security_id, g_free);
+	g_clear_object(&self->host_security_attrs_devices);
 	g_signal_emit(self, signals[SIGNAL_DEVICE_CHANGED], 0, device);
 }
 
@@ -247,6 +323,53 @@ fu_engine_get_context(FuEngine *self)
 	return self->ctx;
 }
 
+/**
+ * fu_engine_has_hwid_guids:
+ * @self: a #FuEngine
+ * @guids: one or more HWID GUIDs, joined with `|`
+ *
+ * Finds out if any of the HWID GUIDs exist on this system, treating the list as OR.
+ *
+ * The same requirement text appears on thousands of components in the LVFS metadata, and the
+ * system HWIDs cannot change while the daemon is running -- so the verdict for each unique
+ * requirement is only computed once.
+ *
+ * Returns: the GUID that matched, or %NULL if none did
+ **/
+const gchar *
+fu_engine_has_hwid_guids(FuEngine *self, const gchar *guids)
+{
+	const gchar *guid_matched = NULL;
+	gchar *value_new;
+	gpointer value = NULL;
+	g_auto(GStrv) guids_split = NULL;
+	g_autoptr(GMutexLocker) locker = NULL;
+
+	g_return_val_if_fail(FU_IS_ENGINE(self), NULL);
+	g_return_val_if_fail(guids != NULL, NULL);
+
+	/* seen this exact requirement before, perhaps on another release */
+	locker = g_mutex_locker_new(&self->hwid_req_cache_mutex);
+	if (g_hash_table_lookup_extended(self->hwid_req_cache, guids, NULL, &value)) {
+		fu_engine_metric_inc(self, FU_ENGINE_METRIC_HWID_REQ_CACHE_HITS);
+		guid_matched = (const gchar *)value;
+		return guid_matched[0] != '\0' ? guid_matched : NULL;
+	}
+	fu_engine_metric_inc(self, FU_ENGINE_METRIC_HWID_REQ_CACHE_MISSES);
+
+	/* split and treat as OR, remembering the result for next time */
+	guids_split = g_strsplit(guids, "|", -1);
+	for (guint i = 0; guids_split[i] != NULL; i++) {
+		if (fu_context_has_hwid_guid(self->ctx, guids_split[i])) {
+			guid_matched = guids_split[i];
+			break;
+		}
+	}
+	value_new = g_strdup(guid_matched != NULL ? guid_matched : "");
+	g_hash_table_insert(self->hwid_req_cache, g_strdup(guids), value_new);
+	return guid_matched != NULL ? value_new : NULL;
+}
+
 static void
 fu_engine_set_status(FuEngine *self, FwupdStatus status)
 {
@@ -345,6 +468,27 @@ fu_engine_set_install_phase(FuEngine *self, FuEngineInstallPhase install_phase)
 	self->install_phase = install_phase;
 }
 
+static void
+fu_engine_add_phase_timing(FuEngine *self,
+			   FuDevice *device,
+			   FwupdInstallFlags flags,
+			   gint64 started,
+			   gboolean success)
+{
+	g_autoptr(GError) error_local = NULL;
+
+	if (flags & FWUPD_INSTALL_FLAG_NO_HISTORY)
+		return;
+	if (!fu_history_add_timing(self->history,
+				   device,
+				   fu_engine_install_phase_to_string(self->install_phase),
+				   started,
+				   g_get_real_time(),
+				   success,
+				   &error_local))
+		g_warning("failed to record phase timing: %s", error_local->message);
+}
+
 static void
 fu_engine_watch_device(FuEngine *self, FuDevice *device)
 {
@@ -499,6 +643,7 @@ fu_engine_device_added_cb(FuDeviceList *device_list, FuDevice *device, FuEngine
 	fu_engine_ensure_device_lid_inhibit(self, device);
 	fu_engine_ensure_device_display_required_inhibit(self, device);
 	fu_engine_ensure_device_system_inhibit(self, device);
+	fu_engine_metric_inc(self, FU_ENGINE_METRIC_DEVICES_ADDED);
 	fu_engine_acquiesce_reset(self);
 	g_signal_emit(self, signals[SIGNAL_DEVICE_ADDED], 0, device);
 }
@@ -517,6 +662,7 @@ static void
 fu_engine_device_removed_cb(FuDeviceList *device_list, FuDevice *device, FuEngine *self)
 {
 	fu_engine_device_runner_device_removed(self, device);
+	fu_engine_metric_inc(self, FU_ENGINE_METRIC_DEVICES_REMOVED);
 	fu_engine_acquiesce_reset(self);
 	g_signal_handlers_disconnect_by_data(device, self);
 	g_signal_emit(self, signals[SIGNAL_DEVICE_REMOVED], 0, device);
@@ -536,11 +682,18 @@ fu_engine_add_local_release_metadata(FuEngine *self, FuRelease *release, GError
 {
 	FuDevice *dev = fu_release_get_device(release);
 	GPtrArray *guids;
+	g_autoptr(GError) error_silo = NULL;
 
 	/* no device matched */
 	if (dev == NULL)
 		return TRUE;
 
+	/* the metadata silo may have been unloaded to save memory */
+	if (!fu_engine_ensure_silo(self, &error_silo)) {
+		g_debug("failed to load silo: %s", error_silo->message);
+		return TRUE;
+	}
+
 	/* not set up */
 	if (self->query_tag_by_guid_version == NULL)
 		return TRUE;
@@ -642,26 +795,61 @@ fu_engine_compare_report_trusted(FwupdReport *report_trusted, FwupdReport *repor
 	return TRUE;
 }
 
+static gchar *
+fu_engine_report_trusted_key(FwupdReport *report)
+{
+	/* every attribute fu_engine_compare_report_trusted() looks at */
+	return g_strdup_printf("%" G_GUINT64_FORMAT ":%u:%s:%s:%s:%s",
+			       fwupd_report_get_flags(report),
+			       fwupd_report_get_vendor_id(report),
+			       fwupd_report_get_distro_id(report),
+			       fwupd_report_get_distro_version(report),
+			       fwupd_report_get_distro_variant(report),
+			       fwupd_report_get_remote_id(report));
+}
+
+static gboolean
+fu_engine_report_trusted(FuEngine *self, FwupdReport *report)
+{
+	GPtrArray *trusted_reports = fu_engine_config_get_trusted_reports(self->config);
+	gpointer value = NULL;
+	g_autofree gchar *key = fu_engine_report_trusted_key(report);
+	g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->report_trusted_cache_mutex);
+
+	/* the same vendor reports appear on thousands of releases in the LVFS metadata, so
+	 * only evaluate each unique fingerprint once per metadata generation */
+	if (g_hash_table_lookup_extended(self->report_trusted_cache, key, NULL, &value))
+		return GPOINTER_TO_INT(value);
+	for (guint i = 0; i < trusted_reports->len; i++) {
+		FwupdReport *trusted_report = g_ptr_array_index(trusted_reports, i);
+		if (fu_engine_compare_report_trusted(trusted_report, report)) {
+			g_autofree gchar *str = fwupd_codec_to_string(FWUPD_CODEC(trusted_report));
+			g_debug("report %s matched as trusted: %s", key, str);
+			g_hash_table_insert(self->report_trusted_cache,
+					    g_steal_pointer(&key),
+					    GINT_TO_POINTER(TRUE));
+			return TRUE;
+		}
+	}
+	g_hash_table_insert(self->report_trusted_cache,
+			    g_steal_pointer(&key),
+			    GINT_TO_POINTER(FALSE));
+	return FALSE;
+}
+
 static void
 fu_engine_add_trusted_report(FuEngine *self, FuRelease *release)
 {
 	GPtrArray *reports = fu_release_get_reports(release);
-	GPtrArray *trusted_reports = fu_engine_config_get_trusted_reports(self->config);
 
 	for (guint i = 0; i < reports->len; i++) {
 		FwupdReport *report = g_ptr_array_index(reports, i);
-		for (guint j = 0; j < trusted_reports->len; j++) {
-			FwupdReport *trusted_report = g_ptr_array_index(trusted_reports, j);
-			if (fu_engine_compare_report_trusted(trusted_report, report)) {
-				g_autofree gchar *str =
-				    fwupd_codec_to_string(FWUPD_CODEC(trusted_report));
-				g_debug("add trusted-report to %s:%s as trusted: %s",
-					fu_release_get_appstream_id(release),
-					fu_release_get_version(release),
-					str);
-				fu_release_add_flag(release, FWUPD_RELEASE_FLAG_TRUSTED_REPORT);
-				return;
-			}
+		if (fu_engine_report_trusted(self, report)) {
+			g_debug("add trusted-report to %s:%s",
+				fu_release_get_appstream_id(release),
+				fu_release_get_version(release));
+			fu_release_add_flag(release, FWUPD_RELEASE_FLAG_TRUSTED_REPORT);
+			return;
 		}
 	}
 }
@@ -715,6 +903,15 @@ static XbNode *
 fu_engine_get_release_for_checksum(FuEngine *self, const gchar *csum)
 {
 	g_auto(XbQueryContext) context = XB_QUERY_CONTEXT_INIT();
+	g_autoptr(GError) error_silo = NULL;
+
+	/* the metadata silo may have been unloaded to save memory */
+	if (!fu_engine_ensure_silo(self, &error_silo)) {
+		g_warning("failed to load silo: %s", error_silo->message);
+		return NULL;
+	}
+
+	xb_query_context_set_flags(&context, XB_QUERY_FLAG_USE_INDEXES);
 	xb_value_bindings_bind_str(xb_query_context_get_bindings(&context), 0, csum, NULL);
 	if (self->query_container_checksum1 != NULL) {
 		g_autoptr(XbNode) rel =
@@ -739,21 +936,126 @@ fu_engine_get_release_for_checksum(FuEngine *self, const gchar *csum)
 	return NULL;
 }
 
+typedef struct {
+	GInputStream *stream; /* no-ref */
+	const GChecksumType *checksum_types;
+	GChecksumType checksum_type;
+	GPtrArray *checksums;
+	gchar *checksum;
+	GMainLoop *loop; /* no-ref */
+	GError *error;
+} FuEngineChecksumHelper;
+
+static void
+fu_engine_compute_stream_checksums_run(FuEngineChecksumHelper *helper)
+{
+	if (helper->checksum_types != NULL) {
+		helper->checksums = fu_input_stream_compute_checksums(helper->stream,
+								      helper->checksum_types,
+								      &helper->error);
+	} else {
+		helper->checksum = fu_input_stream_compute_checksum(helper->stream,
+								    helper->checksum_type,
+								    &helper->error);
+	}
+}
+
+static gboolean
+fu_engine_compute_stream_checksums_done_cb(gpointer user_data)
+{
+	FuEngineChecksumHelper *helper = (FuEngineChecksumHelper *)user_data;
+	g_main_loop_quit(helper->loop);
+	return G_SOURCE_REMOVE;
+}
+
+static gpointer
+fu_engine_compute_stream_checksums_thread_cb(gpointer user_data)
+{
+	FuEngineChecksumHelper *helper = (FuEngineChecksumHelper *)user_data;
+	fu_engine_compute_stream_checksums_run(helper);
+	g_idle_add(fu_engine_compute_stream_checksums_done_cb, helper);
+	return NULL;
+}
+
+/* digest on a worker thread while the default context keeps dispatching, so that D-Bus
+ * method calls are still answered while a multi-gigabyte archive is being hashed */
+static void
+fu_engine_compute_stream_checksums_offload(FuEngineChecksumHelper *helper)
+{
+	GThread *thread;
+	g_autoptr(GMainLoop) loop = NULL;
+
+	/* nothing is iterating the default context here, e.g. a fwupdtool command or an
+	 * install batch worker, so hashing inline cannot block dispatch */
+	if (!g_main_context_is_owner(g_main_context_default())) {
+		fu_engine_compute_stream_checksums_run(helper);
+		return;
+	}
+
+	loop = g_main_loop_new(NULL, FALSE);
+	helper->loop = loop;
+	thread = g_thread_new("FuEngineChecksum",
+			      fu_engine_compute_stream_checksums_thread_cb,
+			      helper);
+	g_main_loop_run(loop);
+	g_thread_join(thread);
+}
+
+static GPtrArray *
+fu_engine_compute_stream_checksums(FuEngine *self,
+				   GInputStream *stream,
+				   const GChecksumType *checksum_types,
+				   GError **error)
+{
+	FuEngineChecksumHelper helper = {
+	    .stream = stream,
+	    .checksum_types = checksum_types,
+	};
+	fu_engine_metric_inc(self, FU_ENGINE_METRIC_STREAM_CHECKSUMS);
+	fu_engine_compute_stream_checksums_offload(&helper);
+	if (helper.checksums == NULL) {
+		g_propagate_error(error, g_steal_pointer(&helper.error));
+		return NULL;
+	}
+	return g_steal_pointer(&helper.checksums);
+}
+
+static gchar *
+fu_engine_compute_stream_checksum(FuEngine *self,
+				  GInputStream *stream,
+				  GChecksumType checksum_type,
+				  GError **error)
+{
+	FuEngineChecksumHelper helper = {
+	    .stream = stream,
+	    .checksum_type = checksum_type,
+	};
+	fu_engine_metric_inc(self, FU_ENGINE_METRIC_STREAM_CHECKSUMS);
+	fu_engine_compute_stream_checksums_offload(&helper);
+	if (helper.checksum == NULL) {
+		g_propagate_error(error, g_steal_pointer(&helper.error));
+		return NULL;
+	}
+	return g_steal_pointer(&helper.checksum);
+}
+
 /* does this exist in any enabled remote */
 gchar *
 fu_engine_get_remote_id_for_stream(FuEngine *self, GInputStream *stream)
 {
 	GChecksumType checksum_types[] = {G_CHECKSUM_SHA256, G_CHECKSUM_SHA1, 0};
+	g_autoptr(GPtrArray) csums = NULL;
 
 	g_return_val_if_fail(FU_IS_ENGINE(self), NULL);
 	g_return_val_if_fail(G_IS_INPUT_STREAM(stream), NULL);
 
-	for (guint i = 0; checksum_types[i] != 0; i++) {
-		g_autofree gchar *csum = NULL;
-		g_autoptr(XbNode) rel = NULL;
-		csum = fu_input_stream_compute_checksum(stream, checksum_types[i], NULL);
-		if (csum != NULL)
-			rel = fu_engine_get_release_for_checksum(self, csum);
+	/* single pass over what might be a very large archive */
+	csums = fu_engine_compute_stream_checksums(self, stream, checksum_types, NULL);
+	if (csums == NULL)
+		return NULL;
+	for (guint i = 0; i < csums->len; i++) {
+		const gchar *csum = g_ptr_array_index(csums, i);
+		g_autoptr(XbNode) rel = fu_engine_get_release_for_checksum(self, csum);
 		if (rel != NULL) {
 			const gchar *remote_id =
 			    xb_node_query_text(rel,
@@ -846,6 +1148,7 @@ fu_engine_modify_config(FuEngine *self,
 		    "P2pPolicy",
 		    "ReleaseDedupe",
 		    "ReleasePriority",
+		    "RequestSizeMax",
 		    "ShowDevicePrivate",
 		    "TestDevices",
 		    "TrustedReports",
@@ -1341,9 +1644,16 @@ static XbNode *
 fu_engine_get_component_by_guid(FuEngine *self, const gchar *guid)
 {
 	g_autoptr(GError) error_local = NULL;
+	g_autoptr(GError) error_silo = NULL;
 	g_autoptr(XbNode) component = NULL;
 	g_auto(XbQueryContext) context = XB_QUERY_CONTEXT_INIT();
 
+	/* the metadata silo may have been unloaded to save memory */
+	if (!fu_engine_ensure_silo(self, &error_silo)) {
+		g_warning("failed to load silo: %s", error_silo->message);
+		return NULL;
+	}
+
 	/* no components in silo */
 	if (self->query_component_by_guid == NULL)
 		return NULL;
@@ -1424,6 +1734,10 @@ fu_engine_verify_from_system_metadata(FuEngine *self, FuDevice *device, GError *
 	GPtrArray *guids = fu_device_get_guids(device);
 	g_autoptr(XbQuery) query = NULL;
 
+	/* the metadata silo may have been unloaded to save memory */
+	if (!fu_engine_ensure_silo(self, error))
+		return NULL;
+
 	/* prepare query with bound GUID parameter */
 	query = xb_query_new_full(self->silo,
 				  "components/component[@type='firmware']/"
@@ -1484,6 +1798,7 @@ fu_engine_verify(FuEngine *self, const gchar *device_id, FuProgress *progress, G
 {
 	FuPlugin *plugin;
 	GPtrArray *checksums;
+	gboolean checksum_on_device = FALSE;
 	g_autoptr(FuDevice) device = NULL;
 	g_autoptr(GError) error_local = NULL;
 	g_autoptr(GString) xpath_csum = g_string_new(NULL);
@@ -1505,8 +1820,34 @@ fu_engine_verify(FuEngine *self, const gchar *device_id, FuProgress *progress, G
 	if (plugin == NULL)
 		return FALSE;
 
-	/* update the device firmware hashes if possible */
-	if (fu_device_has_flag(device, FWUPD_DEVICE_FLAG_CAN_VERIFY_IMAGE)) {
+	/* ask the device to compute the checksum itself if the plugin implements it, which
+	 * avoids reading the entire image back over the transport just to hash it here */
+	if (FU_DEVICE_GET_CLASS(device)->compute_checksum != NULL) {
+		const GChecksumType checksum_types[] = {G_CHECKSUM_SHA256, G_CHECKSUM_SHA1};
+		g_autoptr(FuDeviceLocker) locker = fu_device_locker_new(device, error);
+		if (locker == NULL)
+			return FALSE;
+		for (guint i = 0; i < G_N_ELEMENTS(checksum_types); i++) {
+			g_autofree gchar *csum_tmp = NULL;
+			g_autoptr(GError) error_csum = NULL;
+			csum_tmp = fu_device_compute_checksum(device,
+							      checksum_types[i],
+							      progress,
+							      &error_csum);
+			if (csum_tmp == NULL) {
+				g_debug("failed to compute %s on-device: %s",
+					fwupd_checksum_type_to_string_display(checksum_types[i]),
+					error_csum->message);
+				continue;
+			}
+			fu_device_add_checksum(device, csum_tmp);
+			checksum_on_device = TRUE;
+		}
+	}
+
+	/* update the device firmware hashes by reading the image back if possible */
+	if (!checksum_on_device &&
+	    fu_device_has_flag(device, FWUPD_DEVICE_FLAG_CAN_VERIFY_IMAGE)) {
 		if (!fu_plugin_runner_verify(plugin,
 					     device,
 					     progress,
@@ -1893,6 +2234,14 @@ fu_engine_get_report_metadata(FuEngine *self, GError **error)
 			    passim_client_get_download_saving(self->passim_client)));
 #endif
 
+	/* this is useful to know if re-installs are skipping archive verification */
+	g_hash_table_insert(hash,
+			    g_strdup("CabinetCacheHits"),
+			    g_strdup_printf("%u", self->cabinet_cache_hits));
+	g_hash_table_insert(hash,
+			    g_strdup("CabinetCacheMisses"),
+			    g_strdup_printf("%u", self->cabinet_cache_misses));
+
 	/* DMI data */
 	if (fu_context_has_flag(self->ctx, FU_CONTEXT_FLAG_LOADED_HWINFO)) {
 		struct {
@@ -1956,6 +2305,92 @@ fu_engine_get_report_metadata(FuEngine *self, GError **error)
 	return g_steal_pointer(&hash);
 }
 
+/**
+ * fu_engine_get_metrics:
+ * @self: a #FuEngine
+ *
+ * Gets the internal statistics counters in a Prometheus-friendly key/value layout.
+ *
+ * Returns: (transfer full) (element-type utf8 utf8): counters
+ **/
+GHashTable *
+fu_engine_get_metrics(FuEngine *self)
+{
+	struct {
+		FuEngineMetric metric;
+		const gchar *name;
+	} names[] = {
+	    {FU_ENGINE_METRIC_DEVICES_ADDED, "fwupd_devices_added_total"},
+	    {FU_ENGINE_METRIC_DEVICES_REMOVED, "fwupd_devices_removed_total"},
+	    {FU_ENGINE_METRIC_HWID_REQ_CACHE_HITS, "fwupd_hwid_requirement_cache_hits_total"},
+	    {FU_ENGINE_METRIC_HWID_REQ_CACHE_MISSES, "fwupd_hwid_requirement_cache_misses_total"},
+	    {FU_ENGINE_METRIC_STREAM_CHECKSUMS, "fwupd_stream_checksums_total"},
+	    {FU_ENGINE_METRIC_SILO_REBUILDS, "fwupd_silo_rebuilds_total"},
+	    {FU_ENGINE_METRIC_INSTALLS, "fwupd_installs_total"},
+	    {FU_ENGINE_METRIC_INSTALL_DURATION_MS, "fwupd_install_duration_ms_total"},
+	    {FU_ENGINE_METRIC_INSTALL_PEAK_RSS_KB, "fwupd_install_peak_rss_kb"},
+	};
+	g_autoptr(GHashTable) hash =
+	    g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+	g_autoptr(GPtrArray) devices = NULL;
+
+	g_return_val_if_fail(FU_IS_ENGINE(self), NULL);
+
+	for (guint i = 0; i < G_N_ELEMENTS(names); i++) {
+		gint value = g_atomic_int_get(&self->metrics[names[i].metric]);
+		g_hash_table_insert(hash,
+				    g_strdup(names[i].name),
+				    g_strdup_printf("%i", value));
+	}
+
+	/* not in the registry, but cheap to read here */
+	devices = fu_device_list_get_all(self->device_list);
+	g_hash_table_insert(hash,
+			    g_strdup("fwupd_device_count"),
+			    g_strdup_printf("%u", devices->len));
+	g_hash_table_insert(hash,
+			    g_strdup("fwupd_cabinet_cache_hits_total"),
+			    g_strdup_printf("%u", self->cabinet_cache_hits));
+	g_hash_table_insert(hash,
+			    g_strdup("fwupd_cabinet_cache_misses_total"),
+			    g_strdup_printf("%u", self->cabinet_cache_misses));
+
+	/* live-bytes gauges for the major heap consumers, so monitoring can attribute
+	 * RSS growth to a subsystem rather than alarming on the opaque total */
+	if (self->silo != NULL) {
+		g_autoptr(GBytes) silo_blob = xb_silo_get_bytes(self->silo);
+		if (silo_blob != NULL) {
+			g_hash_table_insert(
+			    hash,
+			    g_strdup("fwupd_silo_bytes"),
+			    g_strdup_printf("%" G_GSIZE_FORMAT, g_bytes_get_size(silo_blob)));
+		}
+	}
+	if (self->cabinet_cache != NULL) {
+		guint64 cabinet_cache_bytes = 0;
+		GHashTableIter cabinet_iter;
+		gpointer value;
+		g_hash_table_iter_init(&cabinet_iter, self->cabinet_cache);
+		while (g_hash_table_iter_next(&cabinet_iter, NULL, &value))
+			cabinet_cache_bytes += fu_firmware_get_size(FU_FIRMWARE(value));
+		g_hash_table_insert(hash,
+				    g_strdup("fwupd_cabinet_cache_bytes"),
+				    g_strdup_printf("%" G_GUINT64_FORMAT, cabinet_cache_bytes));
+	}
+	if (self->plugin_list != NULL) {
+		guint64 plugin_data_bytes = 0;
+		GPtrArray *plugins = fu_plugin_list_get_all(self->plugin_list);
+		for (guint i = 0; i < plugins->len; i++) {
+			FuPlugin *plugin_tmp = g_ptr_array_index(plugins, i);
+			plugin_data_bytes += fu_plugin_get_data_size(plugin_tmp);
+		}
+		g_hash_table_insert(hash,
+				    g_strdup("fwupd_plugin_data_bytes"),
+				    g_strdup_printf("%" G_GUINT64_FORMAT, plugin_data_bytes));
+	}
+	return g_steal_pointer(&hash);
+}
+
 /**
  * fu_engine_composite_prepare:
  * @self: a #FuEngine
@@ -2085,7 +2520,7 @@ fu_engine_publish_release(FuEngine *self, FuRelease *release, GError **error)
 		passim_item_set_max_age(passim_item, 30 * 24 * 60 * 60);
 		passim_item_set_share_limit(passim_item, 50);
 		passim_item_set_basename(passim_item, basename);
-		checksum = fu_input_stream_compute_checksum(stream, G_CHECKSUM_SHA256, error);
+		checksum = fu_engine_compute_stream_checksum(self, stream, G_CHECKSUM_SHA256, error);
 		if (checksum == NULL)
 			return FALSE;
 		if (!fu_input_stream_size(stream, &streamsz, error))
@@ -2136,6 +2571,121 @@ fu_engine_install_release_version_check(FuEngine *self,
 	return TRUE;
 }
 
+/* TRUE only if updating both targets at the same time provably cannot interfere:
+ * equal install order, no ancestor relationship, and different thread-safe plugins */
+static gboolean
+fu_engine_install_releases_independent(FuEngine *self, FuRelease *release1, FuRelease *release2)
+{
+	FuDevice *device1 = fu_release_get_device(release1);
+	FuDevice *device2 = fu_release_get_device(release2);
+	FuPlugin *plugin1;
+	FuPlugin *plugin2;
+
+	/* explicit ordering always wins */
+	if (fu_device_get_order(device1) != fu_device_get_order(device2))
+		return FALSE;
+
+	/* same device, or one is an ancestor of the other */
+	for (FuDevice *tmp = device1; tmp != NULL; tmp = fu_device_get_parent(tmp)) {
+		if (tmp == device2)
+			return FALSE;
+	}
+	for (FuDevice *tmp = device2; tmp != NULL; tmp = fu_device_get_parent(tmp)) {
+		if (tmp == device1)
+			return FALSE;
+	}
+
+	/* devices that change system state have to be serialized */
+	if (fu_device_has_flag(device1, FWUPD_DEVICE_FLAG_NEEDS_REBOOT) ||
+	    fu_device_has_flag(device1, FWUPD_DEVICE_FLAG_NEEDS_SHUTDOWN) ||
+	    fu_device_has_flag(device2, FWUPD_DEVICE_FLAG_NEEDS_REBOOT) ||
+	    fu_device_has_flag(device2, FWUPD_DEVICE_FLAG_NEEDS_SHUTDOWN))
+		return FALSE;
+
+	plugin1 = fu_plugin_list_find_by_name(self->plugin_list, fu_device_get_plugin(device1), NULL);
+	plugin2 = fu_plugin_list_find_by_name(self->plugin_list, fu_device_get_plugin(device2), NULL);
+	if (plugin1 == NULL || plugin2 == NULL)
+		return FALSE;
+
+	/* same bus: identical devices can be flashed together, but only when the plugin
+	 * has explicitly opted in to broadcast installs */
+	if (g_strcmp0(fu_device_get_plugin(device1), fu_device_get_plugin(device2)) == 0)
+		return fu_plugin_has_flag(plugin1, FWUPD_PLUGIN_FLAG_PARALLEL_INSTALLS);
+
+	/* different buses, i.e. different plugins that both allow threaded probes */
+	if (fu_plugin_has_flag(plugin1, FWUPD_PLUGIN_FLAG_NOT_THREAD_SAFE) ||
+	    fu_plugin_has_flag(plugin2, FWUPD_PLUGIN_FLAG_NOT_THREAD_SAFE))
+		return FALSE;
+
+	/* success */
+	return TRUE;
+}
+
+typedef struct {
+	FuEngine *self;
+	FuRelease *release;
+	FuProgress *progress;
+	FwupdInstallFlags flags;
+	gboolean ret;
+	GError *error;
+} FuEngineInstallReleaseHelper;
+
+static gpointer
+fu_engine_install_release_thread_cb(gpointer user_data)
+{
+	FuEngineInstallReleaseHelper *helper = (FuEngineInstallReleaseHelper *)user_data;
+	helper->ret = fu_engine_install_release(helper->self,
+						helper->release,
+						fu_release_get_stream(helper->release),
+						helper->progress,
+						helper->flags,
+						&helper->error);
+	return NULL;
+}
+
+static gboolean
+fu_engine_install_releases_batch(FuEngine *self,
+				 GPtrArray *releases,
+				 guint idx,
+				 guint batchsz,
+				 FwupdInstallFlags flags,
+				 GError **error)
+{
+	gboolean ret = TRUE;
+	g_autofree FuEngineInstallReleaseHelper *helpers =
+	    g_new0(FuEngineInstallReleaseHelper, batchsz);
+	g_autoptr(GPtrArray) threads = g_ptr_array_new();
+
+	/* each thread gets an unparented progress so the shared one is only
+	 * stepped from the main thread once the whole batch has finished */
+	g_info("installing %u independent releases in parallel", batchsz);
+	for (guint i = 0; i < batchsz; i++) {
+		FuEngineInstallReleaseHelper *helper = &helpers[i];
+		helper->self = self;
+		helper->release = g_ptr_array_index(releases, idx + i);
+		helper->progress = fu_progress_new(G_STRLOC);
+		helper->flags = flags;
+		g_ptr_array_add(
+		    threads,
+		    g_thread_new("fu-install", fu_engine_install_release_thread_cb, helper));
+	}
+	for (guint i = 0; i < batchsz; i++) {
+		GThread *thread = g_ptr_array_index(threads, i);
+		FuEngineInstallReleaseHelper *helper = &helpers[i];
+		g_thread_join(thread);
+		if (!helper->ret) {
+			if (ret) {
+				g_propagate_error(error, g_steal_pointer(&helper->error));
+				ret = FALSE;
+			} else {
+				g_clear_error(&helper->error);
+			}
+		}
+		g_object_unref(helper->progress);
+	}
+	return ret;
+}
+
 /**
  * fu_engine_install_releases:
  * @self: a #FuEngine
@@ -2162,10 +2712,15 @@ fu_engine_install_releases(FuEngine *self,
 			   FwupdInstallFlags flags,
 			   GError **error)
 {
+	gboolean parallel;
 	g_autoptr(FuIdleLocker) locker = NULL;
 	g_autoptr(GPtrArray) devices = NULL;
 	g_autoptr(GPtrArray) devices_new = NULL;
 
+	/* writing in parallel would interleave the per-phase emulation events */
+	parallel = fu_engine_config_get_parallel_installs(self->config) &&
+		   !fu_context_has_flag(self->ctx, FU_CONTEXT_FLAG_SAVE_EVENTS);
+
 	/* do not allow auto-shutdown during this time */
 	locker = fu_idle_locker_new(self->idle,
 				    FU_IDLE_INHIBIT_TIMEOUT | FU_IDLE_INHIBIT_SIGNALS,
@@ -2210,9 +2765,10 @@ fu_engine_install_releases(FuEngine *self,
 	/* all authenticated, so install all the things */
 	fu_progress_set_id(progress, G_STRLOC);
 	fu_progress_set_steps(progress, releases->len);
-	for (guint i = 0; i < releases->len; i++) {
+	for (guint i = 0; i < releases->len;) {
 		FuRelease *release = g_ptr_array_index(releases, i);
 		GInputStream *stream = fu_release_get_stream(release);
+		guint batchsz = 1;
 		if (stream == NULL) {
 			g_set_error_literal(error,
 					    FWUPD_ERROR,
@@ -2220,12 +2776,68 @@ fu_engine_install_releases(FuEngine *self,
 					    "no stream for release");
 			return FALSE;
 		}
-		if (!fu_engine_install_release(self,
-					       release,
-					       stream,
-					       fu_progress_get_child(progress),
-					       flags,
-					       error)) {
+
+		/* extend the batch while every pair is provably independent */
+		if (parallel) {
+			while (i + batchsz < releases->len) {
+				FuRelease *release_next =
+				    g_ptr_array_index(releases, i + batchsz);
+				const gchar *plugin_next = fu_device_get_plugin(
+				    fu_release_get_device(release_next));
+				gboolean independent = fu_release_get_stream(release_next) != NULL;
+				guint cnt_plugin = 0;
+				for (guint j = i; independent && j < i + batchsz; j++) {
+					FuRelease *release_tmp = g_ptr_array_index(releases, j);
+					FuDevice *device_tmp = fu_release_get_device(release_tmp);
+					if (!fu_engine_install_releases_independent(self,
+										    release_tmp,
+										    release_next))
+						independent = FALSE;
+					if (g_strcmp0(fu_device_get_plugin(device_tmp),
+						      plugin_next) == 0)
+						cnt_plugin++;
+				}
+				/* cap the concurrency per transport */
+				if (cnt_plugin >= FU_ENGINE_PARALLEL_INSTALL_PLUGIN_MAX)
+					independent = FALSE;
+				if (!independent)
+					break;
+				batchsz++;
+			}
+		}
+
+		/* the usual sequential case */
+		if (batchsz == 1) {
+			FuDevice *device = fu_release_get_device(release);
+
+			/* the settle wait can be deferred until the last member */
+			self->acquiesce_defer_allowed =
+			    i + 1 < releases->len &&
+			    fu_device_has_private_flag(device,
+						       FU_DEVICE_PRIVATE_FLAG_COMPOSITE_ACQUIESCE);
+			if (!fu_engine_install_release(self,
+						       release,
+						       stream,
+						       fu_progress_get_child(progress),
+						       flags,
+						       error)) {
+				g_autoptr(GError) error_local = NULL;
+				self->acquiesce_defer_allowed = FALSE;
+				self->acquiesce_deferred_delay = 0;
+				if (!fu_engine_composite_cleanup(self, devices, &error_local)) {
+					g_warning("failed to cleanup failed composite action: %s",
+						  error_local->message);
+				}
+				return FALSE;
+			}
+			self->acquiesce_defer_allowed = FALSE;
+			fu_progress_step_done(progress);
+			i += 1;
+			continue;
+		}
+
+		/* run each install in the batch in its own thread */
+		if (!fu_engine_install_releases_batch(self, releases, i, batchsz, flags, error)) {
 			g_autoptr(GError) error_local = NULL;
 			if (!fu_engine_composite_cleanup(self, devices, &error_local)) {
 				g_warning("failed to cleanup failed composite action: %s",
@@ -2233,7 +2845,16 @@ fu_engine_install_releases(FuEngine *self,
 			}
 			return FALSE;
 		}
-		fu_progress_step_done(progress);
+		for (guint j = 0; j < batchsz; j++)
+			fu_progress_step_done(progress);
+		i += batchsz;
+	}
+
+	/* wait for any acquiesce delays that were deferred to the end of the update */
+	if (self->acquiesce_deferred_delay > 0) {
+		fu_progress_set_status(progress, FWUPD_STATUS_DEVICE_BUSY);
+		fu_engine_wait_for_acquiesce(self, self->acquiesce_deferred_delay);
+		self->acquiesce_deferred_delay = 0;
 	}
 
 	/* set all the device statuses back to unknown */
@@ -2460,11 +3081,12 @@ fu_engine_install_release(FuEngine *self,
 	/* add the checksum of the container blob if not already set */
 	if (fwupd_release_get_checksums(FWUPD_RELEASE(release))->len == 0) {
 		GChecksumType checksum_types[] = {G_CHECKSUM_SHA256, G_CHECKSUM_SHA1, 0};
-		for (guint i = 0; checksum_types[i] != 0; i++) {
-			g_autofree gchar *checksum =
-			    fu_input_stream_compute_checksum(stream, checksum_types[i], error);
-			if (checksum == NULL)
-				return FALSE;
+		g_autoptr(GPtrArray) checksums =
+		    fu_engine_compute_stream_checksums(self, stream, checksum_types, error);
+		if (checksums == NULL)
+			return FALSE;
+		for (guint i = 0; i < checksums->len; i++) {
+			const gchar *checksum = g_ptr_array_index(checksums, i);
 			fwupd_release_add_checksum(FWUPD_RELEASE(release), checksum);
 		}
 	}
@@ -2561,8 +3183,19 @@ fu_engine_install_release(FuEngine *self,
 	/* wait for the system to acquiesce if required */
 	if (fu_device_get_acquiesce_delay(device_orig) > 0 &&
 	    !fu_device_has_flag(device, FWUPD_DEVICE_FLAG_EMULATED)) {
-		fu_progress_set_status(progress, FWUPD_STATUS_DEVICE_BUSY);
-		fu_engine_wait_for_acquiesce(self, fu_device_get_acquiesce_delay(device_orig));
+		if (self->acquiesce_defer_allowed) {
+			/* the composite members settle together, so wait once at the end */
+			self->acquiesce_deferred_delay =
+			    MAX(self->acquiesce_deferred_delay,
+				fu_device_get_acquiesce_delay(device_orig));
+			g_info("deferring %ums acquiesce delay for %s to the end of the update",
+			       fu_device_get_acquiesce_delay(device_orig),
+			       fu_device_get_id(device_orig));
+		} else {
+			fu_progress_set_status(progress, FWUPD_STATUS_DEVICE_BUSY);
+			fu_engine_wait_for_acquiesce(self,
+						     fu_device_get_acquiesce_delay(device_orig));
+		}
 	}
 
 	/* success */
@@ -2586,6 +3219,67 @@ fu_engine_get_plugins(FuEngine *self)
 	return fu_plugin_list_get_all(self->plugin_list);
 }
 
+/**
+ * fu_engine_get_plugin_timings:
+ * @self: a #FuEngine
+ *
+ * Gets the recorded open, startup and coldplug durations for each plugin and
+ * backend, keyed as `name:step` with values in microseconds.
+ *
+ * Returns: (transfer full): a `a{st}` variant
+ *
+ * Since: 2.0.3
+ **/
+GVariant *
+fu_engine_get_plugin_timings(FuEngine *self)
+{
+	GPtrArray *backends = fu_context_get_backends(self->ctx);
+	GPtrArray *plugins = fu_plugin_list_get_all(self->plugin_list);
+	GVariantBuilder builder;
+
+	g_return_val_if_fail(FU_IS_ENGINE(self), NULL);
+
+	g_variant_builder_init(&builder, G_VARIANT_TYPE("a{st}"));
+	for (guint i = 0; i < plugins->len; i++) {
+		FuPlugin *plugin = g_ptr_array_index(plugins, i);
+		GHashTable *timings = fu_plugin_get_timings(plugin);
+		GHashTableIter iter;
+		gpointer key;
+		gpointer value;
+		if (timings == NULL)
+			continue;
+		g_hash_table_iter_init(&iter, timings);
+		while (g_hash_table_iter_next(&iter, &key, &value)) {
+			g_autofree gchar *id =
+			    g_strdup_printf("%s:%s", fu_plugin_get_name(plugin), (const gchar *)key);
+			g_variant_builder_add(&builder,
+					      "{st}",
+					      id,
+					      (guint64)GPOINTER_TO_UINT(value));
+		}
+	}
+	for (guint i = 0; i < backends->len; i++) {
+		FuBackend *backend = g_ptr_array_index(backends, i);
+		GHashTable *timings = fu_backend_get_timings(backend);
+		GHashTableIter iter;
+		gpointer key;
+		gpointer value;
+		if (timings == NULL)
+			continue;
+		g_hash_table_iter_init(&iter, timings);
+		while (g_hash_table_iter_next(&iter, &key, &value)) {
+			g_autofree gchar *id = g_strdup_printf("%s:%s",
+							       fu_backend_get_name(backend),
+							       (const gchar *)key);
+			g_variant_builder_add(&builder,
+					      "{st}",
+					      id,
+					      (guint64)GPOINTER_TO_UINT(value));
+		}
+	}
+	return g_variant_ref_sink(g_variant_builder_end(&builder));
+}
+
 /**
  * fu_engine_get_plugin_by_name:
  * @self: a #FuPluginList
@@ -2675,6 +3369,7 @@ fu_engine_emulation_load(FuEngine *self,
 	if (!fu_engine_emulation_load_json_blob(self, json_blob, error))
 		return FALSE;
 	g_hash_table_remove_all(self->emulation_phases);
+	g_hash_table_remove_all(self->emulation_recorded_ids);
 
 	/* load archive */
 	archive = fu_archive_new_stream(stream, FU_ARCHIVE_FLAG_NONE, &error_archive);
@@ -2765,6 +3460,7 @@ fu_engine_emulation_save(FuEngine *self, GOutputStream *stream, GError **error)
 
 	/* success */
 	g_hash_table_remove_all(self->emulation_phases);
+	g_hash_table_remove_all(self->emulation_recorded_ids);
 	return TRUE;
 }
 
@@ -2772,6 +3468,7 @@ static void
 fu_engine_backends_to_json(FuEngine *self, JsonBuilder *json_builder)
 {
 	g_autoptr(GPtrArray) devices = fu_device_list_get_active(self->device_list);
+	g_autoptr(GPtrArray) backend_ids_unchanged = g_ptr_array_new();
 
 	/* not always correct, but we want to remain compatible with all the old emulation files */
 	json_builder_begin_object(json_builder);
@@ -2779,15 +3476,40 @@ fu_engine_backends_to_json(FuEngine *self, JsonBuilder *json_builder)
 	json_builder_begin_array(json_builder);
 	for (guint i = 0; i < devices->len; i++) {
 		FuDevice *device = g_ptr_array_index(devices, i);
+		const gchar *backend_id = fu_device_get_backend_id(device);
 
 		/* interesting? */
 		if (!fu_device_has_flag(device, FWUPD_DEVICE_FLAG_EMULATION_TAG))
 			continue;
+
+		/* already recorded in a previous phase with no new events; replay only merges
+		 * the event data for existing devices, so the full serialization (which is
+		 * mostly base64 event payloads) can be replaced by a reference */
+		if (self->install_phase != FU_ENGINE_INSTALL_PHASE_SETUP && backend_id != NULL &&
+		    g_hash_table_contains(self->emulation_recorded_ids, backend_id) &&
+		    fu_device_get_events(device)->len == 0) {
+			g_ptr_array_add(backend_ids_unchanged, (gpointer)backend_id);
+			continue;
+		}
 		json_builder_begin_object(json_builder);
 		fwupd_codec_to_json(FWUPD_CODEC(device), json_builder, FWUPD_CODEC_FLAG_NONE);
 		json_builder_end_object(json_builder);
+		if (backend_id != NULL) {
+			g_hash_table_insert(self->emulation_recorded_ids,
+					    g_strdup(backend_id),
+					    NULL);
+		}
 	}
 	json_builder_end_array(json_builder);
+	if (backend_ids_unchanged->len > 0) {
+		json_builder_set_member_name(json_builder, "UsbDevicesUnchanged");
+		json_builder_begin_array(json_builder);
+		for (guint i = 0; i < backend_ids_unchanged->len; i++) {
+			const gchar *backend_id = g_ptr_array_index(backend_ids_unchanged, i);
+			json_builder_add_string_value(json_builder, backend_id);
+		}
+		json_builder_end_array(json_builder);
+	}
 	json_builder_end_object(json_builder);
 
 	/* we've recorded these, now drop them */
@@ -3434,23 +4156,65 @@ fu_engine_firmware_read(FuEngine *self,
 	return fu_device_read_firmware(device, progress, error);
 }
 
-gboolean
-fu_engine_install_blob(FuEngine *self,
-		       FuDevice *device,
-		       GInputStream *stream_fw,
-		       FuProgress *progress,
-		       FwupdInstallFlags flags,
-		       FwupdFeatureFlags feature_flags,
-		       GError **error)
+#ifdef __linux__
+/* anything past the payload size plus this much is probably a full-image copy */
+#define FU_ENGINE_INSTALL_RSS_SLACK (32u * 1024 * 1024)
+
+static void
+fu_engine_install_peak_rss_reset(void)
 {
-	guint retries = 0;
+	g_autoptr(GError) error_local = NULL;
+
+	/* writing 5 resets the peak RSS watermark for the calling process */
+	if (!g_file_set_contents("/proc/self/clear_refs", "5", -1, &error_local))
+		g_debug("failed to reset peak RSS: %s", error_local->message);
+}
+
+static guint
+fu_engine_install_peak_rss_kb(void)
+{
+	g_autofree gchar *buf = NULL;
+	g_auto(GStrv) lines = NULL;
+
+	if (!g_file_get_contents("/proc/self/status", &buf, NULL, NULL))
+		return 0;
+	lines = g_strsplit(buf, "\n", -1);
+	for (guint i = 0; lines[i] != NULL; i++) {
+		if (g_str_has_prefix(lines[i], "VmHWM:"))
+			return (guint)g_ascii_strtoull(lines[i] + 6, NULL, 10);
+	}
+	return 0;
+}
+#endif
+
+gboolean
+fu_engine_install_blob(FuEngine *self,
+		       FuDevice *device,
+		       GInputStream *stream_fw,
+		       FuProgress *progress,
+		       FwupdInstallFlags flags,
+		       FwupdFeatureFlags feature_flags,
+		       GError **error)
+{
+	guint retries = 0;
 	gsize streamsz = 0;
+	gint64 phase_started;
+#ifdef __linux__
+	guint rss_before_kb;
+	guint rss_peak_kb;
+#endif
 	g_autofree gchar *device_id = NULL;
 	g_autoptr(GTimer) timer = g_timer_new();
 	g_autoptr(FuDeviceProgress) device_progress = fu_device_progress_new(device, progress);
 
 	g_return_val_if_fail(device_progress != NULL, FALSE);
 
+	/* watch for anything materializing the whole image during the install */
+#ifdef __linux__
+	fu_engine_install_peak_rss_reset();
+	rss_before_kb = fu_engine_install_peak_rss_kb();
+#endif
+
 	/* progress */
 	fu_progress_set_id(progress, G_STRLOC);
 	fu_progress_add_flag(progress, FU_PROGRESS_FLAG_NO_PROFILE);
@@ -3474,9 +4238,13 @@ fu_engine_install_blob(FuEngine *self,
 
 	/* signal to all the plugins the update is about to happen */
 	device_id = g_strdup(fu_device_get_id(device));
+	phase_started = g_get_real_time();
 	fu_engine_set_install_phase(self, FU_ENGINE_INSTALL_PHASE_PREPARE);
-	if (!fu_engine_prepare(self, device_id, fu_progress_get_child(progress), flags, error))
+	if (!fu_engine_prepare(self, device_id, fu_progress_get_child(progress), flags, error)) {
+		fu_engine_add_phase_timing(self, device, flags, phase_started, FALSE);
 		return FALSE;
+	}
+	fu_engine_add_phase_timing(self, device, flags, phase_started, TRUE);
 	fu_progress_step_done(progress);
 
 	/* plugins can set FWUPD_DEVICE_FLAG_ANOTHER_WRITE_REQUIRED to run again, but they
@@ -3514,18 +4282,22 @@ fu_engine_install_blob(FuEngine *self,
 		}
 
 		/* detach to bootloader mode */
+		phase_started = g_get_real_time();
 		fu_engine_set_install_phase(self, FU_ENGINE_INSTALL_PHASE_DETACH);
 		if (!fu_engine_detach(self,
 				      device_id,
 				      fu_progress_get_child(progress_local),
 				      feature_flags,
 				      error)) {
+			fu_engine_add_phase_timing(self, device, flags, phase_started, FALSE);
 			g_prefix_error(error, "failed to detach: ");
 			return FALSE;
 		}
+		fu_engine_add_phase_timing(self, device, flags, phase_started, TRUE);
 		fu_progress_step_done(progress_local);
 
 		/* install */
+		phase_started = g_get_real_time();
 		fu_engine_set_install_phase(self, FU_ENGINE_INSTALL_PHASE_INSTALL);
 		if (!fu_engine_write_firmware(self,
 					      device_id,
@@ -3533,28 +4305,36 @@ fu_engine_install_blob(FuEngine *self,
 					      fu_progress_get_child(progress_local),
 					      flags,
 					      error)) {
+			fu_engine_add_phase_timing(self, device, flags, phase_started, FALSE);
 			g_prefix_error(error, "failed to write-firmware: ");
 			return FALSE;
 		}
+		fu_engine_add_phase_timing(self, device, flags, phase_started, TRUE);
 		fu_progress_step_done(progress_local);
 
 		/* attach into runtime mode */
+		phase_started = g_get_real_time();
 		fu_engine_set_install_phase(self, FU_ENGINE_INSTALL_PHASE_ATTACH);
 		if (!fu_engine_attach(self,
 				      device_id,
 				      fu_progress_get_child(progress_local),
 				      error)) {
+			fu_engine_add_phase_timing(self, device, flags, phase_started, FALSE);
 			g_prefix_error(error, "failed to attach: ");
 			return FALSE;
 		}
+		fu_engine_add_phase_timing(self, device, flags, phase_started, TRUE);
 		fu_progress_step_done(progress_local);
 
 		/* get the new version number */
+		phase_started = g_get_real_time();
 		fu_engine_set_install_phase(self, FU_ENGINE_INSTALL_PHASE_RELOAD);
 		if (!fu_engine_reload(self, device_id, error)) {
+			fu_engine_add_phase_timing(self, device, flags, phase_started, FALSE);
 			g_prefix_error(error, "failed to reload: ");
 			return FALSE;
 		}
+		fu_engine_add_phase_timing(self, device, flags, phase_started, TRUE);
 		fu_progress_step_done(progress_local);
 
 		/* the device and plugin both may have changed */
@@ -3576,6 +4356,29 @@ fu_engine_install_blob(FuEngine *self,
 	/* update history database */
 	fu_device_set_update_state(device, FWUPD_UPDATE_STATE_SUCCESS);
 	fu_device_set_install_duration(device, g_timer_elapsed(timer, NULL));
+	fu_engine_metric_inc(self, FU_ENGINE_METRIC_INSTALLS);
+	fu_engine_metric_add(self,
+			     FU_ENGINE_METRIC_INSTALL_DURATION_MS,
+			     (gint)(g_timer_elapsed(timer, NULL) * 1000.f));
+
+	/* regressions back towards buffering the whole payload should be visible */
+#ifdef __linux__
+	rss_peak_kb = fu_engine_install_peak_rss_kb();
+	if (rss_peak_kb > 0) {
+		g_info("peak RSS during install was %u kB for a %u kB payload",
+		       rss_peak_kb,
+		       (guint)(streamsz / 1024));
+		fu_engine_metric_max(self, FU_ENGINE_METRIC_INSTALL_PEAK_RSS_KB, (gint)rss_peak_kb);
+		if (rss_peak_kb > rss_before_kb &&
+		    ((guint64)(rss_peak_kb - rss_before_kb)) * 1024 >
+			streamsz + FU_ENGINE_INSTALL_RSS_SLACK) {
+			g_warning("install of a %u kB payload grew RSS by %u kB; "
+				  "something may be materializing the whole image",
+				  (guint)(streamsz / 1024),
+				  rss_peak_kb - rss_before_kb);
+		}
+	}
+#endif
 	if ((flags & FWUPD_INSTALL_FLAG_NO_HISTORY) == 0) {
 		if (!fu_history_modify_device(self->history, device, error)) {
 			g_prefix_error(error, "failed to set success: ");
@@ -3584,9 +4387,13 @@ fu_engine_install_blob(FuEngine *self,
 	}
 
 	/* signal to all the plugins the update has happened */
+	phase_started = g_get_real_time();
 	fu_engine_set_install_phase(self, FU_ENGINE_INSTALL_PHASE_CLEANUP);
-	if (!fu_engine_cleanup(self, device_id, fu_progress_get_child(progress), flags, error))
+	if (!fu_engine_cleanup(self, device_id, fu_progress_get_child(progress), flags, error)) {
+		fu_engine_add_phase_timing(self, device, flags, phase_started, FALSE);
 		return FALSE;
+	}
+	fu_engine_add_phase_timing(self, device, flags, phase_started, TRUE);
 	fu_progress_step_done(progress);
 
 	/* make the UI update */
@@ -3653,6 +4460,19 @@ fu_engine_get_item_by_id_fallback_history(FuEngine *self, const gchar *id, GErro
 	return NULL;
 }
 
+/* matches the sort order of fu_release_compare(): the explicit release priority wins,
+ * and only then does the remote priority break the tie */
+static gint64
+fu_engine_release_effective_priority(XbNode *component, XbNode *rel, gint remote_priority)
+{
+	guint64 release_priority = xb_node_get_attr_as_uint(rel, "priority");
+	if (release_priority == G_MAXUINT64)
+		release_priority = xb_node_get_attr_as_uint(component, "priority");
+	if (release_priority == G_MAXUINT64)
+		release_priority = 0;
+	return ((gint64)(release_priority & 0xFFFFFFFF) << 20) + (gint64)remote_priority;
+}
+
 static gboolean
 fu_engine_create_silo_index(FuEngine *self, GError **error)
 {
@@ -3661,6 +4481,8 @@ fu_engine_create_silo_index(FuEngine *self, GError **error)
 	g_autoptr(GError) error_container_checksum2 = NULL;
 	g_autoptr(GError) error_tag_by_guid_version = NULL;
 
+	fu_engine_metric_inc(self, FU_ENGINE_METRIC_SILO_REBUILDS);
+
 	/* print what we've got */
 	components = xb_silo_query(self->silo, "components/component[@type='firmware']", 0, NULL);
 	if (components == NULL)
@@ -3692,6 +4514,32 @@ fu_engine_create_silo_index(FuEngine *self, GError **error)
 				       error))
 		return FALSE;
 
+	/* index the container and artifact checksums so the per-release lookups are fast */
+	if (!xb_silo_query_build_index(self->silo,
+				       "components/component[@type='firmware']/releases/release/"
+				       "checksum",
+				       "target",
+				       error))
+		return FALSE;
+	if (!xb_silo_query_build_index(self->silo,
+				       "components/component[@type='firmware']/releases/release/"
+				       "checksum",
+				       NULL,
+				       error))
+		return FALSE;
+	if (!xb_silo_query_build_index(self->silo,
+				       "components/component[@type='firmware']/releases/release/"
+				       "artifacts/artifact",
+				       "type",
+				       error))
+		return FALSE;
+	if (!xb_silo_query_build_index(self->silo,
+				       "components/component[@type='firmware']/releases/release/"
+				       "artifacts/artifact[@type='binary']/checksum",
+				       NULL,
+				       error))
+		return FALSE;
+
 	/* create prepared queries to save time later */
 	self->query_component_by_guid =
 	    xb_query_new_full(self->silo,
@@ -3734,6 +4582,82 @@ fu_engine_create_silo_index(FuEngine *self, GError **error)
 	if (self->query_tag_by_guid_version == NULL)
 		g_debug("ignoring prepared query: %s", error_tag_by_guid_version->message);
 
+	/* build a checksum-keyed index of the best effective priority so that duplicate
+	 * releases from overlapping remotes can be skipped with a single hash lookup */
+	if (self->release_csum_priority == NULL) {
+		self->release_csum_priority =
+		    g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+	} else {
+		g_hash_table_remove_all(self->release_csum_priority);
+	}
+	for (guint i = 0; i < components->len; i++) {
+		XbNode *component = g_ptr_array_index(components, i);
+		gint remote_priority = 0;
+		const gchar *remote_id =
+		    xb_node_query_text(component, "custom/value[@key='fwupd::RemoteId']", NULL);
+		g_autoptr(GPtrArray) rels = NULL;
+
+		if (remote_id != NULL) {
+			FwupdRemote *remote =
+			    fu_remote_list_get_by_id(self->remote_list, remote_id);
+			if (remote != NULL)
+				remote_priority = fwupd_remote_get_priority(remote);
+		}
+		rels = xb_node_query(component, "releases/release", 0, NULL);
+		if (rels == NULL)
+			continue;
+		for (guint j = 0; j < rels->len; j++) {
+			XbNode *rel = g_ptr_array_index(rels, j);
+			const gchar *csum_str;
+			gint64 priority;
+			gint64 *priority_tmp;
+
+			csum_str = xb_node_query_text(rel, "checksum[@target='container']", NULL);
+			if (csum_str == NULL) {
+				csum_str = xb_node_query_text(
+				    rel,
+				    "artifacts/artifact[@type='binary']/checksum",
+				    NULL);
+			}
+			if (csum_str == NULL)
+				continue;
+			priority = fu_engine_release_effective_priority(component,
+									rel,
+									remote_priority);
+			priority_tmp =
+			    g_hash_table_lookup(self->release_csum_priority, csum_str);
+			if (priority_tmp != NULL && *priority_tmp >= priority)
+				continue;
+			priority_tmp = g_new0(gint64, 1);
+			*priority_tmp = priority;
+			g_hash_table_insert(self->release_csum_priority,
+					    g_strdup(csum_str),
+					    priority_tmp);
+		}
+	}
+
+	/* warm the hardware requirement cache so that filtering the whole silo on the first
+	 * get-upgrades call after a metadata refresh is hash lookups alone -- the verdicts
+	 * survive silo rebuilds as the system HWIDs cannot change while we are running */
+	if (fu_context_has_flag(self->ctx, FU_CONTEXT_FLAG_LOADED_HWINFO)) {
+		const gchar *xpaths[] = {
+		    "components/component[@type='firmware']/requires/hardware",
+		    "components/component[@type='firmware']/requires/not_hardware",
+		};
+		for (guint i = 0; i < G_N_ELEMENTS(xpaths); i++) {
+			g_autoptr(GPtrArray) reqs = xb_silo_query(self->silo, xpaths[i], 0, NULL);
+			if (reqs == NULL)
+				continue;
+			for (guint j = 0; j < reqs->len; j++) {
+				XbNode *req = g_ptr_array_index(reqs, j);
+				if (xb_node_get_text(req) != NULL)
+					fu_engine_has_hwid_guids(self, xb_node_get_text(req));
+			}
+		}
+		g_debug("%u unique hardware requirements precomputed",
+			g_hash_table_size(self->hwid_req_cache));
+	}
+
 	/* success */
 	return TRUE;
 }
@@ -3812,6 +4736,34 @@ fu_engine_create_metadata_builder_source(FuEngine *self, const gchar *fn, GError
 	return g_steal_pointer(&source);
 }
 
+static gchar *
+fu_engine_create_metadata_checksum_tree(const gchar *fn, GError **error)
+{
+	gsize streamsz = 0;
+	g_autoptr(GInputStream) stream = NULL;
+	g_autoptr(GString) str = NULL;
+
+	stream = fu_input_stream_from_path(fn, error);
+	if (stream == NULL)
+		return NULL;
+	if (!fu_input_stream_size(stream, &streamsz, error))
+		return NULL;
+	str = g_string_new(NULL);
+	g_string_append_printf(str, "%u", (guint)FU_ENGINE_METADATA_CHECKSUM_BLOCK_SIZE);
+	for (gsize offset = 0; offset < streamsz;
+	     offset += FU_ENGINE_METADATA_CHECKSUM_BLOCK_SIZE) {
+		gsize count = MIN(FU_ENGINE_METADATA_CHECKSUM_BLOCK_SIZE, streamsz - offset);
+		g_autofree gchar *checksum = NULL;
+		g_autoptr(GBytes) blob = NULL;
+		blob = fu_input_stream_read_bytes(stream, offset, count, NULL, error);
+		if (blob == NULL)
+			return NULL;
+		checksum = g_compute_checksum_for_bytes(G_CHECKSUM_SHA256, blob);
+		g_string_append_printf(str, ",%s", checksum);
+	}
+	return g_string_free(g_steal_pointer(&str), FALSE);
+}
+
 static gboolean
 fu_engine_create_metadata(FuEngine *self, XbBuilder *builder, FwupdRemote *remote, GError **error)
 {
@@ -3839,6 +4791,7 @@ fu_engine_create_metadata(FuEngine *self, XbBuilder *builder, FwupdRemote *remot
 		g_autoptr(GError) error_local = NULL;
 		const gchar *fn = g_ptr_array_index(files, i);
 		g_autofree gchar *fn_lowercase = g_ascii_strdown(fn, -1);
+		g_autofree gchar *checksum_tree = NULL;
 
 		/* check is cab file */
 		if (!g_str_has_suffix(fn_lowercase, ".cab")) {
@@ -3853,6 +4806,11 @@ fu_engine_create_metadata(FuEngine *self, XbBuilder *builder, FwupdRemote *remot
 			continue;
 		}
 
+		/* block checksums allow verifying sections of the download */
+		checksum_tree = fu_engine_create_metadata_checksum_tree(fn, &error_local);
+		if (checksum_tree == NULL)
+			g_warning("failed to create checksum tree: %s", error_local->message);
+
 		/* add metadata */
 		custom = xb_builder_node_new("custom");
 		xb_builder_node_insert_text(custom,
@@ -3867,6 +4825,14 @@ fu_engine_create_metadata(FuEngine *self, XbBuilder *builder, FwupdRemote *remot
 					    "key",
 					    "fwupd::RemoteId",
 					    NULL);
+		if (checksum_tree != NULL) {
+			xb_builder_node_insert_text(custom,
+						    "value",
+						    checksum_tree,
+						    "key",
+						    "fwupd::ChecksumTree",
+						    NULL);
+		}
 		xb_builder_source_set_info(source, custom);
 		xb_builder_import_source(builder, source);
 	}
@@ -3931,13 +4897,56 @@ fu_engine_ensure_device_supported(FuEngine *self, FuDevice *device)
 	}
 }
 
+/* walk the silo once, mapping each flashed provide GUID to the first component in document
+ * order -- which matches what fu_engine_get_component_by_guid() would have returned */
+static GHashTable *
+fu_engine_build_component_by_guid_map(FuEngine *self)
+{
+	g_autoptr(GHashTable) components_by_guid =
+	    g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_object_unref);
+	g_autoptr(GPtrArray) components = NULL;
+
+	components = xb_silo_query(self->silo, "components/component", 0, NULL);
+	if (components == NULL)
+		return g_steal_pointer(&components_by_guid);
+	for (guint i = 0; i < components->len; i++) {
+		XbNode *component = g_ptr_array_index(components, i);
+		g_autoptr(GPtrArray) provides = NULL;
+
+		provides = xb_node_query(component, "provides/firmware[@type='flashed']", 0, NULL);
+		if (provides == NULL)
+			continue;
+		for (guint j = 0; j < provides->len; j++) {
+			XbNode *provide = g_ptr_array_index(provides, j);
+			const gchar *guid = xb_node_get_text(provide);
+			if (guid == NULL || g_hash_table_contains(components_by_guid, guid))
+				continue;
+			g_hash_table_insert(components_by_guid,
+					    g_strdup(guid),
+					    g_object_ref(component));
+		}
+	}
+	return g_steal_pointer(&components_by_guid);
+}
+
 static void
 fu_engine_md_refresh_devices(FuEngine *self)
 {
 	g_autoptr(GPtrArray) devices = fu_device_list_get_active(self->device_list);
+	g_autoptr(GHashTable) components_by_guid = fu_engine_build_component_by_guid_map(self);
 	for (guint i = 0; i < devices->len; i++) {
 		FuDevice *device = g_ptr_array_index(devices, i);
-		g_autoptr(XbNode) component = fu_engine_get_component_by_guids(self, device);
+		GPtrArray *guids = fu_device_get_guids(device);
+		XbNode *component = NULL;
+
+		/* the same lookup fu_engine_get_component_by_guids() would do, without issuing
+		 * an XPath query per device per GUID */
+		for (guint j = 0; j < guids->len; j++) {
+			component =
+			    g_hash_table_lookup(components_by_guid, g_ptr_array_index(guids, j));
+			if (component != NULL)
+				break;
+		}
 
 		/* set or clear the SUPPORTED flag */
 		fu_engine_ensure_device_supported(self, device);
@@ -3984,17 +4993,90 @@ fu_engine_load_metadata_store_local(FuEngine *self,
 	return TRUE;
 }
 
-static gboolean
-fu_engine_load_metadata_store(FuEngine *self, FuEngineLoadFlags flags, GError **error)
+/* a stable fingerprint of everything that feeds the metadata silo, or %NULL when the
+ * inputs cannot be fingerprinted cheaply and the builder has to run */
+static gchar *
+fu_engine_metadata_silo_build_key(FuEngine *self)
+{
+	GPtrArray *remotes = fu_remote_list_get_all(self->remote_list);
+	FuPathKind path_kinds[] = {FU_PATH_KIND_LOCALSTATEDIR_PKG, FU_PATH_KIND_DATADIR_PKG};
+	g_autoptr(GString) str = g_string_new(NULL);
+
+#ifdef SOURCE_VERSION
+	g_string_append_printf(str, "version=%s\n", SOURCE_VERSION);
+#endif
+	for (guint i = 0; i < remotes->len; i++) {
+		FwupdRemote *remote = g_ptr_array_index(remotes, i);
+		const gchar *csum;
+		const gchar *path;
+
+		if (!fwupd_remote_has_flag(remote, FWUPD_REMOTE_FLAG_ENABLED))
+			continue;
+
+		/* generated on demand, nothing to key on */
+		if (fwupd_remote_get_kind(remote) == FWUPD_REMOTE_KIND_DIRECTORY)
+			return NULL;
+		path = fwupd_remote_get_filename_cache(remote);
+		if (!g_file_test(path, G_FILE_TEST_EXISTS))
+			continue;
+		csum = fwupd_remote_get_checksum_metadata(remote);
+		if (csum != NULL) {
+			g_string_append_printf(str,
+					       "%s=%s\n",
+					       fwupd_remote_get_id(remote),
+					       csum);
+		} else {
+			GStatBuf statbuf = {0};
+			if (g_stat(path, &statbuf) != 0)
+				return NULL;
+			g_string_append_printf(str,
+					       "%s=%" G_GINT64_FORMAT ",%" G_GINT64_FORMAT "\n",
+					       fwupd_remote_get_id(remote),
+					       (gint64)statbuf.st_mtime,
+					       (gint64)statbuf.st_size);
+		}
+	}
+
+	/* client-side data also compiled into the silo */
+	for (guint i = 0; i < G_N_ELEMENTS(path_kinds); i++) {
+		g_autofree gchar *fn = fu_path_from_kind(path_kinds[i]);
+		g_autofree gchar *metadata_path = g_build_filename(fn, "local.d", NULL);
+		g_autoptr(GPtrArray) metadata_fns = fu_path_glob(metadata_path, "*.xml", NULL);
+
+		if (metadata_fns == NULL)
+			continue;
+		for (guint j = 0; j < metadata_fns->len; j++) {
+			const gchar *path = g_ptr_array_index(metadata_fns, j);
+			GStatBuf statbuf = {0};
+			if (g_stat(path, &statbuf) != 0)
+				return NULL;
+			g_string_append_printf(str,
+					       "%s=%" G_GINT64_FORMAT ",%" G_GINT64_FORMAT "\n",
+					       path,
+					       (gint64)statbuf.st_mtime,
+					       (gint64)statbuf.st_size);
+		}
+	}
+	return g_string_free(g_steal_pointer(&str), FALSE);
+}
+
+static gchar *
+fu_engine_metadata_silo_get_key_path(void)
+{
+	g_autofree gchar *cachedirpkg = fu_path_from_kind(FU_PATH_KIND_CACHEDIR_PKG);
+	return g_build_filename(cachedirpkg, "metadata.xmlb.key", NULL);
+}
+
+static XbBuilder *
+fu_engine_metadata_builder_new(FuEngine *self,
+			       FuEngineLoadFlags flags,
+			       GFile **xmlb_out,
+			       GError **error)
 {
 	GPtrArray *remotes;
-	XbBuilderCompileFlags compile_flags = XB_BUILDER_COMPILE_FLAG_IGNORE_INVALID;
 	g_autoptr(GFile) xmlb = NULL;
 	g_autoptr(XbBuilder) builder = xb_builder_new();
 
-	/* clear existing silo */
-	g_clear_object(&self->silo);
-
 #ifdef SOURCE_VERSION
 	/* invalidate the cache if the fwupd version changes */
 	xb_builder_append_guid(builder, SOURCE_VERSION);
@@ -4081,35 +5163,106 @@ fu_engine_load_metadata_store(FuEngine *self, FuEngineLoadFlags flags, GError **
 						 builder,
 						 FU_PATH_KIND_LOCALSTATEDIR_PKG,
 						 error))
-		return FALSE;
+		return NULL;
 	if (!fu_engine_load_metadata_store_local(self, builder, FU_PATH_KIND_DATADIR_PKG, error))
-		return FALSE;
-
-	/* on a read-only filesystem don't care about the cache GUID */
-	if (flags & FU_ENGINE_LOAD_FLAG_READONLY)
-		compile_flags |= XB_BUILDER_COMPILE_FLAG_IGNORE_GUID;
+		return NULL;
 
-	/* ensure silo is up to date */
+	/* where the compiled blob is cached */
 	if (flags & FU_ENGINE_LOAD_FLAG_NO_CACHE) {
 		g_autoptr(GFileIOStream) iostr = NULL;
 		xmlb = g_file_new_tmp(NULL, &iostr, error);
 		if (xmlb == NULL)
-			return FALSE;
+			return NULL;
 	} else {
 		g_autofree gchar *cachedirpkg = fu_path_from_kind(FU_PATH_KIND_CACHEDIR_PKG);
 		g_autofree gchar *xmlbfn = g_build_filename(cachedirpkg, "metadata.xmlb", NULL);
 		xmlb = g_file_new_for_path(xmlbfn);
 	}
+
+	/* success */
+	*xmlb_out = g_steal_pointer(&xmlb);
+	return g_steal_pointer(&builder);
+}
+
+static gboolean
+fu_engine_load_metadata_store(FuEngine *self, FuEngineLoadFlags flags, GError **error)
+{
+	XbBuilderCompileFlags compile_flags = XB_BUILDER_COMPILE_FLAG_IGNORE_INVALID;
+	g_autofree gchar *silo_key = NULL;
+	g_autofree gchar *silo_key_fn = NULL;
+	g_autoptr(GFile) xmlb = NULL;
+	g_autoptr(XbBuilder) builder = NULL;
+
+	/* clear existing silo */
+	g_clear_object(&self->silo);
+
+	/* fast path: map the compiled blob from the last run when the remote checksums
+	 * have not changed, skipping the per-source scan done by the builder */
+	if ((flags & FU_ENGINE_LOAD_FLAG_NO_CACHE) == 0 &&
+	    g_getenv("FWUPD_XMLB_VERBOSE") == NULL) {
+		silo_key = fu_engine_metadata_silo_build_key(self);
+		silo_key_fn = fu_engine_metadata_silo_get_key_path();
+	}
+	if (silo_key != NULL) {
+		g_autofree gchar *silo_key_old = NULL;
+		g_file_get_contents(silo_key_fn, &silo_key_old, NULL, NULL);
+		if (g_strcmp0(silo_key, silo_key_old) == 0) {
+			g_autofree gchar *cachedirpkg = fu_path_from_kind(FU_PATH_KIND_CACHEDIR_PKG);
+			g_autofree gchar *xmlbfn =
+			    g_build_filename(cachedirpkg, "metadata.xmlb", NULL);
+			g_autoptr(GFile) xmlb_file = g_file_new_for_path(xmlbfn);
+			g_autoptr(GError) error_local = NULL;
+			g_autoptr(XbSilo) silo = xb_silo_new();
+			if (xb_silo_load_from_file(silo,
+						   xmlb_file,
+						   XB_SILO_LOAD_FLAG_NONE,
+						   NULL,
+						   &error_local)) {
+				g_debug("mapped compiled metadata, skipping rebuild");
+				self->silo = g_steal_pointer(&silo);
+				return fu_engine_create_silo_index(self, error);
+			}
+			g_debug("cannot reuse compiled metadata: %s", error_local->message);
+		}
+	}
+
+	builder = fu_engine_metadata_builder_new(self, flags, &xmlb, error);
+	if (builder == NULL)
+		return FALSE;
+
+	/* on a read-only filesystem don't care about the cache GUID */
+	if (flags & FU_ENGINE_LOAD_FLAG_READONLY)
+		compile_flags |= XB_BUILDER_COMPILE_FLAG_IGNORE_GUID;
+
+	/* ensure silo is up to date */
 	self->silo = xb_builder_ensure(builder, xmlb, compile_flags, NULL, error);
 	if (self->silo == NULL) {
 		g_prefix_error(error, "cannot create metadata.xmlb: ");
 		return FALSE;
 	}
 
+	/* remember what went into the blob for next time */
+	if (silo_key != NULL) {
+		g_autoptr(GError) error_local = NULL;
+		if (!g_file_set_contents(silo_key_fn, silo_key, -1, &error_local))
+			g_debug("failed to save silo key: %s", error_local->message);
+	}
+
 	/* success */
 	return fu_engine_create_silo_index(self, error);
 }
 
+/* the silo may have been dropped to save memory when idle; the compiled blob is still on
+ * disk so reloading it is just a mmap and re-preparing the queries */
+static gboolean
+fu_engine_ensure_silo(FuEngine *self, GError **error)
+{
+	if (self->silo != NULL)
+		return TRUE;
+	g_debug("lazily reloading metadata silo");
+	return fu_engine_load_metadata_store(self, FU_ENGINE_LOAD_FLAG_NONE, error);
+}
+
 static void
 fu_engine_remote_list_ensure_p2p_policy_remote(FuEngine *self, FwupdRemote *remote)
 {
@@ -4126,12 +5279,89 @@ fu_engine_remote_list_ensure_p2p_policy_remote(FuEngine *self, FwupdRemote *remo
 	}
 }
 
+static gboolean
+fu_engine_verify_scrub_cb(gpointer user_data);
+
+static void
+fu_engine_ensure_verify_scrub(FuEngine *self)
+{
+	guint64 interval = fu_engine_config_get_verify_scrub_interval(self->config);
+	guint delay;
+	guint cnt_devices = 0;
+	g_autoptr(GPtrArray) devices = NULL;
+
+	if (self->verify_scrub_id != 0) {
+		g_source_remove(self->verify_scrub_id);
+		self->verify_scrub_id = 0;
+	}
+	if (!self->verify_scrub_allowed || interval == 0)
+		return;
+
+	/* one device at a time, spread over the whole configured period */
+	devices = fu_engine_get_devices(self, NULL);
+	if (devices != NULL)
+		cnt_devices = devices->len;
+	delay = (guint)MAX(interval / MAX(cnt_devices, 1), FU_ENGINE_VERIFY_SCRUB_DELAY_MIN);
+	self->verify_scrub_id = g_timeout_add_seconds(delay, fu_engine_verify_scrub_cb, self);
+}
+
+static gboolean
+fu_engine_verify_scrub_cb(gpointer user_data)
+{
+	FuEngine *self = FU_ENGINE(user_data);
+	g_autoptr(GPtrArray) devices = NULL;
+
+	self->verify_scrub_id = 0;
+
+	/* never compete with a real operation */
+	if (fu_idle_has_inhibit(self->idle, FU_IDLE_INHIBIT_TIMEOUT)) {
+		g_debug("daemon busy, skipping verify scrub");
+		fu_engine_ensure_verify_scrub(self);
+		return G_SOURCE_REMOVE;
+	}
+
+	/* round-robin over devices that can be verified */
+	devices = fu_engine_get_devices(self, NULL);
+	if (devices != NULL) {
+		for (guint i = 0; i < devices->len; i++) {
+			guint idx = (self->verify_scrub_idx + i) % devices->len;
+			FuDevice *device = g_ptr_array_index(devices, idx);
+			g_autoptr(FuProgress) progress = fu_progress_new(G_STRLOC);
+			g_autoptr(GError) error_local = NULL;
+			if (!fu_device_has_flag(device, FWUPD_DEVICE_FLAG_CAN_VERIFY))
+				continue;
+			self->verify_scrub_idx = idx + 1;
+			if (!fu_engine_verify(self,
+					      fu_device_get_id(device),
+					      progress,
+					      &error_local)) {
+				g_warning("verify scrub of %s failed: %s",
+					  fu_device_get_id(device),
+					  error_local->message);
+			} else {
+				g_debug("verify scrub of %s succeeded",
+					fu_device_get_id(device));
+			}
+			break;
+		}
+	}
+
+	/* reschedule with the current device count and interval */
+	fu_engine_ensure_verify_scrub(self);
+	return G_SOURCE_REMOVE;
+}
+
 static void
 fu_engine_config_changed_cb(FuEngineConfig *config, FuEngine *self)
 {
 	GPtrArray *remotes = fu_remote_list_get_all(self->remote_list);
 
 	fu_idle_set_timeout(self->idle, fu_engine_config_get_idle_timeout(config));
+	fu_idle_set_timeout_trim(self->idle, fu_engine_config_get_idle_trim_timeout(config));
+	fu_engine_ensure_verify_scrub(self);
+
+	/* the TrustedReports policy may be different now */
+	g_hash_table_remove_all(self->report_trusted_cache);
 
 	/* allow changing the hardcoded ESP location */
 	if (fu_engine_config_get_esp_location(config) != NULL)
@@ -4144,23 +5374,125 @@ fu_engine_config_changed_cb(FuEngineConfig *config, FuEngine *self)
 	}
 }
 
+typedef struct {
+	XbBuilder *builder;
+	GFile *xmlb;
+	guint generation;
+} FuEngineSiloRebuildHelper;
+
 static void
-fu_engine_metadata_changed(FuEngine *self)
+fu_engine_silo_rebuild_helper_free(FuEngineSiloRebuildHelper *helper)
+{
+	g_object_unref(helper->builder);
+	g_object_unref(helper->xmlb);
+	g_free(helper);
+}
+
+static void
+fu_engine_silo_rebuild_thread_cb(GTask *task,
+				 gpointer source_object,
+				 gpointer task_data,
+				 GCancellable *cancellable)
 {
+	FuEngineSiloRebuildHelper *helper = (FuEngineSiloRebuildHelper *)task_data;
 	g_autoptr(GError) error_local = NULL;
-	if (!fu_engine_load_metadata_store(self, FU_ENGINE_LOAD_FLAG_NONE, &error_local))
-		g_warning("Failed to reload metadata store: %s", error_local->message);
+	g_autoptr(XbSilo) silo = NULL;
+
+	/* the compile checks the cancellable as it goes, so a superseded rebuild is
+	 * abandoned early rather than finishing and being thrown away */
+	silo = xb_builder_ensure(helper->builder,
+				 helper->xmlb,
+				 XB_BUILDER_COMPILE_FLAG_IGNORE_INVALID,
+				 cancellable,
+				 &error_local);
+	if (silo == NULL) {
+		g_task_return_error(task, g_steal_pointer(&error_local));
+		return;
+	}
+	g_task_return_pointer(task, g_steal_pointer(&silo), (GDestroyNotify)g_object_unref);
+}
+
+static void
+fu_engine_silo_rebuild_done_cb(GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+	FuEngine *self = FU_ENGINE(source_object);
+	FuEngineSiloRebuildHelper *helper = g_task_get_task_data(G_TASK(res));
+	g_autoptr(GError) error_local = NULL;
+	g_autoptr(XbSilo) silo = g_task_propagate_pointer(G_TASK(res), &error_local);
+
+	if (silo == NULL) {
+		if (g_error_matches(error_local, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+			g_debug("silo rebuild was superseded, ignoring");
+		} else {
+			g_warning("Failed to reload metadata store: %s", error_local->message);
+		}
+		return;
+	}
+
+	/* a newer refresh was scheduled after this compile had already started */
+	if (helper->generation != self->silo_rebuild_generation) {
+		g_debug("silo rebuild generation %u is stale, ignoring", helper->generation);
+		return;
+	}
+
+	/* swap in the new silo */
+	g_set_object(&self->silo, silo);
+	if (!fu_engine_create_silo_index(self, &error_local)) {
+		g_warning("failed to create silo index: %s", error_local->message);
+		return;
+	}
 
 	/* set device properties from the metadata */
 	fu_engine_md_refresh_devices(self);
 
 	/* invalidate host security attributes */
 	g_clear_pointer(&self->host_security_id, g_free);
+	g_clear_object(&self->host_security_attrs_devices);
+	g_clear_object(&self->host_security_attrs_plugins);
+
+	/* keep the report trust verdicts bounded to one metadata generation */
+	g_hash_table_remove_all(self->report_trusted_cache);
 
 	/* make the UI update */
 	fu_engine_emit_changed(self);
 }
 
+static void
+fu_engine_metadata_changed(FuEngine *self)
+{
+	FuEngineSiloRebuildHelper *helper;
+	g_autoptr(GError) error_local = NULL;
+	g_autoptr(GFile) xmlb = NULL;
+	g_autoptr(GTask) task = NULL;
+	g_autoptr(XbBuilder) builder = NULL;
+
+	/* any rebuild already in flight would produce a stale silo, so abandon it */
+	if (self->silo_rebuild_cancellable != NULL)
+		g_cancellable_cancel(self->silo_rebuild_cancellable);
+	g_clear_object(&self->silo_rebuild_cancellable);
+	self->silo_rebuild_cancellable = g_cancellable_new();
+	self->silo_rebuild_generation++;
+
+	/* importing the sources is just a mmap and is done here in the main loop, but the
+	 * expensive compile runs in a worker thread so that D-Bus calls are still answered */
+	builder =
+	    fu_engine_metadata_builder_new(self, FU_ENGINE_LOAD_FLAG_NONE, &xmlb, &error_local);
+	if (builder == NULL) {
+		g_warning("Failed to reload metadata store: %s", error_local->message);
+		return;
+	}
+	helper = g_new0(FuEngineSiloRebuildHelper, 1);
+	helper->builder = g_object_ref(builder);
+	helper->xmlb = g_object_ref(xmlb);
+	helper->generation = self->silo_rebuild_generation;
+	task = g_task_new(self,
+			  self->silo_rebuild_cancellable,
+			  fu_engine_silo_rebuild_done_cb,
+			  NULL);
+	g_task_set_task_data(task, helper, (GDestroyNotify)fu_engine_silo_rebuild_helper_free);
+	g_task_run_in_thread(task, fu_engine_silo_rebuild_thread_cb);
+}
+
 static void
 fu_engine_remote_list_changed_cb(FuRemoteList *remote_list, FuEngine *self)
 {
@@ -4413,17 +5745,11 @@ fu_engine_update_metadata_bytes(FuEngine *self,
 	/* save signature to remotes.d */
 	if (!fu_bytes_set_contents(fwupd_remote_get_filename_cache_sig(remote), bytes_sig, error))
 		return FALSE;
-	if (!fu_engine_load_metadata_store(self, FU_ENGINE_LOAD_FLAG_NONE, error))
-		return FALSE;
-
-	/* refresh SUPPORTED flag on devices */
-	fu_engine_md_refresh_devices(self);
 
-	/* invalidate host security attributes */
-	g_clear_pointer(&self->host_security_id, g_free);
-
-	/* make the UI update */
-	fu_engine_emit_changed(self);
+	/* rebuild the silo on a worker thread so the D-Bus reply is not delayed by the
+	 * compile; the old silo keeps answering queries until the new one is swapped in
+	 * and ::Changed is emitted */
+	fu_engine_metadata_changed(self);
 	return TRUE;
 }
 
@@ -4495,28 +5821,84 @@ fu_engine_update_metadata(FuEngine *self,
  *
  * Creates a silo from a .cab file blob.
  *
+ * Archives that have already been verified and parsed by this daemon instance are returned
+ * from an in-memory cache keyed by the archive SHA256, which means re-installing the same
+ * file skips the Jcat verification and silo build entirely.
+ *
  * Returns: (transfer container): a #XbSilo, or %NULL
  **/
 FuCabinet *
 fu_engine_build_cabinet_from_stream(FuEngine *self, GInputStream *stream, GError **error)
 {
+	return fu_engine_build_cabinet_from_stream_full(self, stream, FALSE, error);
+}
+
+/**
+ * fu_engine_build_cabinet_from_stream_full:
+ * @self: a #FuEngine
+ * @stream: a #GInputStream
+ * @only_metadata: if %TRUE, only parse the metainfo and metadata members
+ * @error: (nullable): optional return location for an error
+ *
+ * Creates a silo from a .cab file blob, optionally without reading any of the firmware
+ * payload members -- which keeps the peak memory usage independent of the archive size,
+ * but means the payload checksums are never verified and the result must not be used
+ * to actually install firmware.
+ *
+ * Returns: (transfer container): a #XbSilo, or %NULL
+ **/
+FuCabinet *
+fu_engine_build_cabinet_from_stream_full(FuEngine *self,
+					 GInputStream *stream,
+					 gboolean only_metadata,
+					 GError **error)
+{
+	FuCabinet *cabinet_cached;
+	g_autofree gchar *checksum = NULL;
 	g_autoptr(FuCabinet) cabinet = fu_cabinet_new();
+	g_autoptr(GError) error_local = NULL;
 
 	g_return_val_if_fail(FU_IS_ENGINE(self), NULL);
 	g_return_val_if_fail(G_IS_INPUT_STREAM(stream), NULL);
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
+	/* already verified this archive? a fully-parsed cabinet is a superset of the
+	 * metadata-only result so the cache is safe to use for both */
+	checksum = fu_engine_compute_stream_checksum(self, stream, G_CHECKSUM_SHA256, &error_local);
+	if (checksum == NULL) {
+		g_debug("failed to get archive checksum: %s", error_local->message);
+	} else {
+		cabinet_cached = g_hash_table_lookup(self->cabinet_cache, checksum);
+		if (cabinet_cached != NULL) {
+			self->cabinet_cache_hits++;
+			g_debug("using cached cabinet for %s", checksum);
+			return g_object_ref(cabinet_cached);
+		}
+		self->cabinet_cache_misses++;
+	}
+
 	/* load file */
 	fu_engine_set_status(self, FWUPD_STATUS_DECOMPRESSING);
 	fu_firmware_set_size_max(FU_FIRMWARE(cabinet),
 				 fu_engine_config_get_archive_size_max(self->config));
 	fu_cabinet_set_jcat_context(cabinet, self->jcat_context);
+	fu_cabinet_set_only_metadata(cabinet, only_metadata);
 	if (!fu_firmware_parse_stream(FU_FIRMWARE(cabinet),
 				      stream,
 				      0x0,
 				      FWUPD_INSTALL_FLAG_NONE,
 				      error))
 		return NULL;
+
+	/* the cabinet holds the payload, so keep only the last few archives; never cache
+	 * metadata-only cabinets as they could be returned to an install request */
+	if (checksum != NULL && !only_metadata) {
+		if (g_hash_table_size(self->cabinet_cache) >= FU_ENGINE_CABINET_CACHE_MAX_ITEMS)
+			g_hash_table_remove_all(self->cabinet_cache);
+		g_hash_table_insert(self->cabinet_cache,
+				    g_strdup(checksum),
+				    g_object_ref(cabinet));
+	}
 	return g_steal_pointer(&cabinet);
 }
 
@@ -4657,9 +6039,10 @@ fu_engine_get_details(FuEngine *self,
 		      GError **error)
 {
 	GChecksumType checksum_types[] = {G_CHECKSUM_SHA256, G_CHECKSUM_SHA1, 0};
+	gsize streamsz = 0;
 	g_autoptr(GPtrArray) components = NULL;
 	g_autoptr(GPtrArray) details = NULL;
-	g_autoptr(GPtrArray) checksums = g_ptr_array_new_with_free_func(g_free);
+	g_autoptr(GPtrArray) checksums = NULL;
 	g_autoptr(FuCabinet) cabinet = NULL;
 	g_autoptr(XbNode) rel_by_csum = NULL;
 
@@ -4667,7 +6050,15 @@ fu_engine_get_details(FuEngine *self,
 	g_return_val_if_fail(G_IS_INPUT_STREAM(stream), NULL);
 	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
-	cabinet = fu_engine_build_cabinet_from_stream(self, stream, error);
+	/* count the archive against the per-request memory budget */
+	if (!fu_input_stream_size(stream, &streamsz, error))
+		return NULL;
+	if (!fu_engine_request_reserve_memory(request, "archive", streamsz, error))
+		return NULL;
+
+	/* getting details never installs anything, so the payload members do not have to be
+	 * read or verified -- keeping the peak memory independent of the archive size */
+	cabinet = fu_engine_build_cabinet_from_stream_full(self, stream, TRUE, error);
 	if (cabinet == NULL) {
 		g_prefix_error(error, "failed to load file: ");
 		return NULL;
@@ -4676,14 +6067,10 @@ fu_engine_get_details(FuEngine *self,
 	if (components == NULL)
 		return NULL;
 
-	/* calculate the checksums of the blob */
-	for (guint i = 0; checksum_types[i] != 0; i++) {
-		g_autofree gchar *checksum =
-		    fu_input_stream_compute_checksum(stream, checksum_types[i], error);
-		if (checksum == NULL)
-			return NULL;
-		g_ptr_array_add(checksums, g_steal_pointer(&checksum));
-	}
+	/* calculate the checksums of the blob in a single pass */
+	checksums = fu_engine_compute_stream_checksums(self, stream, checksum_types, error);
+	if (checksums == NULL)
+		return NULL;
 
 	/* does this exist in any enabled remote */
 	for (guint i = 0; i < checksums->len; i++) {
@@ -4967,6 +6354,34 @@ fu_engine_get_history(FuEngine *self, GError **error)
 		fu_engine_fixup_history_device(self, dev);
 	}
 
+	/* export the per-phase durations of the last update as release metadata */
+	for (guint i = 0; i < devices->len; i++) {
+		FuDevice *dev = g_ptr_array_index(devices, i);
+		FwupdRelease *rel = fu_device_get_release_default(dev);
+		GHashTableIter iter;
+		gpointer key;
+		gpointer value;
+		g_autoptr(GError) error_local = NULL;
+		g_autoptr(GHashTable) timings = NULL;
+
+		if (rel == NULL)
+			continue;
+		timings =
+		    fu_history_get_timings(self->history, fu_device_get_id(dev), &error_local);
+		if (timings == NULL) {
+			g_debug("failed to get timings: %s", error_local->message);
+			continue;
+		}
+		g_hash_table_iter_init(&iter, timings);
+		while (g_hash_table_iter_next(&iter, &key, &value)) {
+			g_autofree gchar *metadata_key =
+			    g_strdup_printf("PhaseDuration(%s)", (const gchar *)key);
+			fwupd_release_add_metadata_item(rel,
+							metadata_key,
+							(const gchar *)value);
+		}
+	}
+
 	return g_steal_pointer(&devices);
 }
 
@@ -5090,6 +6505,7 @@ fu_engine_add_releases_for_device_component(FuEngine *self,
 {
 	FwupdFeatureFlags feature_flags;
 	FwupdVersionFormat fmt = fu_device_get_version_format(device);
+	gint remote_priority = 0;
 	g_autoptr(GError) error_local = NULL;
 	g_autoptr(GPtrArray) releases_tmp = NULL;
 	FwupdInstallFlags install_flags =
@@ -5106,6 +6522,19 @@ fu_engine_add_releases_for_device_component(FuEngine *self,
 		g_propagate_error(error, g_steal_pointer(&error_local));
 		return FALSE;
 	}
+	/* used to skip duplicate payloads that a higher-priority remote also provides */
+	if (fu_engine_config_get_release_dedupe(self->config) &&
+	    self->release_csum_priority != NULL) {
+		const gchar *remote_id =
+		    xb_node_query_text(component, "custom/value[@key='fwupd::RemoteId']", NULL);
+		if (remote_id != NULL) {
+			FwupdRemote *remote =
+			    fu_remote_list_get_by_id(self->remote_list, remote_id);
+			if (remote != NULL)
+				remote_priority = fwupd_remote_get_priority(remote);
+		}
+	}
+
 	feature_flags = fu_engine_request_get_feature_flags(request);
 	for (guint i = 0; i < releases_tmp->len; i++) {
 		XbNode *rel = g_ptr_array_index(releases_tmp, i);
@@ -5119,6 +6548,33 @@ fu_engine_add_releases_for_device_component(FuEngine *self,
 		g_autoptr(FuRelease) release = fu_release_new();
 		g_autoptr(GError) error_loop = NULL;
 
+		/* the same payload is indexed at a higher effective priority from another
+		 * remote, so do not even bother building the FuRelease for this one */
+		if (fu_engine_config_get_release_dedupe(self->config) &&
+		    self->release_csum_priority != NULL) {
+			const gchar *csum_str =
+			    xb_node_query_text(rel, "checksum[@target='container']", NULL);
+			if (csum_str == NULL) {
+				csum_str = xb_node_query_text(
+				    rel,
+				    "artifacts/artifact[@type='binary']/checksum",
+				    NULL);
+			}
+			if (csum_str != NULL) {
+				gint64 *priority_tmp =
+				    g_hash_table_lookup(self->release_csum_priority, csum_str);
+				if (priority_tmp != NULL &&
+				    *priority_tmp >
+					fu_engine_release_effective_priority(component,
+									     rel,
+									     remote_priority)) {
+					g_debug("skipping %s, higher priority remote has it",
+						csum_str);
+					continue;
+				}
+			}
+		}
+
 		/* create new FwupdRelease for the XbNode */
 		fu_release_set_request(release, request);
 		fu_release_set_device(release, device);
@@ -5243,6 +6699,10 @@ fu_engine_get_releases_for_device(FuEngine *self,
 	g_autoptr(GPtrArray) branches = NULL;
 	g_autoptr(GPtrArray) releases = NULL;
 
+	/* the metadata silo may have been unloaded to save memory */
+	if (!fu_engine_ensure_silo(self, error))
+		return NULL;
+
 	/* no components in silo */
 	if (self->query_component_by_guid == NULL) {
 		g_set_error(error, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED, "no components in silo");
@@ -5425,6 +6885,112 @@ fu_engine_get_releases(FuEngine *self,
 	return g_steal_pointer(&releases_deduped);
 }
 
+typedef struct {
+	FuEngine *self;		  /* no-ref */
+	FuEngineRequest *request; /* no-ref */
+	FuDevice *device;	  /* no-ref */
+	GPtrArray *releases;	  /* (nullable) (element-type FuRelease) */
+	GError *error;		  /* (nullable) */
+} FuEngineGetReleasesHelper;
+
+static void
+fu_engine_get_releases_for_devices_cb(gpointer data, gpointer user_data)
+{
+	FuEngineGetReleasesHelper *helper = (FuEngineGetReleasesHelper *)data;
+	helper->releases = fu_engine_get_releases(helper->self,
+						  helper->request,
+						  fu_device_get_id(helper->device),
+						  &helper->error);
+}
+
+/**
+ * fu_engine_get_releases_for_devices:
+ * @self: a #FuEngine
+ * @request: a #FuEngineRequest
+ * @devices: (element-type FuDevice): devices to resolve
+ * @error: (nullable): optional return location for an error
+ *
+ * Gets the releases available for several devices at once, resolving independent devices
+ * concurrently. Devices with no matching releases are simply absent from the result.
+ *
+ * Returns: (transfer container) (element-type utf8 GPtrArray): device ID to releases
+ **/
+GHashTable *
+fu_engine_get_releases_for_devices(FuEngine *self,
+				   FuEngineRequest *request,
+				   GPtrArray *devices,
+				   GError **error)
+{
+	guint max_threads;
+	g_autoptr(GHashTable) results =
+	    g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_ptr_array_unref);
+	g_autoptr(GPtrArray) helpers = g_ptr_array_new_with_free_func(g_free);
+
+	g_return_val_if_fail(FU_IS_ENGINE(self), NULL);
+	g_return_val_if_fail(FU_IS_ENGINE_REQUEST(request), NULL);
+	g_return_val_if_fail(devices != NULL, NULL);
+	g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+	max_threads = MIN(g_get_num_processors(), devices->len);
+
+	/* the workers only query the silo read-only, but loading it is not thread-safe */
+	if (!fu_engine_ensure_silo(self, error))
+		return NULL;
+
+	for (guint i = 0; i < devices->len; i++) {
+		FuDevice *device = g_ptr_array_index(devices, i);
+		FuEngineGetReleasesHelper *helper = g_new0(FuEngineGetReleasesHelper, 1);
+		helper->self = self;
+		helper->request = request;
+		helper->device = device;
+		g_ptr_array_add(helpers, helper);
+	}
+
+	/* resolve on a bounded worker pool; as we block here waiting for the workers nothing
+	 * else is mutating the engine while they run */
+	if (max_threads > 1) {
+		GThreadPool *pool;
+		g_autoptr(GError) error_pool = NULL;
+
+		pool = g_thread_pool_new(fu_engine_get_releases_for_devices_cb,
+					 self,
+					 (gint)max_threads,
+					 FALSE,
+					 &error_pool);
+		if (pool == NULL) {
+			g_debug("failed to create release pool, falling back to serial: %s",
+				error_pool->message);
+			max_threads = 1;
+		} else {
+			for (guint i = 0; i < helpers->len; i++)
+				g_thread_pool_push(pool, g_ptr_array_index(helpers, i), NULL);
+			g_thread_pool_free(pool, FALSE, TRUE);
+		}
+	}
+	if (max_threads <= 1) {
+		for (guint i = 0; i < helpers->len; i++)
+			fu_engine_get_releases_for_devices_cb(g_ptr_array_index(helpers, i), self);
+	}
+
+	/* collect the per-device results */
+	for (guint i = 0; i < helpers->len; i++) {
+		FuEngineGetReleasesHelper *helper = g_ptr_array_index(helpers, i);
+		if (helper->releases == NULL) {
+			g_debug("no releases for %s: %s",
+				fu_device_get_id(helper->device),
+				helper->error != NULL ? helper->error->message : "unknown");
+			g_clear_error(&helper->error);
+			continue;
+		}
+		g_hash_table_insert(results,
+				    g_strdup(fu_device_get_id(helper->device)),
+				    g_steal_pointer(&helper->releases));
+	}
+
+	/* success */
+	return g_steal_pointer(&results);
+}
+
 /**
  * fu_engine_get_downgrades:
  * @self: a #FuEngine
@@ -5910,6 +7476,32 @@ fu_engine_plugins_ready(FuEngine *self, FuProgress *progress)
 	}
 }
 
+typedef struct {
+	FuPlugin *plugin; /* no-ref */
+	FuProgress *progress;
+	GThread *thread;
+	GError *error;
+} FuEnginePluginColdplugHelper;
+
+static void
+fu_engine_plugin_coldplug_helper_free(FuEnginePluginColdplugHelper *helper)
+{
+	if (helper->thread != NULL)
+		g_thread_join(helper->thread);
+	if (helper->error != NULL)
+		g_error_free(helper->error);
+	g_object_unref(helper->progress);
+	g_free(helper);
+}
+
+static gpointer
+fu_engine_plugins_coldplug_thread_cb(gpointer user_data)
+{
+	FuEnginePluginColdplugHelper *helper = (FuEnginePluginColdplugHelper *)user_data;
+	fu_plugin_runner_coldplug(helper->plugin, helper->progress, &helper->error);
+	return NULL;
+}
+
 static void
 fu_engine_plugins_coldplug(FuEngine *self, FuProgress *progress)
 {
@@ -5920,15 +7512,66 @@ fu_engine_plugins_coldplug(FuEngine *self, FuProgress *progress)
 	plugins = fu_plugin_list_get_all(self->plugin_list);
 	fu_progress_set_id(progress, G_STRLOC);
 	fu_progress_set_steps(progress, plugins->len);
-	for (guint i = 0; i < plugins->len; i++) {
-		g_autoptr(GError) error = NULL;
+
+	/* the list is sorted by depsolved order, and plugins sharing an order value have no
+	 * Order/Depends relationship with each other -- so run each such antichain on worker
+	 * threads and join before starting the next level */
+	for (guint i = 0; i < plugins->len;) {
 		FuPlugin *plugin = g_ptr_array_index(plugins, i);
-		if (!fu_plugin_runner_coldplug(plugin, fu_progress_get_child(progress), &error)) {
-			fu_plugin_add_flag(plugin, FWUPD_PLUGIN_FLAG_DISABLED);
-			g_info("disabling plugin because: %s", error->message);
-			fu_progress_add_flag(progress, FU_PROGRESS_FLAG_CHILD_FINISHED);
+		guint j = i + 1;
+		g_autoptr(GPtrArray) helpers = g_ptr_array_new_with_free_func(
+		    (GDestroyNotify)fu_engine_plugin_coldplug_helper_free);
+
+		while (j < plugins->len) {
+			FuPlugin *plugin_tmp = g_ptr_array_index(plugins, j);
+			if (fu_plugin_get_order(plugin_tmp) != fu_plugin_get_order(plugin))
+				break;
+			j++;
+		}
+
+		/* run a lone plugin in the caller thread with a real progress child */
+		if (j == i + 1) {
+			g_autoptr(GError) error = NULL;
+			if (!fu_plugin_runner_coldplug(plugin,
+						       fu_progress_get_child(progress),
+						       &error)) {
+				fu_plugin_add_flag(plugin, FWUPD_PLUGIN_FLAG_DISABLED);
+				g_info("disabling plugin because: %s", error->message);
+				fu_progress_add_flag(progress, FU_PROGRESS_FLAG_CHILD_FINISHED);
+			}
+			fu_progress_step_done(progress);
+			i = j;
+			continue;
 		}
-		fu_progress_step_done(progress);
+
+		/* each worker gets a detached FuProgress so that signal emission stays on
+		 * the worker thread */
+		for (guint k = i; k < j; k++) {
+			FuEnginePluginColdplugHelper *helper =
+			    g_new0(FuEnginePluginColdplugHelper, 1);
+			helper->plugin = g_ptr_array_index(plugins, k);
+			helper->progress = fu_progress_new(G_STRLOC);
+			fu_progress_add_flag(helper->progress, FU_PROGRESS_FLAG_NO_PROFILE);
+			helper->thread = g_thread_new("FuPluginColdplug",
+						      fu_engine_plugins_coldplug_thread_cb,
+						      helper);
+			g_ptr_array_add(helpers, helper);
+		}
+
+		/* wait for the whole level to finish before the next one may start */
+		for (guint k = 0; k < helpers->len; k++) {
+			FuEnginePluginColdplugHelper *helper = g_ptr_array_index(helpers, k);
+			g_thread_join(g_steal_pointer(&helper->thread));
+		}
+		for (guint k = 0; k < helpers->len; k++) {
+			FuEnginePluginColdplugHelper *helper = g_ptr_array_index(helpers, k);
+			if (helper->error != NULL) {
+				fu_plugin_add_flag(helper->plugin, FWUPD_PLUGIN_FLAG_DISABLED);
+				g_info("disabling plugin because: %s", helper->error->message);
+			}
+			fu_progress_step_done(progress);
+		}
+		i = j;
 	}
 
 	/* print what we do have */
@@ -6382,8 +8025,9 @@ fu_engine_context_security_changed_cb(FuContext *ctx, gpointer user_data)
 {
 	FuEngine *self = FU_ENGINE(user_data);
 
-	/* invalidate host security attributes */
+	/* invalidate host security attributes, although the device results are still valid */
 	g_clear_pointer(&self->host_security_id, g_free);
+	g_clear_object(&self->host_security_attrs_plugins);
 
 	/* make UI refresh */
 	fu_engine_emit_changed(self);
@@ -6490,12 +8134,19 @@ fu_engine_add_plugin_filter(FuEngine *self, const gchar *plugin_glob)
 static gboolean
 fu_engine_plugin_check_supported_cb(FuPlugin *plugin, const gchar *guid, FuEngine *self)
 {
+	g_autoptr(GError) error_silo = NULL;
 	g_autoptr(XbNode) n = NULL;
 	g_autofree gchar *xpath = NULL;
 
 	if (fu_engine_config_get_enumerate_all_devices(self->config))
 		return TRUE;
 
+	/* the metadata silo may have been unloaded to save memory */
+	if (!fu_engine_ensure_silo(self, &error_silo)) {
+		g_warning("failed to load silo: %s", error_silo->message);
+		return FALSE;
+	}
+
 	xpath = g_strdup_printf("components/component[@type='firmware']/"
 				"provides/firmware[@type='flashed'][text()='%s']",
 				guid);
@@ -6545,6 +8196,18 @@ fu_engine_get_host_bkc(FuEngine *self)
 }
 
 #ifdef HAVE_HSI
+/* append copies so that fu_security_attrs_depsolve() cannot modify the cached attrs */
+static void
+fu_engine_security_attrs_append_cached(FuEngine *self, FuSecurityAttrs *attrs_cache)
+{
+	g_autoptr(GPtrArray) attrs = fu_security_attrs_get_all(attrs_cache);
+	for (guint i = 0; i < attrs->len; i++) {
+		FwupdSecurityAttr *attr = g_ptr_array_index(attrs, i);
+		g_autoptr(FwupdSecurityAttr) attr_copy = fwupd_security_attr_copy(attr);
+		fu_security_attrs_append_internal(self->host_security_attrs, attr_copy);
+	}
+}
+
 static void
 fu_engine_ensure_security_attrs_supported_cpu(FuEngine *self)
 {
@@ -7049,17 +8712,30 @@ fu_engine_ensure_security_attrs(FuEngine *self)
 	fu_engine_ensure_security_attrs_supported_cpu(self);
 	fu_engine_ensure_security_attrs_tainted(self);
 
-	/* call into devices */
-	for (guint i = 0; i < devices->len; i++) {
-		FuDevice *device = g_ptr_array_index(devices, i);
-		fu_device_add_security_attrs(device, self->host_security_attrs);
+	/* call into devices, unless the results from last time are still valid */
+	if (self->host_security_attrs_devices == NULL) {
+		self->host_security_attrs_devices = fu_security_attrs_new();
+		for (guint i = 0; i < devices->len; i++) {
+			FuDevice *device = g_ptr_array_index(devices, i);
+			fu_device_add_security_attrs(device, self->host_security_attrs_devices);
+		}
+	} else {
+		g_debug("reusing cached device security attributes");
 	}
+	fu_engine_security_attrs_append_cached(self, self->host_security_attrs_devices);
 
-	/* call into plugins */
-	for (guint j = 0; j < plugins->len; j++) {
-		FuPlugin *plugin_tmp = g_ptr_array_index(plugins, j);
-		fu_plugin_runner_add_security_attrs(plugin_tmp, self->host_security_attrs);
+	/* call into plugins, unless the results from last time are still valid */
+	if (self->host_security_attrs_plugins == NULL) {
+		self->host_security_attrs_plugins = fu_security_attrs_new();
+		for (guint j = 0; j < plugins->len; j++) {
+			FuPlugin *plugin_tmp = g_ptr_array_index(plugins, j);
+			fu_plugin_runner_add_security_attrs(plugin_tmp,
+							    self->host_security_attrs_plugins);
+		}
+	} else {
+		g_debug("reusing cached plugin security attributes");
 	}
+	fu_engine_security_attrs_append_cached(self, self->host_security_attrs_plugins);
 
 	/* sanity check */
 	vals = fu_security_attrs_get_all(self->host_security_attrs);
@@ -7164,6 +8840,17 @@ fu_engine_load_plugins_filename(FuEngine *self, const gchar *filename, FuProgres
 	fu_engine_add_plugin(self, plugin);
 	fu_progress_step_done(progress);
 
+	/* defer the module load until a device declaring this plugin appears */
+	if (fu_engine_config_get_lazy_plugins(self->config)) {
+		if (self->plugin_lazy_fns == NULL) {
+			self->plugin_lazy_fns =
+			    g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+		}
+		g_hash_table_insert(self->plugin_lazy_fns, g_strdup(name), g_strdup(filename));
+		fu_progress_finished(progress);
+		return;
+	}
+
 	/* open the plugin and call ->load() */
 	if (!fu_plugin_open(plugin, filename, &error_local))
 		g_warning("cannot load: %s", error_local->message);
@@ -7449,6 +9136,75 @@ fu_engine_backend_device_removed_cb(FuBackend *backend, FuDevice *device, FuEngi
 	}
 }
 
+static void
+fu_engine_probe_mutex_free(GMutex *mutex)
+{
+	g_mutex_clear(mutex);
+	g_free(mutex);
+}
+
+static GMutex *
+fu_engine_get_plugin_probe_mutex(FuEngine *self, const gchar *plugin_name)
+{
+	GMutex *mutex;
+	g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->plugin_probe_mutexes_mutex);
+
+	mutex = g_hash_table_lookup(self->plugin_probe_mutexes, plugin_name);
+	if (mutex == NULL) {
+		mutex = g_new0(GMutex, 1);
+		g_mutex_init(mutex);
+		g_hash_table_insert(self->plugin_probe_mutexes, g_strdup(plugin_name), mutex);
+	}
+	return mutex;
+}
+
+static gboolean
+fu_engine_plugin_ensure_opened(FuEngine *self, FuPlugin *plugin, GError **error)
+{
+	const gchar *name = fu_plugin_get_name(plugin);
+	g_autofree gchar *filename = NULL;
+	g_autoptr(FuProgress) progress = fu_progress_new(G_STRLOC);
+
+	/* not deferred, or already opened */
+	if (self->plugin_lazy_fns == NULL)
+		return TRUE;
+	filename = g_strdup(g_hash_table_lookup(self->plugin_lazy_fns, name));
+	if (filename == NULL)
+		return TRUE;
+
+	/* only try once, even on failure */
+	g_hash_table_remove(self->plugin_lazy_fns, name);
+	if (fu_plugin_has_flag(plugin, FWUPD_PLUGIN_FLAG_DISABLED)) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_NOT_SUPPORTED,
+			    "plugin %s is disabled",
+			    name);
+		return FALSE;
+	}
+
+	/* progress */
+	fu_progress_add_step(progress, FWUPD_STATUS_LOADING, 50, "open");
+	fu_progress_add_step(progress, FWUPD_STATUS_LOADING, 25, "startup");
+	fu_progress_add_step(progress, FWUPD_STATUS_LOADING, 25, "coldplug");
+
+	/* run the load-time steps this plugin missed */
+	g_info("lazy-loading plugin %s as matching device appeared", name);
+	if (!fu_plugin_open(plugin, filename, error))
+		return FALSE;
+	fu_plugin_runner_init(plugin);
+	fu_progress_step_done(progress);
+	if (!fu_plugin_runner_startup(plugin, fu_progress_get_child(progress), error))
+		return FALSE;
+	fu_progress_step_done(progress);
+	if (!fu_plugin_runner_coldplug(plugin, fu_progress_get_child(progress), error))
+		return FALSE;
+	fu_progress_step_done(progress);
+
+	/* success */
+	return TRUE;
+}
+
 static gboolean
 fu_engine_backend_device_added_run_plugin(FuEngine *self,
 					  FuDevice *device,
@@ -7457,6 +9213,7 @@ fu_engine_backend_device_added_run_plugin(FuEngine *self,
 					  GError **error)
 {
 	FuPlugin *plugin;
+	g_autoptr(GMutexLocker) locker = NULL;
 
 	/* find plugin */
 	fu_progress_set_name(progress, plugin_name);
@@ -7464,6 +9221,14 @@ fu_engine_backend_device_added_run_plugin(FuEngine *self,
 	if (plugin == NULL)
 		return FALSE;
 
+	/* open now if the module load was deferred */
+	if (!fu_engine_plugin_ensure_opened(self, plugin, error))
+		return FALSE;
+
+	/* plugins that declare themselves not thread-safe get their probes serialized */
+	if (fu_plugin_has_flag(plugin, FWUPD_PLUGIN_FLAG_NOT_THREAD_SAFE))
+		locker = g_mutex_locker_new(fu_engine_get_plugin_probe_mutex(self, plugin_name));
+
 	/* run the ->probe() then ->setup() vfuncs */
 	if (!fu_plugin_runner_backend_device_added(plugin, device, progress, error)) {
 #ifdef SUPPORTED_BUILD
@@ -7602,6 +9367,7 @@ fu_engine_backend_device_changed_cb(FuBackend *backend, FuDevice *device, FuEngi
 		if (g_strcmp0(fu_udev_device_get_sysfs_path(FU_UDEV_DEVICE(device_tmp)),
 			      fu_udev_device_get_sysfs_path(FU_UDEV_DEVICE(device))) == 0) {
 			fu_udev_device_emit_changed(FU_UDEV_DEVICE(device));
+			fu_device_poll_reset(device_tmp);
 		}
 	}
 
@@ -7795,6 +9561,10 @@ fu_engine_update_history_database(FuEngine *self, GError **error)
 	devices = fu_history_get_devices(self->history, error);
 	if (devices == NULL)
 		return FALSE;
+
+	/* group all the per-device writes into a single durable commit */
+	if (!fu_history_transaction_begin(self->history, error))
+		return FALSE;
 	for (guint i = 0; i < devices->len; i++) {
 		FuDevice *dev = g_ptr_array_index(devices, i);
 		g_autoptr(GError) error_local = NULL;
@@ -7814,7 +9584,7 @@ fu_engine_update_history_database(FuEngine *self, GError **error)
 			g_warning("failed to update history database: %s", error_local->message);
 		}
 	}
-	return TRUE;
+	return fu_history_transaction_commit(self->history, error);
 }
 
 static void
@@ -7958,6 +9728,87 @@ fu_engine_win32_registry_get_string(HKEY hkey,
 }
 #endif
 
+/* maximum additional time a single wedged device probe may delay the load */
+#define FU_ENGINE_DEVICE_PROBE_BUDGET 10000 /* ms */
+
+typedef struct {
+	GMutex mutex;
+	GCond cond;
+	guint pending;
+	gint refcount;
+	GPtrArray *devices_done; /* (element-type FuDevice) */
+} FuEngineProbeCtx;
+
+static FuEngineProbeCtx *
+fu_engine_probe_ctx_new(guint pending)
+{
+	FuEngineProbeCtx *ctx = g_new0(FuEngineProbeCtx, 1);
+	g_mutex_init(&ctx->mutex);
+	g_cond_init(&ctx->cond);
+	ctx->pending = pending;
+	ctx->refcount = 1;
+	ctx->devices_done = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	return ctx;
+}
+
+static FuEngineProbeCtx *
+fu_engine_probe_ctx_ref(FuEngineProbeCtx *ctx)
+{
+	g_atomic_int_inc(&ctx->refcount);
+	return ctx;
+}
+
+static void
+fu_engine_probe_ctx_unref(FuEngineProbeCtx *ctx)
+{
+	if (!g_atomic_int_dec_and_test(&ctx->refcount))
+		return;
+	g_ptr_array_unref(ctx->devices_done);
+	g_cond_clear(&ctx->cond);
+	g_mutex_clear(&ctx->mutex);
+	g_free(ctx);
+}
+
+typedef struct {
+	FuEngine *self; /* no-ref */
+	FuDevice *device;
+	FuProgress *progress;
+	FuEngineProbeCtx *ctx;
+} FuEngineProbeHelper;
+
+static void
+fu_engine_probe_helper_free(FuEngineProbeHelper *helper)
+{
+	g_object_unref(helper->device);
+	g_object_unref(helper->progress);
+	if (helper->ctx != NULL)
+		fu_engine_probe_ctx_unref(helper->ctx);
+	g_free(helper);
+}
+
+static void
+fu_engine_backends_coldplug_probe_cb(gpointer data, gpointer user_data)
+{
+	FuEngineProbeHelper *helper = (FuEngineProbeHelper *)data;
+
+	/* keep the worker near the IRQ/NUMA locality of the backing device */
+	if (FU_IS_UDEV_DEVICE(helper->device)) {
+		g_autoptr(GError) error_local = NULL;
+		if (!fu_udev_device_set_cpu_affinity(FU_UDEV_DEVICE(helper->device), &error_local))
+			g_debug("failed to set CPU affinity: %s", error_local->message);
+	}
+
+	fu_engine_backend_device_added(helper->self, helper->device, helper->progress);
+	if (helper->ctx != NULL) {
+		g_mutex_lock(&helper->ctx->mutex);
+		helper->ctx->pending--;
+		g_ptr_array_add(helper->ctx->devices_done, g_object_ref(helper->device));
+		g_cond_signal(&helper->ctx->cond);
+		g_mutex_unlock(&helper->ctx->mutex);
+	}
+	fu_engine_probe_helper_free(helper);
+}
+
 static gboolean
 fu_engine_backends_coldplug_backend_add_devices(FuEngine *self,
 						FuBackend *backend,
@@ -7965,19 +9816,98 @@ fu_engine_backends_coldplug_backend_add_devices(FuEngine *self,
 						GError **error)
 {
 	g_autoptr(GPtrArray) devices = fu_backend_get_devices(backend);
+	g_autoptr(GPtrArray) devices_done =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	guint max_threads = MIN(g_get_num_processors(), devices->len);
 
 	/* progress */
 	fu_progress_set_id(progress, G_STRLOC);
 	fu_progress_set_steps(progress, devices->len);
-	for (guint i = 0; i < devices->len; i++) {
-		FuDevice *device = g_ptr_array_index(devices, i);
-		g_autoptr(GPtrArray) possible_plugins = NULL;
 
-		fu_engine_backend_device_added(self, device, fu_progress_get_child(progress));
-		fu_progress_step_done(progress);
+	/* probe independent devices concurrently on a bounded worker pool; plugins that set
+	 * FWUPD_PLUGIN_FLAG_NOT_THREAD_SAFE have their probes serialized in the runner */
+	if (max_threads > 1) {
+		GThreadPool *pool;
+		g_autoptr(GError) error_pool = NULL;
+
+		pool = g_thread_pool_new(fu_engine_backends_coldplug_probe_cb,
+					 self,
+					 (gint)max_threads,
+					 FALSE,
+					 &error_pool);
+		if (pool == NULL) {
+			g_debug("failed to create probe pool, falling back to serial: %s",
+				error_pool->message);
+			max_threads = 1;
+		} else {
+			FuEngineProbeCtx *ctx = fu_engine_probe_ctx_new(devices->len);
+			for (guint i = 0; i < devices->len; i++) {
+				FuDevice *device = g_ptr_array_index(devices, i);
+				FuEngineProbeHelper *helper = g_new0(FuEngineProbeHelper, 1);
+				helper->self = self;
+				helper->device = g_object_ref(device);
+				helper->progress = fu_progress_new(G_STRLOC);
+				helper->ctx = fu_engine_probe_ctx_ref(ctx);
+				fu_progress_add_flag(helper->progress,
+						     FU_PROGRESS_FLAG_NO_PROFILE);
+				g_thread_pool_push(pool, helper, NULL);
+			}
+
+			/* wait with a per-device time budget: as long as probes keep
+			 * completing we keep waiting, but a wedged device -- e.g. a MST hub
+			 * stuck in its kernel timeout -- only delays the load by the budget;
+			 * the worker keeps going and the device is added whenever it
+			 * eventually answers */
+			g_mutex_lock(&ctx->mutex);
+			while (ctx->pending > 0) {
+				guint pending_old = ctx->pending;
+				gint64 end_time =
+				    g_get_monotonic_time() +
+				    FU_ENGINE_DEVICE_PROBE_BUDGET * G_TIME_SPAN_MILLISECOND;
+				while (ctx->pending == pending_old) {
+					if (!g_cond_wait_until(&ctx->cond,
+							       &ctx->mutex,
+							       end_time))
+						break;
+				}
+				if (ctx->pending == pending_old) {
+					g_warning("still waiting for %u of %u device probes "
+						  "after %ums, continuing load without them",
+						  ctx->pending,
+						  devices->len,
+						  (guint)FU_ENGINE_DEVICE_PROBE_BUDGET);
+					break;
+				}
+			}
+			for (guint i = 0; i < ctx->devices_done->len; i++) {
+				FuDevice *device = g_ptr_array_index(ctx->devices_done, i);
+				g_ptr_array_add(devices_done, g_object_ref(device));
+			}
+			g_mutex_unlock(&ctx->mutex);
+			fu_engine_probe_ctx_unref(ctx);
+
+			/* any stragglers finish in the background */
+			g_thread_pool_free(pool, FALSE, FALSE);
+			for (guint i = 0; i < devices->len; i++)
+				fu_progress_step_done(progress);
+		}
+	}
+	if (max_threads <= 1) {
+		for (guint i = 0; i < devices->len; i++) {
+			FuDevice *device = g_ptr_array_index(devices, i);
+			fu_engine_backend_device_added(self,
+						       device,
+						       fu_progress_get_child(progress));
+			g_ptr_array_add(devices_done, g_object_ref(device));
+			fu_progress_step_done(progress);
+		}
+	}
 
-		/* there's no point keeping this in the cache */
-		possible_plugins = fu_device_get_possible_plugins(device);
+	/* there's no point keeping devices with no possible plugins in the cache; devices
+	 * that ran out of budget are skipped as they are still being probed */
+	for (guint i = 0; i < devices_done->len; i++) {
+		FuDevice *device = g_ptr_array_index(devices_done, i);
+		g_autoptr(GPtrArray) possible_plugins = fu_device_get_possible_plugins(device);
 		if (possible_plugins->len == 0) {
 			g_debug("removing %s from backend cache as no possible plugin",
 				fu_device_get_backend_id(device));
@@ -7989,30 +9919,42 @@ fu_engine_backends_coldplug_backend_add_devices(FuEngine *self,
 	return TRUE;
 }
 
+typedef struct {
+	FuBackend *backend; /* no-ref */
+	FuProgress *progress;
+	GThread *thread;
+	GError *error;
+} FuEngineColdplugHelper;
+
+static void
+fu_engine_coldplug_helper_free(FuEngineColdplugHelper *helper)
+{
+	if (helper->thread != NULL)
+		g_thread_join(helper->thread);
+	if (helper->error != NULL)
+		g_error_free(helper->error);
+	g_object_unref(helper->progress);
+	g_free(helper);
+}
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(FuEngineColdplugHelper, fu_engine_coldplug_helper_free)
+
+static gpointer
+fu_engine_backends_coldplug_thread_cb(gpointer user_data)
+{
+	FuEngineColdplugHelper *helper = (FuEngineColdplugHelper *)user_data;
+	fu_backend_coldplug(helper->backend, helper->progress, &helper->error);
+	return NULL;
+}
+
 static gboolean
 fu_engine_backends_coldplug_backend(FuEngine *self,
 				    FuBackend *backend,
 				    FuProgress *progress,
 				    GError **error)
 {
-	/* progress */
-	fu_progress_set_id(progress, G_STRLOC);
-	fu_progress_add_flag(progress, FU_PROGRESS_FLAG_NO_PROFILE);
-	fu_progress_set_name(progress, fu_backend_get_name(backend));
-	fu_progress_add_step(progress, FWUPD_STATUS_LOADING, 1, "coldplug");
-	fu_progress_add_step(progress, FWUPD_STATUS_LOADING, 99, "add-devices");
-
-	/* coldplug */
-	if (!fu_backend_coldplug(backend, fu_progress_get_child(progress), error))
-		return FALSE;
-	fu_progress_step_done(progress);
-
 	/* add */
-	fu_engine_backends_coldplug_backend_add_devices(self,
-							backend,
-							fu_progress_get_child(progress),
-							error);
-	fu_progress_step_done(progress);
+	fu_engine_backends_coldplug_backend_add_devices(self, backend, progress, error);
 
 	/* success */
 	g_signal_connect(FU_BACKEND(backend),
@@ -8034,37 +9976,220 @@ static void
 fu_engine_backends_coldplug(FuEngine *self, FuProgress *progress)
 {
 	GPtrArray *backends = fu_context_get_backends(self->ctx);
-	fu_progress_set_id(progress, G_STRLOC);
-	fu_progress_set_steps(progress, backends->len);
+	g_autoptr(GPtrArray) helpers =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)fu_engine_coldplug_helper_free);
+
+	/* enumerate each backend on its own worker thread so the total coldplug time is the
+	 * slowest backend rather than the sum of all of them -- each worker gets a detached
+	 * FuProgress so that signal emission stays on the worker thread */
 	for (guint i = 0; i < backends->len; i++) {
 		FuBackend *backend = g_ptr_array_index(backends, i);
-		g_autoptr(GError) error_backend = NULL;
+		FuEngineColdplugHelper *helper;
 
-		if (!fu_backend_get_enabled(backend)) {
-			fu_progress_step_done(progress);
+		if (!fu_backend_get_enabled(backend))
 			continue;
-		}
-		if (!fu_engine_backends_coldplug_backend(self,
-							 backend,
-							 fu_progress_get_child(progress),
-							 &error_backend)) {
-			if (g_error_matches(error_backend,
+		helper = g_new0(FuEngineColdplugHelper, 1);
+		helper->backend = backend;
+		helper->progress = fu_progress_new(G_STRLOC);
+		fu_progress_add_flag(helper->progress, FU_PROGRESS_FLAG_NO_PROFILE);
+		helper->thread = g_thread_new("FuEngineColdplug",
+					      fu_engine_backends_coldplug_thread_cb,
+					      helper);
+		g_ptr_array_add(helpers, helper);
+	}
+
+	/* wait for all the backends to finish enumerating */
+	for (guint i = 0; i < helpers->len; i++) {
+		FuEngineColdplugHelper *helper = g_ptr_array_index(helpers, i);
+		g_thread_join(g_steal_pointer(&helper->thread));
+	}
+
+	/* merge the enumerated devices into the engine back on the main thread */
+	fu_progress_set_id(progress, G_STRLOC);
+	fu_progress_set_steps(progress, helpers->len);
+	for (guint i = 0; i < helpers->len; i++) {
+		FuEngineColdplugHelper *helper = g_ptr_array_index(helpers, i);
+		g_autoptr(GError) error_backend = NULL;
+
+		if (helper->error != NULL) {
+			if (g_error_matches(helper->error,
 					    FWUPD_ERROR,
 					    FWUPD_ERROR_NOT_SUPPORTED)) {
 				g_debug("ignoring coldplug failure %s: %s",
-					fu_backend_get_name(backend),
-					error_backend->message);
+					fu_backend_get_name(helper->backend),
+					helper->error->message);
 			} else {
 				g_warning("failed to coldplug backend %s: %s",
-					  fu_backend_get_name(backend),
-					  error_backend->message);
+					  fu_backend_get_name(helper->backend),
+					  helper->error->message);
 			}
 			fu_progress_finished(fu_progress_get_child(progress));
+			fu_progress_step_done(progress);
+			continue;
+		}
+		if (!fu_engine_backends_coldplug_backend(self,
+							 helper->backend,
+							 fu_progress_get_child(progress),
+							 &error_backend)) {
+			g_warning("failed to coldplug backend %s: %s",
+				  fu_backend_get_name(helper->backend),
+				  error_backend->message);
+			fu_progress_finished(fu_progress_get_child(progress));
 		}
 		fu_progress_step_done(progress);
 	}
 }
 
+static gpointer
+fu_engine_history_load_thread_cb(gpointer user_data)
+{
+	FuEngine *self = FU_ENGINE(user_data);
+	g_autoptr(GError) error_local = NULL;
+
+	/* any actual failure is reported by the first real query */
+	if (!fu_history_load(self->history, &error_local))
+		g_debug("failed to preload history database: %s", error_local->message);
+	return NULL;
+}
+
+/* wait for the history database open and schema migration running on the worker thread */
+static void
+fu_engine_history_load_join(FuEngine *self)
+{
+	if (self->history_thread == NULL)
+		return;
+	g_thread_join(g_steal_pointer(&self->history_thread));
+}
+
+#ifdef HAVE_POSIX_FADVISE
+static guint
+fu_engine_prefetch_path(const gchar *path, guint depth)
+{
+	gint fd;
+	guint cnt = 0;
+
+	if (g_file_test(path, G_FILE_TEST_IS_DIR)) {
+		const gchar *fn;
+		g_autoptr(GDir) dir = NULL;
+		if (depth == 0)
+			return 0;
+		dir = g_dir_open(path, 0, NULL);
+		if (dir == NULL)
+			return 0;
+		while ((fn = g_dir_read_name(dir)) != NULL) {
+			g_autofree gchar *fn_full = g_build_filename(path, fn, NULL);
+			cnt += fu_engine_prefetch_path(fn_full, depth - 1);
+		}
+		return cnt;
+	}
+	fd = g_open(path, O_RDONLY | O_CLOEXEC | O_NOCTTY, 0);
+	if (fd < 0)
+		return 0;
+	/* best effort; WILLNEED queues the readahead and returns without waiting */
+	if (posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED) != 0)
+		g_debug("failed to fadvise %s", path);
+	g_close(fd, NULL);
+	return 1;
+}
+#endif
+
+/* hint the files the quirk, metadata and history loaders are about to read so that cold-disk
+ * readahead overlaps with config parsing rather than serializing behind it */
+static void
+fu_engine_prefetch_startup_files(void)
+{
+#ifdef HAVE_POSIX_FADVISE
+	guint cnt = 0;
+	g_autofree gchar *cachedirpkg = fu_path_from_kind(FU_PATH_KIND_CACHEDIR_PKG);
+	g_autofree gchar *metadatadir = fu_path_from_kind(FU_PATH_KIND_LOCALSTATEDIR_METADATA);
+	g_autofree gchar *statedirpkg = fu_path_from_kind(FU_PATH_KIND_LOCALSTATEDIR_PKG);
+	g_autofree gchar *pendingdb = g_build_filename(statedirpkg, "pending.db", NULL);
+	g_autoptr(GTimer) timer = g_timer_new();
+
+	cnt += fu_engine_prefetch_path(cachedirpkg, 1);
+	cnt += fu_engine_prefetch_path(metadatadir, 2);
+	cnt += fu_engine_prefetch_path(pendingdb, 0);
+	g_debug("hinted %u files for readahead in %.2fms",
+		cnt,
+		g_timer_elapsed(timer, NULL) * 1000.f);
+#endif
+}
+
+/* expose the devices recorded in the last-boot devices.json right away so that clients do not
+ * have to wait for the full coldplug; each entry is reconciled against real enumeration by
+ * fu_engine_warm_start_reconcile() */
+static GPtrArray *
+fu_engine_warm_start_add_devices(FuEngine *self)
+{
+	JsonArray *json_array;
+	JsonNode *json_root;
+	JsonObject *json_obj;
+	g_autofree gchar *directory = fu_path_from_kind(FU_PATH_KIND_CACHEDIR_PKG);
+	g_autofree gchar *fn = g_build_filename(directory, "devices.json", NULL);
+	g_autoptr(GError) error_local = NULL;
+	g_autoptr(GPtrArray) devices =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	g_autoptr(JsonParser) parser = json_parser_new();
+
+	/* no state from the last boot */
+	if (!g_file_test(fn, G_FILE_TEST_EXISTS))
+		return g_steal_pointer(&devices);
+	if (!json_parser_load_from_file(parser, fn, &error_local)) {
+		g_debug("failed to load %s: %s", fn, error_local->message);
+		return g_steal_pointer(&devices);
+	}
+	json_root = json_parser_get_root(parser);
+	if (json_root == NULL || !JSON_NODE_HOLDS_OBJECT(json_root)) {
+		g_debug("no root object in %s", fn);
+		return g_steal_pointer(&devices);
+	}
+	json_obj = json_node_get_object(json_root);
+	if (!json_object_has_member(json_obj, "Devices"))
+		return g_steal_pointer(&devices);
+	json_array = json_object_get_array_member(json_obj, "Devices");
+	for (guint i = 0; i < json_array_get_length(json_array); i++) {
+		JsonNode *json_node = json_array_get_element(json_array, i);
+		g_autoptr(FuDevice) device = fu_device_new(self->ctx);
+		g_autoptr(GError) error_device = NULL;
+
+		if (!fwupd_codec_from_json(FWUPD_CODEC(device), json_node, &error_device)) {
+			g_debug("ignoring invalid warm-start device: %s", error_device->message);
+			continue;
+		}
+		if (fu_device_get_plugin(device) == NULL)
+			continue;
+
+		/* not real hardware until the backend proves it still exists */
+		fu_device_remove_flag(device, FWUPD_DEVICE_FLAG_UPDATABLE);
+		fu_device_add_flag(device, FWUPD_DEVICE_FLAG_UNREACHABLE);
+		fu_device_list_add(self->device_list, device);
+		g_ptr_array_add(devices, g_object_ref(device));
+	}
+	if (devices->len > 0)
+		g_info("added %u provisional devices from the last boot", devices->len);
+	return g_steal_pointer(&devices);
+}
+
+/* demote any provisional device that did not reappear during coldplug; devices that did come
+ * back have already replaced the provisional item in the device list */
+static void
+fu_engine_warm_start_reconcile(FuEngine *self, GPtrArray *devices)
+{
+	for (guint i = 0; i < devices->len; i++) {
+		FuDevice *device = g_ptr_array_index(devices, i);
+		g_autoptr(FuDevice) device_tmp = NULL;
+
+		device_tmp =
+		    fu_device_list_get_by_id(self->device_list, fu_device_get_id(device), NULL);
+		if (device_tmp != device)
+			continue;
+		g_info("provisional device %s [%s] did not reappear, removing",
+		       fu_device_get_id(device),
+		       fu_device_get_name(device));
+		fu_device_list_remove(self->device_list, device);
+	}
+}
+
 /**
  * fu_engine_load:
  * @self: a #FuEngine
@@ -8089,6 +10214,7 @@ fu_engine_load(FuEngine *self, FuEngineLoadFlags flags, FuProgress *progress, GE
 	g_autoptr(GError) error_quirks = NULL;
 	g_autoptr(GError) error_json_devices = NULL;
 	g_autoptr(GError) error_local = NULL;
+	g_autoptr(GPtrArray) devices_warm_start = NULL;
 #ifdef HAVE_PASSIM
 	g_autoptr(GError) error_passim = NULL;
 #endif
@@ -8133,6 +10259,16 @@ fu_engine_load(FuEngine *self, FuEngineLoadFlags flags, FuProgress *progress, GE
 		return FALSE;
 	}
 
+	/* open the history database and run any schema migration on a worker thread so that
+	 * the daemon activation path does not block on sqlite */
+	if ((flags & FU_ENGINE_LOAD_FLAG_NO_METADATA) == 0) {
+		self->history_thread =
+		    g_thread_new("FuEngineHistory", fu_engine_history_load_thread_cb, self);
+	}
+
+	/* queue disk readahead for the files we are about to load */
+	fu_engine_prefetch_startup_files();
+
 	/* cache machine ID so we can use it from a sandboxed app */
 #ifdef _WIN32
 	self->host_machine_id =
@@ -8198,19 +10334,22 @@ fu_engine_load(FuEngine *self, FuEngineLoadFlags flags, FuProgress *progress, GE
 	}
 
 	/* get extra firmware saved to the database */
-	checksums_approved = fu_history_get_approved_firmware(self->history, error);
-	if (checksums_approved == NULL)
-		return FALSE;
-	for (guint i = 0; i < checksums_approved->len; i++) {
-		const gchar *csum = g_ptr_array_index(checksums_approved, i);
-		fu_engine_add_approved_firmware(self, csum);
-	}
-	checksums_blocked = fu_history_get_blocked_firmware(self->history, error);
-	if (checksums_blocked == NULL)
-		return FALSE;
-	for (guint i = 0; i < checksums_blocked->len; i++) {
-		const gchar *csum = g_ptr_array_index(checksums_blocked, i);
-		fu_engine_add_blocked_firmware(self, csum);
+	if ((flags & FU_ENGINE_LOAD_FLAG_NO_METADATA) == 0) {
+		fu_engine_history_load_join(self);
+		checksums_approved = fu_history_get_approved_firmware(self->history, error);
+		if (checksums_approved == NULL)
+			return FALSE;
+		for (guint i = 0; i < checksums_approved->len; i++) {
+			const gchar *csum = g_ptr_array_index(checksums_approved, i);
+			fu_engine_add_approved_firmware(self, csum);
+		}
+		checksums_blocked = fu_history_get_blocked_firmware(self->history, error);
+		if (checksums_blocked == NULL)
+			return FALSE;
+		for (guint i = 0; i < checksums_blocked->len; i++) {
+			const gchar *csum = g_ptr_array_index(checksums_blocked, i);
+			fu_engine_add_blocked_firmware(self, csum);
+		}
 	}
 	fu_progress_step_done(progress);
 
@@ -8237,9 +10376,14 @@ fu_engine_load(FuEngine *self, FuEngineLoadFlags flags, FuProgress *progress, GE
 		}
 	}
 
-	/* set up idle exit */
-	if ((flags & FU_ENGINE_LOAD_FLAG_NO_IDLE_SOURCES) == 0)
+	/* set up idle exit and memory trim */
+	if ((flags & FU_ENGINE_LOAD_FLAG_NO_IDLE_SOURCES) == 0) {
 		fu_idle_set_timeout(self->idle, fu_engine_config_get_idle_timeout(self->config));
+		fu_idle_set_timeout_trim(self->idle,
+					 fu_engine_config_get_idle_trim_timeout(self->config));
+		self->verify_scrub_allowed = TRUE;
+		fu_engine_ensure_verify_scrub(self);
+	}
 
 	/* on a read-only filesystem don't care about the cache GUID */
 	if (flags & FU_ENGINE_LOAD_FLAG_READONLY)
@@ -8260,20 +10404,25 @@ fu_engine_load(FuEngine *self, FuEngineLoadFlags flags, FuProgress *progress, GE
 	}
 	fu_progress_step_done(progress);
 
-	/* load AppStream metadata */
-	if (!fu_engine_load_metadata_store(self, flags, error)) {
-		g_prefix_error(error, "Failed to load AppStream data: ");
-		return FALSE;
+	/* load AppStream metadata, unless it will be loaded on demand */
+	if ((flags & FU_ENGINE_LOAD_FLAG_NO_METADATA) == 0) {
+		if (!fu_engine_load_metadata_store(self, flags, error)) {
+			g_prefix_error(error, "Failed to load AppStream data: ");
+			return FALSE;
+		}
 	}
 	fu_progress_step_done(progress);
 
 	/* watch the local.d directories for changes */
-	if (!fu_engine_load_local_metadata_watches(self, error))
-		return FALSE;
+	if ((flags & FU_ENGINE_LOAD_FLAG_NO_METADATA) == 0) {
+		if (!fu_engine_load_local_metadata_watches(self, error))
+			return FALSE;
+	}
 
 	/* add the "built-in" firmware types */
 	fu_context_add_firmware_gtype(self->ctx, "raw", FU_TYPE_FIRMWARE);
 	fu_context_add_firmware_gtype(self->ctx, "cab", FU_TYPE_CAB_FIRMWARE);
+	fu_context_add_firmware_gtype(self->ctx, "delta", FU_TYPE_DELTA_FIRMWARE);
 	fu_context_add_firmware_gtype(self->ctx, "dfu", FU_TYPE_DFU_FIRMWARE);
 	fu_context_add_firmware_gtype(self->ctx, "fdt", FU_TYPE_FDT_FIRMWARE);
 	fu_context_add_firmware_gtype(self->ctx, "csv", FU_TYPE_CSV_FIRMWARE);
@@ -8403,6 +10552,10 @@ fu_engine_load(FuEngine *self, FuEngineLoadFlags flags, FuProgress *progress, GE
 
 	/* add devices */
 	if (flags & FU_ENGINE_LOAD_FLAG_COLDPLUG) {
+		/* hardware rarely changes between boots, so show clients what we found last
+		 * time while the real enumeration is still running */
+		if (flags & FU_ENGINE_LOAD_FLAG_DEVICE_HOTPLUG && !self->host_emulation)
+			devices_warm_start = fu_engine_warm_start_add_devices(self);
 		fu_engine_ensure_context_flag_save_events(self);
 		fu_engine_plugins_startup(self, fu_progress_get_child(progress));
 		fu_progress_step_done(progress);
@@ -8426,6 +10579,10 @@ fu_engine_load(FuEngine *self, FuEngineLoadFlags flags, FuProgress *progress, GE
 		fu_progress_step_done(progress);
 	}
 
+	/* demote provisional devices that failed to reappear */
+	if (devices_warm_start != NULL)
+		fu_engine_warm_start_reconcile(self, devices_warm_start);
+
 	/* dump plugin information to the console */
 	for (guint i = 0; i < backends->len; i++) {
 		FuBackend *backend = g_ptr_array_index(backends, i);
@@ -8688,6 +10845,25 @@ fu_engine_idle_timeout_cb(FuIdle *idle, FuEngine *self)
 	fu_engine_set_status(self, FWUPD_STATUS_SHUTDOWN);
 }
 
+static void
+fu_engine_idle_timeout_trim_cb(FuIdle *idle, FuEngine *self)
+{
+	/* drop anything rebuildable; the silo is lazily reloaded from the compiled blob on
+	 * the next request, which gives exit-like memory behavior without losing the warm
+	 * D-Bus activation latency */
+	g_debug("dropping rebuildable caches to save memory");
+	g_clear_object(&self->query_component_by_guid);
+	g_clear_object(&self->query_container_checksum1);
+	g_clear_object(&self->query_container_checksum2);
+	g_clear_object(&self->query_tag_by_guid_version);
+	g_clear_object(&self->silo);
+	g_hash_table_remove_all(self->cabinet_cache);
+#ifdef HAVE_MALLOC_TRIM
+	/* drop heap except one page */
+	malloc_trim(0);
+#endif
+}
+
 static void
 fu_engine_idle_inhibit_changed_cb(FuIdle *idle, GParamSpec *pspec, FuEngine *self)
 {
@@ -8766,6 +10942,10 @@ fu_engine_constructed(GObject *obj)
 			 "timeout",
 			 G_CALLBACK(fu_engine_idle_timeout_cb),
 			 self);
+	g_signal_connect(FU_IDLE(self->idle),
+			 "timeout-trim",
+			 G_CALLBACK(fu_engine_idle_timeout_trim_cb),
+			 self);
 
 	/* backends */
 	{
@@ -8870,8 +11050,22 @@ fu_engine_init(FuEngine *self)
 						       g_direct_equal,
 						       NULL,
 						       (GDestroyNotify)g_bytes_unref);
+	self->emulation_recorded_ids = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
 	self->device_changed_allowlist =
 	    g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	self->cabinet_cache = g_hash_table_new_full(g_str_hash,
+						    g_str_equal,
+						    g_free,
+						    (GDestroyNotify)g_object_unref);
+	self->report_trusted_cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	g_mutex_init(&self->report_trusted_cache_mutex);
+	self->hwid_req_cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+	g_mutex_init(&self->hwid_req_cache_mutex);
+	self->plugin_probe_mutexes = g_hash_table_new_full(g_str_hash,
+							   g_str_equal,
+							   g_free,
+							   (GDestroyNotify)fu_engine_probe_mutex_free);
+	g_mutex_init(&self->plugin_probe_mutexes_mutex);
 #ifdef HAVE_PASSIM
 	self->passim_client = passim_client_new();
 #endif
@@ -8885,11 +11079,18 @@ fu_engine_finalize(GObject *obj)
 {
 	FuEngine *self = FU_ENGINE(obj);
 
+	/* in case fu_engine_load() failed before the first history query */
+	fu_engine_history_load_join(self);
+
 	for (guint i = 0; i < self->local_monitors->len; i++) {
 		GFileMonitor *monitor = g_ptr_array_index(self->local_monitors, i);
 		g_file_monitor_cancel(monitor);
 	}
 
+	if (self->silo_rebuild_cancellable != NULL) {
+		g_cancellable_cancel(self->silo_rebuild_cancellable);
+		g_object_unref(self->silo_rebuild_cancellable);
+	}
 	if (self->silo != NULL)
 		g_object_unref(self->silo);
 	if (self->query_component_by_guid != NULL)
@@ -8900,6 +11101,8 @@ fu_engine_finalize(GObject *obj)
 		g_object_unref(self->query_container_checksum2);
 	if (self->query_tag_by_guid_version != NULL)
 		g_object_unref(self->query_tag_by_guid_version);
+	if (self->release_csum_priority != NULL)
+		g_hash_table_unref(self->release_csum_priority);
 	if (self->coldplug_id != 0)
 		g_source_remove(self->coldplug_id);
 	if (self->approved_firmware != NULL)
@@ -8910,6 +11113,8 @@ fu_engine_finalize(GObject *obj)
 		g_source_remove(self->acquiesce_id);
 	if (self->update_motd_id != 0)
 		g_source_remove(self->update_motd_id);
+	if (self->verify_scrub_id != 0)
+		g_source_remove(self->verify_scrub_id);
 #ifdef HAVE_PASSIM
 	if (self->passim_client != NULL)
 		g_object_unref(self->passim_client);
@@ -8919,6 +11124,10 @@ fu_engine_finalize(GObject *obj)
 	g_free(self->host_machine_id);
 	g_free(self->host_security_id);
 	g_object_unref(self->host_security_attrs);
+	if (self->host_security_attrs_devices != NULL)
+		g_object_unref(self->host_security_attrs_devices);
+	if (self->host_security_attrs_plugins != NULL)
+		g_object_unref(self->host_security_attrs_plugins);
 	g_object_unref(self->idle);
 	g_object_unref(self->config);
 	g_object_unref(self->remote_list);
@@ -8928,7 +11137,17 @@ fu_engine_finalize(GObject *obj)
 	g_ptr_array_unref(self->plugin_filter);
 	g_ptr_array_unref(self->local_monitors);
 	g_hash_table_unref(self->emulation_phases);
+	g_hash_table_unref(self->emulation_recorded_ids);
 	g_hash_table_unref(self->device_changed_allowlist);
+	g_hash_table_unref(self->cabinet_cache);
+	g_hash_table_unref(self->report_trusted_cache);
+	g_mutex_clear(&self->report_trusted_cache_mutex);
+	g_hash_table_unref(self->hwid_req_cache);
+	g_mutex_clear(&self->hwid_req_cache_mutex);
+	g_hash_table_unref(self->plugin_probe_mutexes);
+	g_mutex_clear(&self->plugin_probe_mutexes_mutex);
+	if (self->plugin_lazy_fns != NULL)
+		g_hash_table_unref(self->plugin_lazy_fns);
 	g_object_unref(self->plugin_list);
 
 	G_OBJECT_CLASS(fu_engine_parent_class)->finalize(obj);
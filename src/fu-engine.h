@@ -33,6 +33,7 @@ G_DECLARE_FINAL_TYPE(FuEngine, fu_engine, FU, ENGINE, GObject)
  * @FU_ENGINE_LOAD_FLAG_ENSURE_CLIENT_CERT:	Ensure the client certificate exists
  * @FU_ENGINE_LOAD_FLAG_EXTERNAL_PLUGINS:	Load external dload'ed plugins such as flashrom
  * @FU_ENGINE_LOAD_FLAG_DEVICE_HOTPLUG:		Set up device hotplug
+ * @FU_ENGINE_LOAD_FLAG_NO_METADATA:	Do not preload the metadata silo or history database
  *
  * The flags to use when loading the engine.
  **/
@@ -48,6 +49,7 @@ typedef enum {
 	FU_ENGINE_LOAD_FLAG_ENSURE_CLIENT_CERT = 1 << 7,
 	FU_ENGINE_LOAD_FLAG_EXTERNAL_PLUGINS = 1 << 8,
 	FU_ENGINE_LOAD_FLAG_DEVICE_HOTPLUG = 1 << 9,
+	FU_ENGINE_LOAD_FLAG_NO_METADATA = 1 << 10,
 	/*< private >*/
 	FU_ENGINE_LOAD_FLAG_LAST
 } FuEngineLoadFlags;
@@ -83,10 +85,17 @@ fu_engine_get_host_security_id(FuEngine *self) G_GNUC_NON_NULL(1);
 FuCabinet *
 fu_engine_build_cabinet_from_stream(FuEngine *self, GInputStream *stream, GError **error)
     G_GNUC_NON_NULL(1, 2);
+FuCabinet *
+fu_engine_build_cabinet_from_stream_full(FuEngine *self,
+					 GInputStream *stream,
+					 gboolean only_metadata,
+					 GError **error) G_GNUC_NON_NULL(1, 2);
 FuEngineConfig *
 fu_engine_get_config(FuEngine *self) G_GNUC_NON_NULL(1);
 GPtrArray *
 fu_engine_get_plugins(FuEngine *self) G_GNUC_NON_NULL(1);
+GVariant *
+fu_engine_get_plugin_timings(FuEngine *self) G_GNUC_NON_NULL(1);
 FuPlugin *
 fu_engine_get_plugin_by_name(FuEngine *self, const gchar *name, GError **error)
     G_GNUC_NON_NULL(1, 2);
@@ -112,6 +121,11 @@ fu_engine_get_releases(FuEngine *self,
 		       FuEngineRequest *request,
 		       const gchar *device_id,
 		       GError **error) G_GNUC_NON_NULL(1, 2, 3);
+GHashTable *
+fu_engine_get_releases_for_devices(FuEngine *self,
+				   FuEngineRequest *request,
+				   GPtrArray *devices,
+				   GError **error) G_GNUC_NON_NULL(1, 2, 3);
 GPtrArray *
 fu_engine_get_downgrades(FuEngine *self,
 			 FuEngineRequest *request,
@@ -130,6 +144,8 @@ FuSecurityAttrs *
 fu_engine_get_host_security_events(FuEngine *self, guint limit, GError **error) G_GNUC_NON_NULL(1);
 GHashTable *
 fu_engine_get_report_metadata(FuEngine *self, GError **error) G_GNUC_NON_NULL(1);
+GHashTable *
+fu_engine_get_metrics(FuEngine *self) G_GNUC_NON_NULL(1);
 gboolean
 fu_engine_clear_results(FuEngine *self, const gchar *device_id, GError **error)
     G_GNUC_NON_NULL(1, 2);
@@ -235,6 +251,8 @@ gboolean
 fu_engine_reset_config(FuEngine *self, const gchar *section, GError **error) G_GNUC_NON_NULL(1, 2);
 FuContext *
 fu_engine_get_context(FuEngine *self) G_GNUC_NON_NULL(1);
+const gchar *
+fu_engine_has_hwid_guids(FuEngine *self, const gchar *guids) G_GNUC_NON_NULL(1, 2);
 GPtrArray *
 fu_engine_get_releases_for_device(FuEngine *self,
 				  FuEngineRequest *request,
@@ -37,8 +37,13 @@
  * v12	add install_duration to history
  * v13	add release_flags to history
  * v14	create table emulation_tag
+ * v15	add history indexes
+ * v16	create table timings
  */
-#define FU_HISTORY_CURRENT_SCHEMA_VERSION 14
+#define FU_HISTORY_CURRENT_SCHEMA_VERSION 16
+
+/* rows untouched for this long are moved into the compressed sidecar */
+#define FU_HISTORY_ARCHIVE_AGE_DAYS 730
 
 static void
 fu_history_finalize(GObject *object);
@@ -48,6 +53,10 @@ struct _FuHistory {
 	FuContext *ctx;
 #ifdef HAVE_SQLITE
 	sqlite3 *db;
+	GRecMutex mutex; /* held for the lifetime of an explicit transaction */
+	GHashTable *stmts; /* (element-type utf8 sqlite3_stmt) */
+	guint transaction_depth;
+	gboolean transaction_failed;
 #endif
 };
 
@@ -189,8 +198,40 @@ fu_history_stmt_exec(FuHistory *self, sqlite3_stmt *stmt, GPtrArray *array, GErr
 			    FWUPD_ERROR_WRITE,
 			    "failed to execute prepared statement: %s",
 			    sqlite3_errmsg(self->db));
+		sqlite3_reset(stmt);
+		return FALSE;
+	}
+
+	/* release any implicit transaction promptly as the statement may be cached */
+	sqlite3_reset(stmt);
+	return TRUE;
+}
+
+static gboolean
+fu_history_stmt_prepare(FuHistory *self, const gchar *sql, sqlite3_stmt **stmt_out, GError **error)
+{
+	gint rc;
+	sqlite3_stmt *stmt;
+
+	/* reuse the compiled statement, clearing any old bindings */
+	stmt = g_hash_table_lookup(self->stmts, sql);
+	if (stmt != NULL) {
+		sqlite3_reset(stmt);
+		sqlite3_clear_bindings(stmt);
+		*stmt_out = stmt;
+		return TRUE;
+	}
+	rc = sqlite3_prepare_v3(self->db, sql, -1, SQLITE_PREPARE_PERSISTENT, &stmt, NULL);
+	if (rc != SQLITE_OK) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_WRITE,
+			    "failed to prepare SQL: %s",
+			    sqlite3_errmsg(self->db));
 		return FALSE;
 	}
+	g_hash_table_insert(self->stmts, g_strdup(sql), stmt);
+	*stmt_out = stmt;
 	return TRUE;
 }
 
@@ -226,6 +267,8 @@ fu_history_create_database(FuHistory *self, GError **error)
 			  "version_format INTEGER DEFAULT 0,"
 			  "install_duration INTEGER DEFAULT 0,"
 			  "release_flags INTEGER DEFAULT 0);"
+			  "CREATE INDEX idx_history_device_id ON history (device_id, device_created);"
+			  "CREATE INDEX idx_history_device_modified ON history (device_modified);"
 			  "CREATE TABLE IF NOT EXISTS approved_firmware ("
 			  "checksum TEXT);"
 			  "CREATE TABLE IF NOT EXISTS blocked_firmware ("
@@ -236,6 +279,13 @@ fu_history_create_database(FuHistory *self, GError **error)
 			  "hsi_score TEXT DEFAULT NULL);"
 			  "CREATE TABLE emulation_tag (device_id TEXT);"
 			  "CREATE UNIQUE INDEX idx_device_id ON emulation_tag (device_id);"
+			  "CREATE TABLE IF NOT EXISTS timings ("
+			  "device_id TEXT,"
+			  "phase TEXT,"
+			  "started INTEGER DEFAULT 0," /* microseconds */
+			  "ended INTEGER DEFAULT 0,"   /* microseconds */
+			  "success INTEGER DEFAULT 0);"
+			  "CREATE INDEX idx_timings_device_id ON timings (device_id);"
 			  "COMMIT;",
 			  NULL,
 			  NULL,
@@ -476,6 +526,64 @@ fu_history_migrate_database_v12(FuHistory *self, GError **error)
 	return TRUE;
 }
 
+static gboolean
+fu_history_migrate_database_v13(FuHistory *self, GError **error)
+{
+	gint rc;
+	rc = sqlite3_exec(
+	    self->db,
+	    "BEGIN TRANSACTION;"
+	    "CREATE INDEX IF NOT EXISTS idx_history_device_id ON history (device_id, device_created);"
+	    "CREATE INDEX IF NOT EXISTS idx_history_device_modified ON history (device_modified);"
+	    "COMMIT;",
+	    NULL,
+	    NULL,
+	    NULL);
+	if (rc != SQLITE_OK) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INTERNAL,
+			    "Failed to create index: %s",
+			    sqlite3_errmsg(self->db));
+		return FALSE;
+	}
+
+	/* one-off full vacuum so that auto_vacuum=INCREMENTAL takes effect on
+	 * databases created before the pragma was set */
+	rc = sqlite3_exec(self->db, "VACUUM;", NULL, NULL, NULL);
+	if (rc != SQLITE_OK)
+		g_debug("failed to vacuum: %s", sqlite3_errmsg(self->db));
+	return TRUE;
+}
+
+static gboolean
+fu_history_migrate_database_v14(FuHistory *self, GError **error)
+{
+	gint rc;
+	rc = sqlite3_exec(self->db,
+			  "BEGIN TRANSACTION;"
+			  "CREATE TABLE IF NOT EXISTS timings ("
+			  "device_id TEXT,"
+			  "phase TEXT,"
+			  "started INTEGER DEFAULT 0," /* microseconds */
+			  "ended INTEGER DEFAULT 0,"   /* microseconds */
+			  "success INTEGER DEFAULT 0);"
+			  "CREATE INDEX IF NOT EXISTS idx_timings_device_id ON timings (device_id);"
+			  "COMMIT;",
+			  NULL,
+			  NULL,
+			  NULL);
+	if (rc != SQLITE_OK) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INTERNAL,
+			    "Failed to create table: %s",
+			    sqlite3_errmsg(self->db));
+		return FALSE;
+	}
+	return TRUE;
+}
+
 /* returns 0 if database is not initialized */
 static guint
 fu_history_get_schema_version(FuHistory *self)
@@ -561,6 +669,14 @@ fu_history_create_or_migrate(FuHistory *self, guint schema_ver, GError **error)
 	case 13:
 		if (!fu_history_migrate_database_v12(self, error))
 			return FALSE;
+	/* fall through */
+	case 14:
+		if (!fu_history_migrate_database_v13(self, error))
+			return FALSE;
+	/* fall through */
+	case 15:
+		if (!fu_history_migrate_database_v14(self, error))
+			return FALSE;
 		/* no longer fall through */
 		break;
 	default:
@@ -602,12 +718,42 @@ fu_history_open(FuHistory *self, const gchar *filename, GError **error)
 
 	/* turn off the lookaside cache */
 	sqlite3_db_config(self->db, SQLITE_DBCONFIG_LOOKASIDE, NULL, 0, 0);
+
+	/* use a write-ahead log so that history writes during a composite update do not pay
+	 * a full journal fsync each, and readers are not blocked by the writer */
+	rc = sqlite3_exec(self->db, "PRAGMA journal_mode=WAL;", NULL, NULL, NULL);
+	if (rc != SQLITE_OK)
+		g_debug("failed to set journal mode: %s", sqlite3_errmsg(self->db));
+	rc = sqlite3_exec(self->db, "PRAGMA synchronous=NORMAL;", NULL, NULL, NULL);
+	if (rc != SQLITE_OK)
+		g_debug("failed to set synchronous mode: %s", sqlite3_errmsg(self->db));
+
+	/* reclaim freed pages a few at a time from the idle housekeeping handler, rather
+	 * than letting the file grow forever or stalling on a full vacuum */
+	rc = sqlite3_exec(self->db, "PRAGMA auto_vacuum=INCREMENTAL;", NULL, NULL, NULL);
+	if (rc != SQLITE_OK)
+		g_debug("failed to set auto_vacuum mode: %s", sqlite3_errmsg(self->db));
 	return TRUE;
 }
 
-static gboolean
+/**
+ * fu_history_load:
+ * @self: a #FuHistory
+ * @error: (nullable): optional return location for an error
+ *
+ * Opens the database and performs any schema migration, if not already done.
+ *
+ * This is called implicitly before every query, but can also be called up-front -- possibly
+ * from a worker thread -- to move the sqlite open cost off the startup path.
+ *
+ * Returns: %TRUE for success
+ *
+ * Since: 2.0.3
+ **/
+gboolean
 fu_history_load(FuHistory *self, GError **error)
 {
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
 	gint rc;
 	guint schema_ver;
 	g_autofree gchar *dirname = NULL;
@@ -701,6 +847,138 @@ fu_history_get_device_flags_filtered(FuDevice *device)
 }
 #endif
 
+/**
+ * fu_history_transaction_begin:
+ * @self: a #FuHistory
+ * @error: (nullable): optional return location for an error
+ *
+ * Starts an explicit transaction, so that several statements are made durable
+ * with a single journal barrier when fu_history_transaction_commit() is called.
+ *
+ * Transactions nest by joining: an inner begin/commit pair inside an open
+ * transaction is a no-op and the outermost commit writes everything.
+ *
+ * Returns: %TRUE for success
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_history_transaction_begin(FuHistory *self, GError **error)
+{
+#ifdef HAVE_SQLITE
+	gint rc;
+
+	g_return_val_if_fail(FU_IS_HISTORY(self), FALSE);
+
+	/* held until the matching commit or rollback so that writers on other
+	 * threads cannot interleave statements into our transaction */
+	g_rec_mutex_lock(&self->mutex);
+
+	/* lazy load */
+	if (!fu_history_load(self, error)) {
+		g_rec_mutex_unlock(&self->mutex);
+		return FALSE;
+	}
+
+	/* join the transaction already in progress */
+	if (self->transaction_depth > 0) {
+		self->transaction_depth++;
+		return TRUE;
+	}
+	rc = sqlite3_exec(self->db, "BEGIN IMMEDIATE;", NULL, NULL, NULL);
+	if (rc != SQLITE_OK) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_WRITE,
+			    "failed to begin transaction: %s",
+			    sqlite3_errmsg(self->db));
+		g_rec_mutex_unlock(&self->mutex);
+		return FALSE;
+	}
+	self->transaction_depth = 1;
+#endif
+	return TRUE;
+}
+
+/**
+ * fu_history_transaction_commit:
+ * @self: a #FuHistory
+ * @error: (nullable): optional return location for an error
+ *
+ * Commits a transaction started with fu_history_transaction_begin().
+ * Only the outermost commit actually writes to the database.
+ *
+ * Returns: %TRUE for success
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_history_transaction_commit(FuHistory *self, GError **error)
+{
+#ifdef HAVE_SQLITE
+	gint rc;
+
+	g_return_val_if_fail(FU_IS_HISTORY(self), FALSE);
+	g_return_val_if_fail(self->transaction_depth > 0, FALSE);
+
+	if (--self->transaction_depth > 0) {
+		g_rec_mutex_unlock(&self->mutex);
+		return TRUE;
+	}
+
+	/* an inner scope rolled back, so there is nothing sane left to commit */
+	if (self->transaction_failed) {
+		self->transaction_failed = FALSE;
+		sqlite3_exec(self->db, "ROLLBACK;", NULL, NULL, NULL);
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_WRITE,
+				    "transaction was already rolled back");
+		g_rec_mutex_unlock(&self->mutex);
+		return FALSE;
+	}
+	rc = sqlite3_exec(self->db, "COMMIT;", NULL, NULL, NULL);
+	g_rec_mutex_unlock(&self->mutex);
+	if (rc != SQLITE_OK) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_WRITE,
+			    "failed to commit transaction: %s",
+			    sqlite3_errmsg(self->db));
+		return FALSE;
+	}
+#endif
+	return TRUE;
+}
+
+/**
+ * fu_history_transaction_rollback:
+ * @self: a #FuHistory
+ *
+ * Abandons a transaction started with fu_history_transaction_begin(); when
+ * nested the rollback is deferred to the outermost scope.
+ *
+ * Since: 2.0.3
+ **/
+void
+fu_history_transaction_rollback(FuHistory *self)
+{
+#ifdef HAVE_SQLITE
+	g_return_if_fail(FU_IS_HISTORY(self));
+	g_return_if_fail(self->transaction_depth > 0);
+
+	if (--self->transaction_depth > 0) {
+		self->transaction_failed = TRUE;
+		g_rec_mutex_unlock(&self->mutex);
+		return;
+	}
+	self->transaction_failed = FALSE;
+	if (sqlite3_exec(self->db, "ROLLBACK;", NULL, NULL, NULL) != SQLITE_OK)
+		g_warning("failed to rollback transaction: %s", sqlite3_errmsg(self->db));
+	g_rec_mutex_unlock(&self->mutex);
+#endif
+}
+
 /**
  * fu_history_modify_device:
  * @self: a #FuHistory
@@ -717,8 +995,8 @@ gboolean
 fu_history_modify_device(FuHistory *self, FuDevice *device, GError **error)
 {
 #ifdef HAVE_SQLITE
-	gint rc;
-	g_autoptr(sqlite3_stmt) stmt = NULL;
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
 
 	g_return_val_if_fail(FU_IS_HISTORY(self), FALSE);
 	g_return_val_if_fail(FU_IS_DEVICE(device), FALSE);
@@ -729,26 +1007,18 @@ fu_history_modify_device(FuHistory *self, FuDevice *device, GError **error)
 
 	/* overwrite entry if it exists */
 	g_debug("modifying device %s [%s]", fu_device_get_name(device), fu_device_get_id(device));
-	rc = sqlite3_prepare_v2(self->db,
-				"UPDATE history SET "
-				"update_state = ?1, "
-				"update_error = ?2, "
-				"checksum_device = ?6, "
-				"device_modified = ?7, "
-				"install_duration = ?8, "
-				"flags = ?3 "
-				"WHERE device_id = ?4;",
-				-1,
-				&stmt,
-				NULL);
-	if (rc != SQLITE_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_INTERNAL,
-			    "Failed to prepare SQL to update history: %s",
-			    sqlite3_errmsg(self->db));
+	if (!fu_history_stmt_prepare(self,
+				     "UPDATE history SET "
+				     "update_state = ?1, "
+				     "update_error = ?2, "
+				     "checksum_device = ?6, "
+				     "device_modified = ?7, "
+				     "install_duration = ?8, "
+				     "flags = ?3 "
+				     "WHERE device_id = ?4;",
+				     &stmt,
+				     error))
 		return FALSE;
-	}
 
 	sqlite3_bind_int(stmt, 1, fu_device_get_update_state(device));
 	sqlite3_bind_text(stmt, 2, fu_device_get_update_error(device), -1, SQLITE_STATIC);
@@ -798,9 +1068,9 @@ fu_history_modify_device_release(FuHistory *self,
 				 GError **error)
 {
 #ifdef HAVE_SQLITE
-	gint rc;
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
 	g_autofree gchar *metadata = NULL;
-	g_autoptr(sqlite3_stmt) stmt = NULL;
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
 
 	g_return_val_if_fail(FU_IS_HISTORY(self), FALSE);
 	g_return_val_if_fail(FU_IS_DEVICE(device), FALSE);
@@ -814,26 +1084,18 @@ fu_history_modify_device_release(FuHistory *self,
 
 	/* overwrite entry if it exists */
 	g_debug("modifying device %s [%s]", fu_device_get_name(device), fu_device_get_id(device));
-	rc = sqlite3_prepare_v2(self->db,
-				"UPDATE history SET "
-				"update_state = ?1, "
-				"update_error = ?2, "
-				"checksum_device = ?6, "
-				"device_modified = ?7, "
-				"metadata = ?8, "
-				"flags = ?3 "
-				"WHERE device_id = ?4;",
-				-1,
-				&stmt,
-				NULL);
-	if (rc != SQLITE_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_INTERNAL,
-			    "Failed to prepare SQL to update history: %s",
-			    sqlite3_errmsg(self->db));
+	if (!fu_history_stmt_prepare(self,
+				     "UPDATE history SET "
+				     "update_state = ?1, "
+				     "update_error = ?2, "
+				     "checksum_device = ?6, "
+				     "device_modified = ?7, "
+				     "metadata = ?8, "
+				     "flags = ?3 "
+				     "WHERE device_id = ?4;",
+				     &stmt,
+				     error))
 		return FALSE;
-	}
 
 	sqlite3_bind_int(stmt, 1, fu_device_get_update_state(device));
 	sqlite3_bind_text(stmt, 2, fu_device_get_update_error(device), -1, SQLITE_STATIC);
@@ -872,11 +1134,11 @@ gboolean
 fu_history_add_device(FuHistory *self, FuDevice *device, FuRelease *release, GError **error)
 {
 #ifdef HAVE_SQLITE
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
 	const gchar *checksum_device;
 	const gchar *checksum = NULL;
-	gint rc;
 	g_autofree gchar *metadata = NULL;
-	g_autoptr(sqlite3_stmt) stmt = NULL;
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
 
 	g_return_val_if_fail(FU_IS_HISTORY(self), FALSE);
 	g_return_val_if_fail(FU_IS_DEVICE(device), FALSE);
@@ -886,9 +1148,15 @@ fu_history_add_device(FuHistory *self, FuDevice *device, FuRelease *release, GEr
 	if (!fu_history_load(self, error))
 		return FALSE;
 
+	/* the delete and insert only need one durability barrier between them */
+	if (!fu_history_transaction_begin(self, error))
+		return FALSE;
+
 	/* ensure all old device(s) with this ID are removed */
-	if (!fu_history_remove_device(self, device, error))
+	if (!fu_history_remove_device(self, device, error)) {
+		fu_history_transaction_rollback(self);
 		return FALSE;
+	}
 	g_debug("add device %s [%s]", fu_device_get_name(device), fu_device_get_id(device));
 	checksum = fwupd_checksum_get_by_kind(fu_release_get_checksums(release), G_CHECKSUM_SHA1);
 	checksum_device =
@@ -898,39 +1166,33 @@ fu_history_add_device(FuHistory *self, FuDevice *device, FuRelease *release, GEr
 	metadata = fu_history_convert_hash_to_string(fu_release_get_metadata(release));
 
 	/* add */
-	rc = sqlite3_prepare_v2(self->db,
-				"INSERT INTO history (device_id,"
-				"update_state,"
-				"update_error,"
-				"flags,"
-				"filename,"
-				"checksum,"
-				"display_name,"
-				"plugin,"
-				"guid_default,"
-				"metadata,"
-				"device_created,"
-				"device_modified,"
-				"version_old,"
-				"version_new,"
-				"checksum_device,"
-				"protocol,"
-				"release_id,"
-				"appstream_id,"
-				"version_format,"
-				"install_duration,"
-				"release_flags) "
-				"VALUES (?1,?2,?3,?4,?5,?6,?7,?8,?9,?10,"
-				"?11,?12,?13,?14,?15,?16,?17,?18,?19,?20,?21)",
-				-1,
-				&stmt,
-				NULL);
-	if (rc != SQLITE_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_INTERNAL,
-			    "Failed to prepare SQL to insert history: %s",
-			    sqlite3_errmsg(self->db));
+	if (!fu_history_stmt_prepare(self,
+				     "INSERT INTO history (device_id,"
+				     "update_state,"
+				     "update_error,"
+				     "flags,"
+				     "filename,"
+				     "checksum,"
+				     "display_name,"
+				     "plugin,"
+				     "guid_default,"
+				     "metadata,"
+				     "device_created,"
+				     "device_modified,"
+				     "version_old,"
+				     "version_new,"
+				     "checksum_device,"
+				     "protocol,"
+				     "release_id,"
+				     "appstream_id,"
+				     "version_format,"
+				     "install_duration,"
+				     "release_flags) "
+				     "VALUES (?1,?2,?3,?4,?5,?6,?7,?8,?9,?10,"
+				     "?11,?12,?13,?14,?15,?16,?17,?18,?19,?20,?21)",
+				     &stmt,
+				     error)) {
+		fu_history_transaction_rollback(self);
 		return FALSE;
 	}
 	sqlite3_bind_text(stmt, 1, fu_device_get_id(device), -1, SQLITE_STATIC);
@@ -954,7 +1216,11 @@ fu_history_add_device(FuHistory *self, FuDevice *device, FuRelease *release, GEr
 	sqlite3_bind_int(stmt, 19, fu_device_get_version_format(device));
 	sqlite3_bind_int(stmt, 20, fu_device_get_install_duration(device));
 	sqlite3_bind_int(stmt, 21, fu_release_get_flags(release));
-	return fu_history_stmt_exec(self, stmt, NULL, error);
+	if (!fu_history_stmt_exec(self, stmt, NULL, error)) {
+		fu_history_transaction_rollback(self);
+		return FALSE;
+	}
+	return fu_history_transaction_commit(self, error);
 #else
 	return TRUE;
 #endif
@@ -975,6 +1241,7 @@ gboolean
 fu_history_remove_all(FuHistory *self, GError **error)
 {
 #ifdef HAVE_SQLITE
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
 	gint rc;
 	g_autoptr(sqlite3_stmt) stmt = NULL;
 
@@ -995,7 +1262,14 @@ fu_history_remove_all(FuHistory *self, GError **error)
 			    sqlite3_errmsg(self->db));
 		return FALSE;
 	}
-	return fu_history_stmt_exec(self, stmt, NULL, error);
+	if (!fu_history_stmt_exec(self, stmt, NULL, error))
+		return FALSE;
+
+	/* the timings make no sense without the history rows */
+	rc = sqlite3_exec(self->db, "DELETE FROM timings;", NULL, NULL, NULL);
+	if (rc != SQLITE_OK)
+		g_debug("failed to clear timings: %s", sqlite3_errmsg(self->db));
+	return TRUE;
 #else
 	g_set_error(error, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED, "no sqlite support");
 	return FALSE;
@@ -1018,8 +1292,8 @@ gboolean
 fu_history_remove_device(FuHistory *self, FuDevice *device, GError **error)
 {
 #ifdef HAVE_SQLITE
-	gint rc;
-	g_autoptr(sqlite3_stmt) stmt = NULL;
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
 
 	g_return_val_if_fail(FU_IS_HISTORY(self), FALSE);
 	g_return_val_if_fail(FU_IS_DEVICE(device), FALSE);
@@ -1029,19 +1303,21 @@ fu_history_remove_device(FuHistory *self, FuDevice *device, GError **error)
 		return FALSE;
 
 	g_debug("remove device %s [%s]", fu_device_get_name(device), fu_device_get_id(device));
-	rc = sqlite3_prepare_v2(self->db,
-				"DELETE FROM history WHERE device_id = ?1;",
-				-1,
-				&stmt,
-				NULL);
-	if (rc != SQLITE_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_INTERNAL,
-			    "Failed to prepare SQL to delete history: %s",
-			    sqlite3_errmsg(self->db));
+	if (!fu_history_stmt_prepare(self,
+				     "DELETE FROM history WHERE device_id = ?1;",
+				     &stmt,
+				     error))
+		return FALSE;
+	sqlite3_bind_text(stmt, 1, fu_device_get_id(device), -1, SQLITE_STATIC);
+	if (!fu_history_stmt_exec(self, stmt, NULL, error))
+		return FALSE;
+
+	/* the timings make no sense without the history row */
+	if (!fu_history_stmt_prepare(self,
+				     "DELETE FROM timings WHERE device_id = ?1;",
+				     &stmt,
+				     error))
 		return FALSE;
-	}
 	sqlite3_bind_text(stmt, 1, fu_device_get_id(device), -1, SQLITE_STATIC);
 	return fu_history_stmt_exec(self, stmt, NULL, error);
 #else
@@ -1065,9 +1341,9 @@ FuDevice *
 fu_history_get_device_by_id(FuHistory *self, const gchar *device_id, GError **error)
 {
 #ifdef HAVE_SQLITE
-	gint rc;
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
 	g_autoptr(GPtrArray) array_tmp = NULL;
-	g_autoptr(sqlite3_stmt) stmt = NULL;
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
 
 	g_return_val_if_fail(FU_IS_HISTORY(self), NULL);
 	g_return_val_if_fail(device_id != NULL, NULL);
@@ -1077,41 +1353,33 @@ fu_history_get_device_by_id(FuHistory *self, const gchar *device_id, GError **er
 		return NULL;
 
 	/* get all the devices */
-	rc = sqlite3_prepare_v2(self->db,
-				"SELECT device_id, "
-				"checksum, "
-				"plugin, "
-				"device_created, "
-				"device_modified, "
-				"display_name, "
-				"filename, "
-				"flags, "
-				"metadata, "
-				"guid_default, "
-				"update_state, "
-				"update_error, "
-				"version_new, "
-				"version_old, "
-				"checksum_device, "
-				"protocol, "
-				"release_id, "
-				"appstream_id, "
-				"version_format, "
-				"install_duration, "
-				"release_flags FROM history WHERE "
-				"device_id = ?1 ORDER BY device_created DESC "
-				"LIMIT 1",
-				-1,
-				&stmt,
-				NULL);
-	if (rc != SQLITE_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_INTERNAL,
-			    "Failed to prepare SQL to get history: %s",
-			    sqlite3_errmsg(self->db));
+	if (!fu_history_stmt_prepare(self,
+				     "SELECT device_id, "
+				     "checksum, "
+				     "plugin, "
+				     "device_created, "
+				     "device_modified, "
+				     "display_name, "
+				     "filename, "
+				     "flags, "
+				     "metadata, "
+				     "guid_default, "
+				     "update_state, "
+				     "update_error, "
+				     "version_new, "
+				     "version_old, "
+				     "checksum_device, "
+				     "protocol, "
+				     "release_id, "
+				     "appstream_id, "
+				     "version_format, "
+				     "install_duration, "
+				     "release_flags FROM history WHERE "
+				     "device_id = ?1 ORDER BY device_created DESC "
+				     "LIMIT 1",
+				     &stmt,
+				     error))
 		return NULL;
-	}
 	sqlite3_bind_text(stmt, 1, device_id, -1, SQLITE_STATIC);
 	array_tmp = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
 	if (!fu_history_stmt_exec(self, stmt, array_tmp, error))
@@ -1143,8 +1411,8 @@ fu_history_get_devices(FuHistory *self, GError **error)
 {
 	g_autoptr(GPtrArray) array = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
 #ifdef HAVE_SQLITE
-	g_autoptr(sqlite3_stmt) stmt = NULL;
-	gint rc;
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
 
 	g_return_val_if_fail(FU_IS_HISTORY(self), NULL);
 
@@ -1155,40 +1423,32 @@ fu_history_get_devices(FuHistory *self, GError **error)
 	}
 
 	/* get all the devices */
-	rc = sqlite3_prepare_v2(self->db,
-				"SELECT device_id, "
-				"checksum, "
-				"plugin, "
-				"device_created, "
-				"device_modified, "
-				"display_name, "
-				"filename, "
-				"flags, "
-				"metadata, "
-				"guid_default, "
-				"update_state, "
-				"update_error, "
-				"version_new, "
-				"version_old, "
-				"checksum_device, "
-				"protocol, "
-				"release_id, "
-				"appstream_id, "
-				"version_format, "
-				"install_duration, "
-				"release_flags FROM history "
-				"ORDER BY device_modified ASC;",
-				-1,
-				&stmt,
-				NULL);
-	if (rc != SQLITE_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_INTERNAL,
-			    "Failed to prepare SQL to get history: %s",
-			    sqlite3_errmsg(self->db));
+	if (!fu_history_stmt_prepare(self,
+				     "SELECT device_id, "
+				     "checksum, "
+				     "plugin, "
+				     "device_created, "
+				     "device_modified, "
+				     "display_name, "
+				     "filename, "
+				     "flags, "
+				     "metadata, "
+				     "guid_default, "
+				     "update_state, "
+				     "update_error, "
+				     "version_new, "
+				     "version_old, "
+				     "checksum_device, "
+				     "protocol, "
+				     "release_id, "
+				     "appstream_id, "
+				     "version_format, "
+				     "install_duration, "
+				     "release_flags FROM history "
+				     "ORDER BY device_modified ASC;",
+				     &stmt,
+				     error))
 		return NULL;
-	}
 	if (!fu_history_stmt_exec(self, stmt, array, error))
 		return NULL;
 #endif
@@ -1211,8 +1471,9 @@ fu_history_get_approved_firmware(FuHistory *self, GError **error)
 {
 	g_autoptr(GPtrArray) array = g_ptr_array_new_with_free_func(g_free);
 #ifdef HAVE_SQLITE
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
 	gint rc;
-	g_autoptr(sqlite3_stmt) stmt = NULL;
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
 
 	g_return_val_if_fail(FU_IS_HISTORY(self), NULL);
 
@@ -1223,19 +1484,11 @@ fu_history_get_approved_firmware(FuHistory *self, GError **error)
 	}
 
 	/* get all the approved firmware */
-	rc = sqlite3_prepare_v2(self->db,
-				"SELECT checksum FROM approved_firmware;",
-				-1,
-				&stmt,
-				NULL);
-	if (rc != SQLITE_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_INTERNAL,
-			    "Failed to prepare SQL to get checksum: %s",
-			    sqlite3_errmsg(self->db));
+	if (!fu_history_stmt_prepare(self,
+				     "SELECT checksum FROM approved_firmware;",
+				     &stmt,
+				     error))
 		return NULL;
-	}
 	while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
 		const gchar *tmp = (const gchar *)sqlite3_column_text(stmt, 0);
 		g_ptr_array_add(array, g_strdup(tmp));
@@ -1267,6 +1520,7 @@ gboolean
 fu_history_clear_approved_firmware(FuHistory *self, GError **error)
 {
 #ifdef HAVE_SQLITE
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
 	gint rc;
 	g_autoptr(sqlite3_stmt) stmt = NULL;
 
@@ -1309,8 +1563,8 @@ gboolean
 fu_history_add_approved_firmware(FuHistory *self, const gchar *checksum, GError **error)
 {
 #ifdef HAVE_SQLITE
-	gint rc;
-	g_autoptr(sqlite3_stmt) stmt = NULL;
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
 
 	g_return_val_if_fail(FU_IS_HISTORY(self), FALSE);
 	g_return_val_if_fail(checksum != NULL, FALSE);
@@ -1320,20 +1574,12 @@ fu_history_add_approved_firmware(FuHistory *self, const gchar *checksum, GError
 		return FALSE;
 
 	/* add */
-	rc = sqlite3_prepare_v2(self->db,
-				"INSERT INTO approved_firmware (checksum) "
-				"VALUES (?1)",
-				-1,
-				&stmt,
-				NULL);
-	if (rc != SQLITE_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_INTERNAL,
-			    "Failed to prepare SQL to insert checksum: %s",
-			    sqlite3_errmsg(self->db));
+	if (!fu_history_stmt_prepare(self,
+				     "INSERT INTO approved_firmware (checksum) "
+				     "VALUES (?1)",
+				     &stmt,
+				     error))
 		return FALSE;
-	}
 	sqlite3_bind_text(stmt, 1, checksum, -1, SQLITE_STATIC);
 	return fu_history_stmt_exec(self, stmt, NULL, error);
 #else
@@ -1358,6 +1604,7 @@ fu_history_get_blocked_firmware(FuHistory *self, GError **error)
 {
 	g_autoptr(GPtrArray) array = g_ptr_array_new_with_free_func(g_free);
 #ifdef HAVE_SQLITE
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
 	gint rc;
 	g_autoptr(sqlite3_stmt) stmt = NULL;
 
@@ -1411,6 +1658,7 @@ gboolean
 fu_history_clear_blocked_firmware(FuHistory *self, GError **error)
 {
 #ifdef HAVE_SQLITE
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
 	gint rc;
 	g_autoptr(sqlite3_stmt) stmt = NULL;
 
@@ -1453,8 +1701,8 @@ gboolean
 fu_history_add_blocked_firmware(FuHistory *self, const gchar *checksum, GError **error)
 {
 #ifdef HAVE_SQLITE
-	gint rc;
-	g_autoptr(sqlite3_stmt) stmt = NULL;
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
 
 	g_return_val_if_fail(FU_IS_HISTORY(self), FALSE);
 	g_return_val_if_fail(checksum != NULL, FALSE);
@@ -1464,20 +1712,12 @@ fu_history_add_blocked_firmware(FuHistory *self, const gchar *checksum, GError *
 		return FALSE;
 
 	/* add */
-	rc = sqlite3_prepare_v2(self->db,
-				"INSERT INTO blocked_firmware (checksum) "
-				"VALUES (?1)",
-				-1,
-				&stmt,
-				NULL);
-	if (rc != SQLITE_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_INTERNAL,
-			    "Failed to prepare SQL to insert checksum: %s",
-			    sqlite3_errmsg(self->db));
+	if (!fu_history_stmt_prepare(self,
+				     "INSERT INTO blocked_firmware (checksum) "
+				     "VALUES (?1)",
+				     &stmt,
+				     error))
 		return FALSE;
-	}
 	sqlite3_bind_text(stmt, 1, checksum, -1, SQLITE_STATIC);
 	return fu_history_stmt_exec(self, stmt, NULL, error);
 #else
@@ -1493,8 +1733,8 @@ fu_history_add_security_attribute(FuHistory *self,
 				  GError **error)
 {
 #ifdef HAVE_SQLITE
-	gint rc;
-	g_autoptr(sqlite3_stmt) stmt = NULL;
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
 
 	g_return_val_if_fail(FU_IS_HISTORY(self), FALSE);
 
@@ -1503,20 +1743,12 @@ fu_history_add_security_attribute(FuHistory *self,
 		return FALSE;
 
 	/* remove entries */
-	rc = sqlite3_prepare_v2(self->db,
-				"INSERT INTO hsi_history (hsi_details, hsi_score)"
-				"VALUES (?1, ?2)",
-				-1,
-				&stmt,
-				NULL);
-	if (rc != SQLITE_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_INTERNAL,
-			    "Failed to prepare SQL to write security attribute: %s",
-			    sqlite3_errmsg(self->db));
+	if (!fu_history_stmt_prepare(self,
+				     "INSERT INTO hsi_history (hsi_details, hsi_score)"
+				     "VALUES (?1, ?2)",
+				     &stmt,
+				     error))
 		return FALSE;
-	}
 	sqlite3_bind_text(stmt, 1, security_attr_json, -1, SQLITE_STATIC);
 	sqlite3_bind_text(stmt, 2, hsi_score, -1, SQLITE_STATIC);
 	return fu_history_stmt_exec(self, stmt, NULL, error);
@@ -1544,7 +1776,8 @@ fu_history_get_security_attrs(FuHistory *self, guint limit, GError **error)
 {
 	g_autoptr(GPtrArray) array = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
 #ifdef HAVE_SQLITE
-	g_autoptr(sqlite3_stmt) stmt = NULL;
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
 	gint rc;
 	guint old_hash = 0;
 
@@ -1557,20 +1790,12 @@ fu_history_get_security_attrs(FuHistory *self, guint limit, GError **error)
 	}
 
 	/* get all the devices */
-	rc = sqlite3_prepare_v2(self->db,
-				"SELECT timestamp, hsi_details FROM hsi_history "
-				"ORDER BY timestamp DESC;",
-				-1,
-				&stmt,
-				NULL);
-	if (rc != SQLITE_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_INTERNAL,
-			    "Failed to prepare SQL to get security attrs: %s",
-			    sqlite3_errmsg(self->db));
+	if (!fu_history_stmt_prepare(self,
+				     "SELECT timestamp, hsi_details FROM hsi_history "
+				     "ORDER BY timestamp DESC;",
+				     &stmt,
+				     error))
 		return NULL;
-	}
 	while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
 		const gchar *json;
 		guint hash;
@@ -1648,6 +1873,7 @@ gboolean
 fu_history_has_emulation_tag(FuHistory *self, const gchar *device_id, GError **error)
 {
 #ifdef HAVE_SQLITE
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
 	gint rc;
 	g_autoptr(sqlite3_stmt) stmt = NULL;
 
@@ -1732,8 +1958,8 @@ gboolean
 fu_history_add_emulation_tag(FuHistory *self, const gchar *device_id, GError **error)
 {
 #ifdef HAVE_SQLITE
-	gint rc;
-	g_autoptr(sqlite3_stmt) stmt = NULL;
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
 
 	g_return_val_if_fail(FU_IS_HISTORY(self), FALSE);
 	g_return_val_if_fail(device_id != NULL, FALSE);
@@ -1743,20 +1969,12 @@ fu_history_add_emulation_tag(FuHistory *self, const gchar *device_id, GError **e
 		return FALSE;
 
 	/* add */
-	rc = sqlite3_prepare_v2(self->db,
-				"INSERT INTO emulation_tag (device_id) "
-				"VALUES (?1)",
-				-1,
-				&stmt,
-				NULL);
-	if (rc != SQLITE_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_INTERNAL,
-			    "failed to prepare SQL to insert emulation tag: %s",
-			    sqlite3_errmsg(self->db));
+	if (!fu_history_stmt_prepare(self,
+				     "INSERT INTO emulation_tag (device_id) "
+				     "VALUES (?1)",
+				     &stmt,
+				     error))
 		return FALSE;
-	}
 	sqlite3_bind_text(stmt, 1, device_id, -1, SQLITE_STATIC);
 	return fu_history_stmt_exec(self, stmt, NULL, error);
 #else
@@ -1780,8 +1998,8 @@ gboolean
 fu_history_remove_emulation_tag(FuHistory *self, const gchar *device_id, GError **error)
 {
 #ifdef HAVE_SQLITE
-	gint rc;
-	g_autoptr(sqlite3_stmt) stmt = NULL;
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
 
 	g_return_val_if_fail(FU_IS_HISTORY(self), FALSE);
 	g_return_val_if_fail(device_id != NULL, FALSE);
@@ -1791,19 +2009,11 @@ fu_history_remove_emulation_tag(FuHistory *self, const gchar *device_id, GError
 		return FALSE;
 
 	/* remove entries */
-	rc = sqlite3_prepare_v2(self->db,
-				"DELETE FROM emulation_tag WHERE device_id = ?1;",
-				-1,
-				&stmt,
-				NULL);
-	if (rc != SQLITE_OK) {
-		g_set_error(error,
-			    FWUPD_ERROR,
-			    FWUPD_ERROR_INTERNAL,
-			    "Failed to prepare SQL to delete emulation tag: %s",
-			    sqlite3_errmsg(self->db));
+	if (!fu_history_stmt_prepare(self,
+				     "DELETE FROM emulation_tag WHERE device_id = ?1;",
+				     &stmt,
+				     error))
 		return FALSE;
-	}
 	sqlite3_bind_text(stmt, 1, device_id, -1, SQLITE_STATIC);
 	return fu_history_stmt_exec(self, stmt, NULL, error);
 #else
@@ -1812,13 +2022,253 @@ fu_history_remove_emulation_tag(FuHistory *self, const gchar *device_id, GError
 #endif
 }
 
+/**
+ * fu_history_add_timing:
+ * @self: a #FuHistory
+ * @device: a device
+ * @phase: an install phase, e.g. `detach`
+ * @started: the phase start time in microseconds
+ * @ended: the phase end time in microseconds
+ * @success: if the phase completed without an error
+ * @error: (nullable): optional return location for an error
+ *
+ * Records how long an install phase took for a specific device, so that per-phase
+ * latency can be reviewed after the event without scraping the journal.
+ *
+ * Returns: #TRUE for success, #FALSE for failure
+ *
+ * Since: 2.0.3
+ **/
+gboolean
+fu_history_add_timing(FuHistory *self,
+		      FuDevice *device,
+		      const gchar *phase,
+		      gint64 started,
+		      gint64 ended,
+		      gboolean success,
+		      GError **error)
+{
+#ifdef HAVE_SQLITE
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
+
+	g_return_val_if_fail(FU_IS_HISTORY(self), FALSE);
+	g_return_val_if_fail(FU_IS_DEVICE(device), FALSE);
+	g_return_val_if_fail(phase != NULL, FALSE);
+
+	/* lazy load */
+	if (!fu_history_load(self, error))
+		return FALSE;
+
+	/* add */
+	if (!fu_history_stmt_prepare(self,
+				     "INSERT INTO timings (device_id, phase, started, ended, "
+				     "success) VALUES (?1, ?2, ?3, ?4, ?5)",
+				     &stmt,
+				     error))
+		return FALSE;
+	sqlite3_bind_text(stmt, 1, fu_device_get_id(device), -1, SQLITE_STATIC);
+	sqlite3_bind_text(stmt, 2, phase, -1, SQLITE_STATIC);
+	sqlite3_bind_int64(stmt, 3, started);
+	sqlite3_bind_int64(stmt, 4, ended);
+	sqlite3_bind_int(stmt, 5, success ? 1 : 0);
+	return fu_history_stmt_exec(self, stmt, NULL, error);
+#else
+	g_set_error(error, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED, "no sqlite support");
+	return FALSE;
+#endif
+}
+
+/**
+ * fu_history_get_timings:
+ * @self: a #FuHistory
+ * @device_id: a device ID
+ * @error: (nullable): optional return location for an error
+ *
+ * Gets the phase durations in milliseconds for the most recent update of a device.
+ *
+ * Returns: (transfer full) (element-type utf8 utf8): map of phase name to duration
+ *
+ * Since: 2.0.3
+ **/
+GHashTable *
+fu_history_get_timings(FuHistory *self, const gchar *device_id, GError **error)
+{
+	g_autoptr(GHashTable) hash =
+	    g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+#ifdef HAVE_SQLITE
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
+	gint rc;
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
+
+	g_return_val_if_fail(FU_IS_HISTORY(self), NULL);
+	g_return_val_if_fail(device_id != NULL, NULL);
+
+	/* lazy load */
+	if (self->db == NULL) {
+		if (!fu_history_load(self, error))
+			return NULL;
+	}
+
+	/* walk in started order so that later installs replace earlier ones */
+	if (!fu_history_stmt_prepare(self,
+				     "SELECT phase, started, ended FROM timings WHERE "
+				     "device_id = ?1 ORDER BY started ASC;",
+				     &stmt,
+				     error))
+		return NULL;
+	sqlite3_bind_text(stmt, 1, device_id, -1, SQLITE_STATIC);
+	while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+		const gchar *phase = (const gchar *)sqlite3_column_text(stmt, 0);
+		gint64 duration = sqlite3_column_int64(stmt, 2) - sqlite3_column_int64(stmt, 1);
+		if (phase == NULL)
+			continue;
+		g_hash_table_insert(hash,
+				    g_strdup(phase),
+				    g_strdup_printf("%" G_GINT64_FORMAT,
+						    duration / 1000)); /* ms */
+	}
+	if (rc != SQLITE_DONE) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_WRITE,
+			    "failed to execute prepared statement: %s",
+			    sqlite3_errmsg(self->db));
+		sqlite3_reset(stmt);
+		return NULL;
+	}
+	sqlite3_reset(stmt);
+#endif
+	return g_steal_pointer(&hash);
+}
+
+#ifdef HAVE_SQLITE
+static gboolean
+fu_history_archive_old_devices(FuHistory *self, GError **error)
+{
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
+	gint64 cutoff;
+	gsize len = 0;
+	sqlite3_stmt *stmt = NULL; /* borrowed from the cache */
+	g_autofree gchar *data = NULL;
+	g_autofree gchar *dirname = NULL;
+	g_autofree gchar *fn = NULL;
+	g_autoptr(GConverter) conv = NULL;
+	g_autoptr(GFile) file = NULL;
+	g_autoptr(GFileOutputStream) ostr = NULL;
+	g_autoptr(GOutputStream) cstr = NULL;
+	g_autoptr(GPtrArray) array = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	g_autoptr(JsonBuilder) builder = NULL;
+	g_autoptr(JsonGenerator) generator = NULL;
+	g_autoptr(JsonNode) root = NULL;
+
+	/* find anything not modified for a very long time */
+	cutoff = (g_get_real_time() / G_USEC_PER_SEC) -
+		 ((gint64)FU_HISTORY_ARCHIVE_AGE_DAYS * 24 * 60 * 60);
+	if (!fu_history_stmt_prepare(self,
+				     "SELECT device_id, "
+				     "checksum, "
+				     "plugin, "
+				     "device_created, "
+				     "device_modified, "
+				     "display_name, "
+				     "filename, "
+				     "flags, "
+				     "metadata, "
+				     "guid_default, "
+				     "update_state, "
+				     "update_error, "
+				     "version_new, "
+				     "version_old, "
+				     "checksum_device, "
+				     "protocol, "
+				     "release_id, "
+				     "appstream_id, "
+				     "version_format, "
+				     "install_duration, "
+				     "release_flags FROM history WHERE "
+				     "device_modified > 0 AND device_modified < ?1;",
+				     &stmt,
+				     error))
+		return FALSE;
+	sqlite3_bind_int64(stmt, 1, cutoff);
+	if (!fu_history_stmt_exec(self, stmt, array, error))
+		return FALSE;
+	if (array->len == 0)
+		return TRUE;
+
+	/* export the rows as JSON */
+	builder = json_builder_new();
+	json_builder_begin_object(builder);
+	fwupd_codec_array_to_json(array, "Devices", builder, FWUPD_CODEC_FLAG_TRUSTED);
+	json_builder_end_object(builder);
+	root = json_builder_get_root(builder);
+	generator = json_generator_new();
+	json_generator_set_pretty(generator, TRUE);
+	json_generator_set_root(generator, root);
+	data = json_generator_to_data(generator, &len);
+	if (data == NULL) {
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INTERNAL,
+				    "Failed to convert to JSON string");
+		return FALSE;
+	}
+
+	/* append as a new gzip member to the sidecar */
+	dirname = fu_path_from_kind(FU_PATH_KIND_LOCALSTATEDIR_PKG);
+	fn = g_build_filename(dirname, "pending-archive.json.gz", NULL);
+	file = g_file_new_for_path(fn);
+	ostr = g_file_append_to(file, G_FILE_CREATE_PRIVATE, NULL, error);
+	if (ostr == NULL)
+		return FALSE;
+	conv = G_CONVERTER(g_zlib_compressor_new(G_ZLIB_COMPRESSOR_FORMAT_GZIP, -1));
+	cstr = g_converter_output_stream_new(G_OUTPUT_STREAM(ostr), conv);
+	if (!g_output_stream_write_all(cstr, data, len, NULL, NULL, error))
+		return FALSE;
+	if (!g_output_stream_close(cstr, NULL, error))
+		return FALSE;
+
+	/* only now is it safe to drop the rows */
+	if (!fu_history_stmt_prepare(self,
+				     "DELETE FROM history WHERE "
+				     "device_modified > 0 AND device_modified < ?1;",
+				     &stmt,
+				     error))
+		return FALSE;
+	sqlite3_bind_int64(stmt, 1, cutoff);
+	if (!fu_history_stmt_exec(self, stmt, NULL, error))
+		return FALSE;
+
+	/* success */
+	g_info("archived %u old history entries to %s", array->len, fn);
+	return TRUE;
+}
+#endif
+
 static void
 fu_history_housekeeping_cb(FuContext *ctx, FuHistory *self)
 {
 #ifdef HAVE_SQLITE
-	sqlite3_release_memory(G_MAXINT32);
-	if (self->db != NULL)
+	g_autoptr(GRecMutexLocker) locker = g_rec_mutex_locker_new(&self->mutex);
+
+	/* move ancient rows into the compressed sidecar, then compact the file a little;
+	 * do not force open the database just for this */
+	if (self->db != NULL) {
+		gint rc;
+		g_autoptr(GError) error_local = NULL;
+		if (!fu_history_archive_old_devices(self, &error_local))
+			g_warning("failed to archive old history entries: %s",
+				  error_local->message);
+		rc = sqlite3_exec(self->db, "PRAGMA incremental_vacuum(256);", NULL, NULL, NULL);
+		if (rc != SQLITE_OK)
+			g_debug("failed to vacuum: %s", sqlite3_errmsg(self->db));
+		rc = sqlite3_exec(self->db, "PRAGMA wal_checkpoint(TRUNCATE);", NULL, NULL, NULL);
+		if (rc != SQLITE_OK)
+			g_debug("failed to checkpoint: %s", sqlite3_errmsg(self->db));
 		sqlite3_db_release_memory(self->db);
+	}
+	sqlite3_release_memory(G_MAXINT32);
 #endif
 }
 
@@ -1843,6 +2293,13 @@ fu_history_class_init(FuHistoryClass *klass)
 static void
 fu_history_init(FuHistory *self)
 {
+#ifdef HAVE_SQLITE
+	g_rec_mutex_init(&self->mutex);
+	self->stmts = g_hash_table_new_full(g_str_hash,
+					    g_str_equal,
+					    g_free,
+					    (GDestroyNotify)sqlite3_finalize);
+#endif
 }
 
 static void
@@ -1850,8 +2307,10 @@ fu_history_finalize(GObject *object)
 {
 #ifdef HAVE_SQLITE
 	FuHistory *self = FU_HISTORY(object);
+	g_hash_table_unref(self->stmts);
 	if (self->db != NULL)
 		sqlite3_close(self->db);
+	g_rec_mutex_clear(&self->mutex);
 #endif
 
 	G_OBJECT_CLASS(fu_history_parent_class)->finalize(object);
@@ -16,6 +16,14 @@ G_DECLARE_FINAL_TYPE(FuHistory, fu_history, FU, HISTORY, GObject)
 FuHistory *
 fu_history_new(FuContext *ctx);
 
+gboolean
+fu_history_load(FuHistory *self, GError **error) G_GNUC_NON_NULL(1);
+gboolean
+fu_history_transaction_begin(FuHistory *self, GError **error) G_GNUC_NON_NULL(1);
+gboolean
+fu_history_transaction_commit(FuHistory *self, GError **error) G_GNUC_NON_NULL(1);
+void
+fu_history_transaction_rollback(FuHistory *self) G_GNUC_NON_NULL(1);
 gboolean
 fu_history_add_device(FuHistory *self, FuDevice *device, FuRelease *release, GError **error)
     G_GNUC_NON_NULL(1, 2, 3);
@@ -58,6 +66,18 @@ fu_history_add_security_attribute(FuHistory *self,
 GPtrArray *
 fu_history_get_security_attrs(FuHistory *self, guint limit, GError **error) G_GNUC_NON_NULL(1);
 
+gboolean
+fu_history_add_timing(FuHistory *self,
+		      FuDevice *device,
+		      const gchar *phase,
+		      gint64 started,
+		      gint64 ended,
+		      gboolean success,
+		      GError **error) G_GNUC_NON_NULL(1, 2, 3);
+GHashTable *
+fu_history_get_timings(FuHistory *self, const gchar *device_id, GError **error)
+    G_GNUC_NON_NULL(1, 2);
+
 gboolean
 fu_history_add_emulation_tag(FuHistory *self, const gchar *device_id, GError **error)
     G_GNUC_NON_NULL(1, 2);
@@ -18,10 +18,12 @@ struct _FuIdle {
 	GPtrArray *items; /* of FuIdleItem */
 	guint idle_id;
 	guint timeout;
+	guint trim_id;
+	guint timeout_trim;
 	FuIdleInhibit inhibit_old;
 };
 
-enum { SIGNAL_INHIBIT_CHANGED, SIGNAL_TIMEOUT, SIGNAL_LAST };
+enum { SIGNAL_INHIBIT_CHANGED, SIGNAL_TIMEOUT, SIGNAL_TIMEOUT_TRIM, SIGNAL_LAST };
 
 static guint signals[SIGNAL_LAST] = {0};
 
@@ -41,23 +43,44 @@ fu_idle_check_cb(gpointer user_data)
 	return G_SOURCE_CONTINUE;
 }
 
+static gboolean
+fu_idle_check_trim_cb(gpointer user_data)
+{
+	FuIdle *self = FU_IDLE(user_data);
+	g_signal_emit(self, signals[SIGNAL_TIMEOUT_TRIM], 0);
+	self->trim_id = 0;
+	return G_SOURCE_REMOVE;
+}
+
 static void
 fu_idle_start(FuIdle *self)
 {
-	if (self->idle_id != 0)
-		return;
-	if (self->timeout == 0)
-		return;
-	self->idle_id = g_timeout_add_seconds(self->timeout, fu_idle_check_cb, self);
+	if (self->idle_id == 0 && self->timeout != 0 &&
+	    !fu_idle_has_inhibit(self, FU_IDLE_INHIBIT_TIMEOUT)) {
+		self->idle_id = g_timeout_add_seconds(self->timeout, fu_idle_check_cb, self);
+	}
+
+	/* the trim timer also runs when the shutdown timeout has been disabled or inhibited,
+	 * e.g. by a plugin that needs the daemon to stay resident -- but not during an
+	 * actual transaction */
+	if (self->trim_id == 0 && self->timeout_trim != 0 &&
+	    !fu_idle_has_inhibit(self, FU_IDLE_INHIBIT_SIGNALS)) {
+		self->trim_id =
+		    g_timeout_add_seconds(self->timeout_trim, fu_idle_check_trim_cb, self);
+	}
 }
 
 static void
 fu_idle_stop(FuIdle *self)
 {
-	if (self->idle_id == 0)
-		return;
-	g_source_remove(self->idle_id);
-	self->idle_id = 0;
+	if (self->idle_id != 0) {
+		g_source_remove(self->idle_id);
+		self->idle_id = 0;
+	}
+	if (self->trim_id != 0) {
+		g_source_remove(self->trim_id);
+		self->trim_id = 0;
+	}
 }
 
 static void
@@ -83,8 +106,7 @@ fu_idle_reset(FuIdle *self)
 {
 	g_return_if_fail(FU_IS_IDLE(self));
 	fu_idle_stop(self);
-	if (!fu_idle_has_inhibit(self, FU_IDLE_INHIBIT_TIMEOUT))
-		fu_idle_start(self);
+	fu_idle_start(self);
 }
 
 void
@@ -148,6 +170,15 @@ fu_idle_set_timeout(FuIdle *self, guint timeout)
 	fu_idle_reset(self);
 }
 
+void
+fu_idle_set_timeout_trim(FuIdle *self, guint timeout_trim)
+{
+	g_return_if_fail(FU_IS_IDLE(self));
+	g_debug("setting trim timeout to %us", timeout_trim);
+	self->timeout_trim = timeout_trim;
+	fu_idle_reset(self);
+}
+
 static void
 fu_idle_item_free(FuIdleItem *item)
 {
@@ -199,6 +230,15 @@ fu_idle_class_init(FuIdleClass *klass)
 					       g_cclosure_marshal_VOID__VOID,
 					       G_TYPE_NONE,
 					       0);
+	signals[SIGNAL_TIMEOUT_TRIM] = g_signal_new("timeout-trim",
+						    G_TYPE_FROM_CLASS(object_class),
+						    G_SIGNAL_RUN_LAST,
+						    0,
+						    NULL,
+						    NULL,
+						    g_cclosure_marshal_VOID__VOID,
+						    G_TYPE_NONE,
+						    0);
 }
 
 static void
@@ -24,6 +24,8 @@ fu_idle_has_inhibit(FuIdle *self, FuIdleInhibit inhibit) G_GNUC_NON_NULL(1);
 void
 fu_idle_set_timeout(FuIdle *self, guint timeout) G_GNUC_NON_NULL(1);
 void
+fu_idle_set_timeout_trim(FuIdle *self, guint timeout_trim) G_GNUC_NON_NULL(1);
+void
 fu_idle_reset(FuIdle *self) G_GNUC_NON_NULL(1);
 
 /**
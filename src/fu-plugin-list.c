@@ -160,6 +160,94 @@ fu_plugin_list_sort_cb(gconstpointer a, gconstpointer b)
 	return fu_plugin_order_compare(*pa, *pb);
 }
 
+typedef struct {
+	FuPlugin *plugin; /* noref */
+	GPtrArray *edges; /* noref, of FuPluginListNode that have to be ordered later */
+	guint edges_in;
+	guint level;
+} FuPluginListNode;
+
+static void
+fu_plugin_list_node_free(FuPluginListNode *node)
+{
+	g_ptr_array_unref(node->edges);
+	g_free(node);
+}
+
+static GHashTable *
+fu_plugin_list_nodes_new(FuPluginList *self)
+{
+	GHashTable *nodes = g_hash_table_new_full(g_str_hash,
+						  g_str_equal,
+						  NULL,
+						  (GDestroyNotify)fu_plugin_list_node_free);
+	for (guint i = 0; i < self->plugins->len; i++) {
+		FuPlugin *plugin = g_ptr_array_index(self->plugins, i);
+		FuPluginListNode *node = g_new0(FuPluginListNode, 1);
+		node->plugin = plugin;
+		node->edges = g_ptr_array_new();
+		g_hash_table_insert(nodes, (gpointer)fu_plugin_get_name(plugin), node);
+	}
+	return nodes;
+}
+
+static void
+fu_plugin_list_node_add_edge(FuPluginListNode *node_earlier, FuPluginListNode *node_later)
+{
+	g_ptr_array_add(node_earlier->edges, node_later);
+	node_later->edges_in++;
+}
+
+/* assign each node the longest-path depth from any root using Kahn's algorithm over the
+ * adjacency built by the caller; this converges to the same values as repeatedly promoting
+ * plugins above their dependencies, in linear rather than quadratic time */
+static gboolean
+fu_plugin_list_nodes_depsolve(GHashTable *nodes, GError **error)
+{
+	GHashTableIter iter;
+	gpointer value;
+	guint cnt = 0;
+	g_autoptr(GPtrArray) queue = g_ptr_array_new();
+
+	g_hash_table_iter_init(&iter, nodes);
+	while (g_hash_table_iter_next(&iter, NULL, &value)) {
+		FuPluginListNode *node = (FuPluginListNode *)value;
+		if (node->edges_in == 0)
+			g_ptr_array_add(queue, node);
+	}
+	for (guint i = 0; i < queue->len; i++) {
+		FuPluginListNode *node = g_ptr_array_index(queue, i);
+		cnt++;
+		for (guint j = 0; j < node->edges->len; j++) {
+			FuPluginListNode *node_later = g_ptr_array_index(node->edges, j);
+			if (node_later->level < node->level + 1) {
+				g_debug("%s [%u] to be ordered after %s [%u] "
+					"so promoting to [%u]",
+					fu_plugin_get_name(node_later->plugin),
+					node_later->level,
+					fu_plugin_get_name(node->plugin),
+					node->level,
+					node->level + 1);
+				node_later->level = node->level + 1;
+			}
+			if (--node_later->edges_in == 0)
+				g_ptr_array_add(queue, node_later);
+		}
+	}
+
+	/* at least one plugin is part of a cycle */
+	if (cnt != g_hash_table_size(nodes)) {
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INTERNAL,
+				    "got stuck in dep loop");
+		return FALSE;
+	}
+
+	/* success */
+	return TRUE;
+}
+
 /**
  * fu_plugin_list_depsolve:
  * @self: a #FuPluginList
@@ -179,118 +267,89 @@ fu_plugin_list_depsolve(FuPluginList *self, GError **error)
 {
 	FuPlugin *dep;
 	GPtrArray *deps;
-	gboolean changes;
-	guint dep_loop_check = 0;
+	GHashTableIter iter;
+	gpointer value;
+	g_autoptr(GHashTable) nodes_order = fu_plugin_list_nodes_new(self);
+	g_autoptr(GHashTable) nodes_priority = fu_plugin_list_nodes_new(self);
 
 	g_return_val_if_fail(FU_IS_PLUGIN_LIST(self), FALSE);
 	g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
-	/* order by deps */
-	do {
-		changes = FALSE;
-		for (guint i = 0; i < self->plugins->len; i++) {
-			FuPlugin *plugin = g_ptr_array_index(self->plugins, i);
-			deps = fu_plugin_get_rules(plugin, FU_PLUGIN_RULE_RUN_AFTER);
-			if (deps == NULL)
+	/* build the adjacency index once, then solve both graphs */
+	for (guint i = 0; i < self->plugins->len; i++) {
+		FuPlugin *plugin = g_ptr_array_index(self->plugins, i);
+		FuPluginListNode *node = g_hash_table_lookup(nodes_order,
+							     fu_plugin_get_name(plugin));
+		deps = fu_plugin_get_rules(plugin, FU_PLUGIN_RULE_RUN_AFTER);
+		for (guint j = 0; deps != NULL && j < deps->len; j++) {
+			const gchar *plugin_name = g_ptr_array_index(deps, j);
+			dep = fu_plugin_list_find_by_name(self, plugin_name, NULL);
+			if (dep == NULL) {
+				g_info("cannot find plugin '%s' "
+				       "requested by '%s'",
+				       plugin_name,
+				       fu_plugin_get_name(plugin));
 				continue;
-			for (guint j = 0; j < deps->len && !changes; j++) {
-				const gchar *plugin_name = g_ptr_array_index(deps, j);
-				dep = fu_plugin_list_find_by_name(self, plugin_name, NULL);
-				if (dep == NULL) {
-					g_info("cannot find plugin '%s' "
-					       "requested by '%s'",
-					       plugin_name,
-					       fu_plugin_get_name(plugin));
-					continue;
-				}
-				if (fu_plugin_has_flag(dep, FWUPD_PLUGIN_FLAG_DISABLED))
-					continue;
-				if (fu_plugin_get_order(plugin) <= fu_plugin_get_order(dep)) {
-					g_debug("%s [%u] to be ordered after %s [%u] "
-						"so promoting to [%u]",
-						fu_plugin_get_name(plugin),
-						fu_plugin_get_order(plugin),
-						fu_plugin_get_name(dep),
-						fu_plugin_get_order(dep),
-						fu_plugin_get_order(dep) + 1);
-					fu_plugin_set_order(plugin, fu_plugin_get_order(dep) + 1);
-					changes = TRUE;
-				}
 			}
+			if (fu_plugin_has_flag(dep, FWUPD_PLUGIN_FLAG_DISABLED))
+				continue;
+			fu_plugin_list_node_add_edge(g_hash_table_lookup(nodes_order,
+									 plugin_name),
+						     node);
 		}
-		for (guint i = 0; i < self->plugins->len; i++) {
-			FuPlugin *plugin = g_ptr_array_index(self->plugins, i);
-			deps = fu_plugin_get_rules(plugin, FU_PLUGIN_RULE_RUN_BEFORE);
-			if (deps == NULL)
+		deps = fu_plugin_get_rules(plugin, FU_PLUGIN_RULE_RUN_BEFORE);
+		for (guint j = 0; deps != NULL && j < deps->len; j++) {
+			const gchar *plugin_name = g_ptr_array_index(deps, j);
+			dep = fu_plugin_list_find_by_name(self, plugin_name, NULL);
+			if (dep == NULL) {
+				g_info("cannot find plugin '%s' "
+				       "requested by '%s'",
+				       plugin_name,
+				       fu_plugin_get_name(plugin));
 				continue;
-			for (guint j = 0; j < deps->len && !changes; j++) {
-				const gchar *plugin_name = g_ptr_array_index(deps, j);
-				dep = fu_plugin_list_find_by_name(self, plugin_name, NULL);
-				if (dep == NULL) {
-					g_info("cannot find plugin '%s' "
-					       "requested by '%s'",
-					       plugin_name,
-					       fu_plugin_get_name(plugin));
-					continue;
-				}
-				if (fu_plugin_has_flag(dep, FWUPD_PLUGIN_FLAG_DISABLED))
-					continue;
-				if (fu_plugin_get_order(plugin) >= fu_plugin_get_order(dep)) {
-					g_debug("%s [%u] to be ordered before %s [%u] "
-						"so promoting to [%u]",
-						fu_plugin_get_name(plugin),
-						fu_plugin_get_order(plugin),
-						fu_plugin_get_name(dep),
-						fu_plugin_get_order(dep),
-						fu_plugin_get_order(dep) + 1);
-					fu_plugin_set_order(dep, fu_plugin_get_order(plugin) + 1);
-					changes = TRUE;
-				}
 			}
+			if (fu_plugin_has_flag(dep, FWUPD_PLUGIN_FLAG_DISABLED))
+				continue;
+			fu_plugin_list_node_add_edge(node,
+						     g_hash_table_lookup(nodes_order,
+									 plugin_name));
 		}
-
-		/* set priority as well */
-		for (guint i = 0; i < self->plugins->len; i++) {
-			FuPlugin *plugin = g_ptr_array_index(self->plugins, i);
-			deps = fu_plugin_get_rules(plugin, FU_PLUGIN_RULE_BETTER_THAN);
-			if (deps == NULL)
+		deps = fu_plugin_get_rules(plugin, FU_PLUGIN_RULE_BETTER_THAN);
+		for (guint j = 0; deps != NULL && j < deps->len; j++) {
+			const gchar *plugin_name = g_ptr_array_index(deps, j);
+			dep = fu_plugin_list_find_by_name(self, plugin_name, NULL);
+			if (dep == NULL) {
+				g_info("cannot find plugin '%s' "
+				       "referenced by '%s'",
+				       plugin_name,
+				       fu_plugin_get_name(plugin));
 				continue;
-			for (guint j = 0; j < deps->len && !changes; j++) {
-				const gchar *plugin_name = g_ptr_array_index(deps, j);
-				dep = fu_plugin_list_find_by_name(self, plugin_name, NULL);
-				if (dep == NULL) {
-					g_info("cannot find plugin '%s' "
-					       "referenced by '%s'",
-					       plugin_name,
-					       fu_plugin_get_name(plugin));
-					continue;
-				}
-				if (fu_plugin_has_flag(dep, FWUPD_PLUGIN_FLAG_DISABLED))
-					continue;
-				if (fu_plugin_get_priority(plugin) <= fu_plugin_get_priority(dep)) {
-					g_debug("%s [%u] better than %s [%u] "
-						"so bumping to [%u]",
-						fu_plugin_get_name(plugin),
-						fu_plugin_get_priority(plugin),
-						fu_plugin_get_name(dep),
-						fu_plugin_get_priority(dep),
-						fu_plugin_get_priority(dep) + 1);
-					fu_plugin_set_priority(plugin,
-							       fu_plugin_get_priority(dep) + 1);
-					changes = TRUE;
-				}
 			}
+			if (fu_plugin_has_flag(dep, FWUPD_PLUGIN_FLAG_DISABLED))
+				continue;
+			fu_plugin_list_node_add_edge(
+			    g_hash_table_lookup(nodes_priority, plugin_name),
+			    g_hash_table_lookup(nodes_priority, fu_plugin_get_name(plugin)));
 		}
+	}
 
-		/* check we're not stuck */
-		if (dep_loop_check++ > 100) {
-			g_set_error_literal(error,
-					    FWUPD_ERROR,
-					    FWUPD_ERROR_INTERNAL,
-					    "got stuck in dep loop");
-			return FALSE;
-		}
-	} while (changes);
+	/* order by deps */
+	if (!fu_plugin_list_nodes_depsolve(nodes_order, error))
+		return FALSE;
+	g_hash_table_iter_init(&iter, nodes_order);
+	while (g_hash_table_iter_next(&iter, NULL, &value)) {
+		FuPluginListNode *node = (FuPluginListNode *)value;
+		fu_plugin_set_order(node->plugin, node->level);
+	}
+
+	/* set priority as well */
+	if (!fu_plugin_list_nodes_depsolve(nodes_priority, error))
+		return FALSE;
+	g_hash_table_iter_init(&iter, nodes_priority);
+	while (g_hash_table_iter_next(&iter, NULL, &value)) {
+		FuPluginListNode *node = (FuPluginListNode *)value;
+		fu_plugin_set_priority(node->plugin, node->level);
+	}
 
 	/* check for conflicts */
 	for (guint i = 0; i < self->plugins->len; i++) {
@@ -32,6 +32,8 @@ struct _FuRelease {
 	GPtrArray *soft_reqs; /* nullable, element-type XbNode */
 	GPtrArray *hard_reqs; /* nullable, element-type XbNode */
 	guint64 priority;
+	FuVersionParsed *version_parsed; /* nullable */
+	FwupdVersionFormat version_parsed_fmt;
 };
 
 G_DEFINE_TYPE(FuRelease, fu_release, FWUPD_TYPE_RELEASE)
@@ -391,6 +393,7 @@ fu_release_load_artifact(FuRelease *self, XbNode *artifact, GError **error)
 	g_autoptr(GPtrArray) locations = NULL;
 	g_autoptr(GPtrArray) checksums = NULL;
 	g_autoptr(GPtrArray) test_result = NULL;
+	g_autoptr(XbNode) checksum_tree = NULL;
 
 	/* filename */
 	filename = xb_node_query_text(artifact, "filename", NULL);
@@ -446,6 +449,33 @@ fu_release_load_artifact(FuRelease *self, XbNode *artifact, GError **error)
 		}
 	}
 
+	/* per-block checksums, which allow partial verification of the container */
+	checksum_tree = xb_node_query_first(artifact, "checksum_tree", NULL);
+	if (checksum_tree != NULL) {
+		guint64 block_size = 0;
+		g_autoptr(GPtrArray) blocks = NULL;
+		if (!fu_strtoull(xb_node_get_attr(checksum_tree, "block_size"),
+				 &block_size,
+				 1,
+				 G_MAXUINT32,
+				 FU_INTEGER_BASE_AUTO,
+				 error)) {
+			g_prefix_error(error, "invalid checksum_tree block_size: ");
+			return FALSE;
+		}
+		fwupd_release_set_checksum_block_size(FWUPD_RELEASE(self), (guint32)block_size);
+		blocks = xb_node_query(checksum_tree, "checksum", 0, NULL);
+		if (blocks != NULL) {
+			for (guint i = 0; i < blocks->len; i++) {
+				XbNode *n = g_ptr_array_index(blocks, i);
+				if (xb_node_get_text(n) == NULL)
+					continue;
+				fwupd_release_add_checksum_block(FWUPD_RELEASE(self),
+								 xb_node_get_text(n));
+			}
+		}
+	}
+
 	/* test results */
 	test_result = xb_node_query(artifact, "testing/test_result", 0, NULL);
 	if (test_result != NULL) {
@@ -1020,6 +1050,32 @@ fu_release_load(FuRelease *self,
 			}
 		}
 	}
+	if (fwupd_release_get_checksum_blocks(FWUPD_RELEASE(self))->len == 0) {
+		tmp = xb_node_query_text(component,
+					 "../custom/value[@key='fwupd::ChecksumTree']",
+					 NULL);
+		if (tmp != NULL) {
+			guint64 block_size = 0;
+			g_auto(GStrv) split = g_strsplit(tmp, ",", -1);
+			g_autoptr(GError) error_local = NULL;
+			if (fu_strtoull(split[0],
+					&block_size,
+					1,
+					G_MAXUINT32,
+					FU_INTEGER_BASE_AUTO,
+					&error_local)) {
+				fwupd_release_set_checksum_block_size(FWUPD_RELEASE(self),
+								      (guint32)block_size);
+				for (guint i = 1; split[i] != NULL; i++) {
+					fwupd_release_add_checksum_block(FWUPD_RELEASE(self),
+									 split[i]);
+				}
+			} else {
+				g_warning("invalid fwupd::ChecksumTree: %s",
+					  error_local->message);
+			}
+		}
+	}
 	if (fwupd_release_get_size(FWUPD_RELEASE(self)) == 0) {
 		tmp64 = xb_node_query_text_as_uint(rel, "size[@type='installed']", NULL);
 		if (tmp64 != G_MAXUINT64)
@@ -1256,11 +1312,33 @@ fu_release_get_action_id(FuRelease *self)
  *
  * Returns: 1, 0 or -1 if @release1 is greater, equal, or less than @release2, respectively.
  **/
+/* split the version once and keep it for subsequent comparisons, which saves
+ * re-parsing the same strings N log N times while sorting */
+static FuVersionParsed *
+fu_release_get_version_parsed(FuRelease *self, FwupdVersionFormat fmt)
+{
+	const gchar *version = fu_release_get_version(self);
+	if (version == NULL)
+		return NULL;
+	if (self->version_parsed != NULL && self->version_parsed_fmt != fmt) {
+		fu_version_parsed_free(self->version_parsed);
+		self->version_parsed = NULL;
+	}
+	if (self->version_parsed == NULL) {
+		self->version_parsed = fu_version_parsed_new(version, fmt);
+		self->version_parsed_fmt = fmt;
+	}
+	return self->version_parsed;
+}
+
 gint
 fu_release_compare(FuRelease *release1, FuRelease *release2)
 {
 	FuDevice *device1 = fu_release_get_device(release1);
 	FuDevice *device2 = fu_release_get_device(release2);
+	FuVersionParsed *version_parsed1;
+	FuVersionParsed *version_parsed2;
+	FwupdVersionFormat fmt;
 
 	/* device order, lower is better */
 	if (device1 != NULL && device2 != NULL && device1 != device2) {
@@ -1287,9 +1365,14 @@ fu_release_compare(FuRelease *release1, FuRelease *release2)
 	}
 
 	/* FWUPD_DEVICE_FLAG_INSTALL_ALL_RELEASES has to be from oldest to newest */
+	fmt = fu_device_get_version_format(device1);
+	version_parsed1 = fu_release_get_version_parsed(release1, fmt);
+	version_parsed2 = fu_release_get_version_parsed(release2, fmt);
+	if (version_parsed1 != NULL && version_parsed2 != NULL)
+		return fu_version_parsed_compare(version_parsed1, version_parsed2);
 	return fu_version_compare(fu_release_get_version(release1),
 				  fu_release_get_version(release2),
-				  fu_device_get_version_format(device1));
+				  fmt);
 }
 
 static void
@@ -1319,6 +1402,8 @@ fu_release_finalize(GObject *obj)
 		g_ptr_array_unref(self->soft_reqs);
 	if (self->hard_reqs != NULL)
 		g_ptr_array_unref(self->hard_reqs);
+	if (self->version_parsed != NULL)
+		fu_version_parsed_free(self->version_parsed);
 
 	G_OBJECT_CLASS(fu_release_parent_class)->finalize(obj);
 }
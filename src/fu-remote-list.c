@@ -22,6 +22,9 @@
 #include "fu-remote-list.h"
 #include "fu-remote.h"
 
+/* absorb rapid successive writes, e.g. a config-management run touching every file */
+#define FU_REMOTE_LIST_RELOAD_DELAY 500 /* ms */
+
 enum { SIGNAL_CHANGED, SIGNAL_ADDED, SIGNAL_LAST };
 
 static guint signals[SIGNAL_LAST] = {0};
@@ -39,6 +42,7 @@ struct _FuRemoteList {
 	gboolean fix_metadata_uri;
 	XbSilo *silo;
 	gchar *lvfs_metadata_format;
+	guint changed_id;
 };
 
 G_DEFINE_TYPE(FuRemoteList, fu_remote_list, G_TYPE_OBJECT)
@@ -68,22 +72,6 @@ fu_remote_list_set_lvfs_metadata_format(FuRemoteList *self, const gchar *lvfs_me
 	self->lvfs_metadata_format = g_strdup(lvfs_metadata_format);
 }
 
-static void
-fu_remote_list_monitor_changed_cb(GFileMonitor *monitor,
-				  GFile *file,
-				  GFile *other_file,
-				  GFileMonitorEvent event_type,
-				  gpointer user_data)
-{
-	FuRemoteList *self = FU_REMOTE_LIST(user_data);
-	g_autoptr(GError) error = NULL;
-	g_autofree gchar *filename = g_file_get_path(file);
-	g_info("%s changed, reloading all remotes", filename);
-	if (!fu_remote_list_reload(self, &error))
-		g_warning("failed to rescan remotes: %s", error->message);
-	fu_remote_list_emit_changed(self);
-}
-
 static guint64
 _fwupd_remote_get_mtime(FwupdRemote *remote)
 {
@@ -103,6 +91,64 @@ _fwupd_remote_get_mtime(FwupdRemote *remote)
 	return g_file_info_get_attribute_uint64(info, G_FILE_ATTRIBUTE_TIME_MODIFIED);
 }
 
+/* only the fields that invalidate the metadata silo, so that a config-management run
+ * rewriting identical files does not cause a rebuild */
+static gchar *
+fu_remote_list_build_state(FuRemoteList *self)
+{
+	g_autoptr(GString) str = g_string_new(NULL);
+	for (guint i = 0; i < self->array->len; i++) {
+		FwupdRemote *remote = g_ptr_array_index(self->array, i);
+		g_string_append_printf(str,
+				       "%s=%u:%i:%s:%" G_GUINT64_FORMAT "\n",
+				       fwupd_remote_get_id(remote),
+				       (guint)fwupd_remote_get_flags(remote),
+				       fwupd_remote_get_priority(remote),
+				       fwupd_remote_get_metadata_uri(remote) != NULL
+					   ? fwupd_remote_get_metadata_uri(remote)
+					   : "",
+				       _fwupd_remote_get_mtime(remote));
+	}
+	return g_string_free(g_steal_pointer(&str), FALSE);
+}
+
+static gboolean
+fu_remote_list_reload_timeout_cb(gpointer user_data)
+{
+	FuRemoteList *self = FU_REMOTE_LIST(user_data);
+	g_autofree gchar *state_old = fu_remote_list_build_state(self);
+	g_autoptr(GError) error = NULL;
+
+	self->changed_id = 0;
+	if (!fu_remote_list_reload(self, &error)) {
+		g_warning("failed to rescan remotes: %s", error->message);
+	} else {
+		g_autofree gchar *state_new = fu_remote_list_build_state(self);
+		if (g_strcmp0(state_old, state_new) == 0) {
+			g_debug("no effective change to any remote, ignoring");
+			return G_SOURCE_REMOVE;
+		}
+	}
+	fu_remote_list_emit_changed(self);
+	return G_SOURCE_REMOVE;
+}
+
+static void
+fu_remote_list_monitor_changed_cb(GFileMonitor *monitor,
+				  GFile *file,
+				  GFile *other_file,
+				  GFileMonitorEvent event_type,
+				  gpointer user_data)
+{
+	FuRemoteList *self = FU_REMOTE_LIST(user_data);
+	g_autofree gchar *filename = g_file_get_path(file);
+	g_info("%s changed, scheduling reload of all remotes", filename);
+	if (self->changed_id != 0)
+		g_source_remove(self->changed_id);
+	self->changed_id =
+	    g_timeout_add(FU_REMOTE_LIST_RELOAD_DELAY, fu_remote_list_reload_timeout_cb, self);
+}
+
 /* GLib only returns the very unhelpful "Unable to find default local file monitor type"
  * when /proc/sys/fs/inotify/max_user_instances is set too low; detect this and set a proper
  * error prefix to aid debugging when the daemon fails to start */
@@ -828,6 +874,8 @@ static void
 fu_remote_list_finalize(GObject *obj)
 {
 	FuRemoteList *self = FU_REMOTE_LIST(obj);
+	if (self->changed_id != 0)
+		g_source_remove(self->changed_id);
 	if (self->silo != NULL)
 		g_object_unref(self->silo);
 	g_ptr_array_unref(self->array);
@@ -165,12 +165,32 @@ fu_client_list_func(void)
 	g_assert_false(fu_client_has_flag(client, FU_CLIENT_FLAG_ACTIVE));
 }
 
+static void
+fu_idle_timeout_trim_cb(FuIdle *idle, gpointer user_data)
+{
+	guint *cnt = (guint *)user_data;
+	(*cnt)++;
+	fu_test_loop_quit();
+}
+
 static void
 fu_idle_func(void)
 {
 	guint token;
+	guint trim_cnt = 0;
 	g_autoptr(FuIdle) idle = fu_idle_new();
 
+	/* the trim signal fires once after the daemon has been idle */
+	g_signal_connect(FU_IDLE(idle),
+			 "timeout-trim",
+			 G_CALLBACK(fu_idle_timeout_trim_cb),
+			 &trim_cnt);
+	fu_idle_set_timeout_trim(idle, 1);
+	fu_test_loop_run_with_timeout(2500);
+	fu_test_loop_quit();
+	g_assert_cmpint(trim_cnt, ==, 1);
+	fu_idle_set_timeout_trim(idle, 0);
+
 	fu_idle_reset(idle);
 	g_assert_false(fu_idle_has_inhibit(idle, FU_IDLE_INHIBIT_TIMEOUT));
 	g_assert_false(fu_idle_has_inhibit(idle, FU_IDLE_INHIBIT_SIGNALS));
@@ -495,6 +515,12 @@ fu_engine_requirements_not_hardware_func(gconstpointer user_data)
 	ret = fu_engine_requirements_check(engine, release, FWUPD_INSTALL_FLAG_NONE, &error);
 	g_assert_no_error(error);
 	g_assert_true(ret);
+
+	/* the memoized verdict has to be identical */
+	g_assert_null(fu_engine_has_hwid_guids(engine, "ffffffff-ffff-ffff-ffff-ffffffffffff"));
+	ret = fu_engine_requirements_check(engine, release, FWUPD_INSTALL_FLAG_NONE, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
 }
 
 static void
@@ -2001,6 +2027,7 @@ fu_engine_require_hwid_func(gconstpointer user_data)
 	gboolean ret;
 	g_autofree gchar *filename = NULL;
 	g_autoptr(FuCabinet) cabinet = NULL;
+	g_autoptr(FuCabinet) cabinet2 = NULL;
 	g_autoptr(FuDevice) device = fu_device_new(self->ctx);
 	g_autoptr(FuEngine) engine = fu_engine_new(self->ctx);
 	g_autoptr(FuEngineRequest) request = fu_engine_request_new(NULL);
@@ -2029,6 +2056,12 @@ fu_engine_require_hwid_func(gconstpointer user_data)
 	g_assert_no_error(error);
 	g_assert_nonnull(cabinet);
 
+	/* building the same archive again returns the cached instance */
+	cabinet2 = fu_engine_build_cabinet_from_stream(engine, stream, &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(cabinet2);
+	g_assert_true(cabinet2 == cabinet);
+
 	/* add a dummy device */
 	fu_device_set_id(device, "test_device");
 	fu_device_build_vendor_id_u16(device, "USB", 0xFFFF);
@@ -2166,11 +2199,13 @@ fu_engine_downgrade_func(gconstpointer user_data)
 	FuTest *self = (FuTest *)user_data;
 	FwupdRelease *rel;
 	gboolean ret;
+	GPtrArray *releases_batch;
 	g_autoptr(FuDevice) device = fu_device_new(self->ctx);
 	g_autoptr(FuEngine) engine = fu_engine_new(self->ctx);
 	g_autoptr(FuEngineRequest) request = fu_engine_request_new(NULL);
 	g_autoptr(FuProgress) progress = fu_progress_new(G_STRLOC);
 	g_autoptr(GError) error = NULL;
+	g_autoptr(GHashTable) releases_map = NULL;
 	g_autoptr(GPtrArray) devices = NULL;
 	g_autoptr(GPtrArray) devices_pre = NULL;
 	g_autoptr(GPtrArray) releases_dg = NULL;
@@ -2312,6 +2347,15 @@ fu_engine_downgrade_func(gconstpointer user_data)
 	g_assert_nonnull(releases);
 	g_assert_cmpint(releases->len, ==, 4);
 
+	/* resolve the same thing for all the devices at once */
+	releases_map = fu_engine_get_releases_for_devices(engine, request, devices, &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(releases_map);
+	g_assert_cmpint(g_hash_table_size(releases_map), ==, 1);
+	releases_batch = g_hash_table_lookup(releases_map, fu_device_get_id(device));
+	g_assert_nonnull(releases_batch);
+	g_assert_cmpint(releases_batch->len, ==, 4);
+
 	/* no upgrades, as no firmware is approved */
 	releases_up = fu_engine_get_upgrades(engine, request, fu_device_get_id(device), &error);
 	g_assert_error(error, FWUPD_ERROR, FWUPD_ERROR_NOTHING_TO_DO);
@@ -4235,8 +4279,6 @@ fu_history_migrate_v1_func(gconstpointer user_data)
 	gboolean ret;
 	g_autoptr(FuContext) ctx = fu_context_new();
 	g_autoptr(GError) error = NULL;
-	g_autoptr(GFile) file_dst = NULL;
-	g_autoptr(GFile) file_src = NULL;
 	g_autoptr(FuDevice) device = NULL;
 	g_autoptr(FuHistory) history = NULL;
 	g_autofree gchar *filename = NULL;
@@ -4248,9 +4290,9 @@ fu_history_migrate_v1_func(gconstpointer user_data)
 
 	/* load old version */
 	filename = g_test_build_filename(G_TEST_DIST, "tests", "history_v1.db", NULL);
-	file_src = g_file_new_for_path(filename);
-	file_dst = g_file_new_for_path("/tmp/fwupd-self-test/var/lib/fwupd/pending.db");
-	ret = g_file_copy(file_src, file_dst, G_FILE_COPY_OVERWRITE, NULL, NULL, NULL, &error);
+	ret = fu_path_copy_file(filename,
+				"/tmp/fwupd-self-test/var/lib/fwupd/pending.db",
+				&error);
 	g_assert_no_error(error);
 	g_assert_true(ret);
 
@@ -4273,8 +4315,6 @@ fu_history_migrate_v2_func(gconstpointer user_data)
 	gboolean ret;
 	g_autoptr(FuContext) ctx = fu_context_new();
 	g_autoptr(GError) error = NULL;
-	g_autoptr(GFile) file_dst = NULL;
-	g_autoptr(GFile) file_src = NULL;
 	g_autoptr(FuDevice) device = NULL;
 	g_autoptr(FuHistory) history = NULL;
 	g_autofree gchar *filename = NULL;
@@ -4286,9 +4326,9 @@ fu_history_migrate_v2_func(gconstpointer user_data)
 
 	/* load old version */
 	filename = g_test_build_filename(G_TEST_DIST, "tests", "history_v2.db", NULL);
-	file_src = g_file_new_for_path(filename);
-	file_dst = g_file_new_for_path("/tmp/fwupd-self-test/var/lib/fwupd/pending.db");
-	ret = g_file_copy(file_src, file_dst, G_FILE_COPY_OVERWRITE, NULL, NULL, NULL, &error);
+	ret = fu_path_copy_file(filename,
+				"/tmp/fwupd-self-test/var/lib/fwupd/pending.db",
+				&error);
 	g_assert_no_error(error);
 	g_assert_true(ret);
 
@@ -4570,6 +4610,7 @@ fu_history_func(gconstpointer user_data)
 	g_autoptr(FuDevice) device_found = NULL;
 	g_autoptr(FuHistory) history = NULL;
 	g_autoptr(GError) error = NULL;
+	g_autoptr(GHashTable) timings = NULL;
 	g_autoptr(GPtrArray) approved_firmware = NULL;
 	g_autofree gchar *dirname = NULL;
 	g_autofree gchar *filename = NULL;
@@ -4663,6 +4704,19 @@ fu_history_func(gconstpointer user_data)
 	g_assert_nonnull(device_found);
 	g_object_unref(device_found);
 
+	/* record and fetch per-phase timings */
+	ret = fu_history_add_timing(history, device, "detach", 1000, 51000, TRUE, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+	ret = fu_history_add_timing(history, device, "install", 51000, 2051000, TRUE, &error);
+	g_assert_no_error(error);
+	g_assert_true(ret);
+	timings = fu_history_get_timings(history, fu_device_get_id(device), &error);
+	g_assert_no_error(error);
+	g_assert_nonnull(timings);
+	g_assert_cmpstr(g_hash_table_lookup(timings, "detach"), ==, "50");
+	g_assert_cmpstr(g_hash_table_lookup(timings, "install"), ==, "2000");
+
 	/* remove device */
 	ret = fu_history_remove_device(history, device, &error);
 	g_assert_no_error(error);
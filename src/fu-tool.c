@@ -76,6 +76,7 @@ struct FuUtilPrivate {
 	gboolean as_json;
 	gboolean no_reboot_check;
 	gboolean no_safety_check;
+	gboolean parallel;
 	gboolean no_device_prompt;
 	gboolean prepare_blob;
 	gboolean cleanup_blob;
@@ -84,6 +85,7 @@ struct FuUtilPrivate {
 	FwupdInstallFlags flags;
 	gboolean show_all;
 	gboolean disable_ssl_strict;
+	gint snapshot_ttl;
 	gint lock_fd;
 	/* only valid in update and downgrade */
 	FuUtilOperation current_operation;
@@ -520,6 +522,51 @@ fu_util_get_plugins(FuUtilPrivate *priv, gchar **values, GError **error)
 	return TRUE;
 }
 
+static gboolean
+fu_util_get_plugin_timings(FuUtilPrivate *priv, gchar **values, GError **error)
+{
+	GVariantIter iter;
+	const gchar *step;
+	guint64 duration_usec;
+	g_autoptr(GVariant) timings = NULL;
+
+	/* load engine */
+	if (!fu_util_start_engine(
+		priv,
+		FU_ENGINE_LOAD_FLAG_COLDPLUG | FU_ENGINE_LOAD_FLAG_EXTERNAL_PLUGINS |
+		    FU_ENGINE_LOAD_FLAG_BUILTIN_PLUGINS | FU_ENGINE_LOAD_FLAG_HWINFO,
+		priv->progress,
+		error))
+		return FALSE;
+
+	/* print */
+	timings = fu_engine_get_plugin_timings(priv->engine);
+	if (priv->as_json) {
+		g_autoptr(JsonBuilder) builder = json_builder_new();
+		json_builder_begin_object(builder);
+		json_builder_set_member_name(builder, "PluginTimings");
+		json_builder_begin_object(builder);
+		g_variant_iter_init(&iter, timings);
+		while (g_variant_iter_next(&iter, "{&st}", &step, &duration_usec)) {
+			json_builder_set_member_name(builder, step);
+			json_builder_add_int_value(builder, (gint64)duration_usec);
+		}
+		json_builder_end_object(builder);
+		json_builder_end_object(builder);
+		return fu_util_print_builder(priv->console, builder, error);
+	}
+
+	/* print */
+	g_variant_iter_init(&iter, timings);
+	while (g_variant_iter_next(&iter, "{&st}", &step, &duration_usec)) {
+		g_autofree gchar *str =
+		    g_strdup_printf("%s: %" G_GUINT64_FORMAT "µs", step, duration_usec);
+		fu_console_print_literal(priv->console, str);
+	}
+
+	return TRUE;
+}
+
 static FuDevice *
 fu_util_prompt_for_device(FuUtilPrivate *priv, GPtrArray *devices_opt, GError **error)
 {
@@ -865,33 +912,119 @@ fu_util_get_devices_as_json(FuUtilPrivate *priv, GPtrArray *devs, GError **error
 	return fu_util_print_builder(priv->console, builder, error);
 }
 
+/* reads the inventory snapshot written by the daemon or by `fwupdtool export-inventory` --
+ * a provisioning loop calling get-devices dozens of times can skip the engine setup cost
+ * entirely when the file is fresher than the requested TTL */
+static GPtrArray *
+fu_util_get_devices_from_snapshot(FuUtilPrivate *priv, GError **error)
+{
+	JsonArray *json_array;
+	JsonNode *json_root;
+	JsonObject *json_obj;
+	guint64 mtime;
+	g_autofree gchar *directory = fu_path_from_kind(FU_PATH_KIND_CACHEDIR_PKG);
+	g_autofree gchar *fn = g_build_filename(directory, "devices.json", NULL);
+	g_autoptr(GFile) file = g_file_new_for_path(fn);
+	g_autoptr(GFileInfo) info = NULL;
+	g_autoptr(GPtrArray) devs = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	g_autoptr(JsonParser) parser = json_parser_new();
+
+	/* too stale to be trusted? */
+	info = g_file_query_info(file,
+				 G_FILE_ATTRIBUTE_TIME_MODIFIED,
+				 G_FILE_QUERY_INFO_NONE,
+				 NULL,
+				 error);
+	if (info == NULL)
+		return NULL;
+	mtime = g_file_info_get_attribute_uint64(info, G_FILE_ATTRIBUTE_TIME_MODIFIED);
+	if ((guint64)g_get_real_time() / G_USEC_PER_SEC > mtime + (guint64)priv->snapshot_ttl) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_NOTHING_TO_DO,
+			    "%s is older than %i seconds",
+			    fn,
+			    priv->snapshot_ttl);
+		return NULL;
+	}
+
+	/* same format the engine reads back at warm start */
+	if (!json_parser_load_from_file(parser, fn, error))
+		return NULL;
+	json_root = json_parser_get_root(parser);
+	if (json_root == NULL || !JSON_NODE_HOLDS_OBJECT(json_root)) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_FILE,
+			    "no root object in %s",
+			    fn);
+		return NULL;
+	}
+	json_obj = json_node_get_object(json_root);
+	if (!json_object_has_member(json_obj, "Devices")) {
+		g_set_error(error, FWUPD_ERROR, FWUPD_ERROR_INVALID_FILE, "no devices in %s", fn);
+		return NULL;
+	}
+	json_array = json_object_get_array_member(json_obj, "Devices");
+	for (guint i = 0; i < json_array_get_length(json_array); i++) {
+		JsonNode *json_node = json_array_get_element(json_array, i);
+		g_autoptr(FuDevice) device = fu_device_new(priv->ctx);
+		g_autoptr(GError) error_device = NULL;
+
+		if (!fwupd_codec_from_json(FWUPD_CODEC(device), json_node, &error_device)) {
+			g_debug("ignoring invalid snapshot device: %s", error_device->message);
+			continue;
+		}
+		g_ptr_array_add(devs, g_steal_pointer(&device));
+	}
+	return g_steal_pointer(&devs);
+}
+
 static gboolean
 fu_util_get_devices(FuUtilPrivate *priv, gchar **values, GError **error)
 {
 	g_autoptr(FuUtilNode) root = g_node_new(NULL);
 	g_autoptr(GPtrArray) devs = NULL;
 
+	/* before paying for the full engine load, try the recent inventory snapshot */
+	if (priv->snapshot_ttl > 0 && g_strv_length(values) == 0) {
+		g_autoptr(GError) error_snapshot = NULL;
+		devs = fu_util_get_devices_from_snapshot(priv, &error_snapshot);
+		if (devs == NULL)
+			g_debug("cannot use device snapshot: %s", error_snapshot->message);
+	}
+
 	/* load engine */
-	if (!fu_util_start_engine(priv,
-				  FU_ENGINE_LOAD_FLAG_COLDPLUG | FU_ENGINE_LOAD_FLAG_REMOTES |
-				      FU_ENGINE_LOAD_FLAG_HWINFO,
-				  priv->progress,
-				  error))
-		return FALSE;
+	if (devs == NULL) {
+		if (!fu_util_start_engine(priv,
+					  FU_ENGINE_LOAD_FLAG_COLDPLUG |
+					      FU_ENGINE_LOAD_FLAG_REMOTES |
+					      FU_ENGINE_LOAD_FLAG_HWINFO,
+					  priv->progress,
+					  error))
+			return FALSE;
 
-	/* get devices and build tree */
-	if (g_strv_length(values) > 0) {
-		devs = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
-		for (guint i = 0; values[i] != NULL; i++) {
-			FuDevice *device = fu_util_get_device(priv, values[i], error);
-			if (device == NULL)
+		/* get devices and build tree */
+		if (g_strv_length(values) > 0) {
+			devs = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+			for (guint i = 0; values[i] != NULL; i++) {
+				FuDevice *device = fu_util_get_device(priv, values[i], error);
+				if (device == NULL)
+					return FALSE;
+				g_ptr_array_add(devs, device);
+			}
+		} else {
+			devs = fu_engine_get_devices(priv->engine, error);
+			if (devs == NULL)
 				return FALSE;
-			g_ptr_array_add(devs, device);
 		}
-	} else {
-		devs = fu_engine_get_devices(priv->engine, error);
-		if (devs == NULL)
-			return FALSE;
+
+		/* refresh the snapshot so the next scripted invocation can reuse it */
+		if (priv->snapshot_ttl > 0 && g_strv_length(values) == 0) {
+			g_autoptr(GError) error_local = NULL;
+			if (!fu_engine_update_devices_file(priv->engine, &error_local))
+				g_debug("failed to save snapshot: %s", error_local->message);
+		}
 	}
 
 	/* not for human consumption */
@@ -1002,11 +1135,11 @@ fu_util_install_blob(FuUtilPrivate *priv, gchar **values, GError **error)
 	}
 	fu_progress_step_done(priv->progress);
 
-	/* load engine */
+	/* load engine; remotes and metadata are never used when writing a bare blob */
 	if (!fu_util_start_engine(priv,
 				  FU_ENGINE_LOAD_FLAG_COLDPLUG |
 				      FU_ENGINE_LOAD_FLAG_DEVICE_HOTPLUG |
-				      FU_ENGINE_LOAD_FLAG_REMOTES | FU_ENGINE_LOAD_FLAG_HWINFO,
+				      FU_ENGINE_LOAD_FLAG_NO_METADATA | FU_ENGINE_LOAD_FLAG_HWINFO,
 				  fu_progress_get_child(priv->progress),
 				  error))
 		return FALSE;
@@ -1125,6 +1258,7 @@ fu_util_firmware_dump(FuUtilPrivate *priv, gchar **values, GError **error)
 	g_autoptr(FuDevice) device = NULL;
 	g_autoptr(GBytes) blob_empty = g_bytes_new(NULL, 0);
 	g_autoptr(GBytes) blob_fw = NULL;
+	g_autoptr(GBytes) blob_trimmed = NULL;
 
 	/* progress */
 	fu_progress_set_id(priv->progress, G_STRLOC);
@@ -1190,7 +1324,18 @@ fu_util_firmware_dump(FuUtilPrivate *priv, gchar **values, GError **error)
 	if (blob_fw == NULL)
 		return FALSE;
 	fu_progress_step_done(priv->progress);
-	return fu_bytes_set_contents(values[0], blob_fw, error);
+
+	/* only store the programmed extent; flashing the trimmed image back after a chip
+	 * erase gives identical device contents */
+	blob_trimmed = fu_bytes_trim_empty(blob_fw);
+	if (g_bytes_get_size(blob_trimmed) < g_bytes_get_size(blob_fw)) {
+		fu_console_print(
+		    priv->console,
+		    /* TRANSLATORS: %u is the number of trailing erased bytes not saved */
+		    _("Not saving %u bytes of erased padding"),
+		    (guint)(g_bytes_get_size(blob_fw) - g_bytes_get_size(blob_trimmed)));
+	}
+	return fu_bytes_set_contents(values[0], blob_trimmed, error);
 }
 
 static gboolean
@@ -1325,11 +1470,11 @@ fu_util_install(FuUtilPrivate *priv, gchar **values, GError **error)
 	fu_progress_add_step(priv->progress, FWUPD_STATUS_LOADING, 50, "start-engine");
 	fu_progress_add_step(priv->progress, FWUPD_STATUS_DEVICE_WRITE, 50, NULL);
 
-	/* load engine */
+	/* load engine; the local archive provides its own metadata */
 	if (!fu_util_start_engine(priv,
 				  FU_ENGINE_LOAD_FLAG_COLDPLUG |
 				      FU_ENGINE_LOAD_FLAG_DEVICE_HOTPLUG |
-				      FU_ENGINE_LOAD_FLAG_REMOTES | FU_ENGINE_LOAD_FLAG_HWINFO,
+				      FU_ENGINE_LOAD_FLAG_NO_METADATA | FU_ENGINE_LOAD_FLAG_HWINFO,
 				  fu_progress_get_child(priv->progress),
 				  error))
 		return FALSE;
@@ -2020,6 +2165,39 @@ fu_util_get_report_metadata(FuUtilPrivate *priv, gchar **values, GError **error)
 	return TRUE;
 }
 
+static gboolean
+fu_util_get_metrics(FuUtilPrivate *priv, gchar **values, GError **error)
+{
+	g_autoptr(GHashTable) metrics = NULL;
+	g_autoptr(GList) keys = NULL;
+
+	/* progress */
+	fu_progress_set_id(priv->progress, G_STRLOC);
+	fu_progress_add_step(priv->progress, FWUPD_STATUS_LOADING, 95, "start-engine");
+	fu_progress_add_step(priv->progress, FWUPD_STATUS_DEVICE_BUSY, 5, NULL);
+
+	/* load engine */
+	if (!fu_util_start_engine(priv,
+				  FU_ENGINE_LOAD_FLAG_COLDPLUG | FU_ENGINE_LOAD_FLAG_HWINFO,
+				  fu_progress_get_child(priv->progress),
+				  error))
+		return FALSE;
+	fu_progress_step_done(priv->progress);
+
+	/* print in the Prometheus exposition layout */
+	metrics = fu_engine_get_metrics(priv->engine);
+	keys = g_list_sort(g_hash_table_get_keys(metrics), (GCompareFunc)g_strcmp0);
+	for (GList *l = keys; l != NULL; l = l->next) {
+		const gchar *key = l->data;
+		const gchar *value = g_hash_table_lookup(metrics, key);
+		fu_console_print(priv->console, "%s %s", key, value);
+	}
+	fu_progress_step_done(priv->progress);
+
+	/* success */
+	return TRUE;
+}
+
 static gboolean
 fu_util_modify_config(FuUtilPrivate *priv, gchar **values, GError **error)
 {
@@ -3298,6 +3476,108 @@ fu_util_firmware_patch(FuUtilPrivate *priv, gchar **values, GError **error)
 	return TRUE;
 }
 
+typedef struct {
+	FuEngine *engine; /* noref */
+	FuDevice *device;
+	GError *error;
+} FuUtilVerifyUpdateHelper;
+
+static void
+fu_util_verify_update_helper_free(FuUtilVerifyUpdateHelper *helper)
+{
+	g_object_unref(helper->device);
+	if (helper->error != NULL)
+		g_error_free(helper->error);
+	g_free(helper);
+}
+
+static void
+fu_util_verify_update_thread_cb(gpointer data, gpointer user_data)
+{
+	FuUtilVerifyUpdateHelper *helper = (FuUtilVerifyUpdateHelper *)data;
+	g_autoptr(FuProgress) progress = fu_progress_new(G_STRLOC);
+	fu_engine_verify_update(helper->engine,
+				fu_device_get_id(helper->device),
+				progress,
+				&helper->error);
+}
+
+static gboolean
+fu_util_verify_update_parallel(FuUtilPrivate *priv, GError **error)
+{
+	guint failed_cnt = 0;
+	GThreadPool *pool;
+	g_autoptr(GPtrArray) devices = NULL;
+	g_autoptr(GPtrArray) helpers =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)fu_util_verify_update_helper_free);
+
+	/* each device gets a worker; the I/O is independent per transport */
+	devices = fu_engine_get_devices(priv->engine, error);
+	if (devices == NULL)
+		return FALSE;
+	for (guint i = 0; i < devices->len; i++) {
+		FuDevice *device = g_ptr_array_index(devices, i);
+		FuUtilVerifyUpdateHelper *helper;
+		if (!fu_device_has_flag(device, FWUPD_DEVICE_FLAG_UPDATABLE))
+			continue;
+		if (!fwupd_device_match_flags(FWUPD_DEVICE(device),
+					      priv->filter_device_include,
+					      priv->filter_device_exclude))
+			continue;
+		helper = g_new0(FuUtilVerifyUpdateHelper, 1);
+		helper->engine = priv->engine;
+		helper->device = g_object_ref(device);
+		g_ptr_array_add(helpers, helper);
+	}
+	if (helpers->len == 0) {
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_NOTHING_TO_DO,
+				    "No updatable devices");
+		return FALSE;
+	}
+	pool = g_thread_pool_new(fu_util_verify_update_thread_cb,
+				 NULL,
+				 (gint)helpers->len,
+				 FALSE,
+				 error);
+	if (pool == NULL)
+		return FALSE;
+	for (guint i = 0; i < helpers->len; i++)
+		g_thread_pool_push(pool, g_ptr_array_index(helpers, i), NULL);
+
+	/* wait for all the workers to finish */
+	g_thread_pool_free(pool, FALSE, TRUE);
+
+	/* aggregate the results */
+	for (guint i = 0; i < helpers->len; i++) {
+		FuUtilVerifyUpdateHelper *helper = g_ptr_array_index(helpers, i);
+		g_autofree gchar *str = NULL;
+		if (helper->error != NULL) {
+			fu_console_print(priv->console,
+					 "%s: %s",
+					 fu_device_get_name(helper->device),
+					 helper->error->message);
+			failed_cnt++;
+			continue;
+		}
+		str = fu_device_to_string(helper->device);
+		fu_console_print_literal(priv->console, str);
+	}
+	if (failed_cnt > 0) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INTERNAL,
+			    "failed to verify %u of %u devices",
+			    failed_cnt,
+			    helpers->len);
+		return FALSE;
+	}
+
+	/* success */
+	return TRUE;
+}
+
 static gboolean
 fu_util_verify_update(FuUtilPrivate *priv, gchar **values, GError **error)
 {
@@ -3319,8 +3599,16 @@ fu_util_verify_update(FuUtilPrivate *priv, gchar **values, GError **error)
 		return FALSE;
 	fu_progress_step_done(priv->progress);
 
-	/* get device */
+	/* verify all the devices at the same time */
 	priv->filter_device_include |= FWUPD_DEVICE_FLAG_UPDATABLE;
+	if (priv->parallel) {
+		if (!fu_util_verify_update_parallel(priv, error))
+			return FALSE;
+		fu_progress_step_done(priv->progress);
+		return TRUE;
+	}
+
+	/* get device */
 	if (g_strv_length(values) == 1) {
 		dev = fu_util_get_device(priv, values[0], error);
 		if (dev == NULL)
@@ -4308,6 +4596,55 @@ fu_util_efivar_list(FuUtilPrivate *priv, gchar **values, GError **error)
 	return TRUE;
 }
 
+static gboolean
+fu_util_build_quirks(FuUtilPrivate *priv, gchar **values, GError **error)
+{
+	g_autoptr(FuQuirks) quirks = fu_quirks_new(priv->ctx);
+
+	/* check the given files compile, without writing anything -- so that broken files
+	 * can be rejected before they are dropped into the quirk directory */
+	if (g_strv_length(values) > 0) {
+		for (guint i = 0; values[i] != NULL; i++) {
+			g_autoptr(GFile) file = g_file_new_for_path(values[i]);
+			if (!fu_quirks_check_file(quirks, file, error)) {
+				g_prefix_error(error, "%s: ", values[i]);
+				return FALSE;
+			}
+			fu_console_print(priv->console, "%s: OK", values[i]);
+		}
+		return TRUE;
+	}
+
+	/* pre-compile the content-hash-keyed silo, typically at image build time, so that the
+	 * daemon can memory-map it with zero parsing on first boot */
+	if (!fu_quirks_load(quirks, FU_QUIRKS_LOAD_FLAG_READONLY_FS, error))
+		return FALSE;
+
+	/* TRANSLATORS: success message when the quirk database has been pre-compiled */
+	fu_console_print_literal(priv->console, _("Successfully compiled quirk files"));
+	return TRUE;
+}
+
+static gboolean
+fu_util_export_inventory(FuUtilPrivate *priv, gchar **values, GError **error)
+{
+	/* load engine */
+	if (!fu_util_start_engine(priv,
+				  FU_ENGINE_LOAD_FLAG_COLDPLUG | FU_ENGINE_LOAD_FLAG_HWINFO,
+				  priv->progress,
+				  error))
+		return FALSE;
+
+	/* write the same snapshot the daemon reads at warm start, typically at image build or
+	 * early boot, so that an activated daemon can answer read-only queries right away */
+	if (!fu_engine_update_devices_file(priv->engine, error))
+		return FALSE;
+
+	/* TRANSLATORS: success message when the device inventory has been exported */
+	fu_console_print_literal(priv->console, _("Successfully exported device inventory"));
+	return TRUE;
+}
+
 static gboolean
 fu_util_build_cabinet(FuUtilPrivate *priv, gchar **values, GError **error)
 {
@@ -4518,6 +4855,14 @@ main(int argc, char *argv[])
 	     /* TRANSLATORS: command line option */
 	     N_("Do not check or prompt for reboot after update"),
 	     NULL},
+	    {"parallel",
+	     '\0',
+	     0,
+	     G_OPTION_ARG_NONE,
+	     &priv->parallel,
+	     /* TRANSLATORS: command line option */
+	     N_("Run per-device actions in parallel where supported"),
+	     NULL},
 	    {"no-search",
 	     '\0',
 	     0,
@@ -4598,6 +4943,14 @@ main(int argc, char *argv[])
 	     /* TRANSLATORS: command line option */
 	     N_("Ignore SSL strict checks when downloading files"),
 	     NULL},
+	    {"snapshot-ttl",
+	     '\0',
+	     0,
+	     G_OPTION_ARG_INT,
+	     &priv->snapshot_ttl,
+	     /* TRANSLATORS: command line option */
+	     N_("Reuse the exported device inventory when newer than this many seconds"),
+	     NULL},
 	    {"filter",
 	     '\0',
 	     0,
@@ -4691,6 +5044,12 @@ main(int argc, char *argv[])
 			      /* TRANSLATORS: command description */
 			      _("Get all enabled plugins registered with the system"),
 			      fu_util_get_plugins);
+	fu_util_cmd_array_add(cmd_array,
+			      "get-plugin-timings",
+			      NULL,
+			      /* TRANSLATORS: command description */
+			      _("Get the time taken for each plugin startup step"),
+			      fu_util_get_plugin_timings);
 	fu_util_cmd_array_add(cmd_array,
 			      "get-details",
 			      /* TRANSLATORS: command argument: uppercase, spaces->dashes */
@@ -4764,6 +5123,12 @@ main(int argc, char *argv[])
 			      /* TRANSLATORS: command description */
 			      _("Get device report metadata"),
 			      fu_util_get_report_metadata);
+	fu_util_cmd_array_add(cmd_array,
+			      "get-metrics",
+			      NULL,
+			      /* TRANSLATORS: command description */
+			      _("Get daemon statistics counters"),
+			      fu_util_get_metrics);
 	fu_util_cmd_array_add(cmd_array,
 			      "detach",
 			      /* TRANSLATORS: command argument: uppercase, spaces->dashes */
@@ -4995,6 +5360,19 @@ main(int argc, char *argv[])
 			      /* TRANSLATORS: command description */
 			      _("Build a cabinet archive from a firmware blob and XML metadata"),
 			      fu_util_build_cabinet);
+	fu_util_cmd_array_add(cmd_array,
+			      "build-quirks",
+			      /* TRANSLATORS: command argument: uppercase, spaces->dashes */
+			      _("[FILE1] [FILE2]..."),
+			      /* TRANSLATORS: command description */
+			      _("Pre-compile the quirk files into a mappable silo"),
+			      fu_util_build_quirks);
+	fu_util_cmd_array_add(cmd_array,
+			      "export-inventory",
+			      NULL,
+			      /* TRANSLATORS: command description */
+			      _("Export the device inventory snapshot used for warm starts"),
+			      fu_util_export_inventory);
 	fu_util_cmd_array_add(cmd_array,
 			      "efivar-list",
 			      /* TRANSLATORS: command argument: uppercase, spaces->dashes */
@@ -5150,7 +5528,9 @@ main(int argc, char *argv[])
 				 error->message);
 		return EXIT_FAILURE;
 	}
-	fu_progress_set_profile(priv->progress, g_getenv("FWUPD_VERBOSE") != NULL);
+	fu_progress_set_profile(priv->progress,
+				g_getenv("FWUPD_VERBOSE") != NULL ||
+				    g_getenv("FWUPD_PROFILE_TRACE") != NULL);
 
 	/* allow disabling SSL strict mode for broken corporate proxies */
 	if (priv->disable_ssl_strict) {
@@ -5289,6 +5669,15 @@ main(int argc, char *argv[])
 			fu_console_print_literal(priv->console, str);
 	}
 
+	/* also dump the spans in a format Perfetto can load */
+	if (g_getenv("FWUPD_PROFILE_TRACE") != NULL) {
+		const gchar *fn = g_getenv("FWUPD_PROFILE_TRACE");
+		g_autofree gchar *str = fu_progress_to_trace_string(priv->progress);
+		g_autoptr(GError) error_local = NULL;
+		if (str != NULL && !g_file_set_contents(fn, str, -1, &error_local))
+			g_warning("failed to write %s: %s", fn, error_local->message);
+	}
+
 	/* success */
 	return EXIT_SUCCESS;
 }
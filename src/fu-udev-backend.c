@@ -13,6 +13,7 @@
 #include <glib-unix.h>
 #include <glib/gstdio.h>
 #include <linux/netlink.h>
+#include <poll.h>
 #include <sys/socket.h>
 
 #include "fu-context-private.h"
@@ -24,9 +25,17 @@
 struct _FuUdevBackend {
 	FuBackend parent_instance;
 	gint netlink_fd;
+	GThread *thread_netlink;
+	volatile gint thread_netlink_run;
+	GMutex netlink_blobs_mutex;
+	GPtrArray *netlink_blobs; /* of GBytes */
+	guint netlink_blobs_id;
 	GHashTable *map_paths;	      /* of str:None */
 	GPtrArray *dpaux_devices;     /* of FuDpauxDevice */
 	guint dpaux_devices_rescan_id;
+	GPtrArray *uevents_pending; /* of FuUdevBackendUevent */
+	guint uevents_flush_id;
+	gint64 uevents_first_time;
 	gboolean done_coldplug;
 };
 
@@ -34,6 +43,24 @@ G_DEFINE_TYPE(FuUdevBackend, fu_udev_backend, FU_TYPE_BACKEND)
 
 #define FU_UDEV_BACKEND_DPAUX_RESCAN_DELAY 5 /* s */
 
+#define FU_UDEV_BACKEND_UEVENT_DEBOUNCE	    50	/* ms */
+#define FU_UDEV_BACKEND_UEVENT_DEBOUNCE_MAX 500 /* ms */
+
+typedef struct {
+	FuUdevAction action;
+	gchar *sysfs_path;
+	FuUdevDevice *device_donor;
+} FuUdevBackendUevent;
+
+static void
+fu_udev_backend_uevent_free(FuUdevBackendUevent *uevent)
+{
+	g_free(uevent->sysfs_path);
+	if (uevent->device_donor != NULL)
+		g_object_unref(uevent->device_donor);
+	g_free(uevent);
+}
+
 static void
 fu_udev_backend_to_string(FuBackend *backend, guint idt, GString *str)
 {
@@ -291,6 +318,139 @@ fu_udev_backend_device_remove(FuUdevBackend *self, const gchar *sysfs_path)
 	}
 }
 
+static gboolean
+fu_udev_backend_uevents_flush_cb(gpointer user_data)
+{
+	FuUdevBackend *self = FU_UDEV_BACKEND(user_data);
+	gboolean block_changed = FALSE;
+	g_autoptr(GPtrArray) uevents = g_steal_pointer(&self->uevents_pending);
+
+	self->uevents_pending =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)fu_udev_backend_uevent_free);
+	self->uevents_flush_id = 0;
+
+	/* process in arrival order so that a replug is still a removal followed by an add */
+	for (guint i = 0; i < uevents->len; i++) {
+		FuUdevBackendUevent *uevent = g_ptr_array_index(uevents, i);
+
+		/* a removal has no donor device, so fall back to matching the path */
+		if (!block_changed) {
+			if (uevent->device_donor != NULL) {
+				block_changed =
+				    g_strcmp0(fu_udev_device_get_subsystem(uevent->device_donor),
+					      "block") == 0;
+			} else {
+				block_changed =
+				    g_strstr_len(uevent->sysfs_path, -1, "/block/") != NULL;
+			}
+		}
+		if (uevent->action == FU_UDEV_ACTION_REMOVE) {
+			fu_udev_backend_device_remove(self, uevent->sysfs_path);
+		} else if (uevent->action == FU_UDEV_ACTION_CHANGE) {
+			/* the device may have been removed while coalescing */
+			if (fu_backend_lookup_by_id(FU_BACKEND(self), uevent->sysfs_path) == NULL)
+				continue;
+			if (g_strcmp0(fu_udev_device_get_subsystem(uevent->device_donor), "drm") !=
+			    0)
+				fu_udev_backend_rescan_dpaux_devices(self);
+			fu_backend_device_changed(FU_BACKEND(self),
+						  FU_DEVICE(uevent->device_donor));
+		} else if (uevent->action == FU_UDEV_ACTION_ADD) {
+			g_autoptr(FuUdevDevice) device = NULL;
+			g_autoptr(GError) error_local = NULL;
+
+			device = FU_UDEV_DEVICE(
+			    fu_udev_backend_create_device_for_donor(FU_BACKEND(self),
+								    FU_DEVICE(uevent->device_donor),
+								    &error_local));
+			if (device == NULL) {
+				if (g_error_matches(error_local,
+						    FWUPD_ERROR,
+						    FWUPD_ERROR_NOT_SUPPORTED)) {
+					g_debug("ignoring %s: %s",
+						uevent->sysfs_path,
+						error_local->message);
+					continue;
+				}
+				g_warning("failed to create device from %s: %s",
+					  uevent->sysfs_path,
+					  error_local->message);
+				continue;
+			}
+			fu_udev_backend_device_add_from_device(self, device);
+		}
+	}
+
+	/* any block topology change may have added or taken away an ESP candidate */
+	if (block_changed)
+		fu_context_invalidate_esp_volumes(fu_backend_get_context(FU_BACKEND(self)));
+
+	return G_SOURCE_REMOVE;
+}
+
+static void
+fu_udev_backend_uevent_enqueue(FuUdevBackend *self,
+			       FuUdevAction action,
+			       const gchar *sysfs_path,
+			       FuUdevDevice *device_donor)
+{
+	FuUdevBackendUevent *uevent;
+	gint64 now = g_get_monotonic_time();
+
+	/* coalesce against anything already pending for the same sysfs path */
+	for (guint i = self->uevents_pending->len; i > 0; i--) {
+		FuUdevBackendUevent *uevent_tmp = g_ptr_array_index(self->uevents_pending, i - 1);
+		if (g_strcmp0(uevent_tmp->sysfs_path, sysfs_path) != 0)
+			continue;
+
+		/* the device came and went within the window */
+		if (action == FU_UDEV_ACTION_REMOVE &&
+		    uevent_tmp->action == FU_UDEV_ACTION_ADD) {
+			g_debug("ignoring add-remove pair for %s", sysfs_path);
+			g_ptr_array_remove_index(self->uevents_pending, i - 1);
+			return;
+		}
+
+		/* a change before the removal is pointless */
+		if (action == FU_UDEV_ACTION_REMOVE &&
+		    uevent_tmp->action == FU_UDEV_ACTION_CHANGE) {
+			g_ptr_array_remove_index(self->uevents_pending, i - 1);
+			continue;
+		}
+
+		/* a pending add probes the current state, and repeated changes have already
+		 * updated the properties on the enumerated device */
+		if (action == FU_UDEV_ACTION_CHANGE &&
+		    (uevent_tmp->action == FU_UDEV_ACTION_ADD ||
+		     uevent_tmp->action == FU_UDEV_ACTION_CHANGE))
+			return;
+
+		break;
+	}
+
+	uevent = g_new0(FuUdevBackendUevent, 1);
+	uevent->action = action;
+	uevent->sysfs_path = g_strdup(sysfs_path);
+	if (device_donor != NULL)
+		uevent->device_donor = g_object_ref(device_donor);
+	g_ptr_array_add(self->uevents_pending, uevent);
+
+	/* extend the window while events keep arriving, with a hard limit so that a constant
+	 * stream of uevents cannot postpone the flush forever */
+	if (self->uevents_flush_id == 0) {
+		self->uevents_first_time = now;
+	} else if (now - self->uevents_first_time <
+		   FU_UDEV_BACKEND_UEVENT_DEBOUNCE_MAX * 1000) {
+		g_source_remove(self->uevents_flush_id);
+		self->uevents_flush_id = 0;
+	}
+	if (self->uevents_flush_id == 0) {
+		self->uevents_flush_id = g_timeout_add(FU_UDEV_BACKEND_UEVENT_DEBOUNCE,
+						       fu_udev_backend_uevents_flush_cb,
+						       self);
+	}
+}
+
 static gint
 fu_udev_backend_device_number_sort_cb(gconstpointer a, gconstpointer b)
 {
@@ -366,6 +526,7 @@ fu_udev_backend_netlink_parse_blob(FuUdevBackend *self, GBytes *blob, GError **e
 	const guint8 *buf;
 	gsize bufsz = 0;
 	g_autofree gchar *sysfsdir = fu_path_from_kind(FU_PATH_KIND_SYSFSDIR);
+	g_autofree gchar *sysfs_path_event = NULL;
 	g_autoptr(FuStructUdevMonitorNetlinkHeader) st_hdr = NULL;
 	g_autoptr(FuUdevDevice) device_donor = NULL;
 	g_autoptr(GBytes) blob_payload = NULL;
@@ -420,16 +581,16 @@ fu_udev_backend_netlink_parse_blob(FuUdevBackend *self, GBytes *blob, GError **e
 				    fu_backend_lookup_by_id(FU_BACKEND(self), sysfspath);
 				if (device_tmp == NULL)
 					return TRUE;
-				if (g_strcmp0(
-					fu_udev_device_get_subsystem(FU_UDEV_DEVICE(device_tmp)),
-					"drm") != 0)
-					fu_udev_backend_rescan_dpaux_devices(self);
 				g_set_object(&device_donor, FU_UDEV_DEVICE(device_tmp));
+				sysfs_path_event = g_strdup(sysfspath);
 			}
 
 			/* something got removed */
 			if (action == FU_UDEV_ACTION_REMOVE) {
-				fu_udev_backend_device_remove(self, sysfspath);
+				fu_udev_backend_uevent_enqueue(self,
+							       FU_UDEV_ACTION_REMOVE,
+							       sysfspath,
+							       NULL);
 				return TRUE;
 			}
 
@@ -443,6 +604,7 @@ fu_udev_backend_netlink_parse_blob(FuUdevBackend *self, GBytes *blob, GError **e
 					return FALSE;
 				}
 				device_donor = fu_udev_device_new(ctx, sysfspath);
+				sysfs_path_event = g_strdup(sysfspath);
 			}
 		} else if (g_strcmp0(kv[0], "SUBSYSTEM") == 0 && device_donor != NULL) {
 			fu_udev_device_set_subsystem(device_donor, kv[1]);
@@ -456,7 +618,8 @@ fu_udev_backend_netlink_parse_blob(FuUdevBackend *self, GBytes *blob, GError **e
 		i += strlen(kvstr);
 	}
 
-	/* notify the engine */
+	/* let the uevent coalesce with others from the same replug storm, rather than
+	 * serializing each one through the engine as it arrives */
 	if (action == FU_UDEV_ACTION_CHANGE) {
 		if (device_donor == NULL) {
 			g_set_error_literal(error,
@@ -465,12 +628,12 @@ fu_udev_backend_netlink_parse_blob(FuUdevBackend *self, GBytes *blob, GError **e
 					    "no device to change");
 			return FALSE;
 		}
-		fu_backend_device_changed(FU_BACKEND(self), FU_DEVICE(device_donor));
+		fu_udev_backend_uevent_enqueue(self,
+					       FU_UDEV_ACTION_CHANGE,
+					       sysfs_path_event,
+					       device_donor);
 	}
-
-	/* now create the actual device from the donor */
 	if (action == FU_UDEV_ACTION_ADD) {
-		g_autoptr(FuUdevDevice) device_actual = NULL;
 		if (device_donor == NULL) {
 			g_set_error_literal(error,
 					    FWUPD_ERROR,
@@ -478,43 +641,96 @@ fu_udev_backend_netlink_parse_blob(FuUdevBackend *self, GBytes *blob, GError **e
 					    "no new device to add");
 			return FALSE;
 		}
-		device_actual =
-		    FU_UDEV_DEVICE(fu_udev_backend_create_device_for_donor(FU_BACKEND(self),
-									   FU_DEVICE(device_donor),
-									   error));
-		if (device_actual == NULL)
-			return FALSE;
-
-		/* success */
-		fu_udev_backend_device_add_from_device(self, device_actual);
+		fu_udev_backend_uevent_enqueue(self,
+					       FU_UDEV_ACTION_ADD,
+					       sysfs_path_event,
+					       device_donor);
 	}
 
 	/* success */
 	return TRUE;
 }
 
+/* always in the main thread */
 static gboolean
-fu_udev_backend_netlink_cb(gint fd, GIOCondition condition, gpointer user_data)
+fu_udev_backend_netlink_idle_cb(gpointer user_data)
 {
 	FuUdevBackend *self = FU_UDEV_BACKEND(user_data);
-	gssize len;
-	guint8 buf[10240] = {0x0};
-	g_autoptr(GBytes) blob = NULL;
-	g_autoptr(GError) error_local = NULL;
-
-	len = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
-	if (len < 0)
-		return TRUE;
-	blob = g_bytes_new(buf, len);
-	if (!fu_udev_backend_netlink_parse_blob(self, blob, &error_local)) {
-		if (g_error_matches(error_local, FWUPD_ERROR, FWUPD_ERROR_NOT_SUPPORTED)) {
-			g_debug("ignoring netlink message: %s", error_local->message);
-			return TRUE;
+	g_autoptr(GPtrArray) blobs = NULL;
+
+	/* drain the batch with the lock held */
+	g_mutex_lock(&self->netlink_blobs_mutex);
+	blobs = g_steal_pointer(&self->netlink_blobs);
+	self->netlink_blobs = g_ptr_array_new_with_free_func((GDestroyNotify)g_bytes_unref);
+	self->netlink_blobs_id = 0;
+	g_mutex_unlock(&self->netlink_blobs_mutex);
+
+	/* parse when not locked; the whole storm coalesces into one flush */
+	for (guint i = 0; i < blobs->len; i++) {
+		GBytes *blob = g_ptr_array_index(blobs, i);
+		g_autoptr(GError) error_local = NULL;
+		if (!fu_udev_backend_netlink_parse_blob(self, blob, &error_local)) {
+			if (g_error_matches(error_local,
+					    FWUPD_ERROR,
+					    FWUPD_ERROR_NOT_SUPPORTED)) {
+				g_debug("ignoring netlink message: %s", error_local->message);
+				continue;
+			}
+			g_warning("ignoring netlink message: %s", error_local->message);
 		}
-		g_warning("ignoring netlink message: %s", error_local->message);
-		return TRUE;
 	}
-	return TRUE;
+
+	/* all done */
+	return FALSE;
+}
+
+/* this is run in the netlink thread */
+static void
+fu_udev_backend_netlink_drain(FuUdevBackend *self)
+{
+	g_autoptr(GMutexLocker) locker = NULL;
+	g_autoptr(GPtrArray) blobs =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)g_bytes_unref);
+
+	/* read every queued datagram so a hotplug storm is handed over as one batch */
+	for (;;) {
+		gssize len;
+		guint8 buf[10240] = {0x0};
+
+		len = recv(self->netlink_fd, buf, sizeof(buf), MSG_DONTWAIT);
+		if (len <= 0)
+			break;
+		g_ptr_array_add(blobs, g_bytes_new(buf, len));
+	}
+	if (blobs->len == 0)
+		return;
+
+	locker = g_mutex_locker_new(&self->netlink_blobs_mutex);
+	g_assert(locker != NULL); /* nocheck:blocked */
+	for (guint i = 0; i < blobs->len; i++)
+		g_ptr_array_add(self->netlink_blobs, g_ptr_array_index(blobs, i));
+	g_ptr_array_set_free_func(blobs, NULL);
+	if (self->netlink_blobs_id == 0)
+		self->netlink_blobs_id = g_idle_add(fu_udev_backend_netlink_idle_cb, self);
+}
+
+static gpointer
+fu_udev_backend_netlink_thread_cb(gpointer data)
+{
+	FuUdevBackend *self = FU_UDEV_BACKEND(data);
+	struct pollfd fds[] = {{
+	    .fd = self->netlink_fd,
+	    .events = POLLIN,
+	}};
+
+	while (g_atomic_int_get(&self->thread_netlink_run) > 0) {
+		gint rc = poll(fds, G_N_ELEMENTS(fds), 1000 /* ms */);
+		if (rc < 0 && errno != EINTR)
+			break;
+		if (rc > 0)
+			fu_udev_backend_netlink_drain(self);
+	}
+	return NULL;
 }
 
 static gboolean
@@ -525,7 +741,6 @@ fu_udev_backend_netlink_setup(FuUdevBackend *self, GError **error)
 	    .nl_pid = getpid(),
 	    .nl_groups = FU_UDEV_MONITOR_NETLINK_GROUP_UDEV,
 	};
-	g_autoptr(GSource) source = NULL;
 
 	self->netlink_fd = socket(AF_NETLINK, SOCK_RAW, NETLINK_KOBJECT_UEVENT);
 	if (self->netlink_fd < 0) {
@@ -544,11 +759,11 @@ fu_udev_backend_netlink_setup(FuUdevBackend *self, GError **error)
 			    g_strerror(errno));
 		return FALSE;
 	}
-	source = g_unix_fd_source_new(self->netlink_fd, G_IO_IN);
-	g_source_set_static_name(source, "netlink");
-	g_source_set_callback(source, (GSourceFunc)fu_udev_backend_netlink_cb, self, NULL);
-	g_source_set_can_recurse(source, TRUE);
-	g_source_attach(source, NULL);
+	/* receive on a dedicated thread so D-Bus dispatch does not compete with a hotplug
+	 * storm; batches are escaped back into the mainloop as a single idle source */
+	self->thread_netlink_run = 1;
+	self->thread_netlink =
+	    g_thread_new("FuUdevBackendUevent", fu_udev_backend_netlink_thread_cb, self);
 
 	/* success */
 	return TRUE;
@@ -725,10 +940,19 @@ fu_udev_backend_finalize(GObject *object)
 	FuUdevBackend *self = FU_UDEV_BACKEND(object);
 	if (self->dpaux_devices_rescan_id != 0)
 		g_source_remove(self->dpaux_devices_rescan_id);
+	if (self->uevents_flush_id != 0)
+		g_source_remove(self->uevents_flush_id);
+	if (g_atomic_int_dec_and_test(&self->thread_netlink_run))
+		g_thread_join(self->thread_netlink);
+	if (self->netlink_blobs_id != 0)
+		g_source_remove(self->netlink_blobs_id);
 	if (self->netlink_fd > 0)
 		g_close(self->netlink_fd, NULL);
 	g_hash_table_unref(self->map_paths);
 	g_ptr_array_unref(self->dpaux_devices);
+	g_ptr_array_unref(self->uevents_pending);
+	g_ptr_array_unref(self->netlink_blobs);
+	g_mutex_clear(&self->netlink_blobs_mutex);
 	G_OBJECT_CLASS(fu_udev_backend_parent_class)->finalize(object);
 }
 
@@ -737,6 +961,12 @@ fu_udev_backend_init(FuUdevBackend *self)
 {
 	self->map_paths = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
 	self->dpaux_devices = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+	self->uevents_pending =
+	    g_ptr_array_new_with_free_func((GDestroyNotify)fu_udev_backend_uevent_free);
+
+	/* to escape the netlink thread into the mainloop */
+	g_mutex_init(&self->netlink_blobs_mutex);
+	self->netlink_blobs = g_ptr_array_new_with_free_func((GDestroyNotify)g_bytes_unref);
 }
 
 static void
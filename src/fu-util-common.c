@@ -1856,6 +1856,33 @@ fu_util_report_add_string(FwupdReport *report, guint idt, GString *str)
 	    fwupd_report_get_metadata_item(report, "RuntimeVersion(org.freedesktop.fwupd)"));
 }
 
+static void
+fu_util_release_add_phase_durations(FwupdRelease *rel, guint idt, GString *str)
+{
+	g_autoptr(GList) keys = g_list_sort(g_hash_table_get_keys(fwupd_release_get_metadata(rel)),
+					    (GCompareFunc)g_strcmp0);
+	for (GList *l = keys; l != NULL; l = l->next) {
+		const gchar *key = l->data;
+		const gchar *value;
+		g_autofree gchar *phase = NULL;
+		g_autofree gchar *title = NULL;
+		g_autofree gchar *tmp = NULL;
+
+		if (!g_str_has_prefix(key, "PhaseDuration("))
+			continue;
+		value = fwupd_release_get_metadata_item(rel, key);
+		if (value == NULL)
+			continue;
+		phase = g_strdup(key + strlen("PhaseDuration("));
+		if (g_str_has_suffix(phase, ")"))
+			phase[strlen(phase) - 1] = '\0';
+		/* TRANSLATORS: the %s is an update phase, e.g. 'detach' */
+		title = g_strdup_printf(_("Duration[%s]"), phase);
+		tmp = g_strdup_printf("%sms", value);
+		fwupd_codec_string_append(str, idt, title, tmp);
+	}
+}
+
 static gchar *
 fu_util_release_to_string(FwupdRelease *rel, guint idt)
 {
@@ -1945,6 +1972,9 @@ fu_util_release_to_string(FwupdRelease *rel, guint idt)
 		/* TRANSLATORS: length of time the update takes to apply */
 		fwupd_codec_string_append(str, idt + 1, _("Duration"), tmp);
 	}
+
+	/* per-phase durations are only present for history entries */
+	fu_util_release_add_phase_durations(rel, idt + 1, str);
 	fwupd_codec_string_append(str,
 				  idt + 1,
 				  /* TRANSLATORS: helpful messages for the update */
@@ -2852,6 +2882,38 @@ fu_util_print_builder(FuConsole *console, JsonBuilder *builder, GError **error)
 	return TRUE;
 }
 
+gboolean
+fu_util_print_codec_ndjson(FuConsole *console,
+			   FwupdCodec *codec,
+			   FwupdCodecFlags flags,
+			   GError **error)
+{
+	g_autofree gchar *data = NULL;
+	g_autoptr(JsonBuilder) builder = json_builder_new();
+	g_autoptr(JsonGenerator) json_generator = NULL;
+	g_autoptr(JsonNode) json_root = NULL;
+
+	/* export as a single line so that collectors can parse each record as it arrives */
+	json_builder_begin_object(builder);
+	fwupd_codec_to_json(codec, builder, flags);
+	json_builder_end_object(builder);
+	json_root = json_builder_get_root(builder);
+	json_generator = json_generator_new();
+	json_generator_set_root(json_generator, json_root);
+	data = json_generator_to_data(json_generator, NULL);
+	if (data == NULL) {
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INTERNAL,
+				    "Failed to convert to JSON string");
+		return FALSE;
+	}
+
+	/* just print */
+	fu_console_print_literal(console, data);
+	return TRUE;
+}
+
 void
 fu_util_print_error_as_json(FuConsole *console, const GError *error)
 {
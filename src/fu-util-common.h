@@ -135,6 +135,11 @@ fu_util_is_url(const gchar *perhaps_url) G_GNUC_NON_NULL(1);
 gboolean
 fu_util_print_builder(FuConsole *console, JsonBuilder *builder, GError **error)
     G_GNUC_NON_NULL(1, 2);
+gboolean
+fu_util_print_codec_ndjson(FuConsole *console,
+			   FwupdCodec *codec,
+			   FwupdCodecFlags flags,
+			   GError **error) G_GNUC_NON_NULL(1, 2);
 void
 fu_util_print_error_as_json(FuConsole *console, const GError *error) G_GNUC_NON_NULL(1);
 gchar *
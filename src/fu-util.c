@@ -64,11 +64,14 @@ struct FuUtilPrivate {
 	gboolean no_device_prompt;
 	gboolean no_emulation_check;
 	gboolean no_security_fix;
+	gboolean prefetch;
 	gboolean assume_yes;
 	gboolean sign;
 	gboolean show_all;
+	gboolean show_timings;
 	gboolean disable_ssl_strict;
 	gboolean as_json;
+	gboolean as_json_stream;
 	/* only valid in update and downgrade */
 	FuUtilOperation current_operation;
 	FwupdDevice *current_device;
@@ -530,10 +533,20 @@ fu_util_get_releases_as_json(FuUtilPrivate *priv, GPtrArray *rels, GError **erro
 					       priv->filter_release_include,
 					       priv->filter_release_exclude))
 			continue;
+		if (priv->as_json_stream) {
+			if (!fu_util_print_codec_ndjson(priv->console,
+							FWUPD_CODEC(rel),
+							FWUPD_CODEC_FLAG_NONE,
+							error))
+				return FALSE;
+			continue;
+		}
 		json_builder_begin_object(builder);
 		fwupd_codec_to_json(FWUPD_CODEC(rel), builder, FWUPD_CODEC_FLAG_NONE);
 		json_builder_end_object(builder);
 	}
+	if (priv->as_json_stream)
+		return TRUE;
 	json_builder_end_array(builder);
 	json_builder_end_object(builder);
 	return fu_util_print_builder(priv->console, builder, error);
@@ -575,11 +588,23 @@ fu_util_get_devices_as_json(FuUtilPrivate *priv, GPtrArray *devs, GError **error
 			}
 		}
 
+		/* emit each record as soon as it is complete */
+		if (priv->as_json_stream) {
+			if (!fu_util_print_codec_ndjson(priv->console,
+							FWUPD_CODEC(dev),
+							FWUPD_CODEC_FLAG_TRUSTED,
+							error))
+				return FALSE;
+			continue;
+		}
+
 		/* add to builder */
 		json_builder_begin_object(builder);
 		fwupd_codec_to_json(FWUPD_CODEC(dev), builder, FWUPD_CODEC_FLAG_TRUSTED);
 		json_builder_end_object(builder);
 	}
+	if (priv->as_json_stream)
+		return TRUE;
 	json_builder_end_array(builder);
 	json_builder_end_object(builder);
 	return fu_util_print_builder(priv->console, builder, error);
@@ -689,6 +714,95 @@ fu_util_download_if_required(FuUtilPrivate *priv, const gchar *perhapsfn, GError
 	return g_steal_pointer(&filename);
 }
 
+static gboolean
+fu_util_release_blob_valid(FwupdRelease *rel, GBytes *blob)
+{
+	const gchar *checksum_expected;
+	GChecksumType checksum_type;
+	g_autofree gchar *checksum_actual = NULL;
+
+	checksum_expected = fwupd_checksum_get_best(fwupd_release_get_checksums(rel));
+	if (checksum_expected == NULL)
+		return FALSE;
+	checksum_type = fwupd_checksum_guess_kind(checksum_expected);
+	checksum_actual = g_compute_checksum_for_bytes(checksum_type, blob);
+	return g_strcmp0(checksum_actual, checksum_expected) == 0;
+}
+
+static gchar *
+fu_util_get_prefetched_release(FwupdRelease *rel)
+{
+	GPtrArray *locations = fwupd_release_get_locations(rel);
+
+	for (guint i = 0; i < locations->len; i++) {
+		const gchar *uri = g_ptr_array_index(locations, i);
+		g_autofree gchar *filename = NULL;
+		g_autoptr(GBytes) blob = NULL;
+
+		if (!fu_util_is_url(uri))
+			continue;
+		filename = fu_util_get_user_cache_path(uri);
+		if (!g_file_test(filename, G_FILE_TEST_EXISTS))
+			continue;
+
+		/* something else may have truncated or replaced the archive */
+		blob = fu_bytes_get_contents(filename, NULL);
+		if (blob == NULL || !fu_util_release_blob_valid(rel, blob))
+			continue;
+		return g_steal_pointer(&filename);
+	}
+	return NULL;
+}
+
+static gboolean
+fu_util_prefetch_release(FuUtilPrivate *priv, FwupdRelease *rel, GError **error)
+{
+	GPtrArray *locations = fwupd_release_get_locations(rel);
+	const gchar *uri;
+	g_autofree gchar *filename = NULL;
+	g_autofree gchar *filename_cached = NULL;
+	g_autoptr(GBytes) blob = NULL;
+
+	if (locations->len == 0) {
+		g_set_error_literal(error,
+				    FWUPD_ERROR,
+				    FWUPD_ERROR_INVALID_FILE,
+				    "release missing URI");
+		return FALSE;
+	}
+
+	/* a local file, nothing to download */
+	uri = g_ptr_array_index(locations, 0);
+	if (!fu_util_is_url(uri))
+		return TRUE;
+
+	/* already downloaded and verified */
+	filename_cached = fu_util_get_prefetched_release(rel);
+	if (filename_cached != NULL)
+		return TRUE;
+
+	/* download to the cachedir, verifying against the release checksum */
+	filename = fu_util_get_user_cache_path(uri);
+	if (!fu_path_mkdir_parent(filename, error))
+		return FALSE;
+	blob = fwupd_client_download_bytes(priv->client,
+					   uri,
+					   priv->download_flags,
+					   priv->cancellable,
+					   error);
+	if (blob == NULL)
+		return FALSE;
+	if (!fu_util_release_blob_valid(rel, blob)) {
+		g_set_error(error,
+			    FWUPD_ERROR,
+			    FWUPD_ERROR_INVALID_FILE,
+			    "checksum failure for %s",
+			    uri);
+		return FALSE;
+	}
+	return fu_bytes_set_contents(filename, blob, error);
+}
+
 static void
 fu_util_display_current_message(FuUtilPrivate *priv)
 {
@@ -1796,6 +1910,17 @@ fu_util_get_history(FuUtilPrivate *priv, gchar **values, GError **error)
 		return FALSE;
 
 	/* not for human consumption */
+	if (priv->as_json_stream) {
+		for (guint i = 0; i < devices->len; i++) {
+			FwupdDevice *dev = g_ptr_array_index(devices, i);
+			if (!fu_util_print_codec_ndjson(priv->console,
+							FWUPD_CODEC(dev),
+							FWUPD_CODEC_FLAG_TRUSTED,
+							error))
+				return FALSE;
+		}
+		return TRUE;
+	}
 	if (priv->as_json) {
 		g_autoptr(JsonBuilder) builder = json_builder_new();
 		json_builder_begin_object(builder);
@@ -1819,6 +1944,17 @@ fu_util_get_history(FuUtilPrivate *priv, gchar **values, GError **error)
 		rel = fwupd_device_get_release_default(dev);
 		if (rel == NULL)
 			continue;
+
+		/* only show the per-phase durations when explicitly asked */
+		if (!priv->show_timings) {
+			GHashTableIter iter;
+			gpointer key;
+			g_hash_table_iter_init(&iter, fwupd_release_get_metadata(rel));
+			while (g_hash_table_iter_next(&iter, &key, NULL)) {
+				if (g_str_has_prefix((const gchar *)key, "PhaseDuration("))
+					g_hash_table_iter_remove(&iter);
+			}
+		}
 		g_node_append_data(child, g_object_ref(rel));
 	}
 
@@ -2023,6 +2159,44 @@ fu_util_check_oldest_remote(FuUtilPrivate *priv, guint64 *age_oldest, GError **e
 	return TRUE;
 }
 
+typedef struct {
+	FuUtilPrivate *priv;
+	guint pending_cnt;
+	guint refresh_cnt;
+	GError *error;
+} FuUtilRefreshHelper;
+
+typedef struct {
+	FuUtilRefreshHelper *helper;
+	FwupdRemote *remote;
+} FuUtilRefreshRemoteHelper;
+
+static void
+fu_util_download_metadata_remote_cb(GObject *source, GAsyncResult *res, gpointer user_data)
+{
+	g_autofree FuUtilRefreshRemoteHelper *remote_helper = user_data;
+	FuUtilRefreshHelper *helper = remote_helper->helper;
+	g_autoptr(FwupdRemote) remote = remote_helper->remote;
+	g_autoptr(GError) error_local = NULL;
+
+	if (!fwupd_client_refresh_remote_finish(FWUPD_CLIENT(source), res, &error_local)) {
+		g_debug("failed to refresh %s: %s",
+			fwupd_remote_get_id(remote),
+			error_local->message);
+		/* only the first failure is reported, but all remotes are waited for */
+		if (helper->error == NULL) {
+			g_propagate_prefixed_error(&helper->error,
+						   g_steal_pointer(&error_local),
+						   "failed to refresh %s: ",
+						   fwupd_remote_get_id(remote));
+		}
+	} else {
+		helper->refresh_cnt++;
+	}
+	if (--helper->pending_cnt == 0)
+		g_main_loop_quit(helper->priv->loop);
+}
+
 static gboolean
 fu_util_download_metadata(FuUtilPrivate *priv, GError **error)
 {
@@ -2034,12 +2208,17 @@ fu_util_download_metadata(FuUtilPrivate *priv, GError **error)
 	g_autoptr(GPtrArray) remotes = NULL;
 	g_autoptr(GString) str = g_string_new(NULL);
 	g_autoptr(GError) error_local = NULL;
+	FuUtilRefreshHelper helper = {.priv = priv};
 
 	remotes = fwupd_client_get_remotes(priv->client, priv->cancellable, error);
 	if (remotes == NULL)
 		return FALSE;
+
+	/* refresh all the stale remotes in parallel so the wall time is the
+	 * slowest remote rather than the sum of every download */
 	for (guint i = 0; i < remotes->len; i++) {
 		FwupdRemote *remote = g_ptr_array_index(remotes, i);
+		FuUtilRefreshRemoteHelper *remote_helper;
 		if (!fwupd_remote_has_flag(remote, FWUPD_REMOTE_FLAG_ENABLED))
 			continue;
 		if (fwupd_remote_get_kind(remote) != FWUPD_REMOTE_KIND_DOWNLOAD)
@@ -2056,14 +2235,24 @@ fu_util_download_metadata(FuUtilPrivate *priv, GError **error)
 				 "%s %s",
 				 _("Updating"),
 				 fwupd_remote_get_id(remote));
-		if (!fwupd_client_refresh_remote(priv->client,
-						 remote,
-						 priv->download_flags,
-						 priv->cancellable,
-						 error))
-			return FALSE;
-		refresh_cnt++;
+		remote_helper = g_new0(FuUtilRefreshRemoteHelper, 1);
+		remote_helper->helper = &helper;
+		remote_helper->remote = g_object_ref(remote);
+		helper.pending_cnt++;
+		fwupd_client_refresh_remote_async(priv->client,
+						  remote,
+						  priv->download_flags,
+						  priv->cancellable,
+						  fu_util_download_metadata_remote_cb,
+						  remote_helper);
 	}
+	if (helper.pending_cnt > 0)
+		g_main_loop_run(priv->loop);
+	if (helper.error != NULL) {
+		g_propagate_error(error, g_steal_pointer(&helper.error));
+		return FALSE;
+	}
+	refresh_cnt = helper.refresh_cnt;
 
 	/* no web remote is declared; try to enable LVFS */
 	if (!download_remote_enabled) {
@@ -2545,6 +2734,30 @@ fu_util_get_updates(FuUtilPrivate *priv, gchar **values, GError **error)
 
 	fu_util_print_node(priv->console, priv->client, root);
 
+	/* proactively download the newest release for each device so the
+	 * eventual update is flash-time only */
+	if (priv->prefetch) {
+		for (FuUtilNode *n = g_node_first_child(root); n != NULL;
+		     n = g_node_next_sibling(n)) {
+			FwupdDevice *dev = n->data;
+			FuUtilNode *child = g_node_first_child(n);
+			FwupdRelease *rel;
+			g_autoptr(GError) error_local = NULL;
+
+			if (child == NULL)
+				continue;
+			rel = child->data;
+			if (!fu_util_prefetch_release(priv, rel, &error_local)) {
+				fu_console_print(priv->console,
+						 /* TRANSLATORS: the download failed, %1 is the
+						  * device name and %2 the reason */
+						 _("Failed to prefetch %s: %s"),
+						 fwupd_device_get_name(dev),
+						 error_local->message);
+			}
+		}
+	}
+
 	/* success */
 	return TRUE;
 }
@@ -2787,6 +3000,8 @@ fu_util_update_device_with_release(FuUtilPrivate *priv,
 				   FwupdRelease *rel,
 				   GError **error)
 {
+	g_autofree gchar *filename_cached = NULL;
+
 	if (!fwupd_device_has_flag(dev, FWUPD_DEVICE_FLAG_UPDATABLE)) {
 		const gchar *name = fwupd_device_get_name(dev);
 		g_autofree gchar *str = NULL;
@@ -2812,6 +3027,18 @@ fu_util_update_device_with_release(FuUtilPrivate *priv,
 		if (!fu_util_prompt_warning_bkc(priv, dev, rel, error))
 			return FALSE;
 	}
+
+	/* use the prefetched archive if the checksum still matches */
+	filename_cached = fu_util_get_prefetched_release(rel);
+	if (filename_cached != NULL) {
+		g_debug("installing prefetched %s", filename_cached);
+		return fwupd_client_install(priv->client,
+					    fwupd_device_get_id(dev),
+					    filename_cached,
+					    priv->flags,
+					    priv->cancellable,
+					    error);
+	}
 	return fwupd_client_install_release(priv->client,
 					    dev,
 					    rel,
@@ -4911,6 +5138,14 @@ main(int argc, char *argv[])
 	     /* TRANSLATORS: command line option */
 	     N_("Show all results"),
 	     NULL},
+	    {"timings",
+	     '\0',
+	     0,
+	     G_OPTION_ARG_NONE,
+	     &priv->show_timings,
+	     /* TRANSLATORS: command line option */
+	     N_("Show how long each update phase took"),
+	     NULL},
 	    {"show-all-devices",
 	     '\0',
 	     G_OPTION_FLAG_HIDDEN,
@@ -4961,6 +5196,14 @@ main(int argc, char *argv[])
 	     /* TRANSLATORS: command line option */
 	     N_("Output in JSON format"),
 	     NULL},
+	    {"json-stream",
+	     '\0',
+	     0,
+	     G_OPTION_ARG_NONE,
+	     &priv->as_json_stream,
+	     /* TRANSLATORS: command line option */
+	     N_("Output as newline-delimited JSON, one record per line"),
+	     NULL},
 	    {"no-security-fix",
 	     '\0',
 	     0,
@@ -4977,6 +5220,14 @@ main(int argc, char *argv[])
 	     /* TRANSLATORS: command line option */
 	     N_("Don't prompt for authentication (less details may be shown)"),
 	     NULL},
+	    {"prefetch",
+	     '\0',
+	     0,
+	     G_OPTION_ARG_NONE,
+	     &priv->prefetch,
+	     /* TRANSLATORS: command line option */
+	     N_("Download and verify pending updates after listing them"),
+	     NULL},
 	    {NULL}};
 	FwupdFeatureFlags feature_flags =
 	    FWUPD_FEATURE_FLAG_CAN_REPORT | FWUPD_FEATURE_FLAG_SWITCH_BRANCH |
@@ -5402,6 +5653,10 @@ main(int argc, char *argv[])
 		return EXIT_FAILURE;
 	}
 
+	/* streamed output is still JSON output */
+	if (priv->as_json_stream)
+		priv->as_json = TRUE;
+
 	/* allow disabling SSL strict mode for broken corporate proxies */
 	if (priv->disable_ssl_strict) {
 		fu_console_print_full(priv->console,